@@ -10,6 +10,12 @@
 
 //#define __SWL_CONFIG__USE_DEBUG_NEW 1
 
+// GuardedByteBuffer is replaced by a fixed-capacity lock-free ring buffer.
+//	- SPSC: each buffer has to be filled by one thread & drained by another thread.
+//	- MPMC: any number of threads.
+//#define __SWL_CONFIG__USE_SPSC_BYTE_BUFFER 1
+//#define __SWL_CONFIG__USE_MPMC_BYTE_BUFFER 1
+
 //-----------------------------------------------------------------------------
 //
 
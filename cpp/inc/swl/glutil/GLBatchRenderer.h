@@ -0,0 +1,110 @@
+#if !defined(__SWL_GL_UTIL__GL_BATCH_RENDERER__H_)
+#define __SWL_GL_UTIL__GL_BATCH_RENDERER__H_ 1
+
+
+#include "swl/glutil/ExportGLUtil.h"
+#include "swl/glutil/GLCollectShapeVisitor.h"
+#include "swl/glutil/GLRenderSceneVisitor.h"
+#include "swl/graphics/SceneNode.h"
+#include "swl/graphics/Appearance.h"
+#include <vector>
+
+
+namespace swl {
+
+//--------------------------------------------------------------------------
+// class GLBatchRenderer: draw the shapes of a scene graph from shared vertex & index buffers
+//	- the triangle meshes of the shapes are transformed into object coordinates & packed into one vertex buffer & one index buffer.
+//	- the shapes are grouped into batches by their render states(transparency, polygon mode, drawing face & normals).
+//	  a batch is drawn with one multi-draw call over the runs of its visible shapes.
+//	- shapes without a triangle mesh are drawn one by one as GLRenderSceneVisitor does.
+//	  the shapes referring to a GLMeshGeometry are batched, as are the ones overriding Shape::getTriangleMesh().
+//	- buffer objects are used if OpenGL 1.5 is available. or else client-side vertex arrays are used.
+//	- a rendering context has to be current in render() & release(). build() creates buffer objects only if it is current.
+//	- the destructor can't release the buffers, since no rendering context may be current then.
+//	  release() has to be called with the rendering context current before the renderer is destroyed. it's asserted.
+
+class SWL_GL_UTIL_API GLBatchRenderer
+{
+public:
+	//typedef GLBatchRenderer base_type;
+	typedef ISceneNode<IGLSceneVisitor>::node_type node_type;
+	typedef GLRenderSceneVisitor::RenderMode RenderMode;
+
+private:
+	struct Vertex
+	{
+		float position[3];
+		float normal[3];
+		unsigned char color[4];
+	};
+
+	struct BatchedShape
+	{
+		size_t instance;
+		size_t firstVertex, vertexCount;
+		size_t firstIndex, indexCount;
+	};
+
+	struct Batch
+	{
+		bool isTransparent;
+		attrib::PolygonMode polygonMode;
+		attrib::PolygonFace drawingFace;
+		bool hasNormals;
+
+		std::vector<BatchedShape> shapes;
+	};
+
+public:
+	GLBatchRenderer();
+	/// release() has to be called before, if buffer objects were created.
+	~GLBatchRenderer();
+
+private:
+	GLBatchRenderer(const GLBatchRenderer &rhs);
+	GLBatchRenderer & operator=(const GLBatchRenderer &rhs);
+
+public:
+	/// rebuild after the scene graph, the geometries or the render states of the shapes are changed.
+	void build(const node_type &root);
+	/// release the buffers. a rendering context has to be current if the buffers were created.
+	void release();
+
+	/// draw the shapes of a render mode in object coordinates.
+	void render(const RenderMode renderMode, const bool isPickingState = false) const;
+
+	/// refresh the vertex colors after the colors of the shapes or the picked objects are changed.
+	void updateColors();
+
+	size_t getBatchCount() const  {  return batches_.size();  }
+	size_t getBatchedShapeCount() const;
+	size_t getUnbatchedShapeCount() const  {  return unbatchedInstances_.size();  }
+	/// the number of draw calls issued by the last render()
+	size_t getDrawCallCount() const  {  return drawCallCount_;  }
+	bool isBufferObjectUsed() const  {  return 0u != vertexBufferId_;  }
+
+private:
+	void packShape(const size_t instanceIndex);
+	void fillColor(const BatchedShape &batchedShape);
+
+	void drawBatch(const Batch &batch, const bool isPickingState) const;
+
+private:
+	std::vector<GLShapeInstance> instances_;
+	std::vector<Batch> batches_;
+	std::vector<size_t> unbatchedInstances_;
+
+	std::vector<Vertex> vertices_;
+	std::vector<unsigned int> indices_;
+
+	unsigned int vertexBufferId_;
+	unsigned int indexBufferId_;
+
+	mutable size_t drawCallCount_;
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_GL_UTIL__GL_BATCH_RENDERER__H_
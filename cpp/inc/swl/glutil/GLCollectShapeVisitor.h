@@ -0,0 +1,73 @@
+#if !defined(__SWL_GL_UTIL__GL_COLLECT_SHAPE_VISITOR__H_)
+#define __SWL_GL_UTIL__GL_COLLECT_SHAPE_VISITOR__H_ 1
+
+
+#include "swl/glutil/ExportGLUtil.h"
+#include "swl/glutil/IGLSceneVisitor.h"
+#include "swl/graphics/BoundingBox.h"
+#include "swl/math/TMatrix.h"
+#include <boost/smart_ptr.hpp>
+#include <vector>
+
+
+namespace swl {
+
+class GLShape;
+
+//--------------------------------------------------------------------------
+// struct GLShapeInstance: a shape placed in object coordinates
+
+struct GLShapeInstance
+{
+public:
+	typedef boost::shared_ptr<GLShape> shape_type;
+	typedef TMatrix3<double> transform_type;
+	typedef BoundingBox<double> bound_type;
+
+public:
+	GLShapeInstance()
+	: shape(), transform(), bound(), isBoundKnown(false)
+	{}
+
+public:
+	shape_type shape;
+	/// the transform from the local coordinates of a shape to object coordinates
+	transform_type transform;
+	/// the bound in object coordinates. valid if isBoundKnown is true.
+	bound_type bound;
+	bool isBoundKnown;
+};
+
+//--------------------------------------------------------------------------
+// class GLCollectShapeVisitor: flatten a scene graph into a list of shape instances
+
+class SWL_GL_UTIL_API GLCollectShapeVisitor: public IGLSceneVisitor
+{
+public:
+	//typedef IGLSceneVisitor base_type;
+	typedef GLShapeInstance::transform_type transform_type;
+
+public:
+	/// invisible or unpickable shapes are skipped unless requested.
+	GLCollectShapeVisitor(std::vector<GLShapeInstance> &instances, const bool isInvisibleCollected = false, const bool isUnpickableCollected = true);
+
+public:
+	/*virtual*/ void visit(const appearance_node_type & /*node*/) const  {}
+	/*virtual*/ void visit(const geometry_node_type & /*node*/) const  {}
+	/*virtual*/ void visit(const shape_node_type &node) const;
+
+	/*virtual*/ void visit(const transform_node_type &node) const;
+
+private:
+	std::vector<GLShapeInstance> &instances_;
+	const bool isInvisibleCollected_;
+	const bool isUnpickableCollected_;
+
+	// the transforms from the current local coordinates to object coordinates
+	mutable std::vector<transform_type> transforms_;
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_GL_UTIL__GL_COLLECT_SHAPE_VISITOR__H_
@@ -0,0 +1,60 @@
+#if !defined(__SWL_GL_UTIL__GL_CULLING_RENDER_SCENE_VISITOR__H_)
+#define __SWL_GL_UTIL__GL_CULLING_RENDER_SCENE_VISITOR__H_ 1
+
+
+#include "swl/glutil/GLRenderSceneVisitor.h"
+#include "swl/graphics/Frustum.h"
+#include "swl/math/TMatrix.h"
+#include <vector>
+
+
+namespace swl {
+
+class ViewCamera3;
+
+//--------------------------------------------------------------------------
+// class GLCullingRenderSceneVisitor: render a scene graph skipping the subtrees outside a view frustum
+//	- the cached bounds of the scene nodes are transformed into object coordinates along the traversal.
+//	- a node whose bound is unknown is always rendered.
+//	- a subtree with unbounded nodes is always traversed, but its bounded nodes are culled separately.
+
+class SWL_GL_UTIL_API GLCullingRenderSceneVisitor: public GLRenderSceneVisitor
+{
+public:
+	typedef GLRenderSceneVisitor base_type;
+	typedef Frustum<double> frustum_type;
+	typedef TMatrix3<double> transform_type;
+
+public:
+	GLCullingRenderSceneVisitor(const RenderMode renderMode, const frustum_type &frustum, const bool isPickingState = false);
+	GLCullingRenderSceneVisitor(const RenderMode renderMode, const ViewCamera3 &camera, const bool isPickingState = false);
+
+public:
+	/*virtual*/ void visit(const appearance_node_type &node) const;
+	/*virtual*/ void visit(const geometry_node_type &node) const;
+	/*virtual*/ void visit(const shape_node_type &node) const;
+
+	/*virtual*/ void visit(const transform_node_type &node) const;
+
+	const frustum_type & getFrustum() const  {  return frustum_;  }
+
+	/// the number of culled nodes
+	size_t getCulledCount() const  {  return culledCount_;  }
+
+private:
+	template<typename Node>
+	bool isCulled(const Node &node) const;
+
+private:
+	frustum_type frustum_;
+	const bool isFrustumValid_;
+
+	// the transforms from the current local coordinates to object coordinates
+	mutable std::vector<transform_type> transforms_;
+	mutable size_t culledCount_;
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_GL_UTIL__GL_CULLING_RENDER_SCENE_VISITOR__H_
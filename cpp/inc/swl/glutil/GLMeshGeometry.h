@@ -0,0 +1,47 @@
+#if !defined(__SWL_GL_UTIL__GL_MESH_GEOMETRY__H_)
+#define __SWL_GL_UTIL__GL_MESH_GEOMETRY__H_ 1
+
+
+#include "swl/glutil/ExportGLUtil.h"
+#include "swl/graphics/Geometry.h"
+#include "swl/graphics/TriangleMesh.h"
+
+
+namespace swl {
+
+//-----------------------------------------------------------------------------------------
+// class GLMeshGeometry: a geometry defined by a triangle mesh
+//	- drawn from client-side vertex arrays.
+//	- the mesh is also used for its bound, for CPU ray casting & by GLBatchRenderer,
+//	  so the shapes referring to this geometry are batched.
+
+class SWL_GL_UTIL_API GLMeshGeometry: public Geometry
+{
+public:
+	typedef Geometry base_type;
+
+public:
+	GLMeshGeometry();
+	explicit GLMeshGeometry(const TriangleMesh &mesh);
+	GLMeshGeometry(const GLMeshGeometry &rhs);
+	virtual ~GLMeshGeometry();
+
+	GLMeshGeometry & operator=(const GLMeshGeometry &rhs);
+
+public:
+	/*virtual*/ void draw() const;
+
+	/*virtual*/ const TriangleMesh * getTriangleMesh() const  {  return &mesh_;  }
+
+	/// the shapes referring to this geometry have to be rebuilt in GLBatchRenderer after the mesh is changed.
+	TriangleMesh & getMesh()  {  return mesh_;  }
+	const TriangleMesh & getMesh() const  {  return mesh_;  }
+
+private:
+	TriangleMesh mesh_;
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_GL_UTIL__GL_MESH_GEOMETRY__H_
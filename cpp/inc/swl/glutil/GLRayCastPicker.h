@@ -0,0 +1,92 @@
+#if !defined(__SWL_GL_UTIL__GL_RAY_CAST_PICKER__H_)
+#define __SWL_GL_UTIL__GL_RAY_CAST_PICKER__H_ 1
+
+
+#include "swl/glutil/ExportGLUtil.h"
+#include "swl/glutil/GLCollectShapeVisitor.h"
+#include "swl/graphics/SceneNode.h"
+#include "swl/graphics/BoundingVolumeHierarchy.h"
+#include "swl/graphics/ObjectPickerMgr.h"
+#include "swl/graphics/Ray.h"
+#include <vector>
+
+
+namespace swl {
+
+class ViewCamera3;
+
+//--------------------------------------------------------------------------
+// class GLRayCastPicker: pick shapes by casting a ray on the CPU
+//	- the scene graph is flattened & a bounding volume hierarchy is built over the bounds of the shapes.
+//	- hits are refined with the triangle meshes of the shapes if available, or else with their bounds.
+//	- shapes without a known bound can't be picked.
+//	- no rendering context is required.
+
+class SWL_GL_UTIL_API GLRayCastPicker
+{
+public:
+	//typedef GLRayCastPicker base_type;
+	typedef ISceneNode<IGLSceneVisitor>::node_type node_type;
+	typedef GLShapeInstance::shape_type shape_type;
+	typedef ObjectPickerMgr::object_id_type object_id_type;
+	typedef Ray<double> ray_type;
+
+	struct Hit
+	{
+		Hit()
+		: shape(), objectId(0u), t(0.0)
+		{  point[0] = point[1] = point[2] = 0.0;  }
+
+		shape_type shape;
+		object_id_type objectId;
+		/// the ray parameter & the point hit in object coordinates
+		double t;
+		double point[3];
+	};
+
+public:
+	GLRayCastPicker();
+
+private:
+	GLRayCastPicker(const GLRayCastPicker &rhs);
+	GLRayCastPicker & operator=(const GLRayCastPicker &rhs);
+
+public:
+	/// rebuild after the scene graph is changed.
+	void build(const node_type &root);
+	void clear();
+
+	size_t getShapeCount() const  {  return instances_.size();  }
+
+	/// the nearest shape hit by a ray in object coordinates
+	bool pick(const ray_type &ray, Hit &hit) const;
+	/// the nearest shape under a window point
+	bool pick(const ViewCamera3 &camera, const int x, const int y, Hit &hit) const;
+
+	/// pick the nearest shape under a window point & update ObjectPickerMgr as the selection-mode picking does.
+	/// return true if the picked objects are changed.
+	bool pickObject(const ViewCamera3 &camera, const int x, const int y, const bool isTemporary = false) const;
+	/// update ObjectPickerMgr with a picked object. 0 means that nothing is picked.
+	/// return true if the picked objects are changed.
+	static bool updatePickedObjects(const object_id_type pickedObj, const bool isTemporary);
+
+	/// a ray from the near plane to the far plane through a window point
+	static bool calcPickingRay(const ViewCamera3 &camera, const int x, const int y, ray_type &ray);
+	/// the same id as the one pushed on the name stack by a shape
+	static object_id_type getObjectId(const GLShape *shape);
+
+private:
+	std::vector<GLShapeInstance> instances_;
+	std::vector<GLShapeInstance::transform_type> inverseTransforms_;
+	// the local bounds of the shapes
+	std::vector<GLShapeInstance::bound_type> localBounds_;
+	// indices of the instances with a known bound
+	std::vector<size_t> boundedInstances_;
+
+	BoundingVolumeHierarchy<double> hierarchy_;
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_GL_UTIL__GL_RAY_CAST_PICKER__H_
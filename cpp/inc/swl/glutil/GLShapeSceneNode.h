@@ -19,6 +19,7 @@ public:
 	typedef boost::shared_ptr<GLShape> shape_type;
 	typedef GLShape::geometry_type geometry_type;
 	typedef GLShape::appearance_type appearance_type;
+	typedef typename base_type::bound_type bound_type;
 	typedef typename base_type::visitor_type visitor_type;
 
 public:
@@ -42,6 +43,7 @@ public:
 		if (this == &rhs) return *this;
 		static_cast<base_type &>(*this) = rhs;
 		shape_ = rhs.shape_;
+		this->invalidateBound();
 		return *this;
 	}
 
@@ -51,9 +53,16 @@ public:
 		visitor.visit(*this);
 	}
 
+	// call invalidateBound() after the extent of the shape is changed.
 	shape_type & getShape()  {  return shape_;  }
 	const shape_type & getShape() const  {  return shape_;  }
 
+protected:
+	/*virtual*/ bool doCalculateBound(bound_type &bound) const
+	{
+		return shape_ ? shape_->getBound(bound) : false;
+	}
+
 private:
 	shape_type shape_;
 };
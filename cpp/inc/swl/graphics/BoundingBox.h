@@ -26,12 +26,16 @@ public:
 	{}
 	explicit BoundingBox(const T lowerArr[3], const T upperArr[3])
 	: //base_type(),
-	  bound_(lowerArr, upperArr)
+	  bound_(lowerArr[0], lowerArr[1], lowerArr[2], upperArr[0], upperArr[1], upperArr[2])
 	{}
 	explicit BoundingBox(const T boundArr[6])
-	: swObject(),
+	: //base_type(),
 	  bound_(boundArr)
 	{}
+	explicit BoundingBox(const Region3<T> &bound)
+	: //base_type(),
+	  bound_(bound)
+	{}
 	BoundingBox(const BoundingBox<T>& rhs)
 	: //base_type(rhs),
 	  bound_(rhs.bound_)
@@ -47,74 +51,128 @@ public:
 	}
 
 public:
-    /// union bounding boxes             
+    /// union bounding boxes
 	BoundingBox<T> operator|(const BoundingBox<T> &rhs) const
-	{  return bound_ | rhs.bound_;  }
+	{  return BoundingBox<T>(bound_ | rhs.bound_);  }
 	BoundingBox<T> & operator|=(const BoundingBox<T> &rhs)
-	{  return (bound_ |= rhs.bound_);  }
-	
-    /// intersect bounding boxes               
+	{
+		bound_ |= rhs.bound_;
+		return *this;
+	}
+
+    /// intersect bounding boxes
 	BoundingBox<T> operator&(const BoundingBox<T> &rhs) const
-	{  return bound_ & rhs.bound_;  }
+	{  return BoundingBox<T>(bound_ & rhs.bound_);  }
 	BoundingBox<T> & operator&=(const BoundingBox<T> &rhs)
-	{  return (bound_ &= rhs.bound_);  }
+	{
+		bound_ &= rhs.bound_;
+		return *this;
+	}
 
 	///
 	void set(const T lower[3], const T upper[3])
-	{  bound_ = Region3<T>(lower, upper);  }
-	void get(T lower[3], T upper[3])
+	{  bound_ = Region3<T>(lower[0], lower[1], lower[2], upper[0], upper[1], upper[2]);  }
+	void get(T lower[3], T upper[3]) const
 	{
-		for (int i=0 ; i<3 ; ++i)
-		{
-			lower[i] = bound_.lower[i];
-			upper[i] = bound_.upper[i];
-		}
+		lower[0] = bound_.left;  lower[1] = bound_.bottom;  lower[2] = bound_.front;
+		upper[0] = bound_.right;  upper[1] = bound_.top;  upper[2] = bound_.rear;
+	}
+
+	const Region3<T> & getRegion() const  {  return bound_;  }
+
+	/// the i-th coordinate of the lower & upper corners
+	T getLower(const int i) const  {  return 0 == i ? bound_.left : (1 == i ? bound_.bottom : bound_.front);  }
+	T getUpper(const int i) const  {  return 0 == i ? bound_.right : (1 == i ? bound_.top : bound_.rear);  }
+
+	/// a degenerate(flat) box is still valid
+	bool isValid() const
+	{  return bound_.left <= bound_.right && bound_.bottom <= bound_.top && bound_.front <= bound_.rear;  }
+
+	bool isOverlapped(const BoundingBox<T> &rhs) const
+	{
+		return bound_.left <= rhs.bound_.right && rhs.bound_.left <= bound_.right &&
+			bound_.bottom <= rhs.bound_.top && rhs.bound_.bottom <= bound_.top &&
+			bound_.front <= rhs.bound_.rear && rhs.bound_.front <= bound_.rear;
+	}
+	bool isIncluded(const T pt[3]) const
+	{
+		return bound_.left <= pt[0] && pt[0] <= bound_.right &&
+			bound_.bottom <= pt[1] && pt[1] <= bound_.top &&
+			bound_.front <= pt[2] && pt[2] <= bound_.rear;
 	}
 
 	///
 	void updateBound(const TMatrix3<T> &rTMat)
 	{  *this = calcAxisAlignedBox(rTMat);  }
+	/// the axis-aligned box enclosing this box transformed by a matrix
+	BoundingBox<T> transform(const TMatrix3<T> &rTMat) const
+	{  return calcAxisAlignedBox(rTMat);  }
 
 	///
-	void center(T centerArr[3])
+	void center(T centerArr[3]) const
+	{
+		centerArr[0] = bound_.getCenterX();
+		centerArr[1] = bound_.getCenterY();
+		centerArr[2] = bound_.getCenterZ();
+	}
+	T diagonal() const
+	{
+		const T dx = bound_.right - bound_.left, dy = bound_.top - bound_.bottom, dz = bound_.rear - bound_.front;
+		return (T)std::sqrt(dx*dx + dy*dy + dz*dz);
+	}
+	/// half of the surface area
+	T halfArea() const
 	{
-		centerArr[0] = bound_.centerX();
-		centerArr[1] = bound_.centerY();
-		centerArr[2] = bound_.centerZ();
+		const T dx = bound_.right - bound_.left, dy = bound_.top - bound_.bottom, dz = bound_.rear - bound_.front;
+		return dx*dy + dy*dz + dz*dx;
 	}
-	T diagonal()
-	{  return bound_.diagonal();  }
 
 protected:
-	BoundingBox<T> calcAxisAlignedBox(const TMatrix3<T> &mat)
+	BoundingBox<T> calcAxisAlignedBox(const TMatrix3<T> &mat) const
 	{
-		Vector3<T> vertexArr[8];
-		getAllVertices(vertexArr);
-		for (int i = 0 ; i < 8 ; ++i) vertexArr[i] = mat * vertexArr[i];
-
-		T minArr[3], maxArr[3];
-		for (int i = 0 ; i < 3 ; ++i) minArr[i] = maxArr[i] = vertexArr[0][i];
-
-		for (int i = 1 ; i < 8 ; ++i)
+		// Arvo's method: each output extent is the sum of the extremes of the rotated input extents.
+		const T rot[3][3] = {
+			{ mat.X().x(), mat.Y().x(), mat.Z().x() },
+			{ mat.X().y(), mat.Y().y(), mat.Z().y() },
+			{ mat.X().z(), mat.Y().z(), mat.Z().z() },
+		};
+		T lower[3], upper[3];
+		get(lower, upper);
+
+		T minArr[3] = { mat.T().x(), mat.T().y(), mat.T().z() };
+		T maxArr[3] = { minArr[0], minArr[1], minArr[2] };
+		for (int i = 0 ; i < 3 ; ++i)
+		{
 			for (int j = 0 ; j < 3 ; ++j)
 			{
-				if (minArr[j] > vertexArr[i][j]) minArr[j] = vertexArr[i][j];
-				else if (maxArr[j] < vertexArr[i][j]) maxArr[j] = vertexArr[i][j];
+				const T a = rot[i][j] * lower[j];
+				const T b = rot[i][j] * upper[j];
+				if (a < b)
+				{
+					minArr[i] += a;
+					maxArr[i] += b;
+				}
+				else
+				{
+					minArr[i] += b;
+					maxArr[i] += a;
+				}
 			}
+		}
 
 		return BoundingBox<T>(minArr, maxArr);
 	}
 
-	void getAllVertices(Vector3<T> vertexArr[8])
+	void getAllVertices(Vector3<T> vertexArr[8]) const
 	{
-		vertexArr[0].x() = bound_.lower[0];  vertexArr[0].y() = bound_.lower[1];  vertexArr[0].z() = bound_.lower[2];
-		vertexArr[1].x() = bound_.lower[0];  vertexArr[1].y() = bound_.upper[1];  vertexArr[1].z() = bound_.lower[2];
-		vertexArr[2].x() = bound_.upper[0];  vertexArr[2].y() = bound_.upper[1];  vertexArr[2].z() = bound_.lower[2];
-		vertexArr[3].x() = bound_.upper[0];  vertexArr[3].y() = bound_.lower[1];  vertexArr[3].z() = bound_.lower[2];
-		vertexArr[4].x() = bound_.lower[0];  vertexArr[4].y() = bound_.lower[1];  vertexArr[4].z() = bound_.upper[2];
-		vertexArr[5].x() = bound_.lower[0];  vertexArr[5].y() = bound_.upper[1];  vertexArr[5].z() = bound_.upper[2];
-		vertexArr[6].x() = bound_.upper[0];  vertexArr[6].y() = bound_.upper[1];  vertexArr[6].z() = bound_.upper[2];
-		vertexArr[7].x() = bound_.upper[0];  vertexArr[7].y() = bound_.lower[1];  vertexArr[7].z() = bound_.upper[2];
+		vertexArr[0].x() = bound_.left;  vertexArr[0].y() = bound_.bottom;  vertexArr[0].z() = bound_.front;
+		vertexArr[1].x() = bound_.left;  vertexArr[1].y() = bound_.top;  vertexArr[1].z() = bound_.front;
+		vertexArr[2].x() = bound_.right;  vertexArr[2].y() = bound_.top;  vertexArr[2].z() = bound_.front;
+		vertexArr[3].x() = bound_.right;  vertexArr[3].y() = bound_.bottom;  vertexArr[3].z() = bound_.front;
+		vertexArr[4].x() = bound_.left;  vertexArr[4].y() = bound_.bottom;  vertexArr[4].z() = bound_.rear;
+		vertexArr[5].x() = bound_.left;  vertexArr[5].y() = bound_.top;  vertexArr[5].z() = bound_.rear;
+		vertexArr[6].x() = bound_.right;  vertexArr[6].y() = bound_.top;  vertexArr[6].z() = bound_.rear;
+		vertexArr[7].x() = bound_.right;  vertexArr[7].y() = bound_.bottom;  vertexArr[7].z() = bound_.rear;
 	}
 
 private:
@@ -0,0 +1,304 @@
+#if !defined(__SWL_GRAPHICS__BOUNDING_VOLUME_HIERARCHY__H_)
+#define __SWL_GRAPHICS__BOUNDING_VOLUME_HIERARCHY__H_ 1
+
+
+#include "swl/graphics/BoundingBox.h"
+#include "swl/graphics/Frustum.h"
+#include "swl/graphics/Ray.h"
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+
+namespace swl {
+
+//-----------------------------------------------------------------------------------------
+// class BoundingVolumeHierarchy: a binary tree of axis-aligned bounding boxes
+//	- nodes are stored in a flat array in depth-first order. the left child of an interior node follows it.
+//	- items are referred to by their indices in the array of boxes given at build time.
+//	- built top-down by splitting at the median of the box centers along the longest axis.
+
+template <typename T>
+class BoundingVolumeHierarchy
+{
+public:
+	//typedef BoundingVolumeHierarchy	base_type;
+	typedef T							value_type;
+	typedef BoundingBox<T>				bound_type;
+	typedef std::size_t					index_type;
+
+private:
+	struct Node
+	{
+		bound_type bound;
+		// interior node: the index of the right child. leaf node: the index of the first item.
+		index_type offset;
+		// 0 for an interior node.
+		index_type itemCount;
+	};
+
+	struct CenterLess
+	{
+		CenterLess(const std::vector<T> &centers, const int axis)
+		: centers_(centers), axis_(axis)
+		{}
+
+		bool operator()(const index_type lhs, const index_type rhs) const
+		{  return centers_[3 * lhs + axis_] < centers_[3 * rhs + axis_];  }
+
+	private:
+		const std::vector<T> &centers_;
+		const int axis_;
+	};
+
+public:
+	explicit BoundingVolumeHierarchy(const index_type maxLeafItemCount = 4)
+	: maxLeafItemCount_(0 == maxLeafItemCount ? 1 : maxLeafItemCount), nodes_(), itemIndices_(), itemBounds_()
+	{}
+	BoundingVolumeHierarchy(const BoundingVolumeHierarchy &rhs)
+	: maxLeafItemCount_(rhs.maxLeafItemCount_), nodes_(rhs.nodes_), itemIndices_(rhs.itemIndices_), itemBounds_(rhs.itemBounds_)
+	{}
+	~BoundingVolumeHierarchy()  {}
+
+	BoundingVolumeHierarchy & operator=(const BoundingVolumeHierarchy &rhs)
+	{
+		if (this == &rhs) return *this;
+		maxLeafItemCount_ = rhs.maxLeafItemCount_;
+		nodes_ = rhs.nodes_;
+		itemIndices_ = rhs.itemIndices_;
+		itemBounds_ = rhs.itemBounds_;
+		return *this;
+	}
+
+public:
+	void build(const std::vector<bound_type> &bounds)
+	{
+		clear();
+		if (bounds.empty()) return;
+
+		const index_type count = bounds.size();
+		std::vector<T> centers(3 * count);
+		itemIndices_.resize(count);
+		for (index_type i = 0; i < count; ++i)
+		{
+			bounds[i].center(&centers[3 * i]);
+			itemIndices_[i] = i;
+		}
+		nodes_.reserve(2 * (count / maxLeafItemCount_ + 1));
+
+		buildNode(bounds, centers, 0, count);
+
+		// the bounds of items in the order of leaves
+		itemBounds_.reserve(count);
+		for (index_type i = 0; i < count; ++i)
+			itemBounds_.push_back(bounds[itemIndices_[i]]);
+	}
+
+	void clear()
+	{
+		nodes_.clear();
+		itemIndices_.clear();
+		itemBounds_.clear();
+	}
+
+	bool isEmpty() const  {  return nodes_.empty();  }
+	index_type getNodeCount() const  {  return nodes_.size();  }
+	index_type getItemCount() const  {  return itemIndices_.size();  }
+
+	/// the bound of all the items
+	bool getBound(bound_type &bound) const
+	{
+		if (nodes_.empty()) return false;
+		bound = nodes_.front().bound;
+		return true;
+	}
+
+	/// collect the items whose bounds are not outside a frustum
+	void query(const Frustum<T> &frustum, std::vector<index_type> &items) const
+	{
+		if (nodes_.empty()) return;
+
+		std::vector<index_type> stack;
+		stack.reserve(64);
+		stack.push_back(0);
+		while (!stack.empty())
+		{
+			const index_type nodeIndex = stack.back();
+			stack.pop_back();
+
+			const typename Frustum<T>::Side side = frustum.classify(nodes_[nodeIndex].bound);
+			if (Frustum<T>::OUTSIDE == side) continue;
+			if (Frustum<T>::INSIDE == side)
+			{
+				// a contained subtree is accepted without further tests
+				collectItems(nodeIndex, items);
+				continue;
+			}
+
+			const Node &node = nodes_[nodeIndex];
+			if (node.itemCount > 0)
+			{
+				for (index_type i = node.offset; i < node.offset + node.itemCount; ++i)
+					if (!frustum.isCulled(itemBounds_[i])) items.push_back(itemIndices_[i]);
+			}
+			else
+			{
+				stack.push_back(node.offset);
+				stack.push_back(nodeIndex + 1);
+			}
+		}
+	}
+
+	/// collect the items whose bounds overlap a box
+	void query(const bound_type &box, std::vector<index_type> &items) const
+	{
+		if (nodes_.empty()) return;
+
+		std::vector<index_type> stack;
+		stack.reserve(64);
+		stack.push_back(0);
+		while (!stack.empty())
+		{
+			const index_type nodeIndex = stack.back();
+			stack.pop_back();
+
+			const Node &node = nodes_[nodeIndex];
+			if (!node.bound.isOverlapped(box)) continue;
+			if (node.itemCount > 0)
+			{
+				for (index_type i = node.offset; i < node.offset + node.itemCount; ++i)
+					if (itemBounds_[i].isOverlapped(box)) items.push_back(itemIndices_[i]);
+			}
+			else
+			{
+				stack.push_back(node.offset);
+				stack.push_back(nodeIndex + 1);
+			}
+		}
+	}
+
+	/// find the nearest item hit by a ray in [0, tHit].
+	/// intersector(item, ray, tHit) returns true & decreases tHit if the item is hit closer than tHit.
+	/// nodes are visited front to back & the ones beyond the nearest hit so far are skipped.
+	template <typename Intersector>
+	bool intersect(const Ray<T> &ray, Intersector &intersector, T &tHit) const
+	{
+		if (nodes_.empty()) return false;
+
+		T tNear;
+		if (!ray.intersect(nodes_.front().bound, T(0), tHit, tNear)) return false;
+
+		bool isHit = false;
+		std::vector<std::pair<T, index_type> > stack;
+		stack.reserve(64);
+		stack.push_back(std::make_pair(tNear, index_type(0)));
+		while (!stack.empty())
+		{
+			const std::pair<T, index_type> entry(stack.back());
+			stack.pop_back();
+			if (entry.first > tHit) continue;
+
+			const Node &node = nodes_[entry.second];
+			if (node.itemCount > 0)
+			{
+				for (index_type i = node.offset; i < node.offset + node.itemCount; ++i)
+					if (ray.intersect(itemBounds_[i], T(0), tHit, tNear) && intersector(itemIndices_[i], ray, tHit))
+						isHit = true;
+			}
+			else
+			{
+				const index_type leftIndex = entry.second + 1, rightIndex = node.offset;
+				T tLeft, tRight;
+				const bool isLeftHit = ray.intersect(nodes_[leftIndex].bound, T(0), tHit, tLeft);
+				const bool isRightHit = ray.intersect(nodes_[rightIndex].bound, T(0), tHit, tRight);
+				// the nearer child is popped first
+				if (isLeftHit && isRightHit)
+				{
+					if (tLeft <= tRight)
+					{
+						stack.push_back(std::make_pair(tRight, rightIndex));
+						stack.push_back(std::make_pair(tLeft, leftIndex));
+					}
+					else
+					{
+						stack.push_back(std::make_pair(tLeft, leftIndex));
+						stack.push_back(std::make_pair(tRight, rightIndex));
+					}
+				}
+				else if (isLeftHit) stack.push_back(std::make_pair(tLeft, leftIndex));
+				else if (isRightHit) stack.push_back(std::make_pair(tRight, rightIndex));
+			}
+		}
+
+		return isHit;
+	}
+
+private:
+	index_type buildNode(const std::vector<bound_type> &bounds, const std::vector<T> &centers, const index_type first, const index_type last)
+	{
+		const index_type nodeIndex = nodes_.size();
+		nodes_.push_back(Node());
+
+		bound_type bound(bounds[itemIndices_[first]]);
+		T centerLower[3] = { centers[3 * itemIndices_[first]], centers[3 * itemIndices_[first] + 1], centers[3 * itemIndices_[first] + 2] };
+		T centerUpper[3] = { centerLower[0], centerLower[1], centerLower[2] };
+		for (index_type i = first + 1; i < last; ++i)
+		{
+			bound |= bounds[itemIndices_[i]];
+			for (int j = 0; j < 3; ++j)
+			{
+				const T c = centers[3 * itemIndices_[i] + j];
+				if (c < centerLower[j]) centerLower[j] = c;
+				else if (c > centerUpper[j]) centerUpper[j] = c;
+			}
+		}
+		nodes_[nodeIndex].bound = bound;
+
+		// the longest axis of the bound of the centers
+		int axis = 0;
+		for (int j = 1; j < 3; ++j)
+			if (centerUpper[j] - centerLower[j] > centerUpper[axis] - centerLower[axis]) axis = j;
+
+		if (last - first <= maxLeafItemCount_ || centerUpper[axis] <= centerLower[axis])
+		{
+			nodes_[nodeIndex].offset = first;
+			nodes_[nodeIndex].itemCount = last - first;
+			return nodeIndex;
+		}
+
+		const index_type middle = first + (last - first) / 2;
+		std::nth_element(itemIndices_.begin() + first, itemIndices_.begin() + middle, itemIndices_.begin() + last, CenterLess(centers, axis));
+
+		buildNode(bounds, centers, first, middle);
+		const index_type rightIndex = buildNode(bounds, centers, middle, last);
+		nodes_[nodeIndex].offset = rightIndex;
+		nodes_[nodeIndex].itemCount = 0;
+		return nodeIndex;
+	}
+
+	void collectItems(const index_type nodeIndex, std::vector<index_type> &items) const
+	{
+		// the items of a subtree are contiguous.
+		index_type lastNode = nodeIndex;
+		while (0 == nodes_[lastNode].itemCount) lastNode = nodes_[lastNode].offset;
+		index_type firstNode = nodeIndex;
+		while (0 == nodes_[firstNode].itemCount) firstNode = firstNode + 1;
+
+		const index_type first = nodes_[firstNode].offset, last = nodes_[lastNode].offset + nodes_[lastNode].itemCount;
+		for (index_type i = first; i < last; ++i)
+			items.push_back(itemIndices_[i]);
+	}
+
+private:
+	index_type maxLeafItemCount_;
+
+	std::vector<Node> nodes_;
+	// the items of each leaf are contiguous in this array.
+	std::vector<index_type> itemIndices_;
+	std::vector<bound_type> itemBounds_;
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_GRAPHICS__BOUNDING_VOLUME_HIERARCHY__H_
@@ -0,0 +1,135 @@
+#if !defined(__SWL_GRAPHICS__FRUSTUM__H_)
+#define __SWL_GRAPHICS__FRUSTUM__H_ 1
+
+
+#include "swl/graphics/BoundingBox.h"
+#include <cmath>
+
+
+namespace swl {
+
+//-----------------------------------------------------------------------------------------
+// class Frustum: a view volume bounded by six planes
+
+template <typename T>
+class Frustum
+{
+public:
+	//typedef Frustum		base_type;
+	typedef T				value_type;
+
+	enum Side { OUTSIDE = 0, INTERSECTING, INSIDE };
+	enum Plane { LEFT_PLANE = 0, RIGHT_PLANE, BOTTOM_PLANE, TOP_PLANE, NEAR_PLANE, FAR_PLANE };
+
+public:
+	Frustum()
+	{
+		// an unbounded frustum: every plane accepts everything
+		for (int i = 0 ; i < 6 ; ++i)
+			planes_[i][0] = planes_[i][1] = planes_[i][2] = planes_[i][3] = T(0);
+	}
+	/// vertices[i] = ( i & 1 ? right : left, i & 2 ? top : bottom, i & 4 ? far : near )
+	/// ==> the clip-space corners ( +-1, +-1, +-1 ) mapped to object coordinates
+	explicit Frustum(const T vertices[8][3])
+	{  set(vertices);  }
+	Frustum(const Frustum<T> &rhs)
+	{  copy(rhs);  }
+	~Frustum()  {}
+
+	Frustum<T> & operator=(const Frustum<T> &rhs)
+	{
+		if (this == &rhs) return *this;
+		copy(rhs);
+		return *this;
+	}
+
+public:
+	void set(const T vertices[8][3])
+	{
+		static const int planeVertices[6][3] = {
+			{ 0, 2, 4 }, { 1, 3, 5 },  // left, right
+			{ 0, 1, 4 }, { 2, 3, 6 },  // bottom, top
+			{ 0, 1, 2 }, { 4, 5, 6 },  // near, far
+		};
+
+		T centroid[3] = { T(0), T(0), T(0) };
+		for (int i = 0 ; i < 8 ; ++i)
+			for (int j = 0 ; j < 3 ; ++j)
+				centroid[j] += vertices[i][j] / T(8);
+
+		for (int i = 0 ; i < 6 ; ++i)
+		{
+			const T *p0 = vertices[planeVertices[i][0]], *p1 = vertices[planeVertices[i][1]], *p2 = vertices[planeVertices[i][2]];
+			const T u[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+			const T v[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+			T *plane = planes_[i];
+			plane[0] = u[1]*v[2] - u[2]*v[1];
+			plane[1] = u[2]*v[0] - u[0]*v[2];
+			plane[2] = u[0]*v[1] - u[1]*v[0];
+			const T norm = (T)std::sqrt(plane[0]*plane[0] + plane[1]*plane[1] + plane[2]*plane[2]);
+			if (norm > T(0))
+			{
+				plane[0] /= norm;  plane[1] /= norm;  plane[2] /= norm;
+			}
+			plane[3] = -(plane[0]*p0[0] + plane[1]*p0[1] + plane[2]*p0[2]);
+
+			// make the normal point into the frustum regardless of the handedness of the vertices
+			if (getSignedDistance(i, centroid) < T(0))
+				for (int j = 0 ; j < 4 ; ++j) plane[j] = -plane[j];
+		}
+	}
+
+	/// a plane is ( a, b, c, d ) with a * x + b * y + c * z + d >= 0 inside
+	const T * getPlane(const int plane) const  {  return planes_[plane];  }
+
+	T getSignedDistance(const int plane, const T pt[3]) const
+	{  return planes_[plane][0] * pt[0] + planes_[plane][1] * pt[1] + planes_[plane][2] * pt[2] + planes_[plane][3];  }
+
+	bool isIncluded(const T pt[3]) const
+	{
+		for (int i = 0 ; i < 6 ; ++i)
+			if (getSignedDistance(i, pt) < T(0)) return false;
+		return true;
+	}
+
+	/// classify a box by the positive & negative vertices of each plane
+	Side classify(const BoundingBox<T> &box) const
+	{
+		T lower[3], upper[3];
+		box.get(lower, upper);
+
+		Side side = INSIDE;
+		for (int i = 0 ; i < 6 ; ++i)
+		{
+			const T *plane = planes_[i];
+			T pVertex[3], nVertex[3];
+			for (int j = 0 ; j < 3 ; ++j)
+			{
+				pVertex[j] = plane[j] >= T(0) ? upper[j] : lower[j];
+				nVertex[j] = plane[j] >= T(0) ? lower[j] : upper[j];
+			}
+
+			if (getSignedDistance(i, pVertex) < T(0)) return OUTSIDE;
+			if (getSignedDistance(i, nVertex) < T(0)) side = INTERSECTING;
+		}
+		return side;
+	}
+	bool isCulled(const BoundingBox<T> &box) const
+	{  return OUTSIDE == classify(box);  }
+
+private:
+	void copy(const Frustum<T> &rhs)
+	{
+		for (int i = 0 ; i < 6 ; ++i)
+			for (int j = 0 ; j < 4 ; ++j)
+				planes_[i][j] = rhs.planes_[i][j];
+	}
+
+private:
+	T planes_[6][4];
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_GRAPHICS__FRUSTUM__H_
@@ -3,10 +3,13 @@
 
 
 #include "swl/graphics/ExportGraphics.h"
+#include "swl/graphics/BoundingBox.h"
 
 
 namespace swl {
 
+class TriangleMesh;
+
 //-----------------------------------------------------------------------------------------
 // class Geometry
 
@@ -24,6 +27,13 @@ public:
 
 public:
 	virtual void draw() const = 0;
+
+	/// the bounding box in the local coordinate frame. return false if it's unknown.
+	/// by default, the bound of the triangle mesh is used.
+	virtual bool getBound(BoundingBox<double> &bound) const;
+
+	/// the triangles used for CPU ray casting & batched rendering. NULL if not available.
+	virtual const TriangleMesh * getTriangleMesh() const;
 };
 
 }  // namespace swl
@@ -20,6 +20,7 @@ public:
 	typedef LeafSceneNode<SceneVisitor> base_type;
 	typedef GeometryPoolMgr::geometry_id_type geometry_id_type;
 	typedef GeometryPoolMgr::geometry_type geometry_type;
+	typedef typename base_type::bound_type bound_type;
 	typedef typename base_type::visitor_type visitor_type;
 
 public:
@@ -43,6 +44,7 @@ public:
 		if (this == &rhs) return *this;
 		static_cast<base_type &>(*this) = rhs;
 		geometryId_ = rhs.geometryId_;
+		this->invalidateBound();
 		return *this;
 	}
 
@@ -60,6 +62,13 @@ public:
 		return GeometryPoolMgr::getInstance().getGeometry(geometryId_);
 	}
 
+protected:
+	/*virtual*/ bool doCalculateBound(bound_type &bound) const
+	{
+		const geometry_type &geometry = getGeometry();
+		return geometry ? geometry->getBound(bound) : false;
+	}
+
 private:
 	geometry_id_type geometryId_;
 };
@@ -0,0 +1,145 @@
+#if !defined(__SWL_GRAPHICS__RAY__H_)
+#define __SWL_GRAPHICS__RAY__H_ 1
+
+
+#include "swl/graphics/BoundingBox.h"
+#include "swl/math/TMatrix.h"
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+
+namespace swl {
+
+//-----------------------------------------------------------------------------------------
+// class Ray: a half-line origin + t * direction, t >= 0
+//	- the direction is not normalized. a ray transformed by an affine map keeps its parameter t.
+
+template <typename T>
+class Ray
+{
+public:
+	//typedef Ray		base_type;
+	typedef T			value_type;
+
+public:
+	Ray()
+	{
+		const T origin[3] = { T(0), T(0), T(0) }, direction[3] = { T(0), T(0), T(1) };
+		set(origin, direction);
+	}
+	Ray(const T origin[3], const T direction[3])
+	{  set(origin, direction);  }
+	Ray(const Ray<T> &rhs)
+	{  set(rhs.origin_, rhs.direction_);  }
+	~Ray()  {}
+
+	Ray<T> & operator=(const Ray<T> &rhs)
+	{
+		if (this == &rhs) return *this;
+		set(rhs.origin_, rhs.direction_);
+		return *this;
+	}
+
+public:
+	void set(const T origin[3], const T direction[3])
+	{
+		for (int i = 0 ; i < 3 ; ++i)
+		{
+			origin_[i] = origin[i];
+			direction_[i] = direction[i];
+			// inf for a zero component works with the slab test
+			invDirection_[i] = direction[i] != T(0) ? T(1) / direction[i] : std::numeric_limits<T>::infinity();
+		}
+	}
+
+	const T * getOrigin() const  {  return origin_;  }
+	const T * getDirection() const  {  return direction_;  }
+
+	void getPoint(const T t, T pt[3]) const
+	{
+		pt[0] = origin_[0] + t * direction_[0];
+		pt[1] = origin_[1] + t * direction_[1];
+		pt[2] = origin_[2] + t * direction_[2];
+	}
+
+	/// the ray transformed by an affine map
+	Ray<T> transform(const TMatrix3<T> &mat) const
+	{
+		const T origin[3] = {
+			mat.X().x() * origin_[0] + mat.Y().x() * origin_[1] + mat.Z().x() * origin_[2] + mat.T().x(),
+			mat.X().y() * origin_[0] + mat.Y().y() * origin_[1] + mat.Z().y() * origin_[2] + mat.T().y(),
+			mat.X().z() * origin_[0] + mat.Y().z() * origin_[1] + mat.Z().z() * origin_[2] + mat.T().z(),
+		};
+		const T direction[3] = {
+			mat.X().x() * direction_[0] + mat.Y().x() * direction_[1] + mat.Z().x() * direction_[2],
+			mat.X().y() * direction_[0] + mat.Y().y() * direction_[1] + mat.Z().y() * direction_[2],
+			mat.X().z() * direction_[0] + mat.Y().z() * direction_[1] + mat.Z().z() * direction_[2],
+		};
+		return Ray<T>(origin, direction);
+	}
+
+	/// slab test. tNear is the entry parameter clamped to [tMin, tMax].
+	bool intersect(const BoundingBox<T> &box, const T tMin, const T tMax, T &tNear) const
+	{
+		T lower[3], upper[3];
+		box.get(lower, upper);
+
+		T t0 = tMin, t1 = tMax;
+		for (int i = 0 ; i < 3 ; ++i)
+		{
+			T tLower = (lower[i] - origin_[i]) * invDirection_[i];
+			T tUpper = (upper[i] - origin_[i]) * invDirection_[i];
+			// NaN from 0 * inf when the origin lies on a slab boundary is ignored by the comparisons
+			if (tLower > tUpper) std::swap(tLower, tUpper);
+			if (tLower > t0) t0 = tLower;
+			if (tUpper < t1) t1 = tUpper;
+			if (t0 > t1) return false;
+		}
+
+		tNear = t0;
+		return true;
+	}
+
+	/// Moller-Trumbore ray-triangle intersection. both sides of a triangle are hit.
+	template <typename U>
+	bool intersect(const U v0[3], const U v1[3], const U v2[3], T &t) const
+	{
+		const T e1[3] = { T(v1[0] - v0[0]), T(v1[1] - v0[1]), T(v1[2] - v0[2]) };
+		const T e2[3] = { T(v2[0] - v0[0]), T(v2[1] - v0[1]), T(v2[2] - v0[2]) };
+		const T p[3] = {
+			direction_[1] * e2[2] - direction_[2] * e2[1],
+			direction_[2] * e2[0] - direction_[0] * e2[2],
+			direction_[0] * e2[1] - direction_[1] * e2[0],
+		};
+		const T det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+		// parallel to the plane of a triangle
+		if (T(0) == det) return false;
+
+		const T invDet = T(1) / det;
+		const T s[3] = { origin_[0] - T(v0[0]), origin_[1] - T(v0[1]), origin_[2] - T(v0[2]) };
+		const T u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * invDet;
+		if (u < T(0) || u > T(1)) return false;
+
+		const T q[3] = {
+			s[1] * e1[2] - s[2] * e1[1],
+			s[2] * e1[0] - s[0] * e1[2],
+			s[0] * e1[1] - s[1] * e1[0],
+		};
+		const T v = (direction_[0] * q[0] + direction_[1] * q[1] + direction_[2] * q[2]) * invDet;
+		if (v < T(0) || u + v > T(1)) return false;
+
+		t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * invDet;
+		return t >= T(0);
+	}
+
+private:
+	T origin_[3];
+	T direction_[3];
+	T invDirection_[3];
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_GRAPHICS__RAY__H_
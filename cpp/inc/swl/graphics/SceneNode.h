@@ -4,8 +4,11 @@
 
 #include "swl/base/IVisitable.h"
 #include "swl/base/LogException.h"
+#include "swl/graphics/BoundingBox.h"
 #include <boost/smart_ptr.hpp>
 #include <list>
+#include <vector>
+#include <algorithm>
 
 
 namespace swl {
@@ -19,6 +22,7 @@ struct ISceneNode: public IVisitable<SceneVisitor>
 public:
 	//typedef ISceneNode					base_type;
 	typedef boost::shared_ptr<ISceneNode>	node_type;
+	typedef BoundingBox<double>				bound_type;
 
 public:
 	virtual ~ISceneNode()  {}
@@ -35,6 +39,19 @@ public:
 
 	virtual bool isRoot() const = 0;
 	virtual bool isLeaf() const = 0;
+
+	/// the bounding box of a subtree in the coordinate frame of its parent.
+	/// return false if the bound is unknown. a node without a known bound is never culled.
+	virtual bool getBound(bound_type &bound) const = 0;
+	/// return true if a node below this one has an unknown bound.
+	/// the bound of the subtree covers only its bounded nodes then, so the subtree is never culled as a whole.
+	virtual bool hasUnboundedDescendants() const = 0;
+	/// mark the cached bound of a node & its ancestors dirty.
+	virtual void invalidateBound() = 0;
+
+	/// parents are linked to their children to propagate the invalidation of bounds.
+	virtual void linkParent(ISceneNode *parent) = 0;
+	virtual void unlinkParent(ISceneNode *parent) = 0;
 };
 
 //--------------------------------------------------------------------------
@@ -46,6 +63,7 @@ class ComponentSceneNode: public ISceneNode<SceneVisitor>
 public:
 	typedef ISceneNode<SceneVisitor> base_type;
 	typedef typename base_type::node_type node_type;
+	typedef typename base_type::bound_type bound_type;
 
 protected:
 #if defined(_UNICODE) || defined(UNICODE)
@@ -54,11 +72,11 @@ protected:
 	ComponentSceneNode(const std::string &name = std::string())
 #endif
 	: base_type(),
-	  parent_(), name_(name)
+	  parent_(), name_(name), linkedParents_(), bound_(), isBoundDirty_(true), isBoundKnown_(false), hasUnboundedDescendants_(false)
 	{}
 	ComponentSceneNode(const ComponentSceneNode &rhs)
 	: base_type(rhs),
-	  parent_(rhs.parent_), name_(rhs.name_)
+	  parent_(rhs.parent_), name_(rhs.name_), linkedParents_(), bound_(), isBoundDirty_(true), isBoundKnown_(false), hasUnboundedDescendants_(false)
 	{}
 public:
 	virtual ~ComponentSceneNode()
@@ -70,6 +88,7 @@ public:
 		static_cast<base_type &>(*this) = rhs;
 		parent_ = rhs.parent_;
 		name_ = rhs.name_;
+		invalidateBound();
 		return *this;
 	}
 
@@ -79,6 +98,37 @@ public:
 
 	/*final*/ /*virtual*/ bool isRoot() const  {  return NULL == parent_.get();  }
 
+	/*final*/ /*virtual*/ bool getBound(bound_type &bound) const
+	{
+		updateBound();
+		if (isBoundKnown_) bound = bound_;
+		return isBoundKnown_;
+	}
+	/*final*/ /*virtual*/ bool hasUnboundedDescendants() const
+	{
+		updateBound();
+		return hasUnboundedDescendants_;
+	}
+	/*final*/ /*virtual*/ void invalidateBound()
+	{
+		// a dirty node has dirty ancestors already.
+		if (isBoundDirty_) return;
+		isBoundDirty_ = true;
+		for (typename std::vector<base_type *>::iterator it = linkedParents_.begin(); it != linkedParents_.end(); ++it)
+			(*it)->invalidateBound();
+	}
+
+	/*final*/ /*virtual*/ void linkParent(base_type *parent)
+	{
+		if (parent) linkedParents_.push_back(parent);
+	}
+	/*final*/ /*virtual*/ void unlinkParent(base_type *parent)
+	{
+		// a node shared several times by the same parent is linked as many times.
+		typename std::vector<base_type *>::iterator it = std::find(linkedParents_.begin(), linkedParents_.end(), parent);
+		if (linkedParents_.end() != it) linkedParents_.erase(it);
+	}
+
 #if defined(_UNICODE) || defined(UNICODE)
 	void setName(const std::wstring &name)  {  name_ = name;  }
 	std::wstring & getName()  {  return name_;  }
@@ -89,6 +139,21 @@ public:
 	const std::string & getName() const  {  return name_;  }
 #endif
 
+protected:
+	/// calculate the bound of a subtree. return false if it's unknown.
+	virtual bool doCalculateBound(bound_type & /*bound*/) const  {  return false;  }
+	/// return true if a node below this one has an unknown bound.
+	virtual bool doFindUnboundedDescendants() const  {  return false;  }
+
+private:
+	void updateBound() const
+	{
+		if (!isBoundDirty_) return;
+		isBoundKnown_ = doCalculateBound(bound_);
+		hasUnboundedDescendants_ = doFindUnboundedDescendants();
+		isBoundDirty_ = false;
+	}
+
 private:
 	node_type parent_;
 
@@ -97,6 +162,14 @@ private:
 #else
 	std::string name_;
 #endif
+
+	std::vector<base_type *> linkedParents_;
+
+	// cached bound
+	mutable bound_type bound_;
+	mutable bool isBoundDirty_;
+	mutable bool isBoundKnown_;
+	mutable bool hasUnboundedDescendants_;
 };
 
 //--------------------------------------------------------------------------
@@ -108,6 +181,7 @@ class GroupSceneNode: public ComponentSceneNode<SceneVisitor>
 public:
 	typedef ComponentSceneNode<SceneVisitor> base_type;
 	typedef typename base_type::node_type node_type;
+	typedef typename base_type::bound_type bound_type;
 	typedef typename base_type::visitor_type visitor_type;
 
 public:
@@ -122,15 +196,22 @@ public:
 	GroupSceneNode(const GroupSceneNode &rhs)
 	: base_type(rhs),
 	  children_(rhs.children_)
-	{}
+	{
+		linkChildren();
+	}
 	virtual ~GroupSceneNode()
-	{}
+	{
+		unlinkChildren();
+	}
 
 	GroupSceneNode & operator=(const GroupSceneNode &rhs)
 	{
 		if (this == &rhs) return *this;
 		static_cast<base_type &>(*this) = rhs;
-		children_.assign(children_.begin(), children_.end());
+		unlinkChildren();
+		children_.assign(rhs.children_.begin(), rhs.children_.end());
+		linkChildren();
+		this->invalidateBound();
 		return *this;
 	}
 
@@ -144,14 +225,22 @@ public:
 	/*final*/ /*virtual*/ void addChild(const node_type &node)
 	{
 		children_.push_back(node);
+		if (node) node->linkParent(this);
+		this->invalidateBound();
 	}
 	/*final*/ /*virtual*/ void removeChild(const node_type &node)
 	{
+		const size_t count = (size_t)std::count(children_.begin(), children_.end(), node);
+		if (node)
+			for (size_t i = 0; i < count; ++i) node->unlinkParent(this);
 		children_.remove(node);
+		this->invalidateBound();
 	}
 	/*final*/ /*virtual*/ void clearChildren()
 	{
+		unlinkChildren();
 		children_.clear();
+		this->invalidateBound();
 	}
 	/*final*/ /*virtual*/ size_t countChildren() const  {  return children_.size();  }
 	/*final*/ /*virtual*/ bool containChildren() const  {  return !children_.empty();  }
@@ -166,7 +255,59 @@ public:
 	}
 	void replace(const node_type &oldNode, const node_type &newNode)
 	{
-		std::replace(children_.begin(), children_.end(), oldNode, newNode);
+		for (typename std::list<node_type>::iterator it = children_.begin(); it != children_.end(); ++it)
+			if (oldNode == *it)
+			{
+				if (oldNode) oldNode->unlinkParent(this);
+				if (newNode) newNode->linkParent(this);
+				*it = newNode;
+			}
+		this->invalidateBound();
+	}
+
+protected:
+	/// the union of the known bounds of the children. unknown only if no child has a bound.
+	/// the children without a bound are reported by hasUnboundedDescendants() instead.
+	/*virtual*/ bool doCalculateBound(bound_type &bound) const
+	{
+		bool isFirst = true;
+		for (typename std::list<node_type>::const_iterator it = children_.begin(); it != children_.end(); ++it)
+		{
+			if (!*it) continue;
+
+			bound_type childBound;
+			if (!(*it)->getBound(childBound)) continue;
+			if (isFirst)
+			{
+				bound = childBound;
+				isFirst = false;
+			}
+			else bound |= childBound;
+		}
+		return !isFirst;
+	}
+	/*virtual*/ bool doFindUnboundedDescendants() const
+	{
+		for (typename std::list<node_type>::const_iterator it = children_.begin(); it != children_.end(); ++it)
+		{
+			if (!*it) continue;
+
+			bound_type childBound;
+			if (!(*it)->getBound(childBound) || (*it)->hasUnboundedDescendants()) return true;
+		}
+		return false;
+	}
+
+private:
+	void linkChildren()
+	{
+		for (typename std::list<node_type>::iterator it = children_.begin(); it != children_.end(); ++it)
+			if (*it) (*it)->linkParent(this);
+	}
+	void unlinkChildren()
+	{
+		for (typename std::list<node_type>::iterator it = children_.begin(); it != children_.end(); ++it)
+			if (*it) (*it)->unlinkParent(this);
 	}
 
 private:
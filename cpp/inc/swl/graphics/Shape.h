@@ -34,6 +34,13 @@ public:
 
 	geometry_type getGeometry() const;
 
+	/// the bounding box in the local coordinate frame. return false if it's unknown.
+	/// by default, the bound of the geometry is used.
+	virtual bool getBound(BoundingBox<double> &bound) const;
+	/// the triangles in the local coordinate frame. NULL if not available.
+	/// by default, the triangle mesh of the geometry is used.
+	virtual const TriangleMesh * getTriangleMesh() const;
+
 	//
 	void setColor(const float r, const float g, const float b, const float a = 1.0f)
 	{  appearance_.setColor(r, g, b, a);;  }
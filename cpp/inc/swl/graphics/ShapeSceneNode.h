@@ -15,10 +15,12 @@ template<typename SceneVisitor>
 class ShapeSceneNode: public LeafSceneNode<SceneVisitor>
 {
 public:
-	typedef LeafSceneNode				base_type;
+	typedef LeafSceneNode<SceneVisitor>	base_type;
 	typedef boost::shared_ptr<Shape>	shape_type;
 	typedef Shape::geometry_type		geometry_type;
 	typedef Shape::appearance_type		appearance_type;
+	typedef typename base_type::bound_type bound_type;
+	typedef typename base_type::visitor_type visitor_type;
 
 public:
 #if defined(_UNICODE) || defined(UNICODE)
@@ -41,6 +43,7 @@ public:
 		if (this == &rhs) return *this;
 		static_cast<base_type &>(*this) = rhs;
 		shape_ = rhs.shape_;
+		this->invalidateBound();
 		return *this;
 	}
 
@@ -50,9 +53,16 @@ public:
 		visitor.visit(*this);
 	}
 
+	// call invalidateBound() after the extent of the shape is changed.
 	shape_type & getShape()  {  return shape_;  }
 	const shape_type & getShape() const  {  return shape_;  }
 
+protected:
+	/*virtual*/ bool doCalculateBound(bound_type &bound) const
+	{
+		return shape_ ? shape_->getBound(bound) : false;
+	}
+
 private:
 	shape_type shape_;
 };
@@ -17,6 +17,7 @@ class TransformSceneNode: public GroupSceneNode<SceneVisitor>
 public:
 	typedef GroupSceneNode<SceneVisitor> base_type;
 	typedef TMatrix3<double> transform_type;
+	typedef typename base_type::bound_type bound_type;
 	typedef typename base_type::visitor_type visitor_type;
 
 public:
@@ -36,6 +37,7 @@ public:
 		if (this == &rhs) return *this;
 		static_cast<base_type &>(*this) = rhs;
 		transform_ = rhs.transform_;
+		this->invalidateBound();
 		return *this;
 	}
 
@@ -45,8 +47,27 @@ public:
 		visitor.visit(*this);
 	}
 
-	transform_type & getTransform()  {  return transform_;  }
+	// the transform may be modified through the returned reference.
+	transform_type & getTransform()
+	{
+		this->invalidateBound();
+		return transform_;
+	}
 	const transform_type & getTransform() const  {  return transform_;  }
+	void setTransform(const transform_type &transform)
+	{
+		transform_ = transform;
+		this->invalidateBound();
+	}
+
+protected:
+	/// the bound of the children transformed into the coordinate frame of the parent.
+	/*virtual*/ bool doCalculateBound(bound_type &bound) const
+	{
+		if (!base_type::doCalculateBound(bound)) return false;
+		bound.updateBound(transform_);
+		return true;
+	}
 
 private:
 	transform_type transform_;
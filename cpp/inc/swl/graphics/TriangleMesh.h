@@ -0,0 +1,72 @@
+#if !defined(__SWL_GRAPHICS__TRIANGLE_MESH__H_)
+#define __SWL_GRAPHICS__TRIANGLE_MESH__H_ 1
+
+
+#include "swl/graphics/ExportGraphics.h"
+#include "swl/graphics/BoundingVolumeHierarchy.h"
+#include "swl/graphics/Ray.h"
+#include <vector>
+
+
+namespace swl {
+
+//-----------------------------------------------------------------------------------------
+// class TriangleMesh: an indexed triangle list
+//	- vertices & normals are packed as (x, y, z) triples. normals are optional.
+//	- three indices per triangle.
+//	- a hierarchy over the triangles is built lazily on the first ray query.
+
+class SWL_GRAPHICS_API TriangleMesh
+{
+public:
+	//typedef TriangleMesh base_type;
+	typedef float value_type;
+	typedef unsigned int index_type;
+	typedef BoundingBox<double> bound_type;
+
+public:
+	TriangleMesh();
+	TriangleMesh(const std::vector<value_type> &vertices, const std::vector<index_type> &indices);
+	TriangleMesh(const TriangleMesh &rhs);
+	~TriangleMesh();
+
+	TriangleMesh & operator=(const TriangleMesh &rhs);
+
+public:
+	void setVertices(const std::vector<value_type> &vertices);
+	void setNormals(const std::vector<value_type> &normals);
+	void setIndices(const std::vector<index_type> &indices);
+	void clear();
+
+	const std::vector<value_type> & getVertices() const  {  return vertices_;  }
+	const std::vector<value_type> & getNormals() const  {  return normals_;  }
+	const std::vector<index_type> & getIndices() const  {  return indices_;  }
+
+	size_t getVertexCount() const  {  return vertices_.size() / 3;  }
+	size_t getTriangleCount() const  {  return indices_.size() / 3;  }
+	bool hasNormals() const  {  return !normals_.empty() && normals_.size() == vertices_.size();  }
+	bool isEmpty() const  {  return indices_.size() < 3;  }
+
+	///
+	bool getBound(bound_type &bound) const;
+
+	/// the nearest triangle hit by a ray in [0, tHit]. tHit is decreased on a hit.
+	bool intersect(const Ray<double> &ray, double &tHit, size_t *triangle = NULL) const;
+
+private:
+	void invalidate();
+	void prepareHierarchy() const;
+
+private:
+	std::vector<value_type> vertices_;
+	std::vector<value_type> normals_;
+	std::vector<index_type> indices_;
+
+	mutable bool isHierarchyDirty_;
+	mutable BoundingVolumeHierarchy<double> hierarchy_;
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_GRAPHICS__TRIANGLE_MESH__H_
@@ -0,0 +1,381 @@
+#if !defined(__SWL_MACHINE_LEARNING__PARALLEL_TD_EPISODE_RUNNER__H_)
+#define __SWL_MACHINE_LEARNING__PARALLEL_TD_EPISODE_RUNNER__H_ 1
+
+
+#include "swl/machine_learning/TDLearningBase.h"
+#include "swl/machine_learning/TDTabularStorage.h"
+#include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/atomic.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/bind.hpp>
+#include <vector>
+#include <exception>
+#include <stdexcept>
+
+
+namespace swl {
+
+//--------------------------------------------------------------------------
+// throughput counters of a parallel TD episode runner.
+
+struct TDEpisodeRunnerStatistics
+{
+public:
+	TDEpisodeRunnerStatistics()
+	: episodeCount(0), stepCount(0), updateCount(0), elapsedTimeInSecond(0.0)
+	{}
+
+public:
+	double getEpisodesPerSecond() const  {  return elapsedTimeInSecond > 0.0 ? double(episodeCount) / elapsedTimeInSecond : 0.0;  }
+	double getStepsPerSecond() const  {  return elapsedTimeInSecond > 0.0 ? double(stepCount) / elapsedTimeInSecond : 0.0;  }
+
+public:
+	std::size_t episodeCount;
+	std::size_t stepCount;
+	std::size_t updateCount;  // the number of applied Q-value updates.
+	double elapsedTimeInSecond;
+};
+
+//--------------------------------------------------------------------------
+// parallel multi-environment episode runner for one-step tabular TD control.
+//	- each worker thread rolls out its own copies of the start state with its own random number generator.
+//	- an epsilon-greedy policy derived from the shared action-value table is used.
+//	- SYNCHRONOUS_BATCH_UPDATE: experiences are gathered into per-worker buffers while Q is read-only & then applied at a barrier.
+//	  the episodes of a round are assigned to the workers in a fixed order, so a run is reproducible for a given seed.
+//	- ASYNCHRONOUS_UPDATE: workers update the shared Q without any lock (Hogwild-style).
+//	  an update is an atomic add, so no update is lost, but its TD target may be computed from stale values.
+//	- an exception thrown in a worker stops all the workers & is rethrown from train().
+
+template<typename StateActionPair>
+class ParallelTDEpisodeRunner: public TDLearningBase
+{
+public:
+	typedef TDLearningBase base_type;
+	typedef StateActionPair state_action_pair_type;
+	typedef typename state_action_pair_type::state_type state_type;
+	typedef typename state_action_pair_type::action_type action_type;
+	typedef typename state_action_pair_type::reward_type reward_type;
+	typedef DenseActionValueTable<state_action_pair_type> action_value_table_type;
+
+	enum UPDATE_RULE { SARSA_UPDATE = 0, Q_LEARNING_UPDATE };
+	enum UPDATE_MODE { SYNCHRONOUS_BATCH_UPDATE = 0, ASYNCHRONOUS_UPDATE };
+
+private:
+	struct Experience
+	{
+		std::size_t currIndex;  // the index of (s, a).
+		std::size_t nextIndex;  // the index of (s', a') for Sarsa or (s', argmax_a Q(s', a)) for Q-learning.
+		std::size_t step;
+		double reward;
+	};
+
+	struct Worker
+	{
+		Worker(const std::size_t workerIndex, const unsigned int seed)
+		: index(workerIndex), rng(seed), experiences(), stepCount(0), episodeCount(0)
+		{}
+
+		std::size_t index;
+		boost::random::mt19937 rng;
+		std::vector<Experience> experiences;
+		std::size_t stepCount;
+		std::size_t episodeCount;
+	};
+
+	// the action-value table shared by the workers.
+	//	- it has the same layout as DenseActionValueTable.
+	//	- the entries are read & written with relaxed atomic operations, which compile to plain loads & stores on common platforms.
+	class SharedActionValueTable
+	{
+	public:
+		explicit SharedActionValueTable(const action_value_table_type &Q)
+		: values_(new boost::atomic<double>[action_value_table_type::TABLE_SIZE])
+		{
+			for (std::size_t i = 0; i < action_value_table_type::TABLE_SIZE; ++i)
+				values_[i].store(Q[i], boost::memory_order_relaxed);
+		}
+
+	private:
+		SharedActionValueTable(const SharedActionValueTable &rhs);
+		SharedActionValueTable & operator=(const SharedActionValueTable &rhs);
+
+	public:
+		double load(const std::size_t index) const  {  return values_[index].load(boost::memory_order_relaxed);  }
+		// Q(s, a) += delta by a compare-and-swap loop.
+		void add(const std::size_t index, const double delta)
+		{
+			double expected = values_[index].load(boost::memory_order_relaxed);
+			while (!values_[index].compare_exchange_weak(expected, expected + delta, boost::memory_order_relaxed))
+				;
+		}
+
+		// the first of the maximal actions, as DenseActionValueTable::getGreedyAction().
+		action_type getGreedyAction(const state_type &state) const
+		{
+			const std::size_t first = std::size_t(state.getValue()) * action_type::ACTION_SIZE;
+			std::size_t greedy = 0;
+			double maxValue = load(first);
+			for (std::size_t a = 1; a < action_type::ACTION_SIZE; ++a)
+			{
+				const double value = load(first + a);
+				if (value > maxValue)
+				{
+					maxValue = value;
+					greedy = a;
+				}
+			}
+			return action_type(static_cast<typename action_type::value_type>(greedy));
+		}
+
+		void copyTo(action_value_table_type &Q) const
+		{
+			for (std::size_t i = 0; i < action_value_table_type::TABLE_SIZE; ++i)
+				Q[i] = load(i);
+		}
+
+	private:
+		boost::scoped_array<boost::atomic<double> > values_;
+	};
+
+	struct Context
+	{
+		Context(const std::size_t maxEpisodeCount, const state_type &startState, const action_value_table_type &Q, const std::size_t workerCount)
+		: maxEpisodeCount(maxEpisodeCount), startState(startState), Q(Q), workers(), nextEpisode(1), barrier((unsigned int)workerCount), isDone(false), updateCount(0), isFailed(false), mutex(), exception()
+		{}
+
+		// keeps the first exception only.
+		void fail(const std::exception_ptr &ex)
+		{
+			boost::mutex::scoped_lock lock(mutex);
+			if (!exception) exception = ex;
+			isFailed.store(true);
+		}
+
+		const std::size_t maxEpisodeCount;
+		const state_type &startState;
+		SharedActionValueTable Q;
+		std::vector<Worker> workers;
+
+		boost::atomic<std::size_t> nextEpisode;  // for ASYNCHRONOUS_UPDATE.
+		boost::barrier barrier;
+		bool isDone;
+		std::size_t updateCount;
+
+		boost::atomic<bool> isFailed;
+		boost::mutex mutex;
+		std::exception_ptr exception;
+	};
+
+public:
+	explicit ParallelTDEpisodeRunner(const double gamma, const std::size_t workerCount, const UPDATE_RULE updateRule, const UPDATE_MODE updateMode)
+	: base_type(gamma), workerCount_(0 == workerCount ? 1 : workerCount), updateRule_(updateRule), updateMode_(updateMode), episodesPerRound_(1), maxStepCount_(0), seed_(0)
+	{}
+	explicit ParallelTDEpisodeRunner(const double gamma, epsilon_function_type epsilonFunc, step_size_function_type stepSizeFunc, const std::size_t workerCount, const UPDATE_RULE updateRule, const UPDATE_MODE updateMode)
+	: base_type(gamma, epsilonFunc, stepSizeFunc), workerCount_(0 == workerCount ? 1 : workerCount), updateRule_(updateRule), updateMode_(updateMode), episodesPerRound_(1), maxStepCount_(0), seed_(0)
+	{}
+	explicit ParallelTDEpisodeRunner(const ParallelTDEpisodeRunner &rhs)
+	: base_type(rhs), workerCount_(rhs.workerCount_), updateRule_(rhs.updateRule_), updateMode_(rhs.updateMode_), episodesPerRound_(rhs.episodesPerRound_), maxStepCount_(rhs.maxStepCount_), seed_(rhs.seed_)
+	{}
+
+private:
+	ParallelTDEpisodeRunner & operator=(const ParallelTDEpisodeRunner &rhs);
+
+public:
+	// the number of episodes each worker runs between two synchronous batch updates.
+	void setEpisodesPerRound(const std::size_t episodesPerRound)  {  episodesPerRound_ = 0 == episodesPerRound ? 1 : episodesPerRound;  }
+	// 0 means no limit.
+	void setMaxStepCount(const std::size_t maxStepCount)  {  maxStepCount_ = maxStepCount;  }
+	// worker i uses seed + i.
+	void setSeed(const unsigned int seed)  {  seed_ = seed;  }
+
+	std::size_t getWorkerCount() const  {  return workerCount_;  }
+
+	TDEpisodeRunnerStatistics train(const std::size_t maxEpisodeCount, const state_type &startState, action_value_table_type &Q) const
+	{
+		if (!startState.isValidState())
+			throw std::runtime_error("invalid state");
+
+		Context context(maxEpisodeCount, startState, Q, workerCount_);
+		context.workers.reserve(workerCount_);
+		for (std::size_t i = 0; i < workerCount_; ++i)
+			context.workers.push_back(Worker(i, seed_ + (unsigned int)i));
+
+		const boost::posix_time::ptime startTime(boost::posix_time::microsec_clock::universal_time());
+		{
+			boost::thread_group threads;
+			for (std::size_t i = 1; i < workerCount_; ++i)
+				threads.create_thread(boost::bind(&ParallelTDEpisodeRunner::runWorker, this, boost::ref(context), i));
+			// the calling thread works as worker #0.
+			runWorker(context, 0);
+			threads.join_all();
+		}
+		const boost::posix_time::time_duration elapsed(boost::posix_time::microsec_clock::universal_time() - startTime);
+
+		// Q holds the updates applied before a failure, too.
+		context.Q.copyTo(Q);
+		if (context.exception)
+			std::rethrow_exception(context.exception);
+
+		TDEpisodeRunnerStatistics stats;
+		for (typename std::vector<Worker>::const_iterator cit = context.workers.begin(); cit != context.workers.end(); ++cit)
+		{
+			stats.episodeCount += cit->episodeCount;
+			stats.stepCount += cit->stepCount;
+		}
+		stats.updateCount = ASYNCHRONOUS_UPDATE == updateMode_ ? stats.stepCount : context.updateCount;
+		stats.elapsedTimeInSecond = elapsed.total_microseconds() * 1.0e-6;
+		return stats;
+	}
+
+private:
+	void runWorker(Context &context, const std::size_t workerIndex) const
+	{
+		Worker &worker = context.workers[workerIndex];
+
+		if (ASYNCHRONOUS_UPDATE == updateMode_)
+		{
+			try
+			{
+				std::size_t episode;
+				while (!context.isFailed.load() && (episode = context.nextEpisode.fetch_add(1)) <= context.maxEpisodeCount)
+					runSingleEpisode(episode, context, worker);
+			}
+			catch (...)
+			{
+				context.fail(std::current_exception());
+			}
+			return;
+		}
+
+		// the first episode of the current round.
+		std::size_t roundEpisode = 1;
+		while (true)
+		{
+			// roll out episodes against a read-only Q.
+			//	worker i runs episodes [roundEpisode + i * episodesPerRound_, roundEpisode + (i + 1) * episodesPerRound_) of the round.
+			try
+			{
+				const std::size_t firstEpisode = roundEpisode + workerIndex * episodesPerRound_;
+				for (std::size_t episode = firstEpisode; episode < firstEpisode + episodesPerRound_ && episode <= context.maxEpisodeCount; ++episode)
+				{
+					if (context.isFailed.load()) break;
+					runSingleEpisode(episode, context, worker);
+				}
+			}
+			catch (...)
+			{
+				context.fail(std::current_exception());
+			}
+			roundEpisode += workerCount_ * episodesPerRound_;
+
+			// every worker has to reach both barriers in every round, even after a failure.
+			context.barrier.wait();
+			if (0 == workerIndex)
+			{
+				try
+				{
+					// apply all the gathered experiences in worker order.
+					if (!context.isFailed.load())
+						for (typename std::vector<Worker>::iterator it = context.workers.begin(); it != context.workers.end(); ++it)
+						{
+							for (typename std::vector<Experience>::const_iterator cit = it->experiences.begin(); cit != it->experiences.end(); ++cit)
+								applyExperience(*cit, context.Q);
+							context.updateCount += it->experiences.size();
+							it->experiences.clear();
+						}
+				}
+				catch (...)
+				{
+					context.fail(std::current_exception());
+				}
+				context.isDone = context.isFailed.load() || roundEpisode > context.maxEpisodeCount;
+			}
+			context.barrier.wait();
+
+			if (context.isDone) break;
+		}
+	}
+
+	void runSingleEpisode(const std::size_t episodeTrial, Context &context, Worker &worker) const
+	{
+		const double epsilon = (*epsilonFunction_)(episodeTrial);
+		SharedActionValueTable &Q = context.Q;
+
+		// initialize a state s
+		state_type currState(context.startState);
+		// choose a from s using policy derived from Q
+		action_type currAction(selectAction(currState, Q, epsilon, worker.rng));
+
+		std::size_t step = 1;
+		while (true)
+		{
+			// take action & get a next state s'
+			const state_type &nextState(currState.takeAction(currAction));
+			if (!nextState.isValidState())
+				throw std::runtime_error("invalid state");
+			// get a reward r
+			const reward_type &r(nextState.getReward());
+			// choose a' from s' using policy derived from Q
+			const action_type &nextAction(selectAction(nextState, Q, epsilon, worker.rng));
+
+			Experience experience;
+			experience.currIndex = action_value_table_type::getIndex(currState, currAction);
+			experience.nextIndex = action_value_table_type::getIndex(nextState, Q_LEARNING_UPDATE == updateRule_ ? Q.getGreedyAction(nextState) : nextAction);
+			experience.step = step;
+			experience.reward = double(r);
+
+			if (ASYNCHRONOUS_UPDATE == updateMode_)
+				applyExperience(experience, Q);
+			else
+				worker.experiences.push_back(experience);
+
+			// update the current state & action
+			currState = nextState;
+			currAction = nextAction;
+
+			++step;
+
+			// check termination
+			if (currState.isTerminalState() || (maxStepCount_ > 0 && step > maxStepCount_))
+				break;
+		}
+
+		worker.stepCount += step - 1;
+		++worker.episodeCount;
+	}
+
+	void applyExperience(const Experience &experience, SharedActionValueTable &Q) const
+	{
+		Q.add(experience.currIndex, (*stepSizeFunction_)(experience.step) * (experience.reward + gamma_ * Q.load(experience.nextIndex) - Q.load(experience.currIndex)));
+	}
+
+	action_type selectAction(const state_type &state, const SharedActionValueTable &Q, const double epsilon, boost::random::mt19937 &rng) const
+	{
+		boost::random::uniform_real_distribution<double> probDist(0.0, 1.0);
+		if (probDist(rng) < 1.0 - epsilon)
+			return Q.getGreedyAction(state);
+
+		boost::random::uniform_int_distribution<std::size_t> actionDist(0, action_type::ACTION_SIZE - 1);
+		return action_type(static_cast<typename action_type::value_type>(actionDist(rng)));
+	}
+
+private:
+	const std::size_t workerCount_;
+	const UPDATE_RULE updateRule_;
+	const UPDATE_MODE updateMode_;
+
+	std::size_t episodesPerRound_;
+	std::size_t maxStepCount_;
+	unsigned int seed_;
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_MACHINE_LEARNING__PARALLEL_TD_EPISODE_RUNNER__H_
@@ -11,11 +11,11 @@ namespace swl {
 //--------------------------------------------------------------------------
 //
 
-template<typename StateActionPair>
-class QLambda: public TDLambda<StateActionPair>
+template<typename StateActionPair, typename ActionValueTable = std::map<const StateActionPair, double>, typename EligibilityTrace = std::map<const StateActionPair, double> >
+class QLambda: public TDLambda<StateActionPair, ActionValueTable, EligibilityTrace>
 {
 public:
-	typedef TDLambda<StateActionPair> base_type;
+	typedef TDLambda<StateActionPair, ActionValueTable, EligibilityTrace> base_type;
 	typedef typename base_type::state_type state_type;
 	typedef typename base_type::action_type action_type;
 	typedef typename base_type::policy_type policy_type;
@@ -23,6 +23,8 @@ public:
 	typedef typename base_type::epsilon_function_type epsilon_function_type;
 	typedef typename base_type::step_size_function_type step_size_function_type;
 	typedef typename base_type::state_action_pair_type state_action_pair_type;
+	typedef typename base_type::action_value_table_type action_value_table_type;
+	typedef typename base_type::eligibility_trace_type eligibility_trace_type;
 
 public:
 	explicit QLambda(const double gamma, const double lambda, const bool isReplacingTrace)
@@ -40,7 +42,7 @@ private:
 
 public:
 	// Watkins's Q(lambda): a tabular off-policy TD(lambda) control algorithm
-	/*virtual*/ void train(const size_t maxEpisodeCount, const policy_type &policy, std::map<const state_action_pair_type, double> &Q, std::map<const state_action_pair_type, double> &eligibility) const
+	/*virtual*/ void train(const size_t maxEpisodeCount, const policy_type &policy, action_value_table_type &Q, eligibility_trace_type &eligibility) const
 	{
 		//std::cout << "processing .";
 
@@ -64,7 +66,7 @@ public:
 	}
 
 private:
-	size_t runSingleEpisoide(const size_t episodeTrial, const policy_type &policy, std::map<const state_action_pair_type, double> &Q, std::map<const state_action_pair_type, double> &eligibility) const
+	size_t runSingleEpisoide(const size_t episodeTrial, const policy_type &policy, action_value_table_type &Q, eligibility_trace_type &eligibility) const
 	{
 		size_t step = 1;
 
@@ -92,10 +94,14 @@ private:
 			const state_action_pair_type currSA(currState, currAction);
 			const state_action_pair_type nextSA(nextState, nextGreedyAction);
 			const double delta = r + base_type::gamma_ * Q[nextSA] - Q[currSA];
-			eligibility[currSA] += 1.0;
+			base_type::visit(currSA, eligibility);
 
 			const bool isNextActionGreedy = (nextGreedyAction == nextAction);
+#if defined(__GNUC__)
+			base_type::updateQAndEligibility(step, delta, Q, eligibility, &isNextActionGreedy);
+#else
 			updateQAndEligibility(step, delta, Q, eligibility, &isNextActionGreedy);
+#endif
 
 			// update the current state & action
 			currState = nextState;
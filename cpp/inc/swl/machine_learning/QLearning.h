@@ -2,7 +2,7 @@
 #define __SWL_MACHINE_LEARNING__Q_LEARNING__H_ 1
 
 
-#include "swl/machine_learning/QLearning.h"
+#include "swl/machine_learning/TDLearning.h"
 #include <map>
 
 
@@ -11,11 +11,11 @@ namespace swl {
 //--------------------------------------------------------------------------
 //
 
-template<typename StateActionPair>
-class QLearning: public TDLearning<StateActionPair>
+template<typename StateActionPair, typename ActionValueTable = std::map<const StateActionPair, double> >
+class QLearning: public TDLearning<StateActionPair, ActionValueTable>
 {
 public:
-	typedef TDLearning<StateActionPair> base_type;
+	typedef TDLearning<StateActionPair, ActionValueTable> base_type;
 	typedef typename base_type::state_type state_type;
 	typedef typename base_type::action_type action_type;
 	typedef typename base_type::policy_type policy_type;
@@ -23,6 +23,7 @@ public:
 	typedef typename base_type::epsilon_function_type epsilon_function_type;
 	typedef typename base_type::step_size_function_type step_size_function_type;
 	typedef typename base_type::state_action_pair_type state_action_pair_type;
+	typedef typename base_type::action_value_table_type action_value_table_type;
 
 public:
 	explicit QLearning(const double gamma)
@@ -40,7 +41,7 @@ private:
 
 public:
 	// Q-learning: a tabular off-policy TD control algorithm
-	/*virtual*/ void train(const size_t maxEpisodeCount, const policy_type &policy, std::map<const state_action_pair_type, double> &Q) const
+	/*virtual*/ void train(const size_t maxEpisodeCount, const policy_type &policy, action_value_table_type &Q) const
 	{
 		//std::cout << "processing .";
 
@@ -64,7 +65,7 @@ public:
 	}
 
 private:
-	size_t runSingleEpisoide(const size_t episodeTrial, const policy_type &policy, std::map<const state_action_pair_type, double> &Q) const
+	size_t runSingleEpisoide(const size_t episodeTrial, const policy_type &policy, action_value_table_type &Q) const
 	{
 		size_t step = 1;
 
@@ -12,11 +12,11 @@ namespace swl {
 //--------------------------------------------------------------------------
 //
 
-template<typename StateActionPair>
-class Sarsa: public TDLearning<StateActionPair>
+template<typename StateActionPair, typename ActionValueTable = std::map<const StateActionPair, double> >
+class Sarsa: public TDLearning<StateActionPair, ActionValueTable>
 {
 public:
-	typedef TDLearning<StateActionPair> base_type;
+	typedef TDLearning<StateActionPair, ActionValueTable> base_type;
 	typedef typename base_type::state_type state_type;
 	typedef typename base_type::action_type action_type;
 	typedef typename base_type::policy_type policy_type;
@@ -24,6 +24,7 @@ public:
 	typedef typename base_type::epsilon_function_type epsilon_function_type;
 	typedef typename base_type::step_size_function_type step_size_function_type;
 	typedef typename base_type::state_action_pair_type state_action_pair_type;
+	typedef typename base_type::action_value_table_type action_value_table_type;
 
 public:
 	explicit Sarsa(const double gamma)
@@ -41,7 +42,7 @@ private:
 
 public:
 	// Sarsa: a tabular on-policy TD control algorithm
-	/*virtual*/ void train(const std::size_t maxEpisodeCount, const policy_type &policy, std::map<const state_action_pair_type, double> &Q) const
+	/*virtual*/ void train(const std::size_t maxEpisodeCount, const policy_type &policy, action_value_table_type &Q) const
 	{
 		//std::cout << "processing .";
 
@@ -65,7 +66,7 @@ public:
 	}
 
 private:
-	std::size_t runSingleEpisoide(const std::size_t episodeTrial, const policy_type &policy, std::map<const state_action_pair_type, double> &Q) const
+	std::size_t runSingleEpisoide(const std::size_t episodeTrial, const policy_type &policy, action_value_table_type &Q) const
 	{
 		std::size_t step = 1;
 
@@ -3,7 +3,9 @@
 
 
 #include "swl/machine_learning/TDLearningBase.h"
+#include "swl/machine_learning/TDTabularStorage.h"
 #include <map>
+#include <stdexcept>
 
 
 namespace swl {
@@ -11,7 +13,9 @@ namespace swl {
 //--------------------------------------------------------------------------
 //
 
-template<typename StateActionPair>
+// ActionValueTable: std::map<const StateActionPair, double> or DenseActionValueTable<StateActionPair>.
+// EligibilityTrace: std::map<const StateActionPair, double> or SparseEligibilityTrace<StateActionPair>.
+template<typename StateActionPair, typename ActionValueTable = std::map<const StateActionPair, double>, typename EligibilityTrace = std::map<const StateActionPair, double> >
 class TDLambda: public TDLearningBase
 {
 public:
@@ -21,6 +25,8 @@ public:
 	typedef typename state_action_pair_type::reward_type reward_type;
 	typedef typename state_action_pair_type::action_type action_type;
 	typedef typename state_action_pair_type::policy_type policy_type;
+	typedef ActionValueTable action_value_table_type;
+	typedef EligibilityTrace eligibility_trace_type;
 
 protected:
 	explicit TDLambda(const double gamma, const double lambda, const bool isReplacingTrace)
@@ -39,29 +45,69 @@ private:
 	TDLambda & operator=(const TDLambda &rhs);
 
 public:
-	virtual void train(const size_t maxEpisodeCount, const policy_type &policy, std::map<const state_action_pair_type, double> &Q, std::map<const state_action_pair_type, double> &eligibility) const = 0;
+	virtual void train(const size_t maxEpisodeCount, const policy_type &policy, action_value_table_type &Q, eligibility_trace_type &eligibility) const = 0;
 
 protected:
-	void updateQAndEligibility(const size_t iterationStep, const double delta, std::map<const state_action_pair_type, double> &Q, std::map<const state_action_pair_type, double> &eligibility, const bool *isGreedyAction) const
+	// an accumulating trace: e(s, a) += 1.
+	// a replacing trace: e(s, a) = 1 & e(s, a') = 0 for the other actions a' of s.
+	void visit(const state_action_pair_type &sa, eligibility_trace_type &eligibility) const
+	{
+		doVisit(sa, eligibility);
+	}
+
+	void updateQAndEligibility(const size_t iterationStep, const double delta, action_value_table_type &Q, eligibility_trace_type &eligibility, const bool *isGreedyAction) const
+	{
+		doUpdateQAndEligibility(iterationStep, delta, Q, eligibility, isGreedyAction);
+	}
+
+private:
+	// for std::map: the state-action pairs of a state are found by comparing getState().getValue().
+	void doVisit(const state_action_pair_type &sa, std::map<const state_action_pair_type, double> &eligibility) const
 	{
 		if (isReplacingTrace_)  // Use an replacing trace.
 		{
-			// FIXME [add] >>
-			throw std::logic_error("Not yet implemented");
+			for (typename std::map<const state_action_pair_type, double>::iterator it = eligibility.begin(); it != eligibility.end(); ++it)
+				if (it->first.getState().getValue() == sa.getState().getValue())
+					it->second = 0.0;
+			eligibility[sa] = 1.0;
 		}
 		else  // Use an accumulating trace.
+			eligibility[sa] += 1.0;
+	}
+
+	void doVisit(const state_action_pair_type &sa, SparseEligibilityTrace<state_action_pair_type> &eligibility) const
+	{
+		if (isReplacingTrace_)  // Use an replacing trace.
+			eligibility.replace(sa);
+		else  // Use an accumulating trace.
+			eligibility[sa] += 1.0;
+	}
+
+	// for std::map: visit all the state-action pairs.
+	// accumulating & replacing traces decay in the same way. they differ only in visit().
+	void doUpdateQAndEligibility(const size_t iterationStep, const double delta, std::map<const state_action_pair_type, double> &Q, std::map<const state_action_pair_type, double> &eligibility, const bool *isGreedyAction) const
+	{
+		for (typename std::map<const state_action_pair_type, double>::iterator it = Q.begin(); it != Q.end(); ++it)
 		{
-			for (typename std::map<const state_action_pair_type, double>::iterator it = Q.begin(); it != Q.end(); ++it)
+			it->second += (*stepSizeFunction_)(iterationStep) * delta * eligibility[it->first];
+			if (isGreedyAction)
 			{
-				it->second += (*stepSizeFunction_)(iterationStep) * delta * eligibility[it->first];
-				if (isGreedyAction)
-				{
-					if (*isGreedyAction) eligibility[it->first] *= gamma_ * lambda_;
-					else eligibility[it->first] = 0.0;
-				}
-				else eligibility[it->first] *= gamma_ * lambda_;
+				if (*isGreedyAction) eligibility[it->first] *= gamma_ * lambda_;
+				else eligibility[it->first] = 0.0;
 			}
+			else eligibility[it->first] *= gamma_ * lambda_;
+		}
+	}
+
+	// for DenseActionValueTable & SparseEligibilityTrace: visit only the state-action pairs with non-negligible traces.
+	void doUpdateQAndEligibility(const size_t iterationStep, const double delta, DenseActionValueTable<state_action_pair_type> &Q, SparseEligibilityTrace<state_action_pair_type> &eligibility, const bool *isGreedyAction) const
+	{
+		if (isGreedyAction && !*isGreedyAction)
+		{
+			eligibility.updateAndDecay(Q, (*stepSizeFunction_)(iterationStep) * delta, 0.0);
+			eligibility.clear();
 		}
+		else eligibility.updateAndDecay(Q, (*stepSizeFunction_)(iterationStep) * delta, gamma_ * lambda_);
 	}
 
 private:
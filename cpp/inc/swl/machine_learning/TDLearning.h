@@ -3,6 +3,7 @@
 
 
 #include "swl/machine_learning/TDLearningBase.h"
+#include "swl/machine_learning/TDTabularStorage.h"
 #include <map>
 
 
@@ -11,7 +12,8 @@ namespace swl {
 //--------------------------------------------------------------------------
 //
 
-template<typename StateActionPair>
+// ActionValueTable: std::map<const StateActionPair, double> or DenseActionValueTable<StateActionPair>.
+template<typename StateActionPair, typename ActionValueTable = std::map<const StateActionPair, double> >
 class TDLearning: public TDLearningBase
 {
 public:
@@ -23,6 +25,7 @@ public:
 	typedef typename state_action_pair_type::action_type action_type;
 	typedef typename state_action_pair_type::policy_type policy_type;
 	typedef typename state_action_pair_type::reward_type reward_type;
+	typedef ActionValueTable action_value_table_type;
 
 protected:
 	explicit TDLearning(const double gamma)
@@ -41,7 +44,7 @@ private:
 	TDLearning & operator=(const TDLearning &rhs);
 
 public:
-	virtual void train(const std::size_t maxEpisodeCount, const policy_type &policy, std::map<const state_action_pair_type, double> &Q) const = 0;
+	virtual void train(const std::size_t maxEpisodeCount, const policy_type &policy, action_value_table_type &Q) const = 0;
 };
 
 }  // namespace swl
@@ -0,0 +1,182 @@
+#if !defined(__SWL_MACHINE_LEARNING__TD_TABULAR_STORAGE__H_)
+#define __SWL_MACHINE_LEARNING__TD_TABULAR_STORAGE__H_ 1
+
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+
+namespace swl {
+
+//--------------------------------------------------------------------------
+// dense action-value table.
+//	- Q(s, a) is stored in a contiguous array indexed by s * |A| + a.
+//	- a state-action pair has to provide getState() & getAction().
+//	- a state has to provide getValue() in [0, STATE_SIZE) & STATE_SIZE.
+//	- an action has to provide getValue() in [0, ACTION_SIZE) & ACTION_SIZE.
+
+template<typename StateActionPair>
+class DenseActionValueTable
+{
+public:
+	//typedef DenseActionValueTable base_type;
+	typedef StateActionPair state_action_pair_type;
+	typedef typename state_action_pair_type::state_type state_type;
+	typedef typename state_action_pair_type::action_type action_type;
+	typedef double value_type;
+
+public:
+	static const std::size_t STATE_SIZE = state_type::STATE_SIZE;
+	static const std::size_t ACTION_SIZE = action_type::ACTION_SIZE;
+	static const std::size_t TABLE_SIZE = STATE_SIZE * ACTION_SIZE;
+
+public:
+	explicit DenseActionValueTable(const value_type initialValue = 0.0)
+	: values_(TABLE_SIZE, initialValue)
+	{}
+	explicit DenseActionValueTable(const DenseActionValueTable &rhs)
+	: values_(rhs.values_)
+	{}
+
+	DenseActionValueTable & operator=(const DenseActionValueTable &rhs)
+	{
+		if (this == &rhs) return *this;
+		values_ = rhs.values_;
+		return *this;
+	}
+
+public:
+	static std::size_t getIndex(const state_action_pair_type &sa)
+	{  return getIndex(sa.getState(), sa.getAction());  }
+	static std::size_t getIndex(const state_type &state, const action_type &action)
+	{  return std::size_t(state.getValue()) * ACTION_SIZE + std::size_t(action.getValue());  }
+
+	value_type & operator[](const state_action_pair_type &sa)  {  return values_[getIndex(sa)];  }
+	const value_type & operator[](const state_action_pair_type &sa) const  {  return values_[getIndex(sa)];  }
+	value_type & operator[](const std::size_t index)  {  return values_[index];  }
+	const value_type & operator[](const std::size_t index) const  {  return values_[index];  }
+
+	action_type getGreedyAction(const state_type &state) const
+	{
+		// all the actions of a state are adjacent in memory.
+		const value_type *row = &values_[std::size_t(state.getValue()) * ACTION_SIZE];
+		return action_type(static_cast<typename action_type::value_type>(std::distance(row, std::max_element(row, row + ACTION_SIZE))));
+	}
+
+	void fill(const value_type value)  {  std::fill(values_.begin(), values_.end(), value);  }
+
+	std::size_t size() const  {  return values_.size();  }
+	value_type * data()  {  return values_.empty() ? NULL : &values_[0];  }
+	const value_type * data() const  {  return values_.empty() ? NULL : &values_[0];  }
+
+private:
+	std::vector<value_type> values_;
+};
+
+//--------------------------------------------------------------------------
+// sparse eligibility trace.
+//	- traces are stored in a dense array with the same layout as DenseActionValueTable.
+//	- only the entries whose trace is not negligible are kept in an active list & visited on update.
+
+template<typename StateActionPair>
+class SparseEligibilityTrace
+{
+public:
+	//typedef SparseEligibilityTrace base_type;
+	typedef StateActionPair state_action_pair_type;
+	typedef DenseActionValueTable<state_action_pair_type> action_value_table_type;
+	typedef double value_type;
+
+public:
+	explicit SparseEligibilityTrace(const value_type threshold = 1.0e-5)
+	: threshold_(threshold), traces_(action_value_table_type::TABLE_SIZE, 0.0), isActive_(action_value_table_type::TABLE_SIZE, false), activeIndices_()
+	{
+		activeIndices_.reserve(action_value_table_type::TABLE_SIZE);
+	}
+	explicit SparseEligibilityTrace(const SparseEligibilityTrace &rhs)
+	: threshold_(rhs.threshold_), traces_(rhs.traces_), isActive_(rhs.isActive_), activeIndices_(rhs.activeIndices_)
+	{}
+
+	SparseEligibilityTrace & operator=(const SparseEligibilityTrace &rhs)
+	{
+		if (this == &rhs) return *this;
+		threshold_ = rhs.threshold_;
+		traces_ = rhs.traces_;
+		isActive_ = rhs.isActive_;
+		activeIndices_ = rhs.activeIndices_;
+		return *this;
+	}
+
+public:
+	// an accessed entry becomes active.
+	value_type & operator[](const state_action_pair_type &sa)
+	{
+		const std::size_t index = action_value_table_type::getIndex(sa);
+		if (!isActive_[index])
+		{
+			isActive_[index] = true;
+			activeIndices_.push_back(index);
+		}
+		return traces_[index];
+	}
+	// e(s, a) = 1 & e(s, a') = 0 for the other actions a' of s, as a replacing trace.
+	// the zeroed entries are removed from the active list by the next updateAndDecay().
+	void replace(const state_action_pair_type &sa)
+	{
+		const std::size_t index = action_value_table_type::getIndex(sa);
+		const std::size_t first = index - index % action_value_table_type::ACTION_SIZE;
+		for (std::size_t i = first; i < first + action_value_table_type::ACTION_SIZE; ++i)
+			if (isActive_[i]) traces_[i] = 0.0;
+		(*this)[sa] = 1.0;
+	}
+	value_type getTrace(const state_action_pair_type &sa) const  {  return traces_[action_value_table_type::getIndex(sa)];  }
+
+	// Q(s, a) += scale * e(s, a) & e(s, a) *= decay for all the active entries.
+	// entries whose trace drops below the threshold are reset & removed from the active list.
+	void updateAndDecay(action_value_table_type &Q, const value_type scale, const value_type decay)
+	{
+		std::size_t i = 0;
+		while (i < activeIndices_.size())
+		{
+			const std::size_t index = activeIndices_[i];
+			Q[index] += scale * traces_[index];
+			traces_[index] *= decay;
+
+			if (std::fabs(traces_[index]) < threshold_)
+			{
+				traces_[index] = 0.0;
+				isActive_[index] = false;
+				activeIndices_[i] = activeIndices_.back();
+				activeIndices_.pop_back();
+			}
+			else ++i;
+		}
+	}
+
+	void clear()
+	{
+		for (std::vector<std::size_t>::const_iterator cit = activeIndices_.begin(); cit != activeIndices_.end(); ++cit)
+		{
+			traces_[*cit] = 0.0;
+			isActive_[*cit] = false;
+		}
+		activeIndices_.clear();
+	}
+
+	std::size_t getActiveCount() const  {  return activeIndices_.size();  }
+	value_type getThreshold() const  {  return threshold_;  }
+
+private:
+	value_type threshold_;
+
+	std::vector<value_type> traces_;
+	std::vector<bool> isActive_;
+	std::vector<std::size_t> activeIndices_;
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_MACHINE_LEARNING__TD_TABULAR_STORAGE__H_
@@ -0,0 +1,110 @@
+#pragma once
+
+#if !defined(__SWL_MACHINE_VISION__GRAPH_BASED_IMAGE_SEGMENTATION__H_)
+#define __SWL_MACHINE_VISION__GRAPH_BASED_IMAGE_SEGMENTATION__H_ 1
+
+
+#include "swl/machine_vision/ExportMachineVision.h"
+#define CV_NO_BACKWARD_COMPATIBILITY
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+
+namespace swl {
+
+//--------------------------------------------------------------------------
+// Graph-based Image Segmentation.
+
+// Felzenszwalb & Huttenlocher's efficient graph-based image segmentation on an 8-connected pixel grid.
+//	- all the buffers are kept between calls, so nothing is allocated after the first image of a given size.
+//	- the edges are built in parallel row tiles (with OpenMP) & sorted by an LSD radix sort on the bit patterns of their weights.
+//	- the components are kept in flat arrays with a path-halving union-find, joined by size.
+//	- with a depth-guided mask, only the neighbors of the same mask state are segmented together.
+//		the edges across the states are used only to merge the components smaller than the minimum size.
+class SWL_MACHINE_VISION_API GraphBasedImageSegmentation final
+{
+public:
+	//typedef GraphBasedImageSegmentation base_type;
+
+	// the states of a depth-guided mask.
+	enum { VALID_DEPTH = 255, INVALID_DEPTH = 0, DEPTH_BOUNDARY = 127 };
+
+public:
+	/// sigma: to smooth the image. k: the constant of the threshold function. minSize: the minimum component size.
+	explicit GraphBasedImageSegmentation(const float sigma = 0.5f, const float k = 500.0f, const int minSize = 50);
+
+public:
+	/// rgb: CV_8UC3. labels: CV_32SC1 in [0, the number of the components). returns the number of the components.
+	int segment(const cv::Mat &rgb, cv::Mat &labels);
+	/// depth: CV_16UC1. mask: CV_8UC1 of the mask states.
+	/// the weight of an edge is the color distance plus
+	///	- VALID_DEPTH: lambdaValid * the distance between the back-projected points (with the focal lengths fx & fy).
+	///	- INVALID_DEPTH & DEPTH_BOUNDARY (& any other state): lambdaInvalid & lambdaBoundary * the distance between the pixels.
+	int segment(const cv::Mat &rgb, const cv::Mat &depth, const cv::Mat &mask, const float lambdaValid, const float lambdaInvalid, const float lambdaBoundary, const float fx, const float fy, cv::Mat &labels);
+
+	///
+	float getSigma() const  {  return sigma_;  }
+	float getK() const  {  return k_;  }
+	int getMinSize() const  {  return minSize_;  }
+
+private:
+	struct Edge
+	{
+		float w;
+		int a, b;
+	};
+
+	struct DepthParameters
+	{
+		const cv::Mat *depth;
+		const cv::Mat *mask;
+		float lambdas[3];  // VALID_DEPTH, INVALID_DEPTH, others.
+		float fx, fy;
+	};
+
+private:
+	void prepare(const cv::Mat &rgb);
+	void smooth(const cv::Mat &rgb);
+	void buildEdges(const int tile, const DepthParameters *params);
+	void sortEdges();
+	int segmentGraph(cv::Mat &labels);
+
+	int find(int x)
+	{
+		while (parents_[x] != x)
+		{
+			parents_[x] = parents_[parents_[x]];
+			x = parents_[x];
+		}
+		return x;
+	}
+	int join(int a, int b);
+
+private:
+	const float sigma_;
+	const float k_;
+	const int minSize_;
+
+	int width_, height_;
+	// the 1D Gaussian kernel, from the center.
+	std::vector<float> kernel_;
+	// the smoothed color channels, one after another, & the buffer of the horizontal pass.
+	std::vector<float> channels_;
+	std::vector<float> buffer_;
+
+	// each tile owns the range of four edges per pixel in tileEdges_. the edges between pixels of the same state are stored from the front
+	// of the range & the others from the back.
+	std::vector<Edge> tileEdges_;
+	std::vector<int> innerCounts_, outerCounts_;
+	// the edges between pixels of the same state sorted by weight, followed by the others.
+	std::vector<Edge> edges_;
+	std::size_t innerCount_, outerCount_;
+
+	std::vector<int> parents_, sizes_;
+	std::vector<float> thresholds_;
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_MACHINE_VISION__GRAPH_BASED_IMAGE_SEGMENTATION__H_
@@ -61,7 +61,40 @@ public:
 		cv::Point pt1_, pt2_;
 	};
 
+	enum ThinningMethod { ZHANG_SUEN, GUO_HALL };
+
+	// A skeleton graph in flat arrays.
+	//	- The pixels of a node are a single end pixel or adjacent junction pixels. A cycle without junctions gets a node at its top-left pixel.
+	//	- Branch i runs from node branchNodes[2 * i] to node branchNodes[2 * i + 1] through the pixels [branchOffsets[i], branchOffsets[i + 1]) of branchPixels.
+	//		The pixels of the nodes are not included.
+	struct SWL_MACHINE_VISION_API SkeletonGraph
+	{
+	public:
+		void clear();
+
+		size_t getNodeCount() const { return nodes.size(); }
+		size_t getBranchCount() const { return branchLengths.size(); }
+
+	public:
+		std::vector<cv::Point> nodes;
+		// ISOLATED, LEAF_END, INTERNAL (a node on a cycle), BRANCH (3 branches) or CROSS (4 or more), by the number of the branch ends.
+		std::vector<VertexType> nodeTypes;
+		std::vector<int> branchNodes;
+		std::vector<int> branchOffsets;
+		std::vector<cv::Point> branchPixels;
+		// The 8-connected path length between the node pixels at both ends.
+		std::vector<float> branchLengths;
+	};
+
 public:
+	// Bit-packed thinning. 64 pixels of a row are tested at a time with word operations.
+	// bw: non-zero pixels are the foreground. skeleton_bw: CV_8UC1 of 0 & 255. The pixels on the image border are not removed.
+	static void thin(const cv::Mat& bw, cv::Mat& skeleton_bw, const ThinningMethod method = GUO_HALL);
+
+	// Single-pass, iterative skeleton graph extraction.
+	// A pixel whose neighbors form two neighbor groups is on a branch & the others are nodes. Expects a thin skeleton like the one of thin().
+	static void extractSkeletonGraph(const cv::Mat& skeleton_bw, SkeletonGraph& graph);
+
 	// Skeleton following/tracing approach.
 	static void constructGraphByFollowingSkeleton(const cv::Mat& skeleton_bw, std::list<Vertex>& vertices, std::list<std::pair<const int, const int> >& edges);
 
@@ -0,0 +1,69 @@
+#if !defined(__SWL_MATH__CONVEX_POLYGON__H_)
+#define __SWL_MATH__CONVEX_POLYGON__H_ 1
+
+
+#include "swl/math/ExportMath.h"
+#include "swl/base/Point.h"
+#include <vector>
+#include <list>
+
+
+namespace swl {
+
+//-----------------------------------------------------------------------------------------
+// ConvexPolygon.
+
+// the convex hull of a point set, prepared for many containment queries.
+//	- the hull is computed by Andrew's monotone chain & stored counterclockwise without collinear vertices.
+//	- the edges are moved outward by the tolerance when the polygon is built, so a query is a wedge binary search
+//		around the first vertex followed by a single edge test, O(log n).
+//	- a hull of two vertices is a line segment, and a point is included if LineSegment2<float>::include() holds.
+class SWL_MATH_API ConvexPolygon
+{
+public:
+	//typedef ConvexPolygon base_type;
+	typedef Point2<float> point_type;
+
+public:
+	ConvexPolygon();
+	ConvexPolygon(const point_type *points, const std::size_t count, const float tol = 0.0f);
+	ConvexPolygon(const std::vector<point_type> &points, const float tol = 0.0f);
+	ConvexPolygon(const std::list<point_type> &points, const float tol = 0.0f);
+
+public:
+	///
+	void build(const point_type *points, const std::size_t count, const float tol = 0.0f);
+
+	/// counterclockwise.
+	const std::vector<point_type> & getVertices() const  {  return vertices_;  }
+	float getTolerance() const  {  return tol_;  }
+	bool isEmpty() const  {  return vertices_.size() < 2;  }
+
+	///
+	bool include(const point_type &pt) const;
+	/// results[i] = include(points[i]). returns the number of the included points.
+	std::size_t include(const point_type *points, const std::size_t count, bool *results) const;
+	std::size_t include(const std::vector<point_type> &points, std::vector<bool> &results) const;
+
+	/// Andrew's monotone chain. the hull is counterclockwise, starting from the lowest-leftmost point.
+	static void computeConvexHull(const point_type *points, const std::size_t count, std::vector<point_type> &hull);
+
+private:
+	bool includeSegment(const double x, const double y) const;
+	bool includePolygon(const double x, const double y) const;
+
+private:
+	std::vector<point_type> vertices_;
+	float tol_;
+
+	// the vertices of the polygon offset by the tolerance, relative to the first one.
+	double originX_, originY_;
+	std::vector<double> xs_, ys_;
+	// the bounding box of the offset polygon.
+	double minX_, minY_, maxX_, maxY_;
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_MATH__CONVEX_POLYGON__H_
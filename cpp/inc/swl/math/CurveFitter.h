@@ -0,0 +1,86 @@
+#if !defined(__SWL_MATH__CURVE_FITTER__H_)
+#define __SWL_MATH__CURVE_FITTER__H_ 1
+
+
+#include "swl/math/ExportMath.h"
+#include <Eigen/Core>
+#include <vector>
+
+
+namespace swl {
+
+//-----------------------------------------------------------------------------------------
+// CurveFitter.
+
+// least-squares fitting of 2D curves from incrementally accumulated normal equations.
+//	- every model is linear in its parameters, so a point adds w * z * z^T to a small Gram matrix, where z is the basis of the point
+//		augmented by the target. a point is removed by adding it with the negative weight.
+//	- the parameters:
+//		LINE: [a, b, c] for a * x + b * y + c = 0 with a^2 + b^2 = 1. (orthogonal regression)
+//		QUADRATIC: [a, b, c, d] for a * x^2 + b * x + c * y + d = 0 with c = -1, as in CurveFitting::estimateQuadraticByLeastSquares().
+//		POLYNOMIAL: [p0, p1, ..., pn] for y = p0 + p1 * x + ... + pn * x^n.
+//		CIRCLE: [cx, cy, r]. (algebraic fit)
+//		ELLIPSE: [a, b, c, d, e, f] for a * x^2 + b * x * y + c * y^2 + d * x + e * y + f = 0 with a + c = 1. (algebraic fit)
+//	- the normal equations square the condition number. for high degrees or large coordinates, center & scale the points first.
+class SWL_MATH_API CurveFitter
+{
+public:
+	//typedef CurveFitter base_type;
+
+	enum Model { LINE = 0, QUADRATIC, POLYNOMIAL, CIRCLE, ELLIPSE };
+	// the loss functions of iteratively reweighted least squares.
+	enum Loss { LEAST_SQUARES = 0, HUBER, TUKEY };
+
+public:
+	/// degree is used only for POLYNOMIAL.
+	explicit CurveFitter(const Model model, const std::size_t degree = 2);
+
+public:
+	///
+	void add(const double x, const double y, const double weight = 1.0);
+	/// weights can be NULL for unit weights.
+	void add(const double *xs, const double *ys, const std::size_t count, const double *weights = NULL);
+	void remove(const double x, const double y, const double weight = 1.0);
+	void clear();
+
+	/// solves the accumulated normal equations.
+	bool solve(std::vector<double> &params) const;
+
+	/// the signed distance of a point from the curve. (vertical for QUADRATIC & POLYNOMIAL, Sampson's approximation for ELLIPSE)
+	double computeResidual(const std::vector<double> &params, const double x, const double y) const;
+
+	/// iteratively reweighted least squares with the scale estimated by the median absolute residual.
+	/// the accumulated sums are replaced by the ones of the final weights.
+	bool fitRobust(const double *xs, const double *ys, const std::size_t count, const Loss loss, std::vector<double> &params, std::vector<double> *weights = NULL, const std::size_t maxIterations = 20, const double tol = 1.0e-8);
+
+	/// fits the point sets [offsets[i], offsets[i + 1]) independently. params[i] is empty if the fit fails.
+	/// the sets are fitted in parallel with OpenMP, one CurveFitter per set. the result doesn't depend on the number of threads.
+	/// returns the number of successful fits.
+	static std::size_t fitBatch(const Model model, const std::size_t degree, const Loss loss, const double *xs, const double *ys, const std::vector<std::size_t> &offsets, std::vector<std::vector<double> > &params);
+
+	/// the center, the semi-axes & the angle of the major axis of the ellipse of ELLIPSE parameters.
+	static bool getEllipseGeometry(const std::vector<double> &params, double &cx, double &cy, double &major, double &minor, double &angle);
+
+	///
+	Model getModel() const  {  return model_;  }
+	std::size_t getParameterCount() const;
+	std::size_t getPointCount() const  {  return count_;  }
+
+private:
+	std::size_t getBasisSize() const  {  return (std::size_t)gram_.rows() - (LINE == model_ ? 0 : 1);  }
+	std::size_t getMinimumPointCount() const;
+	void computeBasis(const double x, const double y, double *z) const;
+
+private:
+	const Model model_;
+	const std::size_t degree_;
+
+	// sum of w * z * z^T. only the lower triangle is updated.
+	Eigen::MatrixXd gram_;
+	std::size_t count_;
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_MATH__CURVE_FITTER__H_
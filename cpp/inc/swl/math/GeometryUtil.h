@@ -25,7 +25,9 @@ public:
 
 	//
 	static void getConvexHull(const std::list<Point2<float> > &points, std::list<Point2<float> > &convexHull);
+	/// The convex hull of the points is built on every call, and its edges are moved outward by tol.
 	static bool within(const Point2<float> &pt, const std::list<Point2<float> > &points, const float tol);
+	/// The supplied hull is tested as it is in O(n), clockwise or counterclockwise. tol is used only when the hull is a line segment.
 	static bool withinConvexHull(const Point2<float> &pt, const std::list<Point2<float> > &convexHull, const float tol);
 };
 
@@ -2,52 +2,768 @@
 #define __SWL_MATH__MATRIX__H_ 1
 
 
-#include <valarray>
-#include <cmath>
+#include "swl/math/ExportMath.h"
+#include "swl/base/LogException.h"
+#include <algorithm>
+#include <memory>
+#include <cstdlib>
+#include <cstddef>
 
 
 namespace swl {
-	
+
+template<typename T> class Matrix;
+template<typename T> class MatrixView;
+template<typename T, std::size_t R, std::size_t C> class FixedMatrix;
+
 //-----------------------------------------------------------------------------------------
-// class Matrix
-		
+// struct MatrixKernel: row-major dense kernels for float & double
+//	- the rows of a matrix are stride elements apart. the elements of a row are contiguous.
+//	- the inner loops use SSE2 when it's available.
+
+struct SWL_MATH_API MatrixKernel
+{
+	/// y = alpha * A * x + beta * y, where A is (rows x cols) & x, y are strided vectors.
+	static void gemv(const std::size_t rows, const std::size_t cols, const double alpha, const double *A, const std::size_t lda, const double *x, const std::size_t incx, const double beta, double *y, const std::size_t incy);
+	static void gemv(const std::size_t rows, const std::size_t cols, const float alpha, const float *A, const std::size_t lda, const float *x, const std::size_t incx, const float beta, float *y, const std::size_t incy);
+
+	/// C = alpha * A * B + beta * C, where A is (m x k), B is (k x n) & C is (m x n).
+	static void gemm(const std::size_t m, const std::size_t n, const std::size_t k, const double alpha, const double *A, const std::size_t lda, const double *B, const std::size_t ldb, const double beta, double *C, const std::size_t ldc);
+	static void gemm(const std::size_t m, const std::size_t n, const std::size_t k, const float alpha, const float *A, const std::size_t lda, const float *B, const std::size_t ldb, const float beta, float *C, const std::size_t ldc);
+};
+
+namespace matrix_detail {
+
+// the kernels for the other element types.
+template<typename T>
+void gemv(const std::size_t rows, const std::size_t cols, const T &alpha, const T *A, const std::size_t lda, const T *x, const std::size_t incx, const T &beta, T *y, const std::size_t incy)
+{
+	for (std::size_t i = 0; i < rows; ++i, A += lda, y += incy)
+	{
+		T sum = T(0);
+		const T *xj = x;
+		for (std::size_t j = 0; j < cols; ++j, xj += incx)
+			sum += A[j] * *xj;
+		*y = T(0) == beta ? alpha * sum : alpha * sum + beta * *y;
+	}
+}
+
 template<typename T>
-class Matrix
+void gemm(const std::size_t m, const std::size_t n, const std::size_t k, const T &alpha, const T *A, const std::size_t lda, const T *B, const std::size_t ldb, const T &beta, T *C, const std::size_t ldc)
+{
+	for (std::size_t i = 0; i < m; ++i, A += lda, C += ldc)
+	{
+		if (T(0) == beta) std::fill(C, C + n, T(0));
+		else if (T(1) != beta)
+			for (std::size_t j = 0; j < n; ++j) C[j] *= beta;
+
+		for (std::size_t p = 0; p < k; ++p)
+		{
+			const T a = alpha * A[p];
+			const T *b = B + p * ldb;
+			for (std::size_t j = 0; j < n; ++j)
+				C[j] += a * b[j];
+		}
+	}
+}
+
+inline void gemv(const std::size_t rows, const std::size_t cols, const double alpha, const double *A, const std::size_t lda, const double *x, const std::size_t incx, const double beta, double *y, const std::size_t incy)
+{  MatrixKernel::gemv(rows, cols, alpha, A, lda, x, incx, beta, y, incy);  }
+inline void gemv(const std::size_t rows, const std::size_t cols, const float alpha, const float *A, const std::size_t lda, const float *x, const std::size_t incx, const float beta, float *y, const std::size_t incy)
+{  MatrixKernel::gemv(rows, cols, alpha, A, lda, x, incx, beta, y, incy);  }
+
+inline void gemm(const std::size_t m, const std::size_t n, const std::size_t k, const double alpha, const double *A, const std::size_t lda, const double *B, const std::size_t ldb, const double beta, double *C, const std::size_t ldc)
+{  MatrixKernel::gemm(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);  }
+inline void gemm(const std::size_t m, const std::size_t n, const std::size_t k, const float alpha, const float *A, const std::size_t lda, const float *B, const std::size_t ldb, const float beta, float *C, const std::size_t ldc)
+{  MatrixKernel::gemm(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);  }
+
+// storage aligned to 32 bytes. the address returned by std::malloc() is kept just in front of the aligned block.
+enum { ALIGNMENT = 32 };
+
+inline void * allocateAligned(const std::size_t bytes)
+{
+	void *raw = std::malloc(bytes + ALIGNMENT + sizeof(void *));
+	if (!raw) throw std::bad_alloc();
+	void *aligned = reinterpret_cast<void *>((reinterpret_cast<std::size_t>(raw) + sizeof(void *) + ALIGNMENT) & ~(std::size_t)(ALIGNMENT - 1));
+	reinterpret_cast<void **>(aligned)[-1] = raw;
+	return aligned;
+}
+
+inline void deallocateAligned(void *aligned)
+{
+	if (aligned) std::free(reinterpret_cast<void **>(aligned)[-1]);
+}
+
+// how an expression holds its operands. containers are held by reference, views & expressions by value.
+template<typename E>
+struct Nested
+{
+	typedef const E type;
+};
+
+template<typename T>
+struct Nested<Matrix<T> >
+{
+	typedef const Matrix<T> & type;
+};
+
+template<typename T, std::size_t R, std::size_t C>
+struct Nested<FixedMatrix<T, R, C> >
+{
+	typedef const FixedMatrix<T, R, C> & type;
+};
+
+inline void checkSize(const std::size_t rows1, const std::size_t cols1, const std::size_t rows2, const std::size_t cols2)
+{
+	if (rows1 != rows2 || cols1 != cols2)
+		throw LogException(LogException::L_ERROR, "mismatched matrix size", __FILE__, __LINE__, __FUNCTION__);
+}
+
+}  // namespace matrix_detail
+
+//-----------------------------------------------------------------------------------------
+// class MatrixExpression: the base of matrices & lazily evaluated matrix expressions
+//	- an expression is evaluated when it's assigned, directly into the destination matrix.
+//		e.g.) y = A * x + b computes A * x into y & then adds b to y, without a temporary matrix.
+//	- an expression E has the following members.
+//		value_type, rows(), cols()
+//		evalTo(dst, alpha): dst = alpha * E.
+//		addTo(dst, alpha): dst += alpha * E.
+//		aliases(first, last): true if E reads any element in [first, last).
+//		evaluate(tmp): a view of E, evaluated into tmp unless E is a matrix or a view.
+
+template<typename E>
+class MatrixExpression
 {
 public:
-    typedef T value_type;
+	const E & derived() const  {  return static_cast<const E &>(*this);  }
+};
+
+//-----------------------------------------------------------------------------------------
+// class MatrixView: a row-major view onto memory owned by someone else
+//	- copying a view copies the reference, assigning to a view copies the elements.
+
+template<typename T>
+class MatrixView: public MatrixExpression<MatrixView<T> >
+{
+public:
+	typedef T value_type;
 
 public:
-	Matrix(const int row = 1, const int col = 1)
-	: row_(row), col_(col), entry_()
+	MatrixView(T *data, const std::size_t rows, const std::size_t cols)
+	: data_(data), rows_(rows), cols_(cols), stride_(cols)
 	{}
-	Matrix(const Matrix &rhs)
-	: row_(rhs.row_), col_(rhs.col_), entry_(rhs.entry_)
+	MatrixView(T *data, const std::size_t rows, const std::size_t cols, const std::size_t stride)
+	: data_(data), rows_(rows), cols_(cols), stride_(stride)
+	{}
+	MatrixView(const MatrixView &rhs)
+	: data_(rhs.data_), rows_(rhs.rows_), cols_(rhs.cols_), stride_(rhs.stride_)
+	{}
+
+	MatrixView & operator=(const MatrixView &rhs)
+	{
+		assign(rhs);
+		return *this;
+	}
+	template<typename E>
+	MatrixView & operator=(const MatrixExpression<E> &expr)
+	{
+		assign(expr.derived());
+		return *this;
+	}
+
+public:
+	/// accessor & mutator
+	T & operator()(const std::size_t row, const std::size_t col) const  {  return data_[row * stride_ + col];  }
+	T * row(const std::size_t row) const  {  return data_ + row * stride_;  }
+	T * data() const  {  return data_;  }
+
+	std::size_t rows() const  {  return rows_;  }
+	std::size_t cols() const  {  return cols_;  }
+	std::size_t stride() const  {  return stride_;  }
+
+	/// the (rows x cols) sub-matrix at (row, col)
+	MatrixView block(const std::size_t row, const std::size_t col, const std::size_t rows, const std::size_t cols) const
+	{
+		if (row + rows > rows_ || col + cols > cols_)
+			throw LogException(LogException::L_ERROR, "illegal index", __FILE__, __LINE__, __FUNCTION__);
+		return MatrixView(data_ + row * stride_ + col, rows, cols, stride_);
+	}
+
+	void fill(const T &value) const
+	{
+		for (std::size_t i = 0; i < rows_; ++i)
+			std::fill(row(i), row(i) + cols_, value);
+	}
+	void setZero() const  {  fill(T(0));  }
+
+	///
+	template<typename E>
+	MatrixView & operator+=(const MatrixExpression<E> &expr)
+	{
+		accumulate(expr.derived(), T(1));
+		return *this;
+	}
+	template<typename E>
+	MatrixView & operator-=(const MatrixExpression<E> &expr)
+	{
+		accumulate(expr.derived(), T(-1));
+		return *this;
+	}
+	MatrixView & operator*=(const T &s)
+	{
+		for (std::size_t i = 0; i < rows_; ++i)
+			for (T *p = row(i), *end = row(i) + cols_; p != end; ++p) *p *= s;
+		return *this;
+	}
+
+public:
+	/// expression
+	void evalTo(const MatrixView &dst, const T &alpha) const
+	{
+		for (std::size_t i = 0; i < rows_; ++i)
+		{
+			const T *src = row(i);
+			if (T(1) == alpha) std::copy(src, src + cols_, dst.row(i));
+			else
+				for (T *p = dst.row(i), *end = dst.row(i) + cols_; p != end; ++p, ++src) *p = alpha * *src;
+		}
+	}
+	void addTo(const MatrixView &dst, const T &alpha) const
+	{
+		for (std::size_t i = 0; i < rows_; ++i)
+		{
+			const T *src = row(i);
+			for (T *p = dst.row(i), *end = dst.row(i) + cols_; p != end; ++p, ++src) *p += alpha * *src;
+		}
+	}
+	bool aliases(const T *first, const T *last) const
+	{
+		return rows_ && cols_ && data_ < last && first < data_ + (rows_ - 1) * stride_ + cols_;
+	}
+	MatrixView evaluate(Matrix<T> & /*tmp*/) const  {  return *this;  }
+
+private:
+	template<typename E>
+	void assign(const E &expr);
+	template<typename E>
+	void accumulate(const E &expr, const T &alpha);
+
+private:
+	T *data_;
+	std::size_t rows_;
+	std::size_t cols_;
+	std::size_t stride_;
+};
+
+//-----------------------------------------------------------------------------------------
+// class Matrix: a row-major dense matrix in 32-byte aligned storage
+
+template<typename T>
+class Matrix: public MatrixExpression<Matrix<T> >
+{
+public:
+	typedef T value_type;
+
+public:
+	Matrix()
+	: rows_(0), cols_(0), data_(NULL)
 	{}
-	~Matrix() {}
-	
+	Matrix(const std::size_t rows, const std::size_t cols, const T &value = T(0))
+	: rows_(0), cols_(0), data_(NULL)
+	{
+		allocate(rows, cols, value);
+	}
+	Matrix(const Matrix &rhs)
+	: rows_(0), cols_(0), data_(NULL)
+	{
+		allocate(rhs.rows_, rhs.cols_, T(0));
+		std::copy(rhs.data_, rhs.data_ + size(), data_);
+	}
+	template<typename E>
+	Matrix(const MatrixExpression<E> &expr)
+	: rows_(0), cols_(0), data_(NULL)
+	{
+		allocate(expr.derived().rows(), expr.derived().cols(), T(0));
+		expr.derived().evalTo(view(), T(1));
+	}
+	~Matrix()
+	{
+		release();
+	}
+
 	Matrix & operator=(const Matrix &rhs)
 	{
 		if (this == &rhs) return *this;
-		row_ = rhs.row_;
-		col_ = rhs.col_;
-		entry_ = rhs.entry_;
+		resize(rhs.rows_, rhs.cols_);
+		std::copy(rhs.data_, rhs.data_ + size(), data_);
+		return *this;
+	}
+	template<typename E>
+	Matrix & operator=(const MatrixExpression<E> &expr)
+	{
+		const E &e = expr.derived();
+		if (e.aliases(data_, data_ + size()))
+		{
+			Matrix tmp(e);
+			swap(tmp);
+		}
+		else
+		{
+			resize(e.rows(), e.cols());
+			e.evalTo(view(), T(1));
+		}
+		return *this;
+	}
+
+public:
+	/// accessor & mutator
+	T & operator()(const std::size_t row, const std::size_t col)  {  return data_[row * cols_ + col];  }
+	const T & operator()(const std::size_t row, const std::size_t col) const  {  return data_[row * cols_ + col];  }
+	T * row(const std::size_t row)  {  return data_ + row * cols_;  }
+	const T * row(const std::size_t row) const  {  return data_ + row * cols_;  }
+	T * data()  {  return data_;  }
+	const T * data() const  {  return data_;  }
+
+	std::size_t rows() const  {  return rows_;  }
+	std::size_t cols() const  {  return cols_;  }
+	std::size_t stride() const  {  return cols_;  }
+	std::size_t size() const  {  return rows_ * cols_;  }
+	bool empty() const  {  return 0 == rows_ || 0 == cols_;  }
+
+	MatrixView<T> view()  {  return MatrixView<T>(data_, rows_, cols_);  }
+	MatrixView<T> block(const std::size_t row, const std::size_t col, const std::size_t rows, const std::size_t cols)  {  return view().block(row, col, rows, cols);  }
+
+	/// the elements are kept if the number of elements doesn't change. otherwise they're zero.
+	void resize(const std::size_t rows, const std::size_t cols)
+	{
+		if (rows * cols != size())
+		{
+			release();
+			allocate(rows, cols, T(0));
+		}
+		rows_ = rows;
+		cols_ = cols;
+	}
+	void fill(const T &value)  {  std::fill(data_, data_ + size(), value);  }
+	void setZero()  {  fill(T(0));  }
+
+	void swap(Matrix &rhs)
+	{
+		std::swap(rows_, rhs.rows_);
+		std::swap(cols_, rhs.cols_);
+		std::swap(data_, rhs.data_);
+	}
+
+	Matrix transpose() const
+	{
+		Matrix t(cols_, rows_);
+		for (std::size_t i = 0; i < rows_; ++i)
+			for (std::size_t j = 0; j < cols_; ++j)
+				t.data_[j * rows_ + i] = data_[i * cols_ + j];
+		return t;
+	}
+
+	static Matrix identity(const std::size_t n)
+	{
+		Matrix I(n, n);
+		for (std::size_t i = 0; i < n; ++i) I.data_[i * n + i] = T(1);
+		return I;
+	}
+
+	///
+	template<typename E>
+	Matrix & operator+=(const MatrixExpression<E> &expr)
+	{
+		view() += expr;
+		return *this;
+	}
+	template<typename E>
+	Matrix & operator-=(const MatrixExpression<E> &expr)
+	{
+		view() -= expr;
+		return *this;
+	}
+	Matrix & operator*=(const T &s)
+	{
+		for (T *p = data_, *end = data_ + size(); p != end; ++p) *p *= s;
 		return *this;
 	}
 
+public:
+	/// expression
+	void evalTo(const MatrixView<T> &dst, const T &alpha) const  {  constView().evalTo(dst, alpha);  }
+	void addTo(const MatrixView<T> &dst, const T &alpha) const  {  constView().addTo(dst, alpha);  }
+	bool aliases(const T *first, const T *last) const  {  return constView().aliases(first, last);  }
+	MatrixView<T> evaluate(Matrix & /*tmp*/) const  {  return constView();  }
+
+private:
+	MatrixView<T> constView() const  {  return MatrixView<T>(data_, rows_, cols_);  }
+
+	void allocate(const std::size_t rows, const std::size_t cols, const T &value)
+	{
+		if (0 != rows * cols)
+		{
+			data_ = static_cast<T *>(matrix_detail::allocateAligned(rows * cols * sizeof(T)));
+			std::uninitialized_fill(data_, data_ + rows * cols, value);
+		}
+		rows_ = rows;
+		cols_ = cols;
+	}
+	void release()
+	{
+		for (T *p = data_, *end = data_ + size(); p != end; ++p) p->~T();
+		matrix_detail::deallocateAligned(data_);
+		data_ = NULL;
+		rows_ = cols_ = 0;
+	}
+
 private:
+	std::size_t rows_;
+	std::size_t cols_;
+	T *data_;
+};
+
+//-----------------------------------------------------------------------------------------
+// class FixedMatrix: a small (R x C) row-major matrix stored in place
+//	- the products & sums of fixed-size matrices are computed directly with loops of fixed length.
+
+template<typename T, std::size_t R, std::size_t C>
+class FixedMatrix: public MatrixExpression<FixedMatrix<T, R, C> >
+{
+public:
+	typedef T value_type;
+
+public:
+	FixedMatrix()
+	{
+		std::fill(data_, data_ + R * C, T(0));
+	}
+	explicit FixedMatrix(const T rhs[R * C])
+	{
+		std::copy(rhs, rhs + R * C, data_);
+	}
+	template<typename E>
+	FixedMatrix(const MatrixExpression<E> &expr)
+	{
+		matrix_detail::checkSize(R, C, expr.derived().rows(), expr.derived().cols());
+		expr.derived().evalTo(constView(), T(1));
+	}
+
+	template<typename E>
+	FixedMatrix & operator=(const MatrixExpression<E> &expr)
+	{
+		constView() = expr;
+		return *this;
+	}
+
+public:
+	/// accessor & mutator
+	T & operator()(const std::size_t row, const std::size_t col)  {  return data_[row * C + col];  }
+	const T & operator()(const std::size_t row, const std::size_t col) const  {  return data_[row * C + col];  }
+	T * data()  {  return data_;  }
+	const T * data() const  {  return data_;  }
+
+	std::size_t rows() const  {  return R;  }
+	std::size_t cols() const  {  return C;  }
+	std::size_t stride() const  {  return C;  }
+
+	MatrixView<T> view()  {  return constView();  }
+
+	void fill(const T &value)  {  std::fill(data_, data_ + R * C, value);  }
+	void setZero()  {  fill(T(0));  }
+
+	FixedMatrix<T, C, R> transpose() const
+	{
+		FixedMatrix<T, C, R> t;
+		for (std::size_t i = 0; i < R; ++i)
+			for (std::size_t j = 0; j < C; ++j)
+				t(j, i) = data_[i * C + j];
+		return t;
+	}
+
+	static FixedMatrix identity()
+	{
+		FixedMatrix I;
+		for (std::size_t i = 0; i < R && i < C; ++i) I.data_[i * C + i] = T(1);
+		return I;
+	}
+
 	///
-	size_t row_;
-	size_t col_;
+	template<typename E>
+	FixedMatrix & operator+=(const MatrixExpression<E> &expr)
+	{
+		constView() += expr;
+		return *this;
+	}
+	template<typename E>
+	FixedMatrix & operator-=(const MatrixExpression<E> &expr)
+	{
+		constView() -= expr;
+		return *this;
+	}
+	FixedMatrix & operator*=(const T &s)
+	{
+		for (std::size_t i = 0; i < R * C; ++i) data_[i] *= s;
+		return *this;
+	}
+
+public:
+	/// expression
+	void evalTo(const MatrixView<T> &dst, const T &alpha) const  {  constView().evalTo(dst, alpha);  }
+	void addTo(const MatrixView<T> &dst, const T &alpha) const  {  constView().addTo(dst, alpha);  }
+	bool aliases(const T *first, const T *last) const  {  return constView().aliases(first, last);  }
+	MatrixView<T> evaluate(Matrix<T> & /*tmp*/) const  {  return constView();  }
+
+private:
+	MatrixView<T> constView() const  {  return MatrixView<T>(const_cast<T *>(data_), R, C);  }
+
+private:
+	T data_[R * C];
+};
+
+//-----------------------------------------------------------------------------------------
+// matrix expressions
+
+// lhs + rhsScale * rhs.
+template<typename L, typename R>
+class MatrixSum: public MatrixExpression<MatrixSum<L, R> >
+{
+public:
+	typedef typename L::value_type value_type;
+
+public:
+	MatrixSum(const L &lhs, const R &rhs, const value_type &rhsScale)
+	: lhs_(lhs), rhs_(rhs), rhsScale_(rhsScale)
+	{
+		matrix_detail::checkSize(lhs.rows(), lhs.cols(), rhs.rows(), rhs.cols());
+	}
+
+public:
+	std::size_t rows() const  {  return lhs_.rows();  }
+	std::size_t cols() const  {  return lhs_.cols();  }
+
+	void evalTo(const MatrixView<value_type> &dst, const value_type &alpha) const
+	{
+		lhs_.evalTo(dst, alpha);
+		rhs_.addTo(dst, alpha * rhsScale_);
+	}
+	void addTo(const MatrixView<value_type> &dst, const value_type &alpha) const
+	{
+		lhs_.addTo(dst, alpha);
+		rhs_.addTo(dst, alpha * rhsScale_);
+	}
+	bool aliases(const value_type *first, const value_type *last) const  {  return lhs_.aliases(first, last) || rhs_.aliases(first, last);  }
+	MatrixView<value_type> evaluate(Matrix<value_type> &tmp) const
+	{
+		tmp = *this;
+		return tmp.view();
+	}
 
-	/// entry
-	std::valarray<T> entry_;
+private:
+	typename matrix_detail::Nested<L>::type lhs_;
+	typename matrix_detail::Nested<R>::type rhs_;
+	const value_type rhsScale_;
 };
 
+// scale * expr.
+template<typename E>
+class MatrixScaled: public MatrixExpression<MatrixScaled<E> >
+{
+public:
+	typedef typename E::value_type value_type;
+
+public:
+	MatrixScaled(const E &expr, const value_type &scale)
+	: expr_(expr), scale_(scale)
+	{}
+
+public:
+	std::size_t rows() const  {  return expr_.rows();  }
+	std::size_t cols() const  {  return expr_.cols();  }
+
+	void evalTo(const MatrixView<value_type> &dst, const value_type &alpha) const  {  expr_.evalTo(dst, alpha * scale_);  }
+	void addTo(const MatrixView<value_type> &dst, const value_type &alpha) const  {  expr_.addTo(dst, alpha * scale_);  }
+	bool aliases(const value_type *first, const value_type *last) const  {  return expr_.aliases(first, last);  }
+	MatrixView<value_type> evaluate(Matrix<value_type> &tmp) const
+	{
+		tmp = *this;
+		return tmp.view();
+	}
+
+private:
+	typename matrix_detail::Nested<E>::type expr_;
+	const value_type scale_;
+};
+
+// lhs * rhs. operands which aren't matrices or views are evaluated into temporaries first.
+template<typename L, typename R>
+class MatrixProduct: public MatrixExpression<MatrixProduct<L, R> >
+{
+public:
+	typedef typename L::value_type value_type;
+
+public:
+	MatrixProduct(const L &lhs, const R &rhs)
+	: lhs_(lhs), rhs_(rhs)
+	{
+		if (lhs.cols() != rhs.rows())
+			throw LogException(LogException::L_ERROR, "mismatched matrix size", __FILE__, __LINE__, __FUNCTION__);
+	}
+
+public:
+	std::size_t rows() const  {  return lhs_.rows();  }
+	std::size_t cols() const  {  return rhs_.cols();  }
+
+	void evalTo(const MatrixView<value_type> &dst, const value_type &alpha) const  {  multiply(dst, alpha, value_type(0));  }
+	void addTo(const MatrixView<value_type> &dst, const value_type &alpha) const  {  multiply(dst, alpha, value_type(1));  }
+	bool aliases(const value_type *first, const value_type *last) const  {  return lhs_.aliases(first, last) || rhs_.aliases(first, last);  }
+	MatrixView<value_type> evaluate(Matrix<value_type> &tmp) const
+	{
+		tmp = *this;
+		return tmp.view();
+	}
+
+private:
+	void multiply(const MatrixView<value_type> &dst, const value_type &alpha, const value_type &beta) const
+	{
+		Matrix<value_type> lhsTmp, rhsTmp;
+		const MatrixView<value_type> &a = lhs_.evaluate(lhsTmp);
+		const MatrixView<value_type> &b = rhs_.evaluate(rhsTmp);
+		if (1 == b.cols())
+			matrix_detail::gemv(a.rows(), a.cols(), alpha, a.data(), a.stride(), b.data(), b.stride(), beta, dst.data(), dst.stride());
+		else
+			matrix_detail::gemm(a.rows(), b.cols(), a.cols(), alpha, a.data(), a.stride(), b.data(), b.stride(), beta, dst.data(), dst.stride());
+	}
+
+private:
+	typename matrix_detail::Nested<L>::type lhs_;
+	typename matrix_detail::Nested<R>::type rhs_;
+};
+
+//-----------------------------------------------------------------------------------------
+// class MatrixView
+
+template<typename T>
+template<typename E>
+void MatrixView<T>::assign(const E &expr)
+{
+	matrix_detail::checkSize(rows_, cols_, expr.rows(), expr.cols());
+	if (expr.aliases(data_, data_ + (rows_ ? (rows_ - 1) * stride_ + cols_ : 0)))
+	{
+		const Matrix<T> tmp(expr);
+		tmp.evalTo(*this, T(1));
+	}
+	else expr.evalTo(*this, T(1));
+}
+
+template<typename T>
+template<typename E>
+void MatrixView<T>::accumulate(const E &expr, const T &alpha)
+{
+	matrix_detail::checkSize(rows_, cols_, expr.rows(), expr.cols());
+	if (expr.aliases(data_, data_ + (rows_ ? (rows_ - 1) * stride_ + cols_ : 0)))
+	{
+		const Matrix<T> tmp(expr);
+		tmp.addTo(*this, alpha);
+	}
+	else expr.addTo(*this, alpha);
+}
 
 //-----------------------------------------------------------------------------------------
 // Matrix API
-		
+
+template<typename L, typename R>
+inline MatrixSum<L, R> operator+(const MatrixExpression<L> &lhs, const MatrixExpression<R> &rhs)
+{  return MatrixSum<L, R>(lhs.derived(), rhs.derived(), typename L::value_type(1));  }
+
+template<typename L, typename R>
+inline MatrixSum<L, R> operator-(const MatrixExpression<L> &lhs, const MatrixExpression<R> &rhs)
+{  return MatrixSum<L, R>(lhs.derived(), rhs.derived(), typename L::value_type(-1));  }
+
+template<typename E>
+inline MatrixScaled<E> operator-(const MatrixExpression<E> &expr)
+{  return MatrixScaled<E>(expr.derived(), typename E::value_type(-1));  }
+
+template<typename E>
+inline MatrixScaled<E> operator*(const MatrixExpression<E> &expr, const typename E::value_type &s)
+{  return MatrixScaled<E>(expr.derived(), s);  }
+
+template<typename E>
+inline MatrixScaled<E> operator*(const typename E::value_type &s, const MatrixExpression<E> &expr)
+{  return MatrixScaled<E>(expr.derived(), s);  }
+
+template<typename E>
+inline MatrixScaled<E> operator/(const MatrixExpression<E> &expr, const typename E::value_type &s)
+{  return MatrixScaled<E>(expr.derived(), typename E::value_type(1) / s);  }
+
+template<typename L, typename R>
+inline MatrixProduct<L, R> operator*(const MatrixExpression<L> &lhs, const MatrixExpression<R> &rhs)
+{  return MatrixProduct<L, R>(lhs.derived(), rhs.derived());  }
+
+// fixed-size matrices.
+template<typename T, std::size_t R, std::size_t K, std::size_t C>
+inline FixedMatrix<T, R, C> operator*(const FixedMatrix<T, R, K> &lhs, const FixedMatrix<T, K, C> &rhs)
+{
+	FixedMatrix<T, R, C> prod;
+	for (std::size_t i = 0; i < R; ++i)
+		for (std::size_t p = 0; p < K; ++p)
+			for (std::size_t j = 0; j < C; ++j)
+				prod(i, j) += lhs(i, p) * rhs(p, j);
+	return prod;
+}
+
+template<typename T, std::size_t R, std::size_t C>
+inline FixedMatrix<T, R, C> operator+(const FixedMatrix<T, R, C> &lhs, const FixedMatrix<T, R, C> &rhs)
+{
+	FixedMatrix<T, R, C> sum(lhs);
+	for (std::size_t i = 0; i < R * C; ++i) sum.data()[i] += rhs.data()[i];
+	return sum;
+}
+
+template<typename T, std::size_t R, std::size_t C>
+inline FixedMatrix<T, R, C> operator-(const FixedMatrix<T, R, C> &lhs, const FixedMatrix<T, R, C> &rhs)
+{
+	FixedMatrix<T, R, C> diff(lhs);
+	for (std::size_t i = 0; i < R * C; ++i) diff.data()[i] -= rhs.data()[i];
+	return diff;
+}
+
+// zero-copy views onto the matrices of other libraries.
+template<typename T>
+inline MatrixView<T> makeMatrixView(T *data, const std::size_t rows, const std::size_t cols, const std::size_t stride)
+{  return MatrixView<T>(data, rows, cols, stride);  }
+
+// a gsl_matrix (T = double) or a gsl_matrix_float (T = float).
+//	e.g.) swl::MatrixView<double> A(swl::makeGslMatrixView<double>(*gslMat));
+template<typename T, typename GslMatrix>
+inline MatrixView<T> makeGslMatrixView(GslMatrix &mat)
+{  return MatrixView<T>(mat.data, mat.size1, mat.size2, mat.tda);  }
+
+// a single-channel cv::Mat whose elements are of type T.
+//	e.g.) swl::MatrixView<float> A(swl::makeCvMatView<float>(cvMat));
+template<typename T, typename CvMat>
+inline MatrixView<T> makeCvMatView(CvMat &mat)
+{
+	if (mat.empty()) return MatrixView<T>(NULL, 0, 0, 0);
+	if (1 != mat.channels() || sizeof(T) != mat.elemSize())
+		throw LogException(LogException::L_ERROR, "illegal element type", __FILE__, __LINE__, __FUNCTION__);
+	return MatrixView<T>(mat.template ptr<T>(0), (std::size_t)mat.rows, (std::size_t)mat.cols, mat.step1());
+}
+
+// a row-major Eigen matrix or Eigen::Map, or a column vector.
+//	a swl::Matrix can be viewed the other way by Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> >(A.data(), A.rows(), A.cols()).
+template<typename EigenDense>
+inline MatrixView<typename EigenDense::Scalar> makeEigenMatrixView(EigenDense &mat)
+{
+	typedef MatrixView<typename EigenDense::Scalar> view_type;
+	if (EigenDense::IsRowMajor && 1 == mat.innerStride())
+		return view_type(mat.data(), (std::size_t)mat.rows(), (std::size_t)mat.cols(), (std::size_t)mat.outerStride());
+	else if (!EigenDense::IsRowMajor && 1 == mat.cols())
+		return view_type(mat.data(), (std::size_t)mat.rows(), 1, (std::size_t)mat.innerStride());
+	else
+		throw LogException(LogException::L_ERROR, "the rows aren't contiguous", __FILE__, __LINE__, __FUNCTION__);
+}
 
 }  // namespace swl
 
@@ -0,0 +1,71 @@
+#if !defined(__SWL_MATH__MULTIVARIATE_NORMAL_DISTRIBUTION__H_)
+#define __SWL_MATH__MULTIVARIATE_NORMAL_DISTRIBUTION__H_ 1
+
+
+#include "swl/math/ExportMath.h"
+#include <Eigen/Core>
+
+
+namespace swl {
+
+//-----------------------------------------------------------------------------------------
+// MultivariateNormalDistribution.
+
+// a multivariate normal distribution whose covariance is factored once.
+//	- log p(x) = logNormalizer - 0.5 * |L^-1 * (x - mean)|^2, where cov = L * L^T & logNormalizer = -0.5 * (n * log(2 * pi) + log|cov|).
+//	- a diagonal or an isotropic covariance is stored as the reciprocals of the standard deviations & needs no solve.
+//	- the sizes are checked only on construction. the evaluations assume points of the right dimension.
+class SWL_MATH_API MultivariateNormalDistribution
+{
+public:
+	//typedef MultivariateNormalDistribution base_type;
+
+	enum CovarianceType { FULL_COVARIANCE = 0, DIAGONAL_COVARIANCE, ISOTROPIC_COVARIANCE };
+
+public:
+	/// a full covariance matrix.
+	MultivariateNormalDistribution(const Eigen::VectorXd &mean, const Eigen::MatrixXd &cov);
+	/// a diagonal covariance matrix, diag(variances).
+	MultivariateNormalDistribution(const Eigen::VectorXd &mean, const Eigen::VectorXd &variances);
+	/// an isotropic covariance matrix, variance * I.
+	MultivariateNormalDistribution(const Eigen::VectorXd &mean, const double variance);
+
+public:
+	///
+	double logPdf(const Eigen::VectorXd &x) const;
+	double pdf(const Eigen::VectorXd &x) const;
+	/// (x - mean)^T * cov^-1 * (x - mean).
+	double squaredMahalanobisDistance(const Eigen::VectorXd &x) const;
+
+	/// the points are the columns of X. logPdfs(j) = log p(X.col(j)).
+	void logPdf(const Eigen::MatrixXd &X, Eigen::VectorXd &logPdfs) const;
+	void pdf(const Eigen::MatrixXd &X, Eigen::VectorXd &pdfs) const;
+
+	///
+	std::size_t dimension() const  {  return (std::size_t)mean_.size();  }
+	CovarianceType getCovarianceType() const  {  return covType_;  }
+	const Eigen::VectorXd & getMean() const  {  return mean_;  }
+	double getLogNormalizer() const  {  return logNormalizer_;  }
+
+private:
+	void initializeDiagonal(const Eigen::VectorXd &variances);
+
+	/// whitens the columns of Z in place: Z = L^-1 * Z.
+	void whiten(Eigen::Ref<Eigen::MatrixXd> Z) const;
+
+private:
+	CovarianceType covType_;
+	Eigen::VectorXd mean_;
+
+	// the lower triangular Cholesky factor for FULL_COVARIANCE.
+	Eigen::MatrixXd L_;
+	// 1 / standard deviations for DIAGONAL_COVARIANCE. the first entry is used for ISOTROPIC_COVARIANCE.
+	Eigen::VectorXd invStdDevs_;
+
+	double logNormalizer_;
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_MATH__MULTIVARIATE_NORMAL_DISTRIBUTION__H_
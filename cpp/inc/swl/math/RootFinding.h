@@ -3,10 +3,16 @@
 
 
 #include "swl/math/MathConstant.h"
+#include "swl/math/MathUtil.h"
 #include "swl/math/Complex.h"
+#include "swl/base/LogException.h"
+#include <type_traits>
+#include <algorithm>
 #include <vector>
 #include <array>
 #include <complex>
+#include <limits>
+#include <cmath>
 
 
 namespace swl {
@@ -16,6 +22,24 @@ namespace swl {
 
 struct SWL_MATH_API RootFinding
 {
+public:
+	/**
+	 *	@brief The termination status of a solver with diagnostics.
+	 */
+	enum Status { CONVERGED = 0, NOT_BRACKETED, ZERO_DERIVATIVE, NOT_FINITE, ITERATION_LIMIT_REACHED };
+
+	/**
+	 *	@brief The diagnostics of a solver.
+	 *	residual is f at the last evaluated point, which is one step behind root for Newton's & Halley's methods.
+	 */
+	struct Result
+	{
+		double root;
+		double residual;
+		std::size_t iterations;
+		Status status;
+	};
+
 public:
 	/**
 	 *	@defgroup SolveEquation Solve an equation, f(x) = 0
@@ -26,17 +50,48 @@ public:
 	 *	@brief Solve f(x) = 0 using the secant method.
 	 */
 	static double secant(double init, double (*func)(double), const double& tol = MathConstant::EPS);
-	//template<class Functor> static double secant(double init, Functor func, const double& tol = MathConstant::EPS);
+	template<class Functor> static double secant(double init, Functor func, const double& tol = MathConstant::EPS);
 	/**
 	 *	@brief Solve f(x) = 0 using the bisection method.
 	 */
 	static double bisection(double left, double right, double (*func)(double), const double& tol = MathConstant::EPS);
-	//template<class Functor> static double bisection(double left, double right, Functor func, const double& tol = MathConstant::EPS);
+	template<class Functor> static double bisection(double left, double right, Functor func, const double& tol = MathConstant::EPS);
 	/**
 	 *	@brief Solve f(x) = 0 using the false position method.
 	 */
 	static double falsePosition(double left, double right, double (*func)(double), const double& tol = MathConstant::EPS);
-	//template<class Functor> static double falsePosition(double left, double right, Functor func, const double& tol = MathConstant::EPS);
+	template<class Functor> static double falsePosition(double left, double right, Functor func, const double& tol = MathConstant::EPS);
+
+	/**
+	 *	@brief Solve f(x) = 0 in [left, right] using Brent's method.
+	 *	f(left) & f(right) must have opposite signs. The root is found within tol.
+	 */
+	template<class Functor> static Result brent(double left, double right, Functor func, const double& tol = MathConstant::TOL_10, const std::size_t maxIterations = MathConstant::ITERATION_LIMIT);
+	/**
+	 *	@brief Solve f(x) = 0 using Newton's method.
+	 *	func(x, f, df) sets f = f(x) & df = f'(x). The iteration stops when a step is within tol * (1 + |x|).
+	 */
+	template<class Functor> static Result newton(double init, Functor func, const double& tol = MathConstant::TOL_10, const std::size_t maxIterations = MathConstant::ITERATION_LIMIT);
+	/**
+	 *	@brief Solve f(x) = 0 using Halley's method.
+	 *	func(x, f, df, d2f) sets f = f(x), df = f'(x) & d2f = f''(x). A step is limited to twice the Newton step.
+	 */
+	template<class Functor> static Result halley(double init, Functor func, const double& tol = MathConstant::TOL_10, const std::size_t maxIterations = MathConstant::ITERATION_LIMIT);
+
+	/**
+	 *	@brief Solve count independent equations f_i(x) = 0 using Newton's method in lock step.
+	 *	func(i, x, f, df) evaluates the i-th equation. All the unfinished problems advance by one step per iteration,
+	 *	and a problem leaves the batch as soon as it terminates. <br/>
+	 *	If lefts & rights are given, f_i(lefts[i]) & f_i(rights[i]) must have opposite signs, and a step leaving the bracket is replaced by bisection.
+	 *	@return The number of the converged problems.
+	 */
+	template<class Functor> static std::size_t newton(const std::size_t count, const double *inits, Functor func, Result *results, const double *lefts = NULL, const double *rights = NULL, const double& tol = MathConstant::TOL_10, const std::size_t maxIterations = MathConstant::ITERATION_LIMIT);
+	/**
+	 *	@brief Solve count independent equations f_i(x) = 0 using Halley's method in lock step.
+	 *	func(i, x, f, df, d2f) evaluates the i-th equation.
+	 *	@see newton()
+	 */
+	template<class Functor> static std::size_t halley(const std::size_t count, const double *inits, Functor func, Result *results, const double *lefts = NULL, const double *rights = NULL, const double& tol = MathConstant::TOL_10, const std::size_t maxIterations = MathConstant::ITERATION_LIMIT);
 
 	/**
 	 *	@}
@@ -63,6 +118,15 @@ public:
 	 */
 	static bool quartic(const std::array<double, 5>& coeffs, std::array<std::complex<double>, 4>& roots, const double& tol = MathConstant::EPS);
 
+	/**
+	 *	@brief Solve count 2nd, 3rd & 4th order polynomials.
+	 *	Nothing is thrown. The roots of an illegal polynomial are set to NaN.
+	 *	@return The number of the solved polynomials.
+	 */
+	static std::size_t quadratic(const std::size_t count, const std::array<double, 3> *coeffs, std::array<std::complex<double>, 2> *roots, const double& tol = MathConstant::EPS);
+	static std::size_t cubic(const std::size_t count, const std::array<double, 4> *coeffs, std::array<std::complex<double>, 3> *roots, const double& tol = MathConstant::EPS);
+	static std::size_t quartic(const std::size_t count, const std::array<double, 5> *coeffs, std::array<std::complex<double>, 4> *roots, const double& tol = MathConstant::EPS);
+
 	/**
 	 *	@brief Solve n-th order polynomials using Bairstow's method.
 	 *	Coefficients are arranged by a descending order.
@@ -89,8 +153,412 @@ public:
 	/**
 	 *	@}
 	 */
+
+private:
+	/// Advance x by a Newton (or Halley) step safeguarded by the bracket [lo, hi].
+	/// orientation is 1 if f(lo) < 0 < f(hi), -1 if f(lo) > 0 > f(hi) & 0 without a bracket.
+	/// @return true if the iteration terminates.
+	static bool step(const double x, const double f, const double df, const double d2f, const int orientation, double &lo, double &hi, const double tol, double &next, Status &status);
+
+	template<bool UseSecondDerivative, class Functor> static Result iterate(double x, Functor &func, const double tol, const std::size_t maxIterations);
+	template<bool UseSecondDerivative, class Functor> static std::size_t iterate(const std::size_t count, const double *inits, Functor &func, Result *results, const double *lefts, const double *rights, const double tol, const std::size_t maxIterations);
+
+	template<class Functor> static void evaluate(Functor &func, const double x, double &f, double &df, double &d2f, std::false_type)  {  func(x, f, df);  d2f = 0.0;  }
+	template<class Functor> static void evaluate(Functor &func, const double x, double &f, double &df, double &d2f, std::true_type)  {  func(x, f, df, d2f);  }
+	template<class Functor> static void evaluate(Functor &func, const std::size_t i, const double x, double &f, double &df, double &d2f, std::false_type)  {  func(i, x, f, df);  d2f = 0.0;  }
+	template<class Functor> static void evaluate(Functor &func, const std::size_t i, const double x, double &f, double &df, double &d2f, std::true_type)  {  func(i, x, f, df, d2f);  }
 };
 
+//-----------------------------------------------------------------------------------------
+// Root Finding.
+
+template<class Functor>
+/*static*/ double RootFinding::secant(double init, Functor func, const double& tol /*= MathConstant::EPS*/)
+{
+	double delta, final;
+	double front, rear;
+
+	final = init + 2.0;
+	front = func(init);
+	rear = func(final);
+
+	int i = 0;
+	do
+	{
+		if (MathUtil::isZero(rear-front, tol))
+		{
+			throw LogException(LogException::L_ERROR, "Divide by zero", __FILE__, __LINE__, __FUNCTION__);
+			//return 0.0;
+		}
+
+		delta = -rear * (final - init) / (rear - front);
+		init = final;
+		final += delta;
+		front = rear;
+		rear = func(final);
+		++i;
+
+		if (i >= MathConstant::ITERATION_LIMIT)
+		{
+			throw LogException(LogException::L_ERROR, "Iteration overflow", __FILE__, __LINE__, __FUNCTION__);
+			//return final;
+		}
+	} while (std::abs(delta) > tol || std::abs(rear) > tol);
+
+	return final;
+}
+
+template<class Functor>
+/*static*/ double RootFinding::bisection(double left, double right, Functor func, const double& tol /*= MathConstant::EPS*/)
+{
+	double front, rear;
+	front = func(left);
+	rear = func(right);
+
+	if (front * rear >= 0.0)
+	{
+		throw LogException(LogException::L_ERROR, "Illegal parameter value", __FILE__, __LINE__, __FUNCTION__);
+		//return 0.0;
+	}
+
+	double mid, delta, temp;
+	int i = 0;
+	do
+	{
+		mid = (left + right) / 2.0;
+		temp = func(mid);
+
+		if (temp * front > 0.0)
+		{
+			front = temp;
+			delta = mid - left;
+			left = mid;
+		}
+		else
+		{
+			rear = temp;
+			delta = mid - right;
+			right = mid;
+		}
+		++i;
+
+		if (i >= MathConstant::ITERATION_LIMIT)
+		{
+			throw LogException(LogException::L_ERROR, "Iteration overflow", __FILE__, __LINE__, __FUNCTION__);
+			//return mid;
+		}
+	} while (std::abs(delta) > tol || std::abs(temp) > tol);
+
+	return mid;
+}
+
+template<class Functor>
+/*static*/ double RootFinding::falsePosition(double left, double right, Functor func, const double& tol /*= MathConstant::EPS*/)
+{
+	double front, rear;
+	front = func(left);
+	rear = func(right);
+
+	if (front * rear >= 0.0)
+	{
+		throw LogException(LogException::L_ERROR, "Illegal parameter value", __FILE__, __LINE__, __FUNCTION__);
+		//return 0.0;
+	}
+
+	double inter, delta, temp;
+	int i = 0;
+	do
+	{
+		inter =  (right * front - left * rear) / (front - rear);
+		temp = func(inter);
+		if (temp * front > 0.0)
+		{
+			front = temp;
+			delta = inter - left;
+			left = inter;
+		}
+		else
+		{
+			rear = temp;
+			delta = inter - right;
+			right = inter;
+		}
+		++i;
+
+		if (i >= MathConstant::ITERATION_LIMIT)
+		{
+			throw LogException(LogException::L_ERROR, "Iteration overflow", __FILE__, __LINE__, __FUNCTION__);
+			//return inter;
+		}
+	}  while (std::abs(delta) > tol || std::abs(temp) > tol);
+
+	return inter;
+}
+
+template<class Functor>
+/*static*/ RootFinding::Result RootFinding::brent(double left, double right, Functor func, const double& tol /*= MathConstant::TOL_10*/, const std::size_t maxIterations /*= MathConstant::ITERATION_LIMIT*/)
+{
+	const double eps = std::numeric_limits<double>::epsilon();
+
+	double a = left, b = right, fa = func(a), fb = func(b);
+	Result result = { b, fb, 0, CONVERGED };
+	if (0.0 == fa)
+	{
+		result.root = a;
+		result.residual = fa;
+		return result;
+	}
+	if (0.0 == fb) return result;
+	if ((fa > 0.0) == (fb > 0.0))
+	{
+		result.status = NOT_BRACKETED;
+		return result;
+	}
+
+	// b is the best estimate, a is the previous one & the root is between b & c.
+	double c = b, fc = fb, d = b - a, e = d;
+	for (result.iterations = 1; result.iterations <= maxIterations; ++result.iterations)
+	{
+		if ((fb > 0.0) == (fc > 0.0))
+		{
+			c = a;
+			fc = fa;
+			e = d = b - a;
+		}
+		if (std::abs(fc) < std::abs(fb))
+		{
+			a = b;  b = c;  c = a;
+			fa = fb;  fb = fc;  fc = fa;
+		}
+
+		const double tol1 = 2.0 * eps * std::abs(b) + 0.5 * tol, xm = 0.5 * (c - b);
+		if (std::abs(xm) <= tol1 || 0.0 == fb)
+		{
+			result.root = b;
+			result.residual = fb;
+			return result;
+		}
+
+		if (std::abs(e) >= tol1 && std::abs(fa) > std::abs(fb))
+		{
+			// the secant step if a == c, the inverse quadratic interpolation otherwise.
+			const double s = fb / fa;
+			double p, q;
+			if (a == c)
+			{
+				p = 2.0 * xm * s;
+				q = 1.0 - s;
+			}
+			else
+			{
+				const double qq = fa / fc, r = fb / fc;
+				p = s * (2.0 * xm * qq * (qq - r) - (b - a) * (r - 1.0));
+				q = (qq - 1.0) * (r - 1.0) * (s - 1.0);
+			}
+			if (p > 0.0) q = -q;
+			p = std::abs(p);
+
+			// accept the interpolation only if it falls within the bracket & converges fast enough.
+			if (2.0 * p < std::min(3.0 * xm * q - std::abs(tol1 * q), std::abs(e * q)))
+			{
+				e = d;
+				d = p / q;
+			}
+			else
+			{
+				d = xm;
+				e = d;
+			}
+		}
+		else
+		{
+			d = xm;
+			e = d;
+		}
+
+		a = b;
+		fa = fb;
+		b += std::abs(d) > tol1 ? d : (xm >= 0.0 ? tol1 : -tol1);
+		fb = func(b);
+	}
+
+	result.root = b;
+	result.residual = fb;
+	result.iterations = maxIterations;
+	result.status = ITERATION_LIMIT_REACHED;
+	return result;
+}
+
+template<class Functor>
+/*static*/ RootFinding::Result RootFinding::newton(double init, Functor func, const double& tol /*= MathConstant::TOL_10*/, const std::size_t maxIterations /*= MathConstant::ITERATION_LIMIT*/)
+{
+	return iterate<false>(init, func, tol, maxIterations);
+}
+
+template<class Functor>
+/*static*/ RootFinding::Result RootFinding::halley(double init, Functor func, const double& tol /*= MathConstant::TOL_10*/, const std::size_t maxIterations /*= MathConstant::ITERATION_LIMIT*/)
+{
+	return iterate<true>(init, func, tol, maxIterations);
+}
+
+template<class Functor>
+/*static*/ std::size_t RootFinding::newton(const std::size_t count, const double *inits, Functor func, Result *results, const double *lefts /*= NULL*/, const double *rights /*= NULL*/, const double& tol /*= MathConstant::TOL_10*/, const std::size_t maxIterations /*= MathConstant::ITERATION_LIMIT*/)
+{
+	return iterate<false>(count, inits, func, results, lefts, rights, tol, maxIterations);
+}
+
+template<class Functor>
+/*static*/ std::size_t RootFinding::halley(const std::size_t count, const double *inits, Functor func, Result *results, const double *lefts /*= NULL*/, const double *rights /*= NULL*/, const double& tol /*= MathConstant::TOL_10*/, const std::size_t maxIterations /*= MathConstant::ITERATION_LIMIT*/)
+{
+	return iterate<true>(count, inits, func, results, lefts, rights, tol, maxIterations);
+}
+
+inline /*static*/ bool RootFinding::step(const double x, const double f, const double df, const double d2f, const int orientation, double &lo, double &hi, const double tol, double &next, Status &status)
+{
+	if (0.0 == f)
+	{
+		next = x;
+		status = CONVERGED;
+		return true;
+	}
+
+	// shrink the bracket to the side where f changes its sign.
+	if (orientation * f < 0.0) lo = x;
+	else if (orientation * f > 0.0) hi = x;
+
+	// Halley's step is the Newton step divided by 1 - f * f'' / (2 * f'^2), which is not allowed to drop below 1/2.
+	const double newtonStep = f / df;
+	const double ratio = 0.5 * newtonStep * d2f / df;
+	next = x - (ratio < 0.5 ? newtonStep / (1.0 - ratio) : newtonStep);
+	// out of the bracket or not finite.
+	if (!(next > lo && next < hi)) next = 0.5 * (lo + hi);
+
+	if (!std::isfinite(next))
+	{
+		next = x;
+		status = 0.0 == df ? ZERO_DERIVATIVE : NOT_FINITE;
+		return true;
+	}
+	if (std::abs(next - x) <= tol * (1.0 + std::abs(next)) || hi - lo <= tol * (1.0 + std::abs(next)))
+	{
+		status = CONVERGED;
+		return true;
+	}
+	return false;
+}
+
+template<bool UseSecondDerivative, class Functor>
+/*static*/ RootFinding::Result RootFinding::iterate(double x, Functor &func, const double tol, const std::size_t maxIterations)
+{
+	double lo = -std::numeric_limits<double>::infinity(), hi = std::numeric_limits<double>::infinity();
+	Result result = { x, 0.0, 0, ITERATION_LIMIT_REACHED };
+	for (result.iterations = 1; result.iterations <= maxIterations; ++result.iterations)
+	{
+		double df, d2f;
+		evaluate(func, x, result.residual, df, d2f, std::integral_constant<bool, UseSecondDerivative>());
+		const bool terminated = step(x, result.residual, df, d2f, 0, lo, hi, tol, result.root, result.status);
+		x = result.root;
+		if (terminated) return result;
+	}
+
+	result.iterations = maxIterations;
+	result.status = ITERATION_LIMIT_REACHED;
+	return result;
+}
+
+template<bool UseSecondDerivative, class Functor>
+/*static*/ std::size_t RootFinding::iterate(const std::size_t count, const double *inits, Functor &func, Result *results, const double *lefts, const double *rights, const double tol, const std::size_t maxIterations)
+{
+	const std::integral_constant<bool, UseSecondDerivative> useSecondDerivative;
+	const double inf = std::numeric_limits<double>::infinity();
+
+	// the state of the unfinished problems, packed to the front.
+	std::vector<std::size_t> indices;
+	std::vector<double> xs, los, his, fs(count), dfs(count), d2fs(count);
+	std::vector<int> orientations;
+	indices.reserve(count);
+	xs.reserve(count);
+	los.reserve(count);
+	his.reserve(count);
+	orientations.reserve(count);
+
+	std::size_t convergedCount = 0;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		double x = inits[i], lo = -inf, hi = inf;
+		int orientation = 0;
+		if (lefts && rights)
+		{
+			lo = std::min(lefts[i], rights[i]);
+			hi = std::max(lefts[i], rights[i]);
+
+			double flo, fhi, df, d2f;
+			evaluate(func, i, lo, flo, df, d2f, useSecondDerivative);
+			evaluate(func, i, hi, fhi, df, d2f, useSecondDerivative);
+			if (0.0 == flo || 0.0 == fhi)
+			{
+				const Result result = { 0.0 == flo ? lo : hi, 0.0, 0, CONVERGED };
+				results[i] = result;
+				++convergedCount;
+				continue;
+			}
+			if ((flo > 0.0) == (fhi > 0.0))
+			{
+				const Result result = { x, fhi, 0, NOT_BRACKETED };
+				results[i] = result;
+				continue;
+			}
+			orientation = flo < 0.0 ? 1 : -1;
+			if (!(x > lo && x < hi)) x = 0.5 * (lo + hi);
+		}
+
+		indices.push_back(i);
+		xs.push_back(x);
+		los.push_back(lo);
+		his.push_back(hi);
+		orientations.push_back(orientation);
+	}
+
+	std::size_t activeCount = indices.size();
+	for (std::size_t iter = 1; iter <= maxIterations && activeCount > 0; ++iter)
+	{
+		for (std::size_t k = 0; k < activeCount; ++k)
+			evaluate(func, indices[k], xs[k], fs[k], dfs[k], d2fs[k], useSecondDerivative);
+
+		// a finished problem is written out & the rest are moved down over it.
+		std::size_t kept = 0;
+		for (std::size_t k = 0; k < activeCount; ++k)
+		{
+			double next;
+			Status status;
+			if (step(xs[k], fs[k], dfs[k], d2fs[k], orientations[k], los[k], his[k], tol, next, status))
+			{
+				const Result result = { next, fs[k], iter, status };
+				results[indices[k]] = result;
+				if (CONVERGED == status) ++convergedCount;
+			}
+			else
+			{
+				indices[kept] = indices[k];
+				xs[kept] = next;
+				fs[kept] = fs[k];
+				los[kept] = los[k];
+				his[kept] = his[k];
+				orientations[kept] = orientations[k];
+				++kept;
+			}
+		}
+		activeCount = kept;
+	}
+
+	for (std::size_t k = 0; k < activeCount; ++k)
+	{
+		const Result result = { xs[k], fs[k], maxIterations, ITERATION_LIMIT_REACHED };
+		results[indices[k]] = result;
+	}
+	return convergedCount;
+}
+
 }  // namespace swl
 
 
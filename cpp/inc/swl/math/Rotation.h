@@ -27,6 +27,8 @@ public:
 
 struct SWL_MATH_API RotationAngle
 {
+	friend struct RotationArray;
+
 public:
 	RotationAngle(const double alpha = 0.0, const double beta = 0.0, const double gamma = 0.0)
 	: alpha_(alpha), beta_(beta), gamma_(gamma)
@@ -460,6 +462,42 @@ private:
 	static RMatrix3<double> rotateRelativeZYZ(const double alpha, const double beta, const double gamma);
 };
 
+
+//-----------------------------------------------------------------------------------------
+// struct RotationArray: conversions of rotations stored as structure-of-arrays
+
+//	- a batch of rotation matrices is nine arrays, mats[i][n] being the entry i of the n-th RMatrix3, e.g. as in RMatrix3::get().
+//	- a batch of quaternions is four arrays, quats[0][n], ..., quats[3][n] being q0, ..., q3 of the n-th quaternion.
+//	- a batch of rotation angles is three arrays, alpha, beta & gamma.
+//	- the rotation order is decoded once per batch & each axis order has its own loop. the sines & cosines of a batch are
+//		computed a block at a time with a branch-free polynomial which the compiler can vectorize.
+//	- the angles of the null axes of an order are ignored, where Rotation::rotate() throws an exception.
+//	- the outputs may be the same arrays as the inputs.
+struct SWL_MATH_API RotationArray
+{
+public:
+	/// rotation angles ==> rotation matrices & quaternions
+	static void rotate(const unsigned int order, const std::size_t count, const double *alpha, const double *beta, const double *gamma, double * const mats[9]);
+	static void toQuaternion(const unsigned int order, const std::size_t count, const double *alpha, const double *beta, const double *gamma, double * const quats[4]);
+
+	/// rotation matrices ==> rotation angles, the same as RotationAngle::calc()
+	static void calc(const unsigned int order, const std::size_t count, const double * const mats[9], double *alpha, double *beta, double *gamma);
+
+	/// rotation matrices <==> unit quaternions. the quaternions have q0 >= 0.
+	static void toQuaternion(const std::size_t count, const double * const mats[9], double * const quats[4]);
+	static void toRotationMatrix(const std::size_t count, const double * const quats[4], double * const mats[9]);
+
+	/// quats = lhs * rhs
+	static void multiply(const std::size_t count, const double * const lhs[4], const double * const rhs[4], double * const quats[4]);
+	/// unit quaternions. zero quaternions are left as they are.
+	static void normalize(const std::size_t count, const double * const quats[4], double * const unitQuats[4]);
+	/// spherical linear interpolation between unit quaternions, the same as Quaternion<double>::slerp(t[n], uq0, uq1).
+	static void slerp(const std::size_t count, const double *t, const double * const uq0[4], const double * const uq1[4], double * const quats[4]);
+
+	/// sin(angle[n]) & cos(angle[n])
+	static void sincos(const std::size_t count, const double *angle, double *s, double *c);
+};
+
 }  // namespace swl
 
 
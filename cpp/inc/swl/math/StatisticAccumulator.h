@@ -0,0 +1,174 @@
+#if !defined(__SWL_MATH__STATISTIC_ACCUMULATOR__H_)
+#define __SWL_MATH__STATISTIC_ACCUMULATOR__H_ 1
+
+
+#include "swl/math/ExportMath.h"
+#include <Eigen/Core>
+#include <vector>
+#include <deque>
+#include <utility>
+
+
+namespace swl {
+
+//-----------------------------------------------------------------------------------------
+// StatisticAccumulator.
+
+// one-pass statistics of a scalar sample.
+//	- the mean & the 2nd, 3rd & 4th central moments are updated by Welford's method & merged by Pebay's formulas,
+//		so partial results of the parts of a sample can be computed separately & combined.
+//	- the statistics are the same as the ones of Statistic with the mean of the sample.
+class SWL_MATH_API StatisticAccumulator
+{
+public:
+	//typedef StatisticAccumulator base_type;
+
+public:
+	StatisticAccumulator();
+
+private:
+	StatisticAccumulator(const std::size_t count, const double mean, const double M2, const double M3, const double M4, const double minimum, const double maximum);
+
+	friend class SlidingStatisticAccumulator;
+
+public:
+	///
+	void add(const double x);
+	void add(const double *sample, const std::size_t count);
+	void add(const std::vector<double> &sample)  {  if (!sample.empty()) add(&sample[0], sample.size());  }
+	// the result is the same as if all the values added to rhs were added to this.
+	void merge(const StatisticAccumulator &rhs);
+	void clear();
+
+	///
+	std::size_t count() const  {  return count_;  }
+	bool isEmpty() const  {  return 0 == count_;  }
+
+	double mean() const  {  return mean_;  }
+	double variance() const;
+	double sampleVariance() const;
+	double standardDeviation() const;
+	double sampleStandardDeviation() const;
+	double skewness() const;
+	double kurtosis() const;
+
+	double minimum() const  {  return minimum_;  }
+	double maximum() const  {  return maximum_;  }
+	double peak() const;
+	// the root mean square of (x - mean).
+	double rms(const double mean) const;
+	double crestFactor(const double mean) const;
+
+private:
+	std::size_t count_;
+	double mean_;
+	// the sums of the 2nd, 3rd & 4th powers of the deviations from the mean.
+	double M2_, M3_, M4_;
+	double minimum_, maximum_;
+};
+
+//-----------------------------------------------------------------------------------------
+// CovarianceAccumulator.
+
+// one-pass mean & covariance of multivariate data.
+//	- a column of data is added by a rank-1 update, and a matrix by blocks of columns
+//		which are centered at the block mean & merged, so no centered copy of the whole matrix is made.
+//	- only the lower triangle of the scatter matrix is updated.
+class SWL_MATH_API CovarianceAccumulator
+{
+public:
+	//typedef CovarianceAccumulator base_type;
+
+public:
+	explicit CovarianceAccumulator(const std::size_t dim);
+
+public:
+	///
+	void add(const Eigen::VectorXd &x);
+	// row : The dimension of data.
+	// col : The number of data.
+	void add(const Eigen::MatrixXd &D);
+	void merge(const CovarianceAccumulator &rhs);
+	void clear();
+
+	/// the columns of D are split into chunks which are accumulated in parallel (with OpenMP) & merged in order.
+	static CovarianceAccumulator accumulate(const Eigen::MatrixXd &D);
+
+	///
+	std::size_t dimension() const  {  return (std::size_t)mean_.size();  }
+	std::size_t count() const  {  return count_;  }
+
+	const Eigen::VectorXd & mean() const  {  return mean_;  }
+	Eigen::VectorXd sampleVariance() const;
+	Eigen::MatrixXd covarianceMatrix() const;
+	Eigen::MatrixXd sampleCovarianceMatrix() const;
+
+	const Eigen::VectorXd & minimum() const  {  return minimum_;  }
+	const Eigen::VectorXd & maximum() const  {  return maximum_;  }
+
+private:
+	void addColumns(const Eigen::Ref<const Eigen::MatrixXd> &D);
+	void merge(const std::size_t count, const Eigen::VectorXd &mean, const Eigen::MatrixXd &scatter);
+	Eigen::MatrixXd getSymmetricScatter() const;
+
+private:
+	std::size_t count_;
+	Eigen::VectorXd mean_;
+	// the sum of the outer products of the deviations from the mean. only the lower triangle is valid.
+	Eigen::MatrixXd scatter_;
+	Eigen::VectorXd minimum_, maximum_;
+};
+
+//-----------------------------------------------------------------------------------------
+// SlidingStatisticAccumulator.
+
+// statistics of the last N values.
+//	- the sums of the powers of (x - shift) are updated by adding the new value & subtracting the evicted one,
+//		where the shift is the mean when the sums were last recomputed. they're recomputed once every N values.
+//	- the minimum & the maximum are kept in monotonic queues.
+class SWL_MATH_API SlidingStatisticAccumulator
+{
+public:
+	//typedef SlidingStatisticAccumulator base_type;
+
+public:
+	explicit SlidingStatisticAccumulator(const std::size_t windowSize);
+
+public:
+	///
+	void add(const double x);
+	void clear();
+
+	std::size_t getWindowSize() const  {  return windowSize_;  }
+	std::size_t count() const  {  return count_;  }
+	bool isFull() const  {  return count_ == windowSize_;  }
+
+	/// the statistics of the values in the window.
+	StatisticAccumulator getStatistic() const;
+
+	double mean() const  {  return count_ ? shift_ + sums_[0] / double(count_) : 0.0;  }
+
+private:
+	void recomputeSums();
+
+private:
+	const std::size_t windowSize_;
+
+	std::vector<double> ring_;
+	std::size_t head_;  // the slot for the next value.
+	std::size_t count_;
+	std::size_t updateCount_;  // since the sums were last recomputed.
+	std::size_t sequence_;  // the number of values added so far.
+
+	double shift_;
+	// the sums of (x - shift)^k, k = 1, 2, 3, 4.
+	double sums_[4];
+
+	// (sequence number, value) of the candidates for the minimum & the maximum.
+	std::deque<std::pair<std::size_t, double> > minQueue_, maxQueue_;
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_MATH__STATISTIC_ACCUMULATOR__H_
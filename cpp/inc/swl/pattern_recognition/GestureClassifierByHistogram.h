@@ -5,6 +5,7 @@
 #include "swl/pattern_recognition/ExportPatternRecognition.h"
 #include "swl/pattern_recognition/IGestureClassifier.h"
 #include "swl/rnd_util/HistogramAccumulator.h"
+#include "swl/rnd_util/HistogramMatcher.h"
 #include <boost/circular_buffer.hpp>
 #include <boost/smart_ptr.hpp>
 #include <vector>
@@ -110,6 +111,8 @@ private:
 	Params params_;
 
 	std::vector<histogram_type> refFullPhaseHistograms_;
+	// packed once from refFullPhaseHistograms_.
+	boost::shared_ptr<PackedHistogramMatcher> refFullPhaseHistogramMatcher_;
 
 	std::vector<histogram_type> refHistogramsForClass1Gesture_;
 	std::vector<histogram_type> refHistogramsForClass2Gesture_;
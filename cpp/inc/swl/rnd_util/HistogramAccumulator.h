@@ -5,45 +5,91 @@
 #include "swl/rnd_util/ExportRndUtil.h"
 #define CV_NO_BACKWARD_COMPATIBILITY
 #include <opencv2/core/core.hpp>
-#include <boost/circular_buffer.hpp>
 #include <vector>
 
 
 namespace swl {
 
+class PackedHistogramMatcher;
+
 //-----------------------------------------------------------------------------
 //
 
+// accumulator of the last N histograms.
+//	- the histograms are copied into the rows of a preallocated ring matrix, so adding one doesn't allocate memory.
+//	- with uniform or exponential weights, a running sum is updated by subtracting the evicted histogram & adding the new one.
+//		it's recomputed from the ring once every N histograms to keep the round-off errors from building up.
+//	- with any other weights (a fixed kernel), the weighted sum is computed from the ring when requested.
 class SWL_RND_UTIL_API HistogramAccumulator
 {
 public:
-	//typedef HistogramAccumulator base_type;
-    typedef cv::MatND histogram_type;
+	//typedef HistogramAccumulator base_type;
+    typedef cv::MatND histogram_type;
+
+	enum WeightingMode { UNIFORM_WEIGHTING = 0, EXPONENTIAL_WEIGHTING, KERNEL_WEIGHTING };
 
 public:
+	// the sum of the last histogramNum histograms.
 	HistogramAccumulator(const size_t histogramNum);
+	// the weighted sum with weights[0] for the newest histogram, weights[1] for the one before it, ...
+	// geometric weights, e.g. exp(-2 * i / N), are detected & accumulated like exponential weights.
 	HistogramAccumulator(const std::vector<float> &weights);
+	// the weighted sum with the weights scale * decay^i, i = 0 for the newest histogram.
+	HistogramAccumulator(const size_t histogramNum, const double decay, const double scale = 1.0);
 
 private:
 	HistogramAccumulator(const HistogramAccumulator &rhs);
 	HistogramAccumulator & operator=(const HistogramAccumulator &rhs);
 
 public:
-	void addHistogram(const cv::MatND &hist)  {  histograms_.push_back(hist);  }
-	void clearAllHistograms()  {  histograms_.clear();  }
+	void addHistogram(const cv::MatND &hist);
+	void clearAllHistograms();
 
-	size_t getHistogramSize() const  {  return histograms_.size();  }
-	bool isFull() const  {  return histograms_.full();  }
+	size_t getHistogramSize() const  {  return count_;  }
+	size_t getHistogramCapacity() const  {  return histogramNum_;  }
+	bool isFull() const  {  return count_ == histogramNum_;  }
 
+	WeightingMode getWeightingMode() const  {  return mode_;  }
+
+	// a new matrix of the same shape & type as the added histograms.
 	cv::MatND createAccumulatedHistogram() const;
+	// a (bins x histograms) matrix with the oldest histogram in the first column.
+	// the matrix is kept in the accumulator & overwritten by the next call.
 	cv::MatND createTemporalHistogram() const;
-	cv::MatND createTemporalHistogram(const std::vector<histogram_type> &refHistograms, const double histDistThreshold) const;
+	// the same matrix with each histogram replaced by its closest reference, or by zeros if the reference isn't close enough.
+	//	- refMatcher has to be packed from refHistograms. it's built once by the caller, not on every call.
+	//	- a reference is close enough if its distance is below histDistThreshold, or if its similarity is above it.
+	cv::MatND createTemporalHistogram(const std::vector<histogram_type> &refHistograms, const PackedHistogramMatcher &refMatcher, const double histDistThreshold) const;
 
 private:
-	const size_t histogramNum_;
-	const std::vector<float> weights_;
+	void reallocate(const cv::MatND &hist);
+	void recomputeSum();
 
-	boost::circular_buffer<histogram_type> histograms_;
+	// the ring slot of the histogram added age histograms ago.
+	size_t getSlot(const size_t age) const  {  return (head_ + histogramNum_ - 1 - age) % histogramNum_;  }
+
+private:
+	const size_t histogramNum_;
+	WeightingMode mode_;
+
+	// for KERNEL_WEIGHTING.
+	std::vector<float> weights_;
+	// for UNIFORM_WEIGHTING & EXPONENTIAL_WEIGHTING. decay_ is 1 for UNIFORM_WEIGHTING.
+	double decay_, scale_;
+	// decay_^(histogramNum_ - 1), the weight of the histogram to be evicted.
+	double evictedWeight_;
+
+	// the histogram in slot i is stored in row i.
+	cv::Mat ring_;
+	std::vector<int> histSizes_;
+	int histType_;
+	size_t head_;  // the slot for the next histogram.
+	size_t count_;
+	size_t updateCount_;  // since the running sum was last recomputed.
+
+	// the running sum in double precision.
+	cv::Mat sum_;
+	mutable cv::Mat temporalHistogram_;
 };
 
 }  // namespace swl
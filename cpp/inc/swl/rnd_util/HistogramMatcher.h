@@ -20,11 +20,70 @@ namespace swl {
 
 struct SWL_RND_UTIL_API HistogramMatcher
 {
-    typedef cv::MatND histogram_type;
-
+    typedef cv::MatND histogram_type;
+
 	static std::size_t match(const std::vector<histogram_type> &refHistograms, const cv::MatND &hist, double &minDist);
 };
 
+//-----------------------------------------------------------------------------
+//
+
+// matcher against a fixed set of reference histograms.
+//	- the references are packed once into one contiguous (references x bins) matrix, together with the per-reference
+//		square roots, sums & norms the metric needs.
+//	- a query or a batch of queries (one per row) is scored against all the references at once. except for the intersection,
+//		every metric reduces to a matrix product, so the work is done by cv::gemm.
+//	- the scores are the same as cv::compareHist(query, reference, metric).
+class SWL_RND_UTIL_API PackedHistogramMatcher
+{
+public:
+	typedef HistogramMatcher::histogram_type histogram_type;
+
+	// correlation & intersection are similarities (larger is closer), chi-square & Bhattacharyya are distances (smaller is closer).
+	enum Metric { CORRELATION = 0, CHI_SQUARE, INTERSECTION, BHATTACHARYYA };
+
+public:
+	explicit PackedHistogramMatcher(const Metric metric = BHATTACHARYYA);
+	PackedHistogramMatcher(const std::vector<histogram_type> &refHistograms, const Metric metric = BHATTACHARYYA);
+
+public:
+	// all the references must have the same number of bins.
+	void setReferenceHistograms(const std::vector<histogram_type> &refHistograms);
+
+	std::size_t getReferenceCount() const  {  return refCount_;  }
+	std::size_t getBinCount() const  {  return binCount_;  }
+	Metric getMetric() const  {  return metric_;  }
+	bool empty() const  {  return 0 == refCount_;  }
+
+	static bool isSimilarity(const Metric metric)  {  return CORRELATION == metric || INTERSECTION == metric;  }
+
+	// the score of the query against each reference.
+	void computeScores(const cv::MatND &hist, std::vector<double> &scores) const;
+	// a (queries x references) matrix of type CV_64F. queries has one histogram per row.
+	void computeScores(const cv::Mat &queries, cv::Mat &scores) const;
+
+	// the index of the closest reference, or (std::size_t)-1 if there is no reference.
+	std::size_t match(const cv::MatND &hist, double &bestScore) const;
+	// the closest reference for each row of queries.
+	void match(const cv::Mat &queries, std::vector<std::size_t> &matchedIndexes, std::vector<double> &bestScores) const;
+	// the k closest references, the closest one first.
+	void match(const cv::MatND &hist, const std::size_t k, std::vector<std::size_t> &matchedIndexes, std::vector<double> &scores) const;
+
+private:
+	const Metric metric_;
+
+	std::size_t refCount_;
+	std::size_t binCount_;
+
+	// the references in row-major order.
+	std::vector<double> refs_;
+	// the square roots of the references for BHATTACHARYYA, their squares for CHI_SQUARE.
+	std::vector<double> refTerms_;
+	// the sums of the bins, and the sums of the squared deviations for CORRELATION.
+	std::vector<double> refSums_;
+	std::vector<double> refNorms_;
+};
+
 }  // namespace swl
 
 
@@ -4,6 +4,7 @@
 
 #include "swl/rnd_util/ExportRndUtil.h"
 #include <vector>
+#include <complex>
 
 
 namespace swl {
@@ -17,6 +18,122 @@ public:
 	static void filter(const std::vector<double> &a, const std::vector<double> &b, const std::vector<double> &x, std::vector<double> &y);
 };
 
+//--------------------------------------------------------------------------
+// Streaming linear filters.
+//	- All the filters keep their state between calls to process(), so a signal can be filtered block by block.
+//	- Multi-channel samples are interleaved: x[n * numChannels + ch].
+//		The state is laid out the same way, so the inner loops run over the channels & are vectorized by the compilers.
+//	- process() doesn't allocate memory & y may be equal to x.
+
+// Direct form II transposed IIR/FIR filter.
+//	a[0] * y[n] = b[0] * x[n] + b[1] * x[n - 1] + ... + b[nb - 1] * x[n - nb + 1] - a[1] * y[n - 1] - ... - a[na - 1] * y[n - na + 1].
+class SWL_RND_UTIL_API LinearFilter
+{
+public:
+	//typedef LinearFilter base_type;
+
+public:
+	LinearFilter(const std::vector<double> &a, const std::vector<double> &b, const size_t numChannels = 1);
+
+public:
+	void process(const double *x, double *y, const size_t numFrames);
+	// Clear the state.
+	void reset();
+
+	size_t getNumberOfChannels() const  {  return numChannels_;  }
+	size_t getOrder() const  {  return order_;  }
+
+private:
+	const size_t numChannels_;
+	size_t order_;
+
+	// Normalized by a[0] & padded with zeros to order_ + 1 coefficients.
+	std::vector<double> a_, b_;
+	// z_[k * numChannels_ + ch], k = 0, ..., order_ - 1.
+	std::vector<double> z_;
+	// The current input frame, kept for in-place processing.
+	std::vector<double> x_;
+};
+
+// Cascade of second-order sections (biquads) in direct form II transposed.
+//	High-order IIR filters are numerically stable as a cascade of second-order sections, unlike as a single polynomial.
+class SWL_RND_UTIL_API BiquadCascade
+{
+public:
+	//typedef BiquadCascade base_type;
+
+	// H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2).
+	struct Section
+	{
+		double b0, b1, b2, a1, a2;
+	};
+
+public:
+	BiquadCascade(const std::vector<Section> &sections, const size_t numChannels = 1, const double gain = 1.0);
+	// sos: the rows of [b0 b1 b2 a0 a1 a2] as in Matlab, numSections x 6 in row-major order.
+	BiquadCascade(const std::vector<double> &sos, const size_t numChannels = 1, const double gain = 1.0);
+
+public:
+	void process(const double *x, double *y, const size_t numFrames);
+	// Clear the state.
+	void reset();
+
+	size_t getNumberOfChannels() const  {  return numChannels_;  }
+	size_t getNumberOfSections() const  {  return sections_.size();  }
+
+private:
+	const size_t numChannels_;
+	const double gain_;
+
+	std::vector<Section> sections_;
+	// z_[(2 * s + k) * numChannels_ + ch], k = 0, 1.
+	std::vector<double> z_;
+};
+
+// FIR filter by FFT-based overlap-save.
+//	Cheaper than LinearFilter for long impulse responses: O(log N) instead of O(nb) operations per sample.
+//	The output is the same as LinearFilter's, up to round-off errors, & there is no latency.
+//	Each FFT computes up to getBlockSize() frames, so numFrames had better be a multiple of getBlockSize().
+//	Two channels are filtered by one complex FFT, as the real & the imaginary parts.
+class SWL_RND_UTIL_API OverlapSaveFilter
+{
+public:
+	//typedef OverlapSaveFilter base_type;
+
+public:
+	// fftSize: a power of 2 larger than b.size(). if 0, it's chosen from b.size().
+	OverlapSaveFilter(const std::vector<double> &b, const size_t numChannels = 1, const size_t fftSize = 0);
+
+public:
+	void process(const double *x, double *y, const size_t numFrames);
+	// Clear the state.
+	void reset();
+
+	size_t getNumberOfChannels() const  {  return numChannels_;  }
+	size_t getFftSize() const  {  return fftSize_;  }
+	// The number of the frames computed by an FFT.
+	size_t getBlockSize() const  {  return fftSize_ - historySize_;  }
+
+private:
+	void processBlock(const double *x, double *y, const size_t numFrames);
+	void transform(std::complex<double> *data, const bool isInverse) const;
+
+private:
+	const size_t numChannels_;
+	size_t fftSize_;
+	// nb - 1.
+	size_t historySize_;
+
+	// The frequency response of the filter, scaled by 1 / fftSize_.
+	std::vector<std::complex<double> > H_;
+	std::vector<std::complex<double> > twiddles_;
+	std::vector<size_t> bitReversed_;
+
+	// The last historySize_ input samples of each channel: history_[ch * historySize_ + i].
+	std::vector<double> history_;
+	std::vector<std::complex<double> > buffer_;
+};
+
 }  // namespace swl
 
 
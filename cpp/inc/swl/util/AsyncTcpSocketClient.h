@@ -5,12 +5,14 @@
 #include "swl/util/ExportUtil.h"
 #include "swl/util/GuardedBuffer.h"
 #include <boost/asio.hpp>
-#include <boost/array.hpp>
 #include <string>
 
 
 namespace swl {
 
+class FrameParser;
+struct IFrameHandler;
+
 //-----------------------------------------------------------------------------------
 //
 
@@ -98,6 +100,16 @@ public:
 	 *	asynchronous I/O  message Ѵ.
 	 */
 	std::size_t receive(unsigned char *msg, const std::size_t len);
+	/**
+	 *	@brief  ŵ messageκ  frame Ͽ handler .
+	 *	@param[in,out]  parser  frame parser. ϳ  buffer ϳ parser ؾ .
+	 *	@param[in]  handler   frame ó handler.
+	 *	@return  ó frame .
+	 *
+	 *	frame  bufferκ   handler ޵   buffer ŵȴ.
+	 *	ϼ  frame  buffer    ȣ⿡  ŵ data ̾ óȴ.
+	 */
+	std::size_t receiveFrames(FrameParser &parser, IFrameHandler &handler);
 
 	/**
 	 *	@brief    I/O ۾ .
@@ -152,6 +164,21 @@ public:
 	 */
 	std::size_t getReceiveBufferSize() const;
 
+	/**
+	 *	@brief  set the maximum length of a message sent by one write operation.
+	 *
+	 *	the message is written directly from the segments of the send buffer.
+	 */
+	void setMaxSendLength(const std::size_t len)  {  maxSendLength_ = len;  }
+	std::size_t getMaxSendLength() const  {  return maxSendLength_;  }
+	/**
+	 *	@brief  set the maximum length of a message received by one read operation.
+	 *
+	 *	the message is read directly into the segments of the receive buffer.
+	 */
+	void setMaxReceiveLength(const std::size_t len)  {  maxReceiveLength_ = len;  }
+	std::size_t getMaxReceiveLength() const  {  return maxReceiveLength_;  }
+
 protected:
 	/**
 	 *	@brief  asynchronous mode  host ̸ service ̸ ̿ TCP socket server channel .
@@ -208,21 +235,13 @@ private:
 
 protected:
 	/**
-	 *	@brief    ۽    ִ message ִ .
+	 *	@brief    ۽    ִ message ⺻ ִ .
 	 */
-#if defined(__GNUC__)
-	static const unsigned long MAX_SEND_LENGTH_ = 512;
-#else
-	static const std::size_t MAX_SEND_LENGTH_ = 512;
-#endif
+	static const std::size_t DEFAULT_MAX_SEND_LENGTH_ = 65536;
 	/**
-	 *	@brief        ִ message ִ .
+	 *	@brief        ִ message ⺻ ִ .
 	 */
-#if defined(__GNUC__)
-	static const unsigned long MAX_RECEIVE_LENGTH_ = 512;
-#else
-	static const std::size_t MAX_RECEIVE_LENGTH_ = 512;
-#endif
+	static const std::size_t DEFAULT_MAX_RECEIVE_LENGTH_ = 65536;
 
 	/**
 	 *	@brief  TCP socket   ϴ Boost.ASIO socket ü.
@@ -249,17 +268,17 @@ protected:
 	 */
 	GuardedByteBuffer receiveBuffer_;
 	/**
-	 *	@brief    ۽  ϰ  message ϴ buffer.
+	 *	@brief    ۽    ִ message ִ .
 	 *
-	 *	buffer ̴ MAX_SEND_LENGTH_̴.
+	 *	message send buffer segmentκ  ۵ȴ.
 	 */
-	boost::array<GuardedByteBuffer::value_type, MAX_SEND_LENGTH_> sendMsg_;
+	std::size_t maxSendLength_;
 	/**
-	 *	@brief      ϰ  message ϴ buffer.
+	 *	@brief        ִ message ִ .
 	 *
-	 *	buffer ̴ MAX_RECEIVE_LENGTH_̴.
+	 *	message receive buffer    ŵȴ.
 	 */
-	boost::array<GuardedByteBuffer::value_type, MAX_RECEIVE_LENGTH_> receiveMsg_;
+	std::size_t maxReceiveLength_;
 	/**
 	 *	@brief   ֱ ۽   message .
 	 */
@@ -0,0 +1,145 @@
+#if !defined(__SWL_UTIL__BYTE_ORDER__H_)
+#define __SWL_UTIL__BYTE_ORDER__H_ 1
+
+
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <cstring>
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif
+
+
+namespace swl {
+
+//-----------------------------------------------------------------------------------
+//	byte swapping
+
+inline boost::uint16_t swapByteOrder16(const boost::uint16_t value)
+{
+#if defined(_MSC_VER)
+	return _byteswap_ushort(value);
+#elif defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8))
+	return __builtin_bswap16(value);
+#else
+	return (boost::uint16_t)((value << 8) | (value >> 8));
+#endif
+}
+
+inline boost::uint32_t swapByteOrder32(const boost::uint32_t value)
+{
+#if defined(_MSC_VER)
+	return _byteswap_ulong(value);
+#elif defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 3))
+	return __builtin_bswap32(value);
+#else
+	return (value << 24) | ((value << 8) & 0x00FF0000) | ((value >> 8) & 0x0000FF00) | (value >> 24);
+#endif
+}
+
+inline boost::uint64_t swapByteOrder64(const boost::uint64_t value)
+{
+#if defined(_MSC_VER)
+	return _byteswap_uint64(value);
+#elif defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 3))
+	return __builtin_bswap64(value);
+#else
+	return ((boost::uint64_t)swapByteOrder32((boost::uint32_t)value) << 32) | swapByteOrder32((boost::uint32_t)(value >> 32));
+#endif
+}
+
+/**
+ *	@brief  copy Size bytes in the reverse order.
+ *
+ *	the 2, 4 & 8-byte copies are compiled to a load, a byte swap & a store.
+ *	the other sizes (e.g. long double) fall back to a byte-wise copy.
+ */
+template<std::size_t Size>
+struct ReversedByteCopier
+{
+	static void copy(unsigned char *dst, const unsigned char *src)
+	{  std::reverse_copy(src, src + Size, dst);  }
+};
+
+template<>
+struct ReversedByteCopier<1>
+{
+	static void copy(unsigned char *dst, const unsigned char *src)
+	{  *dst = *src;  }
+};
+
+template<>
+struct ReversedByteCopier<2>
+{
+	static void copy(unsigned char *dst, const unsigned char *src)
+	{
+		boost::uint16_t value;
+		std::memcpy(&value, src, sizeof(value));
+		value = swapByteOrder16(value);
+		std::memcpy(dst, &value, sizeof(value));
+	}
+};
+
+template<>
+struct ReversedByteCopier<4>
+{
+	static void copy(unsigned char *dst, const unsigned char *src)
+	{
+		boost::uint32_t value;
+		std::memcpy(&value, src, sizeof(value));
+		value = swapByteOrder32(value);
+		std::memcpy(dst, &value, sizeof(value));
+	}
+};
+
+template<>
+struct ReversedByteCopier<8>
+{
+	static void copy(unsigned char *dst, const unsigned char *src)
+	{
+		boost::uint64_t value;
+		std::memcpy(&value, src, sizeof(value));
+		value = swapByteOrder64(value);
+		std::memcpy(dst, &value, sizeof(value));
+	}
+};
+
+//-----------------------------------------------------------------------------------
+//	unaligned loads & stores
+
+/**
+ *	@brief  store a value at an arbitrary (unaligned) address.
+ *	@param[out]  dst  the destination of sizeof(T) bytes.
+ *	@param[in]  value  the value to store.
+ *	@param[in]  isReversed  store the bytes in the reverse of the host byte order if it's true.
+ */
+template<typename T>
+inline void storeBytes(unsigned char *dst, const T &value, const bool isReversed)
+{
+	if (isReversed)
+		ReversedByteCopier<sizeof(T)>::copy(dst, reinterpret_cast<const unsigned char *>(&value));
+	else
+		std::memcpy(dst, &value, sizeof(T));
+}
+
+/**
+ *	@brief  load a value from an arbitrary (unaligned) address.
+ *	@param[in]  src  the source of sizeof(T) bytes.
+ *	@param[in]  isReversed  the bytes are stored in the reverse of the host byte order if it's true.
+ *	@return  the loaded value.
+ */
+template<typename T>
+inline T loadBytes(const unsigned char *src, const bool isReversed)
+{
+	T value;
+	if (isReversed)
+		ReversedByteCopier<sizeof(T)>::copy(reinterpret_cast<unsigned char *>(&value), src);
+	else
+		std::memcpy(&value, src, sizeof(T));
+	return value;
+}
+
+}  // namespace swl
+
+
+#endif  // __SWL_UTIL__BYTE_ORDER__H_
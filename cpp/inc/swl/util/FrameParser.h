@@ -0,0 +1,232 @@
+#if !defined(__SWL_UTIL__FRAME_PARSER__H_)
+#define __SWL_UTIL__FRAME_PARSER__H_ 1
+
+
+#include "swl/util/ExportUtil.h"
+#include "swl/util/IPacketDispatcher.h"
+#include <cstddef>
+
+
+namespace swl {
+
+//-----------------------------------------------------------------------------------
+//	frame format
+
+/**
+ *	@brief  the descriptor of a framed protocol: sync bytes, a header with a length field & a trailing checksum.
+ *
+ *	frame := [sync bytes][rest of header][body][checksum]
+ *		- the sync bytes start the header & are searched for to resynchronize after garbage or a broken frame.
+ *		- the frame length is (length field value + lengthAdjustment), or fixedFrameLength if lengthSize is 0.
+ *		- the checksum is computed over [checksumOffset, frame length - checksum size) & stored at the end of the frame.
+ *		- multi-byte length & checksum fields are little-endian on the wire if isLittleEndian is true, big-endian otherwise.
+ */
+struct SWL_UTIL_API FrameFormat
+{
+public:
+	enum ChecksumType { NO_CHECKSUM = 0, SUM8_CHECKSUM, XOR8_CHECKSUM, CRC16_CCITT_CHECKSUM };
+
+	static const std::size_t MAX_SYNC_LENGTH = 4;
+
+public:
+	FrameFormat();
+
+public:
+	void setSyncBytes(const unsigned char *sync, const std::size_t len);
+	std::size_t getChecksumSize() const;
+	/**
+	 *	@brief  check if the descriptor is consistent.
+	 */
+	bool isValid() const;
+
+public:
+	unsigned char syncBytes[MAX_SYNC_LENGTH];
+	std::size_t syncLength;
+
+	/// the length of the header including the sync bytes & the length field.
+	std::size_t headerLength;
+	std::size_t lengthOffset;
+	/// the size of the length field: 0, 1, 2 or 4.
+	std::size_t lengthSize;
+	long lengthAdjustment;
+	std::size_t fixedFrameLength;
+	std::size_t maxFrameLength;
+
+	ChecksumType checksumType;
+	std::size_t checksumOffset;
+
+	bool isLittleEndian;
+};
+
+//-----------------------------------------------------------------------------------
+//	frame view
+
+/**
+ *	@brief  a complete frame still lying in the receive buffer.
+ *
+ *	the frame may wrap around the end of a ring buffer, so it consists of at most two segments.
+ *	it's valid only during IFrameHandler::handleFrame().
+ */
+struct SWL_UTIL_API FrameView
+{
+public:
+	FrameView(const unsigned char * const segments[2], const std::size_t lengths[2], const std::size_t frameLength);
+
+public:
+	std::size_t getSize() const  {  return size_;  }
+	const unsigned char * getSegment(const std::size_t i) const  {  return segments_[i];  }
+	std::size_t getSegmentLength(const std::size_t i) const  {  return lengths_[i];  }
+
+	unsigned char operator[](const std::size_t i) const
+	{  return i < lengths_[0] ? segments_[0][i] : segments_[1][i - lengths_[0]];  }
+
+	/**
+	 *	@brief  copy len bytes from offset into dst.
+	 *	@return  the number of the copied bytes.
+	 */
+	std::size_t copy(unsigned char *dst, const std::size_t offset, const std::size_t len) const;
+
+private:
+	const unsigned char *segments_[2];
+	std::size_t lengths_[2];
+	std::size_t size_;
+};
+
+//-----------------------------------------------------------------------------------
+//	frame handler interface
+
+struct IFrameHandler
+{
+public:
+	//typedef IFrameHandler base_type;
+
+public:
+	virtual ~IFrameHandler()  {}
+
+public:
+	/**
+	 *	@brief  handle a complete & verified frame. the frame is removed from the buffer after this returns.
+	 */
+	virtual void handleFrame(const FrameView &frame) = 0;
+};
+
+//-----------------------------------------------------------------------------------
+//	resumable frame parser
+
+/**
+ *	@brief  an incremental parser extracting the frames of a FrameFormat from a receive buffer.
+ *
+ *	the parser keeps its state between calls to parse(), so the bytes already examined (sync bytes, length & checksum)
+ *	are not examined again when the rest of a frame arrives.
+ *	at most maxFrameLength bytes are looked at to complete a frame, so the cost doesn't grow with the backlog.
+ *
+ *	parse() works with any buffer having getReadableSegments() & pop(len), i.e. GuardedBuffer, SpscRingBuffer & MpmcRingBuffer,
+ *	& must be called by one consumer at a time.
+ */
+class SWL_UTIL_API FrameParser
+{
+public:
+	//typedef FrameParser base_type;
+
+private:
+	enum Result { NEED_MORE_DATA = 0, FRAME_COMPLETED, CONTINUE_PARSING };
+
+public:
+	explicit FrameParser(const FrameFormat &format);
+
+public:
+	/**
+	 *	@brief  extract all the complete frames in the buffer & hand them to the handler.
+	 *	@return  the number of the handled frames.
+	 */
+	template<class Buffer>
+	std::size_t parse(Buffer &buffer, IFrameHandler &handler)
+	{
+		std::size_t frameCount = 0;
+		const typename Buffer::value_type *segments[2];
+		std::size_t lengths[2];
+		for (;;)
+		{
+			if (0 == buffer.getReadableSegments(segments, lengths, format_.maxFrameLength)) break;
+
+			std::size_t consumed = 0;
+			const Result result = advance(segments, lengths, consumed);
+			if (FRAME_COMPLETED == result)
+			{
+				handler.handleFrame(FrameView(segments, lengths, consumed));
+				++frameCount;
+			}
+			if (consumed) buffer.pop(consumed);
+			if (NEED_MORE_DATA == result) break;
+		}
+		return frameCount;
+	}
+
+	/**
+	 *	@brief  discard the partially parsed frame. call it when the buffer is cleared.
+	 */
+	void reset();
+
+	const FrameFormat & getFormat() const  {  return format_;  }
+
+	/// the number of bytes discarded while searching for the sync bytes.
+	unsigned long long getDiscardedByteCount() const  {  return discardedByteCount_;  }
+	/// the number of candidate frames rejected by the length or the checksum.
+	unsigned long long getErrorCount() const  {  return errorCount_;  }
+
+private:
+	Result advance(const unsigned char * const segments[2], const std::size_t lengths[2], std::size_t &consumed);
+	Result searchSync(const unsigned char * const segments[2], const std::size_t lengths[2], std::size_t &consumed);
+	Result resynchronize(const bool isError, std::size_t &consumed);
+
+	void updateChecksum(const unsigned char * const segments[2], const std::size_t lengths[2], const std::size_t begin, const std::size_t end);
+	unsigned long readField(const unsigned char * const segments[2], const std::size_t lengths[2], const std::size_t offset, const std::size_t size) const;
+
+private:
+	const FrameFormat format_;
+
+	// the state of the current frame.
+	bool isSynchronized_;
+	// the bytes in [0, parsedLength_) have been examined.
+	std::size_t parsedLength_;
+	// 0 if not yet known.
+	std::size_t frameLength_;
+	unsigned int checksum_;
+
+	unsigned long long discardedByteCount_;
+	unsigned long long errorCount_;
+};
+
+//-----------------------------------------------------------------------------------
+//	framed packet dispatcher
+
+/**
+ *	@brief  a packet dispatcher handing the frames received in a GuardedByteBuffer to a frame handler.
+ */
+class SWL_UTIL_API FramedPacketDispatcher: public IPacketDispatcher
+{
+public:
+	typedef IPacketDispatcher base_type;
+
+public:
+	FramedPacketDispatcher(const FrameFormat &format, IFrameHandler &handler);
+
+public:
+	/**
+	 *	@return  true if one or more frames have been dispatched.
+	 */
+	/*virtual*/ bool dispatch(GuardedByteBuffer &byteBuffer) const;
+
+	FrameParser & getParser()  {  return parser_;  }
+	const FrameParser & getParser() const  {  return parser_;  }
+
+private:
+	// the parser state changes while dispatching.
+	mutable FrameParser parser_;
+	IFrameHandler &handler_;
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_UTIL__FRAME_PARSER__H_
@@ -2,10 +2,16 @@
 #define __SWL_UTIL__GUARDED_BUFFER__H_ 1
 
 
+#include "swl/Config.h"
 #include "swl/DisableCompilerWarning.h"
+#if defined(__SWL_CONFIG__USE_SPSC_BYTE_BUFFER) || defined(__SWL_CONFIG__USE_MPMC_BYTE_BUFFER)
+#include "swl/util/LockFreeRingBuffer.h"
+#endif
 #include <boost/thread/mutex.hpp>
 #include <boost/config.hpp>
 #include <deque>
+#include <vector>
+#include <algorithm>
 
 
 namespace swl {
@@ -41,7 +47,7 @@ public:
 	 *	 data buffer ʱȭѴ.
 	 */
 	GuardedBuffer()
-	: buf_()
+	: buf_(), readStage_(), writeStage_()
 	{}
 	/**
 	 *	@brief  [dtor] default destructor.
@@ -64,11 +70,11 @@ public:
 	 */
 	bool push(const value_type &data)
 	{
-		if (buf_.size() > buf_.max_size())
+		boost::mutex::scoped_lock lock(mutex_);
+		if (buf_.size() >= buf_.max_size())
 			return false;
 		else
 		{
-			boost::mutex::scoped_lock lock(mutex_);
 			buf_.push_back(data);
 			return true;
 		}
@@ -83,13 +89,12 @@ public:
 	 */
 	bool push(const value_type *data, const size_t len)
 	{
-		if (buf_.size() + len >= buf_.max_size())
+		boost::mutex::scoped_lock lock(mutex_);
+		if (len > buf_.max_size() - buf_.size())
 			return false;
 		else
 		{
-			boost::mutex::scoped_lock lock(mutex_);
-			//buf_.insert(buf_.end(), data, data + len);
-			std::copy(data, data + len, std::back_inserter(buf_));
+			buf_.insert(buf_.end(), data, data + len);
 			return true;
 		}
 	}
@@ -97,13 +102,12 @@ public:
 	bool push(InputIterator first, InputIterator last)
 	{
 		const size_t len = std::distance(first, last);
-		if (buf_.size() + len >= buf_.max_size())
+		boost::mutex::scoped_lock lock(mutex_);
+		if (len > buf_.max_size() - buf_.size())
 			return false;
 		else
 		{
-			boost::mutex::scoped_lock lock(mutex_);
-			//buf_.insert(buf_.end(), first, last);
-			std::copy(first, last, std::back_inserter(buf_));
+			buf_.insert(buf_.end(), first, last);
 			return true;
 		}
 	}
@@ -115,10 +119,10 @@ public:
 	 */
 	bool pop()
 	{
+		boost::mutex::scoped_lock lock(mutex_);
 		if (buf_.empty()) return false;
 		else
 		{
-			boost::mutex::scoped_lock lock(mutex_);
 			buf_.pop_front();
 			return true;
 		}
@@ -132,10 +136,10 @@ public:
 	 */
 	bool pop(const size_t len)
 	{
+		boost::mutex::scoped_lock lock(mutex_);
 		if (buf_.size() < len) return false;
 		else
 		{
-			boost::mutex::scoped_lock lock(mutex_);
 			typename buffer_type::iterator itBegin = buf_.begin();
 			typename buffer_type::iterator it = itBegin;
 			std::advance(it, len);
@@ -154,10 +158,10 @@ public:
 	 */
 	bool top(value_type &data) const
 	{
+		boost::mutex::scoped_lock lock(mutex_);
 		if (buf_.empty()) return false;
 		else
 		{
-			boost::mutex::scoped_lock lock(mutex_);
 			data = buf_.front();
 			return true;
 		}
@@ -174,10 +178,10 @@ public:
 	 */
 	bool top(value_type *data, const size_t len) const
 	{
+		boost::mutex::scoped_lock lock(mutex_);
 		if (buf_.size() < len) return false;
 		else
 		{
-			boost::mutex::scoped_lock lock(mutex_);
 			typename buffer_type::const_iterator itBegin = buf_.begin();
 			typename buffer_type::const_iterator it = itBegin;
 			std::advance(it, len);
@@ -186,6 +190,45 @@ public:
 		}
 	}
 
+	/**
+	 *	@brief  [consumer] get at most maxLen oldest values as contiguous segments without removing them.
+	 *	@return  the total length of the segments.
+	 *
+	 *	std::deque has no contiguous storage, so the values are copied into a staging area in one segment.
+	 *	the segments stay valid until the next call. only one consumer may use them at a time.
+	 */
+	size_t getReadableSegments(const value_type *segments[2], size_t lengths[2], const size_t maxLen) const
+	{
+		boost::mutex::scoped_lock lock(mutex_);
+		const size_t len = std::min(buf_.size(), maxLen);
+		readStage_.resize(std::max(len, size_t(1)));
+		typename buffer_type::const_iterator itBegin = buf_.begin();
+		typename buffer_type::const_iterator it = itBegin;
+		std::advance(it, len);
+		std::copy(itBegin, it, readStage_.begin());
+
+		segments[0] = &readStage_[0];  lengths[0] = len;
+		segments[1] = NULL;  lengths[1] = 0;
+		return len;
+	}
+	/**
+	 *	@brief  [producer] get a staging area for at most maxLen values.
+	 *	@return  the total length of the segments.
+	 *
+	 *	values written into the segments are pushed by produce(). only one producer may use them at a time.
+	 */
+	size_t getWritableSegments(value_type *segments[2], size_t lengths[2], const size_t maxLen)
+	{
+		writeStage_.resize(std::max(maxLen, size_t(1)));
+		segments[0] = &writeStage_[0];  lengths[0] = maxLen;
+		segments[1] = NULL;  lengths[1] = 0;
+		return maxLen;
+	}
+	/**
+	 *	@brief  [producer] push the first len values written into the segments given by getWritableSegments().
+	 */
+	bool produce(const size_t len)  {  return push(&writeStage_[0], len);  }
+
 	/**
 	 *	@brief  data buffer .
 	 *
@@ -193,11 +236,8 @@ public:
 	 */
 	void clear()
 	{
-		if (!buf_.empty())
-		{
-			boost::mutex::scoped_lock lock(mutex_);
-			buf_.clear();
-		}
+		boost::mutex::scoped_lock lock(mutex_);
+		buf_.clear();
 	}
 
 	/**
@@ -206,25 +246,43 @@ public:
 	 *
 	 *	data buffer  ִ data  ˷ش.
 	 */
-	size_t getSize() const  {  return buf_.size();  }
+	size_t getSize() const
+	{
+		boost::mutex::scoped_lock lock(mutex_);
+		return buf_.size();
+	}
 	/**
 	 *	@brief  data buffer  ִ Ȯ.
 	 *	@return  data buffer  ִٸ true ȯ.
 	 *
 	 *	data buffer  ִٸ true,   ʴٸ false ȯѴ.
 	 */
-	bool isEmpty() const  {  return buf_.empty();  }
+	bool isEmpty() const
+	{
+		boost::mutex::scoped_lock lock(mutex_);
+		return buf_.empty();
+	}
 
 private:
 	buffer_type buf_;
 
+	mutable std::vector<value_type> readStage_;
+	std::vector<value_type> writeStage_;
+
 	mutable boost::mutex mutex_;
 };
 
 //-----------------------------------------------------------------------------------
-//	mutex-guarded byte(unsigned char) buffer
+//	byte(unsigned char) buffer used by serial & TCP socket communication
+//	- a fixed-capacity lock-free ring buffer is used instead of the mutex-guarded one if configured in swl/Config.h.
 
+#if defined(__SWL_CONFIG__USE_SPSC_BYTE_BUFFER)
+typedef SpscByteBuffer GuardedByteBuffer;
+#elif defined(__SWL_CONFIG__USE_MPMC_BYTE_BUFFER)
+typedef MpmcByteBuffer GuardedByteBuffer;
+#else
 typedef GuardedBuffer<unsigned char> GuardedByteBuffer;
+#endif
 
 }  // namespace swl
 
@@ -2,10 +2,11 @@
 #define __SWL_UTIL__PACKET_DISPATCHER_INTERFACE__H_ 1
 
 
-namespace swl {
+// GuardedByteBuffer can be a lock-free ring buffer depending on the configuration.
+#include "swl/util/GuardedBuffer.h"
+
 
-template<class T> class GuardedBuffer;
-typedef GuardedBuffer<unsigned char> GuardedByteBuffer;
+namespace swl {
 
 //-----------------------------------------------------------------------------------
 //	packet dispatcher interface
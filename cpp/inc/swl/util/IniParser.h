@@ -3,7 +3,10 @@
 
 
 #include "swl/util/ExportUtil.h"
+#include "swl/DisableCompilerWarning.h"
+#include <boost/unordered_map.hpp>
 #include <string>
+#include <vector>
 
 
 struct dictionary;
@@ -13,6 +16,71 @@ namespace swl {
 //--------------------------------------------------------------------------
 //
 
+/**
+ *	@brief  A snapshot of the entries of an ini file or of one of its sections
+ *
+ *	The entries are copied out of the dictionary once by IniParser::takeSnapshot() or IniParser::takeSectionSnapshot(),
+ *	so the lookups are hashed & the wide-string conversions are done only once.
+ *	Keys are lowercase as in the dictionary. Section entries (without values) are not included.
+ *
+ *	Two snapshots can be compared by diff() to find the entries changed by reloading an ini file.
+ */
+class SWL_UTIL_API IniSnapshot
+{
+public:
+#if defined(_UNICODE) || defined(UNICODE)
+	typedef std::wstring string_type;
+#else
+	typedef std::string string_type;
+#endif
+	typedef boost::unordered_map<string_type, string_type> entry_map_type;
+
+public:
+	IniSnapshot();
+
+public:
+	/**
+	 *	@brief  Check if a key exists in the snapshot
+	 *	@param[in]  key  Key string to look for. it's case-insensitive.
+	 */
+	bool contains(const string_type &key) const;
+
+	/**
+	 *	@brief  Get the values associated to a key, with the same conversions as the getters of IniParser
+	 *	@param[in]  key  Key string to look for. it's case-insensitive.
+	 *	@param[in]  notfound  Value to return if the key is not found (or can't be converted to a boolean by getBool()).
+	 */
+	string_type getString(const string_type &key, const string_type &notfound) const;
+	int getInt(const string_type &key, const int notfound) const;
+	double getDouble(const string_type &key, const double notfound) const;
+	bool getBool(const string_type &key, const bool notfound) const;
+
+	/**
+	 *	@brief  Compare the snapshot with a previous one
+	 *	@param[in]  previous  The snapshot to compare with.
+	 *	@param[out]  addedKeys  Keys only in this snapshot.
+	 *	@param[out]  removedKeys  Keys only in the previous snapshot.
+	 *	@param[out]  changedKeys  Keys whose values are different.
+	 *	@return  true if there is any difference.
+	 */
+	bool diff(const IniSnapshot &previous, std::vector<string_type> &addedKeys, std::vector<string_type> &removedKeys, std::vector<string_type> &changedKeys) const;
+
+	const entry_map_type & getEntries() const  {  return entries_;  }
+	std::size_t getSize() const  {  return entries_.size();  }
+	void clear()  {  entries_.clear();  }
+
+private:
+	const string_type * find(const string_type &key) const;
+
+private:
+	friend class IniParser;
+
+	entry_map_type entries_;
+};
+
+//--------------------------------------------------------------------------
+//
+
 /**
  *	@brief  A parser class for interfacing an ini file
  *
@@ -265,6 +333,26 @@ public:
 	bool findEntry(const std::string &entry) const;
 #endif
 
+	/**
+	 *	@brief  Copy all the entries to a snapshot
+	 *	@param[out]  snapshot  Snapshot receiving the entries keyed as "section:key".
+	 *
+	 *	The entries are read with a single pass over the dictionary.
+	 */
+	void takeSnapshot(IniSnapshot &snapshot) const;
+	/**
+	 *	@brief  Copy the entries of a section to a snapshot
+	 *	@param[in]  section  Section name. it's case-insensitive.
+	 *	@param[out]  snapshot  Snapshot receiving the entries keyed without the "section:" prefix.
+	 *
+	 *	The entries are read with a single pass over the dictionary.
+	 */
+#if defined(_UNICODE) || defined(UNICODE)
+	void takeSectionSnapshot(const std::wstring &section, IniSnapshot &snapshot) const;
+#else
+	void takeSectionSnapshot(const std::string &section, IniSnapshot &snapshot) const;
+#endif
+
 private:
 	dictionary *ini_;
 };
@@ -272,4 +360,7 @@ private:
 }  // namespace swl
 
 
+#include "swl/EnableCompilerWarning.h"
+
+
 #endif  // __SWL_UTIL__INI_PARSER__H_
@@ -0,0 +1,130 @@
+#if !defined(__SWL_UTIL__IO_SERVICE_POOL__H_)
+#define __SWL_UTIL__IO_SERVICE_POOL__H_ 1
+
+
+#include "swl/util/ExportUtil.h"
+#include <boost/asio.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/atomic.hpp>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+
+namespace swl {
+
+//-----------------------------------------------------------------------------------
+//	counters of an I/O service in a pool
+
+/**
+ *	@brief  load counters of an I/O service, updated by the connections served by it.
+ */
+struct SWL_UTIL_API IoServiceStatistics
+{
+public:
+	IoServiceStatistics()
+	: connectionCount(0), sentByteCount(0), receivedByteCount(0), pendingOperationCount(0)
+	{}
+
+private:
+	IoServiceStatistics(const IoServiceStatistics &rhs);
+	IoServiceStatistics & operator=(const IoServiceStatistics &rhs);
+
+public:
+	/// the number of open connections.
+	boost::atomic<std::size_t> connectionCount;
+	boost::atomic<unsigned long long> sentByteCount;
+	boost::atomic<unsigned long long> receivedByteCount;
+	/// the number of started & not yet completed asynchronous operations, i.e. the queue depth.
+	boost::atomic<std::size_t> pendingOperationCount;
+};
+
+//-----------------------------------------------------------------------------------
+//	pool of I/O services
+
+/**
+ *	@brief  a pool of Boost.ASIO I/O services, each of which is run by its own thread.
+ *
+ *	a connection is assigned to one I/O service for its lifetime, so the handlers of a connection run on one thread
+ *	& the connections are served in parallel on different threads.
+ *	the threads can be pinned to the processor cores.
+ *
+ *	the I/O services keep running without any pending work until stop() is called.
+ */
+class SWL_UTIL_API IoServicePool
+{
+public:
+	//typedef IoServicePool base_type;
+
+	enum AssignmentPolicy { ROUND_ROBIN = 0, LEAST_LOADED };
+
+public:
+	/**
+	 *	@brief  [ctor] constructor.
+	 *	@param[in]  poolSize  the number of I/O services. the number of hardware threads is used if it's 0.
+	 *	@param[in]  policy  how an I/O service is selected for a new connection.
+	 *	@param[in]  pinsThreads  pin the i-th thread to the (i mod #cores)-th core if it's true.
+	 */
+	explicit IoServicePool(const std::size_t poolSize = 0, const AssignmentPolicy policy = LEAST_LOADED, const bool pinsThreads = false);
+	~IoServicePool();
+
+private:
+	IoServicePool(const IoServicePool &rhs);
+	IoServicePool & operator=(const IoServicePool &rhs);
+
+public:
+	/**
+	 *	@brief  run all the I/O services on their threads & wait until they are stopped by stop() in another thread.
+	 */
+	void run();
+	/**
+	 *	@brief  run all the I/O services on their threads & return immediately.
+	 */
+	void start();
+	/**
+	 *	@brief  stop all the I/O services. it can be called from any thread.
+	 */
+	void stop();
+	/**
+	 *	@brief  wait for the threads started by start() to finish.
+	 */
+	void join();
+
+	/**
+	 *	@brief  select an I/O service for a new connection by the assignment policy.
+	 *	@return  the index of the selected I/O service.
+	 */
+	std::size_t selectIoService();
+
+	boost::asio::io_service & getIoService(const std::size_t index)  {  return *ioServices_[index];  }
+	IoServiceStatistics & getStatistics(const std::size_t index)  {  return *statistics_[index];  }
+	const IoServiceStatistics & getStatistics(const std::size_t index) const  {  return *statistics_[index];  }
+
+	std::size_t getSize() const  {  return ioServices_.size();  }
+	AssignmentPolicy getAssignmentPolicy() const  {  return policy_;  }
+
+private:
+	typedef boost::shared_ptr<boost::asio::io_service> io_service_pointer;
+	typedef boost::shared_ptr<boost::asio::io_service::work> work_pointer;
+	typedef boost::shared_ptr<IoServiceStatistics> statistics_pointer;
+	typedef boost::shared_ptr<boost::thread> thread_pointer;
+
+	static void runIoService(io_service_pointer ioService);
+	void pinThread(boost::thread &thrd, const std::size_t index) const;
+
+private:
+
+	std::vector<io_service_pointer> ioServices_;
+	std::vector<work_pointer> works_;
+	std::vector<statistics_pointer> statistics_;
+
+	const AssignmentPolicy policy_;
+	const bool pinsThreads_;
+	boost::atomic<std::size_t> nextIndex_;
+
+	std::vector<thread_pointer> threads_;
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_UTIL__IO_SERVICE_POOL__H_
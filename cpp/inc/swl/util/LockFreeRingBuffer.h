@@ -0,0 +1,558 @@
+#if !defined(__SWL_UTIL__LOCK_FREE_RING_BUFFER__H_)
+#define __SWL_UTIL__LOCK_FREE_RING_BUFFER__H_ 1
+
+
+#include <boost/atomic.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_pod.hpp>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <cstring>
+
+
+namespace swl {
+
+//-----------------------------------------------------------------------------------
+//	fixed-capacity lock-free ring buffer for a single producer & a single consumer
+
+/**
+ *	@brief  lock-free ring buffer for one producer thread & one consumer thread.
+ *
+ *	push() has to be called from one thread, and top(), pop(), peek() & consume() from another thread.
+ *	clear() may be called from any thread. data being read by the consumer at the same time are discarded.
+ *	bulk operations are all-or-nothing & copy at most two contiguous segments.
+ *	the segment operations give direct access to the storage for scatter-gather I/O without a staging copy.
+ *	the capacity is rounded up to a power of two. the value type has to be a POD type.
+ *	the indices of the producer & the consumer are kept on separate cache lines.
+ *
+ *	this class has the same interface as GuardedBuffer.
+ */
+template<class T>
+class SpscRingBuffer
+{
+public:
+	//typedef SpscRingBuffer				base_type;
+	typedef T							value_type;
+
+	BOOST_STATIC_ASSERT(boost::is_pod<T>::value);
+
+public:
+	enum { DEFAULT_CAPACITY = 1 << 20, CACHE_LINE_SIZE = 64 };
+
+public:
+	explicit SpscRingBuffer(const size_t capacity = DEFAULT_CAPACITY)
+	: capacity_(roundUpCapacity(capacity)), mask_(capacity_ - 1), buf_(new value_type [capacity_]),
+	  head_(0), cachedTail_(0), tail_(0), cachedHead_(0), writeStage_(), isWriteStaged_(false)
+	{}
+	~SpscRingBuffer()
+	{
+		delete [] buf_;
+	}
+
+private:
+	SpscRingBuffer(const SpscRingBuffer &rhs);
+	SpscRingBuffer & operator=(const SpscRingBuffer &rhs);
+
+public:
+	/**
+	 *	@brief  [producer] push a value.
+	 *	@return  false if the buffer is full.
+	 */
+	bool push(const value_type &data)
+	{
+		const size_t tail = tail_.load(boost::memory_order_relaxed);
+		if (!hasSpace(tail, 1)) return false;
+
+		buf_[tail & mask_] = data;
+		tail_.store(tail + 1, boost::memory_order_release);
+		return true;
+	}
+	/**
+	 *	@brief  [producer] push len values.
+	 *	@return  false if there is not enough space. nothing is pushed in that case.
+	 */
+	bool push(const value_type *data, const size_t len)
+	{
+		const size_t tail = tail_.load(boost::memory_order_relaxed);
+		if (!hasSpace(tail, len)) return false;
+
+		copyIn(tail, data, len);
+		tail_.store(tail + len, boost::memory_order_release);
+		return true;
+	}
+	template <class InputIterator>
+	bool push(InputIterator first, InputIterator last)
+	{
+		const size_t len = std::distance(first, last);
+		const size_t tail = tail_.load(boost::memory_order_relaxed);
+		if (!hasSpace(tail, len)) return false;
+
+		copyIn(tail, first, len);
+		tail_.store(tail + len, boost::memory_order_release);
+		return true;
+	}
+
+	/**
+	 *	@brief  [producer] get the free space for at most maxLen values as at most two contiguous segments.
+	 *	@return  the total length of the segments.
+	 *
+	 *	values written into the segments are pushed by produce().
+	 *	if the buffer is full, a staging area is given instead & produce() fails like push().
+	 */
+	size_t getWritableSegments(value_type *segments[2], size_t lengths[2], const size_t maxLen)
+	{
+		const size_t tail = tail_.load(boost::memory_order_relaxed);
+		cachedHead_ = head_.load(boost::memory_order_acquire);
+		const size_t len = std::min(capacity_ - (tail - cachedHead_), maxLen);
+		if (0 == len && maxLen > 0)
+		{
+			writeStage_.resize(maxLen);
+			isWriteStaged_ = true;
+			segments[0] = &writeStage_[0];  lengths[0] = maxLen;
+			segments[1] = NULL;  lengths[1] = 0;
+			return maxLen;
+		}
+
+		isWriteStaged_ = false;
+		splitSegments(tail, len, segments, lengths);
+		return len;
+	}
+	/**
+	 *	@brief  [producer] push the first len values written into the segments given by getWritableSegments().
+	 */
+	bool produce(const size_t len)
+	{
+		if (isWriteStaged_)
+		{
+			isWriteStaged_ = false;
+			return push(&writeStage_[0], len);
+		}
+
+		const size_t tail = tail_.load(boost::memory_order_relaxed);
+		if (!hasSpace(tail, len)) return false;
+		tail_.store(tail + len, boost::memory_order_release);
+		return true;
+	}
+
+	/**
+	 *	@brief  [consumer] copy the oldest value without removing it.
+	 *	@return  false if the buffer is empty.
+	 */
+	bool top(value_type &data) const
+	{
+		const size_t head = head_.load(boost::memory_order_acquire);
+		if (!hasData(head, 1)) return false;
+
+		data = buf_[head & mask_];
+		return true;
+	}
+	/**
+	 *	@brief  [consumer] copy the oldest len values without removing them.
+	 *	@return  false if fewer than len values are stored.
+	 */
+	bool top(value_type *data, const size_t len) const
+	{
+		const size_t head = head_.load(boost::memory_order_acquire);
+		if (!hasData(head, len)) return false;
+
+		copyOut(head, data, len);
+		return true;
+	}
+	bool peek(value_type *data, const size_t len) const  {  return top(data, len);  }
+
+	/**
+	 *	@brief  [consumer] get at most maxLen oldest values as at most two contiguous segments without removing them.
+	 *	@return  the total length of the segments.
+	 *
+	 *	the segments point into the storage & stay valid until the values are popped.
+	 */
+	size_t getReadableSegments(const value_type *segments[2], size_t lengths[2], const size_t maxLen) const
+	{
+		const size_t head = head_.load(boost::memory_order_acquire);
+		cachedTail_ = tail_.load(boost::memory_order_acquire);
+		const size_t len = std::min(std::min(cachedTail_ - head, capacity_), maxLen);
+		splitSegments(head, len, segments, lengths);
+		return len;
+	}
+
+	/**
+	 *	@brief  [consumer] remove the oldest len values.
+	 *	@return  false if fewer than len values are stored or they are cleared meanwhile.
+	 */
+	bool pop(const size_t len)
+	{
+		size_t head = head_.load(boost::memory_order_acquire);
+		if (!hasData(head, len)) return false;
+
+		// fails only if clear() has been called in another thread.
+		return head_.compare_exchange_strong(head, head + len, boost::memory_order_release, boost::memory_order_relaxed);
+	}
+	bool pop()  {  return pop(1);  }
+	bool consume(const size_t len)  {  return pop(len);  }
+	/**
+	 *	@brief  [consumer] copy & remove the oldest len values.
+	 */
+	bool pop(value_type *data, const size_t len)
+	{
+		size_t head = head_.load(boost::memory_order_acquire);
+		if (!hasData(head, len)) return false;
+
+		copyOut(head, data, len);
+		return head_.compare_exchange_strong(head, head + len, boost::memory_order_release, boost::memory_order_relaxed);
+	}
+
+	/**
+	 *	@brief  discard all the stored values.
+	 */
+	void clear()
+	{
+		size_t head = head_.load(boost::memory_order_relaxed);
+		size_t tail;
+		do
+		{
+			// the tail is loaded after the head so that the head is never moved backward.
+			tail = tail_.load(boost::memory_order_acquire);
+			if (head == tail) return;
+		} while (!head_.compare_exchange_weak(head, tail, boost::memory_order_release, boost::memory_order_relaxed));
+	}
+
+	/**
+	 *	@brief  the number of stored values. it's a snapshot if it's called from neither the producer nor the consumer.
+	 */
+	size_t getSize() const
+	{
+		// the head never passes the tail.
+		const size_t head = head_.load(boost::memory_order_acquire);
+		const size_t tail = tail_.load(boost::memory_order_acquire);
+		return std::min(tail - head, capacity_);
+	}
+	bool isEmpty() const  {  return 0 == getSize();  }
+	size_t getCapacity() const  {  return capacity_;  }
+
+private:
+	static size_t roundUpCapacity(const size_t capacity)
+	{
+		size_t powerOfTwo = 1;
+		while (powerOfTwo < capacity) powerOfTwo <<= 1;
+		return powerOfTwo;
+	}
+
+	template <class Pointer>
+	void splitSegments(const size_t pos, const size_t len, Pointer segments[2], size_t lengths[2]) const
+	{
+		const size_t first = pos & mask_;
+		segments[0] = buf_ + first;  lengths[0] = std::min(len, capacity_ - first);
+		segments[1] = buf_;  lengths[1] = len - lengths[0];
+	}
+
+	bool hasSpace(const size_t tail, const size_t len)
+	{
+		// the cached head is reloaded only when the buffer looks full.
+		if (capacity_ - (tail - cachedHead_) >= len) return true;
+		cachedHead_ = head_.load(boost::memory_order_acquire);
+		return capacity_ - (tail - cachedHead_) >= len;
+	}
+
+	bool hasData(const size_t head, const size_t len) const
+	{
+		// the cached tail is reloaded only when the buffer looks empty. it may be behind the head after clear().
+		const size_t available = cachedTail_ - head;
+		if (available <= capacity_ && available >= len) return true;
+		cachedTail_ = tail_.load(boost::memory_order_acquire);
+		return cachedTail_ - head >= len;
+	}
+
+	void copyIn(const size_t pos, const value_type *data, const size_t len)
+	{
+		const size_t first = pos & mask_;
+		const size_t len1 = std::min(len, capacity_ - first);
+		std::memcpy(buf_ + first, data, len1 * sizeof(value_type));
+		std::memcpy(buf_, data + len1, (len - len1) * sizeof(value_type));
+	}
+	template <class InputIterator>
+	void copyIn(const size_t pos, InputIterator first, const size_t len)
+	{
+		for (size_t i = 0; i < len; ++i, ++first)
+			buf_[(pos + i) & mask_] = *first;
+	}
+
+	void copyOut(const size_t pos, value_type *data, const size_t len) const
+	{
+		const size_t first = pos & mask_;
+		const size_t len1 = std::min(len, capacity_ - first);
+		std::memcpy(data, buf_ + first, len1 * sizeof(value_type));
+		std::memcpy(data + len1, buf_, (len - len1) * sizeof(value_type));
+	}
+
+private:
+	// read-only after construction
+	const size_t capacity_;
+	const size_t mask_;
+	value_type *buf_;
+	char padding0_[CACHE_LINE_SIZE];
+
+	// written by the consumer
+	boost::atomic<size_t> head_;
+	mutable size_t cachedTail_;
+	char padding1_[CACHE_LINE_SIZE];
+
+	// written by the producer
+	boost::atomic<size_t> tail_;
+	size_t cachedHead_;
+	std::vector<value_type> writeStage_;
+	bool isWriteStaged_;
+	char padding2_[CACHE_LINE_SIZE];
+};
+
+//-----------------------------------------------------------------------------------
+//	fixed-capacity lock-free ring buffer for multiple producers & multiple consumers
+
+/**
+ *	@brief  ring buffer for any number of producer & consumer threads.
+ *
+ *	a range is reserved by advancing a reserve index with CAS & published by advancing a commit index in the reservation order.
+ *	copies are done outside of any lock, but a thread may wait for the threads which reserved earlier ranges to commit.
+ *	top() followed by pop() is atomic only with a single consumer. use pop(data, len) otherwise.
+ *	bulk operations are all-or-nothing & copy at most two contiguous segments.
+ *	the readable segments point into the storage, but the writable segments are a staging area
+ *	since a reserved range would block the other producers until it's committed.
+ *	the capacity is rounded up to a power of two. the value type has to be a POD type.
+ *
+ *	this class has the same interface as GuardedBuffer.
+ */
+template<class T>
+class MpmcRingBuffer
+{
+public:
+	//typedef MpmcRingBuffer				base_type;
+	typedef T							value_type;
+
+	BOOST_STATIC_ASSERT(boost::is_pod<T>::value);
+
+public:
+	enum { DEFAULT_CAPACITY = 1 << 20, CACHE_LINE_SIZE = 64 };
+
+public:
+	explicit MpmcRingBuffer(const size_t capacity = DEFAULT_CAPACITY)
+	: capacity_(roundUpCapacity(capacity)), mask_(capacity_ - 1), buf_(new value_type [capacity_]),
+	  writeReserve_(0), writeCommit_(0), readReserve_(0), readCommit_(0), writeStage_()
+	{}
+	~MpmcRingBuffer()
+	{
+		delete [] buf_;
+	}
+
+private:
+	MpmcRingBuffer(const MpmcRingBuffer &rhs);
+	MpmcRingBuffer & operator=(const MpmcRingBuffer &rhs);
+
+public:
+	bool push(const value_type &data)  {  return push(&data, 1);  }
+	/**
+	 *	@brief  push len values.
+	 *	@return  false if there is not enough space. nothing is pushed in that case.
+	 */
+	bool push(const value_type *data, const size_t len)
+	{
+		size_t pos;
+		if (!reserveWrite(len, pos)) return false;
+		copyIn(pos, data, len);
+		commit(writeCommit_, pos, len);
+		return true;
+	}
+	template <class InputIterator>
+	bool push(InputIterator first, InputIterator last)
+	{
+		const size_t len = std::distance(first, last);
+		size_t pos;
+		if (!reserveWrite(len, pos)) return false;
+		copyIn(pos, first, len);
+		commit(writeCommit_, pos, len);
+		return true;
+	}
+
+	/**
+	 *	@brief  get a staging area for at most maxLen values. only one producer may use it at a time.
+	 *	@return  the total length of the segments.
+	 *
+	 *	values written into the segments are pushed by produce().
+	 */
+	size_t getWritableSegments(value_type *segments[2], size_t lengths[2], const size_t maxLen)
+	{
+		writeStage_.resize(std::max(maxLen, size_t(1)));
+		segments[0] = &writeStage_[0];  lengths[0] = maxLen;
+		segments[1] = NULL;  lengths[1] = 0;
+		return maxLen;
+	}
+	/**
+	 *	@brief  push the first len values written into the segments given by getWritableSegments().
+	 */
+	bool produce(const size_t len)  {  return push(&writeStage_[0], len);  }
+
+	bool top(value_type &data) const  {  return top(&data, 1);  }
+	/**
+	 *	@brief  copy the oldest len values without removing them.
+	 */
+	bool top(value_type *data, const size_t len) const
+	{
+		const size_t pos = readReserve_.load(boost::memory_order_acquire);
+		if (writeCommit_.load(boost::memory_order_acquire) - pos < len) return false;
+		copyOut(pos, data, len);
+		return true;
+	}
+	bool peek(value_type *data, const size_t len) const  {  return top(data, len);  }
+
+	/**
+	 *	@brief  get at most maxLen oldest values as at most two contiguous segments without removing them.
+	 *	@return  the total length of the segments.
+	 *
+	 *	the segments point into the storage & stay valid until the values are popped.
+	 *	like top(), it's safe only with a single consumer.
+	 */
+	size_t getReadableSegments(const value_type *segments[2], size_t lengths[2], const size_t maxLen) const
+	{
+		const size_t pos = readReserve_.load(boost::memory_order_acquire);
+		const size_t len = std::min(std::min(writeCommit_.load(boost::memory_order_acquire) - pos, capacity_), maxLen);
+		const size_t first = pos & mask_;
+		segments[0] = buf_ + first;  lengths[0] = std::min(len, capacity_ - first);
+		segments[1] = buf_;  lengths[1] = len - lengths[0];
+		return len;
+	}
+
+	/**
+	 *	@brief  copy & remove the oldest len values.
+	 *	@return  false if fewer than len values are stored.
+	 */
+	bool pop(value_type *data, const size_t len)
+	{
+		size_t pos;
+		if (!reserveRead(len, pos)) return false;
+		copyOut(pos, data, len);
+		commit(readCommit_, pos, len);
+		return true;
+	}
+	bool pop(const size_t len)
+	{
+		size_t pos;
+		if (!reserveRead(len, pos)) return false;
+		commit(readCommit_, pos, len);
+		return true;
+	}
+	bool pop()  {  return pop(1);  }
+	bool consume(const size_t len)  {  return pop(len);  }
+
+	void clear()
+	{
+		size_t pos = readReserve_.load(boost::memory_order_relaxed);
+		size_t len;
+		do
+		{
+			len = writeCommit_.load(boost::memory_order_acquire) - pos;
+			if (0 == len) return;
+		} while (!readReserve_.compare_exchange_weak(pos, pos + len, boost::memory_order_acq_rel, boost::memory_order_relaxed));
+		commit(readCommit_, pos, len);
+	}
+
+	size_t getSize() const
+	{
+		// the read reserve index never passes the write commit index.
+		const size_t head = readReserve_.load(boost::memory_order_acquire);
+		const size_t tail = writeCommit_.load(boost::memory_order_acquire);
+		return std::min(tail - head, capacity_);
+	}
+	bool isEmpty() const  {  return 0 == getSize();  }
+	size_t getCapacity() const  {  return capacity_;  }
+
+private:
+	static size_t roundUpCapacity(const size_t capacity)
+	{
+		size_t powerOfTwo = 1;
+		while (powerOfTwo < capacity) powerOfTwo <<= 1;
+		return powerOfTwo;
+	}
+
+	bool reserveWrite(const size_t len, size_t &pos)
+	{
+		pos = writeReserve_.load(boost::memory_order_relaxed);
+		do
+		{
+			if (capacity_ - (pos - readCommit_.load(boost::memory_order_acquire)) < len) return false;
+		} while (!writeReserve_.compare_exchange_weak(pos, pos + len, boost::memory_order_acq_rel, boost::memory_order_relaxed));
+		return true;
+	}
+
+	bool reserveRead(const size_t len, size_t &pos)
+	{
+		pos = readReserve_.load(boost::memory_order_relaxed);
+		do
+		{
+			if (writeCommit_.load(boost::memory_order_acquire) - pos < len) return false;
+		} while (!readReserve_.compare_exchange_weak(pos, pos + len, boost::memory_order_acq_rel, boost::memory_order_relaxed));
+		return true;
+	}
+
+	static void commit(boost::atomic<size_t> &index, const size_t pos, const size_t len)
+	{
+		// ranges are published in the order of their reservation.
+		while (index.load(boost::memory_order_acquire) != pos)
+			boost::this_thread::yield();
+		index.store(pos + len, boost::memory_order_release);
+	}
+
+	void copyIn(const size_t pos, const value_type *data, const size_t len)
+	{
+		const size_t first = pos & mask_;
+		const size_t len1 = std::min(len, capacity_ - first);
+		std::memcpy(buf_ + first, data, len1 * sizeof(value_type));
+		std::memcpy(buf_, data + len1, (len - len1) * sizeof(value_type));
+	}
+	template <class InputIterator>
+	void copyIn(const size_t pos, InputIterator first, const size_t len)
+	{
+		for (size_t i = 0; i < len; ++i, ++first)
+			buf_[(pos + i) & mask_] = *first;
+	}
+
+	void copyOut(const size_t pos, value_type *data, const size_t len) const
+	{
+		const size_t first = pos & mask_;
+		const size_t len1 = std::min(len, capacity_ - first);
+		std::memcpy(data, buf_ + first, len1 * sizeof(value_type));
+		std::memcpy(data + len1, buf_, (len - len1) * sizeof(value_type));
+	}
+
+private:
+	// read-only after construction
+	const size_t capacity_;
+	const size_t mask_;
+	value_type *buf_;
+	char padding0_[CACHE_LINE_SIZE];
+
+	// producers
+	boost::atomic<size_t> writeReserve_;
+	char padding1_[CACHE_LINE_SIZE];
+	boost::atomic<size_t> writeCommit_;
+	char padding2_[CACHE_LINE_SIZE];
+
+	// consumers
+	boost::atomic<size_t> readReserve_;
+	char padding3_[CACHE_LINE_SIZE];
+	boost::atomic<size_t> readCommit_;
+	char padding4_[CACHE_LINE_SIZE];
+
+	// used by one producer at a time
+	std::vector<value_type> writeStage_;
+};
+
+//-----------------------------------------------------------------------------------
+//	lock-free byte(unsigned char) buffers
+
+typedef SpscRingBuffer<unsigned char> SpscByteBuffer;
+typedef MpmcRingBuffer<unsigned char> MpmcByteBuffer;
+
+}  // namespace swl
+
+
+#endif  // __SWL_UTIL__LOCK_FREE_RING_BUFFER__H_
@@ -0,0 +1,127 @@
+#if !defined(__SWL_UTIL__MAPPED_WAVE_READER__H_ )
+#define __SWL_UTIL__MAPPED_WAVE_READER__H_ 1
+
+
+#include "swl/util/ExportUtil.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+namespace swl {
+
+// Memory-mapped reader for the samples of a wave file.
+//	- The RIFF chunks are walked, so chunks such as "LIST" or "fact" in front of the "data" chunk are skipped.
+//	- 8/16/24/32-bit PCM & 32/64-bit IEEE float samples are decoded, including WAVE_FORMAT_EXTENSIBLE files.
+//	- Samples are decoded block by block into de-interleaved channel arrays & normalized to [-1, 1).
+//	- Only the byte range being decoded is mapped, so files larger than the address space can be read.
+//	- The read functions don't change the reader, so they can be called from several threads at once.
+class SWL_UTIL_API MappedWaveReader final
+{
+public:
+	enum SampleFormat { UNKNOWN_FORMAT = 0, PCM_U8, PCM_S16, PCM_S24, PCM_S32, FLOAT32, FLOAT64 };
+
+public:
+	MappedWaveReader();
+	~MappedWaveReader();
+
+private:
+	MappedWaveReader(const MappedWaveReader &) = delete;
+	MappedWaveReader & operator=(const MappedWaveReader &) = delete;
+
+public:
+	bool open(const std::string &filepath);
+	void close();
+
+	bool isOpened() const {  return isOpened_;  }
+
+	// Decode the frames [startFrame, startFrame + frameCount) into channels[0], ..., channels[getNumberOfChannels() - 1].
+	// Return the number of the decoded frames.
+	size_t readFrames(const size_t startFrame, const size_t frameCount, float * const *channels) const;
+	size_t readFrames(const size_t startFrame, const size_t frameCount, double * const *channels) const;
+	// The channel arrays are resized to the number of the decoded frames.
+	size_t readFrames(const size_t startFrame, const size_t frameCount, std::vector<std::vector<float> > &channels) const;
+	size_t readChannel(const size_t channel, const size_t startFrame, const size_t frameCount, float *channelData) const;
+
+	// Format info.
+	SampleFormat getSampleFormat() const {  return sampleFormat_;  }
+	uint16_t getNumberOfChannels() const {  return channels_;  }
+	uint32_t getSamplesPerSecond() const {  return samplesPerSec_;  }
+	uint16_t getBitsPerSample() const {  return bitsPerSample_;  }
+	uint16_t getBlockAlign() const {  return blockAlign_;  }
+
+	uint64_t getDataOffset() const {  return dataOffset_;  }  // [byte].
+	uint64_t getDataSize() const {  return dataSize_;  }  // [byte].
+	size_t getNumberOfFrames() const {  return frameCount_;  }
+	double getDuration() const  // [sec].
+	{
+		return samplesPerSec_ ? (double)frameCount_ / (double)samplesPerSec_ : 0.0;
+	}
+
+private:
+	bool readHeader(const std::string &filepath);
+
+	template<typename T>
+	size_t decodeFrames(const size_t startFrame, const size_t frameCount, T * const *channels) const;
+	size_t clampFrameCount(const size_t startFrame, const size_t frameCount) const;
+
+private:
+	boost::interprocess::file_mapping file_;
+	bool isOpened_;
+
+	SampleFormat sampleFormat_;
+	uint16_t channels_;
+	uint32_t samplesPerSec_;
+	uint16_t bitsPerSample_;
+	uint16_t blockAlign_;
+
+	uint64_t dataOffset_;
+	uint64_t dataSize_;
+	size_t frameCount_;
+};
+
+// Chunked streaming over the frames of a MappedWaveReader.
+//	- Each call to next() maps & decodes the next framesPerChunk frames into the buffers of the stream.
+//	- The memory in use doesn't depend on the length of the file.
+//
+//	swl::WaveChunkStream stream(reader, 65536);
+//	while (stream.next())
+//		process(stream.getChannel(0), stream.getFrameCount());
+class SWL_UTIL_API WaveChunkStream final
+{
+public:
+	WaveChunkStream(const MappedWaveReader &reader, const size_t framesPerChunk, const size_t startFrame = 0);
+
+private:
+	WaveChunkStream(const WaveChunkStream &) = delete;
+	WaveChunkStream & operator=(const WaveChunkStream &) = delete;
+
+public:
+	// Return false at the end of the data.
+	bool next();
+	void seek(const size_t frame);
+
+	// The current chunk.
+	size_t getStartFrame() const {  return startFrame_;  }
+	size_t getFrameCount() const {  return frameCount_;  }
+	const float * getChannel(const size_t channel) const {  return channelPtrs_[channel];  }
+
+	size_t getFramesPerChunk() const {  return framesPerChunk_;  }
+
+private:
+	const MappedWaveReader &reader_;
+	const size_t framesPerChunk_;
+
+	size_t nextFrame_;
+	size_t startFrame_;
+	size_t frameCount_;
+
+	std::vector<float> buffer_;
+	std::vector<float *> channelPtrs_;
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_UTIL__MAPPED_WAVE_READER__H_
@@ -0,0 +1,94 @@
+#if !defined(__SWL_UTIL__PACKET_LAYOUT__H_)
+#define __SWL_UTIL__PACKET_LAYOUT__H_ 1
+
+
+#include "swl/util/ByteOrder.h"
+#include <cstring>
+
+
+namespace swl {
+
+//-----------------------------------------------------------------------------------
+//	compile-time packet layout
+
+/**
+ *	@brief  the start of a packet layout.
+ */
+struct PacketLayoutBegin
+{
+	static const std::size_t end = 0;
+};
+
+/**
+ *	@brief  a field of a fixed-size packet placed right after the field Previous.
+ *
+ *	the offset & the byte order are resolved at compile time,
+ *	so put() & get() are compiled to a store & a load (plus a byte swap) at a constant offset.
+ *	IsLittleEndian has the same meaning as in PacketPacker, i.e. multi-byte data is stored in the reverse order.
+ *
+ *	e.g.) <br>
+ *	>>  typedef swl::PacketField<unsigned char> Stx; <br>
+ *	>>  typedef swl::PacketField<short, Stx> Id; <br>
+ *	>>  typedef swl::PacketField<float, Id> Value; <br>
+ *	>>  typedef swl::PacketTextField<2, Value> Checksum; <br>
+ *	>>  typedef swl::PacketLayout<Checksum> Layout; <br>
+ *	>> <br>
+ *	>>  unsigned char packet[Layout::size]; <br>
+ *	>>  Id::put(packet, 7); <br>
+ *	>>  const float value = Value::get(packet); <br>
+ */
+template<typename T, class Previous = PacketLayoutBegin, bool IsLittleEndian = false>
+struct PacketField
+{
+public:
+	typedef T value_type;
+	typedef Previous previous_type;
+
+	static const std::size_t offset = Previous::end;
+	static const std::size_t size = sizeof(T);
+	static const std::size_t end = offset + size;
+
+public:
+	static void put(unsigned char *packet, const T &data)
+	{  storeBytes(packet + offset, data, IsLittleEndian);  }
+	static T get(const unsigned char *packet)
+	{  return loadBytes<T>(packet + offset, IsLittleEndian);  }
+};
+
+/**
+ *	@brief  a fixed-length text (or raw byte) field of a fixed-size packet placed right after the field Previous.
+ */
+template<std::size_t Length, class Previous = PacketLayoutBegin>
+struct PacketTextField
+{
+public:
+	typedef Previous previous_type;
+
+	static const std::size_t offset = Previous::end;
+	static const std::size_t size = Length;
+	static const std::size_t end = offset + size;
+
+public:
+	static void put(unsigned char *packet, const char *data)
+	{  std::memcpy(packet + offset, data, Length);  }
+	static void fill(unsigned char *packet, const char data)
+	{  std::memset(packet + offset, data, Length);  }
+	static void get(const unsigned char *packet, char *data)
+	{  std::memcpy(data, packet + offset, Length);  }
+};
+
+/**
+ *	@brief  a fixed-size packet layout ending with the field LastField.
+ */
+template<class LastField>
+struct PacketLayout
+{
+	typedef LastField last_field_type;
+
+	static const std::size_t size = LastField::end;
+};
+
+}  // namespace swl
+
+
+#endif  // __SWL_UTIL__PACKET_LAYOUT__H_
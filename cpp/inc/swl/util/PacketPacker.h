@@ -4,7 +4,6 @@
 
 #include "swl/util/ExportUtil.h"
 #include "swl/DisableCompilerWarning.h"
-#include <list>
 #include <vector>
 
 
@@ -50,7 +49,7 @@ public:
 	 */
 	//typedef T							value_type;
 	typedef unsigned char				value_type;
-	typedef std::list<value_type>		buffer_type;
+	typedef std::vector<value_type>		buffer_type;
 
 public:
 	/**
@@ -61,6 +60,17 @@ public:
 	 *	packet   ʿ  Է ޴´.
 	 */
 	PacketPacker(const std::size_t packetSize, const bool isLittleEndian);
+	/**
+	 *	@brief  [ctor] constructor.
+	 *	@param[in]  buffer  packet pack ܺ buffer. packet packer ϴ  ȿؾ .
+	 *	@param[in]  bufferSize  ܺ buffer .
+	 *	@param[in]  packetSize   Ծ . packetSize 0̶   protocol .
+	 *	@param[in]  isLittleEndian  multi-byte data little-endian (reverse order) packingǴ .
+	 *
+	 *	packet  buffer  ȣ   buffer  packѴ.
+	 *	buffer ̸ Ѵ data pack , isOverflowed() true ǰ finalize() Ѵ.
+	 */
+	PacketPacker(value_type *buffer, const std::size_t bufferSize, const std::size_t packetSize, const bool isLittleEndian);
 	/**
 	 *	@brief  [dtor] default destructor.
 	 *
@@ -95,13 +105,37 @@ public:
 	 *	ȯ packet pointer  Լ ȣ  array delete (e.g. delete [] packet_pointer;) ̿Ͽ Ͽ Ѵ.
 	 */
 	value_type * getPacket(bool isComplete = true) const;
+	/**
+	 *	@brief  packet packer   packet ȣ   buffer .
+	 *	@param[out]  packet  packet  buffer.
+	 *	@param[in]  size  packet  buffer .
+	 *	@param[in]  isComplete  ȯؾ  packet   . true ش packet ϼǾ ǹ.
+	 *	@return   packet ̸ ȯ. packet    0 ȯ.
+	 */
+	std::size_t copyPacket(value_type *packet, const std::size_t size, bool isComplete = true) const;
+	/**
+	 *	@brief  packet packer Ǿ ִ packet data pointer   ȯ.
+	 *	@return  packet data pointer.  data ٸ NULL ȯ.
+	 *
+	 *	ȯ pointer packet packer data ߰ packϰų ʱȭϱ  ȿϴ.
+	 */
+	const value_type * getPacketData() const;
 	/**
 	 *	@brief  Լ ȣϴ  packet packer pack data size.
 	 *	@return  packet packer Ǿ ִ data size ȯ.
 	 *
 	 *	packet  ̴  ̴ ϰ ȣ  Ǿ ִ packet data ̸ ȯѴ.
 	 */
-	std::size_t getPacketSize() const  {  return dataBuf_.size();  }
+	std::size_t getPacketSize() const  {  return dataSize_;  }
+
+	/**
+	 *	@brief   buffer  ̸ Ȯ.
+	 *	@param[in]  size  Ȯ buffer .
+	 *
+	 *	 buffer initialize()   Ҵ  ϹǷ,
+	 *	packet packer ϸ packet ޸𸮸 Ҵ ʴ´.
+	 */
+	void reserve(const std::size_t size);
 
 	/**
 	 *	@brief  packer packer ʱȭ.
@@ -149,11 +183,11 @@ public:
 	 *	@brief  packet packer 64-bit int  data pack.
 	 *	@param[in]  data  packet packer  data.
 	 */
-#if defined(__GNUC__)
+#if defined(__GNUC__)
 	void putInt64(long long data);
-#elif defined(_MSC_VER)
+#elif defined(_MSC_VER)
 	void putInt64(__int64 data);
-#endif
+#endif
 	/**
 	 *	@brief  packet packer float  data pack.
 	 *	@param[in]  data  packet packer  data.
@@ -190,6 +224,17 @@ public:
 	 *	packet   protocol̶ true, ׷ ʴٸ false ȯѴ.
 	 */
 	bool isFixedSize() const  {  return packetSize_ != 0;  }
+	/**
+	 *	@brief  ܺ buffer ̸ Ѵ data packϷ ߴ ȯ.
+	 *	@return  ܺ buffer ƴٸ true ȯ.
+	 */
+	bool isOverflowed() const  {  return isOverflowed_;  }
+
+private:
+	// make a room of len bytes at the current position & return it.
+	value_type * prepare(const std::size_t len);
+	template<typename T>
+	void put(const T &data);
 
 private:
 	// multi-byte data is packed in the reverse order
@@ -200,8 +245,134 @@ private:
 
 	// buffer
 	buffer_type dataBuf_;
-	//buffer_type::iterator itEnd_;
-	buffer_type::iterator itCurr_;
+	// caller-supplied buffer. if externalBuf_ == NULL, dataBuf_ is used
+	value_type * const externalBuf_;
+	const std::size_t externalBufSize_;
+	std::size_t dataSize_;
+	// data is inserted at currPos_
+	std::size_t currPos_;
+	bool isOverflowed_;
+};
+
+//-----------------------------------------------------------------------------------
+//  byte-based packet unpacker
+
+/**
+ *	@brief    application ߽ ŵ packet ؼϱ  Ǵ utility class.
+ *
+ *	PacketPacker   packet   unpackѴ.
+ *	packet  , ȣ   bufferκ  д´.
+ *
+ *	 ) <br>
+ *	>>  PacketUnpacker unpacker(packet, packetLen, isLittleEndian); <br>
+ *	>> <br>
+ *	>>  char prompt; <br>
+ *	>>  short id; <br>
+ *	>>  if (!unpacker.getChar(prompt) || !unpacker.getShort(id)) <br>
+ *	>>  { <br>
+ *	>>      // do something <br>
+ *	>>  } <br>
+ */
+class SWL_UTIL_API PacketUnpacker
+{
+public:
+	//typedef PacketUnpacker			base_type;
+	typedef unsigned char				value_type;
+
+public:
+	/**
+	 *	@brief  [ctor] constructor.
+	 *	@param[in]  packet  unpack packet. packet unpacker ϴ  ȿؾ .
+	 *	@param[in]  packetSize  unpack packet .
+	 *	@param[in]  isLittleEndian  multi-byte data little-endian (reverse order) packingǾ .
+	 */
+	PacketUnpacker(const value_type *packet, const std::size_t packetSize, const bool isLittleEndian);
+	/**
+	 *	@brief  [ctor] constructor.
+	 *	@param[in]  isLittleEndian  multi-byte data little-endian (reverse order) packingǾ .
+	 *
+	 *	unpack packet setPacket() Ѵ.
+	 */
+	explicit PacketUnpacker(const bool isLittleEndian);
+	/**
+	 *	@brief  [dtor] default destructor.
+	 *
+	 *	ش classκ ڽ class Ļ ϵ virtual Ǿ ִ.
+	 */
+	virtual ~PacketUnpacker();
+
+private:
+	PacketUnpacker(const PacketUnpacker &);
+	PacketUnpacker & operator=(const PacketUnpacker &);
+
+public:
+	bool isLittleEndian() const  {  return isLittleEndian_;  }
+
+	/**
+	 *	@brief  unpack packet ϰ ó unpackϵ ʱȭ.
+	 *	@param[in]  packet  unpack packet. packet unpacker ϴ  ȿؾ .
+	 *	@param[in]  packetSize  unpack packet .
+	 */
+	void setPacket(const value_type *packet, const std::size_t packetSize);
+	const value_type * getPacket() const  {  return packet_;  }
+	std::size_t getPacketSize() const  {  return packetSize_;  }
+
+	/**
+	 *	@brief  packet ó ٽ unpackϵ ʱȭ.
+	 *	@return  unpack packet Ǿ ִٸ true ȯ.
+	 */
+	bool initialize();
+
+	/**
+	 *	@brief   unpack data packet  ġ.
+	 */
+	std::size_t getPosition() const  {  return currPos_;  }
+	/**
+	 *	@brief   unpack  data .
+	 */
+	std::size_t getRemainingSize() const  {  return packetSize_ - currPos_;  }
+
+	/**
+	 *	@brief  packetκ data unpack.
+	 *	@param[out]  data  unpack data.
+	 *	@return   ִ data ϴٸ data  ʰ false ȯ.
+	 */
+	bool getChar(char &data);
+	bool getShort(short &data);
+	bool getInt(int &data);
+	bool getLong(long &data);
+#if defined(__GNUC__)
+	bool getInt64(long long &data);
+#elif defined(_MSC_VER)
+	bool getInt64(__int64 &data);
+#endif
+	bool getFloat(float &data);
+	bool getDouble(double &data);
+	bool getLDouble(long double &data);
+	/**
+	 *	@brief  packetκ size  c-style string(text)  data unpack.
+	 *	@param[out]  data  unpack data  buffer. null ڴ ߰ .
+	 *	@param[in]  size  unpack data .
+	 *	@return   ִ data ϴٸ false ȯ.
+	 */
+	bool getText(char *data, const std::size_t size);
+	/**
+	 *	@brief  size  data unpack ʰ ǳʶ.
+	 *	@return   ִ data ϴٸ false ȯ.
+	 */
+	bool skip(const std::size_t size);
+
+private:
+	template<typename T>
+	bool get(T &data);
+
+private:
+	// multi-byte data is packed in the reverse order
+	const bool isLittleEndian_;
+
+	const value_type *packet_;
+	std::size_t packetSize_;
+	std::size_t currPos_;
 };
 
 /*
@@ -4,14 +4,17 @@
 
 #include "swl/util/ExportUtil.h"
 #include "swl/util/GuardedBuffer.h"
+#include "swl/util/IoServicePool.h"
 #include <boost/asio.hpp>
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/bind.hpp>
-#include <boost/array.hpp>
 
 
 namespace swl {
 
+class FrameParser;
+struct IFrameHandler;
+
 //-----------------------------------------------------------------------------------
 //
 
@@ -27,6 +30,7 @@ namespace swl {
  *		-# [server] ٸ client  û 
  *
  *	TCP socket  asynchronous I/O ̿Ͽ Ѵ.
+ *	completion handler strand  ȣǹǷ I/O service  thread Ǵ  connection handler ÿ  ʴ´.
  */
 class SWL_UTIL_API TcpSocketConnection: public boost::enable_shared_from_this<TcpSocketConnection>
 {
@@ -127,6 +131,28 @@ public:
 	 */
 	std::size_t getReceiveBufferSize() const;
 
+	/**
+	 *	@brief  set the maximum length of a message sent by one write operation.
+	 *
+	 *	the message is written directly from the segments of the send buffer.
+	 */
+	void setMaxSendLength(const std::size_t len)  {  maxSendLength_ = len;  }
+	std::size_t getMaxSendLength() const  {  return maxSendLength_;  }
+	/**
+	 *	@brief  set the maximum length of a message received by one read operation.
+	 *
+	 *	the message is read directly into the segments of the receive buffer.
+	 */
+	void setMaxReceiveLength(const std::size_t len)  {  maxReceiveLength_ = len;  }
+	std::size_t getMaxReceiveLength() const  {  return maxReceiveLength_;  }
+
+	/**
+	 *	@brief  set the counters of the I/O service which serves this connection.
+	 *
+	 *	it has to be called once before start(). the connection is counted until it's destroyed.
+	 */
+	void setStatistics(IoServiceStatistics *statistics);
+
 protected:
 	/**
 	 *	@brief  ۽ buffer  message  .
@@ -154,28 +180,49 @@ protected:
 	 */
 	virtual void doCompleteReceiving(boost::system::error_code ec, std::size_t bytesTransferred) = 0;
 
+	/**
+	 *	@brief  start an asynchronous write of at most maxSendLength_ values from the send buffer.
+	 *
+	 *	the segments of the send buffer are written as a buffer sequence, so no staging copy is made.
+	 *	the length of the message is stored in sentMsgLength_ & the message has to be popped in doCompleteSending().
+	 */
+	void startSending();
+	/**
+	 *	@brief  start an asynchronous read into the free space of the receive buffer.
+	 *
+	 *	the received message has to be committed by receiveBuffer_.produce() in doCompleteReceiving().
+	 */
+	void startReceiving();
+	/**
+	 *	@brief  extract the complete frames from the receive buffer & hand them to the handler.
+	 *	@return  the number of the handled frames.
+	 *
+	 *	it can be called in doCompleteReceiving() after the received message is committed.
+	 */
+	std::size_t receiveFrames(FrameParser &parser, IFrameHandler &handler);
+
+private:
+	void handleSending(boost::system::error_code ec, std::size_t bytesTransferred);
+	void handleReceiving(boost::system::error_code ec, std::size_t bytesTransferred);
+
 protected:
 	/**
-	 *	@brief    ۽    ִ message ִ .
+	 *	@brief    ۽    ִ message ⺻ ִ .
 	 */
-#if defined(__GNUC__)
-	static const unsigned long MAX_SEND_LENGTH_ = 512;
-#else
-	static const std::size_t MAX_SEND_LENGTH_ = 512;
-#endif
+	static const std::size_t DEFAULT_MAX_SEND_LENGTH_ = 65536;
 	/**
-	 *	@brief        ִ message ִ .
+	 *	@brief        ִ message ⺻ ִ .
 	 */
-#if defined(__GNUC__)
-	static const unsigned long MAX_RECEIVE_LENGTH_ = 512;
-#else
-	static const std::size_t MAX_RECEIVE_LENGTH_ = 512;
-#endif
+	static const std::size_t DEFAULT_MAX_RECEIVE_LENGTH_ = 65536;
 
 	/**
 	 *	@brief  TCP socket   ϴ Boost.ASIO socket ü.
 	 */
 	boost::asio::ip::tcp::socket socket_;
+	/**
+	 *	@brief  completion handler serializeϴ strand.
+	 */
+	boost::asio::io_service::strand strand_;
 
 	/**
 	 *	@brief  TCP socket   send buffer.
@@ -190,17 +237,13 @@ protected:
 	 */
 	GuardedByteBuffer receiveBuffer_;
 	/**
-	 *	@brief    ۽  ϰ  message ϴ buffer.
-	 *
-	 *	buffer ̴ MAX_SEND_LENGTH_̴.
+	 *	@brief    ۽    ִ message ִ .
 	 */
-	boost::array<GuardedByteBuffer::value_type, MAX_SEND_LENGTH_> sendMsg_;
+	std::size_t maxSendLength_;
 	/**
-	 *	@brief      ϰ  message ϴ buffer.
-	 *
-	 *	buffer ̴ MAX_RECEIVE_LENGTH_̴.
+	 *	@brief        ִ message ִ .
 	 */
-	boost::array<GuardedByteBuffer::value_type, MAX_RECEIVE_LENGTH_> receiveMsg_;
+	std::size_t maxReceiveLength_;
 	/**
 	 *	@brief   ֱ ۽   message .
 	 */
@@ -214,6 +257,9 @@ protected:
 	 *	@brief  TCP socket   message   Ȯ.
 	 */
 	bool isReceiving_;
+
+private:
+	IoServiceStatistics *statistics_;
 };
 
 }  // namespace swl
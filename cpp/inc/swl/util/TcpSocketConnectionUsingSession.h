@@ -2,6 +2,7 @@
 #define __SWL_UTIL__TCP_SOCKET_CONNECTION_USING_SESSION__H_ 1
 
 
+#include "swl/util/IoServicePool.h"
 #include <boost/asio.hpp>
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/bind.hpp>
@@ -30,8 +31,11 @@ namespace swl {
  *			- void send(boost::system::error_code &ec);
  *			- bool isReadyToSend();
  *			- void receive(boost::system::error_code &ec);
+ *			- unsigned long long getSentByteCount() const;
+ *			- unsigned long long getReceivedByteCount() const;
  *
  *	TCP socket  asynchronous I/O ̿Ͽ Ѵ.
+ *	completion handler strand  ȣǹǷ I/O service  thread Ǵ session ÿ ȣ ʴ´.
  */
 template<typename Session>
 class TcpSocketConnectionUsingSession: public boost::enable_shared_from_this<TcpSocketConnectionUsingSession<Session> >
@@ -49,10 +53,17 @@ private:
 	 *	TCP socket connection ü ʱȭ Ѵ.
 	 */
 	TcpSocketConnectionUsingSession(boost::asio::io_service &ioService)
-	: socket_(ioService), session_(socket_),
-	  isReceiving_(false), isSending_(false)
+	: socket_(ioService), strand_(ioService), session_(socket_),
+	  isReceiving_(false), isSending_(false), statistics_(NULL)
 	{}
 
+public:
+	~TcpSocketConnectionUsingSession()
+	{
+		if (statistics_)
+			--statistics_->connectionCount;
+	}
+
 public:
 	/**
 	 *	@brief  [ctor] TCP socket connection ü   factory Լ.
@@ -92,21 +103,29 @@ public:
 		startOperation();
 	}
 
+	/**
+	 *	@brief  set the counters of the I/O service which serves this connection.
+	 *
+	 *	it has to be called once before start(). the connection is counted until it's destroyed.
+	 */
+	void setStatistics(IoServiceStatistics *statistics)
+	{
+		if (statistics_) --statistics_->connectionCount;
+		statistics_ = statistics;
+		if (statistics_) ++statistics_->connectionCount;
+	}
+
 private:
 	void startOperation()
 	{
 		// start a read operation if the third party library wants one.
 		if (session_.isReadyToReceive() && !isReceiving_)
 		{
-			isReceiving_ = true;
-#if defined(__GNUC__)
-			boost::shared_ptr<TcpSocketConnectionUsingSession<session_type> > pp = this->shared_from_this();
-#else
-			boost::shared_ptr<TcpSocketConnectionUsingSession<session_type> > pp = shared_from_this();
-#endif
+			isReceiving_ = true;
+			if (statistics_) ++statistics_->pendingOperationCount;
 			socket_.async_read_some(
 				boost::asio::null_buffers(),
-				boost::bind(&TcpSocketConnectionUsingSession::completeReceiving, pp, boost::asio::placeholders::error)
+				strand_.wrap(boost::bind(&TcpSocketConnectionUsingSession::completeReceiving, this->shared_from_this(), boost::asio::placeholders::error))
 			);
 		}
 
@@ -114,13 +133,10 @@ private:
 		if (session_.isReadyToSend() && !isSending_)
 		{
 			isSending_ = true;
+			if (statistics_) ++statistics_->pendingOperationCount;
 			socket_.async_write_some(
-				boost::asio::null_buffers(),
-#if defined(__GNUC__)
-				boost::bind(&TcpSocketConnectionUsingSession::completeSending, this->shared_from_this(), boost::asio::placeholders::error)
-#else
-				boost::bind(&TcpSocketConnectionUsingSession::completeSending, shared_from_this(), boost::asio::placeholders::error)
-#endif
+				boost::asio::null_buffers(),
+				strand_.wrap(boost::bind(&TcpSocketConnectionUsingSession::completeSending, this->shared_from_this(), boost::asio::placeholders::error))
 			);
 		}
 	}
@@ -131,7 +147,12 @@ private:
 
 		// notify third party library that it can perform a write.
 		if (!ec)
+		{
+			const unsigned long long sentByteCount = session_.getSentByteCount();
 			session_.send(ec);
+			if (statistics_) statistics_->sentByteCount += session_.getSentByteCount() - sentByteCount;
+		}
+		if (statistics_) --statistics_->pendingOperationCount;
 
 		// the third party library successfully performed a write on the socket.
 		// start new read or write operations based on what it now wants.
@@ -149,7 +170,12 @@ private:
 
 		// notify third party library that it can perform a read.
 		if (!ec)
+		{
+			const unsigned long long receivedByteCount = session_.getReceivedByteCount();
 			session_.receive(ec);
+			if (statistics_) statistics_->receivedByteCount += session_.getReceivedByteCount() - receivedByteCount;
+		}
+		if (statistics_) --statistics_->pendingOperationCount;
 
 		// the third party library successfully performed a read on the socket.
 		// start new read or write operations based on what it now wants.
@@ -163,11 +189,14 @@ private:
 
 private:
 	boost::asio::ip::tcp::socket socket_;
+	boost::asio::io_service::strand strand_;
 
 	session_type session_;
 
 	bool isReceiving_;
 	bool isSending_;
+
+	IoServiceStatistics *statistics_;
 };
 
 }  // namespace swl
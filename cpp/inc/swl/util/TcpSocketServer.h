@@ -2,6 +2,7 @@
 #define __SWL_UTIL__TCP_SOCKET_SERVER__H_ 1
 
 
+#include "swl/util/IoServicePool.h"
 #include <boost/asio.hpp>
 #include <boost/bind.hpp>
 
@@ -31,6 +32,10 @@ namespace swl {
  *			- static pointer create(boost::asio::io_service &ioService);
  *			- boost::asio::ip::tcp::socket & getSocket(); and/or const boost::asio::ip::tcp::socket & getSocket() const;
  *			- void start();
+ *			- void setStatistics(IoServiceStatistics *statistics);  (IoServicePool ϴ )
+ *
+ *	IoServicePool ϴ  accept connection pool I/O service鿡  Ҵǰ  thread ķ óȴ.
+ *	connection Ҵ I/O service counter Ѵ.
  */
 template<typename Connection>
 class TcpSocketServer
@@ -48,10 +53,23 @@ public:
 	 *	TCP socket connection ü ʱȭ ϰ  port Ǵ client  û ٸ.
 	 */
 	TcpSocketServer(boost::asio::io_service &ioService, const unsigned short portNum)
-	: acceptor_(ioService, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), portNum))
+	: acceptor_(ioService, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), portNum)), ioServicePool_(NULL)
 	{
 		startAccepting();
 	}
+	/**
+	 *	@brief  [ctor] constructor.
+	 *	@param[in]  ioServicePool  accept connection ó I/O service pool.
+	 *	@param[in]  portNum  TCP socket   server openϴ port ȣ.
+	 *
+	 *	client  û pool ù° I/O service ٸ,
+	 *	accept connection pool assignment policy  õ I/O service óȴ.
+	 */
+	TcpSocketServer(IoServicePool &ioServicePool, const unsigned short portNum)
+	: acceptor_(ioServicePool.getIoService(0), boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), portNum)), ioServicePool_(&ioServicePool)
+	{
+		startAcceptingInPool();
+	}
 
 private:
 	void startAccepting()
@@ -73,8 +91,31 @@ private:
 		}
 	}
 
+	void startAcceptingInPool()
+	{
+		const std::size_t index = ioServicePool_->selectIoService();
+		typename connection_type::pointer newConnection = connection_type::create(ioServicePool_->getIoService(index));
+
+		acceptor_.async_accept(
+			newConnection->getSocket(),
+			boost::bind(&TcpSocketServer::handleAcceptingInPool, this, newConnection, index, boost::asio::placeholders::error)
+		);
+	}
+
+	void handleAcceptingInPool(typename connection_type::pointer newConnection, const std::size_t index, const boost::system::error_code &ec)
+	{
+		if (!ec)
+		{
+			newConnection->setStatistics(&ioServicePool_->getStatistics(index));
+			// the handlers of the connection have to run on its own I/O service.
+			ioServicePool_->getIoService(index).post(boost::bind(&connection_type::start, newConnection));
+			startAcceptingInPool();
+		}
+	}
+
 private:
 	boost::asio::ip::tcp::acceptor acceptor_;
+	IoServicePool *ioServicePool_;
 };
 
 }  // namespace swl
@@ -5,11 +5,13 @@
 #include "swl/util/ExportUtil.h"
 #include "swl/util/GuardedBuffer.h"
 #include <boost/asio.hpp>
-#include <boost/array.hpp>
 
 
 namespace swl {
 
+class FrameParser;
+struct IFrameHandler;
+
 //-----------------------------------------------------------------------------------
 //
 
@@ -123,15 +125,53 @@ public:
 	 */
 	std::size_t getReceiveBufferSize() const;
 
+	/**
+	 *	@brief  set the maximum length of a message sent by one write operation.
+	 *
+	 *	the message is written directly from the segments of the send buffer.
+	 */
+	void setMaxSendLength(const std::size_t len)  {  maxSendLength_ = len;  }
+	std::size_t getMaxSendLength() const  {  return maxSendLength_;  }
+	/**
+	 *	@brief  set the maximum length of a message received by one read operation.
+	 *
+	 *	the message is read directly into the segments of the receive buffer.
+	 */
+	void setMaxReceiveLength(const std::size_t len)  {  maxReceiveLength_ = len;  }
+	std::size_t getMaxReceiveLength() const  {  return maxReceiveLength_;  }
+
+	/**
+	 *	@brief  the total number of bytes written by writeSendBuffer() & read by readReceiveBuffer().
+	 */
+	unsigned long long getSentByteCount() const  {  return sentByteCount_;  }
+	unsigned long long getReceivedByteCount() const  {  return receivedByteCount_;  }
+
 protected:
 	/**
-	 *	@brief    ۽    ִ message ִ .
+	 *	@brief  write at most maxSendLength_ values from the segments of the send buffer without a staging copy.
+	 *	@return  the length of the sent message. it has to be popped from the send buffer.
 	 */
-	static const std::size_t MAX_SEND_LENGTH_ = 512;
+	std::size_t writeSendBuffer(boost::system::error_code &ec);
 	/**
-	 *	@brief        ִ message ִ .
+	 *	@brief  read at most maxReceiveLength_ values directly into the free space of the receive buffer.
+	 *	@return  the length of the received message. it's already pushed into the receive buffer.
 	 */
-	static const std::size_t MAX_RECEIVE_LENGTH_ = 512;
+	std::size_t readReceiveBuffer(boost::system::error_code &ec);
+	/**
+	 *	@brief  extract the complete frames from the receive buffer & hand them to the handler.
+	 *	@return  the number of the handled frames.
+	 */
+	std::size_t receiveFrames(FrameParser &parser, IFrameHandler &handler);
+
+protected:
+	/**
+	 *	@brief    ۽    ִ message ⺻ ִ .
+	 */
+	static const std::size_t DEFAULT_MAX_SEND_LENGTH_ = 65536;
+	/**
+	 *	@brief        ִ message ⺻ ִ .
+	 */
+	static const std::size_t DEFAULT_MAX_RECEIVE_LENGTH_ = 65536;
 
 	/**
 	 *	@brief  TCP socket   ϴ Boost.ASIO socket ü.
@@ -155,17 +195,17 @@ protected:
 	 */
 	GuardedByteBuffer receiveBuffer_;
 	/**
-	 *	@brief    ۽  ϰ  message ϴ buffer.
-	 *
-	 *	buffer ̴ MAX_SEND_LENGTH_̴.
+	 *	@brief    ۽    ִ message ִ .
 	 */
-	boost::array<GuardedByteBuffer::value_type, MAX_SEND_LENGTH_> sendMsg_;
+	std::size_t maxSendLength_;
 	/**
-	 *	@brief      ϰ  message ϴ buffer.
-	 *
-	 *	buffer ̴ MAX_RECEIVE_LENGTH_̴.
+	 *	@brief        ִ message ִ .
 	 */
-	boost::array<GuardedByteBuffer::value_type, MAX_RECEIVE_LENGTH_> receiveMsg_;
+	std::size_t maxReceiveLength_;
+
+private:
+	unsigned long long sentByteCount_;
+	unsigned long long receivedByteCount_;
 };
 
 }  // namespace swl
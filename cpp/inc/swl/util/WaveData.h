@@ -5,6 +5,7 @@
 #include "swl/util/ExportUtil.h"
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <cstdio>
 #include <cassert>
 
@@ -101,7 +102,8 @@ size_t WaveData::readAllChannelData(const size_t startSampleIdx, std::vector<std
 {
 	if (!isOpened() || allChannelData.empty() || allChannelData.size() != getNumberOfChannels()) return 0;
 	const size_t sampleSize = sizeof(SampleType);
-	assert(getBytesPerSample() == sampleSize);
+	// blockAlign comes from the file. A frame has to be exactly one SampleType per channel, or it'd overflow the block below.
+	if (getBlockAlign() != getNumberOfChannels() * sampleSize) return 0;
 
 	const size_t &numSamples = allChannelData[0].size();
 	for (size_t ch = 1; ch < getNumberOfChannels(); ++ch)
@@ -109,6 +111,22 @@ size_t WaveData::readAllChannelData(const size_t startSampleIdx, std::vector<std
 
 	std::fseek(fp_, long(headerSize_ + startSampleIdx * getBlockAlign()), SEEK_SET);
 #if 1
+	// Read a block of frames at a time. swl::MappedWaveReader avoids stdio altogether.
+	const size_t numChannels = getNumberOfChannels();
+	const size_t blockFrames = 4096;
+	std::vector<SampleType> block(blockFrames * numChannels);
+	for (size_t idx = 0; idx < numSamples; )
+	{
+		const size_t numFramesRead = std::fread(&block[0], getBlockAlign(), std::min(blockFrames, numSamples - idx), fp_);
+		for (size_t i = 0; i < numFramesRead; ++i)
+			for (size_t ch = 0; ch < numChannels; ++ch)
+				allChannelData[ch][idx + i] = block[i * numChannels + ch];
+		idx += numFramesRead;
+		if (0 == numFramesRead) return idx;
+	}
+
+	return numSamples;
+#elif 0
 	SampleType sample;
 	size_t numSamplesRead;
 	for (size_t idx = 0; idx < numSamples; ++idx)
@@ -150,12 +168,28 @@ size_t WaveData::readChannelData(const size_t channel, const size_t startSampleI
 {
 	if (!isOpened() || channel >= getNumberOfChannels()) return 0;
 	const size_t sampleSize = sizeof(SampleType);
-	assert(getBytesPerSample() == sampleSize);
+	// blockAlign comes from the file. A frame has to be exactly one SampleType per channel, or it'd overflow the block below.
+	if (getBlockAlign() != getNumberOfChannels() * sampleSize) return 0;
 
 	const size_t &numSamples = channelData.size();
 
 	std::fseek(fp_, long(headerSize_ + startSampleIdx * getBlockAlign()), SEEK_SET);
 #if 1
+	// Read a block of frames at a time. swl::MappedWaveReader avoids stdio altogether.
+	const size_t numChannels = getNumberOfChannels();
+	const size_t blockFrames = 4096;
+	std::vector<SampleType> block(blockFrames * numChannels);
+	for (size_t idx = 0; idx < numSamples; )
+	{
+		const size_t numFramesRead = std::fread(&block[0], getBlockAlign(), std::min(blockFrames, numSamples - idx), fp_);
+		for (size_t i = 0; i < numFramesRead; ++i)
+			channelData[idx + i] = block[i * numChannels + channel];
+		idx += numFramesRead;
+		if (0 == numFramesRead) return idx;
+	}
+
+	return numSamples;
+#elif 0
 	SampleType sample;
 	size_t numSamplesRead;
 	for (size_t idx = 0; idx < numSamples; ++idx)
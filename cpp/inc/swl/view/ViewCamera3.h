@@ -168,6 +168,10 @@ public:
 	/// ==> OpenGL Red Book(p. 96)
 	bool mapWindowToObject(const double ptWin[3], double ptObj[3]) const;
 
+	/// get the vertices of the view frustum in object coordinates
+	/// vertices[i] = ( i & 1 ? right : left, i & 2 ? top : bottom, i & 4 ? far : near )
+	bool getFrustumVertices(double vertices[8][3]) const;
+
 	/// update the camera
 	/*virtual*/ bool update()  {  return doUpdateFrustum();  }
 
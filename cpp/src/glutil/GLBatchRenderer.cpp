@@ -0,0 +1,458 @@
+#include "swl/Config.h"
+#include "swl/glutil/GLBatchRenderer.h"
+#include "swl/glutil/GLShape.h"
+#include "swl/glutil/GLRayCastPicker.h"
+#include "swl/graphics/TriangleMesh.h"
+#include "swl/graphics/ObjectPickerMgr.h"
+#if defined(_WIN64) || defined(WIN64) || defined(_WIN32) || defined(WIN32)
+#include <windows.h>
+#else
+#define GL_GLEXT_PROTOTYPES 1
+#endif
+#include <GL/gl.h>
+#include <cstddef>
+#include <cmath>
+#include <cassert>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+#if !defined(APIENTRY)
+#define APIENTRY
+#endif
+#if !defined(GL_ARRAY_BUFFER)
+#define GL_ARRAY_BUFFER 0x8892
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#define GL_STATIC_DRAW 0x88E4
+#endif
+
+
+namespace swl {
+
+namespace {
+
+// OpenGL 1.4 & 1.5 entry points which are not exported by opengl32.dll
+struct BufferObjectApi
+{
+	typedef void (APIENTRY *gen_buffers_type)(GLsizei n, GLuint *buffers);
+	typedef void (APIENTRY *delete_buffers_type)(GLsizei n, const GLuint *buffers);
+	typedef void (APIENTRY *bind_buffer_type)(GLenum target, GLuint buffer);
+	typedef void (APIENTRY *buffer_data_type)(GLenum target, std::ptrdiff_t size, const GLvoid *data, GLenum usage);
+	typedef void (APIENTRY *buffer_sub_data_type)(GLenum target, std::ptrdiff_t offset, std::ptrdiff_t size, const GLvoid *data);
+	typedef void (APIENTRY *multi_draw_elements_type)(GLenum mode, const GLsizei *count, GLenum type, const GLvoid * const *indices, GLsizei drawcount);
+
+	BufferObjectApi()
+	: genBuffers(NULL), deleteBuffers(NULL), bindBuffer(NULL), bufferData(NULL), bufferSubData(NULL), multiDrawElements(NULL)
+	{}
+
+	void load()
+	{
+		*this = BufferObjectApi();
+
+		// the entry points may exist even though the version of the context is lower.
+		const char *version = reinterpret_cast<const char *>(glGetString(GL_VERSION));
+		if (!version || version[0] < '1' || ('1' == version[0] && '.' == version[1] && version[2] < '4'))
+			return;
+
+#if defined(_WIN64) || defined(WIN64) || defined(_WIN32) || defined(WIN32)
+		// the addresses depend on the current rendering context.
+		multiDrawElements = (multi_draw_elements_type)wglGetProcAddress("glMultiDrawElements");
+#else
+		multiDrawElements = (multi_draw_elements_type)&glMultiDrawElements;
+#endif
+		if ('1' == version[0] && '.' == version[1] && version[2] < '5')
+			return;
+
+#if defined(_WIN64) || defined(WIN64) || defined(_WIN32) || defined(WIN32)
+		genBuffers = (gen_buffers_type)wglGetProcAddress("glGenBuffers");
+		deleteBuffers = (delete_buffers_type)wglGetProcAddress("glDeleteBuffers");
+		bindBuffer = (bind_buffer_type)wglGetProcAddress("glBindBuffer");
+		bufferData = (buffer_data_type)wglGetProcAddress("glBufferData");
+		bufferSubData = (buffer_sub_data_type)wglGetProcAddress("glBufferSubData");
+#else
+		genBuffers = (gen_buffers_type)&glGenBuffers;
+		deleteBuffers = (delete_buffers_type)&glDeleteBuffers;
+		bindBuffer = (bind_buffer_type)&glBindBuffer;
+		bufferData = (buffer_data_type)&glBufferData;
+		bufferSubData = (buffer_sub_data_type)&glBufferSubData;
+#endif
+	}
+
+	bool isBufferObjectSupported() const
+	{  return genBuffers && deleteBuffers && bindBuffer && bufferData && bufferSubData;  }
+
+	gen_buffers_type genBuffers;
+	delete_buffers_type deleteBuffers;
+	bind_buffer_type bindBuffer;
+	buffer_data_type bufferData;
+	buffer_sub_data_type bufferSubData;
+	multi_draw_elements_type multiDrawElements;
+};
+
+BufferObjectApi bufferObjectApi;
+
+GLenum toGLPolygonFace(const attrib::PolygonFace drawingFace)
+{
+	return attrib::POLYGON_FACE_FRONT == drawingFace ? GL_FRONT :
+		(attrib::POLYGON_FACE_BACK == drawingFace ? GL_BACK :
+		(attrib::POLYGON_FACE_FRONT_AND_BACK == drawingFace ? GL_FRONT_AND_BACK :
+		(attrib::POLYGON_FACE_NONE == drawingFace ? GL_NONE : GL_FRONT)));
+}
+
+GLenum toGLPolygonMode(const attrib::PolygonMode polygonMode)
+{
+	return attrib::POLYGON_FILL == polygonMode ? GL_FILL :
+		(attrib::POLYGON_LINE == polygonMode ? GL_LINE :
+		(attrib::POLYGON_POINT == polygonMode ? GL_POINT : GL_FILL));
+}
+
+unsigned char toByte(const float c)
+{
+	return c <= 0.0f ? 0 : (c >= 1.0f ? 255 : (unsigned char)(c * 255.0f + 0.5f));
+}
+
+bool isRendered(const GLShape &shape, const GLRenderSceneVisitor::RenderMode renderMode)
+{
+	return shape.isVisible() && (GLRenderSceneVisitor::RENDER_TRANSPARENT_OBJECTS == renderMode) == shape.isTransparent();
+}
+
+}  // unnamed namespace
+
+//--------------------------------------------------------------------------
+// class GLBatchRenderer
+
+GLBatchRenderer::GLBatchRenderer()
+: instances_(), batches_(), unbatchedInstances_(), vertices_(), indices_(), vertexBufferId_(0u), indexBufferId_(0u), drawCallCount_(0)
+{
+}
+
+GLBatchRenderer::~GLBatchRenderer()
+{
+	// the buffers can't be deleted without a current rendering context. release() has to be called before.
+	assert(0u == vertexBufferId_);
+}
+
+void GLBatchRenderer::build(const node_type &root)
+{
+	release();
+	if (!root) return;
+
+	// invisible shapes are batched as well. they are skipped at draw time.
+	root->accept(GLCollectShapeVisitor(instances_, true, true));
+
+	for (size_t i = 0; i < instances_.size(); ++i)
+	{
+		const TriangleMesh *mesh = instances_[i].shape->getTriangleMesh();
+		if (mesh && !mesh->isEmpty())
+			packShape(i);
+		else
+			unbatchedInstances_.push_back(i);
+	}
+
+	for (std::vector<Batch>::const_iterator itBatch = batches_.begin(); itBatch != batches_.end(); ++itBatch)
+		for (std::vector<BatchedShape>::const_iterator it = itBatch->shapes.begin(); it != itBatch->shapes.end(); ++it)
+			fillColor(*it);
+
+	if (vertices_.empty()) return;
+
+	bufferObjectApi.load();
+	if (!bufferObjectApi.isBufferObjectSupported()) return;
+
+	GLuint bufferIds[2] = { 0u, 0u };
+	bufferObjectApi.genBuffers(2, bufferIds);
+	vertexBufferId_ = bufferIds[0];
+	indexBufferId_ = bufferIds[1];
+
+	bufferObjectApi.bindBuffer(GL_ARRAY_BUFFER, vertexBufferId_);
+	bufferObjectApi.bufferData(GL_ARRAY_BUFFER, std::ptrdiff_t(vertices_.size() * sizeof(Vertex)), &vertices_[0], GL_STATIC_DRAW);
+	bufferObjectApi.bindBuffer(GL_ARRAY_BUFFER, 0u);
+	bufferObjectApi.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBufferId_);
+	bufferObjectApi.bufferData(GL_ELEMENT_ARRAY_BUFFER, std::ptrdiff_t(indices_.size() * sizeof(unsigned int)), &indices_[0], GL_STATIC_DRAW);
+	bufferObjectApi.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0u);
+
+	// the indices are kept only in the buffer.
+	std::vector<unsigned int>().swap(indices_);
+}
+
+void GLBatchRenderer::release()
+{
+	if (0u != vertexBufferId_)
+	{
+		const GLuint bufferIds[2] = { vertexBufferId_, indexBufferId_ };
+		bufferObjectApi.deleteBuffers(2, bufferIds);
+		vertexBufferId_ = indexBufferId_ = 0u;
+	}
+
+	instances_.clear();
+	batches_.clear();
+	unbatchedInstances_.clear();
+	vertices_.clear();
+	indices_.clear();
+	drawCallCount_ = 0;
+}
+
+size_t GLBatchRenderer::getBatchedShapeCount() const
+{
+	size_t count = 0;
+	for (std::vector<Batch>::const_iterator it = batches_.begin(); it != batches_.end(); ++it)
+		count += it->shapes.size();
+	return count;
+}
+
+void GLBatchRenderer::packShape(const size_t instanceIndex)
+{
+	const GLShapeInstance &instance = instances_[instanceIndex];
+	const GLShape &shape = *instance.shape;
+	const TriangleMesh &mesh = *shape.getTriangleMesh();
+
+	// find the batch of the render states of the shape
+	const bool hasNormals = mesh.hasNormals();
+	std::vector<Batch>::iterator itBatch = batches_.begin();
+	for (; itBatch != batches_.end(); ++itBatch)
+		if (itBatch->isTransparent == shape.isTransparent() && itBatch->polygonMode == shape.getPolygonMode() &&
+			itBatch->drawingFace == shape.getDrawingFace() && itBatch->hasNormals == hasNormals)
+			break;
+	if (batches_.end() == itBatch)
+	{
+		batches_.push_back(Batch());
+		itBatch = batches_.end() - 1;
+		itBatch->isTransparent = shape.isTransparent();
+		itBatch->polygonMode = shape.getPolygonMode();
+		itBatch->drawingFace = shape.getDrawingFace();
+		itBatch->hasNormals = hasNormals;
+	}
+
+	BatchedShape batchedShape;
+	batchedShape.instance = instanceIndex;
+	batchedShape.firstVertex = vertices_.size();
+	batchedShape.vertexCount = mesh.getVertexCount();
+	batchedShape.firstIndex = indices_.size();
+	batchedShape.indexCount = 3 * mesh.getTriangleCount();
+
+	// vertices are transformed into object coordinates & normals by the inverse transpose of the transform
+	const GLShapeInstance::transform_type &T = instance.transform;
+	const GLShapeInstance::transform_type invT(hasNormals ? T.inverse() : GLShapeInstance::transform_type());
+	const std::vector<TriangleMesh::value_type> &positions = mesh.getVertices();
+	const std::vector<TriangleMesh::value_type> &normals = mesh.getNormals();
+	vertices_.resize(batchedShape.firstVertex + batchedShape.vertexCount);
+	for (size_t i = 0; i < batchedShape.vertexCount; ++i)
+	{
+		Vertex &vertex = vertices_[batchedShape.firstVertex + i];
+
+		const double x = positions[3 * i], y = positions[3 * i + 1], z = positions[3 * i + 2];
+		vertex.position[0] = float(T.X().x() * x + T.Y().x() * y + T.Z().x() * z + T.T().x());
+		vertex.position[1] = float(T.X().y() * x + T.Y().y() * y + T.Z().y() * z + T.T().y());
+		vertex.position[2] = float(T.X().z() * x + T.Y().z() * y + T.Z().z() * z + T.T().z());
+
+		if (hasNormals)
+		{
+			const double nx = normals[3 * i], ny = normals[3 * i + 1], nz = normals[3 * i + 2];
+			double n[3] = {
+				invT.X().x() * nx + invT.X().y() * ny + invT.X().z() * nz,
+				invT.Y().x() * nx + invT.Y().y() * ny + invT.Y().z() * nz,
+				invT.Z().x() * nx + invT.Z().y() * ny + invT.Z().z() * nz,
+			};
+			const double norm = std::sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+			if (norm > 0.0)
+			{
+				n[0] /= norm;  n[1] /= norm;  n[2] /= norm;
+			}
+			vertex.normal[0] = float(n[0]);  vertex.normal[1] = float(n[1]);  vertex.normal[2] = float(n[2]);
+		}
+		else
+		{
+			vertex.normal[0] = vertex.normal[1] = 0.0f;
+			vertex.normal[2] = 1.0f;
+		}
+	}
+
+	const std::vector<TriangleMesh::index_type> &indices = mesh.getIndices();
+	const unsigned int base = (unsigned int)batchedShape.firstVertex;
+	indices_.reserve(batchedShape.firstIndex + batchedShape.indexCount);
+	for (size_t i = 0; i < batchedShape.indexCount; ++i)
+		indices_.push_back(base + indices[i]);
+
+	itBatch->shapes.push_back(batchedShape);
+}
+
+void GLBatchRenderer::fillColor(const BatchedShape &batchedShape)
+{
+	const GLShape &shape = *instances_[batchedShape.instance].shape;
+	const ObjectPickerMgr &pickerMgr = ObjectPickerMgr::getInstance();
+	const ObjectPickerMgr::object_id_type id = GLRayCastPicker::getObjectId(&shape);
+
+	// the same colors as the ones used by shapes drawn one by one
+	ObjectPickerMgr::color_type color(shape.red(), shape.green(), shape.blue(), shape.alpha());
+	if (pickerMgr.isPicking() && pickerMgr.isTemporarilyPickedObject(id))
+		color = pickerMgr.getTemporarilyPickedColor();
+	else if (pickerMgr.isPickedObject(id))
+		color = pickerMgr.getPickedColor();
+
+	const unsigned char rgba[4] = { toByte(color.r), toByte(color.g), toByte(color.b), toByte(color.a) };
+	for (size_t i = batchedShape.firstVertex; i < batchedShape.firstVertex + batchedShape.vertexCount; ++i)
+	{
+		vertices_[i].color[0] = rgba[0];  vertices_[i].color[1] = rgba[1];
+		vertices_[i].color[2] = rgba[2];  vertices_[i].color[3] = rgba[3];
+	}
+}
+
+void GLBatchRenderer::updateColors()
+{
+	for (std::vector<Batch>::const_iterator itBatch = batches_.begin(); itBatch != batches_.end(); ++itBatch)
+		for (std::vector<BatchedShape>::const_iterator it = itBatch->shapes.begin(); it != itBatch->shapes.end(); ++it)
+			fillColor(*it);
+
+	if (0u == vertexBufferId_ || vertices_.empty()) return;
+
+	bufferObjectApi.bindBuffer(GL_ARRAY_BUFFER, vertexBufferId_);
+	bufferObjectApi.bufferSubData(GL_ARRAY_BUFFER, 0, std::ptrdiff_t(vertices_.size() * sizeof(Vertex)), &vertices_[0]);
+	bufferObjectApi.bindBuffer(GL_ARRAY_BUFFER, 0u);
+}
+
+void GLBatchRenderer::render(const RenderMode renderMode, const bool isPickingState /*= false*/) const
+{
+	drawCallCount_ = 0;
+
+	const bool isTransparentRendered = GLRenderSceneVisitor::RENDER_TRANSPARENT_OBJECTS == renderMode;
+	bool isBatchRendered = false;
+	for (std::vector<Batch>::const_iterator it = batches_.begin(); it != batches_.end(); ++it)
+		if (it->isTransparent == isTransparentRendered)
+		{
+			isBatchRendered = true;
+			break;
+		}
+
+	if (isBatchRendered)
+	{
+		glPushAttrib(GL_ENABLE_BIT | GL_POLYGON_BIT | GL_LIGHTING_BIT);
+		glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+
+		// offsets into the buffer objects or addresses of the client-side arrays
+		const char *vertexBase = NULL;
+		if (0u != vertexBufferId_)
+		{
+			bufferObjectApi.bindBuffer(GL_ARRAY_BUFFER, vertexBufferId_);
+			bufferObjectApi.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBufferId_);
+		}
+		else vertexBase = reinterpret_cast<const char *>(&vertices_[0]);
+
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glVertexPointer(3, GL_FLOAT, sizeof(Vertex), vertexBase + offsetof(Vertex, position));
+		glEnableClientState(GL_COLOR_ARRAY);
+		glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), vertexBase + offsetof(Vertex, color));
+		glNormalPointer(GL_FLOAT, sizeof(Vertex), vertexBase + offsetof(Vertex, normal));
+
+		// the vertex colors drive the material as glColor*() does for shapes drawn one by one
+		glColorMaterial(GL_FRONT_AND_BACK, GL_AMBIENT_AND_DIFFUSE);
+		glEnable(GL_COLOR_MATERIAL);
+
+		for (std::vector<Batch>::const_iterator it = batches_.begin(); it != batches_.end(); ++it)
+			if (it->isTransparent == isTransparentRendered)
+				drawBatch(*it, isPickingState);
+
+		if (0u != vertexBufferId_)
+		{
+			bufferObjectApi.bindBuffer(GL_ARRAY_BUFFER, 0u);
+			bufferObjectApi.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0u);
+		}
+
+		glPopClientAttrib();
+		glPopAttrib();
+	}
+
+	// shapes without a triangle mesh
+	for (std::vector<size_t>::const_iterator it = unbatchedInstances_.begin(); it != unbatchedInstances_.end(); ++it)
+	{
+		const GLShapeInstance &instance = instances_[*it];
+		if (!isRendered(*instance.shape, renderMode)) continue;
+
+		double tmat[16] = { 0.0, };
+		instance.transform.get(tmat);
+
+		glPushMatrix();
+			glMultMatrixd(tmat);
+			isPickingState || !instance.shape->isDisplayListUsed() ? instance.shape->draw() : instance.shape->callDisplayList();
+		glPopMatrix();
+		++drawCallCount_;
+	}
+}
+
+void GLBatchRenderer::drawBatch(const Batch &batch, const bool isPickingState) const
+{
+	const GLenum drawingFace = toGLPolygonFace(batch.drawingFace);
+	if (GL_NONE != drawingFace) glPolygonMode(drawingFace, toGLPolygonMode(batch.polygonMode));
+
+	if (batch.hasNormals)
+	{
+		glEnableClientState(GL_NORMAL_ARRAY);
+	}
+	else
+	{
+		glDisableClientState(GL_NORMAL_ARRAY);
+		glNormal3f(0.0f, 0.0f, 1.0f);
+	}
+
+	const char *indexBase = 0u != indexBufferId_ ? NULL : reinterpret_cast<const char *>(&indices_[0]);
+
+	if (isPickingState)
+	{
+		// each shape is drawn with its own name
+		for (std::vector<BatchedShape>::const_iterator it = batch.shapes.begin(); it != batch.shapes.end(); ++it)
+		{
+			const GLShape &shape = *instances_[it->instance].shape;
+			if (!shape.isVisible() || !shape.isPickable()) continue;
+
+			glPushName(GLRayCastPicker::getObjectId(&shape));
+				glDrawElements(GL_TRIANGLES, GLsizei(it->indexCount), GL_UNSIGNED_INT, indexBase + it->firstIndex * sizeof(unsigned int));
+			glPopName();
+			++drawCallCount_;
+		}
+		return;
+	}
+
+	// merge the index ranges of adjacent visible shapes into runs
+	std::vector<GLsizei> counts;
+	std::vector<const GLvoid *> offsets;
+	size_t runFirst = 0, runCount = 0;
+	for (std::vector<BatchedShape>::const_iterator it = batch.shapes.begin(); it != batch.shapes.end(); ++it)
+	{
+		if (!instances_[it->instance].shape->isVisible()) continue;
+
+		if (runCount > 0 && runFirst + runCount == it->firstIndex)
+			runCount += it->indexCount;
+		else
+		{
+			if (runCount > 0)
+			{
+				counts.push_back(GLsizei(runCount));
+				offsets.push_back(indexBase + runFirst * sizeof(unsigned int));
+			}
+			runFirst = it->firstIndex;
+			runCount = it->indexCount;
+		}
+	}
+	if (runCount > 0)
+	{
+		counts.push_back(GLsizei(runCount));
+		offsets.push_back(indexBase + runFirst * sizeof(unsigned int));
+	}
+	if (counts.empty()) return;
+
+	if (bufferObjectApi.multiDrawElements)
+	{
+		bufferObjectApi.multiDrawElements(GL_TRIANGLES, &counts[0], GL_UNSIGNED_INT, &offsets[0], GLsizei(counts.size()));
+		++drawCallCount_;
+	}
+	else
+	{
+		for (size_t i = 0; i < counts.size(); ++i)
+			glDrawElements(GL_TRIANGLES, counts[i], GL_UNSIGNED_INT, offsets[i]);
+		drawCallCount_ += counts.size();
+	}
+}
+
+}  // namespace swl
@@ -0,0 +1,48 @@
+#include "swl/Config.h"
+#include "swl/glutil/GLCollectShapeVisitor.h"
+#include "swl/glutil/GLShapeSceneNode.h"
+#include "swl/graphics/TransformSceneNode.h"
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace swl {
+
+//--------------------------------------------------------------------------
+// class GLCollectShapeVisitor
+
+GLCollectShapeVisitor::GLCollectShapeVisitor(std::vector<GLShapeInstance> &instances, const bool isInvisibleCollected /*= false*/, const bool isUnpickableCollected /*= true*/)
+: instances_(instances), isInvisibleCollected_(isInvisibleCollected), isUnpickableCollected_(isUnpickableCollected), transforms_(1, transform_type())
+{
+}
+
+void GLCollectShapeVisitor::visit(const shape_node_type &node) const
+{
+	const shape_node_type::shape_type &shape = node.getShape();
+	if (!shape) return;
+
+	if (!isInvisibleCollected_ && !shape->isVisible()) return;
+	if (!isUnpickableCollected_ && !shape->isPickable()) return;
+
+	instances_.push_back(GLShapeInstance());
+	GLShapeInstance &instance = instances_.back();
+	instance.shape = shape;
+	instance.transform = transforms_.back();
+
+	shape_node_type::bound_type bound;
+	instance.isBoundKnown = node.getBound(bound);
+	if (instance.isBoundKnown) instance.bound = bound.transform(instance.transform);
+}
+
+void GLCollectShapeVisitor::visit(const transform_node_type &node) const
+{
+	transforms_.push_back(transforms_.back() * node.getTransform());
+	node.traverse(*this);
+	transforms_.pop_back();
+}
+
+}  // namespace swl
@@ -0,0 +1,89 @@
+#include "swl/Config.h"
+#include "swl/glutil/GLCullingRenderSceneVisitor.h"
+#include "swl/glutil/GLShapeSceneNode.h"
+#include "swl/graphics/AppearanceSceneNode.h"
+#include "swl/graphics/GeometrySceneNode.h"
+#include "swl/graphics/TransformSceneNode.h"
+#include "swl/view/ViewCamera3.h"
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace swl {
+
+namespace {
+
+bool calcFrustum(const ViewCamera3 &camera, Frustum<double> &frustum)
+{
+	double vertices[8][3];
+	if (!camera.getFrustumVertices(vertices)) return false;
+	frustum.set(vertices);
+	return true;
+}
+
+}  // unnamed namespace
+
+//--------------------------------------------------------------------------
+// class GLCullingRenderSceneVisitor
+
+GLCullingRenderSceneVisitor::GLCullingRenderSceneVisitor(const RenderMode renderMode, const frustum_type &frustum, const bool isPickingState /*= false*/)
+: base_type(renderMode, isPickingState),
+  frustum_(frustum), isFrustumValid_(true), transforms_(1, transform_type()), culledCount_(0)
+{
+}
+
+GLCullingRenderSceneVisitor::GLCullingRenderSceneVisitor(const RenderMode renderMode, const ViewCamera3 &camera, const bool isPickingState /*= false*/)
+: base_type(renderMode, isPickingState),
+  frustum_(), isFrustumValid_(calcFrustum(camera, frustum_)), transforms_(1, transform_type()), culledCount_(0)
+{
+}
+
+template<typename Node>
+bool GLCullingRenderSceneVisitor::isCulled(const Node &node) const
+{
+	if (!isFrustumValid_) return false;
+
+	// a partial bound says nothing about the unbounded nodes below. the bounded ones are culled one by one.
+	typename Node::bound_type bound;
+	if (!node.getBound(bound) || node.hasUnboundedDescendants()) return false;
+
+	if (frustum_.isCulled(bound.transform(transforms_.back())))
+	{
+		++culledCount_;
+		return true;
+	}
+	return false;
+}
+
+void GLCullingRenderSceneVisitor::visit(const appearance_node_type &node) const
+{
+	base_type::visit(node);
+}
+
+void GLCullingRenderSceneVisitor::visit(const geometry_node_type &node) const
+{
+	if (isCulled(node)) return;
+	base_type::visit(node);
+}
+
+void GLCullingRenderSceneVisitor::visit(const shape_node_type &node) const
+{
+	if (isCulled(node)) return;
+	base_type::visit(node);
+}
+
+void GLCullingRenderSceneVisitor::visit(const transform_node_type &node) const
+{
+	// the bound of a transform node is expressed in the coordinates of its parent.
+	if (isCulled(node)) return;
+
+	transforms_.push_back(transforms_.back() * node.getTransform());
+	base_type::visit(node);
+	transforms_.pop_back();
+}
+
+}  // namespace swl
@@ -0,0 +1,67 @@
+#include "swl/Config.h"
+#include "swl/glutil/GLMeshGeometry.h"
+#if defined(_WIN64) || defined(WIN64) || defined(_WIN32) || defined(WIN32)
+#include <windows.h>
+#endif
+#include <GL/gl.h>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace swl {
+
+//--------------------------------------------------------------------------
+// class GLMeshGeometry
+
+GLMeshGeometry::GLMeshGeometry()
+: base_type(),
+  mesh_()
+{
+}
+
+GLMeshGeometry::GLMeshGeometry(const TriangleMesh &mesh)
+: base_type(),
+  mesh_(mesh)
+{
+}
+
+GLMeshGeometry::GLMeshGeometry(const GLMeshGeometry &rhs)
+: base_type(rhs),
+  mesh_(rhs.mesh_)
+{
+}
+
+GLMeshGeometry::~GLMeshGeometry()
+{
+}
+
+GLMeshGeometry & GLMeshGeometry::operator=(const GLMeshGeometry &rhs)
+{
+	if (this == &rhs) return *this;
+	static_cast<base_type &>(*this) = rhs;
+	mesh_ = rhs.mesh_;
+	return *this;
+}
+
+void GLMeshGeometry::draw() const
+{
+	if (mesh_.isEmpty()) return;
+
+	glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glVertexPointer(3, GL_FLOAT, 0, &mesh_.getVertices()[0]);
+		if (mesh_.hasNormals())
+		{
+			glEnableClientState(GL_NORMAL_ARRAY);
+			glNormalPointer(GL_FLOAT, 0, &mesh_.getNormals()[0]);
+		}
+
+		glDrawElements(GL_TRIANGLES, GLsizei(3 * mesh_.getTriangleCount()), GL_UNSIGNED_INT, &mesh_.getIndices()[0]);
+	glPopClientAttrib();
+}
+
+}  // namespace swl
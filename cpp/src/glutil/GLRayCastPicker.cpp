@@ -0,0 +1,180 @@
+#include "swl/Config.h"
+#include "swl/glutil/GLRayCastPicker.h"
+#include "swl/glutil/GLShape.h"
+#include "swl/graphics/TriangleMesh.h"
+#include "swl/view/ViewCamera3.h"
+#include <limits>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace swl {
+
+namespace {
+
+struct ShapeIntersector
+{
+	ShapeIntersector(const std::vector<GLShapeInstance> &instances, const std::vector<GLShapeInstance::transform_type> &inverseTransforms, const std::vector<GLShapeInstance::bound_type> &localBounds, const std::vector<size_t> &boundedInstances)
+	: instances_(instances), inverseTransforms_(inverseTransforms), localBounds_(localBounds), boundedInstances_(boundedInstances), instance(0)
+	{}
+
+	bool operator()(const size_t item, const Ray<double> &ray, double &tHit)
+	{
+		const size_t idx = boundedInstances_[item];
+		// the parameter of a ray is kept by the affine map.
+		const Ray<double> localRay(ray.transform(inverseTransforms_[idx]));
+
+		double t = tHit;
+		const TriangleMesh *mesh = instances_[idx].shape->getTriangleMesh();
+		if (mesh && !mesh->isEmpty())
+		{
+			if (!mesh->intersect(localRay, t)) return false;
+		}
+		else if (!localRay.intersect(localBounds_[idx], 0.0, tHit, t))
+			return false;
+
+		tHit = t;
+		instance = idx;
+		return true;
+	}
+
+private:
+	const std::vector<GLShapeInstance> &instances_;
+	const std::vector<GLShapeInstance::transform_type> &inverseTransforms_;
+	const std::vector<GLShapeInstance::bound_type> &localBounds_;
+	const std::vector<size_t> &boundedInstances_;
+
+public:
+	size_t instance;
+};
+
+}  // unnamed namespace
+
+//--------------------------------------------------------------------------
+// class GLRayCastPicker
+
+GLRayCastPicker::GLRayCastPicker()
+: instances_(), inverseTransforms_(), localBounds_(), boundedInstances_(), hierarchy_()
+{
+}
+
+void GLRayCastPicker::build(const node_type &root)
+{
+	clear();
+	if (!root) return;
+
+	root->accept(GLCollectShapeVisitor(instances_, false, false));
+
+	inverseTransforms_.resize(instances_.size());
+	localBounds_.resize(instances_.size());
+	std::vector<GLShapeInstance::bound_type> bounds;
+	bounds.reserve(instances_.size());
+	for (size_t i = 0; i < instances_.size(); ++i)
+	{
+		const GLShapeInstance &instance = instances_[i];
+		if (!instance.isBoundKnown || !instance.shape->getBound(localBounds_[i])) continue;
+
+		inverseTransforms_[i] = instance.transform.inverse();
+		boundedInstances_.push_back(i);
+		bounds.push_back(instance.bound);
+	}
+
+	hierarchy_.build(bounds);
+}
+
+void GLRayCastPicker::clear()
+{
+	instances_.clear();
+	inverseTransforms_.clear();
+	localBounds_.clear();
+	boundedInstances_.clear();
+	hierarchy_.clear();
+}
+
+bool GLRayCastPicker::pick(const ray_type &ray, Hit &hit) const
+{
+	ShapeIntersector intersector(instances_, inverseTransforms_, localBounds_, boundedInstances_);
+	double t = std::numeric_limits<double>::max();
+	if (!hierarchy_.intersect(ray, intersector, t)) return false;
+
+	hit.shape = instances_[intersector.instance].shape;
+	hit.objectId = getObjectId(hit.shape.get());
+	hit.t = t;
+	ray.getPoint(t, hit.point);
+	return true;
+}
+
+bool GLRayCastPicker::pick(const ViewCamera3 &camera, const int x, const int y, Hit &hit) const
+{
+	ray_type ray;
+	return calcPickingRay(camera, x, y, ray) && pick(ray, hit);
+}
+
+bool GLRayCastPicker::pickObject(const ViewCamera3 &camera, const int x, const int y, const bool isTemporary /*= false*/) const
+{
+	Hit hit;
+	return updatePickedObjects(pick(camera, x, y, hit) ? hit.objectId : 0u, isTemporary);
+}
+
+/*static*/ bool GLRayCastPicker::updatePickedObjects(const object_id_type pickedObj, const bool isTemporary)
+{
+	ObjectPickerMgr &pickerMgr = ObjectPickerMgr::getInstance();
+	if (isTemporary)
+	{
+		if (0u == pickedObj && pickerMgr.containTemporarilyPickedObject())
+		{
+			pickerMgr.clearAllTemporarilyPickedObjects();
+			return true;
+		}
+		else if (0u != pickedObj && !pickerMgr.isTemporarilyPickedObject(pickedObj))
+		{
+			pickerMgr.clearAllTemporarilyPickedObjects();
+			pickerMgr.addTemporarilyPickedObject(pickedObj);
+			return true;
+		}
+	}
+	else
+	{
+		const bool isTemporarilyPickedObj = pickerMgr.isTemporarilyPickedObject(pickedObj);
+		pickerMgr.clearAllTemporarilyPickedObjects();
+
+		if (0u == pickedObj && pickerMgr.containPickedObject())
+		{
+			pickerMgr.clearAllPickedObjects();
+			return true;
+		}
+		else if (0u != pickedObj && !pickerMgr.isPickedObject(pickedObj))
+		{
+			pickerMgr.clearAllPickedObjects();
+			pickerMgr.addPickedObject(pickedObj);
+			return !isTemporarilyPickedObj;
+		}
+	}
+
+	return false;
+}
+
+/*static*/ bool GLRayCastPicker::calcPickingRay(const ViewCamera3 &camera, const int x, const int y, ray_type &ray)
+{
+	const double ptNearWin[3] = { double(x), double(y), -1.0 }, ptFarWin[3] = { double(x), double(y), 1.0 };
+	double ptNear[3], ptFar[3];
+	if (!camera.mapWindowToObject(ptNearWin, ptNear) || !camera.mapWindowToObject(ptFarWin, ptFar))
+		return false;
+
+	// t = 0 at the near plane & t = 1 at the far plane
+	const double dir[3] = { ptFar[0] - ptNear[0], ptFar[1] - ptNear[1], ptFar[2] - ptNear[2] };
+	ray.set(ptNear, dir);
+	return true;
+}
+
+/*static*/ GLRayCastPicker::object_id_type GLRayCastPicker::getObjectId(const GLShape *shape)
+{
+	// a shape pushes its address on the name stack.
+	return object_id_type(reinterpret_cast<size_t>(shape));
+}
+
+}  // namespace swl
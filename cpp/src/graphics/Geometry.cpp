@@ -1,5 +1,6 @@
 #include "swl/Config.h"
 #include "swl/graphics/Geometry.h"
+#include "swl/graphics/TriangleMesh.h"
 
 
 #if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
@@ -34,4 +35,15 @@ Geometry & Geometry::operator=(const Geometry &rhs)
 	return *this;
 }
 
+bool Geometry::getBound(BoundingBox<double> &bound) const
+{
+	const TriangleMesh *mesh = getTriangleMesh();
+	return mesh ? mesh->getBound(bound) : false;
+}
+
+const TriangleMesh * Geometry::getTriangleMesh() const
+{
+	return NULL;
+}
+
 }  // namespace swl
@@ -43,4 +43,16 @@ Shape::geometry_type Shape::getGeometry() const
 	return GeometryPoolMgr::getInstance().getGeometry(geometryId_);
 }
 
+bool Shape::getBound(BoundingBox<double> &bound) const
+{
+	const geometry_type &geometry = getGeometry();
+	return geometry ? geometry->getBound(bound) : false;
+}
+
+const TriangleMesh * Shape::getTriangleMesh() const
+{
+	const geometry_type &geometry = getGeometry();
+	return geometry ? geometry->getTriangleMesh() : NULL;
+}
+
 }  // namespace swl
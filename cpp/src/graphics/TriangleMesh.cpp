@@ -0,0 +1,167 @@
+#include "swl/Config.h"
+#include "swl/graphics/TriangleMesh.h"
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace swl {
+
+namespace {
+
+struct TriangleIntersector
+{
+	TriangleIntersector(const std::vector<TriangleMesh::value_type> &vertices, const std::vector<TriangleMesh::index_type> &indices)
+	: vertices_(vertices), indices_(indices), triangle(0)
+	{}
+
+	bool operator()(const size_t tri, const Ray<double> &ray, double &tHit)
+	{
+		const TriangleMesh::value_type *v0 = &vertices_[3 * indices_[3 * tri]];
+		const TriangleMesh::value_type *v1 = &vertices_[3 * indices_[3 * tri + 1]];
+		const TriangleMesh::value_type *v2 = &vertices_[3 * indices_[3 * tri + 2]];
+
+		double t;
+		if (ray.intersect(v0, v1, v2, t) && t <= tHit)
+		{
+			tHit = t;
+			triangle = tri;
+			return true;
+		}
+		return false;
+	}
+
+private:
+	const std::vector<TriangleMesh::value_type> &vertices_;
+	const std::vector<TriangleMesh::index_type> &indices_;
+
+public:
+	size_t triangle;
+};
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------------------
+// class TriangleMesh
+
+TriangleMesh::TriangleMesh()
+: vertices_(), normals_(), indices_(), isHierarchyDirty_(true), hierarchy_()
+{
+}
+
+TriangleMesh::TriangleMesh(const std::vector<value_type> &vertices, const std::vector<index_type> &indices)
+: vertices_(vertices), normals_(), indices_(indices), isHierarchyDirty_(true), hierarchy_()
+{
+}
+
+TriangleMesh::TriangleMesh(const TriangleMesh &rhs)
+: vertices_(rhs.vertices_), normals_(rhs.normals_), indices_(rhs.indices_), isHierarchyDirty_(rhs.isHierarchyDirty_), hierarchy_(rhs.hierarchy_)
+{
+}
+
+TriangleMesh::~TriangleMesh()
+{
+}
+
+TriangleMesh & TriangleMesh::operator=(const TriangleMesh &rhs)
+{
+	if (this == &rhs) return *this;
+	vertices_ = rhs.vertices_;
+	normals_ = rhs.normals_;
+	indices_ = rhs.indices_;
+	isHierarchyDirty_ = rhs.isHierarchyDirty_;
+	hierarchy_ = rhs.hierarchy_;
+	return *this;
+}
+
+void TriangleMesh::setVertices(const std::vector<value_type> &vertices)
+{
+	vertices_ = vertices;
+	invalidate();
+}
+
+void TriangleMesh::setNormals(const std::vector<value_type> &normals)
+{
+	normals_ = normals;
+}
+
+void TriangleMesh::setIndices(const std::vector<index_type> &indices)
+{
+	indices_ = indices;
+	invalidate();
+}
+
+void TriangleMesh::clear()
+{
+	vertices_.clear();
+	normals_.clear();
+	indices_.clear();
+	invalidate();
+}
+
+bool TriangleMesh::getBound(bound_type &bound) const
+{
+	if (vertices_.size() < 3) return false;
+
+	double lower[3] = { vertices_[0], vertices_[1], vertices_[2] };
+	double upper[3] = { lower[0], lower[1], lower[2] };
+	for (size_t i = 3; i + 2 < vertices_.size(); i += 3)
+		for (int j = 0; j < 3; ++j)
+		{
+			if (vertices_[i + j] < lower[j]) lower[j] = vertices_[i + j];
+			else if (vertices_[i + j] > upper[j]) upper[j] = vertices_[i + j];
+		}
+
+	bound.set(lower, upper);
+	return true;
+}
+
+bool TriangleMesh::intersect(const Ray<double> &ray, double &tHit, size_t *triangle /*= NULL*/) const
+{
+	if (isEmpty()) return false;
+
+	prepareHierarchy();
+
+	TriangleIntersector intersector(vertices_, indices_);
+	if (!hierarchy_.intersect(ray, intersector, tHit)) return false;
+
+	if (triangle) *triangle = intersector.triangle;
+	return true;
+}
+
+void TriangleMesh::invalidate()
+{
+	isHierarchyDirty_ = true;
+	hierarchy_.clear();
+}
+
+void TriangleMesh::prepareHierarchy() const
+{
+	if (!isHierarchyDirty_) return;
+
+	const size_t triangleCount = getTriangleCount();
+	std::vector<bound_type> bounds;
+	bounds.reserve(triangleCount);
+	for (size_t tri = 0; tri < triangleCount; ++tri)
+	{
+		double lower[3], upper[3];
+		for (int k = 0; k < 3; ++k)
+		{
+			const value_type *v = &vertices_[3 * indices_[3 * tri + k]];
+			for (int j = 0; j < 3; ++j)
+			{
+				if (0 == k || v[j] < lower[j]) lower[j] = v[j];
+				if (0 == k || v[j] > upper[j]) upper[j] = v[j];
+			}
+		}
+		bounds.push_back(bound_type(lower, upper));
+	}
+
+	hierarchy_.build(bounds);
+	isHierarchyDirty_ = false;
+}
+
+}  // namespace swl
@@ -0,0 +1,333 @@
+#include "swl/Config.h"
+#include "swl/machine_vision/GraphBasedImageSegmentation.h"
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <stdexcept>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+// the rows of a tile of the edge construction.
+const int TILE_ROWS = 32;
+// the kernel half-width in units of sigma, as in the original implementation.
+const float KERNEL_WIDTH = 4.0f;
+const float SQRT_2 = 1.41421356f;
+
+// maps a float to an unsigned integer of the same order.
+inline unsigned int toRadixKey(const float w)
+{
+	unsigned int bits;
+	std::memcpy(&bits, &w, sizeof(bits));
+	return bits ^ ((unsigned int)-(int)(bits >> 31) | 0x80000000u);
+}
+
+inline float square(const float x)
+{
+	return x * x;
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+
+//--------------------------------------------------------------------------
+// Graph-based Image Segmentation.
+
+GraphBasedImageSegmentation::GraphBasedImageSegmentation(const float sigma /*= 0.5f*/, const float k /*= 500.0f*/, const int minSize /*= 50*/)
+: sigma_(std::max(sigma, 0.01f)), k_(k), minSize_(minSize), width_(0), height_(0), innerCount_(0), outerCount_(0)
+{
+	// the Gaussian kernel, normalized so that the symmetric kernel integrates to one.
+	const int len = (int)std::ceil(sigma_ * local::KERNEL_WIDTH) + 1;
+	kernel_.resize(len);
+	float sum = 0.0f;
+	for (int i = 0; i < len; ++i)
+	{
+		kernel_[i] = std::exp(-0.5f * local::square(float(i) / sigma_));
+		sum += (0 == i ? 1.0f : 2.0f) * kernel_[i];
+	}
+	for (int i = 0; i < len; ++i)
+		kernel_[i] /= sum;
+}
+
+int GraphBasedImageSegmentation::segment(const cv::Mat &rgb, cv::Mat &labels)
+{
+	prepare(rgb);
+
+	const int tileCount = (height_ + local::TILE_ROWS - 1) / local::TILE_ROWS;
+#pragma omp parallel for schedule(dynamic)
+	for (int tile = 0; tile < tileCount; ++tile)
+		buildEdges(tile, NULL);
+
+	sortEdges();
+	return segmentGraph(labels);
+}
+
+int GraphBasedImageSegmentation::segment(const cv::Mat &rgb, const cv::Mat &depth, const cv::Mat &mask, const float lambdaValid, const float lambdaInvalid, const float lambdaBoundary, const float fx, const float fy, cv::Mat &labels)
+{
+	if (CV_16UC1 != depth.type() || CV_8UC1 != mask.type() || depth.size() != rgb.size() || mask.size() != rgb.size())
+		throw std::invalid_argument("the depth image & the mask have to be CV_16UC1 & CV_8UC1 images of the size of the color image");
+
+	prepare(rgb);
+
+	DepthParameters params;
+	params.depth = &depth;
+	params.mask = &mask;
+	params.lambdas[0] = lambdaValid;
+	params.lambdas[1] = lambdaInvalid;
+	params.lambdas[2] = lambdaBoundary;
+	params.fx = fx;
+	params.fy = fy;
+
+	const int tileCount = (height_ + local::TILE_ROWS - 1) / local::TILE_ROWS;
+#pragma omp parallel for schedule(dynamic)
+	for (int tile = 0; tile < tileCount; ++tile)
+		buildEdges(tile, &params);
+
+	sortEdges();
+	return segmentGraph(labels);
+}
+
+void GraphBasedImageSegmentation::prepare(const cv::Mat &rgb)
+{
+	if (CV_8UC3 != rgb.type() || rgb.empty())
+		throw std::invalid_argument("the color image has to be a non-empty CV_8UC3 image");
+
+	if (rgb.cols != width_ || rgb.rows != height_)
+	{
+		width_ = rgb.cols;
+		height_ = rgb.rows;
+		const std::size_t pixelCount = (std::size_t)width_ * height_;
+		const std::size_t tileCount = (height_ + local::TILE_ROWS - 1) / local::TILE_ROWS;
+
+		channels_.resize(3 * pixelCount);
+		buffer_.resize(pixelCount);
+		tileEdges_.resize(4 * pixelCount);
+		edges_.resize(4 * pixelCount);
+		innerCounts_.resize(tileCount);
+		outerCounts_.resize(tileCount);
+		parents_.resize(pixelCount);
+		sizes_.resize(pixelCount);
+		thresholds_.resize(pixelCount);
+	}
+
+	smooth(rgb);
+}
+
+void GraphBasedImageSegmentation::smooth(const cv::Mat &rgb)
+{
+	const int len = (int)kernel_.size();
+	const std::size_t pixelCount = (std::size_t)width_ * height_;
+	for (int c = 0; c < 3; ++c)
+	{
+		// horizontal pass.
+#pragma omp parallel for
+		for (int y = 0; y < height_; ++y)
+		{
+			const unsigned char *src = rgb.ptr<unsigned char>(y) + c;
+			float *dst = &buffer_[(std::size_t)y * width_];
+			for (int x = 0; x < width_; ++x)
+			{
+				float sum = kernel_[0] * src[3 * x];
+				for (int i = 1; i < len; ++i)
+					sum += kernel_[i] * (float(src[3 * std::max(x - i, 0)]) + float(src[3 * std::min(x + i, width_ - 1)]));
+				dst[x] = sum;
+			}
+		}
+
+		// vertical pass, row by row for contiguous access.
+		float *channel = &channels_[c * pixelCount];
+#pragma omp parallel for
+		for (int y = 0; y < height_; ++y)
+		{
+			float *dst = channel + (std::size_t)y * width_;
+			const float *src = &buffer_[(std::size_t)y * width_];
+			for (int x = 0; x < width_; ++x)
+				dst[x] = kernel_[0] * src[x];
+			for (int i = 1; i < len; ++i)
+			{
+				const float *above = &buffer_[(std::size_t)std::max(y - i, 0) * width_];
+				const float *below = &buffer_[(std::size_t)std::min(y + i, height_ - 1) * width_];
+				const float w = kernel_[i];
+				for (int x = 0; x < width_; ++x)
+					dst[x] += w * (above[x] + below[x]);
+			}
+		}
+	}
+}
+
+void GraphBasedImageSegmentation::buildEdges(const int tile, const DepthParameters *params)
+{
+	const std::size_t pixelCount = (std::size_t)width_ * height_;
+	const float *red = &channels_[0], *green = &channels_[pixelCount], *blue = &channels_[2 * pixelCount];
+
+	const int firstRow = tile * local::TILE_ROWS, lastRow = std::min(firstRow + local::TILE_ROWS, height_);
+	Edge *inner = &tileEdges_[4 * (std::size_t)firstRow * width_];
+	Edge *outer = &tileEdges_[0] + 4 * (std::size_t)lastRow * width_;
+	int innerCount = 0, outerCount = 0;
+
+	// the neighbors to the right, below, below right & above right.
+	const int dxs[4] = { 1, 0, 1, 1 }, dys[4] = { 0, 1, 1, -1 };
+	const float distances[4] = { 1.0f, 1.0f, local::SQRT_2, local::SQRT_2 };
+
+	for (int y = firstRow; y < lastRow; ++y)
+		for (int x = 0; x < width_; ++x)
+		{
+			const int a = y * width_ + x;
+			const unsigned char sa = params ? params->mask->ptr<unsigned char>(y)[x] : (unsigned char)VALID_DEPTH;
+			for (int n = 0; n < 4; ++n)
+			{
+				const int x2 = x + dxs[n], y2 = y + dys[n];
+				if (x2 >= width_ || y2 < 0 || y2 >= height_) continue;
+
+				const int b = y2 * width_ + x2;
+				Edge edge;
+				edge.a = a;
+				edge.b = b;
+				edge.w = std::sqrt(local::square(red[a] - red[b]) + local::square(green[a] - green[b]) + local::square(blue[a] - blue[b]));
+				if (!params)
+				{
+					inner[innerCount++] = edge;
+					continue;
+				}
+
+				const unsigned char sb = params->mask->ptr<unsigned char>(y2)[x2];
+				if (sa != sb)
+				{
+					*--outer = edge;
+					++outerCount;
+				}
+				else if (VALID_DEPTH == sa)
+				{
+					const float z1 = params->depth->ptr<unsigned short>(y)[x], z2 = params->depth->ptr<unsigned short>(y2)[x2];
+					edge.w += params->lambdas[0] * std::sqrt(local::square((z1 * x - z2 * x2) / params->fx) + local::square((z1 * y - z2 * y2) / params->fy) + local::square(z1 - z2));
+					inner[innerCount++] = edge;
+				}
+				else
+				{
+					edge.w += params->lambdas[INVALID_DEPTH == sa ? 1 : 2] * distances[n];
+					inner[innerCount++] = edge;
+				}
+			}
+		}
+
+	innerCounts_[tile] = innerCount;
+	outerCounts_[tile] = outerCount;
+}
+
+void GraphBasedImageSegmentation::sortEdges()
+{
+	// merge the tiles.
+	const int tileCount = (int)innerCounts_.size();
+	innerCount_ = outerCount_ = 0;
+	for (int tile = 0; tile < tileCount; ++tile)
+		innerCount_ += innerCounts_[tile];
+	std::size_t innerOffset = 0;
+	for (int tile = 0; tile < tileCount; ++tile)
+	{
+		const std::size_t first = 4 * (std::size_t)tile * local::TILE_ROWS * width_;
+		const std::size_t last = 4 * (std::size_t)std::min((tile + 1) * local::TILE_ROWS, height_) * width_;
+		std::copy(tileEdges_.begin() + first, tileEdges_.begin() + first + innerCounts_[tile], edges_.begin() + innerOffset);
+		std::reverse_copy(tileEdges_.begin() + last - outerCounts_[tile], tileEdges_.begin() + last, edges_.begin() + innerCount_ + outerCount_);
+		innerOffset += innerCounts_[tile];
+		outerCount_ += outerCounts_[tile];
+	}
+
+	// LSD radix sort of the inner edges, a byte at a time, with tileEdges_ as the other buffer.
+	// a pass is skipped when all the keys have the same byte.
+	std::size_t histograms[4][256];
+	std::memset(histograms, 0, sizeof(histograms));
+	for (std::size_t i = 0; i < innerCount_; ++i)
+	{
+		const unsigned int key = local::toRadixKey(edges_[i].w);
+		++histograms[0][key & 0xFF];
+		++histograms[1][(key >> 8) & 0xFF];
+		++histograms[2][(key >> 16) & 0xFF];
+		++histograms[3][key >> 24];
+	}
+
+	Edge *src = &edges_[0], *dst = &tileEdges_[0];
+	for (int pass = 0; pass < 4; ++pass)
+	{
+		std::size_t *histogram = histograms[pass];
+		const int shift = 8 * pass;
+		if (0 == innerCount_ || innerCount_ == histogram[(local::toRadixKey(src[0].w) >> shift) & 0xFF]) continue;
+
+		std::size_t offset = 0;
+		for (int i = 0; i < 256; ++i)
+		{
+			const std::size_t count = histogram[i];
+			histogram[i] = offset;
+			offset += count;
+		}
+		for (std::size_t i = 0; i < innerCount_; ++i)
+			dst[histogram[(local::toRadixKey(src[i].w) >> shift) & 0xFF]++] = src[i];
+		std::swap(src, dst);
+	}
+	if (src != &edges_[0])
+		std::copy(src, src + innerCount_, edges_.begin());
+}
+
+int GraphBasedImageSegmentation::segmentGraph(cv::Mat &labels)
+{
+	const int pixelCount = width_ * height_;
+	for (int i = 0; i < pixelCount; ++i)
+	{
+		parents_[i] = i;
+		sizes_[i] = 1;
+		thresholds_[i] = k_;
+	}
+
+	// the edges in non-decreasing weight order.
+	for (std::size_t i = 0; i < innerCount_; ++i)
+	{
+		const Edge &edge = edges_[i];
+		const int a = find(edge.a), b = find(edge.b);
+		if (a != b && edge.w <= thresholds_[a] && edge.w <= thresholds_[b])
+		{
+			const int root = join(a, b);
+			thresholds_[root] = edge.w + k_ / sizes_[root];
+		}
+	}
+
+	// merge the small components, through the edges across the states last.
+	for (std::size_t i = 0; i < innerCount_ + outerCount_; ++i)
+	{
+		const int a = find(edges_[i].a), b = find(edges_[i].b);
+		if (a != b && (sizes_[a] < minSize_ || sizes_[b] < minSize_))
+			join(a, b);
+	}
+
+	// the sizes of the roots are replaced by the negative, one-based labels.
+	labels.create(height_, width_, CV_32SC1);
+	int count = 0;
+	for (int y = 0; y < height_; ++y)
+	{
+		int *label = labels.ptr<int>(y);
+		for (int x = 0; x < width_; ++x)
+		{
+			const int root = find(y * width_ + x);
+			if (sizes_[root] > 0) sizes_[root] = -++count;
+			label[x] = -sizes_[root] - 1;
+		}
+	}
+	return count;
+}
+
+int GraphBasedImageSegmentation::join(int a, int b)
+{
+	if (sizes_[a] < sizes_[b]) std::swap(a, b);
+	parents_[b] = a;
+	sizes_[a] += sizes_[b];
+	return a;
+}
+
+}  // namespace swl
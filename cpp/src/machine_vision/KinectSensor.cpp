@@ -4,6 +4,7 @@
 #include "swl/machine_vision/ImageRectificationUsingOpenCV.h"
 #define CV_NO_BACKWARD_COMPATIBILITY
 #include <opencv2/opencv.hpp>
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <iostream>
@@ -32,7 +33,8 @@ KinectSensor::KinectSensor(
   imageSize_ir_(imageSize_ir), imageSize_rgb_(imageSize_rgb),
   K_ir_(K_ir), K_rgb_(K_rgb),
   distCoeffs_ir_(distCoeffs_ir), distCoeffs_rgb_(distCoeffs_rgb),
-  R_(R), T_(T)
+  R_(R), T_(T),
+  rayX_(), rayY_(), rayZ_(), offsetX_(0.0f), offsetY_(0.0f), offsetZ_(0.0f)
 {
 }
 
@@ -74,8 +76,10 @@ void KinectSensor::prepareRectification()
 		imageUndistortionUsingOpenCV_rgb_.reset(new ImageUndistortionUsingOpenCV(imageSize_rgb_, K_rgb_, distCoeffs_rgb_));
 #endif
 
-		computeHomogeneousImageCoordinates(imageSize_ir_, K_ir_, distCoeffs_ir_, IC_homo_ir_, IC_homo_undist_ir_);
-		computeHomogeneousImageCoordinates(imageSize_rgb_, K_rgb_, distCoeffs_rgb_, IC_homo_rgb_, IC_homo_undist_rgb_);
+		computeUndistortionMaps(imageSize_ir_, K_ir_, distCoeffs_ir_, undistortionMap1_ir_, undistortionMap2_ir_);
+		computeUndistortionMaps(imageSize_rgb_, K_rgb_, distCoeffs_rgb_, undistortionMap1_rgb_, undistortionMap2_rgb_);
+		if (useIRtoRGB_)
+			prepareDepthProjection(imageSize_ir_, K_ir_, K_rgb_, R_, T_);
 	}
 }
 
@@ -152,6 +156,48 @@ void KinectSensor::computeHomogeneousImageCoordinates(const cv::Size &imageSize,
 	}
 }
 
+void KinectSensor::computeUndistortionMaps(const cv::Size &imageSize, const cv::Mat &K, const cv::Mat &distCoeffs, cv::Mat &map1, cv::Mat &map2)
+{
+	cv::Mat IC_homo, IC_homo_undist;
+	computeHomogeneousImageCoordinates(imageSize, K, distCoeffs, IC_homo, IC_homo_undist);
+
+	// The output pixel (x, y) is interpolated at (IC_homo_undist(0, idx), IC_homo_undist(1, idx)) of the input image, where idx = y * width + x.
+	// The maps are converted to fixed point once, so that cv::remap() needs no conversion per frame.
+	cv::Mat mapX, mapY;
+	IC_homo_undist.row(0).reshape(1, imageSize.height).convertTo(mapX, CV_32FC1);
+	IC_homo_undist.row(1).reshape(1, imageSize.height).convertTo(mapY, CV_32FC1);
+	cv::convertMaps(mapX, mapY, map1, map2, CV_16SC2);
+}
+
+// Rays of the left camera in the right camera, up to the depth.
+void KinectSensor::prepareDepthProjection(const cv::Size &imageSize_left, const cv::Mat &K_left, const cv::Mat &K_right, const cv::Mat &R, const cv::Mat &T)
+{
+	// A pixel (x, y) of depth d is at d * K_left^-1 * [x y 1]^T in the left camera,
+	// so it is projected by K_right * (R * d * K_left^-1 * [x y 1]^T + T) = d * (K_right * R * K_left^-1) * [x y 1]^T + K_right * T.
+	const cv::Mat K_left_inv(K_left.inv());
+	const cv::Mat M(K_right * R * K_left_inv);
+	const cv::Mat offset(K_right * T);
+
+	const std::size_t numPixels = (std::size_t)imageSize_left.width * imageSize_left.height;
+	rayX_.resize(numPixels);
+	rayY_.resize(numPixels);
+	rayZ_.resize(numPixels);
+	for (int y = 0; y < imageSize_left.height; ++y)
+		for (int x = 0; x < imageSize_left.width; ++x)
+		{
+			const std::size_t idx = (std::size_t)y * imageSize_left.width + x;
+			rayX_[idx] = (float)(M.at<double>(0, 0) * x + M.at<double>(0, 1) * y + M.at<double>(0, 2));
+			rayY_[idx] = (float)(M.at<double>(1, 0) * x + M.at<double>(1, 1) * y + M.at<double>(1, 2));
+			rayZ_[idx] = (float)(M.at<double>(2, 0) * x + M.at<double>(2, 1) * y + M.at<double>(2, 2));
+		}
+
+	offsetX_ = (float)offset.at<double>(0);
+	offsetY_ = (float)offset.at<double>(1);
+	offsetZ_ = (float)offset.at<double>(2);
+	for (int i = 0; i < 3; ++i)
+		depthScale_[i] = (float)K_left_inv.at<double>(2, i);
+}
+
 // [ref] rectify_kinect_images_using_depth() in ${CPP_RND_HOME}/test/machine_vision/opencv/opencv_image_rectification.cpp
 void KinectSensor::rectifyImagePairUsingDepth(const cv::Mat &ir_input_image, const cv::Mat &rgb_input_image, cv::Mat &ir_output_image, cv::Mat &rgb_output_image) const
 {
@@ -167,14 +213,14 @@ void KinectSensor::rectifyImagePairUsingDepth(const cv::Mat &ir_input_image, con
 #else
 
 #if 1
-		undistortImagePairUsingFormula<unsigned short>(ir_input_image, ir_input_image2, IC_homo_ir_, IC_homo_undist_ir_);
-		undistortImagePairUsingFormula<cv::Vec3b>(rgb_input_image, rgb_input_image2, IC_homo_rgb_, IC_homo_undist_rgb_);
+		cv::remap(ir_input_image, ir_input_image2, undistortionMap1_ir_, undistortionMap2_ir_, cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar::all(0));
+		cv::remap(rgb_input_image, rgb_input_image2, undistortionMap1_rgb_, undistortionMap2_rgb_, cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar::all(0));
 #else
-		undistortImagePairUsingFormula<unsigned short>(ir_input_image, ir_input_image2, IC_homo_ir_, IC_homo_undist_ir_);
+		cv::remap(ir_input_image, ir_input_image2, undistortionMap1_ir_, undistortionMap2_ir_, cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar::all(0));
 
 		cv::Mat rgb_input_gray_image;
 		cv::cvtColor(rgb_input_image, rgb_input_gray_image, CV_BGR2GRAY);
-		undistortImagePairUsingFormula<unsigned char>(rgb_input_gray_image, rgb_input_image2, IC_homo_rgb_, IC_homo_undist_rgb_);
+		cv::remap(rgb_input_gray_image, rgb_input_image2, undistortionMap1_rgb_, undistortionMap2_rgb_, cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar::all(0));
 #endif
 
 #endif  // __USE_OPENCV_UNDISTORTION
@@ -184,16 +230,12 @@ void KinectSensor::rectifyImagePairUsingDepth(const cv::Mat &ir_input_image, con
 	if (useIRtoRGB_)
 		rectifyImagePairFromIRToRGBUsingDepth(
 			ir_input_image2, rgb_input_image2, ir_output_image, rgb_output_image,
-			imageSize_ir_, imageSize_rgb_,
-			K_ir_, K_rgb_, R_, T_,
-			IC_homo_ir_
+			imageSize_rgb_
 		);
 	else
 		rectifyImagePairFromRGBToIRUsingDepth(
 			rgb_input_image2, ir_input_image2, rgb_output_image, ir_output_image,
-			imageSize_rgb_, imageSize_ir_,
-			K_rgb_, K_ir_, R_, T_,
-			IC_homo_rgb_
+			imageSize_ir_
 		);  // Not yet implemented.
 }
 
@@ -201,68 +243,47 @@ void KinectSensor::rectifyImagePairUsingDepth(const cv::Mat &ir_input_image, con
 // IR (left) to RGB (right).
 void KinectSensor::rectifyImagePairFromIRToRGBUsingDepth(
 	const cv::Mat &input_image_left, const cv::Mat &input_image_right, cv::Mat &output_image_left, cv::Mat &output_image_right,
-	const cv::Size &imageSize_left, const cv::Size &imageSize_right,
-	const cv::Mat &K_left, const cv::Mat &K_right, const cv::Mat &R, const cv::Mat &T,
-	const cv::Mat &IC_homo_left
+	const cv::Size &imageSize_right
 ) const
 {
-	// Homogeneous normalized camera coordinates (left).
-	const cv::Mat CC_norm_left(K_left.inv() * IC_homo_left);
-
-	// Camera coordinates (left).
-	cv::Mat CC_left;
-	{
-		cv::Mat tmp;
-#if 0
-		// 0 0 0 ...   0 1 1 1 ...   1 ... 639 639 639 ... 639.
-		// 0 1 2 ... 479 0 1 2 ... 479 ...   0   1   2 ... 479.
-
-		((cv::Mat)input_image_left.t()).convertTo(tmp, CV_64FC1, 1.0, 0.0);
-#else
-		// 0 1 2 ... 639 0 1 2 ... 639 ...   0   1   2 ... 639.
-		// 0 0 0 ...   0 1 1 1 ...   1 ... 479 479 479 ... 479.
-
-		input_image_left.convertTo(tmp, CV_64FC1, 1.0, 0.0);
-#endif
-		cv::repeat(tmp.reshape(1, 1), 3, 1, CC_left);
-		CC_left = CC_left.mul(CC_norm_left);
-	}
-
-	// Camera coordinates (right).
-	cv::Mat CC_right;
-#if 0
-	cv::repeat(T, 1, imageSize_left.width*imageSize_left.height, CC_right);
-	CC_right = R.t() * (CC_left - CC_right);
-#else
-	cv::repeat(T, 1, imageSize_left.width*imageSize_left.height, CC_right);
-	CC_right = R * CC_left + CC_right;
-#endif
-
-	// Homogeneous normalized camera coordinates (right).
-	cv::Mat CC_norm_right;
-	cv::repeat(CC_right(cv::Range(2, 3), cv::Range::all()), 3, 1, CC_norm_right);
-	CC_norm_right = CC_right / CC_norm_right;
-
-	// Homogeneous image coordinates (right).
-	const cv::Mat IC_homo_right(K_right * CC_norm_right);  // Zero-based coordinates.
+	if (CV_16UC1 != input_image_left.type() || (std::size_t)input_image_left.rows * input_image_left.cols != rayX_.size())
+		throw std::runtime_error("Invalid depth image");
 
 	// The left image is mapped onto the right image.
 	cv::Mat(input_image_right.size(), input_image_left.type(), cv::Scalar::all(0)).copyTo(output_image_left);
 	//output_image_left = cv::Mat::zeros(input_image_right.size(), input_image_left.type());
-#pragma omp parallel
-//#pragma omp parallel shared(a, b, c, d, loop_count, chunk) private(i)
-//#pragma omp parallel shared(a, b, c, d, loop_count, i, chunk)
+
+	// Only the depth changes per frame, so a row is projected by a loop without branches over the precomputed tables & then scattered.
+	// When pixels fall on the same pixel of the right image, the nearest one is kept.
+	const int width = input_image_left.cols, height = input_image_left.rows;
+	const float maxX = (float)imageSize_right.width - 0.5f, maxY = (float)imageSize_right.height - 0.5f;
+	const int stride = (int)output_image_left.step1();
+	unsigned short *output = output_image_left.ptr<unsigned short>(0);
+	std::vector<int> targets(width);
+	std::vector<unsigned short> depths(width);
+	for (int y = 0; y < height; ++y)
 	{
-#pragma omp for
-//#pragma omp for schedule(dynamic, 100) nowait
-		for (int idx = 0; idx < imageSize_left.height*imageSize_left.width; ++idx)
+		const unsigned short *depth = input_image_left.ptr<unsigned short>(y);
+		const float *rayX = &rayX_[(std::size_t)y * width], *rayY = &rayY_[(std::size_t)y * width], *rayZ = &rayZ_[(std::size_t)y * width];
+		const float rowScale = depthScale_[1] * y + depthScale_[2];
+		for (int x = 0; x < width; ++x)
 		{
-			const int &cc = (int)cvRound(IC_homo_right.at<double>(0,idx));
-			const int &rr = (int)cvRound(IC_homo_right.at<double>(1,idx));
-			if (0 <= cc && cc < imageSize_right.width && 0 <= rr && rr < imageSize_right.height)
-				output_image_left.at<unsigned short>(rr, cc) = (unsigned short)cvRound(CC_left.at<double>(2, idx));
+			const float d = depth[x];
+			const float w = d * rayZ[x] + offsetZ_;
+			const float u = (d * rayX[x] + offsetX_) / w, v = (d * rayY[x] + offsetY_) / w;
+			// No depth, behind the right camera or out of the right image.
+			const bool valid = d > 0.0f && w > 0.0f && u > -0.5f && u < maxX && v > -0.5f && v < maxY;
+			targets[x] = valid ? (int)(v + 0.5f) * stride + (int)(u + 0.5f) : -1;
+			depths[x] = (unsigned short)std::min(std::max(d * (depthScale_[0] * x + rowScale) + 0.5f, 0.0f), 65535.0f);
 		}
-	}
+
+		for (int x = 0; x < width; ++x)
+		{
+			if (targets[x] < 0) continue;
+			unsigned short &dst = output[targets[x]];
+			if (0 == dst || depths[x] < dst) dst = depths[x];
+		}
+	}
 
 	input_image_right.copyTo(output_image_right);
 }
@@ -271,9 +292,7 @@ void KinectSensor::rectifyImagePairFromIRToRGBUsingDepth(
 // RGB (left) to IR (right).
 void KinectSensor::rectifyImagePairFromRGBToIRUsingDepth(
 	const cv::Mat &input_image_left, const cv::Mat &input_image_right, cv::Mat &output_image_left, cv::Mat &output_image_right,
-	const cv::Size &imageSize_left, const cv::Size &imageSize_right,
-	const cv::Mat &K_left, const cv::Mat &K_right, const cv::Mat &R, const cv::Mat &T,
-	const cv::Mat &IC_homo_left
+	const cv::Size &imageSize_right
 ) const
 {
 	throw std::runtime_error("Not yet implemented");
@@ -207,6 +207,355 @@ void showVertices(cv::Mat& rgb, const std::string& windowName, const std::list<s
 	cv::imshow(windowName, rgb);
 }
 
+// Bit-packed thinning.
+//	Bit b of word i of a row is the pixel at x = 64 * i + b, & the rows are padded with a zero row above & below.
+
+typedef unsigned long long word_type;
+
+const int BITS_PER_WORD = 64;
+
+// The neighbors at x - 1 & x + 1, moved to x.
+inline word_type shiftWest(const word_type* row, const int i)
+{
+	return (row[i] << 1) | (i > 0 ? row[i - 1] >> (BITS_PER_WORD - 1) : 0);
+}
+
+inline word_type shiftEast(const word_type* row, const int i, const int wordsPerRow)
+{
+	return (row[i] >> 1) | (i + 1 < wordsPerRow ? row[i + 1] << (BITS_PER_WORD - 1) : 0);
+}
+
+// The bits set in exactly one & in at least two of the words.
+inline void countBits(const word_type* words, const int count, word_type& exactlyOne, word_type& atLeastTwo)
+{
+	word_type ones = 0, twos = 0;
+	for (int k = 0; k < count; ++k)
+	{
+		twos |= ones & words[k];
+		ones |= words[k];
+	}
+	exactlyOne = ones & ~twos;
+	atLeastTwo = twos;
+}
+
+// The pixels removed by a sub-iteration, from the neighbors p2 (north), p3 (north-east), ..., p9 (north-west).
+word_type getZhangSuenDeletion(const word_type p[10], const int iter)
+{
+	const word_type transitions[8] = { ~p[2] & p[3], ~p[3] & p[4], ~p[4] & p[5], ~p[5] & p[6], ~p[6] & p[7], ~p[7] & p[8], ~p[8] & p[9], ~p[9] & p[2] };
+	const word_type neighbors[8] = { p[2], p[3], p[4], p[5], p[6], p[7], p[8], p[9] };
+	const word_type nonNeighbors[8] = { ~p[2], ~p[3], ~p[4], ~p[5], ~p[6], ~p[7], ~p[8], ~p[9] };
+
+	word_type A1, dummy, B2, notB7;
+	countBits(transitions, 8, A1, dummy);  // A = 1.
+	countBits(neighbors, 8, dummy, B2);  // B >= 2.
+	countBits(nonNeighbors, 8, dummy, notB7);  // B <= 6.
+	const word_type m1 = 0 == iter ? (p[2] & p[4] & p[6]) : (p[2] & p[4] & p[8]);
+	const word_type m2 = 0 == iter ? (p[4] & p[6] & p[8]) : (p[2] & p[6] & p[8]);
+	return A1 & B2 & notB7 & ~m1 & ~m2;
+}
+
+word_type getGuoHallDeletion(const word_type p[10], const int iter)
+{
+	const word_type C[4] = { ~p[2] & (p[3] | p[4]), ~p[4] & (p[5] | p[6]), ~p[6] & (p[7] | p[8]), ~p[8] & (p[9] | p[2]) };
+	const word_type N1[4] = { p[9] | p[2], p[3] | p[4], p[5] | p[6], p[7] | p[8] };
+	const word_type N2[4] = { p[2] | p[3], p[4] | p[5], p[6] | p[7], p[8] | p[9] };
+
+	word_type C1, dummy, N1_2, N2_2;
+	countBits(C, 4, C1, dummy);  // C = 1.
+	countBits(N1, 4, dummy, N1_2);
+	countBits(N2, 4, dummy, N2_2);
+	const word_type N1_4 = N1[0] & N1[1] & N1[2] & N1[3], N2_4 = N2[0] & N2[1] & N2[2] & N2[3];
+	const word_type m = 0 == iter ? ((p[6] | p[7] | ~p[9]) & p[8]) : ((p[2] | p[3] | ~p[5]) & p[4]);
+	return C1 & N1_2 & N2_2 & ~(N1_4 & N2_4) & ~m;  // 2 <= min(N1, N2) <= 3.
+}
+
+// One sub-iteration from src to dst. Returns whether any pixel is removed.
+bool thinningIteration(const std::vector<word_type>& src, std::vector<word_type>& dst, const std::vector<word_type>& columnMask, const int rows, const int wordsPerRow, const swl::SkeletonAlgorithm::ThinningMethod method, const int iter)
+{
+	word_type changed = 0;
+#pragma omp parallel for reduction(|:changed)
+	for (int y = 1; y <= rows; ++y)
+	{
+		const word_type* above = &src[(y - 1) * wordsPerRow];
+		const word_type* curr = &src[y * wordsPerRow];
+		const word_type* below = &src[(y + 1) * wordsPerRow];
+		word_type* out = &dst[y * wordsPerRow];
+
+		// The first & the last rows of the image are kept.
+		if (1 == y || rows == y)
+		{
+			std::copy(curr, curr + wordsPerRow, out);
+			continue;
+		}
+
+		for (int i = 0; i < wordsPerRow; ++i)
+		{
+			if (!curr[i])
+			{
+				out[i] = 0;
+				continue;
+			}
+
+			word_type p[10];
+			p[2] = above[i];
+			p[3] = shiftEast(above, i, wordsPerRow);
+			p[4] = shiftEast(curr, i, wordsPerRow);
+			p[5] = shiftEast(below, i, wordsPerRow);
+			p[6] = below[i];
+			p[7] = shiftWest(below, i);
+			p[8] = shiftWest(curr, i);
+			p[9] = shiftWest(above, i);
+
+			const word_type deletion = curr[i] & columnMask[i] & (swl::SkeletonAlgorithm::ZHANG_SUEN == method ? getZhangSuenDeletion(p, iter) : getGuoHallDeletion(p, iter));
+			out[i] = curr[i] & ~deletion;
+			changed |= deletion;
+		}
+	}
+
+	return 0 != changed;
+}
+
+// Skeleton graph extraction.
+//	The skeleton is copied into a buffer padded by one pixel, so the neighbors of a pixel are at index + NEIGHBOR_OFFSETS[k].
+//	The neighbors are in the order of NEIGHBOR_COORDINATES, so the even ones are 4-connected.
+
+const size_t NEIGHBOR_SEARCH_ORDER[] = { 0, 2, 4, 6, 1, 3, 5, 7 };
+const float NEIGHBOR_DISTANCES[] = { 1.0f, 1.41421356f, 1.0f, 1.41421356f, 1.0f, 1.41421356f, 1.0f, 1.41421356f };
+
+// The number of the runs of neighbors around a pixel.
+struct NeighborGroupTable
+{
+public:
+	NeighborGroupTable()
+	{
+		for (int code = 0; code < 256; ++code)
+		{
+			int runs = 0;
+			for (int k = 0; k < (int)NUM_NEIGHBORS; ++k)
+				if ((code >> k) & 1 && !((code >> ((k + NUM_NEIGHBORS - 1) % NUM_NEIGHBORS)) & 1)) ++runs;
+			counts[code] = (unsigned char)(0xFF == code ? 1 : runs);
+		}
+	}
+
+public:
+	unsigned char counts[256];
+};
+
+const NeighborGroupTable NEIGHBOR_GROUP_TABLE;
+
+// Marks of the pixels in the padded buffer.
+const int UNVISITED = -1;
+const int VISITED = -2;
+
+// The neighbors not in the neighbor group of the neighbor k.
+inline unsigned int getOtherNeighbors(const unsigned int code, const size_t k)
+{
+	unsigned int group = 1u << k;
+	for (size_t i = 1; i < NUM_NEIGHBORS && ((code >> ((k + i) % NUM_NEIGHBORS)) & 1); ++i)
+		group |= 1u << ((k + i) % NUM_NEIGHBORS);
+	for (size_t i = 1; i < NUM_NEIGHBORS && ((code >> ((k + NUM_NEIGHBORS - i) % NUM_NEIGHBORS)) & 1); ++i)
+		group |= 1u << ((k + NUM_NEIGHBORS - i) % NUM_NEIGHBORS);
+	return code & ~group;
+}
+
+class SkeletonGraphBuilder
+{
+public:
+	SkeletonGraphBuilder(const cv::Mat& skeleton_bw, swl::SkeletonAlgorithm::SkeletonGraph& graph)
+	: graph_(graph), stride_(skeleton_bw.cols + 2), pixels_((size_t)(skeleton_bw.rows + 2) * (skeleton_bw.cols + 2), 0), marks_(pixels_.size(), UNVISITED)
+	{
+		for (size_t k = 0; k < NUM_NEIGHBORS; ++k)
+			offsets_[k] = NEIGHBOR_COORDINATES[k].y * stride_ + NEIGHBOR_COORDINATES[k].x;
+		for (int y = 0; y < skeleton_bw.rows; ++y)
+		{
+			const unsigned char* row = skeleton_bw.ptr<unsigned char>(y);
+			unsigned char* padded = &pixels_[(y + 1) * stride_ + 1];
+			for (int x = 0; x < skeleton_bw.cols; ++x)
+				padded[x] = row[x] ? 1 : 0;
+		}
+	}
+
+public:
+	void build()
+	{
+		graph_.clear();
+		graph_.branchOffsets.push_back(0);
+
+		// Nodes.
+		std::vector<int> nodePixels, nodeOffsets(1, 0);
+		for (int idx = stride_ + 1; idx < (int)pixels_.size() - stride_; ++idx)
+		{
+			if (!pixels_[idx] || UNVISITED != marks_[idx] || 2 == getGroupCount(idx)) continue;
+
+			// Adjacent junction pixels are a node.
+			const int node = addNode(idx);
+			marks_[idx] = node;
+			nodePixels.push_back(idx);
+			const bool isJunction = getGroupCount(idx) > 2;
+			for (size_t i = nodePixels.size() - 1; isJunction && i < nodePixels.size(); ++i)
+				for (size_t k = 0; k < NUM_NEIGHBORS; ++k)
+				{
+					const int neighbor = nodePixels[i] + offsets_[k];
+					if (pixels_[neighbor] && UNVISITED == marks_[neighbor] && getGroupCount(neighbor) > 2)
+					{
+						marks_[neighbor] = node;
+						nodePixels.push_back(neighbor);
+					}
+				}
+			nodeOffsets.push_back((int)nodePixels.size());
+		}
+
+		// Branches.
+		for (int node = 0; node + 1 < (int)nodeOffsets.size(); ++node)
+		{
+			const size_t firstBranch = graph_.branchLengths.size();
+			for (int i = nodeOffsets[node]; i < nodeOffsets[node + 1]; ++i)
+				traceBranches(nodePixels[i], firstBranch);
+		}
+
+		// Cycles without junctions.
+		for (int idx = stride_ + 1; idx < (int)pixels_.size() - stride_; ++idx)
+			if (pixels_[idx] && UNVISITED == marks_[idx])
+			{
+				marks_[idx] = addNode(idx);
+				traceBranches(idx, graph_.branchLengths.size());
+			}
+
+		// Node types.
+		std::vector<int> branchEnds(graph_.nodes.size(), 0);
+		for (size_t i = 0; i < graph_.branchNodes.size(); ++i)
+			++branchEnds[graph_.branchNodes[i]];
+		graph_.nodeTypes.resize(graph_.nodes.size());
+		for (size_t i = 0; i < graph_.nodes.size(); ++i)
+		{
+			const int count = branchEnds[i];
+			graph_.nodeTypes[i] = 0 == count ? swl::SkeletonAlgorithm::ISOLATED : (1 == count ? swl::SkeletonAlgorithm::LEAF_END : (2 == count ? swl::SkeletonAlgorithm::INTERNAL : (3 == count ? swl::SkeletonAlgorithm::BRANCH : swl::SkeletonAlgorithm::CROSS)));
+		}
+	}
+
+private:
+	unsigned int getNeighborCode(const int idx) const
+	{
+		unsigned int code = 0;
+		for (size_t k = 0; k < NUM_NEIGHBORS; ++k)
+			code |= (unsigned int)pixels_[idx + offsets_[k]] << k;
+		return code;
+	}
+
+	int getGroupCount(const int idx) const
+	{
+		return NEIGHBOR_GROUP_TABLE.counts[getNeighborCode(idx)];
+	}
+
+	cv::Point toPoint(const int idx) const
+	{
+		return cv::Point(idx % stride_ - 1, idx / stride_ - 1);
+	}
+
+	int addNode(const int idx)
+	{
+		graph_.nodes.push_back(toPoint(idx));
+		return (int)graph_.nodes.size() - 1;
+	}
+
+	void addBranch(const int startNode, const int endNode, const float length)
+	{
+		graph_.branchNodes.push_back(startNode);
+		graph_.branchNodes.push_back(endNode);
+		graph_.branchOffsets.push_back((int)graph_.branchPixels.size());
+		graph_.branchLengths.push_back(length);
+	}
+
+	// The branches from a node pixel to the unvisited pixels & to the adjacent nodes of larger ids.
+	void traceBranches(const int start, const size_t firstBranch)
+	{
+		const int node = marks_[start];
+		for (size_t n = 0; n < NUM_NEIGHBORS; ++n)
+		{
+			const size_t k = NEIGHBOR_SEARCH_ORDER[n];
+			const int neighbor = start + offsets_[k];
+			if (!pixels_[neighbor]) continue;
+
+			const int mark = marks_[neighbor];
+			if (mark > node)
+			{
+				// Adjacent nodes without branch pixels, linked once.
+				bool linked = false;
+				for (size_t i = firstBranch; i < graph_.branchLengths.size() && !linked; ++i)
+					linked = graph_.branchNodes[2 * i + 1] == mark && graph_.branchOffsets[i] == graph_.branchOffsets[i + 1];
+				if (!linked) addBranch(node, mark, NEIGHBOR_DISTANCES[k]);
+			}
+			else if (UNVISITED == mark)
+				followBranch(start, neighbor, NEIGHBOR_DISTANCES[k]);
+		}
+	}
+
+	// Follows a branch pixel by pixel until it reaches a node.
+	void followBranch(const int start, int curr, float length)
+	{
+		const int startNode = marks_[start];
+		const size_t firstPixel = graph_.branchPixels.size();
+		int prev = start, endNode = -1;
+		while (true)
+		{
+			marks_[curr] = VISITED;
+			graph_.branchPixels.push_back(toPoint(curr));
+
+			const unsigned int code = getNeighborCode(curr);
+			size_t prevK = 0;
+			while (curr + offsets_[prevK] != prev) ++prevK;
+			const unsigned int others = getOtherNeighbors(code, prevK);
+
+			// A node first, then an unvisited pixel, 4-connected ones first.
+			int next = -1;
+			size_t nextK = 0;
+			for (size_t n = 0; n < NUM_NEIGHBORS && -1 == next; ++n)
+			{
+				const size_t k = NEIGHBOR_SEARCH_ORDER[n];
+				if ((others >> k) & 1 && marks_[curr + offsets_[k]] >= 0) next = curr + offsets_[nextK = k];
+			}
+			if (-1 != next)
+			{
+				endNode = marks_[next];
+				length += NEIGHBOR_DISTANCES[nextK];
+				break;
+			}
+			for (size_t n = 0; n < NUM_NEIGHBORS && -1 == next; ++n)
+			{
+				const size_t k = NEIGHBOR_SEARCH_ORDER[n];
+				if ((others >> k) & 1 && UNVISITED == marks_[curr + offsets_[k]]) next = curr + offsets_[nextK = k];
+			}
+			if (-1 == next)
+			{
+				// A dead end, which becomes a node.
+				graph_.branchPixels.pop_back();
+				endNode = marks_[curr] = addNode(curr);
+				break;
+			}
+
+			length += NEIGHBOR_DISTANCES[nextK];
+			prev = curr;
+			curr = next;
+		}
+
+		if (startNode == endNode && graph_.branchPixels.size() - firstPixel <= 1)
+		{
+			// A bump of one pixel on a node.
+			graph_.branchPixels.resize(firstPixel);
+			return;
+		}
+		addBranch(startNode, endNode, length);
+	}
+
+private:
+	swl::SkeletonAlgorithm::SkeletonGraph& graph_;
+	const int stride_;
+	int offsets_[NUM_NEIGHBORS];
+	std::vector<unsigned char> pixels_;
+	// A node id, UNVISITED or VISITED.
+	std::vector<int> marks_;
+};
+
 }  // namespace local
 }  // unnamed namespace
 
@@ -1627,4 +1976,70 @@ bool SkeletonAlgorithm::LineSegment::isContained(const cv::Point& pt) const
 	}
 }
 
+void SkeletonAlgorithm::SkeletonGraph::clear()
+{
+	nodes.clear();
+	nodeTypes.clear();
+	branchNodes.clear();
+	branchOffsets.clear();
+	branchPixels.clear();
+	branchLengths.clear();
+}
+
+/*static*/ void SkeletonAlgorithm::thin(const cv::Mat& bw, cv::Mat& skeleton_bw, const ThinningMethod method /*= GUO_HALL*/)
+{
+	CV_Assert(CV_8UC1 == bw.type());
+	if (bw.empty())
+	{
+		// No word to pack, even if one of the dimensions isn't zero.
+		skeleton_bw.create(bw.size(), CV_8UC1);
+		return;
+	}
+
+	const int rows = bw.rows, cols = bw.cols;
+	const int wordsPerRow = (cols + local::BITS_PER_WORD - 1) / local::BITS_PER_WORD;
+
+	// The columns which can be removed, without the first & the last columns.
+	std::vector<local::word_type> columnMask(wordsPerRow, ~local::word_type(0));
+	if (wordsPerRow > 0)
+	{
+		columnMask.front() &= ~local::word_type(1);
+		if (cols % local::BITS_PER_WORD)
+			columnMask.back() &= (local::word_type(1) << (cols % local::BITS_PER_WORD)) - 1;
+		columnMask.back() &= ~(local::word_type(1) << ((cols - 1) % local::BITS_PER_WORD));
+	}
+
+	std::vector<local::word_type> src((size_t)(rows + 2) * wordsPerRow, 0), dst(src.size(), 0);
+	for (int y = 0; y < rows; ++y)
+	{
+		const unsigned char* row = bw.ptr<unsigned char>(y);
+		local::word_type* words = &src[(size_t)(y + 1) * wordsPerRow];
+		for (int x = 0; x < cols; ++x)
+			if (row[x]) words[x / local::BITS_PER_WORD] |= local::word_type(1) << (x % local::BITS_PER_WORD);
+	}
+
+	bool changed = true;
+	while (changed)
+	{
+		changed = local::thinningIteration(src, dst, columnMask, rows, wordsPerRow, method, 0);
+		changed = local::thinningIteration(dst, src, columnMask, rows, wordsPerRow, method, 1) || changed;
+	}
+
+	skeleton_bw.create(rows, cols, CV_8UC1);
+	for (int y = 0; y < rows; ++y)
+	{
+		const local::word_type* words = &src[(size_t)(y + 1) * wordsPerRow];
+		unsigned char* row = skeleton_bw.ptr<unsigned char>(y);
+		for (int x = 0; x < cols; ++x)
+			row[x] = (words[x / local::BITS_PER_WORD] >> (x % local::BITS_PER_WORD)) & 1 ? 255 : 0;
+	}
+}
+
+/*static*/ void SkeletonAlgorithm::extractSkeletonGraph(const cv::Mat& skeleton_bw, SkeletonGraph& graph)
+{
+	CV_Assert(CV_8UC1 == skeleton_bw.type());
+
+	local::SkeletonGraphBuilder(skeleton_bw, graph).build();
+}
+
 }  // namespace swl
@@ -0,0 +1,206 @@
+#include "swl/Config.h"
+#include "swl/math/ConvexPolygon.h"
+#include "swl/math/LineSegment.h"
+#include <algorithm>
+#include <cmath>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace swl {
+
+namespace {
+namespace local {
+
+bool isLess(const ConvexPolygon::point_type &lhs, const ConvexPolygon::point_type &rhs)
+{
+	return lhs.x < rhs.x || (lhs.x == rhs.x && lhs.y < rhs.y);
+}
+
+// > 0 if o -> a -> b turns counterclockwise.
+double cross(const ConvexPolygon::point_type &o, const ConvexPolygon::point_type &a, const ConvexPolygon::point_type &b)
+{
+	return ((double)a.x - o.x) * ((double)b.y - o.y) - ((double)a.y - o.y) * ((double)b.x - o.x);
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------------------
+// ConvexPolygon.
+
+ConvexPolygon::ConvexPolygon()
+: vertices_(), tol_(0.0f), originX_(0.0), originY_(0.0), xs_(), ys_(), minX_(0.0), minY_(0.0), maxX_(0.0), maxY_(0.0)
+{
+}
+
+ConvexPolygon::ConvexPolygon(const point_type *points, const std::size_t count, const float tol /*= 0.0f*/)
+: vertices_(), tol_(tol), originX_(0.0), originY_(0.0), xs_(), ys_(), minX_(0.0), minY_(0.0), maxX_(0.0), maxY_(0.0)
+{
+	build(points, count, tol);
+}
+
+ConvexPolygon::ConvexPolygon(const std::vector<point_type> &points, const float tol /*= 0.0f*/)
+: vertices_(), tol_(tol), originX_(0.0), originY_(0.0), xs_(), ys_(), minX_(0.0), minY_(0.0), maxX_(0.0), maxY_(0.0)
+{
+	build(points.empty() ? NULL : &points[0], points.size(), tol);
+}
+
+ConvexPolygon::ConvexPolygon(const std::list<point_type> &points, const float tol /*= 0.0f*/)
+: vertices_(), tol_(tol), originX_(0.0), originY_(0.0), xs_(), ys_(), minX_(0.0), minY_(0.0), maxX_(0.0), maxY_(0.0)
+{
+	const std::vector<point_type> pts(points.begin(), points.end());
+	build(pts.empty() ? NULL : &pts[0], pts.size(), tol);
+}
+
+/*static*/ void ConvexPolygon::computeConvexHull(const point_type *points, const std::size_t count, std::vector<point_type> &hull)
+{
+	std::vector<point_type> pts(points, points + count);
+	std::sort(pts.begin(), pts.end(), local::isLess);
+
+	hull.clear();
+	if (pts.size() < 2)
+	{
+		hull.swap(pts);
+		return;
+	}
+	hull.reserve(2 * pts.size());
+
+	// the lower hull from left to right, then the upper hull from right to left. collinear points are dropped.
+	for (std::size_t i = 0; i < pts.size(); ++i)
+	{
+		while (hull.size() >= 2 && local::cross(hull[hull.size() - 2], hull.back(), pts[i]) <= 0.0) hull.pop_back();
+		hull.push_back(pts[i]);
+	}
+	const std::size_t lowerSize = hull.size() + 1;
+	for (std::size_t i = pts.size() - 1; i > 0; --i)
+	{
+		while (hull.size() >= lowerSize && local::cross(hull[hull.size() - 2], hull.back(), pts[i - 1]) <= 0.0) hull.pop_back();
+		hull.push_back(pts[i - 1]);
+	}
+
+	// the last point is the same as the first one.
+	hull.pop_back();
+	// all the points are the same.
+	if (hull.size() == 2 && hull[0].x == hull[1].x && hull[0].y == hull[1].y) hull.pop_back();
+}
+
+void ConvexPolygon::build(const point_type *points, const std::size_t count, const float tol /*= 0.0f*/)
+{
+	computeConvexHull(points, count, vertices_);
+	tol_ = tol;
+	xs_.clear();
+	ys_.clear();
+	if (vertices_.size() < 3) return;
+
+	// the offset vertex i is the intersection of the offset lines of the edges (i - 1, i) & (i, i + 1).
+	const std::size_t n = vertices_.size();
+	std::vector<double> nx(n), ny(n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		const point_type &p = vertices_[i], &q = vertices_[(i + 1) % n];
+		const double dx = (double)q.x - p.x, dy = (double)q.y - p.y, len = std::sqrt(dx * dx + dy * dy);
+		// the outward normal of a counterclockwise edge.
+		nx[i] = dy / len;
+		ny[i] = -dx / len;
+	}
+
+	xs_.resize(n);
+	ys_.resize(n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		const std::size_t prev = (i + n - 1) % n;
+		const double scale = tol / (1.0 + nx[prev] * nx[i] + ny[prev] * ny[i]);
+		xs_[i] = vertices_[i].x + scale * (nx[prev] + nx[i]);
+		ys_[i] = vertices_[i].y + scale * (ny[prev] + ny[i]);
+	}
+
+	minX_ = *std::min_element(xs_.begin(), xs_.end());
+	maxX_ = *std::max_element(xs_.begin(), xs_.end());
+	minY_ = *std::min_element(ys_.begin(), ys_.end());
+	maxY_ = *std::max_element(ys_.begin(), ys_.end());
+
+	originX_ = xs_[0];
+	originY_ = ys_[0];
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		xs_[i] -= originX_;
+		ys_[i] -= originY_;
+	}
+}
+
+bool ConvexPolygon::includeSegment(const double x, const double y) const
+{
+	return LineSegment2<float>(vertices_[0], vertices_[1]).include(point_type((float)x, (float)y), tol_);
+}
+
+bool ConvexPolygon::includePolygon(const double x, const double y) const
+{
+	if (x < minX_ || x > maxX_ || y < minY_ || y > maxY_) return false;
+
+	const double px = x - originX_, py = y - originY_;
+	const std::size_t n = xs_.size();
+
+	// outside the wedge spanned at the first vertex.
+	if (xs_[1] * py - ys_[1] * px < 0.0 || xs_[n - 1] * py - ys_[n - 1] * px > 0.0) return false;
+
+	// the last k in [1, n - 2] such that the point is on the left of (or on) the ray to vertex k.
+	std::size_t lo = 1, hi = n - 2;
+	while (lo < hi)
+	{
+		const std::size_t mid = (lo + hi + 1) / 2;
+		if (xs_[mid] * py - ys_[mid] * px >= 0.0) lo = mid;
+		else hi = mid - 1;
+	}
+
+	// on the left of (or on) the edge (k, k + 1).
+	const double ex = xs_[lo + 1] - xs_[lo], ey = ys_[lo + 1] - ys_[lo];
+	return ex * (py - ys_[lo]) - ey * (px - xs_[lo]) >= 0.0;
+}
+
+bool ConvexPolygon::include(const point_type &pt) const
+{
+	switch (vertices_.size())
+	{
+	case 0:
+	case 1:
+		return false;
+	case 2:
+		return includeSegment(pt.x, pt.y);
+	default:
+		return includePolygon(pt.x, pt.y);
+	}
+}
+
+std::size_t ConvexPolygon::include(const point_type *points, const std::size_t count, bool *results) const
+{
+	std::size_t includedCount = 0;
+	if (vertices_.size() < 2)
+		std::fill(results, results + count, false);
+	else if (2 == vertices_.size())
+	{
+		for (std::size_t i = 0; i < count; ++i)
+			if ((results[i] = includeSegment(points[i].x, points[i].y))) ++includedCount;
+	}
+	else
+	{
+		for (std::size_t i = 0; i < count; ++i)
+			if ((results[i] = includePolygon(points[i].x, points[i].y))) ++includedCount;
+	}
+	return includedCount;
+}
+
+std::size_t ConvexPolygon::include(const std::vector<point_type> &points, std::vector<bool> &results) const
+{
+	results.resize(points.size());
+	std::size_t includedCount = 0;
+	for (std::size_t i = 0; i < points.size(); ++i)
+		if ((results[i] = include(points[i]))) ++includedCount;
+	return includedCount;
+}
+
+}  // namespace swl
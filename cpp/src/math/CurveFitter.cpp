@@ -0,0 +1,373 @@
+#include "swl/Config.h"
+#include "swl/math/CurveFitter.h"
+#include <Eigen/Cholesky>
+#include <Eigen/Eigenvalues>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace swl {
+
+namespace {
+namespace local {
+
+typedef Eigen::MatrixXd::Index Index;
+
+// the number of points accumulated by a matrix product at a time.
+const Index ACCUMULATION_BLOCK_SIZE = 256;
+
+// the tuning constants for 95% efficiency under normal noise.
+const double HUBER_CONSTANT = 1.345;
+const double TUKEY_CONSTANT = 4.685;
+// 1 / Phi^-1(3/4). the median absolute residual times this is a consistent estimate of the standard deviation.
+const double MAD_SCALE = 1.4826;
+
+std::size_t getGramSize(const CurveFitter::Model model, const std::size_t degree)
+{
+	switch (model)
+	{
+	case CurveFitter::LINE:
+		// [x, y, 1].
+		return 3;
+	case CurveFitter::QUADRATIC:
+		// [x^2, x, 1 | y].
+		return 4;
+	case CurveFitter::POLYNOMIAL:
+		// [1, x, ..., x^n | y].
+		return degree + 2;
+	case CurveFitter::CIRCLE:
+		// [x, y, 1 | -(x^2 + y^2)].
+		return 4;
+	case CurveFitter::ELLIPSE:
+		// [x * y, y^2 - x^2, x, y, 1 | -x^2].
+		return 6;
+	}
+	return 0;
+}
+
+double computeMedian(std::vector<double> &values)
+{
+	const std::size_t half = values.size() / 2;
+	std::nth_element(values.begin(), values.begin() + half, values.end());
+	if (values.size() % 2) return values[half];
+
+	const double upper = values[half];
+	return 0.5 * (upper + *std::max_element(values.begin(), values.begin() + half));
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------------------
+// CurveFitter.
+
+CurveFitter::CurveFitter(const Model model, const std::size_t degree /*= 2*/)
+: model_(model), degree_(degree), gram_(), count_(0)
+{
+	const local::Index size = (local::Index)local::getGramSize(model_, degree_);
+	gram_.setZero(size, size);
+}
+
+std::size_t CurveFitter::getParameterCount() const
+{
+	switch (model_)
+	{
+	case LINE:
+		return 3;
+	case QUADRATIC:
+		return 4;
+	case POLYNOMIAL:
+		return degree_ + 1;
+	case CIRCLE:
+		return 3;
+	case ELLIPSE:
+		return 6;
+	}
+	return 0;
+}
+
+std::size_t CurveFitter::getMinimumPointCount() const
+{
+	return LINE == model_ ? 2 : getBasisSize();
+}
+
+void CurveFitter::computeBasis(const double x, const double y, double *z) const
+{
+	switch (model_)
+	{
+	case LINE:
+		z[0] = x;  z[1] = y;  z[2] = 1.0;
+		break;
+	case QUADRATIC:
+		z[0] = x * x;  z[1] = x;  z[2] = 1.0;  z[3] = y;
+		break;
+	case POLYNOMIAL:
+		z[0] = 1.0;
+		for (std::size_t k = 1; k <= degree_; ++k)
+			z[k] = z[k - 1] * x;
+		z[degree_ + 1] = y;
+		break;
+	case CIRCLE:
+		z[0] = x;  z[1] = y;  z[2] = 1.0;  z[3] = -(x * x + y * y);
+		break;
+	case ELLIPSE:
+		z[0] = x * y;  z[1] = y * y - x * x;  z[2] = x;  z[3] = y;  z[4] = 1.0;  z[5] = -x * x;
+		break;
+	}
+}
+
+void CurveFitter::add(const double x, const double y, const double weight /*= 1.0*/)
+{
+	Eigen::VectorXd z(gram_.rows());
+	computeBasis(x, y, z.data());
+	gram_.selfadjointView<Eigen::Lower>().rankUpdate(z, weight);
+	++count_;
+}
+
+void CurveFitter::add(const double *xs, const double *ys, const std::size_t count, const double *weights /*= NULL*/)
+{
+	const local::Index size = gram_.rows();
+	Eigen::MatrixXd Z(size, std::min((local::Index)count, local::ACCUMULATION_BLOCK_SIZE));
+	Eigen::MatrixXd WZ(Z.rows(), Z.cols());
+	for (std::size_t start = 0; start < count; start += (std::size_t)local::ACCUMULATION_BLOCK_SIZE)
+	{
+		// the basis vectors of a block are the columns of Z, and the block adds Z * W * Z^T at once.
+		const local::Index blockSize = std::min((local::Index)(count - start), local::ACCUMULATION_BLOCK_SIZE);
+		for (local::Index j = 0; j < blockSize; ++j)
+			computeBasis(xs[start + j], ys[start + j], Z.col(j).data());
+
+		if (weights)
+			WZ.leftCols(blockSize) = Z.leftCols(blockSize) * Eigen::Map<const Eigen::VectorXd>(weights + start, blockSize).asDiagonal();
+		else
+			WZ.leftCols(blockSize) = Z.leftCols(blockSize);
+		gram_.triangularView<Eigen::Lower>() += WZ.leftCols(blockSize) * Z.leftCols(blockSize).transpose();
+	}
+	count_ += count;
+}
+
+void CurveFitter::remove(const double x, const double y, const double weight /*= 1.0*/)
+{
+	Eigen::VectorXd z(gram_.rows());
+	computeBasis(x, y, z.data());
+	gram_.selfadjointView<Eigen::Lower>().rankUpdate(z, -weight);
+	if (count_ > 0) --count_;
+}
+
+void CurveFitter::clear()
+{
+	gram_.setZero();
+	count_ = 0;
+}
+
+bool CurveFitter::solve(std::vector<double> &params) const
+{
+	if (count_ < getMinimumPointCount()) return false;
+
+	if (LINE == model_)
+	{
+		// the normal of the line is the eigenvector of the smallest eigenvalue of the weighted scatter matrix.
+		const double sw = gram_(2, 2);
+		if (sw <= 0.0) return false;
+		const double mx = gram_(2, 0) / sw, my = gram_(2, 1) / sw;
+
+		Eigen::Matrix2d scatter;
+		scatter(0, 0) = gram_(0, 0) - sw * mx * mx;
+		scatter(1, 0) = scatter(0, 1) = gram_(1, 0) - sw * mx * my;
+		scatter(1, 1) = gram_(1, 1) - sw * my * my;
+
+		const Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d> eig(scatter);
+		if (Eigen::Success != eig.info()) return false;
+		// all the points are the same.
+		if (eig.eigenvalues()(1) <= 0.0) return false;
+
+		const Eigen::Vector2d normal(eig.eigenvectors().col(0));
+		params.resize(3);
+		params[0] = normal(0);
+		params[1] = normal(1);
+		params[2] = -(normal(0) * mx + normal(1) * my);
+		return true;
+	}
+
+	const local::Index m = (local::Index)getBasisSize();
+	const Eigen::MatrixXd A(gram_.topLeftCorner(m, m).selfadjointView<Eigen::Lower>());
+	const Eigen::LDLT<Eigen::MatrixXd> ldlt(A);
+	if (Eigen::Success != ldlt.info() || !ldlt.isPositive()) return false;
+	// rank deficient.
+	const Eigen::VectorXd D(ldlt.vectorD().cwiseAbs());
+	if (D.minCoeff() <= D.maxCoeff() * m * std::numeric_limits<double>::epsilon()) return false;
+
+	const Eigen::VectorXd sol(ldlt.solve(gram_.bottomLeftCorner(1, m).transpose()));
+	switch (model_)
+	{
+	case QUADRATIC:
+		params.resize(4);
+		params[0] = sol(0);
+		params[1] = sol(1);
+		params[2] = -1.0;
+		params[3] = sol(2);
+		break;
+	case POLYNOMIAL:
+		params.assign(sol.data(), sol.data() + sol.size());
+		break;
+	case CIRCLE:
+		{
+			// x^2 + y^2 + D * x + E * y + F = 0.
+			const double cx = -0.5 * sol(0), cy = -0.5 * sol(1);
+			const double r2 = cx * cx + cy * cy - sol(2);
+			if (r2 <= 0.0) return false;
+			params.resize(3);
+			params[0] = cx;
+			params[1] = cy;
+			params[2] = std::sqrt(r2);
+		}
+		break;
+	case ELLIPSE:
+		params.resize(6);
+		params[0] = 1.0 - sol(1);
+		params[1] = sol(0);
+		params[2] = sol(1);
+		params[3] = sol(2);
+		params[4] = sol(3);
+		params[5] = sol(4);
+		break;
+	default:
+		return false;
+	}
+	return true;
+}
+
+double CurveFitter::computeResidual(const std::vector<double> &params, const double x, const double y) const
+{
+	switch (model_)
+	{
+	case LINE:
+		return params[0] * x + params[1] * y + params[2];
+	case QUADRATIC:
+		return y - ((params[0] * x + params[1]) * x + params[3]);
+	case POLYNOMIAL:
+		{
+			// Horner's method.
+			double val = 0.0;
+			for (std::size_t k = params.size(); k > 0; --k)
+				val = val * x + params[k - 1];
+			return y - val;
+		}
+	case CIRCLE:
+		return std::sqrt((x - params[0]) * (x - params[0]) + (y - params[1]) * (y - params[1])) - params[2];
+	case ELLIPSE:
+		{
+			const double &a = params[0], &b = params[1], &c = params[2], &d = params[3], &e = params[4], &f = params[5];
+			const double val = (a * x + b * y + d) * x + (c * y + e) * y + f;
+			const double gx = 2.0 * a * x + b * y + d, gy = b * x + 2.0 * c * y + e;
+			const double grad = std::sqrt(gx * gx + gy * gy);
+			return grad > 0.0 ? val / grad : val;
+		}
+	}
+	return 0.0;
+}
+
+bool CurveFitter::fitRobust(const double *xs, const double *ys, const std::size_t count, const Loss loss, std::vector<double> &params, std::vector<double> *weights /*= NULL*/, const std::size_t maxIterations /*= 20*/, const double tol /*= 1.0e-8*/)
+{
+	std::vector<double> w(count, 1.0), absResiduals(count), prevParams;
+
+	clear();
+	add(xs, ys, count);
+	bool solved = solve(params);
+	if (solved && LEAST_SQUARES != loss)
+	{
+		const double tuning = HUBER == loss ? local::HUBER_CONSTANT : local::TUKEY_CONSTANT;
+		for (std::size_t iter = 0; iter < maxIterations; ++iter)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+				absResiduals[i] = std::abs(computeResidual(params, xs[i], ys[i]));
+
+			std::vector<double> sorted(absResiduals);
+			const double scale = local::MAD_SCALE * local::computeMedian(sorted);
+			// more than half of the points are on the curve.
+			if (scale <= std::numeric_limits<double>::min()) break;
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const double u = absResiduals[i] / (tuning * scale);
+				if (HUBER == loss)
+					w[i] = u <= 1.0 ? 1.0 : 1.0 / u;
+				else
+					w[i] = u < 1.0 ? (1.0 - u * u) * (1.0 - u * u) : 0.0;
+			}
+
+			prevParams.swap(params);
+			clear();
+			add(xs, ys, count, &w[0]);
+			if (!solve(params))
+			{
+				solved = false;
+				break;
+			}
+
+			double maxChange = 0.0, maxParam = 0.0;
+			for (std::size_t k = 0; k < params.size(); ++k)
+			{
+				maxChange = std::max(maxChange, std::abs(params[k] - prevParams[k]));
+				maxParam = std::max(maxParam, std::abs(prevParams[k]));
+			}
+			if (maxChange <= tol * (1.0 + maxParam)) break;
+		}
+	}
+
+	if (weights) weights->swap(w);
+	return solved;
+}
+
+/*static*/ std::size_t CurveFitter::fitBatch(const Model model, const std::size_t degree, const Loss loss, const double *xs, const double *ys, const std::vector<std::size_t> &offsets, std::vector<std::vector<double> > &params)
+{
+	const int numSets = offsets.empty() ? 0 : (int)offsets.size() - 1;
+	params.assign(numSets, std::vector<double>());
+
+	std::size_t successCount = 0;
+#pragma omp parallel for schedule(dynamic) reduction(+:successCount)
+	for (int i = 0; i < numSets; ++i)
+	{
+		CurveFitter fitter(model, degree);
+		const std::size_t start = offsets[i], count = offsets[i + 1] - offsets[i];
+		if (fitter.fitRobust(xs + start, ys + start, count, loss, params[i])) ++successCount;
+		else params[i].clear();
+	}
+	return successCount;
+}
+
+/*static*/ bool CurveFitter::getEllipseGeometry(const std::vector<double> &params, double &cx, double &cy, double &major, double &minor, double &angle)
+{
+	const double &a = params[0], &b = params[1], &c = params[2], &d = params[3], &e = params[4], &f = params[5];
+
+	// not an ellipse.
+	const double det = 4.0 * a * c - b * b;
+	if (det <= 0.0) return false;
+
+	// the center makes the gradient zero.
+	cx = (b * e - 2.0 * c * d) / det;
+	cy = (b * d - 2.0 * a * e) / det;
+	// the value at the center. the conic is [x y] * M * [x y]^T = -f0 around the center.
+	const double f0 = 0.5 * (d * cx + e * cy) + f;
+
+	Eigen::Matrix2d M;
+	M << a, 0.5 * b, 0.5 * b, c;
+	const Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d> eig(M);
+	const double l0 = eig.eigenvalues()(0), l1 = eig.eigenvalues()(1);
+	// imaginary or degenerate.
+	if (-f0 / l0 <= 0.0 || -f0 / l1 <= 0.0) return false;
+
+	// the smaller eigenvalue belongs to the major axis.
+	major = std::sqrt(-f0 / l0);
+	minor = std::sqrt(-f0 / l1);
+	angle = std::atan2(eig.eigenvectors()(1, 0), eig.eigenvectors()(0, 0));
+	return true;
+}
+
+}  // namespace swl
@@ -5,7 +5,7 @@
 #include <boost/geometry/geometry.hpp>
 #include <boost/geometry/geometries/cartesian2d.hpp>
 #else
-#include "ConvexHull.h"
+#include "swl/math/ConvexPolygon.h"
 #endif
 #include <gsl/gsl_poly.h>
 #include <vector>
@@ -20,18 +20,6 @@
 
 namespace swl {
 
-namespace {
-namespace local {
-
-// line equation: (x - x0) / a = (y - y0) / b ==> b * (x - x0) - a * (y - y0) = 0
-bool isInTheSameSide(const double &px, const double &py, const double &cx, const double &cy, const double &a, const double &b, const double &x0, const double &y0, const double &tol)
-{
-	return (b * (px - x0) - a * (py - y0)) * (b * (cx - x0) - a * (cy - y0)) >= 0.0;
-}
-
-}  // namespace local
-}  // unnamed namespace
-
 // Line equation: a * x + b * y + c = 0.
 /*static*/ bool GeometryUtil::computeNearestPointWithLine(const double x0, const double y0, const double a, const double b, const double c, double& nearestX, double& nearestY)
 {
@@ -154,16 +142,11 @@ bool isInTheSameSide(const double &px, const double &py, const double &cx, const
 	for (boost::geometry::polygon_2d::iterator it = hull.begin(); it != hull.end(); ++it)
 		convexHull.push_back(Point2<float>(it->x, it->y));
 #else
-	std::vector<point2d> pts;
-	std::vector<point2d> hull;
-
-	for (std::list<Point2<float> >::const_iterator it = points.begin(); it != points.end(); ++it)
-		pts.push_back(point2d(it->x, it->y));
-
-	GrahamScanConvexHull()(pts, hull);
+	const std::vector<Point2<float> > pts(points.begin(), points.end());
+	std::vector<Point2<float> > hull;
+	ConvexPolygon::computeConvexHull(pts.empty() ? NULL : &pts[0], pts.size(), hull);
 
-	for (std::vector<point2d>::iterator it = hull.begin(); it != hull.end(); ++it)
-		convexHull.push_back(Point2<float>((float)it->x, (float)it->y));
+	convexHull.insert(convexHull.end(), hull.begin(), hull.end());
 #endif
 }
 
@@ -186,46 +169,8 @@ bool isInTheSameSide(const double &px, const double &py, const double &cx, const
 
 	return within(boost::geometry::make<boost::geometry::point_2d>(pt.x, pt.y), hull);  // not boundary point, but internal point
 #else
-	std::vector<point2d> pts;
-	std::vector<point2d> hull;
-
-	for (std::list<Point2<float> >::const_iterator it = points.begin(); it != points.end(); ++it)
-		pts.push_back(point2d(it->x, it->y));
-
-	GrahamScanConvexHull()(pts, hull);
-
-	const size_t count = hull.size();
-	if (count < 2) return false;
-	else if (2 == count)
-	{
-		const point2d &pt1 = hull.front();
-		const point2d &pt2 = hull.back();
-
-		return LineSegment2<float>(Point2<float>((float)pt1.x, (float)pt1.y), Point2<float>((float)pt2.x, (float)pt2.y)).include(pt, tol);
-	}
-	else
-	{
-		point2d center(0, 0);
-		for (std::vector<point2d>::iterator it = hull.begin(); it != hull.end(); ++it)
-		{
-			center.x += it->x;
-			center.y += it->y;
-		}
-		center.x /= (double)count;
-		center.y /= (double)count;
-
-		std::vector<point2d>::iterator itPrev = hull.begin(), it = itPrev;
-		++it;
-		//if (hull.end() == itPrev || hull.end() == it) return false;
-
-		for (; it != hull.end(); ++it)
-		{
-			if (!local::isInTheSameSide(pt.x, pt.y, center.x, center.y, it->x - itPrev->x, it->y - itPrev->y, itPrev->x, itPrev->y, tol)) return false;
-			itPrev = it;
-		}
-		it = hull.begin();
-		return local::isInTheSameSide(pt.x, pt.y, center.x, center.y, it->x - itPrev->x, it->y - itPrev->y, itPrev->x, itPrev->y, tol);
-	}
+	// To test many points against the same points, keep a ConvexPolygon instead.
+	return ConvexPolygon(points, tol).include(pt);
 #endif
 }
 
@@ -237,26 +182,18 @@ bool isInTheSameSide(const double &px, const double &py, const double &cx, const
 		return LineSegment2<float>(convexHull.front(), convexHull.back()).include(pt, tol);
 	else
 	{
-		Point2<float> center(0, 0);
-		for (std::list<Point2<float> >::const_iterator it = convexHull.begin(); it != convexHull.end(); ++it)
+		// The point is inside if it isn't on both sides of the edges, whichever the orientation of the hull is.
+		bool isOnLeft = false, isOnRight = false;
+		std::list<Point2<float> >::const_iterator itPrev = convexHull.end();
+		--itPrev;
+		for (std::list<Point2<float> >::const_iterator it = convexHull.begin(); it != convexHull.end(); itPrev = it, ++it)
 		{
-			center.x += it->x;
-			center.y += it->y;
+			const double cross = ((double)it->x - itPrev->x) * ((double)pt.y - itPrev->y) - ((double)it->y - itPrev->y) * ((double)pt.x - itPrev->x);
+			if (cross > 0.0) isOnLeft = true;
+			else if (cross < 0.0) isOnRight = true;
+			if (isOnLeft && isOnRight) return false;
 		}
-		center.x /= (float)count;
-		center.y /= (float)count;
-
-		std::list<Point2<float> >::const_iterator itPrev = convexHull.begin(), it = itPrev;
-		++it;
-		//if (convexHull.end() == itPrev || convexHull.end() == it) return false;
-
-		for (; it != convexHull.end(); ++it)
-		{
-			if (!local::isInTheSameSide(pt.x, pt.y, center.x, center.y, it->x - itPrev->x, it->y - itPrev->y, itPrev->x, itPrev->y, tol)) return false;
-			itPrev = it;
-		}
-		it = convexHull.begin();
-		return local::isInTheSameSide(pt.x, pt.y, center.x, center.y, it->x - itPrev->x, it->y - itPrev->y, itPrev->x, itPrev->y, tol);
+		return true;
 	}
 }
 
@@ -0,0 +1,178 @@
+#include "swl/Config.h"
+#include "swl/math/Matrix.h"
+#include <vector>
+#include <algorithm>
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define __SWL_MATH__MATRIX__USE_SSE2 1
+#endif
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace swl {
+
+namespace {
+namespace local {
+
+// the blocks of B which are kept in the cache while the rows of C are updated.
+const std::size_t GEMM_BLOCK_K = 128;
+const std::size_t GEMM_BLOCK_N = 256;
+
+inline double dot(const double *a, const double *b, const std::size_t n)
+{
+	std::size_t j = 0;
+	double sum = 0.0;
+#if defined(__SWL_MATH__MATRIX__USE_SSE2)
+	__m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+	for (; j + 4 <= n; j += 4)
+	{
+		s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(a + j), _mm_loadu_pd(b + j)));
+		s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(a + j + 2), _mm_loadu_pd(b + j + 2)));
+	}
+	double buf[2];
+	_mm_storeu_pd(buf, _mm_add_pd(s0, s1));
+	sum = buf[0] + buf[1];
+#endif
+	for (; j < n; ++j)
+		sum += a[j] * b[j];
+	return sum;
+}
+
+inline float dot(const float *a, const float *b, const std::size_t n)
+{
+	std::size_t j = 0;
+	float sum = 0.0f;
+#if defined(__SWL_MATH__MATRIX__USE_SSE2)
+	__m128 s0 = _mm_setzero_ps(), s1 = _mm_setzero_ps();
+	for (; j + 8 <= n; j += 8)
+	{
+		s0 = _mm_add_ps(s0, _mm_mul_ps(_mm_loadu_ps(a + j), _mm_loadu_ps(b + j)));
+		s1 = _mm_add_ps(s1, _mm_mul_ps(_mm_loadu_ps(a + j + 4), _mm_loadu_ps(b + j + 4)));
+	}
+	float buf[4];
+	_mm_storeu_ps(buf, _mm_add_ps(s0, s1));
+	sum = (buf[0] + buf[1]) + (buf[2] + buf[3]);
+#endif
+	for (; j < n; ++j)
+		sum += a[j] * b[j];
+	return sum;
+}
+
+// y += a * x.
+inline void axpy(double *y, const double a, const double *x, const std::size_t n)
+{
+	std::size_t j = 0;
+#if defined(__SWL_MATH__MATRIX__USE_SSE2)
+	const __m128d va = _mm_set1_pd(a);
+	for (; j + 4 <= n; j += 4)
+	{
+		_mm_storeu_pd(y + j, _mm_add_pd(_mm_loadu_pd(y + j), _mm_mul_pd(va, _mm_loadu_pd(x + j))));
+		_mm_storeu_pd(y + j + 2, _mm_add_pd(_mm_loadu_pd(y + j + 2), _mm_mul_pd(va, _mm_loadu_pd(x + j + 2))));
+	}
+#endif
+	for (; j < n; ++j)
+		y[j] += a * x[j];
+}
+
+inline void axpy(float *y, const float a, const float *x, const std::size_t n)
+{
+	std::size_t j = 0;
+#if defined(__SWL_MATH__MATRIX__USE_SSE2)
+	const __m128 va = _mm_set1_ps(a);
+	for (; j + 8 <= n; j += 8)
+	{
+		_mm_storeu_ps(y + j, _mm_add_ps(_mm_loadu_ps(y + j), _mm_mul_ps(va, _mm_loadu_ps(x + j))));
+		_mm_storeu_ps(y + j + 4, _mm_add_ps(_mm_loadu_ps(y + j + 4), _mm_mul_ps(va, _mm_loadu_ps(x + j + 4))));
+	}
+#endif
+	for (; j < n; ++j)
+		y[j] += a * x[j];
+}
+
+template<typename T>
+void gemv(const std::size_t rows, const std::size_t cols, const T alpha, const T *A, const std::size_t lda, const T *x, const std::size_t incx, const T beta, T *y, const std::size_t incy)
+{
+	// a strided x is gathered once so that every row is a contiguous dot product.
+	std::vector<T> xbuf;
+	if (1 != incx && rows > 1)
+	{
+		xbuf.resize(cols);
+		for (std::size_t j = 0; j < cols; ++j) xbuf[j] = x[j * incx];
+		x = &xbuf[0];
+	}
+
+	for (std::size_t i = 0; i < rows; ++i, A += lda, y += incy)
+	{
+		T sum;
+		if (1 == incx || rows > 1) sum = dot(A, x, cols);
+		else
+		{
+			sum = T(0);
+			for (std::size_t j = 0; j < cols; ++j) sum += A[j] * x[j * incx];
+		}
+		*y = T(0) == beta ? alpha * sum : alpha * sum + beta * *y;
+	}
+}
+
+template<typename T>
+void gemm(const std::size_t m, const std::size_t n, const std::size_t k, const T alpha, const T *A, const std::size_t lda, const T *B, const std::size_t ldb, const T beta, T *C, const std::size_t ldc)
+{
+	for (std::size_t i = 0; i < m; ++i)
+	{
+		T *c = C + i * ldc;
+		if (T(0) == beta) std::fill(c, c + n, T(0));
+		else if (T(1) != beta)
+			for (std::size_t j = 0; j < n; ++j) c[j] *= beta;
+	}
+
+	// C(i, jj:jj+nb) += alpha * A(i, pp:pp+kb) * B(pp:pp+kb, jj:jj+nb) for each block of B.
+	for (std::size_t jj = 0; jj < n; jj += GEMM_BLOCK_N)
+	{
+		const std::size_t nb = std::min(GEMM_BLOCK_N, n - jj);
+		for (std::size_t pp = 0; pp < k; pp += GEMM_BLOCK_K)
+		{
+			const std::size_t kb = std::min(GEMM_BLOCK_K, k - pp);
+			for (std::size_t i = 0; i < m; ++i)
+			{
+				T *c = C + i * ldc + jj;
+				const T *a = A + i * lda + pp;
+				const T *b = B + pp * ldb + jj;
+				for (std::size_t p = 0; p < kb; ++p, b += ldb)
+					axpy(c, alpha * a[p], b, nb);
+			}
+		}
+	}
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------------------
+// struct MatrixKernel
+
+/*static*/ void MatrixKernel::gemv(const std::size_t rows, const std::size_t cols, const double alpha, const double *A, const std::size_t lda, const double *x, const std::size_t incx, const double beta, double *y, const std::size_t incy)
+{
+	local::gemv(rows, cols, alpha, A, lda, x, incx, beta, y, incy);
+}
+
+/*static*/ void MatrixKernel::gemv(const std::size_t rows, const std::size_t cols, const float alpha, const float *A, const std::size_t lda, const float *x, const std::size_t incx, const float beta, float *y, const std::size_t incy)
+{
+	local::gemv(rows, cols, alpha, A, lda, x, incx, beta, y, incy);
+}
+
+/*static*/ void MatrixKernel::gemm(const std::size_t m, const std::size_t n, const std::size_t k, const double alpha, const double *A, const std::size_t lda, const double *B, const std::size_t ldb, const double beta, double *C, const std::size_t ldc)
+{
+	local::gemm(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+/*static*/ void MatrixKernel::gemm(const std::size_t m, const std::size_t n, const std::size_t k, const float alpha, const float *A, const std::size_t lda, const float *B, const std::size_t ldb, const float beta, float *C, const std::size_t ldc)
+{
+	local::gemm(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+}  // namespace swl
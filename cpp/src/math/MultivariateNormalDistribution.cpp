@@ -0,0 +1,130 @@
+#include "swl/Config.h"
+#include "swl/math/MultivariateNormalDistribution.h"
+#include "swl/math/MathConstant.h"
+#include <Eigen/Cholesky>
+#include <stdexcept>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace swl {
+
+namespace {
+namespace local {
+
+typedef Eigen::MatrixXd::Index Index;
+
+// the number of points whitened at a time, so that the temporary stays in the cache.
+const Index BATCH_BLOCK_SIZE = 512;
+
+}  // namespace local
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------------------
+// MultivariateNormalDistribution.
+
+MultivariateNormalDistribution::MultivariateNormalDistribution(const Eigen::VectorXd &mean, const Eigen::MatrixXd &cov)
+: covType_(FULL_COVARIANCE), mean_(mean), L_(), invStdDevs_(), logNormalizer_(0.0)
+{
+	if (mean.size() != cov.rows() || cov.rows() != cov.cols())
+		throw std::runtime_error("Invalid vector or matrix size");
+
+	const Eigen::LLT<Eigen::MatrixXd> chol(cov);
+	if (Eigen::Success != chol.info())
+		throw std::runtime_error("Cholesky decompoistion failed");
+
+	L_ = chol.matrixL();
+	// log|cov| = 2 * sum(log(L_ii)).
+	const double logDet = 2.0 * L_.diagonal().array().log().sum();
+	logNormalizer_ = -0.5 * (double(mean_.size()) * std::log(MathConstant::_2_PI) + logDet);
+}
+
+MultivariateNormalDistribution::MultivariateNormalDistribution(const Eigen::VectorXd &mean, const Eigen::VectorXd &variances)
+: covType_(DIAGONAL_COVARIANCE), mean_(mean), L_(), invStdDevs_(), logNormalizer_(0.0)
+{
+	if (mean.size() != variances.size())
+		throw std::runtime_error("Invalid vector size");
+
+	initializeDiagonal(variances);
+}
+
+MultivariateNormalDistribution::MultivariateNormalDistribution(const Eigen::VectorXd &mean, const double variance)
+: covType_(ISOTROPIC_COVARIANCE), mean_(mean), L_(), invStdDevs_(), logNormalizer_(0.0)
+{
+	initializeDiagonal(Eigen::VectorXd::Constant(mean.size(), variance));
+}
+
+void MultivariateNormalDistribution::initializeDiagonal(const Eigen::VectorXd &variances)
+{
+	if (mean_.size() > 0 && !(variances.minCoeff() > 0.0))
+		throw std::runtime_error("Non-positive variance");
+
+	invStdDevs_ = variances.array().rsqrt();
+	logNormalizer_ = -0.5 * (double(mean_.size()) * std::log(MathConstant::_2_PI) + variances.array().log().sum());
+}
+
+void MultivariateNormalDistribution::whiten(Eigen::Ref<Eigen::MatrixXd> Z) const
+{
+	switch (covType_)
+	{
+	case FULL_COVARIANCE:
+		L_.triangularView<Eigen::Lower>().solveInPlace(Z);
+		break;
+	case DIAGONAL_COVARIANCE:
+		Z = invStdDevs_.asDiagonal() * Z;
+		break;
+	case ISOTROPIC_COVARIANCE:
+		if (mean_.size() > 0) Z *= invStdDevs_(0);
+		break;
+	}
+}
+
+double MultivariateNormalDistribution::squaredMahalanobisDistance(const Eigen::VectorXd &x) const
+{
+	assert(x.size() == mean_.size());
+
+	Eigen::VectorXd z(x - mean_);
+	whiten(z);
+	return z.squaredNorm();
+}
+
+double MultivariateNormalDistribution::logPdf(const Eigen::VectorXd &x) const
+{
+	return logNormalizer_ - 0.5 * squaredMahalanobisDistance(x);
+}
+
+double MultivariateNormalDistribution::pdf(const Eigen::VectorXd &x) const
+{
+	return std::exp(logPdf(x));
+}
+
+void MultivariateNormalDistribution::logPdf(const Eigen::MatrixXd &X, Eigen::VectorXd &logPdfs) const
+{
+	assert(X.rows() == mean_.size());
+
+	logPdfs.resize(X.cols());
+	Eigen::MatrixXd Z(X.rows(), std::min(X.cols(), local::BATCH_BLOCK_SIZE));
+	for (local::Index start = 0; start < X.cols(); start += local::BATCH_BLOCK_SIZE)
+	{
+		// one triangular solve with all the points of a block as the right-hand sides.
+		const local::Index blockSize = std::min(local::BATCH_BLOCK_SIZE, X.cols() - start);
+		Z.leftCols(blockSize).noalias() = X.middleCols(start, blockSize).colwise() - mean_;
+		whiten(Z.leftCols(blockSize));
+		logPdfs.segment(start, blockSize) = (-0.5 * Z.leftCols(blockSize).colwise().squaredNorm().transpose()).array() + logNormalizer_;
+	}
+}
+
+void MultivariateNormalDistribution::pdf(const Eigen::MatrixXd &X, Eigen::VectorXd &pdfs) const
+{
+	logPdf(X, pdfs);
+	pdfs = pdfs.array().exp();
+}
+
+}  // namespace swl
@@ -4,6 +4,7 @@
 #include "swl/base/LogException.h"
 #include <gsl/gsl_poly.h>
 #include <numeric>
+#include <limits>
 #include <algorithm>
 #include <cmath>
 #include <cassert>
@@ -54,141 +55,13 @@ void solveQuadraticForBairstowMethod(double u, double v, std::vector<std::comple
 	}
 }
 
-}  // namespace local
-}  // unnamed namespace
-
-namespace swl {
-
-//-----------------------------------------------------------------------------------------
-// Root Finding.
-
-double RootFinding::secant(double init, double (*func)(double), const double& tol /*= MathConstant::EPS*/)
-{
-	double delta, final;
-	double front, rear;
-	
-	final = init + 2.0;
-	front = (*func)(init);
-	rear = (*func)(final);
-	
-	int i = 0;
-	do
-	{
-		if (MathUtil::isZero(rear-front, tol))
-		{
-			throw LogException(LogException::L_ERROR, "Divide by zero", __FILE__, __LINE__, __FUNCTION__);
-			//return 0.0;
-		}
-
-		delta = -rear * (final - init) / (rear - front);
-		init = final;
-		final += delta;
-		front = rear;
-		rear = (*func)(final);
-		++i;
-
-		if (i >= MathConstant::ITERATION_LIMIT)
-		{
-			throw LogException(LogException::L_ERROR, "Iteration overflow", __FILE__, __LINE__, __FUNCTION__);
-			//return final;
-		}
-	} while (std::abs(delta) > tol || std::abs(rear) > tol);
-	
-	return final;
-}
+enum SolveStatus { SOLVED = 0, ILLEGAL_PARAMETER, DOMAIN_ERROR };
 
-double RootFinding::bisection(double left, double right, double (*func)(double), const double& tol /*= MathConstant::EPS*/)
+// Coefficients are arranged by a descending order.
+SolveStatus solveQuadratic(const std::array<double, 3>& coeffs, std::array<std::complex<double>, 2>& roots, const double& tol)
 {
-	double front, rear;
-	front = (*func)(left);
-	rear = (*func)(right);
-
-	if (front * rear >= 0.0)
-	{
-		throw LogException(LogException::L_ERROR, "Illegal parameter value", __FILE__, __LINE__, __FUNCTION__);
-		//return 0.0;
-	}
-
-	double mid, delta, temp;
-	int i = 0;
-	do
-	{
-		mid = (left + right) / 2.0;
-		temp = (*func)(mid);
-		
-		if (temp * front > 0.0)
-		{
-			front = temp;
-			delta = mid - left;
-			left = mid;
-		}
-		else
-		{
-			rear = temp;
-			delta = mid - right;
-			right = mid;
-		}
-		++i;
-
-		if (i >= MathConstant::ITERATION_LIMIT)
-		{
-			throw LogException(LogException::L_ERROR, "Iteration overflow", __FILE__, __LINE__, __FUNCTION__);
-			//return mid;
-		}
-	} while (std::abs(delta) > tol || std::abs(temp) > tol);
-	
-	return mid;
-}
-
-double RootFinding::falsePosition(double left, double right, double (*func)(double), const double& tol /*= MathConstant::EPS*/)
-{
-	double front, rear;
-	front = (*func)(left);
-	rear = (*func)(right);
-	
-	if (front * rear >= 0.0)
-	{
-		throw LogException(LogException::L_ERROR, "Illegal parameter value", __FILE__, __LINE__, __FUNCTION__);
-		//return 0.0;
-	}
-
-	double inter, delta, temp;
-	int i = 0;
-	do
-	{
-		inter =  (right * front - left * rear) / (front - rear);
-		temp = (*func)(inter);
-		if (temp * front > 0.0)
-		{
-			front = temp;
-			delta = inter - left;
-			left = inter;
-		}
-		else
-		{
-			rear = temp;
-			delta = inter - right;
-			right = inter;
-		}
-		++i;
-
-		if (i >= MathConstant::ITERATION_LIMIT)
-		{
-			throw LogException(LogException::L_ERROR, "Iteration overflow", __FILE__, __LINE__, __FUNCTION__);
-			//return inter;
-		}
-	}  while (std::abs(delta) > tol || std::abs(temp) > tol);
-	
-	return inter;
-}
-
-bool RootFinding::quadratic(const std::array<double, 3>& coeffs, std::array<std::complex<double>, 2>& roots, const double& tol /*= MathConstant::EPS*/)
-{
-	if (MathUtil::isZero(coeffs[0], tol))
-	{
-		throw LogException(LogException::L_ERROR, "Illegal parameter value", __FILE__, __LINE__, __FUNCTION__);
-		//return false;
-	}
+	if (swl::MathUtil::isZero(coeffs[0], tol))
+		return ILLEGAL_PARAMETER;
 
 	// Calculate normalized coefficients.
 	const double u = coeffs[1] / coeffs[0];
@@ -223,16 +96,13 @@ bool RootFinding::quadratic(const std::array<double, 3>& coeffs, std::array<std:
 		roots[1].imag(-roots[0].imag());
 	}
 
-	return true;
+	return SOLVED;
 }
 
-bool RootFinding::cubic(const std::array<double, 4>& coeffs, std::array<std::complex<double>, 3>& roots, const double& tol /*= MathConstant::EPS*/)
+SolveStatus solveCubic(const std::array<double, 4>& coeffs, std::array<std::complex<double>, 3>& roots, const double& tol)
 {
 	if (-tol <= coeffs[0] && coeffs[0] <= tol)
-	{
-		throw LogException(LogException::L_ERROR, "Illegal parameter value", __FILE__, __LINE__, __FUNCTION__);
-		//return false;
-	}
+		return ILLEGAL_PARAMETER;
 
 	// Calculate normalized coefficients.
 	const double a = coeffs[1] / coeffs[0];
@@ -269,31 +139,25 @@ bool RootFinding::cubic(const std::array<double, 4>& coeffs, std::array<std::com
 	else  // Three roots are real and distinct.
 	{
 		if (p < 0.0)
-		{
-			throw LogException(LogException::L_ERROR, "Domain error", __FILE__, __LINE__, __FUNCTION__);
-			//return false;
-		}
+			return DOMAIN_ERROR;
 
 		const double u = ::acos(q / std::pow(p, 1.5));
 		const double val1 = 2.0 * std::sqrt(p), val2 = a / 3.0;
 		roots[0].real(val1 * std::cos(u / 3.0) - val2);
-		roots[1].real(val1 * std::cos((u + MathConstant::_2_PI) / 3.0) - val2);
-		roots[2].real(val1 * std::cos((u + MathConstant::_4_PI) / 3.0) - val2);
+		roots[1].real(val1 * std::cos((u + swl::MathConstant::_2_PI) / 3.0) - val2);
+		roots[2].real(val1 * std::cos((u + swl::MathConstant::_4_PI) / 3.0) - val2);
 		roots[0].imag(0.0);
 		roots[1].imag(0.0);
 		roots[2].imag(0.0);
 	}
 
-	return true;
+	return SOLVED;
 }
 
-bool RootFinding::quartic(const std::array<double, 5>& coeffs, std::array<std::complex<double>, 4>& roots, const double& tol /*= MathConstant::EPS*/)
+SolveStatus solveQuartic(const std::array<double, 5>& coeffs, std::array<std::complex<double>, 4>& roots, const double& tol)
 {
-	if (MathUtil::isZero(coeffs[0], tol))
-	{
-		throw LogException(LogException::L_ERROR, "Illegal parameter value", __FILE__, __LINE__, __FUNCTION__);
-		//return false;
-	}
+	if (swl::MathUtil::isZero(coeffs[0], tol))
+		return ILLEGAL_PARAMETER;
 
 	// Calculate normalized coefficients.
 	const double a1 = coeffs[1] / coeffs[0];
@@ -309,7 +173,7 @@ bool RootFinding::quartic(const std::array<double, 5>& coeffs, std::array<std::c
 	const std::array<double, 4> coeffs1 = { 1.0, 2.0*b1, b1*b1-4.0*b3, -b2*b2 };
 	std::array<std::complex<double>, 3> arRoot1;
 
-	cubic(coeffs1, arRoot1);
+	if (DOMAIN_ERROR == solveCubic(coeffs1, arRoot1, swl::MathConstant::EPS)) return DOMAIN_ERROR;
 	
 	for (int i = 0 ; i < 3 ; ++i)
 	{
@@ -323,13 +187,13 @@ bool RootFinding::quartic(const std::array<double, 5>& coeffs, std::array<std::c
 
 				std::array<double, 3> coeffs2 = { 1.0, p, q1 };
 				std::array<std::complex<double>, 2> roots2;
-				quadratic(coeffs2, roots2);
+				solveQuadratic(coeffs2, roots2, swl::MathConstant::EPS);
 				roots[0] = roots2[0];
 				roots[1] = roots2[1];
 				
 				coeffs2[1] = -p;
 				coeffs2[2] = q2;
-				quadratic(coeffs2, roots2);
+				solveQuadratic(coeffs2, roots2, swl::MathConstant::EPS);
 				roots[2] = roots2[0];
 				roots[3] = roots2[1];
 
@@ -338,9 +202,100 @@ bool RootFinding::quartic(const std::array<double, 5>& coeffs, std::array<std::c
 		}
 	}
 
+	return SOLVED;
+}
+
+template<std::size_t N, class Solver>
+std::size_t solveBatch(const std::size_t count, const std::array<double, N + 1> *coeffs, std::array<std::complex<double>, N> *roots, const double& tol, Solver solver)
+{
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	std::size_t solvedCount = 0;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		if (SOLVED == solver(coeffs[i], roots[i], tol)) ++solvedCount;
+		else roots[i].fill(std::complex<double>(nan, nan));
+	}
+	return solvedCount;
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+
+//-----------------------------------------------------------------------------------------
+// Root Finding.
+
+double RootFinding::secant(double init, double (*func)(double), const double& tol /*= MathConstant::EPS*/)
+{
+	return secant<double (*)(double)>(init, func, tol);
+}
+
+double RootFinding::bisection(double left, double right, double (*func)(double), const double& tol /*= MathConstant::EPS*/)
+{
+	return bisection<double (*)(double)>(left, right, func, tol);
+}
+
+double RootFinding::falsePosition(double left, double right, double (*func)(double), const double& tol /*= MathConstant::EPS*/)
+{
+	return falsePosition<double (*)(double)>(left, right, func, tol);
+}
+
+bool RootFinding::quadratic(const std::array<double, 3>& coeffs, std::array<std::complex<double>, 2>& roots, const double& tol /*= MathConstant::EPS*/)
+{
+	if (local::ILLEGAL_PARAMETER == local::solveQuadratic(coeffs, roots, tol))
+	{
+		throw LogException(LogException::L_ERROR, "Illegal parameter value", __FILE__, __LINE__, __FUNCTION__);
+		//return false;
+	}
 	return true;
 }
 
+bool RootFinding::cubic(const std::array<double, 4>& coeffs, std::array<std::complex<double>, 3>& roots, const double& tol /*= MathConstant::EPS*/)
+{
+	switch (local::solveCubic(coeffs, roots, tol))
+	{
+	case local::ILLEGAL_PARAMETER:
+		throw LogException(LogException::L_ERROR, "Illegal parameter value", __FILE__, __LINE__, __FUNCTION__);
+		//return false;
+	case local::DOMAIN_ERROR:
+		throw LogException(LogException::L_ERROR, "Domain error", __FILE__, __LINE__, __FUNCTION__);
+		//return false;
+	default:
+		return true;
+	}
+}
+
+bool RootFinding::quartic(const std::array<double, 5>& coeffs, std::array<std::complex<double>, 4>& roots, const double& tol /*= MathConstant::EPS*/)
+{
+	switch (local::solveQuartic(coeffs, roots, tol))
+	{
+	case local::ILLEGAL_PARAMETER:
+		throw LogException(LogException::L_ERROR, "Illegal parameter value", __FILE__, __LINE__, __FUNCTION__);
+		//return false;
+	case local::DOMAIN_ERROR:
+		throw LogException(LogException::L_ERROR, "Domain error", __FILE__, __LINE__, __FUNCTION__);
+		//return false;
+	default:
+		return true;
+	}
+}
+
+/*static*/ std::size_t RootFinding::quadratic(const std::size_t count, const std::array<double, 3> *coeffs, std::array<std::complex<double>, 2> *roots, const double& tol /*= MathConstant::EPS*/)
+{
+	return local::solveBatch(count, coeffs, roots, tol, local::solveQuadratic);
+}
+
+/*static*/ std::size_t RootFinding::cubic(const std::size_t count, const std::array<double, 4> *coeffs, std::array<std::complex<double>, 3> *roots, const double& tol /*= MathConstant::EPS*/)
+{
+	return local::solveBatch(count, coeffs, roots, tol, local::solveCubic);
+}
+
+/*static*/ std::size_t RootFinding::quartic(const std::size_t count, const std::array<double, 5> *coeffs, std::array<std::complex<double>, 4> *roots, const double& tol /*= MathConstant::EPS*/)
+{
+	return local::solveBatch(count, coeffs, roots, tol, local::solveQuartic);
+}
+
 bool RootFinding::bairstow(const std::vector<double>& coeffs, std::vector<std::complex<double> >& roots, const double& tol /*= MathConstant::EPS*/)
 {
 	std::vector<double>::size_type nOrder = coeffs.size() - 1;
@@ -2,6 +2,7 @@
 #include "swl/math/Rotation.h"
 #include "swl/base/LogException.h"
 #include <cmath>
+#include <algorithm>
 
 
 #if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
@@ -1665,4 +1666,438 @@ RMatrix3<double> Rotation::rotateRelativeZYZ(const double alpha, const double be
 	return m;
 }
 
+//-----------------------------------------------------------------------------------------
+//  struct RotationArray
+
+namespace {
+namespace local {
+
+// the number of rotations whose sines & cosines are computed at a time.
+const std::size_t BLOCK_SIZE = 256;
+
+// beyond this, the polynomial loses precision in the argument reduction & the standard functions are used.
+const double MAX_POLYNOMIAL_ANGLE = 1.0e6;
+
+// sine & cosine in Cephes style. pi/4 is split in three parts for the argument reduction.
+void sincos(const std::size_t count, const double *angle, double *s, double *c)
+{
+	const double DP1 = 7.85398125648498535156e-1, DP2 = 3.77489470793079817668e-8, DP3 = 2.69515142907905952645e-15;
+	const double FOUR_OVER_PI = 1.27323954473516268615;
+
+	double maxAngle = 0.0;
+	for (std::size_t n = 0; n < count; ++n)
+		maxAngle = std::max(maxAngle, std::fabs(angle[n]));
+	if (!(maxAngle <= MAX_POLYNOMIAL_ANGLE))  // also for NaN.
+	{
+		for (std::size_t n = 0; n < count; ++n)
+		{
+			const double x = angle[n];
+			s[n] = std::sin(x);
+			c[n] = std::cos(x);
+		}
+		return;
+	}
+
+	for (std::size_t n = 0; n < count; ++n)
+	{
+		const double x = angle[n];
+		const double ax = std::fabs(x);
+
+		// the nearest even multiple of pi/4.
+		const int q = ((int)(ax * FOUR_OVER_PI) + 1) & ~1;
+		const double y = (double)q;
+		const double z = ((ax - y * DP1) - y * DP2) - y * DP3;
+		const double zz = z * z;
+
+		const double ps = z + z * zz * (((((1.58962301576546568060e-10 * zz - 2.50507477628578072866e-8) * zz + 2.75573136213857245213e-6) * zz - 1.98412698295895385996e-4) * zz + 8.33333333332211858878e-3) * zz - 1.66666666666666307295e-1);
+		const double pc = 1.0 - 0.5 * zz + zz * zz * (((((-1.13585365213876817300e-11 * zz + 2.08757008419747316778e-9) * zz - 2.75573141792967388112e-7) * zz + 2.48015872888517045348e-5) * zz - 1.38888888888730564116e-3) * zz + 4.16666666666665929218e-2);
+
+		// the quadrant.
+		const int k = (q >> 1) & 3;
+		const double sinAx = (k & 1) ? pc : ps;
+		const double cosAx = (k & 1) ? ps : pc;
+		s[n] = ((k & 2) ? -sinAx : sinAx) * (x < 0.0 ? -1.0 : 1.0);
+		c[n] = ((k + 1) & 2) ? -cosAx : cosAx;
+	}
+}
+
+// the axis of MathConstant::AXIS as 0, 1 or 2, and -1 for the null axis.
+int getAxisIndex(const MathConstant::AXIS axis)
+{
+	switch (axis)
+	{
+	case MathConstant::AXIS_X:  return 0;
+	case MathConstant::AXIS_Y:  return 1;
+	case MathConstant::AXIS_Z:  return 2;
+	default:  return -1;
+	}
+}
+
+// the axes, the angles & whether it's the identity, with the fixed rotations turned into relative ones.
+bool parseRotation(const unsigned int order, const double *&alpha, const double *&gamma, int &axis1, int &axis2, int &axis3)
+{
+	axis1 = axis2 = axis3 = -1;
+	if (!order) return false;
+
+	MathConstant::AXIS first, second, third;
+	if (!RotationOrder::parseOrder(order, first, second, third))
+		throw LogException(LogException::L_ERROR, "illegal parameter value", __FILE__, __LINE__, __FUNCTION__);
+
+	if (RotationOrder::isFixed(order))
+	{
+		std::swap(first, third);
+		std::swap(alpha, gamma);
+	}
+	axis1 = getAxisIndex(first);
+	axis2 = getAxisIndex(second);
+	axis3 = getAxisIndex(third);
+	return axis1 >= 0 || axis2 >= 0 || axis3 >= 0;
+}
+
+struct SinCosBlock
+{
+	double s[3][BLOCK_SIZE];
+	double c[3][BLOCK_SIZE];
+};
+
+typedef void (*BlockKernel)(const std::size_t count, const SinCosBlock &block, double * const *out, const std::size_t offset);
+
+// R = R_axis1(alpha) * R_axis2(beta) * R_axis3(gamma), where R_axis(angle) is Rotation::rotateX(), rotateY() or rotateZ().
+template<int AXIS1, int AXIS2, int AXIS3>
+struct MatrixKernel
+{
+	// m = m * R_axis(angle), where m is a 3x3 matrix in row-major order.
+	template<int AXIS>
+	static void rotate(double m[9], const double s, const double c)
+	{
+		if (AXIS < 0) return;
+		const int j = (AXIS + 1) % 3, k = (AXIS + 2) % 3;
+		for (int r = 0; r < 3; ++r)
+		{
+			const double mj = m[r * 3 + j], mk = m[r * 3 + k];
+			m[r * 3 + j] = c * mj + s * mk;
+			m[r * 3 + k] = c * mk - s * mj;
+		}
+	}
+
+	static void run(const std::size_t count, const SinCosBlock &block, double * const *mats, const std::size_t offset)
+	{
+		for (std::size_t n = 0; n < count; ++n)
+		{
+			double m[9] = { 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0 };
+			rotate<AXIS1>(m, block.s[0][n], block.c[0][n]);
+			rotate<AXIS2>(m, block.s[1][n], block.c[1][n]);
+			rotate<AXIS3>(m, block.s[2][n], block.c[2][n]);
+
+			// column-major, as in RMatrix3.
+			for (int col = 0; col < 3; ++col)
+				for (int row = 0; row < 3; ++row)
+					mats[col * 3 + row][offset + n] = m[row * 3 + col];
+		}
+	}
+};
+
+// q = q_axis1(alpha) * q_axis2(beta) * q_axis3(gamma). the sines & cosines are of the half angles.
+template<int AXIS1, int AXIS2, int AXIS3>
+struct QuaternionKernel
+{
+	// q = q * (c, s * e_axis), where q = (w, v[0], v[1], v[2]).
+	template<int AXIS>
+	static void rotate(double q[4], const double s, const double c)
+	{
+		if (AXIS < 0) return;
+		const int i = AXIS + 1, j = (AXIS + 1) % 3 + 1, k = (AXIS + 2) % 3 + 1;
+		const double w = q[0], vi = q[i], vj = q[j], vk = q[k];
+		q[0] = c * w - s * vi;
+		q[i] = c * vi + s * w;
+		q[j] = c * vj + s * vk;
+		q[k] = c * vk - s * vj;
+	}
+
+	static void run(const std::size_t count, const SinCosBlock &block, double * const *quats, const std::size_t offset)
+	{
+		for (std::size_t n = 0; n < count; ++n)
+		{
+			double q[4] = { 1.0, 0.0, 0.0, 0.0 };
+			rotate<AXIS1>(q, block.s[0][n], block.c[0][n]);
+			rotate<AXIS2>(q, block.s[1][n], block.c[1][n]);
+			rotate<AXIS3>(q, block.s[2][n], block.c[2][n]);
+			for (int i = 0; i < 4; ++i)
+				quats[i][offset + n] = q[i];
+		}
+	}
+};
+
+template<template<int, int, int> class Kernel, int AXIS1, int AXIS2>
+BlockKernel selectKernel(const int axis3)
+{
+	switch (axis3)
+	{
+	case 0:  return &Kernel<AXIS1, AXIS2, 0>::run;
+	case 1:  return &Kernel<AXIS1, AXIS2, 1>::run;
+	case 2:  return &Kernel<AXIS1, AXIS2, 2>::run;
+	default:  return &Kernel<AXIS1, AXIS2, -1>::run;
+	}
+}
+
+template<template<int, int, int> class Kernel, int AXIS1>
+BlockKernel selectKernel(const int axis2, const int axis3)
+{
+	switch (axis2)
+	{
+	case 0:  return selectKernel<Kernel, AXIS1, 0>(axis3);
+	case 1:  return selectKernel<Kernel, AXIS1, 1>(axis3);
+	case 2:  return selectKernel<Kernel, AXIS1, 2>(axis3);
+	default:  return selectKernel<Kernel, AXIS1, -1>(axis3);
+	}
+}
+
+template<template<int, int, int> class Kernel>
+BlockKernel selectKernel(const int axis1, const int axis2, const int axis3)
+{
+	switch (axis1)
+	{
+	case 0:  return selectKernel<Kernel, 0>(axis2, axis3);
+	case 1:  return selectKernel<Kernel, 1>(axis2, axis3);
+	case 2:  return selectKernel<Kernel, 2>(axis2, axis3);
+	default:  return selectKernel<Kernel, -1>(axis2, axis3);
+	}
+}
+
+// run a kernel over the batch a block at a time. the angles are multiplied by angleScale before their sines & cosines are taken.
+void runKernel(const BlockKernel kernel, const std::size_t count, const double * const angles[3], const int axes[3], const double angleScale, double * const *out)
+{
+	SinCosBlock block;
+	double scaled[BLOCK_SIZE];
+	for (std::size_t offset = 0; offset < count; offset += BLOCK_SIZE)
+	{
+		const std::size_t blockSize = std::min(BLOCK_SIZE, count - offset);
+		for (int a = 0; a < 3; ++a)
+		{
+			if (axes[a] < 0) continue;
+			const double *angle = angles[a] + offset;
+			if (1.0 != angleScale)
+			{
+				for (std::size_t n = 0; n < blockSize; ++n) scaled[n] = angle[n] * angleScale;
+				angle = scaled;
+			}
+			sincos(blockSize, angle, block.s[a], block.c[a]);
+		}
+		kernel(blockSize, block, out, offset);
+	}
+}
+
+typedef void (*AngleCalculator)(const RMatrix3<double> &mat, double &alpha, double &beta, double &gamma);
+
+}  // namespace local
+}  // unnamed namespace
+
+/*static*/ void RotationArray::rotate(const unsigned int order, const std::size_t count, const double *alpha, const double *beta, const double *gamma, double * const mats[9])
+{
+	int axes[3];
+	if (!local::parseRotation(order, alpha, gamma, axes[0], axes[1], axes[2]))
+	{
+		for (int i = 0; i < 9; ++i)
+			std::fill(mats[i], mats[i] + count, (0 == i % 4) ? 1.0 : 0.0);
+		return;
+	}
+
+	const double * const angles[3] = { alpha, beta, gamma };
+	local::runKernel(local::selectKernel<local::MatrixKernel>(axes[0], axes[1], axes[2]), count, angles, axes, 1.0, mats);
+}
+
+/*static*/ void RotationArray::toQuaternion(const unsigned int order, const std::size_t count, const double *alpha, const double *beta, const double *gamma, double * const quats[4])
+{
+	int axes[3];
+	if (!local::parseRotation(order, alpha, gamma, axes[0], axes[1], axes[2]))
+	{
+		for (int i = 0; i < 4; ++i)
+			std::fill(quats[i], quats[i] + count, 0 == i ? 1.0 : 0.0);
+		return;
+	}
+
+	const double * const angles[3] = { alpha, beta, gamma };
+	local::runKernel(local::selectKernel<local::QuaternionKernel>(axes[0], axes[1], axes[2]), count, angles, axes, 0.5, quats);
+}
+
+/*static*/ void RotationArray::calc(const unsigned int order, const std::size_t count, const double * const mats[9], double *alpha, double *beta, double *gamma)
+{
+	// the 3-axis orders are mapped to the relative rotation once. the others go through RotationAngle::calc().
+	MathConstant::AXIS first, second, third;
+	if (order && !RotationOrder::parseOrder(order, first, second, third))
+		throw LogException(LogException::L_ERROR, "illegal parameter value", __FILE__, __LINE__, __FUNCTION__);
+
+	local::AngleCalculator calculator = NULL;
+	if (order)
+	{
+		if (RotationOrder::isFixed(order))
+		{
+			std::swap(first, third);
+			std::swap(alpha, gamma);
+		}
+		switch ((first << 8) | (second << 4) | third)
+		{
+		case 0x124:  calculator = &RotationAngle::calcRelativeXYZ;  break;
+		case 0x142:  calculator = &RotationAngle::calcRelativeXZY;  break;
+		case 0x241:  calculator = &RotationAngle::calcRelativeYZX;  break;
+		case 0x214:  calculator = &RotationAngle::calcRelativeYXZ;  break;
+		case 0x412:  calculator = &RotationAngle::calcRelativeZXY;  break;
+		case 0x421:  calculator = &RotationAngle::calcRelativeZYX;  break;
+		case 0x121:  calculator = &RotationAngle::calcRelativeXYX;  break;
+		case 0x141:  calculator = &RotationAngle::calcRelativeXZX;  break;
+		case 0x242:  calculator = &RotationAngle::calcRelativeYZY;  break;
+		case 0x212:  calculator = &RotationAngle::calcRelativeYXY;  break;
+		case 0x414:  calculator = &RotationAngle::calcRelativeZXZ;  break;
+		case 0x424:  calculator = &RotationAngle::calcRelativeZYZ;  break;
+		default:
+			// undo the swap, RotationAngle::calc() takes the order as it is.
+			if (RotationOrder::isFixed(order)) std::swap(alpha, gamma);
+			break;
+		}
+	}
+
+	double entry[9];
+	for (std::size_t n = 0; n < count; ++n)
+	{
+		for (int i = 0; i < 9; ++i) entry[i] = mats[i][n];
+		const RMatrix3<double> mat(entry);
+		if (calculator)
+			calculator(mat, alpha[n], beta[n], gamma[n]);
+		else
+		{
+			const RotationAngle angle(RotationAngle::calc(order, mat));
+			alpha[n] = angle.alpha();
+			beta[n] = angle.beta();
+			gamma[n] = angle.gamma();
+		}
+	}
+}
+
+/*static*/ void RotationArray::toQuaternion(const std::size_t count, const double * const mats[9], double * const quats[4])
+//  R = [  e0  e3  e6  ]
+//      [  e1  e4  e7  ]
+//      [  e2  e5  e8  ]
+{
+	for (std::size_t n = 0; n < count; ++n)
+	{
+		const double e0 = mats[0][n], e1 = mats[1][n], e2 = mats[2][n], e3 = mats[3][n], e4 = mats[4][n], e5 = mats[5][n], e6 = mats[6][n], e7 = mats[7][n], e8 = mats[8][n];
+		const double trace = e0 + e4 + e8;
+
+		// the largest of 4 * q0^2, 4 * q1^2, 4 * q2^2 & 4 * q3^2 is computed first, so nothing is divided by a small number.
+		double q0, q1, q2, q3;
+		if (trace >= e0 && trace >= e4 && trace >= e8)
+		{
+			const double r = std::sqrt(1.0 + trace), h = 0.5 / r;
+			q0 = 0.5 * r;  q1 = (e5 - e7) * h;  q2 = (e6 - e2) * h;  q3 = (e1 - e3) * h;
+		}
+		else if (e0 >= e4 && e0 >= e8)
+		{
+			const double r = std::sqrt(1.0 + e0 - e4 - e8), h = 0.5 / r;
+			q0 = (e5 - e7) * h;  q1 = 0.5 * r;  q2 = (e1 + e3) * h;  q3 = (e2 + e6) * h;
+		}
+		else if (e4 >= e8)
+		{
+			const double r = std::sqrt(1.0 - e0 + e4 - e8), h = 0.5 / r;
+			q0 = (e6 - e2) * h;  q1 = (e1 + e3) * h;  q2 = 0.5 * r;  q3 = (e5 + e7) * h;
+		}
+		else
+		{
+			const double r = std::sqrt(1.0 - e0 - e4 + e8), h = 0.5 / r;
+			q0 = (e1 - e3) * h;  q1 = (e2 + e6) * h;  q2 = (e5 + e7) * h;  q3 = 0.5 * r;
+		}
+
+		const double sign = q0 < 0.0 ? -1.0 : 1.0;
+		quats[0][n] = sign * q0;
+		quats[1][n] = sign * q1;
+		quats[2][n] = sign * q2;
+		quats[3][n] = sign * q3;
+	}
+}
+
+/*static*/ void RotationArray::toRotationMatrix(const std::size_t count, const double * const quats[4], double * const mats[9])
+{
+	for (std::size_t n = 0; n < count; ++n)
+	{
+		const double q0 = quats[0][n], q1 = quats[1][n], q2 = quats[2][n], q3 = quats[3][n];
+		const double norm = q0*q0 + q1*q1 + q2*q2 + q3*q3;
+		if (MathUtil::isZero(norm))
+			throw LogException(LogException::L_ERROR, "divide by zero", __FILE__, __LINE__, __FUNCTION__);
+
+		// the same as RMatrix3<double>::toRotationMatrix() of the unit quaternion.
+		const double s = 2.0 / norm;
+		mats[0][n] = 1.0 - s * (q2*q2 + q3*q3);
+		mats[1][n] = s * (q1*q2 + q0*q3);
+		mats[2][n] = s * (q1*q3 - q0*q2);
+		mats[3][n] = s * (q2*q1 - q0*q3);
+		mats[4][n] = 1.0 - s * (q1*q1 + q3*q3);
+		mats[5][n] = s * (q2*q3 + q0*q1);
+		mats[6][n] = s * (q3*q1 + q0*q2);
+		mats[7][n] = s * (q3*q2 - q0*q1);
+		mats[8][n] = 1.0 - s * (q1*q1 + q2*q2);
+	}
+}
+
+/*static*/ void RotationArray::multiply(const std::size_t count, const double * const lhs[4], const double * const rhs[4], double * const quats[4])
+{
+	for (std::size_t n = 0; n < count; ++n)
+	{
+		const double a0 = lhs[0][n], a1 = lhs[1][n], a2 = lhs[2][n], a3 = lhs[3][n];
+		const double b0 = rhs[0][n], b1 = rhs[1][n], b2 = rhs[2][n], b3 = rhs[3][n];
+		quats[0][n] = a0*b0 - a1*b1 - a2*b2 - a3*b3;
+		quats[1][n] = a0*b1 + a1*b0 + a2*b3 - a3*b2;
+		quats[2][n] = a0*b2 + a2*b0 + a3*b1 - a1*b3;
+		quats[3][n] = a0*b3 + a3*b0 + a1*b2 - a2*b1;
+	}
+}
+
+/*static*/ void RotationArray::normalize(const std::size_t count, const double * const quats[4], double * const unitQuats[4])
+{
+	for (std::size_t n = 0; n < count; ++n)
+	{
+		const double q0 = quats[0][n], q1 = quats[1][n], q2 = quats[2][n], q3 = quats[3][n];
+		const double norm = std::sqrt(q0*q0 + q1*q1 + q2*q2 + q3*q3);
+		const double scale = norm > 0.0 ? 1.0 / norm : 1.0;
+		unitQuats[0][n] = q0 * scale;
+		unitQuats[1][n] = q1 * scale;
+		unitQuats[2][n] = q2 * scale;
+		unitQuats[3][n] = q3 * scale;
+	}
+}
+
+/*static*/ void RotationArray::slerp(const std::size_t count, const double *t, const double * const uq0[4], const double * const uq1[4], double * const quats[4])
+{
+	for (std::size_t n = 0; n < count; ++n)
+	{
+		const double a0 = uq0[0][n], a1 = uq0[1][n], a2 = uq0[2][n], a3 = uq0[3][n];
+		const double b0 = uq1[0][n], b1 = uq1[1][n], b2 = uq1[2][n], b3 = uq1[3][n];
+
+		// uq0 * (uq0^-1 * uq1)^t, i.e. no shortest-path flip when uq0 . uq1 < 0.
+		const double cosTheta = std::max(-1.0, std::min(1.0, a0*b0 + a1*b1 + a2*b2 + a3*b3));
+		const double theta = std::acos(cosTheta), sinTheta = std::sin(theta);
+		double w0, w1;
+		if (sinTheta < 1.0e-8)
+		{
+			// linear interpolation for nearly the same rotation.
+			w0 = 1.0 - t[n];
+			w1 = t[n];
+		}
+		else
+		{
+			w0 = std::sin((1.0 - t[n]) * theta) / sinTheta;
+			w1 = std::sin(t[n] * theta) / sinTheta;
+		}
+
+		quats[0][n] = w0 * a0 + w1 * b0;
+		quats[1][n] = w0 * a1 + w1 * b1;
+		quats[2][n] = w0 * a2 + w1 * b2;
+		quats[3][n] = w0 * a3 + w1 * b3;
+	}
+}
+
+/*static*/ void RotationArray::sincos(const std::size_t count, const double *angle, double *s, double *c)
+{
+	for (std::size_t offset = 0; offset < count; offset += local::BLOCK_SIZE)
+		local::sincos(std::min(local::BLOCK_SIZE, count - offset), angle + offset, s + offset, c + offset);
+}
+
 }  // namespace swl
@@ -1,7 +1,8 @@
 #include "swl/Config.h"
 #include "swl/math/Statistic.h"
+#include "swl/math/StatisticAccumulator.h"
+#include "swl/math/MultivariateNormalDistribution.h"
 #include "swl/math/MathConstant.h"
-#include <Eigen/Cholesky>
 #include <algorithm>
 #include <numeric>
 #include <cmath>
@@ -180,39 +181,28 @@ namespace swl {
 {
 	if (D.cols() <= 1) return Eigen::MatrixXd::Zero(D.rows(), D.rows());
 
-	// Centered data.
-	const Eigen::MatrixXd centered(D.colwise() - D.rowwise().mean());
-	return (centered * centered.adjoint()) / double(D.cols() - 1);
+	// One pass over blocks of columns, without a centered copy of D.
+	return CovarianceAccumulator::accumulate(D).sampleCovarianceMatrix();
 }
 
 /*static*/ double Statistic::multivariateNormalDistibutionPdf(const Eigen::VectorXd &x, const Eigen::VectorXd &mean, const Eigen::MatrixXd &cov)
 // Compute p(x) at the point x using mean vector and variance-covariance matrix.
 {
-	if (x.size() != mean.size() || x.size() != cov.rows() || cov.rows() != cov.cols())
+	if (x.size() != mean.size())
 		throw std::runtime_error("Invalid vector or matrix size");
 
-	Eigen::LLT<Eigen::MatrixXd> chol(cov);
-	if (Eigen::Success != chol.info())
-		throw std::runtime_error("Cholesky decompoistion failed");
-
-	const Eigen::LLT<Eigen::MatrixXd>::Traits::MatrixL& L = chol.matrixL();
-	const double numer = std::exp(-0.5 * L.solve(x - mean).squaredNorm());
-	const double denom = std::pow(MathConstant::_2_PI, L.rows() * 0.5) * L.determinant();
-	return numer / denom;
+	// To evaluate many points, keep a MultivariateNormalDistribution instead.
+	return MultivariateNormalDistribution(mean, cov).pdf(x);
 }
 
 /*static*/ double Statistic::multivariateNormalDistibutionLogPdf(const Eigen::VectorXd &x, const Eigen::VectorXd &mean, const Eigen::MatrixXd &cov)
 // Compute log(p(x)) at the point x using mean vector and variance-covariance matrix.
 {
-	if (x.size() != mean.size() || x.size() != cov.rows() || cov.rows() != cov.cols())
+	if (x.size() != mean.size())
 		throw std::runtime_error("Invalid vector or matrix size");
 
-	Eigen::LLT<Eigen::MatrixXd> chol(cov);
-	if (Eigen::Success != chol.info())
-		throw std::runtime_error("Cholesky decompoistion failed");
-
-	const Eigen::LLT<Eigen::MatrixXd>::Traits::MatrixL& L = chol.matrixL();
-	return -0.5 * L.solve(x - mean).squaredNorm() - 0.5 * L.rows() * std::log(MathConstant::_2_PI) - std::log(L.determinant());
+	// To evaluate many points, keep a MultivariateNormalDistribution instead.
+	return MultivariateNormalDistribution(mean, cov).logPdf(x);
 }
 
 }  //  namespace swl
@@ -0,0 +1,382 @@
+#include "swl/Config.h"
+#include "swl/math/StatisticAccumulator.h"
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace swl {
+
+namespace {
+namespace local {
+
+typedef Eigen::MatrixXd::Index Index;
+
+// the number of columns centered at a time.
+const Index COVARIANCE_BLOCK_SIZE = 256;
+// the number of columns accumulated by a thread at a time.
+const Index COVARIANCE_CHUNK_SIZE = 4096;
+
+}  // namespace local
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------------------
+// StatisticAccumulator.
+
+StatisticAccumulator::StatisticAccumulator()
+: count_(0), mean_(0.0), M2_(0.0), M3_(0.0), M4_(0.0),
+  minimum_(std::numeric_limits<double>::infinity()), maximum_(-std::numeric_limits<double>::infinity())
+{
+}
+
+StatisticAccumulator::StatisticAccumulator(const std::size_t count, const double mean, const double M2, const double M3, const double M4, const double minimum, const double maximum)
+: count_(count), mean_(mean), M2_(M2), M3_(M3), M4_(M4), minimum_(minimum), maximum_(maximum)
+{
+}
+
+void StatisticAccumulator::add(const double x)
+{
+	const double n1 = double(count_);
+	const double n = double(++count_);
+	const double delta = x - mean_;
+	const double deltaN = delta / n;
+	const double deltaN2 = deltaN * deltaN;
+	const double term = delta * deltaN * n1;
+
+	mean_ += deltaN;
+	M4_ += term * deltaN2 * (n * n - 3.0 * n + 3.0) + 6.0 * deltaN2 * M2_ - 4.0 * deltaN * M3_;
+	M3_ += term * deltaN * (n - 2.0) - 3.0 * deltaN * M2_;
+	M2_ += term;
+
+	if (x < minimum_) minimum_ = x;
+	if (x > maximum_) maximum_ = x;
+}
+
+void StatisticAccumulator::add(const double *sample, const std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+		add(sample[i]);
+}
+
+void StatisticAccumulator::merge(const StatisticAccumulator &rhs)
+{
+	if (0 == rhs.count_) return;
+	if (0 == count_)
+	{
+		*this = rhs;
+		return;
+	}
+
+	const double na = double(count_), nb = double(rhs.count_);
+	const double n = na + nb;
+	const double delta = rhs.mean_ - mean_;
+	const double delta2 = delta * delta;
+	const double nab = na * nb;
+
+	const double M2 = M2_ + rhs.M2_ + delta2 * nab / n;
+	const double M3 = M3_ + rhs.M3_ + delta * delta2 * nab * (na - nb) / (n * n) + 3.0 * delta * (na * rhs.M2_ - nb * M2_) / n;
+	const double M4 = M4_ + rhs.M4_ + delta2 * delta2 * nab * (na * na - nab + nb * nb) / (n * n * n)
+		+ 6.0 * delta2 * (na * na * rhs.M2_ + nb * nb * M2_) / (n * n) + 4.0 * delta * (na * rhs.M3_ - nb * M3_) / n;
+
+	count_ += rhs.count_;
+	mean_ += delta * nb / n;
+	M2_ = M2;
+	M3_ = M3;
+	M4_ = M4;
+	minimum_ = std::min(minimum_, rhs.minimum_);
+	maximum_ = std::max(maximum_, rhs.maximum_);
+}
+
+void StatisticAccumulator::clear()
+{
+	*this = StatisticAccumulator();
+}
+
+double StatisticAccumulator::variance() const
+{
+	return count_ <= 1 ? 0.0 : M2_ / double(count_);
+}
+
+double StatisticAccumulator::sampleVariance() const
+{
+	return count_ <= 1 ? 0.0 : M2_ / double(count_ - 1);
+}
+
+double StatisticAccumulator::standardDeviation() const
+{
+	return std::sqrt(variance());
+}
+
+double StatisticAccumulator::sampleStandardDeviation() const
+{
+	return std::sqrt(sampleVariance());
+}
+
+double StatisticAccumulator::skewness() const
+// the same as Statistic::skewness() with the (population) standard deviation.
+{
+	if (count_ <= 1 || M2_ <= 0.0) return 0.0;
+	return std::sqrt(double(count_)) * M3_ / std::pow(M2_, 1.5);
+}
+
+double StatisticAccumulator::kurtosis() const
+// the same as Statistic::kurtosis() with the (population) standard deviation.
+{
+	if (count_ <= 1 || M2_ <= 0.0) return 0.0;
+	return double(count_) * M4_ / (M2_ * M2_);
+}
+
+double StatisticAccumulator::peak() const
+{
+	return 0 == count_ ? 0.0 : std::max(std::abs(minimum_), std::abs(maximum_));
+}
+
+double StatisticAccumulator::rms(const double mean) const
+{
+	if (0 == count_) return 0.0;
+
+	// sum((x - mean)^2) = M2 + n * (mean_ - mean)^2.
+	const double offset = mean_ - mean;
+	return std::sqrt(M2_ / double(count_) + offset * offset);
+}
+
+double StatisticAccumulator::crestFactor(const double mean) const
+{
+	if (0 == count_) return 0.0;
+	if (1 == count_) return 1.0;
+
+	const double &rms = StatisticAccumulator::rms(mean);
+	return rms > std::numeric_limits<double>::epsilon() ? peak() / rms : std::numeric_limits<double>::infinity();
+}
+
+//-----------------------------------------------------------------------------------------
+// CovarianceAccumulator.
+
+CovarianceAccumulator::CovarianceAccumulator(const std::size_t dim)
+: count_(0), mean_(Eigen::VectorXd::Zero(dim)), scatter_(Eigen::MatrixXd::Zero(dim, dim)),
+  minimum_(Eigen::VectorXd::Constant(dim, std::numeric_limits<double>::infinity())), maximum_(Eigen::VectorXd::Constant(dim, -std::numeric_limits<double>::infinity()))
+{
+}
+
+void CovarianceAccumulator::add(const Eigen::VectorXd &x)
+{
+	if (x.size() != mean_.size())
+		throw std::runtime_error("Invalid vector size");
+
+	const double n = double(++count_);
+	const Eigen::VectorXd delta(x - mean_);
+	mean_ += delta / n;
+	// sum += (x - mean_old) * (x - mean_new)^T = (n - 1) / n * delta * delta^T.
+	scatter_.selfadjointView<Eigen::Lower>().rankUpdate(delta, (n - 1.0) / n);
+
+	minimum_ = minimum_.cwiseMin(x);
+	maximum_ = maximum_.cwiseMax(x);
+}
+
+void CovarianceAccumulator::add(const Eigen::MatrixXd &D)
+{
+	if (D.rows() != mean_.size())
+		throw std::runtime_error("Invalid matrix size");
+
+	addColumns(D);
+}
+
+void CovarianceAccumulator::addColumns(const Eigen::Ref<const Eigen::MatrixXd> &D)
+{
+	const local::Index dim = D.rows();
+	Eigen::MatrixXd centered(dim, std::min(D.cols(), local::COVARIANCE_BLOCK_SIZE));
+	Eigen::MatrixXd scatter(dim, dim);
+	for (local::Index start = 0; start < D.cols(); start += local::COVARIANCE_BLOCK_SIZE)
+	{
+		const local::Index blockSize = std::min(local::COVARIANCE_BLOCK_SIZE, D.cols() - start);
+		const Eigen::Ref<const Eigen::MatrixXd>::ConstColsBlockXpr block(D.middleCols(start, blockSize));
+
+		const Eigen::VectorXd blockMean(block.rowwise().mean());
+		centered.leftCols(blockSize).noalias() = block.colwise() - blockMean;
+		scatter.setZero();
+		scatter.selfadjointView<Eigen::Lower>().rankUpdate(centered.leftCols(blockSize));
+
+		merge((std::size_t)blockSize, blockMean, scatter);
+		minimum_ = minimum_.cwiseMin(block.rowwise().minCoeff());
+		maximum_ = maximum_.cwiseMax(block.rowwise().maxCoeff());
+	}
+}
+
+void CovarianceAccumulator::merge(const CovarianceAccumulator &rhs)
+{
+	if (rhs.mean_.size() != mean_.size())
+		throw std::runtime_error("Invalid dimension");
+
+	merge(rhs.count_, rhs.mean_, rhs.scatter_);
+	minimum_ = minimum_.cwiseMin(rhs.minimum_);
+	maximum_ = maximum_.cwiseMax(rhs.maximum_);
+}
+
+void CovarianceAccumulator::merge(const std::size_t count, const Eigen::VectorXd &mean, const Eigen::MatrixXd &scatter)
+{
+	if (0 == count) return;
+	if (0 == count_)
+	{
+		count_ = count;
+		mean_ = mean;
+		scatter_.triangularView<Eigen::Lower>() = scatter;
+		return;
+	}
+
+	const double na = double(count_), nb = double(count);
+	const double n = na + nb;
+	const Eigen::VectorXd delta(mean - mean_);
+
+	count_ += count;
+	mean_ += delta * (nb / n);
+	scatter_.triangularView<Eigen::Lower>() += scatter;
+	scatter_.selfadjointView<Eigen::Lower>().rankUpdate(delta, na * nb / n);
+}
+
+void CovarianceAccumulator::clear()
+{
+	count_ = 0;
+	mean_.setZero();
+	scatter_.setZero();
+	minimum_.setConstant(std::numeric_limits<double>::infinity());
+	maximum_.setConstant(-std::numeric_limits<double>::infinity());
+}
+
+/*static*/ CovarianceAccumulator CovarianceAccumulator::accumulate(const Eigen::MatrixXd &D)
+{
+	const local::Index chunkNum = (D.cols() + local::COVARIANCE_CHUNK_SIZE - 1) / local::COVARIANCE_CHUNK_SIZE;
+	std::vector<CovarianceAccumulator> partials((std::size_t)chunkNum, CovarianceAccumulator((std::size_t)D.rows()));
+
+#pragma omp parallel for
+	for (int chunk = 0; chunk < (int)chunkNum; ++chunk)
+	{
+		const local::Index start = local::Index(chunk) * local::COVARIANCE_CHUNK_SIZE;
+		partials[chunk].addColumns(D.middleCols(start, std::min(local::COVARIANCE_CHUNK_SIZE, D.cols() - start)));
+	}
+
+	// merged in order, so the result doesn't depend on the number of threads.
+	CovarianceAccumulator accumulator((std::size_t)D.rows());
+	for (std::vector<CovarianceAccumulator>::const_iterator it = partials.begin(); it != partials.end(); ++it)
+		accumulator.merge(*it);
+	return accumulator;
+}
+
+Eigen::MatrixXd CovarianceAccumulator::getSymmetricScatter() const
+{
+	return Eigen::MatrixXd(scatter_.selfadjointView<Eigen::Lower>());
+}
+
+Eigen::VectorXd CovarianceAccumulator::sampleVariance() const
+{
+	if (count_ <= 1) return Eigen::VectorXd::Zero(mean_.size());
+	return scatter_.diagonal() / double(count_ - 1);
+}
+
+Eigen::MatrixXd CovarianceAccumulator::covarianceMatrix() const
+{
+	if (count_ <= 1) return Eigen::MatrixXd::Zero(mean_.size(), mean_.size());
+	return getSymmetricScatter() / double(count_);
+}
+
+Eigen::MatrixXd CovarianceAccumulator::sampleCovarianceMatrix() const
+{
+	if (count_ <= 1) return Eigen::MatrixXd::Zero(mean_.size(), mean_.size());
+	return getSymmetricScatter() / double(count_ - 1);
+}
+
+//-----------------------------------------------------------------------------------------
+// SlidingStatisticAccumulator.
+
+SlidingStatisticAccumulator::SlidingStatisticAccumulator(const std::size_t windowSize)
+: windowSize_(windowSize), ring_(windowSize, 0.0), head_(0), count_(0), updateCount_(0), sequence_(0),
+  shift_(0.0), minQueue_(), maxQueue_()
+{
+	if (0 == windowSize_)
+		throw std::runtime_error("Invalid window size");
+
+	std::fill(sums_, sums_ + 4, 0.0);
+}
+
+void SlidingStatisticAccumulator::add(const double x)
+{
+	if (0 == count_) shift_ = x;
+
+	if (isFull())
+	{
+		const double y = ring_[head_] - shift_, y2 = y * y;
+		sums_[0] -= y;
+		sums_[1] -= y2;
+		sums_[2] -= y2 * y;
+		sums_[3] -= y2 * y2;
+	}
+	else ++count_;
+
+	ring_[head_] = x;
+	head_ = (head_ + 1) % windowSize_;
+
+	const double y = x - shift_, y2 = y * y;
+	sums_[0] += y;
+	sums_[1] += y2;
+	sums_[2] += y2 * y;
+	sums_[3] += y2 * y2;
+
+	// the ascending minima & the descending maxima.
+	const std::size_t oldest = sequence_ + 1 - count_;
+	while (!minQueue_.empty() && minQueue_.back().second >= x) minQueue_.pop_back();
+	minQueue_.push_back(std::make_pair(sequence_, x));
+	while (minQueue_.front().first < oldest) minQueue_.pop_front();
+	while (!maxQueue_.empty() && maxQueue_.back().second <= x) maxQueue_.pop_back();
+	maxQueue_.push_back(std::make_pair(sequence_, x));
+	while (maxQueue_.front().first < oldest) maxQueue_.pop_front();
+	++sequence_;
+
+	if (++updateCount_ >= windowSize_)
+		recomputeSums();
+}
+
+void SlidingStatisticAccumulator::clear()
+{
+	head_ = count_ = updateCount_ = sequence_ = 0;
+	shift_ = 0.0;
+	std::fill(sums_, sums_ + 4, 0.0);
+	minQueue_.clear();
+	maxQueue_.clear();
+}
+
+void SlidingStatisticAccumulator::recomputeSums()
+{
+	// shift to the current mean so that the sums stay small.
+	shift_ = mean();
+	std::fill(sums_, sums_ + 4, 0.0);
+	for (std::size_t i = 0; i < count_; ++i)
+	{
+		const double y = ring_[(head_ + windowSize_ - 1 - i) % windowSize_] - shift_, y2 = y * y;
+		sums_[0] += y;
+		sums_[1] += y2;
+		sums_[2] += y2 * y;
+		sums_[3] += y2 * y2;
+	}
+	updateCount_ = 0;
+}
+
+StatisticAccumulator SlidingStatisticAccumulator::getStatistic() const
+{
+	if (0 == count_) return StatisticAccumulator();
+
+	// the central moments from the sums of the powers of y = x - shift, with m = mean(y).
+	const double n = double(count_);
+	const double m = sums_[0] / n, m2 = m * m;
+	const double M2 = std::max(0.0, sums_[1] - n * m2);
+	const double M3 = sums_[2] - 3.0 * m * sums_[1] + 2.0 * n * m2 * m;
+	const double M4 = std::max(0.0, sums_[3] - 4.0 * m * sums_[2] + 6.0 * m2 * sums_[1] - 3.0 * n * m2 * m2);
+	return StatisticAccumulator(count_, shift_ + m, M2, M3, M4, minQueue_.front().second, maxQueue_.front().second);
+}
+
+}  // namespace swl
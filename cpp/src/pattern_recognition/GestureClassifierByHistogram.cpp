@@ -97,7 +97,7 @@ const std::string windowNameForVerticalOrientationHistogram("gesture recognition
 GestureClassifierByHistogram::GestureClassifierByHistogram(const Params &params)
 : base_type(),
   params_(params),
-  refFullPhaseHistograms_(),
+  refFullPhaseHistograms_(), refFullPhaseHistogramMatcher_(),
   refHistogramsForClass1Gesture_(), refHistogramsForClass2Gesture_(), refHistogramsForClass3Gesture_(),
   gestureIdPatternHistogramsForClass1Gesture_(),
   histogramAccumulatorForClass1Gesture_(params_.doesApplyTimeWeighting ? new HistogramAccumulator(local::getHistogramTimeWeight(params_.accumulatedHistogramNumForClass1Gesture)) : new HistogramAccumulator(params_.accumulatedHistogramNumForClass1Gesture)),
@@ -116,7 +116,7 @@ GestureClassifierByHistogram::GestureClassifierByHistogram(const Params &params)
 GestureClassifierByHistogram::GestureClassifierByHistogram(const GestureClassifierByHistogram &rhs)
 : base_type(),
   params_(rhs.params_),
-  refFullPhaseHistograms_(rhs.refFullPhaseHistograms_),
+  refFullPhaseHistograms_(rhs.refFullPhaseHistograms_), refFullPhaseHistogramMatcher_(rhs.refFullPhaseHistogramMatcher_),
   refHistogramsForClass1Gesture_(rhs.refHistogramsForClass1Gesture_), refHistogramsForClass2Gesture_(rhs.refHistogramsForClass2Gesture_), refHistogramsForClass3Gesture_(rhs.refHistogramsForClass3Gesture_),
   gestureIdPatternHistogramsForClass1Gesture_(rhs.gestureIdPatternHistogramsForClass1Gesture_),
   histogramAccumulatorForClass1Gesture_(rhs.histogramAccumulatorForClass1Gesture_), histogramAccumulatorForClass2Gesture_(rhs.histogramAccumulatorForClass2Gesture_), histogramAccumulatorForClass3Gesture_(rhs.histogramAccumulatorForClass3Gesture_),
@@ -142,6 +142,7 @@ GestureClassifierByHistogram & GestureClassifierByHistogram::operator=(const Ges
 
 	params_ = rhs.params_;
 	refFullPhaseHistograms_.assign(rhs.refFullPhaseHistograms_.begin(), rhs.refFullPhaseHistograms_.end());
+	refFullPhaseHistogramMatcher_ = rhs.refFullPhaseHistogramMatcher_;
 	refHistogramsForClass1Gesture_.assign(rhs.refHistogramsForClass1Gesture_.begin(), rhs.refHistogramsForClass1Gesture_.end());
 	refHistogramsForClass2Gesture_.assign(rhs.refHistogramsForClass2Gesture_.begin(), rhs.refHistogramsForClass2Gesture_.end());
 	refHistogramsForClass3Gesture_.assign(rhs.refHistogramsForClass3Gesture_.begin(), rhs.refHistogramsForClass3Gesture_.end());
@@ -209,7 +210,7 @@ bool GestureClassifierByHistogram::classifyClass1Gesture()
 	{
 		// FIXME [restore] >> have to decide which one is used
 		//cv::MatND &temporalHist = histogramAccumulatorForClass1Gesture_->createTemporalHistogram();
-		cv::MatND temporalHist(histogramAccumulatorForClass1Gesture_->createTemporalHistogram(refFullPhaseHistograms_, params_.histDistThresholdForClass1Gesture));
+		cv::MatND temporalHist(histogramAccumulatorForClass1Gesture_->createTemporalHistogram(refFullPhaseHistograms_, *refFullPhaseHistogramMatcher_, params_.histDistThresholdForClass1Gesture));
 		// normalize histogram
 		HistogramUtil::normalizeHistogram(temporalHist, local::refHistogramNormalizationFactor);
 
@@ -604,6 +605,7 @@ void GestureClassifierByHistogram::createReferenceFullPhaseHistograms()
 	const std::vector<cv::MatND> &refHistograms = refHistogramGenerator.getHistograms();
 
 	refFullPhaseHistograms_.assign(refHistograms.begin(), refHistograms.end());
+	refFullPhaseHistogramMatcher_.reset(new PackedHistogramMatcher(refFullPhaseHistograms_, PackedHistogramMatcher::BHATTACHARYYA));
 
 #if 0
 	// FIXME [delete] >>
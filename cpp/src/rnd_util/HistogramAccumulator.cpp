@@ -1,47 +1,142 @@
 #include "swl/rnd_util/HistogramAccumulator.h"
-#include "swl/rnd_util/HistogramMatcher.h"
+#include "swl/rnd_util/HistogramMatcher.h"
 #include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include <cmath>
 
 
 namespace swl {
 
+namespace {
+namespace local {
+
+// check if weights[i] = weights[0] * ratio^i.
+bool isGeometric(const std::vector<float> &weights, double &ratio)
+{
+	ratio = 1.0;
+	if (weights.empty() || 0.0f == weights[0]) return false;
+	if (weights.size() > 1) ratio = (double)weights[1] / (double)weights[0];
+
+	const double tol = 1.0e-4;
+	for (size_t i = 1; i < weights.size(); ++i)
+	{
+		const double expected = (double)weights[i - 1] * ratio;
+		if (std::fabs((double)weights[i] - expected) > tol * std::fabs(expected) + std::numeric_limits<float>::min())
+			return false;
+	}
+	return true;
+}
+
+}  // namespace local
+}  // unnamed namespace
+
 //-----------------------------------------------------------------------------
 //
 
 HistogramAccumulator::HistogramAccumulator(const size_t histogramNum)
-: histogramNum_(histogramNum), weights_(), histograms_(histogramNum_)
+: histogramNum_(histogramNum), mode_(UNIFORM_WEIGHTING), weights_(), decay_(1.0), scale_(1.0), evictedWeight_(1.0),
+  ring_(), histSizes_(), histType_(-1), head_(0), count_(0), updateCount_(0), sum_(), temporalHistogram_()
 {
 }
 
 HistogramAccumulator::HistogramAccumulator(const std::vector<float> &weights)
-: histogramNum_(weights.size()), weights_(weights), histograms_(histogramNum_)
+: histogramNum_(weights.size()), mode_(KERNEL_WEIGHTING), weights_(weights), decay_(1.0), scale_(1.0), evictedWeight_(1.0),
+  ring_(), histSizes_(), histType_(-1), head_(0), count_(0), updateCount_(0), sum_(), temporalHistogram_()
+{
+	if (weights_.empty())
+		throw std::runtime_error("the 1st parameter is empty");
+
+	double ratio = 1.0;
+	if (local::isGeometric(weights_, ratio))
+	{
+		mode_ = EXPONENTIAL_WEIGHTING;
+		decay_ = ratio;
+		scale_ = weights_[0];
+		evictedWeight_ = std::pow(decay_, (double)(histogramNum_ - 1));
+	}
+}
+
+HistogramAccumulator::HistogramAccumulator(const size_t histogramNum, const double decay, const double scale /*= 1.0*/)
+: histogramNum_(histogramNum), mode_(EXPONENTIAL_WEIGHTING), weights_(), decay_(decay), scale_(scale), evictedWeight_(histogramNum ? std::pow(decay, (double)(histogramNum - 1)) : 1.0),
+  ring_(), histSizes_(), histType_(-1), head_(0), count_(0), updateCount_(0), sum_(), temporalHistogram_()
+{
+}
+
+void HistogramAccumulator::addHistogram(const cv::MatND &hist)
 {
-	if (weights_.size() != histogramNum_)
-		throw std::runtime_error("the size of the 2nd parameter is mismatched");
+	if (0 == histogramNum_ || hist.empty()) return;
+	CV_Assert(1 == hist.channels());
+
+	// a histogram of another shape or type starts a new accumulation.
+	if (ring_.empty() || hist.type() != histType_ || hist.dims != (int)histSizes_.size() || !std::equal(histSizes_.begin(), histSizes_.end(), hist.size.p))
+		reallocate(hist);
+
+	const cv::Mat src(hist.isContinuous() ? hist : hist.clone());
+	const cv::Mat flat(1, ring_.cols, histType_, src.data);
+	cv::Mat slot(ring_.row((int)head_));
+
+	const bool isIncremental = KERNEL_WEIGHTING != mode_;
+	if (isIncremental && isFull())
+		cv::addWeighted(sum_, 1.0, slot, -evictedWeight_, 0.0, sum_, CV_64F);
+
+	flat.copyTo(slot);
+	if (isIncremental)
+		cv::addWeighted(sum_, decay_, slot, 1.0, 0.0, sum_, CV_64F);
+
+	head_ = (head_ + 1) % histogramNum_;
+	if (count_ < histogramNum_) ++count_;
+
+	if (isIncremental && ++updateCount_ >= histogramNum_)
+		recomputeSum();
+}
+
+void HistogramAccumulator::clearAllHistograms()
+{
+	head_ = count_ = updateCount_ = 0;
+	if (!sum_.empty()) sum_.setTo(cv::Scalar::all(0));
+}
+
+void HistogramAccumulator::reallocate(const cv::MatND &hist)
+{
+	histType_ = hist.type();
+	histSizes_.assign(hist.size.p, hist.size.p + hist.dims);
+
+	const int binNum = (int)hist.total();
+	ring_.create((int)histogramNum_, binNum, histType_);
+	sum_.create(1, binNum, CV_64F);
+	temporalHistogram_.release();
+
+	clearAllHistograms();
+}
+
+void HistogramAccumulator::recomputeSum()
+{
+	sum_.setTo(cv::Scalar::all(0));
+	double weight = 1.0;
+	for (size_t age = 0; age < count_; ++age, weight *= decay_)
+		cv::addWeighted(sum_, 1.0, ring_.row((int)getSlot(age)), weight, 0.0, sum_, CV_64F);
+	updateCount_ = 0;
 }
 
 cv::MatND HistogramAccumulator::createAccumulatedHistogram() const
 {
-	cv::MatND accumulatedHistogram;
+	if (0 == count_) return cv::MatND();
 
-	if (weights_.empty())
+	cv::MatND accumulatedHistogram((int)histSizes_.size(), &histSizes_[0], histType_);
+	cv::Mat flat(1, ring_.cols, histType_, accumulatedHistogram.data);
+	if (KERNEL_WEIGHTING == mode_)
 	{
-		// simple running averaging
-		for (boost::circular_buffer<histogram_type>::const_iterator it = histograms_.begin(); it != histograms_.end(); ++it)
-		{
-			if (accumulatedHistogram.empty()) accumulatedHistogram = *it;
-			else accumulatedHistogram += *it;
-		}
+		// weighted averaging
+		cv::Mat sum(cv::Mat::zeros(1, ring_.cols, CV_64F));
+		for (size_t age = 0; age < count_; ++age)
+			cv::addWeighted(sum, 1.0, ring_.row((int)getSlot(age)), weights_[age], 0.0, sum, CV_64F);
+		sum.convertTo(flat, histType_);
 	}
 	else
 	{
-		// weighted averaging
-		size_t step = 0;
-		for (boost::circular_buffer<histogram_type>::const_reverse_iterator rit = histograms_.rbegin(); rit != histograms_.rend(); ++rit, ++step)
-		{
-			if (accumulatedHistogram.empty()) accumulatedHistogram = (*rit) * weights_[step];
-			else accumulatedHistogram += (*rit) * weights_[step];
-		}
+		// running sum
+		sum_.convertTo(flat, histType_, scale_);
 	}
 
 	return accumulatedHistogram;
@@ -49,51 +144,53 @@ cv::MatND HistogramAccumulator::createAccumulatedHistogram() const
 
 cv::MatND HistogramAccumulator::createTemporalHistogram() const
 {
-	if (histograms_.empty()) return cv::MatND();
+	if (0 == count_) return cv::MatND();
 
-	cv::MatND temporalHistogram(cv::Mat::zeros(histograms_.front().rows, histograms_.size(), histograms_.front().type()));
+	temporalHistogram_.create(ring_.cols, (int)histogramNum_, histType_);
 
-	size_t k = 0;
-	for (boost::circular_buffer<histogram_type>::const_iterator it = histograms_.begin(); it != histograms_.end(); ++it, ++k)
+	// the oldest histogram is in slot head_ if the ring is full, or in slot 0 otherwise.
+	const int N = (int)histogramNum_, head = (int)head_;
+	if (isFull() && head > 0)
 	{
-#if defined(__GNUC__)
-        cv::Mat col(temporalHistogram.col(k));
-		it->copyTo(col);
-#else
-		//temporalHistogram.col(k) = *it;  // not working
-		it->copyTo(temporalHistogram.col(k));
-#endif
+		cv::Mat older(temporalHistogram_.colRange(0, N - head)), newer(temporalHistogram_.colRange(N - head, N));
+		cv::transpose(ring_.rowRange(head, N), older);
+		cv::transpose(ring_.rowRange(0, head), newer);
+	}
+	else
+	{
+		cv::Mat dst(temporalHistogram_.colRange(0, (int)count_));
+		cv::transpose(ring_.rowRange(0, (int)count_), dst);
 	}
 
-	return temporalHistogram;
+	return temporalHistogram_.colRange(0, (int)count_);
 }
 
-cv::MatND HistogramAccumulator::createTemporalHistogram(const std::vector<histogram_type> &refHistograms, const double histDistThreshold) const
+cv::MatND HistogramAccumulator::createTemporalHistogram(const std::vector<histogram_type> &refHistograms, const PackedHistogramMatcher &refMatcher, const double histDistThreshold) const
 {
-	if (histograms_.empty() || refHistograms.empty()) return cv::MatND();
+	if (0 == count_ || refHistograms.empty()) return cv::MatND();
+	if (refMatcher.getReferenceCount() != refHistograms.size())
+		throw std::runtime_error("the matcher isn't packed from the reference histograms");
 
-	cv::MatND temporalHistogram(cv::Mat::zeros(histograms_.front().rows, histograms_.size(), histograms_.front().type()));
+	temporalHistogram_.create(ring_.cols, (int)histogramNum_, histType_);
+	temporalHistogram_.setTo(cv::Scalar::all(0));
 
-	size_t k = 0;
-	for (boost::circular_buffer<histogram_type>::const_iterator it = histograms_.begin(); it != histograms_.end(); ++it, ++k)
-	{
-		// match histogram
-		double minHistDist = std::numeric_limits<double>::max();
-		const size_t &matchedIdx = HistogramMatcher::match(refHistograms, *it, minHistDist);
+	// match all the stored histograms at once. row i of the queries is the histogram in slot i.
+	std::vector<size_t> matchedIndexes;
+	std::vector<double> bestScores;
+	refMatcher.match(ring_.rowRange(0, (int)count_), matchedIndexes, bestScores);
 
-		if (minHistDist < histDistThreshold)
+	const bool isSimilarity = PackedHistogramMatcher::isSimilarity(refMatcher.getMetric());
+	for (size_t k = 0; k < count_; ++k)
+	{
+		const size_t slot = getSlot(count_ - 1 - k);
+		if (isSimilarity ? bestScores[slot] > histDistThreshold : bestScores[slot] < histDistThreshold)
 		{
-#if defined(__GNUC__)
-            cv::Mat col(temporalHistogram.col(k));
-			refHistograms[matchedIdx].copyTo(col);
-#else
-			//temporalHistogram.col(k) = refHistograms[matchedIdx];  // not working
-			refHistograms[matchedIdx].copyTo(temporalHistogram.col(k));
-#endif
+			cv::Mat col(temporalHistogram_.col((int)k));
+			refHistograms[matchedIndexes[slot]].reshape(0, ring_.cols).copyTo(col);
 		}
 	}
 
-	return temporalHistogram;
+	return temporalHistogram_.colRange(0, (int)count_);
 }
 
 }  // namespace swl
@@ -2,27 +2,282 @@
 #define CV_NO_BACKWARD_COMPATIBILITY
 #include <opencv2/highgui/highgui.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include <cfloat>
+#include <cmath>
 
 
 namespace swl {
 
+namespace {
+namespace local {
+
+// a (1 x bins) CV_64F copy of a histogram.
+void packHistogram(const cv::MatND &hist, const size_t binCount, double *dst)
+{
+	if (hist.total() != binCount || 1 != hist.channels())
+		throw std::runtime_error("the number of bins is mismatched");
+
+	const cv::Mat src(hist.isContinuous() ? hist : hist.clone());
+	cv::Mat packed(1, (int)binCount, CV_64F, dst);
+	cv::Mat(1, (int)binCount, src.type(), src.data).convertTo(packed, CV_64F);
+}
+
+struct ScoreComparator
+{
+public:
+	ScoreComparator(const double *scores, const bool isSimilarity)
+	: scores_(scores), isSimilarity_(isSimilarity)
+	{}
+
+	bool operator()(const size_t lhs, const size_t rhs) const
+	{
+		if (scores_[lhs] != scores_[rhs])
+			return isSimilarity_ ? scores_[lhs] > scores_[rhs] : scores_[lhs] < scores_[rhs];
+		return lhs < rhs;
+	}
+
+private:
+	const double *scores_;
+	const bool isSimilarity_;
+};
+
+}  // namespace local
+}  // unnamed namespace
+
 //-----------------------------------------------------------------------------
 //
 
 /*static*/ size_t HistogramMatcher::match(const std::vector<histogram_type> &refHistograms, const cv::MatND &hist, double &minDist)
 {
-	std::vector<double> dists;
-	dists.reserve(refHistograms.size());
+	size_t minIdx = 0;
+	minDist = std::numeric_limits<double>::max();
 	for (std::vector<histogram_type>::const_iterator it = refHistograms.begin(); it != refHistograms.end(); ++it)
+	{
 		// correlation: CV_COMP_CORREL
 		// chi-square statistic: CV_COMP_CHISQR
 		// intersection: CV_COMP_INTERSECT
 		// Bhattacharyya distance: CV_COMP_BHATTACHARYYA
-		dists.push_back(cv::compareHist(hist, *it, CV_COMP_BHATTACHARYYA));
+		const double dist = cv::compareHist(hist, *it, CV_COMP_BHATTACHARYYA);
+		if (dist < minDist)
+		{
+			minDist = dist;
+			minIdx = (size_t)std::distance(refHistograms.begin(), it);
+		}
+	}
+
+	return minIdx;
+}
+
+//-----------------------------------------------------------------------------
+//
+
+PackedHistogramMatcher::PackedHistogramMatcher(const Metric metric /*= BHATTACHARYYA*/)
+: metric_(metric), refCount_(0), binCount_(0), refs_(), refTerms_(), refSums_(), refNorms_()
+{
+}
+
+PackedHistogramMatcher::PackedHistogramMatcher(const std::vector<histogram_type> &refHistograms, const Metric metric /*= BHATTACHARYYA*/)
+: metric_(metric), refCount_(0), binCount_(0), refs_(), refTerms_(), refSums_(), refNorms_()
+{
+	setReferenceHistograms(refHistograms);
+}
+
+void PackedHistogramMatcher::setReferenceHistograms(const std::vector<histogram_type> &refHistograms)
+{
+	refCount_ = refHistograms.size();
+	binCount_ = refHistograms.empty() ? 0 : refHistograms.front().total();
+	refs_.resize(refCount_ * binCount_);
+	refTerms_.clear();
+	refSums_.assign(refCount_, 0.0);
+	refNorms_.clear();
+	if (refs_.empty()) return;
+
+	for (size_t r = 0; r < refCount_; ++r)
+		local::packHistogram(refHistograms[r], binCount_, &refs_[r * binCount_]);
+
+	const cv::Mat refs((int)refCount_, (int)binCount_, CV_64F, &refs_[0]);
+	if (BHATTACHARYYA == metric_ || CHI_SQUARE == metric_)
+	{
+		refTerms_.resize(refs_.size());
+		cv::Mat terms((int)refCount_, (int)binCount_, CV_64F, &refTerms_[0]);
+		if (BHATTACHARYYA == metric_) cv::sqrt(refs, terms);
+		else cv::multiply(refs, refs, terms);
+	}
+
+	for (size_t r = 0; r < refCount_; ++r)
+		refSums_[r] = cv::sum(refs.row((int)r))[0];
+
+	if (CORRELATION == metric_)
+	{
+		refNorms_.resize(refCount_);
+		for (size_t r = 0; r < refCount_; ++r)
+			refNorms_[r] = refs.row((int)r).dot(refs.row((int)r)) - refSums_[r] * refSums_[r] / (double)binCount_;
+	}
+}
+
+void PackedHistogramMatcher::computeScores(const cv::MatND &hist, std::vector<double> &scores) const
+{
+	scores.resize(refCount_);
+	if (0 == refCount_) return;
+
+	std::vector<double> query(binCount_);
+	local::packHistogram(hist, binCount_, &query[0]);
+
+	cv::Mat scoreRow(1, (int)refCount_, CV_64F, &scores[0]);
+	computeScores(cv::Mat(1, (int)binCount_, CV_64F, &query[0]), scoreRow);
+}
+
+void PackedHistogramMatcher::computeScores(const cv::Mat &queries, cv::Mat &scores) const
+{
+	if (0 == refCount_ || queries.empty())
+	{
+		scores.release();
+		return;
+	}
+	if ((size_t)queries.cols != binCount_ || 1 != queries.channels())
+		throw std::runtime_error("the number of bins is mismatched");
+
+	cv::Mat q;
+	queries.convertTo(q, CV_64F);
+
+	const int queryCount = q.rows;
+	scores.create(queryCount, (int)refCount_, CV_64F);
+
+	const cv::Mat refs((int)refCount_, (int)binCount_, CV_64F, const_cast<double *>(&refs_[0]));
+	switch (metric_)
+	{
+	case CORRELATION:
+		// (s12 - s1 * s2 / n) / sqrt((s11 - s1^2 / n) * (s22 - s2^2 / n)).
+		cv::gemm(q, refs, 1.0, cv::Mat(), 0.0, scores, cv::GEMM_2_T);
+		for (int i = 0; i < queryCount; ++i)
+		{
+			const double s1 = cv::sum(q.row(i))[0];
+			const double norm1 = q.row(i).dot(q.row(i)) - s1 * s1 / (double)binCount_;
+			double *score = scores.ptr<double>(i);
+			for (size_t r = 0; r < refCount_; ++r)
+			{
+				const double denom2 = norm1 * refNorms_[r];
+				score[r] = std::fabs(denom2) > DBL_EPSILON ? (score[r] - s1 * refSums_[r] / (double)binCount_) / std::sqrt(denom2) : 1.0;
+			}
+		}
+		break;
+	case CHI_SQUARE:
+		{
+			// sum of (q - r)^2 / q over the nonzero bins of q = sum of (q - 2 * r + r^2 / q).
+			cv::Mat mask(q.size(), CV_64F), inv(q.size(), CV_64F);
+			std::vector<double> qSums(queryCount, 0.0);
+			for (int i = 0; i < queryCount; ++i)
+			{
+				const double *qi = q.ptr<double>(i);
+				double *mi = mask.ptr<double>(i), *ii = inv.ptr<double>(i);
+				for (size_t j = 0; j < binCount_; ++j)
+				{
+					const bool isNonzero = std::fabs(qi[j]) > DBL_EPSILON;
+					mi[j] = isNonzero ? 1.0 : 0.0;
+					ii[j] = isNonzero ? 1.0 / qi[j] : 0.0;
+					if (isNonzero) qSums[i] += qi[j];
+				}
+			}
+
+			const cv::Mat refSquares((int)refCount_, (int)binCount_, CV_64F, const_cast<double *>(&refTerms_[0]));
+			cv::Mat squareTerms;
+			cv::gemm(inv, refSquares, 1.0, cv::Mat(), 0.0, squareTerms, cv::GEMM_2_T);
+			cv::gemm(mask, refs, -2.0, squareTerms, 1.0, scores, cv::GEMM_2_T);
+			for (int i = 0; i < queryCount; ++i)
+				scores.row(i) += qSums[i];
+		}
+		break;
+	case INTERSECTION:
+		for (int i = 0; i < queryCount; ++i)
+		{
+			const double *qi = q.ptr<double>(i);
+			double *score = scores.ptr<double>(i);
+			for (size_t r = 0; r < refCount_; ++r)
+			{
+				const double *ref = &refs_[r * binCount_];
+				double sum = 0.0;
+				for (size_t j = 0; j < binCount_; ++j)
+					sum += std::min(qi[j], ref[j]);
+				score[r] = sum;
+			}
+		}
+		break;
+	case BHATTACHARYYA:
+		{
+			// sqrt(1 - sum of sqrt(q * r) / sqrt(s1 * s2)).
+			cv::Mat sqrtQ;
+			cv::sqrt(q, sqrtQ);
+			const cv::Mat sqrtRefs((int)refCount_, (int)binCount_, CV_64F, const_cast<double *>(&refTerms_[0]));
+			cv::gemm(sqrtQ, sqrtRefs, 1.0, cv::Mat(), 0.0, scores, cv::GEMM_2_T);
+			for (int i = 0; i < queryCount; ++i)
+			{
+				const double s1 = cv::sum(q.row(i))[0];
+				double *score = scores.ptr<double>(i);
+				for (size_t r = 0; r < refCount_; ++r)
+				{
+					const double s12 = s1 * refSums_[r];
+					const double scale = std::fabs(s12) > FLT_EPSILON ? 1.0 / std::sqrt(s12) : 1.0;
+					score[r] = std::sqrt(std::max(1.0 - score[r] * scale, 0.0));
+				}
+			}
+		}
+		break;
+	}
+}
+
+size_t PackedHistogramMatcher::match(const cv::MatND &hist, double &bestScore) const
+{
+	if (0 == refCount_) return (size_t)-1;
+
+	std::vector<double> scores;
+	computeScores(hist, scores);
+
+	const std::vector<double>::iterator itBest = isSimilarity(metric_) ? std::max_element(scores.begin(), scores.end()) : std::min_element(scores.begin(), scores.end());
+	bestScore = *itBest;
+	return (size_t)std::distance(scores.begin(), itBest);
+}
+
+void PackedHistogramMatcher::match(const cv::Mat &queries, std::vector<size_t> &matchedIndexes, std::vector<double> &bestScores) const
+{
+	cv::Mat scores;
+	computeScores(queries, scores);
+
+	matchedIndexes.assign(queries.rows, (size_t)-1);
+	bestScores.assign(queries.rows, isSimilarity(metric_) ? -std::numeric_limits<double>::max() : std::numeric_limits<double>::max());
+	if (scores.empty()) return;
+
+	for (int i = 0; i < scores.rows; ++i)
+	{
+		const double *score = scores.ptr<double>(i);
+		const double *best = isSimilarity(metric_) ? std::max_element(score, score + refCount_) : std::min_element(score, score + refCount_);
+		matchedIndexes[i] = (size_t)(best - score);
+		bestScores[i] = *best;
+	}
+}
+
+void PackedHistogramMatcher::match(const cv::MatND &hist, const size_t k, std::vector<size_t> &matchedIndexes, std::vector<double> &scores) const
+{
+	matchedIndexes.clear();
+	scores.clear();
+	if (0 == refCount_ || 0 == k) return;
+
+	std::vector<double> allScores;
+	computeScores(hist, allScores);
+
+	std::vector<size_t> indexes(refCount_);
+	for (size_t r = 0; r < refCount_; ++r)
+		indexes[r] = r;
+
+	const size_t count = std::min(k, refCount_);
+	std::partial_sort(indexes.begin(), indexes.begin() + count, indexes.end(), local::ScoreComparator(&allScores[0], isSimilarity(metric_)));
 
-	std::vector<double>::iterator itMin = std::min_element(dists.begin(), dists.end());
-	minDist = *itMin;
-	return (size_t)std::distance(dists.begin(), itMin);
+	matchedIndexes.assign(indexes.begin(), indexes.begin() + count);
+	scores.reserve(count);
+	for (size_t i = 0; i < count; ++i)
+		scores.push_back(allScores[matchedIndexes[i]]);
 }
 
 }  // namespace swl
@@ -1,5 +1,12 @@
 #include "swl/Config.h"
 #include "swl/rnd_util/SignalProcessing.h"
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+#if defined(_WIN64) || defined(_WIN32)
+#define _USE_MATH_DEFINES
+#include <math.h>
+#endif
 
 
 #if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
@@ -16,37 +23,274 @@ namespace swl {
 // REF [function] >> filter() in Matlab.
 /*static*/ void SignalProcessing::filter(const std::vector<double> &a, const std::vector<double> &b, const std::vector<double> &x, std::vector<double> &y)
 {
-	// a[0] * y[n] = b[0] * x[n] + b[1] * x[n - 1] + ... + b[nb] * x[n - nb] - a[1] * y[n - 1] - ... - a[na] * y[n - na].
+	// a[0] * y[n] = b[0] * x[n] + b[1] * x[n - 1] + ... + b[nb - 1] * x[n - nb + 1] - a[1] * y[n - 1] - ... - a[na - 1] * y[n - na + 1].
+
+	y.resize(x.size());
+	if (x.empty()) return;
+
+	LinearFilter filter(a, b);
+	filter.process(&x[0], &y[0], x.size());
+}
 
-	const size_t na = a.size();
-	const size_t nb = b.size();
-	const size_t nx = x.size();
+//--------------------------------------------------------------------------
+// Direct form II transposed IIR/FIR filter.
 
-	y.reserve(nx);
-	if (na == nb)
+LinearFilter::LinearFilter(const std::vector<double> &a, const std::vector<double> &b, const size_t numChannels /*= 1*/)
+: numChannels_(numChannels), order_(0), a_(), b_(), z_(), x_(numChannels)
+{
+	if (a.empty() || 0.0 == a[0] || b.empty() || 0 == numChannels)
+		throw std::invalid_argument("invalid filter coefficients");
+
+	order_ = std::max(a.size(), b.size()) - 1;
+	a_.assign(order_ + 1, 0.0);
+	b_.assign(order_ + 1, 0.0);
+	for (size_t i = 0; i < a.size(); ++i)
+		a_[i] = a[i] / a[0];
+	for (size_t i = 0; i < b.size(); ++i)
+		b_[i] = b[i] / a[0];
+
+	z_.assign(order_ * numChannels_, 0.0);
+}
+
+void LinearFilter::reset()
+{
+	std::fill(z_.begin(), z_.end(), 0.0);
+}
+
+void LinearFilter::process(const double *x, double *y, const size_t numFrames)
+{
+	const size_t C = numChannels_;
+	const double b0 = b_[0];
+	double *xv = &x_[0];
+
+	for (size_t n = 0; n < numFrames; ++n)
 	{
-		for (size_t n = 0; n < nx; ++n)
+		const double *xn = x + n * C;
+		double *yn = y + n * C;
+		for (size_t ch = 0; ch < C; ++ch)
+			xv[ch] = xn[ch];
+
+		if (0 == order_)
 		{
-			double sum = b[0] * x[n];
-			for (size_t i = 1; i <= nb && i <= n; ++i)
-				sum += b[i] * x[n - i] - a[i] * y[n - i];
+			for (size_t ch = 0; ch < C; ++ch)
+				yn[ch] = b0 * xv[ch];
+			continue;
+		}
+
+		// y[n] = b[0] * x[n] + z[0].
+		double *z = &z_[0];
+		for (size_t ch = 0; ch < C; ++ch)
+			yn[ch] = b0 * xv[ch] + z[ch];
+
+		// z[k] = b[k + 1] * x[n] + z[k + 1] - a[k + 1] * y[n].
+		for (size_t k = 0; k + 1 < order_; ++k, z += C)
+		{
+			const double bk = b_[k + 1], ak = a_[k + 1];
+			const double *zNext = z + C;
+			for (size_t ch = 0; ch < C; ++ch)
+				z[ch] = bk * xv[ch] + zNext[ch] - ak * yn[ch];
+		}
+		const double bk = b_[order_], ak = a_[order_];
+		for (size_t ch = 0; ch < C; ++ch)
+			z[ch] = bk * xv[ch] - ak * yn[ch];
+	}
+}
+
+//--------------------------------------------------------------------------
+// Cascade of second-order sections.
+
+BiquadCascade::BiquadCascade(const std::vector<Section> &sections, const size_t numChannels /*= 1*/, const double gain /*= 1.0*/)
+: numChannels_(numChannels), gain_(gain), sections_(sections), z_(2 * sections.size() * numChannels, 0.0)
+{
+	if (0 == numChannels)
+		throw std::invalid_argument("invalid number of channels");
+}
+
+BiquadCascade::BiquadCascade(const std::vector<double> &sos, const size_t numChannels /*= 1*/, const double gain /*= 1.0*/)
+: numChannels_(numChannels), gain_(gain), sections_(sos.size() / 6), z_(2 * (sos.size() / 6) * numChannels, 0.0)
+{
+	if (0 == numChannels || 0 != sos.size() % 6)
+		throw std::invalid_argument("invalid second-order sections");
+
+	for (size_t s = 0; s < sections_.size(); ++s)
+	{
+		const double *row = &sos[6 * s];
+		if (0.0 == row[3])
+			throw std::invalid_argument("invalid second-order sections");
 
-			y.push_back(sum / a[0]);
+		Section &section = sections_[s];
+		section.b0 = row[0] / row[3];
+		section.b1 = row[1] / row[3];
+		section.b2 = row[2] / row[3];
+		section.a1 = row[4] / row[3];
+		section.a2 = row[5] / row[3];
+	}
+}
+
+void BiquadCascade::reset()
+{
+	std::fill(z_.begin(), z_.end(), 0.0);
+}
+
+void BiquadCascade::process(const double *x, double *y, const size_t numFrames)
+{
+	const size_t C = numChannels_;
+
+	// Run the whole block through a section at a time, so the state of the section stays in the cache.
+	const double *in = x;
+	for (size_t s = 0; s < sections_.size(); ++s, in = y)
+	{
+		const Section &sec = sections_[s];
+		double *z1 = &z_[2 * s * C];
+		double *z2 = z1 + C;
+		for (size_t n = 0; n < numFrames; ++n)
+		{
+			const double *xn = in + n * C;
+			double *yn = y + n * C;
+			for (size_t ch = 0; ch < C; ++ch)
+			{
+				const double xv = xn[ch];
+				const double yv = sec.b0 * xv + z1[ch];
+				z1[ch] = sec.b1 * xv - sec.a1 * yv + z2[ch];
+				z2[ch] = sec.b2 * xv - sec.a2 * yv;
+				yn[ch] = yv;
+			}
 		}
 	}
-	else
+
+	if (in != y || 1.0 != gain_)
+	{
+		const size_t count = numFrames * C;
+		for (size_t i = 0; i < count; ++i)
+			y[i] = gain_ * in[i];
+	}
+}
+
+//--------------------------------------------------------------------------
+// FIR filter by FFT-based overlap-save.
+
+OverlapSaveFilter::OverlapSaveFilter(const std::vector<double> &b, const size_t numChannels /*= 1*/, const size_t fftSize /*= 0*/)
+: numChannels_(numChannels), fftSize_(fftSize), historySize_(b.empty() ? 0 : b.size() - 1),
+  H_(), twiddles_(), bitReversed_(), history_(), buffer_()
+{
+	if (b.empty() || 0 == numChannels)
+		throw std::invalid_argument("invalid filter coefficients");
+
+	if (0 == fftSize_)
+	{
+		// About 3/4 of an FFT are new frames.
+		fftSize_ = 64;
+		while (fftSize_ < 4 * b.size()) fftSize_ <<= 1;
+	}
+	else if (0 != (fftSize_ & (fftSize_ - 1)) || fftSize_ <= historySize_)
+		throw std::invalid_argument("invalid FFT size");
+
+	const size_t N = fftSize_;
+	twiddles_.resize(N / 2);
+	for (size_t k = 0; k < N / 2; ++k)
+		twiddles_[k] = std::polar(1.0, -2.0 * M_PI * double(k) / double(N));
+
+	bitReversed_.resize(N);
+	size_t numBits = 0;
+	while ((size_t(1) << numBits) < N) ++numBits;
+	for (size_t i = 0; i < N; ++i)
+	{
+		size_t r = 0;
+		for (size_t bit = 0; bit < numBits; ++bit)
+			if (i & (size_t(1) << bit)) r |= size_t(1) << (numBits - 1 - bit);
+		bitReversed_[i] = r;
+	}
+
+	// The scale of the inverse FFT is folded into the frequency response.
+	H_.assign(N, std::complex<double>(0.0, 0.0));
+	for (size_t i = 0; i < b.size(); ++i)
+		H_[i] = b[i] / double(N);
+	transform(&H_[0], false);
+
+	history_.assign(historySize_ * numChannels_, 0.0);
+	buffer_.resize(N);
+}
+
+void OverlapSaveFilter::reset()
+{
+	std::fill(history_.begin(), history_.end(), 0.0);
+}
+
+void OverlapSaveFilter::process(const double *x, double *y, const size_t numFrames)
+{
+	const size_t blockSize = getBlockSize();
+	for (size_t done = 0; done < numFrames; )
 	{
-		for (size_t n = 0; n < nx; ++n)
+		const size_t count = std::min(blockSize, numFrames - done);
+		processBlock(x + done * numChannels_, y + done * numChannels_, count);
+		done += count;
+	}
+}
+
+void OverlapSaveFilter::processBlock(const double *x, double *y, const size_t numFrames)
+{
+	const size_t C = numChannels_;
+	const size_t M = historySize_;
+	std::complex<double> *buf = &buffer_[0];
+
+	for (size_t ch = 0; ch < C; ch += 2)
+	{
+		// A pair of channels is transformed at once as the real & the imaginary parts.
+		const bool isPaired = ch + 1 < C;
+		double *history1 = M ? &history_[ch * M] : NULL;
+		double *history2 = M && isPaired ? &history_[(ch + 1) * M] : NULL;
+
+		// [the last M input samples | the new input samples | zeros].
+		for (size_t i = 0; i < M; ++i)
+			buf[i] = std::complex<double>(history1[i], isPaired ? history2[i] : 0.0);
+		for (size_t i = 0; i < numFrames; ++i)
+			buf[M + i] = std::complex<double>(x[i * C + ch], isPaired ? x[i * C + ch + 1] : 0.0);
+		std::fill(buf + M + numFrames, buf + fftSize_, std::complex<double>(0.0, 0.0));
+
+		// Keep the last M input samples before y, which may be x, is written.
+		for (size_t i = 0; i < M; ++i)
 		{
-			double sum = 0.0;
-			for (size_t i = 0; i <= nb && i <= n; ++i)
-				sum += b[i] * x[n - i];
-			for (size_t i = 1; i <= na && i <= n; ++i)
-				sum -= a[i] * y[n - i];
+			history1[i] = buf[numFrames + i].real();
+			if (isPaired) history2[i] = buf[numFrames + i].imag();
+		}
 
-			y.push_back(sum / a[0]);
+		transform(buf, false);
+		for (size_t k = 0; k < fftSize_; ++k)
+			buf[k] *= H_[k];
+		transform(buf, true);
+
+		// The first M outputs are corrupted by the circular convolution.
+		for (size_t i = 0; i < numFrames; ++i)
+		{
+			y[i * C + ch] = buf[M + i].real();
+			if (isPaired) y[i * C + ch + 1] = buf[M + i].imag();
 		}
 	}
 }
 
+// In-place iterative radix-2 FFT. The inverse transform is not scaled.
+void OverlapSaveFilter::transform(std::complex<double> *data, const bool isInverse) const
+{
+	const size_t N = fftSize_;
+	for (size_t i = 0; i < N; ++i)
+	{
+		const size_t j = bitReversed_[i];
+		if (i < j) std::swap(data[i], data[j]);
+	}
+
+	for (size_t len = 2; len <= N; len <<= 1)
+	{
+		const size_t half = len / 2, step = N / len;
+		for (size_t i = 0; i < N; i += len)
+			for (size_t k = 0; k < half; ++k)
+			{
+				const std::complex<double> w = isInverse ? std::conj(twiddles_[k * step]) : twiddles_[k * step];
+				const std::complex<double> u = data[i + k];
+				const std::complex<double> v = data[i + k + half] * w;
+				data[i + k] = u + v;
+				data[i + k + half] = u - v;
+			}
+	}
+}
+
 }  // namespace swl
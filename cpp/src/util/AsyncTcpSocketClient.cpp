@@ -1,8 +1,10 @@
 #include "swl/Config.h"
 #include "swl/util/AsyncTcpSocketClient.h"
+#include "swl/util/FrameParser.h"
 #include "swl/base/LogException.h"
 #include "swl/base/String.h"
 #include <boost/bind.hpp>
+#include <boost/array.hpp>
 
 
 #if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
@@ -27,7 +29,7 @@ AsyncTcpSocketClient::AsyncTcpSocketClient(boost::asio::io_service &ioService, c
 AsyncTcpSocketClient::AsyncTcpSocketClient(boost::asio::io_service &ioService, const std::string &hostName, const std::string &serviceName)
 #endif
 : socket_(ioService), isActive_(false),
-  sendBuffer_(), receiveBuffer_(), sendMsg_(), receiveMsg_(), sentMsgLength_(0)
+  sendBuffer_(), receiveBuffer_(), maxSendLength_(DEFAULT_MAX_SEND_LENGTH_), maxReceiveLength_(DEFAULT_MAX_RECEIVE_LENGTH_), sentMsgLength_(0)
 {
 	boost::asio::ip::tcp::resolver resolver(socket_.get_io_service());
 #if defined(_UNICODE) || defined(UNICODE)
@@ -66,6 +68,11 @@ std::size_t AsyncTcpSocketClient::receive(unsigned char *msg, const std::size_t
 	return readLen;
 }
 
+std::size_t AsyncTcpSocketClient::receiveFrames(FrameParser &parser, IFrameHandler &handler)
+{
+	return parser.parse(receiveBuffer_, handler);
+}
+
 void AsyncTcpSocketClient::cancelIo()
 {
 	socket_.get_io_service().post(boost::bind(&AsyncTcpSocketClient::doCancelOperation, this, boost::system::error_code()));
@@ -134,15 +141,16 @@ void AsyncTcpSocketClient::doCompleteConnecting(const boost::system::error_code
 
 void AsyncTcpSocketClient::doStartSending()
 {
-#if defined(__GNUC__)
-	sentMsgLength_ = std::min(sendBuffer_.getSize(), (std::size_t)MAX_SEND_LENGTH_);
-#else
-	sentMsgLength_ = std::min(sendBuffer_.getSize(), MAX_SEND_LENGTH_);
-#endif
-	sendBuffer_.top(sendMsg_.c_array(), sentMsgLength_);
+	// write the message directly from the segments of the send buffer.
+	const GuardedByteBuffer::value_type *segments[2];
+	std::size_t lengths[2];
+	sentMsgLength_ = sendBuffer_.getReadableSegments(segments, lengths, maxSendLength_);
+	const boost::array<boost::asio::const_buffer, 2> buffers = {{
+		boost::asio::buffer(segments[0], lengths[0]), boost::asio::buffer(segments[1], lengths[1])
+	}};
 	boost::asio::async_write(
 		socket_,
-		boost::asio::buffer(sendMsg_, sentMsgLength_),
+		buffers,
 		boost::bind(&AsyncTcpSocketClient::doCompleteSending, this, boost::asio::placeholders::error)
 	);
 }
@@ -165,8 +173,15 @@ void AsyncTcpSocketClient::doCompleteSending(const boost::system::error_code &ec
 
 void AsyncTcpSocketClient::doStartReceiving()
 {
+	// read the message directly into the free space of the receive buffer.
+	GuardedByteBuffer::value_type *segments[2];
+	std::size_t lengths[2];
+	receiveBuffer_.getWritableSegments(segments, lengths, maxReceiveLength_);
+	const boost::array<boost::asio::mutable_buffer, 2> buffers = {{
+		boost::asio::buffer(segments[0], lengths[0]), boost::asio::buffer(segments[1], lengths[1])
+	}};
 	socket_.async_read_some(
-		boost::asio::buffer(receiveMsg_),
+		buffers,
 		boost::bind(&AsyncTcpSocketClient::doCompleteReceiving, this, boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred)
 	);
 }
@@ -177,7 +192,7 @@ void AsyncTcpSocketClient::doCompleteReceiving(const boost::system::error_code &
 	{
 		// TODO [add] >> do something here to process receiving message
 
-		receiveBuffer_.push(receiveMsg_.data(), bytesTransferred);
+		receiveBuffer_.produce(bytesTransferred);
 		doStartReceiving();
 	}
 	else
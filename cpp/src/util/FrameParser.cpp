@@ -0,0 +1,281 @@
+#include "swl/Config.h"
+#include "swl/util/FrameParser.h"
+#include "swl/util/GuardedBuffer.h"
+#include <algorithm>
+#include <cstring>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace swl {
+
+namespace {
+
+// CRC-16/CCITT: polynomial 0x1021, initial value 0xFFFF.
+struct Crc16CcittTable
+{
+	Crc16CcittTable()
+	{
+		for (unsigned int i = 0; i < 256; ++i)
+		{
+			unsigned int crc = i << 8;
+			for (int k = 0; k < 8; ++k)
+				crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+			table[i] = (unsigned short)(crc & 0xFFFF);
+		}
+	}
+
+	unsigned short table[256];
+} crc16CcittTable;
+
+inline unsigned int getInitialChecksum(const FrameFormat::ChecksumType type)
+{
+	return FrameFormat::CRC16_CCITT_CHECKSUM == type ? 0xFFFF : 0;
+}
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------------
+//	frame format
+
+FrameFormat::FrameFormat()
+: syncLength(0), headerLength(0), lengthOffset(0), lengthSize(0), lengthAdjustment(0), fixedFrameLength(0), maxFrameLength(0),
+  checksumType(NO_CHECKSUM), checksumOffset(0), isLittleEndian(false)
+{
+	std::memset(syncBytes, 0, MAX_SYNC_LENGTH);
+}
+
+void FrameFormat::setSyncBytes(const unsigned char *sync, const std::size_t len)
+{
+	syncLength = len < MAX_SYNC_LENGTH ? len : MAX_SYNC_LENGTH;
+	std::memcpy(syncBytes, sync, syncLength);
+}
+
+std::size_t FrameFormat::getChecksumSize() const
+{
+	switch (checksumType)
+	{
+	case SUM8_CHECKSUM:
+	case XOR8_CHECKSUM:
+		return 1;
+	case CRC16_CCITT_CHECKSUM:
+		return 2;
+	default:
+		return 0;
+	}
+}
+
+bool FrameFormat::isValid() const
+{
+	if (syncLength > headerLength || 0 == maxFrameLength) return false;
+	if (0 == lengthSize)
+		return fixedFrameLength >= headerLength + getChecksumSize() && fixedFrameLength <= maxFrameLength;
+	return (1 == lengthSize || 2 == lengthSize || 4 == lengthSize) && lengthOffset + lengthSize <= headerLength &&
+		headerLength + getChecksumSize() <= maxFrameLength;
+}
+
+//-----------------------------------------------------------------------------------
+//	frame view
+
+FrameView::FrameView(const unsigned char * const segments[2], const std::size_t lengths[2], const std::size_t frameLength)
+: size_(frameLength)
+{
+	segments_[0] = segments[0];
+	segments_[1] = segments[1];
+	lengths_[0] = std::min(lengths[0], frameLength);
+	lengths_[1] = frameLength - lengths_[0];
+}
+
+std::size_t FrameView::copy(unsigned char *dst, const std::size_t offset, const std::size_t len) const
+{
+	if (offset >= size_) return 0;
+	const std::size_t count = std::min(len, size_ - offset);
+
+	std::size_t copied = 0;
+	if (offset < lengths_[0])
+	{
+		copied = std::min(count, lengths_[0] - offset);
+		std::memcpy(dst, segments_[0] + offset, copied);
+	}
+	if (copied < count)
+		std::memcpy(dst + copied, segments_[1] + (offset + copied - lengths_[0]), count - copied);
+	return count;
+}
+
+//-----------------------------------------------------------------------------------
+//	resumable frame parser
+
+FrameParser::FrameParser(const FrameFormat &format)
+: format_(format),
+  isSynchronized_(false), parsedLength_(0), frameLength_(0), checksum_(getInitialChecksum(format.checksumType)),
+  discardedByteCount_(0), errorCount_(0)
+{
+}
+
+void FrameParser::reset()
+{
+	isSynchronized_ = false;
+	parsedLength_ = 0;
+	frameLength_ = 0;
+	checksum_ = getInitialChecksum(format_.checksumType);
+}
+
+FrameParser::Result FrameParser::advance(const unsigned char * const segments[2], const std::size_t lengths[2], std::size_t &consumed)
+{
+	if (!isSynchronized_) return searchSync(segments, lengths, consumed);
+
+	const FrameView bytes(segments, lengths, lengths[0] + lengths[1]);
+	const std::size_t available = bytes.getSize();
+
+	// the bytes before parsedLength_ have been verified by the previous calls.
+	for (; parsedLength_ < format_.syncLength; ++parsedLength_)
+	{
+		if (parsedLength_ >= available) return NEED_MORE_DATA;
+		if (format_.syncBytes[parsedLength_] != bytes[parsedLength_]) return resynchronize(false, consumed);
+	}
+
+	const std::size_t checksumSize = format_.getChecksumSize();
+	if (0 == frameLength_)
+	{
+		if (available < format_.headerLength)
+		{
+			updateChecksum(segments, lengths, parsedLength_, available);
+			parsedLength_ = available;
+			return NEED_MORE_DATA;
+		}
+
+		const long frameLength = 0 == format_.lengthSize ? (long)format_.fixedFrameLength :
+			(long)readField(segments, lengths, format_.lengthOffset, format_.lengthSize) + format_.lengthAdjustment;
+		if (frameLength < (long)(format_.headerLength + checksumSize) || frameLength > (long)format_.maxFrameLength)
+			return resynchronize(true, consumed);
+		frameLength_ = (std::size_t)frameLength;
+	}
+
+	const std::size_t checksumEnd = frameLength_ - checksumSize;
+	const std::size_t end = std::min(available, checksumEnd);
+	if (end > parsedLength_)
+	{
+		updateChecksum(segments, lengths, parsedLength_, end);
+		parsedLength_ = end;
+	}
+	if (available < frameLength_) return NEED_MORE_DATA;
+
+	if (checksumSize)
+	{
+		const unsigned int mask = 1 == checksumSize ? 0xFF : 0xFFFF;
+		if ((checksum_ & mask) != readField(segments, lengths, checksumEnd, checksumSize))
+			return resynchronize(true, consumed);
+	}
+
+	consumed = frameLength_;
+	reset();
+	return FRAME_COMPLETED;
+}
+
+FrameParser::Result FrameParser::searchSync(const unsigned char * const segments[2], const std::size_t lengths[2], std::size_t &consumed)
+{
+	std::size_t offset = 0;
+	if (format_.syncLength)
+	{
+		// memchr() is vectorized by the C runtime libraries.
+		const unsigned char *found = NULL;
+		for (int i = 0; i < 2 && !found; ++i)
+		{
+			if (0 == lengths[i]) continue;
+			found = (const unsigned char *)std::memchr(segments[i], format_.syncBytes[0], lengths[i]);
+			offset += found ? std::size_t(found - segments[i]) : lengths[i];
+		}
+		if (!found)
+		{
+			// none of the bytes can start a frame.
+			consumed = offset;
+			discardedByteCount_ += offset;
+			return CONTINUE_PARSING;
+		}
+	}
+
+	consumed = offset;
+	discardedByteCount_ += offset;
+	isSynchronized_ = true;
+	return CONTINUE_PARSING;
+}
+
+FrameParser::Result FrameParser::resynchronize(const bool isError, std::size_t &consumed)
+{
+	if (isError) ++errorCount_;
+
+	// search again from the next byte.
+	consumed = 1;
+	++discardedByteCount_;
+	reset();
+	return CONTINUE_PARSING;
+}
+
+void FrameParser::updateChecksum(const unsigned char * const segments[2], const std::size_t lengths[2], const std::size_t begin, const std::size_t end)
+{
+	if (FrameFormat::NO_CHECKSUM == format_.checksumType) return;
+
+	std::size_t pos = std::max(begin, format_.checksumOffset);
+	unsigned int checksum = checksum_;
+	for (int i = 0; i < 2 && pos < end; ++i)
+	{
+		const std::size_t segmentBegin = 0 == i ? 0 : lengths[0];
+		const std::size_t segmentEnd = segmentBegin + lengths[i];
+		if (pos >= segmentEnd) continue;
+
+		const unsigned char *data = segments[i] + (pos - segmentBegin);
+		const unsigned char *dataEnd = segments[i] + (std::min(end, segmentEnd) - segmentBegin);
+		switch (format_.checksumType)
+		{
+		case FrameFormat::SUM8_CHECKSUM:
+			for (; data < dataEnd; ++data) checksum += *data;
+			break;
+		case FrameFormat::XOR8_CHECKSUM:
+			for (; data < dataEnd; ++data) checksum ^= *data;
+			break;
+		case FrameFormat::CRC16_CCITT_CHECKSUM:
+			for (; data < dataEnd; ++data)
+				checksum = ((checksum << 8) ^ crc16CcittTable.table[((checksum >> 8) ^ *data) & 0xFF]) & 0xFFFF;
+			break;
+		default:
+			break;
+		}
+		pos = std::min(end, segmentEnd);
+	}
+	checksum_ = checksum;
+}
+
+unsigned long FrameParser::readField(const unsigned char * const segments[2], const std::size_t lengths[2], const std::size_t offset, const std::size_t size) const
+{
+	const FrameView bytes(segments, lengths, lengths[0] + lengths[1]);
+
+	unsigned long value = 0;
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		const unsigned long byte = bytes[offset + i];
+		if (format_.isLittleEndian)
+			value |= byte << (8 * i);
+		else
+			value = (value << 8) | byte;
+	}
+	return value;
+}
+
+//-----------------------------------------------------------------------------------
+//	framed packet dispatcher
+
+FramedPacketDispatcher::FramedPacketDispatcher(const FrameFormat &format, IFrameHandler &handler)
+: parser_(format), handler_(handler)
+{
+}
+
+/*virtual*/ bool FramedPacketDispatcher::dispatch(GuardedByteBuffer &byteBuffer) const
+{
+	return parser_.parse(byteBuffer, handler_) > 0;
+}
+
+}  // namespace swl
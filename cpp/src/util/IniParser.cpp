@@ -3,6 +3,11 @@
 #include "swl/base/String.h"
 #include "swl/base/LogException.h"
 #include "iniparser_impl.h"
+#include "dictionary.h"
+#include <cctype>
+#include <cwctype>
+#include <cstdlib>
+#include <cstring>
 
 
 #if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
@@ -13,6 +18,118 @@
 
 namespace swl {
 
+namespace {
+
+#if defined(_UNICODE) || defined(UNICODE)
+inline std::wstring toSnapshotString(const char *str)  {  return String::mbs2wcs(str);  }
+#else
+inline std::string toSnapshotString(const char *str)  {  return std::string(str);  }
+#endif
+
+// keys are stored in lowercase in the dictionary.
+std::string toLower(const std::string &str)
+{
+	std::string lower(str);
+	for (std::string::size_type i = 0; i < lower.length(); ++i)
+		lower[i] = (char)std::tolower((unsigned char)lower[i]);
+	return lower;
+}
+
+std::wstring toLower(const std::wstring &str)
+{
+	std::wstring lower(str);
+	for (std::wstring::size_type i = 0; i < lower.length(); ++i)
+		lower[i] = (wchar_t)std::towlower(lower[i]);
+	return lower;
+}
+
+inline long toLong(const std::string &str)  {  return std::strtol(str.c_str(), NULL, 0);  }
+inline long toLong(const std::wstring &str)  {  return std::wcstol(str.c_str(), NULL, 0);  }
+inline double toDouble(const std::string &str)  {  return std::strtod(str.c_str(), NULL);  }
+inline double toDouble(const std::wstring &str)  {  return std::wcstod(str.c_str(), NULL);  }
+
+}  // unnamed namespace
+
+//--------------------------------------------------------------------------
+//
+
+IniSnapshot::IniSnapshot()
+: entries_()
+{
+}
+
+const IniSnapshot::string_type * IniSnapshot::find(const string_type &key) const
+{
+	entry_map_type::const_iterator it = entries_.find(key);
+	if (entries_.end() == it)
+	{
+		// the key may be given in mixed case.
+		it = entries_.find(toLower(key));
+		if (entries_.end() == it) return NULL;
+	}
+	return &it->second;
+}
+
+bool IniSnapshot::contains(const string_type &key) const
+{
+	return NULL != find(key);
+}
+
+IniSnapshot::string_type IniSnapshot::getString(const string_type &key, const string_type &notfound) const
+{
+	const string_type *val = find(key);
+	return val ? *val : notfound;
+}
+
+int IniSnapshot::getInt(const string_type &key, const int notfound) const
+{
+	const string_type *val = find(key);
+	return val ? (int)toLong(*val) : notfound;
+}
+
+double IniSnapshot::getDouble(const string_type &key, const double notfound) const
+{
+	const string_type *val = find(key);
+	return val ? toDouble(*val) : notfound;
+}
+
+bool IniSnapshot::getBool(const string_type &key, const bool notfound) const
+{
+	const string_type *val = find(key);
+	if (!val || val->empty()) return notfound;
+
+	switch ((*val)[0])
+	{
+	case 'y': case 'Y': case '1': case 't': case 'T':
+		return true;
+	case 'n': case 'N': case '0': case 'f': case 'F':
+		return false;
+	default:
+		return notfound;
+	}
+}
+
+bool IniSnapshot::diff(const IniSnapshot &previous, std::vector<string_type> &addedKeys, std::vector<string_type> &removedKeys, std::vector<string_type> &changedKeys) const
+{
+	addedKeys.clear();
+	removedKeys.clear();
+	changedKeys.clear();
+
+	for (entry_map_type::const_iterator it = entries_.begin(); it != entries_.end(); ++it)
+	{
+		entry_map_type::const_iterator itPrev = previous.entries_.find(it->first);
+		if (previous.entries_.end() == itPrev)
+			addedKeys.push_back(it->first);
+		else if (it->second != itPrev->second)
+			changedKeys.push_back(it->first);
+	}
+	for (entry_map_type::const_iterator itPrev = previous.entries_.begin(); itPrev != previous.entries_.end(); ++itPrev)
+		if (entries_.end() == entries_.find(itPrev->first))
+			removedKeys.push_back(itPrev->first);
+
+	return !addedKeys.empty() || !removedKeys.empty() || !changedKeys.empty();
+}
+
 //--------------------------------------------------------------------------
 //
 
@@ -169,4 +286,36 @@ bool IniParser::findEntry(const std::string &entry) const
 #endif
 }
 
+void IniParser::takeSnapshot(IniSnapshot &snapshot) const
+{
+	snapshot.entries_.clear();
+	snapshot.entries_.reserve(ini_->n);
+	for (int i = 0; i < ini_->size; ++i)
+	{
+		if (NULL == ini_->key[i] || NULL == ini_->val[i]) continue;
+		snapshot.entries_[toSnapshotString(ini_->key[i])] = toSnapshotString(ini_->val[i]);
+	}
+}
+
+#if defined(_UNICODE) || defined(UNICODE)
+void IniParser::takeSectionSnapshot(const std::wstring &section, IniSnapshot &snapshot) const
+#else
+void IniParser::takeSectionSnapshot(const std::string &section, IniSnapshot &snapshot) const
+#endif
+{
+#if defined(_UNICODE) || defined(UNICODE)
+	const std::string prefix(toLower(String::wcs2mbs(section)) + ':');
+#else
+	const std::string prefix(toLower(section) + ':');
+#endif
+
+	snapshot.entries_.clear();
+	for (int i = 0; i < ini_->size; ++i)
+	{
+		if (NULL == ini_->key[i] || NULL == ini_->val[i]) continue;
+		if (0 != std::strncmp(ini_->key[i], prefix.c_str(), prefix.length())) continue;
+		snapshot.entries_[toSnapshotString(ini_->key[i] + prefix.length())] = toSnapshotString(ini_->val[i]);
+	}
+}
+
 }  // namespace swl
@@ -0,0 +1,133 @@
+#include "swl/Config.h"
+#include "swl/util/IoServicePool.h"
+#include <boost/bind.hpp>
+#if defined(_WIN64) || defined(WIN64) || defined(_WIN32) || defined(WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace swl {
+
+IoServicePool::IoServicePool(const std::size_t poolSize /*= 0*/, const AssignmentPolicy policy /*= LEAST_LOADED*/, const bool pinsThreads /*= false*/)
+: ioServices_(), works_(), statistics_(), policy_(policy), pinsThreads_(pinsThreads), nextIndex_(0), threads_()
+{
+	std::size_t count = poolSize;
+	if (0 == count) count = boost::thread::hardware_concurrency();
+	if (0 == count) count = 1;
+
+	ioServices_.reserve(count);
+	works_.reserve(count);
+	statistics_.reserve(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const io_service_pointer ioService(new boost::asio::io_service(1));
+		ioServices_.push_back(ioService);
+		// keep the I/O service running without any pending work.
+		works_.push_back(work_pointer(new boost::asio::io_service::work(*ioService)));
+		statistics_.push_back(statistics_pointer(new IoServiceStatistics()));
+	}
+}
+
+IoServicePool::~IoServicePool()
+{
+	stop();
+	join();
+
+	// the pending handlers are destroyed with the I/O services & may hold the last references to connections,
+	// whose destructors update the statistics. so the I/O services have to be destroyed before the statistics.
+	works_.clear();
+	ioServices_.clear();
+}
+
+void IoServicePool::run()
+{
+	start();
+	join();
+}
+
+void IoServicePool::start()
+{
+	if (!threads_.empty()) return;
+
+	threads_.reserve(ioServices_.size());
+	for (std::size_t i = 0; i < ioServices_.size(); ++i)
+	{
+		ioServices_[i]->reset();
+		const thread_pointer thrd(new boost::thread(boost::bind(&IoServicePool::runIoService, ioServices_[i])));
+		if (pinsThreads_) pinThread(*thrd, i);
+		threads_.push_back(thrd);
+	}
+}
+
+void IoServicePool::stop()
+{
+	for (std::size_t i = 0; i < ioServices_.size(); ++i)
+		ioServices_[i]->stop();
+}
+
+void IoServicePool::join()
+{
+	for (std::size_t i = 0; i < threads_.size(); ++i)
+		threads_[i]->join();
+	// the threads are created again by the next start().
+	threads_.clear();
+}
+
+std::size_t IoServicePool::selectIoService()
+{
+	const std::size_t count = ioServices_.size();
+	const std::size_t start = nextIndex_.fetch_add(1, boost::memory_order_relaxed) % count;
+	if (ROUND_ROBIN == policy_ || 1 == count) return start;
+
+	// the least number of connections. ties are broken in the round-robin order.
+	std::size_t selected = start;
+	std::size_t minCount = statistics_[start]->connectionCount.load(boost::memory_order_relaxed);
+	for (std::size_t k = 1; k < count && minCount > 0; ++k)
+	{
+		const std::size_t i = (start + k) % count;
+		const std::size_t connectionCount = statistics_[i]->connectionCount.load(boost::memory_order_relaxed);
+		if (connectionCount < minCount)
+		{
+			selected = i;
+			minCount = connectionCount;
+		}
+	}
+	return selected;
+}
+
+/*static*/ void IoServicePool::runIoService(io_service_pointer ioService)
+{
+	ioService->run();
+}
+
+void IoServicePool::pinThread(boost::thread &thrd, const std::size_t index) const
+{
+	const unsigned int coreCount = boost::thread::hardware_concurrency();
+	if (0 == coreCount) return;
+	const std::size_t core = index % coreCount;
+
+#if defined(_WIN64) || defined(WIN64) || defined(_WIN32) || defined(WIN32)
+	if (core < sizeof(DWORD_PTR) * 8)
+		SetThreadAffinityMask(thrd.native_handle(), DWORD_PTR(1) << core);
+#elif defined(__linux__)
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	CPU_SET(core, &cpuSet);
+	pthread_setaffinity_np(thrd.native_handle(), sizeof(cpu_set_t), &cpuSet);
+#else
+	// not supported.
+	(void)thrd;
+	(void)core;
+#endif
+}
+
+}  // namespace swl
@@ -0,0 +1,492 @@
+#include "swl/Config.h"
+#include "swl/util/MappedWaveReader.h"
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define __SWL_UTIL__MAPPED_WAVE_READER__USE_SSE2 1
+#endif
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+const uint16_t WAVE_FORMAT_PCM = 0x0001;
+const uint16_t WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+const uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+// The number of samples decoded at a time before being de-interleaved.
+const size_t BLOCK_SAMPLES = 4096;
+
+inline uint16_t toUInt16(const uint8_t *p)
+{
+	return uint16_t(p[0] | (p[1] << 8));
+}
+
+inline uint32_t toUInt32(const uint8_t *p)
+{
+	return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+// Sample codecs. The samples in a wave file are little-endian.
+struct PcmU8
+{
+	static const size_t SIZE = 1;
+	template<typename T>
+	static T decode(const uint8_t *p)  {  return T(int(p[0]) - 128) * T(1.0 / 128.0);  }
+};
+
+struct PcmS16
+{
+	static const size_t SIZE = 2;
+	template<typename T>
+	static T decode(const uint8_t *p)
+	{
+		int16_t v;
+		std::memcpy(&v, p, SIZE);
+		return T(v) * T(1.0 / 32768.0);
+	}
+};
+
+struct PcmS24
+{
+	static const size_t SIZE = 3;
+	template<typename T>
+	static T decode(const uint8_t *p)
+	{
+		// Sign-extend by placing the 24 bits at the top of a 32-bit integer.
+		const int32_t v = int32_t((uint32_t(p[0]) << 8) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 24)) >> 8;
+		return T(v) * T(1.0 / 8388608.0);
+	}
+};
+
+struct PcmS32
+{
+	static const size_t SIZE = 4;
+	template<typename T>
+	static T decode(const uint8_t *p)
+	{
+		int32_t v;
+		std::memcpy(&v, p, SIZE);
+		return T(v) * T(1.0 / 2147483648.0);
+	}
+};
+
+struct Float32
+{
+	static const size_t SIZE = 4;
+	template<typename T>
+	static T decode(const uint8_t *p)
+	{
+		float v;
+		std::memcpy(&v, p, SIZE);
+		return T(v);
+	}
+};
+
+struct Float64
+{
+	static const size_t SIZE = 8;
+	template<typename T>
+	static T decode(const uint8_t *p)
+	{
+		double v;
+		std::memcpy(&v, p, SIZE);
+		return T(v);
+	}
+};
+
+// The stride is a compile-time constant, so the compilers can vectorize the loop.
+template<class Codec, typename T>
+void convert(const uint8_t *src, const size_t count, T *dst)
+{
+	for (size_t i = 0; i < count; ++i)
+		dst[i] = Codec::template decode<T>(src + i * Codec::SIZE);
+}
+
+#if defined(__SWL_UTIL__MAPPED_WAVE_READER__USE_SSE2)
+// The most common case: 16-bit PCM to float, 8 samples at a time.
+template<>
+void convert<PcmS16, float>(const uint8_t *src, const size_t count, float *dst)
+{
+	const __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * PcmS16::SIZE));
+		// Sign-extend the 16-bit samples to 32 bits.
+		const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+		const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+		_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+		_mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+	}
+	for (; i < count; ++i)
+		dst[i] = PcmS16::decode<float>(src + i * PcmS16::SIZE);
+}
+#endif
+
+template<class Codec, typename T>
+void convertStrided(const uint8_t *src, const size_t stride, const size_t count, T *dst)
+{
+	for (size_t i = 0; i < count; ++i)
+		dst[i] = Codec::template decode<T>(src + i * stride);
+}
+
+template<typename T>
+void convertSamples(const swl::MappedWaveReader::SampleFormat format, const uint8_t *src, const size_t count, T *dst)
+{
+	switch (format)
+	{
+	case swl::MappedWaveReader::PCM_U8:
+		convert<PcmU8>(src, count, dst);
+		break;
+	case swl::MappedWaveReader::PCM_S16:
+		convert<PcmS16>(src, count, dst);
+		break;
+	case swl::MappedWaveReader::PCM_S24:
+		convert<PcmS24>(src, count, dst);
+		break;
+	case swl::MappedWaveReader::PCM_S32:
+		convert<PcmS32>(src, count, dst);
+		break;
+	case swl::MappedWaveReader::FLOAT32:
+		convert<Float32>(src, count, dst);
+		break;
+	case swl::MappedWaveReader::FLOAT64:
+		convert<Float64>(src, count, dst);
+		break;
+	default:
+		break;
+	}
+}
+
+template<typename T>
+void convertSamples(const swl::MappedWaveReader::SampleFormat format, const uint8_t *src, const size_t stride, const size_t count, T *dst)
+{
+	switch (format)
+	{
+	case swl::MappedWaveReader::PCM_U8:
+		convertStrided<PcmU8>(src, stride, count, dst);
+		break;
+	case swl::MappedWaveReader::PCM_S16:
+		convertStrided<PcmS16>(src, stride, count, dst);
+		break;
+	case swl::MappedWaveReader::PCM_S24:
+		convertStrided<PcmS24>(src, stride, count, dst);
+		break;
+	case swl::MappedWaveReader::PCM_S32:
+		convertStrided<PcmS32>(src, stride, count, dst);
+		break;
+	case swl::MappedWaveReader::FLOAT32:
+		convertStrided<Float32>(src, stride, count, dst);
+		break;
+	case swl::MappedWaveReader::FLOAT64:
+		convertStrided<Float64>(src, stride, count, dst);
+		break;
+	default:
+		break;
+	}
+}
+
+template<typename T>
+void deinterleave(const T *src, const size_t channels, const size_t frameCount, T * const *dst, const size_t dstOffset)
+{
+	if (2 == channels)
+	{
+		T *left = dst[0] + dstOffset;
+		T *right = dst[1] + dstOffset;
+		for (size_t i = 0; i < frameCount; ++i)
+		{
+			left[i] = src[2 * i];
+			right[i] = src[2 * i + 1];
+		}
+	}
+	else
+	{
+		for (size_t ch = 0; ch < channels; ++ch)
+		{
+			T *out = dst[ch] + dstOffset;
+			for (size_t i = 0; i < frameCount; ++i)
+				out[i] = src[i * channels + ch];
+		}
+	}
+}
+
+swl::MappedWaveReader::SampleFormat getSampleFormat(const uint16_t formatTag, const size_t bytesPerSample)
+{
+	if (WAVE_FORMAT_PCM == formatTag)
+	{
+		switch (bytesPerSample)
+		{
+		case 1: return swl::MappedWaveReader::PCM_U8;
+		case 2: return swl::MappedWaveReader::PCM_S16;
+		case 3: return swl::MappedWaveReader::PCM_S24;
+		case 4: return swl::MappedWaveReader::PCM_S32;
+		}
+	}
+	else if (WAVE_FORMAT_IEEE_FLOAT == formatTag)
+	{
+		switch (bytesPerSample)
+		{
+		case 4: return swl::MappedWaveReader::FLOAT32;
+		case 8: return swl::MappedWaveReader::FLOAT64;
+		}
+	}
+	return swl::MappedWaveReader::UNKNOWN_FORMAT;
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+
+//-----------------------------------------------------------------------------
+//	MappedWaveReader
+
+MappedWaveReader::MappedWaveReader()
+: file_(), isOpened_(false),
+  sampleFormat_(UNKNOWN_FORMAT), channels_(0), samplesPerSec_(0), bitsPerSample_(0), blockAlign_(0),
+  dataOffset_(0), dataSize_(0), frameCount_(0)
+{
+}
+
+MappedWaveReader::~MappedWaveReader()
+{
+	close();
+}
+
+bool MappedWaveReader::open(const std::string &filepath)
+{
+	close();
+
+	if (!readHeader(filepath))
+	{
+		std::cerr << "Failed to read the header of a wave file: " << filepath << std::endl;
+		close();
+		return false;
+	}
+
+	try
+	{
+		boost::interprocess::file_mapping file(filepath.c_str(), boost::interprocess::read_only);
+		file_.swap(file);
+	}
+	catch (const boost::interprocess::interprocess_exception &ex)
+	{
+		std::cerr << "Failed to map a wave file: " << filepath << ": " << ex.what() << std::endl;
+		close();
+		return false;
+	}
+
+	isOpened_ = true;
+	return true;
+}
+
+void MappedWaveReader::close()
+{
+	boost::interprocess::file_mapping empty;
+	file_.swap(empty);
+	isOpened_ = false;
+
+	sampleFormat_ = UNKNOWN_FORMAT;
+	channels_ = 0;
+	samplesPerSec_ = 0;
+	bitsPerSample_ = 0;
+	blockAlign_ = 0;
+	dataOffset_ = 0;
+	dataSize_ = 0;
+	frameCount_ = 0;
+}
+
+bool MappedWaveReader::readHeader(const std::string &filepath)
+{
+	std::ifstream stream(filepath.c_str(), std::ios::in | std::ios::binary);
+	if (!stream) return false;
+
+	stream.seekg(0, std::ios::end);
+	const uint64_t fileSize = (uint64_t)stream.tellg();
+	stream.seekg(0, std::ios::beg);
+
+	// RIFF header.
+	uint8_t riff[12];
+	if (!stream.read(reinterpret_cast<char *>(riff), sizeof(riff)) || 0 != std::memcmp(riff, "RIFF", 4) || 0 != std::memcmp(riff + 8, "WAVE", 4))
+		return false;
+
+	// Walk the sub-chunks up to the "data" chunk.
+	bool hasFmt = false;
+	uint16_t formatTag = 0;
+	uint64_t pos = sizeof(riff);
+	while (pos + 8 <= fileSize)
+	{
+		uint8_t chunk[8];
+		stream.seekg((std::streamoff)pos, std::ios::beg);
+		if (!stream.read(reinterpret_cast<char *>(chunk), sizeof(chunk))) return false;
+		const uint32_t chunkSize = local::toUInt32(chunk + 4);
+		pos += sizeof(chunk);
+
+		if (0 == std::memcmp(chunk, "fmt ", 4))
+		{
+			if (chunkSize < 16) return false;
+
+			uint8_t fmt[40] = { 0, };
+			if (!stream.read(reinterpret_cast<char *>(fmt), std::min<uint32_t>(chunkSize, sizeof(fmt)))) return false;
+			formatTag = local::toUInt16(fmt);
+			channels_ = local::toUInt16(fmt + 2);
+			samplesPerSec_ = local::toUInt32(fmt + 4);
+			blockAlign_ = local::toUInt16(fmt + 12);
+			bitsPerSample_ = local::toUInt16(fmt + 14);
+			// The format tag of WAVE_FORMAT_EXTENSIBLE is in the first two bytes of the sub-format GUID.
+			if (local::WAVE_FORMAT_EXTENSIBLE == formatTag && chunkSize >= 40)
+				formatTag = local::toUInt16(fmt + 24);
+			hasFmt = true;
+		}
+		else if (0 == std::memcmp(chunk, "data", 4))
+		{
+			if (!hasFmt || 0 == channels_ || 0 == blockAlign_ || 0 != blockAlign_ % channels_) return false;
+
+			sampleFormat_ = local::getSampleFormat(formatTag, blockAlign_ / channels_);
+			if (UNKNOWN_FORMAT == sampleFormat_) return false;
+
+			// The size of a data chunk being recorded may not be updated yet.
+			dataOffset_ = pos;
+			dataSize_ = std::min<uint64_t>(chunkSize, fileSize - pos);
+			frameCount_ = size_t(dataSize_ / blockAlign_);
+			return true;
+		}
+
+		// Chunks are word-aligned.
+		pos += chunkSize + (chunkSize & 1);
+	}
+
+	return false;
+}
+
+size_t MappedWaveReader::clampFrameCount(const size_t startFrame, const size_t frameCount) const
+{
+	if (!isOpened_ || startFrame >= frameCount_) return 0;
+	return std::min(frameCount, frameCount_ - startFrame);
+}
+
+template<typename T>
+size_t MappedWaveReader::decodeFrames(const size_t startFrame, const size_t frameCount, T * const *channels) const
+{
+	const size_t count = clampFrameCount(startFrame, frameCount);
+	if (0 == count || !channels) return 0;
+
+	try
+	{
+		// Only the requested frames are mapped.
+		boost::interprocess::mapped_region region(file_, boost::interprocess::read_only, (boost::interprocess::offset_t)(dataOffset_ + (uint64_t)startFrame * blockAlign_), count * blockAlign_);
+		region.advise(boost::interprocess::mapped_region::advice_sequential);
+		const uint8_t *src = static_cast<const uint8_t *>(region.get_address());
+
+		if (1 == channels_)
+		{
+			local::convertSamples(sampleFormat_, src, count, channels[0]);
+			return count;
+		}
+
+		// Decode a block of interleaved samples into a contiguous buffer, then de-interleave it.
+		const size_t blockFrames = std::max<size_t>(1, local::BLOCK_SAMPLES / channels_);
+		std::vector<T> block(blockFrames * channels_);
+		for (size_t frame = 0; frame < count; frame += blockFrames)
+		{
+			const size_t n = std::min(blockFrames, count - frame);
+			local::convertSamples(sampleFormat_, src + frame * blockAlign_, n * channels_, &block[0]);
+			local::deinterleave(&block[0], channels_, n, channels, frame);
+		}
+		return count;
+	}
+	catch (const boost::interprocess::interprocess_exception &ex)
+	{
+		std::cerr << "Failed to map the frames of a wave file: " << ex.what() << std::endl;
+		return 0;
+	}
+}
+
+size_t MappedWaveReader::readFrames(const size_t startFrame, const size_t frameCount, float * const *channels) const
+{
+	return decodeFrames(startFrame, frameCount, channels);
+}
+
+size_t MappedWaveReader::readFrames(const size_t startFrame, const size_t frameCount, double * const *channels) const
+{
+	return decodeFrames(startFrame, frameCount, channels);
+}
+
+size_t MappedWaveReader::readFrames(const size_t startFrame, const size_t frameCount, std::vector<std::vector<float> > &channels) const
+{
+	const size_t count = clampFrameCount(startFrame, frameCount);
+	channels.resize(channels_);
+	std::vector<float *> channelPtrs(channels_);
+	for (size_t ch = 0; ch < channels_; ++ch)
+	{
+		channels[ch].resize(count);
+		channelPtrs[ch] = channels[ch].empty() ? nullptr : &channels[ch][0];
+	}
+	if (0 == count) return 0;
+
+	const size_t numFramesRead = decodeFrames(startFrame, count, &channelPtrs[0]);
+	if (numFramesRead != count)
+		for (size_t ch = 0; ch < channels_; ++ch)
+			channels[ch].resize(numFramesRead);
+	return numFramesRead;
+}
+
+size_t MappedWaveReader::readChannel(const size_t channel, const size_t startFrame, const size_t frameCount, float *channelData) const
+{
+	const size_t count = channel < channels_ ? clampFrameCount(startFrame, frameCount) : 0;
+	if (0 == count || !channelData) return 0;
+
+	try
+	{
+		const size_t bytesPerSample = blockAlign_ / channels_;
+		boost::interprocess::mapped_region region(file_, boost::interprocess::read_only, (boost::interprocess::offset_t)(dataOffset_ + (uint64_t)startFrame * blockAlign_ + channel * bytesPerSample), (count - 1) * blockAlign_ + bytesPerSample);
+		region.advise(boost::interprocess::mapped_region::advice_sequential);
+		local::convertSamples(sampleFormat_, static_cast<const uint8_t *>(region.get_address()), blockAlign_, count, channelData);
+		return count;
+	}
+	catch (const boost::interprocess::interprocess_exception &ex)
+	{
+		std::cerr << "Failed to map the frames of a wave file: " << ex.what() << std::endl;
+		return 0;
+	}
+}
+
+//-----------------------------------------------------------------------------
+//	WaveChunkStream
+
+WaveChunkStream::WaveChunkStream(const MappedWaveReader &reader, const size_t framesPerChunk, const size_t startFrame /*= 0*/)
+: reader_(reader), framesPerChunk_(std::max<size_t>(1, framesPerChunk)),
+  nextFrame_(startFrame), startFrame_(startFrame), frameCount_(0),
+  buffer_(framesPerChunk_ * reader.getNumberOfChannels()), channelPtrs_(reader.getNumberOfChannels())
+{
+	for (size_t ch = 0; ch < channelPtrs_.size(); ++ch)
+		channelPtrs_[ch] = &buffer_[ch * framesPerChunk_];
+}
+
+bool WaveChunkStream::next()
+{
+	startFrame_ = nextFrame_;
+	frameCount_ = channelPtrs_.empty() ? 0 : reader_.readFrames(nextFrame_, framesPerChunk_, &channelPtrs_[0]);
+	nextFrame_ += frameCount_;
+	return frameCount_ > 0;
+}
+
+void WaveChunkStream::seek(const size_t frame)
+{
+	nextFrame_ = startFrame_ = frame;
+	frameCount_ = 0;
+}
+
+}  // namespace swl
@@ -1,7 +1,8 @@
 #include "swl/Config.h"
 #include "swl/util/PacketPacker.h"
-#include <iterator>
+#include "swl/util/ByteOrder.h"
 #include <algorithm>
+#include <cstring>
 
 
 #if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
@@ -63,7 +64,14 @@ namespace swl {
 
 PacketPacker::PacketPacker(const size_t packetSize, const bool isLittleEndian)
 : isLittleEndian_(isLittleEndian), packetSize_(packetSize),
-  dataBuf_(), itCurr_()
+  dataBuf_(), externalBuf_(0L), externalBufSize_(0), dataSize_(0), currPos_(0), isOverflowed_(false)
+{
+	if (packetSize_) dataBuf_.reserve(packetSize_);
+}
+
+PacketPacker::PacketPacker(value_type *buffer, const size_t bufferSize, const size_t packetSize, const bool isLittleEndian)
+: isLittleEndian_(isLittleEndian), packetSize_(packetSize),
+  dataBuf_(), externalBuf_(buffer), externalBufSize_(buffer ? bufferSize : 0), dataSize_(0), currPos_(0), isOverflowed_(false)
 {
 }
 
@@ -73,159 +81,263 @@ PacketPacker::~PacketPacker()
 
 bool PacketPacker::initialize(bool doesClearData /*= true*/)
 {
-	if (doesClearData) dataBuf_.clear();
-	itCurr_ = dataBuf_.begin();
+	if (doesClearData)
+	{
+		// the capacity of dataBuf_ is kept for the next packet.
+		dataBuf_.clear();
+		dataSize_ = 0;
+		isOverflowed_ = false;
+	}
+	currPos_ = 0;
 	return true;
 }
 
 bool PacketPacker::finalize()
 {
-	if (dataBuf_.empty()) return false;
+	if (0 == dataSize_ || isOverflowed_) return false;
 
 	if (isFixedSize())
 	{
-		if (dataBuf_.size() != packetSize_) return false;
+		if (dataSize_ != packetSize_) return false;
 	}
 
-	itCurr_ = dataBuf_.begin();
+	currPos_ = 0;
 	return true;
 }
 
-PacketPacker::value_type * PacketPacker::getPacket(bool isComplete /*= true*/) const
+void PacketPacker::reserve(const size_t size)
 {
-	if (dataBuf_.empty()) return 0L;
+	if (!externalBuf_) dataBuf_.reserve(size);
+}
 
-	size_t size = dataBuf_.size();
-	if (isComplete && isFixedSize() && size != packetSize_) return 0L;
+const PacketPacker::value_type * PacketPacker::getPacketData() const
+{
+	if (0 == dataSize_) return 0L;
+	return externalBuf_ ? externalBuf_ : &dataBuf_[0];
+}
 
-	value_type* data = new value_type [size];
+PacketPacker::value_type * PacketPacker::getPacket(bool isComplete /*= true*/) const
+{
+	if (0 == dataSize_) return 0L;
+	if (isComplete && isFixedSize() && dataSize_ != packetSize_) return 0L;
+
+	value_type* data = new value_type [dataSize_];
 	if (!data) return 0L;
 
 	//
-	std::copy(dataBuf_.begin(), dataBuf_.end(), data);
+	std::memcpy(data, getPacketData(), dataSize_);
 
 	return data;
 }
 
-void PacketPacker::putChar(char data)
+size_t PacketPacker::copyPacket(value_type *packet, const size_t size, bool isComplete /*= true*/) const
 {
-	//--S [] 2004/06/30 : Sang-Wook Lee
-	//dataBuf_.push_back(data);
-	std::inserter(dataBuf_, itCurr_) = data;
-	//++itCurr_;  // don't need because of a mechanism of inserter
-	//--E [] 2004/06/30
+	if (0 == dataSize_ || !packet || size < dataSize_) return 0;
+	if (isComplete && isFixedSize() && dataSize_ != packetSize_) return 0;
+
+	std::memcpy(packet, getPacketData(), dataSize_);
+	return dataSize_;
 }
 
-void PacketPacker::putShort(short data)
+PacketPacker::value_type * PacketPacker::prepare(const size_t len)
 {
-	if (isLittleEndian_)
-		std::reverse_copy((value_type *)&data, (value_type *)&data + sizeof(short), std::inserter(dataBuf_, itCurr_));
+	if (0 == len) return 0L;
+
+	value_type *buf = 0L;
+	if (externalBuf_)
+	{
+		if (isOverflowed_ || dataSize_ + len > externalBufSize_)
+		{
+			isOverflowed_ = true;
+			return 0L;
+		}
+
+		if (currPos_ < dataSize_)
+			std::memmove(externalBuf_ + currPos_ + len, externalBuf_ + currPos_, dataSize_ - currPos_);
+		buf = externalBuf_;
+	}
 	else
 	{
-		std::copy((value_type *)&data, (value_type *)&data + sizeof(short), std::inserter(dataBuf_, itCurr_));
-		//std::advance(itCurr_, sizeof(short));  // don't need because of a mechanism of inserter
+		if (currPos_ == dataSize_)
+			dataBuf_.resize(dataSize_ + len);
+		else
+			dataBuf_.insert(dataBuf_.begin() + currPos_, len, value_type(0));
+		buf = &dataBuf_[0];
 	}
+
+	value_type *dst = buf + currPos_;
+	currPos_ += len;
+	dataSize_ += len;
+	return dst;
+}
+
+template<typename T>
+void PacketPacker::put(const T &data)
+{
+	value_type *dst = prepare(sizeof(T));
+	if (dst) storeBytes(dst, data, isLittleEndian_);
+}
+
+void PacketPacker::putChar(char data)
+{
+	value_type *dst = prepare(1);
+	if (dst) *dst = (value_type)data;
+}
+
+void PacketPacker::putShort(short data)
+{
+	put(data);
 }
 
 void PacketPacker::putInt(int data)
 {
-	if (isLittleEndian_)
-		std::reverse_copy((value_type *)&data, (value_type *)&data + sizeof(int), std::inserter(dataBuf_, itCurr_));
-	else
-	{
-		std::copy((value_type *)&data, (value_type *)&data + sizeof(int), std::inserter(dataBuf_, itCurr_));
-		//std::advance(itCurr_, sizeof(int));  // don't need because of a mechanism of inserter
-	}
+	put(data);
 }
 
 void PacketPacker::putLong(long data)
 {
-	if (isLittleEndian_)
-		std::reverse_copy((value_type *)&data, (value_type *)&data + sizeof(long), std::inserter(dataBuf_, itCurr_));
-	else
-	{
-		std::copy((value_type *)&data, (value_type *)&data + sizeof(long), std::inserter(dataBuf_, itCurr_));
-		//std::advance(itCurr_, sizeof(long));  // don't need because of a mechanism of inserter
-	}
+	put(data);
 }
 
-#if defined(__GNUC__)
+#if defined(__GNUC__)
 void PacketPacker::putInt64(long long data)
-#elif defined(_MSC_VER)
+#elif defined(_MSC_VER)
 void PacketPacker::putInt64(__int64 data)
-#endif
-{
-	if (isLittleEndian_)
-#if defined(__GNUC__)
-		std::reverse_copy((value_type *)&data, (value_type *)&data + sizeof(long long), std::inserter(dataBuf_, itCurr_));
-#elif defined(_MSC_VER)
-		std::reverse_copy((value_type *)&data, (value_type *)&data + sizeof(__int64), std::inserter(dataBuf_, itCurr_));
-#endif
-	else
-	{
-#if defined(__GNUC__)
-		std::copy((value_type *)&data, (value_type *)&data + sizeof(long long), std::inserter(dataBuf_, itCurr_));
-		//std::advance(itCurr_, sizeof(long long));  // don't need because of a mechanism of inserter
-#elif defined(_MSC_VER)
-		std::copy((value_type *)&data, (value_type *)&data + sizeof(__int64), std::inserter(dataBuf_, itCurr_));
-		//std::advance(itCurr_, sizeof(__int64));  // don't need because of a mechanism of inserter
-#endif
-	}
+#endif
+{
+	put(data);
 }
 
 void PacketPacker::putFloat(float data)
 {
-	if (isLittleEndian_)
-		std::reverse_copy((value_type *)&data, (value_type *)&data + sizeof(float), std::inserter(dataBuf_, itCurr_));
-	else
-	{
-		std::copy((value_type *)&data, (value_type *)&data + sizeof(float), std::inserter(dataBuf_, itCurr_));
-		//std::advance(itCurr_, sizeof(float));  // don't need because of a mechanism of inserter
-	}
+	put(data);
 }
 
 void PacketPacker::putDouble(double data)
 {
-	if (isLittleEndian_)
-		std::reverse_copy((value_type *)&data, (value_type *)&data + sizeof(double), std::inserter(dataBuf_, itCurr_));
-	else
-	{
-		std::copy((value_type *)&data, (value_type *)&data + sizeof(double), std::inserter(dataBuf_, itCurr_));
-		//std::advance(itCurr_, sizeof(double));  // don't need because of a mechanism of inserter
-	}
+	put(data);
 }
 
 void PacketPacker::putLDouble(long double data)
 {
-	if (isLittleEndian_)
-		std::reverse_copy((value_type *)&data, (value_type *)&data + sizeof(long double), std::inserter(dataBuf_, itCurr_));
-	else
-	{
-		std::copy((value_type *)&data, (value_type *)&data + sizeof(long double), std::inserter(dataBuf_, itCurr_));
-		//std::advance(itCurr_, sizeof(long double));  // don't need because of a mechanism of inserter
-	}
+	put(data);
 }
 
 void PacketPacker::putText(const char* data, const size_t size)
 {
-	// FIXME [check] >>
-/*
-	if (isLittleEndian_)
-		std::reverse_copy(data, data + size, std::inserter(dataBuf_, itCurr_));
-	else
-	{
-//		//dataBuf_.insert(dataBuf_.end(), data, data + size);
-//		std::copy(data, data + size, std::back_inserter(dataBuf_));
-		std::copy((value_type *)data, (value_type *)data + size, std::inserter(dataBuf_, itCurr_));
-		//std::advance(itCurr_, size);  // don't need because of a mechanism of inserter
-	}
-*/
-	std::copy((value_type *)data, (value_type *)data + size, std::inserter(dataBuf_, itCurr_));
+	// text is not affected by the byte order.
+	value_type *dst = prepare(size);
+	if (dst) std::memcpy(dst, data, size);
 }
 
 void PacketPacker::fillChar(char data, const size_t size)
 {
-	dataBuf_.insert(itCurr_, size, data);
+	value_type *dst = prepare(size);
+	if (dst) std::memset(dst, data, size);
+}
+
+//-----------------------------------------------------------------------------------
+//  byte-based packet unpacker
+
+PacketUnpacker::PacketUnpacker(const value_type *packet, const size_t packetSize, const bool isLittleEndian)
+: isLittleEndian_(isLittleEndian), packet_(packet), packetSize_(packet ? packetSize : 0), currPos_(0)
+{
+}
+
+PacketUnpacker::PacketUnpacker(const bool isLittleEndian)
+: isLittleEndian_(isLittleEndian), packet_(0L), packetSize_(0), currPos_(0)
+{
+}
+
+PacketUnpacker::~PacketUnpacker()
+{
+}
+
+void PacketUnpacker::setPacket(const value_type *packet, const size_t packetSize)
+{
+	packet_ = packet;
+	packetSize_ = packet ? packetSize : 0;
+	currPos_ = 0;
+}
+
+bool PacketUnpacker::initialize()
+{
+	currPos_ = 0;
+	return NULL != packet_;
+}
+
+template<typename T>
+bool PacketUnpacker::get(T &data)
+{
+	if (getRemainingSize() < sizeof(T)) return false;
+
+	data = loadBytes<T>(packet_ + currPos_, isLittleEndian_);
+	currPos_ += sizeof(T);
+	return true;
+}
+
+bool PacketUnpacker::getChar(char &data)
+{
+	if (getRemainingSize() < 1) return false;
+
+	data = (char)packet_[currPos_++];
+	return true;
+}
+
+bool PacketUnpacker::getShort(short &data)
+{
+	return get(data);
+}
+
+bool PacketUnpacker::getInt(int &data)
+{
+	return get(data);
+}
+
+bool PacketUnpacker::getLong(long &data)
+{
+	return get(data);
+}
+
+#if defined(__GNUC__)
+bool PacketUnpacker::getInt64(long long &data)
+#elif defined(_MSC_VER)
+bool PacketUnpacker::getInt64(__int64 &data)
+#endif
+{
+	return get(data);
+}
+
+bool PacketUnpacker::getFloat(float &data)
+{
+	return get(data);
+}
+
+bool PacketUnpacker::getDouble(double &data)
+{
+	return get(data);
+}
+
+bool PacketUnpacker::getLDouble(long double &data)
+{
+	return get(data);
+}
+
+bool PacketUnpacker::getText(char *data, const size_t size)
+{
+	if (getRemainingSize() < size) return false;
+
+	if (size) std::memcpy(data, packet_ + currPos_, size);
+	currPos_ += size;
+	return true;
+}
+
+bool PacketUnpacker::skip(const size_t size)
+{
+	if (getRemainingSize() < size) return false;
+
+	currPos_ += size;
+	return true;
 }
 
 
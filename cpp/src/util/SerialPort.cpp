@@ -1,8 +1,10 @@
 #include "swl/Config.h"
 #include "swl/util/SerialPort.h"
+#include "swl/util/FrameParser.h"
 #include "swl/base/LogException.h"
 #include "swl/base/String.h"
 #include <boost/bind.hpp>
+#include <boost/array.hpp>
 #include <iostream>
 
 
@@ -21,7 +23,7 @@ namespace swl {
 
 SerialPort::SerialPort(boost::asio::io_service &ioService)
 : port_(ioService), isActive_(false),
-  sendBuffer_(), receiveBuffer_(), sendMsg_(), receiveMsg_(), sentMsgLength_(0)
+  sendBuffer_(), receiveBuffer_(), maxSendLength_(DEFAULT_MAX_SEND_LENGTH_), maxReceiveLength_(DEFAULT_MAX_RECEIVE_LENGTH_), sentMsgLength_(0)
 {}
 
 SerialPort::~SerialPort()
@@ -85,6 +87,11 @@ std::size_t SerialPort::receive(unsigned char *msg, const std::size_t len)
 	return readLen;
 }
 
+std::size_t SerialPort::receiveFrames(FrameParser &parser, IFrameHandler &handler)
+{
+	return parser.parse(receiveBuffer_, handler);
+}
+
 void SerialPort::cancelIo()
 {
 	port_.get_io_service().post(boost::bind(&SerialPort::doCancelOperation, this, boost::system::error_code()));
@@ -122,15 +129,16 @@ std::size_t SerialPort::getReceiveBufferSize() const
 
 void SerialPort::doStartSending()
 {
-#if defined(__GNUC__)
-	sentMsgLength_ = std::min(sendBuffer_.getSize(), (std::size_t)MAX_SEND_LENGTH_);
-#else
-	sentMsgLength_ = std::min(sendBuffer_.getSize(), MAX_SEND_LENGTH_);
-#endif
-	sendBuffer_.top(sendMsg_.c_array(), sentMsgLength_);
+	// write the message directly from the segments of the send buffer.
+	const GuardedByteBuffer::value_type *segments[2];
+	std::size_t lengths[2];
+	sentMsgLength_ = sendBuffer_.getReadableSegments(segments, lengths, maxSendLength_);
+	const boost::array<boost::asio::const_buffer, 2> buffers = {{
+		boost::asio::buffer(segments[0], lengths[0]), boost::asio::buffer(segments[1], lengths[1])
+	}};
 	boost::asio::async_write(
 		port_,
-		boost::asio::buffer(sendMsg_, sentMsgLength_),
+		buffers,
 		boost::bind(&SerialPort::doCompleteSending, this, boost::asio::placeholders::error)
 	);
 }
@@ -150,8 +158,15 @@ void SerialPort::doCompleteSending(const boost::system::error_code &ec)
 
 void SerialPort::doStartReceiving()
 {
+	// read the message directly into the free space of the receive buffer.
+	GuardedByteBuffer::value_type *segments[2];
+	std::size_t lengths[2];
+	receiveBuffer_.getWritableSegments(segments, lengths, maxReceiveLength_);
+	const boost::array<boost::asio::mutable_buffer, 2> buffers = {{
+		boost::asio::buffer(segments[0], lengths[0]), boost::asio::buffer(segments[1], lengths[1])
+	}};
 	port_.async_read_some(
-		boost::asio::buffer(receiveMsg_),
+		buffers,
 		boost::bind(&SerialPort::doCompleteReceiving, this, boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred)
 	);
 }
@@ -160,7 +175,7 @@ void SerialPort::doCompleteReceiving(const boost::system::error_code &ec, std::s
 {
 	if (!ec)
 	{
-		receiveBuffer_.push(receiveMsg_.data(), bytesTransferred);
+		receiveBuffer_.produce(bytesTransferred);
 		doStartReceiving();
 	}
 	else
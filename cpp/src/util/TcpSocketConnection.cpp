@@ -1,5 +1,7 @@
 #include "swl/Config.h"
 #include "swl/util/TcpSocketConnection.h"
+#include "swl/util/FrameParser.h"
+#include <boost/array.hpp>
 
 
 #if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
@@ -14,20 +16,29 @@
 
 
 namespace swl {
-
+
 ///*static*/ TcpSocketConnection::pointer TcpSocketConnection::create(boost::asio::io_service &ioService)
 //{
 //	return pointer(new TcpSocketConnection(ioService));
 //}
 
 TcpSocketConnection::TcpSocketConnection(boost::asio::io_service &ioService)
-: socket_(ioService),
-  sendBuffer_(), receiveBuffer_(), sendMsg_(), receiveMsg_(), sentMsgLength_(0),
-  isSending_(false), isReceiving_(false)
+: socket_(ioService), strand_(ioService),
+  sendBuffer_(), receiveBuffer_(), maxSendLength_(DEFAULT_MAX_SEND_LENGTH_), maxReceiveLength_(DEFAULT_MAX_RECEIVE_LENGTH_), sentMsgLength_(0),
+  isSending_(false), isReceiving_(false), statistics_(NULL)
 {}
 
 TcpSocketConnection::~TcpSocketConnection()
 {
+	if (statistics_)
+		--statistics_->connectionCount;
+}
+
+void TcpSocketConnection::setStatistics(IoServiceStatistics *statistics)
+{
+	if (statistics_) --statistics_->connectionCount;
+	statistics_ = statistics;
+	if (statistics_) ++statistics_->connectionCount;
 }
 
 void TcpSocketConnection::start()
@@ -45,30 +56,75 @@ void TcpSocketConnection::doStartOperation()
 	if (!isReceiving_)
 	{
 		isReceiving_ = true;
-		socket_.async_read_some(
-			boost::asio::buffer(receiveMsg_),
-			// caution: shared_from_this() must be used here
-			boost::bind(&TcpSocketConnection::doCompleteReceiving, shared_from_this(), boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred)
-		);
+		startReceiving();
 	}
 
 	// start a write operation if the third party library wants one.
 	if (!isSending_ && !sendBuffer_.isEmpty())
 	{
 		isSending_ = true;
-#if defined(__GNUC__)
-		sentMsgLength_ = std::min(sendBuffer_.getSize(), (std::size_t)MAX_SEND_LENGTH_);
-#else
-		sentMsgLength_ = std::min(sendBuffer_.getSize(), MAX_SEND_LENGTH_);
-#endif
-		sendBuffer_.top(sendMsg_.c_array(), sentMsgLength_);
-		boost::asio::async_write(
-			socket_,
-			boost::asio::buffer(sendMsg_, sentMsgLength_),
-			// caution: shared_from_this() must be used here
-			boost::bind(&TcpSocketConnection::doCompleteSending, shared_from_this(), boost::asio::placeholders::error)
-		);
+		startSending();
+	}
+}
+
+void TcpSocketConnection::startSending()
+{
+	// write the message directly from the segments of the send buffer.
+	const GuardedByteBuffer::value_type *segments[2];
+	std::size_t lengths[2];
+	sentMsgLength_ = sendBuffer_.getReadableSegments(segments, lengths, maxSendLength_);
+	const boost::array<boost::asio::const_buffer, 2> buffers = {{
+		boost::asio::buffer(segments[0], lengths[0]), boost::asio::buffer(segments[1], lengths[1])
+	}};
+	if (statistics_) ++statistics_->pendingOperationCount;
+	boost::asio::async_write(
+		socket_,
+		buffers,
+		// caution: shared_from_this() must be used here
+		strand_.wrap(boost::bind(&TcpSocketConnection::handleSending, shared_from_this(), boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred))
+	);
+}
+
+void TcpSocketConnection::startReceiving()
+{
+	// read the message directly into the free space of the receive buffer.
+	GuardedByteBuffer::value_type *segments[2];
+	std::size_t lengths[2];
+	receiveBuffer_.getWritableSegments(segments, lengths, maxReceiveLength_);
+	const boost::array<boost::asio::mutable_buffer, 2> buffers = {{
+		boost::asio::buffer(segments[0], lengths[0]), boost::asio::buffer(segments[1], lengths[1])
+	}};
+	if (statistics_) ++statistics_->pendingOperationCount;
+	socket_.async_read_some(
+		buffers,
+		// caution: shared_from_this() must be used here
+		strand_.wrap(boost::bind(&TcpSocketConnection::handleReceiving, shared_from_this(), boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred))
+	);
+}
+
+std::size_t TcpSocketConnection::receiveFrames(FrameParser &parser, IFrameHandler &handler)
+{
+	return parser.parse(receiveBuffer_, handler);
+}
+
+void TcpSocketConnection::handleSending(boost::system::error_code ec, std::size_t bytesTransferred)
+{
+	if (statistics_)
+	{
+		--statistics_->pendingOperationCount;
+		statistics_->sentByteCount += bytesTransferred;
+	}
+	doCompleteSending(ec);
+}
+
+void TcpSocketConnection::handleReceiving(boost::system::error_code ec, std::size_t bytesTransferred)
+{
+	if (statistics_)
+	{
+		--statistics_->pendingOperationCount;
+		statistics_->receivedByteCount += bytesTransferred;
 	}
+	doCompleteReceiving(ec, bytesTransferred);
 }
 
 void TcpSocketConnection::doCompleteSending(boost::system::error_code ec)
@@ -103,7 +159,7 @@ void TcpSocketConnection::doCompleteReceiving(boost::system::error_code ec, std:
 	{
 		// TODO [add] >> do something here to process received message
 
-		receiveBuffer_.push(receiveMsg_.data(), bytesTransferred);
+		receiveBuffer_.produce(bytesTransferred);
 	}
 
 	// the third party library successfully performed a read on the socket.
@@ -1,5 +1,7 @@
 #include "swl/Config.h"
 #include "swl/util/TcpSocketSession.h"
+#include "swl/util/FrameParser.h"
+#include <boost/array.hpp>
 
 
 #if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
@@ -14,15 +16,16 @@
 
 
 namespace swl {
-
-#if defined(__GNUC__)
-/*static*/ const std::size_t TcpSocketSession::MAX_SEND_LENGTH_;
-/*static*/ const std::size_t TcpSocketSession::MAX_RECEIVE_LENGTH_;
-#endif
+
+#if defined(__GNUC__)
+/*static*/ const std::size_t TcpSocketSession::DEFAULT_MAX_SEND_LENGTH_;
+/*static*/ const std::size_t TcpSocketSession::DEFAULT_MAX_RECEIVE_LENGTH_;
+#endif
 
 TcpSocketSession::TcpSocketSession(boost::asio::ip::tcp::socket &socket)
 : socket_(socket), state_(RECEIVING),
-  sendBuffer_(), receiveBuffer_(), sendMsg_(), receiveMsg_()
+  sendBuffer_(), receiveBuffer_(), maxSendLength_(DEFAULT_MAX_SEND_LENGTH_), maxReceiveLength_(DEFAULT_MAX_RECEIVE_LENGTH_),
+  sentByteCount_(0), receivedByteCount_(0)
 {
 }
 
@@ -36,13 +39,7 @@ void TcpSocketSession::send(boost::system::error_code &ec)
 		state_ = RECEIVING;
 	else
 	{
-#if defined(__GNUC__)
-		const std::size_t len = std::min(sendBuffer_.getSize(), (std::size_t)MAX_SEND_LENGTH_);
-#else
-		const std::size_t len = std::min(sendBuffer_.getSize(), MAX_SEND_LENGTH_);
-#endif
-		sendBuffer_.top(sendMsg_.c_array(), len);
-		if (const std::size_t sentLen = socket_.write_some(boost::asio::buffer(sendMsg_, len), ec))
+		if (const std::size_t sentLen = writeSendBuffer(ec))
 		{
 			// TODO [add] >> do something here to process sending message
 
@@ -54,15 +51,46 @@ void TcpSocketSession::send(boost::system::error_code &ec)
 
 void TcpSocketSession::receive(boost::system::error_code &ec)
 {
-	if (const std::size_t len = socket_.read_some(boost::asio::buffer(receiveMsg_), ec))
+	if (readReceiveBuffer(ec))
 	{
 		// TODO [add] >> do something here to process received message
 
-		receiveBuffer_.push(receiveMsg_.data(), len);
 		state_ = sendBuffer_.isEmpty() ? RECEIVING : SENDING;
 	}
 }
 
+std::size_t TcpSocketSession::writeSendBuffer(boost::system::error_code &ec)
+{
+	const GuardedByteBuffer::value_type *segments[2];
+	std::size_t lengths[2];
+	sendBuffer_.getReadableSegments(segments, lengths, maxSendLength_);
+	const boost::array<boost::asio::const_buffer, 2> buffers = {{
+		boost::asio::buffer(segments[0], lengths[0]), boost::asio::buffer(segments[1], lengths[1])
+	}};
+	const std::size_t len = socket_.write_some(buffers, ec);
+	sentByteCount_ += len;
+	return len;
+}
+
+std::size_t TcpSocketSession::readReceiveBuffer(boost::system::error_code &ec)
+{
+	GuardedByteBuffer::value_type *segments[2];
+	std::size_t lengths[2];
+	receiveBuffer_.getWritableSegments(segments, lengths, maxReceiveLength_);
+	const boost::array<boost::asio::mutable_buffer, 2> buffers = {{
+		boost::asio::buffer(segments[0], lengths[0]), boost::asio::buffer(segments[1], lengths[1])
+	}};
+	const std::size_t len = socket_.read_some(buffers, ec);
+	if (len) receiveBuffer_.produce(len);
+	receivedByteCount_ += len;
+	return len;
+}
+
+std::size_t TcpSocketSession::receiveFrames(FrameParser &parser, IFrameHandler &handler)
+{
+	return parser.parse(receiveBuffer_, handler);
+}
+
 void TcpSocketSession::clearSendBuffer()
 {
 	sendBuffer_.clear();
@@ -47,6 +47,10 @@
 /** Invalid key token */
 #define DICT_INVALID_KEY    ((char*)-1)
 
+/** Hash index slot states */
+#define IDX_EMPTY		0
+#define IDX_DELETED		(-1)
+
 
 /*---------------------------------------------------------------------------
   							Private functions
@@ -64,6 +68,63 @@ static void * mem_double(void * ptr, int size)
     return newptr ;
 }
 
+/* Returns the hash index slot of a key, or -1 if not found */
+static int dictionary_lookup(dictionary * d, const char * key, unsigned hash)
+{
+	unsigned	mask ;
+	unsigned	i ;
+	int			pos ;
+
+	if (d->idx==NULL) return -1 ;
+	mask = (unsigned)d->idxsize - 1 ;
+	/* The index always has empty slots, so the probing ends */
+	for (i=hash & mask ; ; i=(i+1) & mask) {
+		pos = d->idx[i] ;
+		if (pos==IDX_EMPTY)
+			return -1 ;
+		if (pos!=IDX_DELETED && hash==d->hash[pos-1] && !strcmp(key, d->key[pos-1]))
+			return (int)i ;
+	}
+}
+
+/* Adds an entry position for a key not in the index */
+static void dictionary_index_insert(dictionary * d, unsigned hash, int pos)
+{
+	unsigned	mask ;
+	unsigned	i ;
+
+	mask = (unsigned)d->idxsize - 1 ;
+	for (i=hash & mask ; d->idx[i]>0 ; i=(i+1) & mask)
+		;
+	if (d->idx[i]==IDX_EMPTY)
+		d->idxused ++ ;
+	d->idx[i] = pos + 1 ;
+}
+
+/* Rebuilds the hash index so that it has room for 'count' entries */
+static int dictionary_index_rebuild(dictionary * d, int count)
+{
+	int		*	idx ;
+	int			idxsize ;
+	int			i ;
+
+	/* Keep the load factor under 1/2 */
+	for (idxsize=2*DICTMINSZ ; idxsize<4*count ; idxsize*=2)
+		;
+	if (!(idx = (int *)calloc(idxsize, sizeof(int))))
+		return -1 ;
+
+	free(d->idx);
+	d->idx = idx ;
+	d->idxsize = idxsize ;
+	d->idxused = 0 ;
+	for (i=0 ; i<d->size ; i++) {
+		if (d->key[i]!=NULL)
+			dictionary_index_insert(d, d->hash[i], i);
+	}
+	return 0 ;
+}
+
 
 /*---------------------------------------------------------------------------
   							Function codes
@@ -127,6 +188,14 @@ dictionary * dictionary_new(int size)
 	d->val  = (char **)calloc(size, sizeof(char*));
 	d->key  = (char **)calloc(size, sizeof(char*));
 	d->hash = (unsigned int *)calloc(size, sizeof(unsigned));
+	if (d->val==NULL || d->key==NULL || d->hash==NULL || dictionary_index_rebuild(d, size)!=0) {
+		free(d->val);
+		free(d->key);
+		free(d->hash);
+		free(d->idx);
+		free(d);
+		return NULL;
+	}
 	return d ;
 }
 
@@ -155,6 +224,7 @@ void dictionary_del(dictionary * d)
 	free(d->val);
 	free(d->key);
 	free(d->hash);
+	free(d->idx);
 	free(d);
 	return ;
 }
@@ -177,22 +247,12 @@ void dictionary_del(dictionary * d)
 /*--------------------------------------------------------------------------*/
 char * dictionary_get(dictionary * d, char * key, char * def)
 {
-	unsigned	hash ;
-	int			i ;
+	int			slot ;
 
-	hash = dictionary_hash(key);
-	for (i=0 ; i<d->size ; i++) {
-        if (d->key==NULL)
-            continue ;
-        /* Compare hash */
-		if (hash==d->hash[i]) {
-            /* Compare string, to avoid hash collisions */
-            if (!strcmp(key, d->key[i])) {
-				return d->val[i] ;
-			}
-		}
-	}
-	return def ;
+	slot = dictionary_lookup(d, key, dictionary_hash(key));
+	if (slot<0)
+		return def ;
+	return d->val[d->idx[slot]-1] ;
 }
 
 /*-------------------------------------------------------------------------*/
@@ -296,6 +356,7 @@ double dictionary_getdouble(dictionary * d, char * key, double def)
 void dictionary_set(dictionary * d, char * key, char * val)
 {
 	int			i ;
+	int			slot ;
 	unsigned	hash ;
 
 	if (d==NULL || key==NULL) return ;
@@ -303,21 +364,14 @@ void dictionary_set(dictionary * d, char * key, char * val)
 	/* Compute hash for this key */
 	hash = dictionary_hash(key) ;
 	/* Find if value is already in blackboard */
-	if (d->n>0) {
-		for (i=0 ; i<d->size ; i++) {
-            if (d->key[i]==NULL)
-                continue ;
-			if (hash==d->hash[i]) { /* Same hash value */
-				if (!strcmp(key, d->key[i])) {	 /* Same key */
-					/* Found a value: modify and return */
-					if (d->val[i]!=NULL)
-						free(d->val[i]);
-                    d->val[i] = val ? strdup(val) : NULL ;
-                    /* Value has been modified: return */
-					return ;
-				}
-			}
-		}
+	if (d->n>0 && (slot = dictionary_lookup(d, key, hash))>=0) {
+		/* Found a value: modify and return */
+		i = d->idx[slot] - 1 ;
+		if (d->val[i]!=NULL)
+			free(d->val[i]);
+		d->val[i] = val ? strdup(val) : NULL ;
+		/* Value has been modified: return */
+		return ;
 	}
 	/* Add a new value */
 	/* See if dictionary needs to grow */
@@ -332,8 +386,14 @@ void dictionary_set(dictionary * d, char * key, char * val)
 		d->size *= 2 ;
 	}
 
+	/* Keep the load factor of the index under 1/2 */
+	if (2*(d->idxused+1) > d->idxsize) {
+		if (dictionary_index_rebuild(d, d->n+1)!=0)
+			return ;
+	}
+
     /* Insert key in the first empty slot */
-    for (i=0 ; i<d->size ; i++) {
+    for (i=d->firstfree ; i<d->size ; i++) {
         if (d->key[i]==NULL) {
             /* Add key here */
             break ;
@@ -344,6 +404,8 @@ void dictionary_set(dictionary * d, char * key, char * val)
     d->val[i]  = val ? strdup(val) : NULL ;
 	d->hash[i] = hash;
 	d->n ++ ;
+	d->firstfree = i + 1 ;
+	dictionary_index_insert(d, hash, i);
 	return ;
 }
 
@@ -360,39 +422,32 @@ void dictionary_set(dictionary * d, char * key, char * val)
 /*--------------------------------------------------------------------------*/
 void dictionary_unset(dictionary * d, char * key)
 {
-	unsigned	hash ;
+	int			slot ;
 	int			i ;
 
 	if (key == NULL) {
 		return;
 	}
 
-	hash = dictionary_hash(key);
-	for (i=0 ; i<d->size ; i++) {
-        if (d->key[i]==NULL)
-            continue ;
-        /* Compare hash */
-		if (hash==d->hash[i]) {
-            /* Compare string, to avoid hash collisions */
-            if (!strcmp(key, d->key[i])) {
-                /* Found key */
-                break ;
-			}
-		}
+	slot = dictionary_lookup(d, key, dictionary_hash(key));
+	if (slot<0) {
+		/* Key not found */
+		return ;
 	}
-    if (i>=d->size)
-        /* Key not found */
-        return ;
-
-    free(d->key[i]);
-    d->key[i] = NULL ;
-    if (d->val[i]!=NULL) {
-        free(d->val[i]);
-        d->val[i] = NULL ;
-    }
-    d->hash[i] = 0 ;
-    d->n -- ;
-    return ;
+	i = d->idx[slot] - 1 ;
+	d->idx[slot] = IDX_DELETED ;
+
+	free(d->key[i]);
+	d->key[i] = NULL ;
+	if (d->val[i]!=NULL) {
+		free(d->val[i]);
+		d->val[i] = NULL ;
+	}
+	d->hash[i] = 0 ;
+	d->n -- ;
+	if (i<d->firstfree)
+		d->firstfree = i ;
+	return ;
 }
 
 
@@ -53,6 +53,10 @@ struct dictionary {
 	char 		**	val ;	/** List of string values */
 	char 		**  key ;	/** List of string keys */
 	unsigned	 *	hash ;	/** List of hash values for keys */
+	int			 *	idx ;	/** Open-addressing hash index: entry position + 1, 0 if empty, -1 if deleted */
+	int				idxsize ;	/** Size of the hash index, a power of 2 */
+	int				idxused ;	/** Number of non-empty (used or deleted) index slots */
+	int				firstfree ;	/** No empty entry before this position */
 };
 
 
@@ -110,6 +114,9 @@ void dictionary_del(dictionary * vd);
   value, or the passed 'def' pointer if no such key can be found in
   dictionary. The returned character pointer points to data internal to the
   dictionary object, you should not try to free it or modify it.
+
+  The key is looked up in an open-addressing hash index, so the cost does
+  not depend on the number of entries.
  */
 /*--------------------------------------------------------------------------*/
 char * dictionary_get(dictionary * d, char * key, char * def);
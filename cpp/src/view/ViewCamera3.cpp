@@ -242,13 +242,13 @@ bool ViewCamera3::transform(const ViewMatrix3 &rdT, const bool bUpdateViewpoint
 	return setEyeFrame(rdT * getEyeFrame(), bUpdateViewpoint);
 }
 
-inline bool ViewCamera3::updateEyeDistance(const bool bUpdateViewpoint /*= true*/)
+bool ViewCamera3::updateEyeDistance(const bool bUpdateViewpoint /*= true*/)
 {
 	eyeDistance_ = std::sqrt(std::pow(refObj_[0]-eyePos_[0], 2.0) + std::pow(refObj_[1]-eyePos_[1], 2.0) + std::pow(refObj_[2]-eyePos_[2], 2.0));
 	return bUpdateViewpoint ? doUpdateFrustum() : true;  //-- [] 2001/05/22: Sang-Wook Lee
 }
 
-inline bool ViewCamera3::updateEyePosition(const bool bUpdateViewpoint /*= true*/)
+bool ViewCamera3::updateEyePosition(const bool bUpdateViewpoint /*= true*/)
 {
 	if (eyeDistance_ <= 0.0)  return isValid_ = false;
 	for (int i = 0; i < 3; ++i)  eyePos_[i] = refObj_[i] - eyeDistance_ * eyeDir_[i];
@@ -256,7 +256,7 @@ inline bool ViewCamera3::updateEyePosition(const bool bUpdateViewpoint /*= true*
 	return bUpdateViewpoint ? doUpdateFrustum() : true;
 }
 
-inline bool ViewCamera3::updateEyeDirection(const bool bUpdateViewpoint /*= true*/)
+bool ViewCamera3::updateEyeDirection(const bool bUpdateViewpoint /*= true*/)
 {
 	for (int i = 0; i < 3; ++i)  eyeDir_[i] = refObj_[i] - eyePos_[i];
 	isValid_ &= normalizeVector(eyeDir_);
@@ -559,6 +559,20 @@ bool ViewCamera3::doMapWindowToClip(const double ptWin[3], double ptClip[3]) con
 
 }
 
+bool ViewCamera3::getFrustumVertices(double vertices[8][3]) const
+{
+	// the corners of the clip coordinates: inverse projection, modeling & viewing transformations
+	for (int i = 0; i < 8; ++i)
+	{
+		const double ptClip[3] = { (i & 1) ? 1.0 : -1.0, (i & 2) ? 1.0 : -1.0, (i & 4) ? 1.0 : -1.0 };
+		double ptEye[3] = { 0., };
+		if (!doMapClipToEye(ptClip, ptEye) || !doMapEyeToObject(ptEye, vertices[i]))
+			return false;
+	}
+
+	return true;
+}
+
 bool ViewCamera3::doMapClipToEye(const double ptClip[3], double ptEye[3]) const
 {
 	// inverse projection transformation: a clip coordinates  ==>  an eye coordinates
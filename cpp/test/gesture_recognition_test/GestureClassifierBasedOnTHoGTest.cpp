@@ -2,6 +2,7 @@
 #include "HistogramGenerator.h"  // FIXME [solve] >> These files are duplicates of ${SWL_ROOT}/src/swl_pattern_recognition/HistogramGenerator.h & .cpp.
 #include "swl/pattern_recognition/MotionSegmenter.h"
 #include "swl/rnd_util/HistogramAccumulator.h"
+#include "swl/rnd_util/HistogramMatcher.h"
 #include "swl/rnd_util/HistogramUtil.h"
 #define CV_NO_BACKWARD_COMPATIBILITY
 #include <opencv2/opencv.hpp>
@@ -140,6 +141,7 @@ const double gesturePatternHistogramNormalizationFactor = 10.0; //(double)maxMat
 
 //
 std::vector<swl::HistogramAccumulator::histogram_type> refFullPhaseHistograms;
+boost::shared_ptr<swl::PackedHistogramMatcher> refFullPhaseHistogramMatcher;
 boost::shared_ptr<swl::HistogramAccumulator> orientationHistogramAccumulator(doesApplyTimeWeighting ? new swl::HistogramAccumulator(getHistogramTimeWeight(accumulatedOrientationHistogramNum)) : new swl::HistogramAccumulator(accumulatedOrientationHistogramNum));
 
 void accumulateOrientationHistogram(const cv::Mat &orientation, std::ostream *stream)
@@ -189,6 +191,7 @@ void createReferenceFullPhaseHistograms()
 	const std::vector<cv::MatND> &refHistograms = refHistogramGenerator.getHistograms();
 
 	refFullPhaseHistograms.assign(refHistograms.begin(), refHistograms.end());
+	refFullPhaseHistogramMatcher.reset(new swl::PackedHistogramMatcher(refFullPhaseHistograms, swl::PackedHistogramMatcher::BHATTACHARYYA));
 
 #if 0
 	// FIXME [delete] >>
@@ -226,7 +229,7 @@ bool computeTemporalOrientationHistogram(cv::MatND &temporalOrientationHist)
 #if 1
 		temporalOrientationHist = orientationHistogramAccumulator->createTemporalHistogram();
 #else
-		temporalOrientationHist = orientationHistogramAccumulator->createTemporalHistogram(refFullPhaseHistograms, histDistThresholdForTemporalOrientationHistogram);
+		temporalOrientationHist = orientationHistogramAccumulator->createTemporalHistogram(refFullPhaseHistograms, *refFullPhaseHistogramMatcher, histDistThresholdForTemporalOrientationHistogram);
 #endif
 		// Normalize histogram.
 		swl::HistogramUtil::normalizeHistogram(temporalOrientationHist, refHistogramNormalizationFactor);
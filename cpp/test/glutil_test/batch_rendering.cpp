@@ -0,0 +1,347 @@
+//#include "stdafx.h"
+#if !defined(_WIN64) && !defined(WIN64) && !defined(_WIN32) && !defined(WIN32) && !defined(__APPLE__)
+#define __USE_EGL 1
+#endif
+#include "swl/glutil/GLBatchRenderer.h"
+#include "swl/glutil/GLMeshGeometry.h"
+#include "swl/glutil/GLShape.h"
+#include "swl/glutil/GLShapeSceneNode.h"
+#include "swl/graphics/GeometryPoolMgr.h"
+#include "swl/graphics/TransformSceneNode.h"
+#include "swl/graphics/TriangleMesh.h"
+#if defined(_WIN64) || defined(WIN64) || defined(_WIN32) || defined(WIN32)
+#include <windows.h>
+#endif
+#if defined(__USE_EGL)
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+#include <GL/gl.h>
+#include <boost/smart_ptr.hpp>
+#include <iostream>
+#include <stdexcept>
+#include <cstdlib>
+
+
+namespace {
+namespace local {
+
+swl::TriangleMesh createSquareMesh()
+{
+	const float vertices[] = { -1.0f, -1.0f, 0.0f,  1.0f, -1.0f, 0.0f,  1.0f, 1.0f, 0.0f,  -1.0f, 1.0f, 0.0f };
+	const unsigned int indices[] = { 0, 1, 2,  0, 2, 3 };
+	return swl::TriangleMesh(std::vector<float>(vertices, vertices + 12), std::vector<unsigned int>(indices, indices + 6));
+}
+
+// a unit square in the plane z = 0 with its own triangle mesh, which is never drawn one by one.
+class SquareShape: public swl::GLShape
+{
+public:
+	typedef swl::GLShape base_type;
+
+public:
+	SquareShape(const bool isTransparent, const swl::attrib::PolygonMode polygonMode)
+	: base_type(0u, isTransparent, true, true, polygonMode), mesh_(createSquareMesh())
+	{}
+
+public:
+	/*virtual*/ void draw() const  {}
+	/*virtual*/ const swl::TriangleMesh * getTriangleMesh() const  {  return &mesh_;  }
+
+private:
+	swl::TriangleMesh mesh_;
+};
+
+// a shape drawing the geometry it refers to. its triangle mesh is the one of the geometry.
+class MeshShape: public swl::GLShape
+{
+public:
+	typedef swl::GLShape base_type;
+
+public:
+	MeshShape(const geometry_id_type geometryId, const bool isTransparent, const swl::attrib::PolygonMode polygonMode)
+	: base_type(0u, isTransparent, true, true, polygonMode)
+	{
+		getGeometryId() = geometryId;
+	}
+
+public:
+	/*virtual*/ void draw() const
+	{
+		const geometry_type &geometry = getGeometry();
+		if (!geometry) return;
+
+		glPushAttrib(GL_CURRENT_BIT | GL_POLYGON_BIT);
+			glPolygonMode(GL_FRONT, swl::attrib::POLYGON_LINE == getPolygonMode() ? GL_LINE : GL_FILL);
+			glColor4f(red(), green(), blue(), alpha());
+			geometry->draw();
+		glPopAttrib();
+	}
+};
+
+// a shape without a triangle mesh.
+class ImmediateShape: public swl::GLShape
+{
+public:
+	typedef swl::GLShape base_type;
+
+public:
+	ImmediateShape()
+	: base_type(0u)
+	{}
+
+public:
+	/*virtual*/ void draw() const
+	{
+		glPushAttrib(GL_CURRENT_BIT);
+			glColor4f(red(), green(), blue(), alpha());
+			glBegin(GL_QUADS);
+				glVertex2f(-1.0f, -1.0f);  glVertex2f(1.0f, -1.0f);  glVertex2f(1.0f, 1.0f);  glVertex2f(-1.0f, 1.0f);
+			glEnd();
+		glPopAttrib();
+	}
+};
+
+typedef swl::IGLSceneVisitor visitor_type;
+typedef swl::GLShapeSceneNode<visitor_type>::shape_type shape_type;
+
+shape_type addShape(const boost::shared_ptr<swl::GroupSceneNode<visitor_type> > &root, swl::GLShape *shape, const double x, const double y = 0.0)
+{
+	boost::shared_ptr<swl::TransformSceneNode<visitor_type> > transformNode(new swl::TransformSceneNode<visitor_type>());
+	swl::TMatrix3<double> transform;
+	transform.T() = swl::TMatrix3<double>::column_type(x, y, 0.0);
+	transformNode->setTransform(transform);
+
+	shape_type shapePtr(shape);
+	transformNode->addChild(swl::ISceneNode<visitor_type>::node_type(new swl::GLShapeSceneNode<visitor_type>(shapePtr)));
+	root->addChild(transformNode);
+	return shapePtr;
+}
+
+swl::GeometryPoolMgr::geometry_id_type createSquareGeometry()
+{
+	swl::GeometryPoolMgr &geometryPoolMgr = swl::GeometryPoolMgr::getInstance();
+	const swl::GeometryPoolMgr::geometry_id_type geometryId = geometryPoolMgr.createGeometryId();
+	swl::GeometryPoolMgr::geometry_type geometry(new swl::GLMeshGeometry(createSquareMesh()));
+	geometryPoolMgr.setGeometry(geometryId, geometry);
+	return geometryId;
+}
+
+void check(const bool condition, const char *message)
+{
+	if (!condition) throw std::runtime_error(message);
+}
+
+#if defined(__USE_EGL)
+
+// a 64 x 64 pbuffer with a compatibility profile context, on the display of the window system or on Mesa's surfaceless platform.
+class OffscreenContext
+{
+public:
+	OffscreenContext()
+	: display_(EGL_NO_DISPLAY), surface_(EGL_NO_SURFACE), context_(EGL_NO_CONTEXT)
+	{
+		EGLint major = 0, minor = 0;
+		display_ = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+		if (EGL_NO_DISPLAY == display_ || !eglInitialize(display_, &major, &minor))
+		{
+			PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+			display_ = getPlatformDisplay ? getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL) : EGL_NO_DISPLAY;
+			if (EGL_NO_DISPLAY == display_ || !eglInitialize(display_, &major, &minor))
+			{
+				display_ = EGL_NO_DISPLAY;
+				return;
+			}
+		}
+
+		const EGLint configAttribs[] = {
+			EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+			EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+			EGL_NONE
+		};
+		const EGLint surfaceAttribs[] = { EGL_WIDTH, WIDTH, EGL_HEIGHT, HEIGHT, EGL_NONE };
+		EGLConfig config;
+		EGLint configCount = 0;
+		if (!eglChooseConfig(display_, configAttribs, &config, 1, &configCount) || configCount < 1 || !eglBindAPI(EGL_OPENGL_API))
+			return;
+
+		surface_ = eglCreatePbufferSurface(display_, config, surfaceAttribs);
+		context_ = eglCreateContext(display_, config, EGL_NO_CONTEXT, NULL);
+		if (EGL_NO_SURFACE != surface_ && EGL_NO_CONTEXT != context_)
+			eglMakeCurrent(display_, surface_, surface_, context_);
+	}
+	~OffscreenContext()
+	{
+		if (EGL_NO_DISPLAY == display_) return;
+
+		eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		if (EGL_NO_CONTEXT != context_) eglDestroyContext(display_, context_);
+		if (EGL_NO_SURFACE != surface_) eglDestroySurface(display_, surface_);
+		eglTerminate(display_);
+	}
+
+public:
+	bool isCurrent() const  {  return EGL_NO_CONTEXT != context_ && eglGetCurrentContext() == context_;  }
+
+public:
+	static const int WIDTH = 64, HEIGHT = 64;
+
+private:
+	EGLDisplay display_;
+	EGLSurface surface_;
+	EGLContext context_;
+};
+
+// the object coordinates [-8, 8] x [-8, 8] are mapped onto the 64 x 64 pixels. a pixel is a quarter of a unit.
+void setView()
+{
+	glViewport(0, 0, OffscreenContext::WIDTH, OffscreenContext::HEIGHT);
+	glMatrixMode(GL_PROJECTION);
+	glLoadIdentity();
+	glOrtho(-8.0, 8.0, -8.0, 8.0, -1.0, 1.0);
+	glMatrixMode(GL_MODELVIEW);
+	glLoadIdentity();
+
+	glDisable(GL_LIGHTING);
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_BLEND);
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT);
+}
+
+bool isPixel(const double x, const double y, const int r, const int g, const int b)
+{
+	unsigned char rgba[4] = { 0, 0, 0, 0 };
+	glReadPixels(int((x + 8.0) * 4.0), int((y + 8.0) * 4.0), 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+	return std::abs(rgba[0] - r) <= 2 && std::abs(rgba[1] - g) <= 2 && std::abs(rgba[2] - b) <= 2;
+}
+
+#endif  // __USE_EGL
+
+}  // namespace local
+}  // unnamed namespace
+
+// no rendering context is current here, so only the batching is checked & the vertex arrays stay on the client side.
+void batch_rendering()
+{
+	const swl::GeometryPoolMgr::geometry_id_type geometryId = local::createSquareGeometry();
+
+	boost::shared_ptr<swl::GroupSceneNode<local::visitor_type> > root(new swl::GroupSceneNode<local::visitor_type>());
+	for (int i = 0; i < 2; ++i)
+		local::addShape(root, new local::MeshShape(geometryId, false, swl::attrib::POLYGON_FILL), 3.0 * i);
+	local::addShape(root, new local::SquareShape(false, swl::attrib::POLYGON_FILL), 6.0);
+	local::addShape(root, new local::MeshShape(geometryId, true, swl::attrib::POLYGON_FILL), 9.0);
+	local::addShape(root, new local::SquareShape(false, swl::attrib::POLYGON_LINE), 12.0);
+	local::addShape(root, new local::ImmediateShape(), 15.0);
+
+	swl::GLBatchRenderer renderer;
+	renderer.build(root);
+	// the opaque filled squares share a batch. the transparent & the wireframe ones get their own.
+	local::check(3 == renderer.getBatchCount(), "the shapes are not grouped by their render states");
+	local::check(5 == renderer.getBatchedShapeCount(), "the shapes with triangle meshes are not batched");
+	local::check(1 == renderer.getUnbatchedShapeCount(), "the shape without a triangle mesh is batched");
+	local::check(!renderer.isBufferObjectUsed(), "buffer objects are created without a rendering context");
+
+	std::cout << "batch rendering: " << renderer.getBatchedShapeCount() << " shapes are packed into " << renderer.getBatchCount() << " batches" << std::endl;
+
+	renderer.release();
+	local::check(0 == renderer.getBatchCount() && 0 == renderer.getUnbatchedShapeCount(), "the batches are not released");
+
+	swl::GeometryPoolMgr::getInstance().deleteGeometryId(geometryId);
+}
+
+// draw through GLBatchRenderer::render() into an offscreen buffer & compare with GLRenderSceneVisitor.
+void batch_rendering_offscreen()
+{
+#if defined(__USE_EGL)
+	local::OffscreenContext context;
+	if (!context.isCurrent())
+	{
+		std::cout << "batch rendering offscreen: skipped, no EGL rendering context" << std::endl;
+		return;
+	}
+	std::cout << "batch rendering offscreen: " << glGetString(GL_RENDERER) << ", OpenGL " << glGetString(GL_VERSION) << std::endl;
+
+	const swl::GeometryPoolMgr::geometry_id_type geometryId = local::createSquareGeometry();
+
+	// a row of opaque filled squares, a transparent one, a wireframe one & one drawn one by one.
+	// the edges of the wireframe square run through the centers of pixels.
+	boost::shared_ptr<swl::GroupSceneNode<local::visitor_type> > root(new swl::GroupSceneNode<local::visitor_type>());
+	const local::shape_type red(local::addShape(root, new local::MeshShape(geometryId, false, swl::attrib::POLYGON_FILL), -6.0, 4.0));
+	const local::shape_type green(local::addShape(root, new local::MeshShape(geometryId, false, swl::attrib::POLYGON_FILL), -3.0, 4.0));
+	const local::shape_type blue(local::addShape(root, new local::MeshShape(geometryId, false, swl::attrib::POLYGON_FILL), 0.0, 4.0));
+	const local::shape_type yellow(local::addShape(root, new local::SquareShape(false, swl::attrib::POLYGON_FILL), 3.0, 4.0));
+	const local::shape_type white(local::addShape(root, new local::MeshShape(geometryId, true, swl::attrib::POLYGON_FILL), 6.0, 4.0));
+	const local::shape_type magenta(local::addShape(root, new local::MeshShape(geometryId, false, swl::attrib::POLYGON_LINE), -6.125, -4.125));
+	const local::shape_type cyan(local::addShape(root, new local::ImmediateShape(), 0.0, -4.0));
+	red->setColor(1.0f, 0.0f, 0.0f);
+	green->setColor(0.0f, 1.0f, 0.0f);
+	blue->setColor(0.0f, 0.0f, 1.0f);
+	yellow->setColor(1.0f, 1.0f, 0.0f);
+	white->setColor(1.0f, 1.0f, 1.0f, 0.5f);
+	magenta->setColor(1.0f, 0.0f, 1.0f);
+	cyan->setColor(0.0f, 1.0f, 1.0f);
+
+	swl::GLBatchRenderer renderer;
+	renderer.build(root);
+	local::check(3 == renderer.getBatchCount() && 6 == renderer.getBatchedShapeCount() && 1 == renderer.getUnbatchedShapeCount(), "the shapes are not batched in a rendering context");
+	local::check(renderer.isBufferObjectUsed(), "no buffer objects are created in a rendering context");
+
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		// the batches first, then the shapes one by one for reference.
+		local::setView();
+		if (0 == pass)
+		{
+			renderer.render(swl::GLRenderSceneVisitor::RENDER_OPAQUE_OBJECTS);
+			// a multi-draw call for the filled batch, one for the wireframe batch & one for the shape without a mesh.
+			local::check(3 == renderer.getDrawCallCount(), "the opaque batches are not drawn with one call each");
+		}
+		else root->accept(swl::GLRenderSceneVisitor(swl::GLRenderSceneVisitor::RENDER_OPAQUE_OBJECTS));
+
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		if (0 == pass)
+		{
+			renderer.render(swl::GLRenderSceneVisitor::RENDER_TRANSPARENT_OBJECTS);
+			local::check(1 == renderer.getDrawCallCount(), "the transparent batch is not drawn with one call");
+		}
+		else root->accept(swl::GLRenderSceneVisitor(swl::GLRenderSceneVisitor::RENDER_TRANSPARENT_OBJECTS));
+		glFinish();
+
+		const char *message = 0 == pass ? "a batched shape is drawn wrong" : "a shape is drawn wrong one by one";
+		local::check(local::isPixel(-6.0, 4.0, 255, 0, 0) && local::isPixel(-3.0, 4.0, 0, 255, 0) && local::isPixel(0.0, 4.0, 0, 0, 255), message);
+		local::check(local::isPixel(3.0, 4.0, 1 == pass ? 0 : 255, 1 == pass ? 0 : 255, 0), message);  // a SquareShape draws nothing by itself.
+		local::check(local::isPixel(6.0, 4.0, 128, 128, 128), message);  // half transparent white over black.
+		local::check(local::isPixel(-5.625, -4.625, 0, 0, 0) && local::isPixel(-7.125, -4.0, 255, 0, 255), message);  // inside & on the left edge of the wireframe square.
+		local::check(local::isPixel(0.0, -4.0, 0, 255, 255) && local::isPixel(-4.5, 4.0, 0, 0, 0), message);
+	}
+
+	// a hidden shape splits the filled batch into two runs, which are still drawn with one call.
+	green->setVisible(false);
+	local::setView();
+	renderer.render(swl::GLRenderSceneVisitor::RENDER_OPAQUE_OBJECTS);
+	glFinish();
+	local::check(3 == renderer.getDrawCallCount(), "the runs of a batch are not drawn with one call");
+	local::check(local::isPixel(-6.0, 4.0, 255, 0, 0) && local::isPixel(-3.0, 4.0, 0, 0, 0) && local::isPixel(0.0, 4.0, 0, 0, 255), "a hidden shape is drawn");
+
+	// the colors are refreshed in the vertex buffer.
+	red->setColor(0.0f, 0.0f, 1.0f);
+	renderer.updateColors();
+	local::setView();
+	renderer.render(swl::GLRenderSceneVisitor::RENDER_OPAQUE_OBJECTS);
+	glFinish();
+	local::check(local::isPixel(-6.0, 4.0, 0, 0, 255), "the vertex colors are not updated");
+	local::check(GL_NO_ERROR == glGetError(), "an OpenGL error occurred");
+
+	std::cout << "batch rendering offscreen: " << renderer.getBatchedShapeCount() << " shapes are drawn with " << renderer.getDrawCallCount() << " draw calls" << std::endl;
+
+	// the buffers are released while the context is current.
+	renderer.release();
+	local::check(!renderer.isBufferObjectUsed(), "the buffer objects are not released");
+
+	swl::GeometryPoolMgr::getInstance().deleteGeometryId(geometryId);
+#else
+	std::cout << "batch rendering offscreen: skipped, EGL is not used on this platform" << std::endl;
+#endif
+}
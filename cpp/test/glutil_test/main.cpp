@@ -9,10 +9,16 @@
 
 int main(int argc, char *argv[])
 {
+	void ray_cast_picking();
+	void batch_rendering();
+	void batch_rendering_offscreen();
+
 	int retval = EXIT_SUCCESS;
 	try
 	{
-		throw std::runtime_error("Not yet implemented");
+		ray_cast_picking();
+		batch_rendering();
+		batch_rendering_offscreen();
 	}
     catch (const std::bad_alloc &e)
 	{
@@ -0,0 +1,127 @@
+//#include "stdafx.h"
+#include "swl/glutil/GLRayCastPicker.h"
+#include "swl/glutil/GLShape.h"
+#include "swl/glutil/GLShapeSceneNode.h"
+#include "swl/graphics/TransformSceneNode.h"
+#include "swl/graphics/TriangleMesh.h"
+#include "swl/view/ViewCamera3.h"
+#include <boost/smart_ptr.hpp>
+#include <iostream>
+#include <stdexcept>
+#include <cmath>
+
+
+namespace {
+namespace local {
+
+// a unit square in the plane z = 0, which is never drawn.
+class SquareShape: public swl::GLShape
+{
+public:
+	typedef swl::GLShape base_type;
+
+public:
+	SquareShape()
+	: base_type(0u), mesh_()
+	{
+		const float vertices[] = { -1.0f, -1.0f, 0.0f,  1.0f, -1.0f, 0.0f,  1.0f, 1.0f, 0.0f,  -1.0f, 1.0f, 0.0f };
+		const unsigned int indices[] = { 0, 1, 2,  0, 2, 3 };
+		mesh_.setVertices(std::vector<float>(vertices, vertices + 12));
+		mesh_.setIndices(std::vector<unsigned int>(indices, indices + 6));
+	}
+
+public:
+	/*virtual*/ void draw() const  {}
+	/*virtual*/ bool getBound(swl::BoundingBox<double> &bound) const  {  return mesh_.getBound(bound);  }
+	/*virtual*/ const swl::TriangleMesh * getTriangleMesh() const  {  return &mesh_;  }
+
+private:
+	swl::TriangleMesh mesh_;
+};
+
+typedef swl::IGLSceneVisitor visitor_type;
+typedef swl::GLShapeSceneNode<visitor_type>::shape_type shape_type;
+
+swl::ISceneNode<visitor_type>::node_type addSquare(const boost::shared_ptr<swl::GroupSceneNode<visitor_type> > &root, shape_type &shape, const double x, const double y, const double z)
+{
+	boost::shared_ptr<swl::TransformSceneNode<visitor_type> > transformNode(new swl::TransformSceneNode<visitor_type>());
+	swl::TMatrix3<double> transform;
+	transform.T() = swl::TMatrix3<double>::column_type(x, y, z);
+	transformNode->setTransform(transform);
+
+	shape.reset(new SquareShape());
+	transformNode->addChild(swl::ISceneNode<visitor_type>::node_type(new swl::GLShapeSceneNode<visitor_type>(shape)));
+	root->addChild(transformNode);
+	return transformNode;
+}
+
+void check(const bool condition, const char *message)
+{
+	if (!condition) throw std::runtime_error(message);
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+void ray_cast_picking()
+{
+	boost::shared_ptr<swl::GroupSceneNode<local::visitor_type> > root(new swl::GroupSceneNode<local::visitor_type>());
+	local::shape_type nearShape, farShape, sideShape;
+	local::addSquare(root, farShape, 0.0, 0.0, -5.0);
+	local::addSquare(root, nearShape, 0.0, 0.0, 5.0);
+	local::addSquare(root, sideShape, 10.0, 0.0, 0.0);
+
+	swl::GLRayCastPicker picker;
+	picker.build(root);
+	local::check(3 == picker.getShapeCount(), "the shapes are not collected");
+
+	// a ray along -z hits the nearest square first.
+	{
+		const double origin[3] = { 0.5, 0.5, 100.0 }, direction[3] = { 0.0, 0.0, -1.0 };
+		swl::GLRayCastPicker::Hit hit;
+		local::check(picker.pick(swl::Ray<double>(origin, direction), hit), "no hit");
+		local::check(hit.shape == nearShape && std::fabs(hit.t - 95.0) < 1.0e-9, "a wrong shape is picked");
+		local::check(hit.objectId == swl::GLRayCastPicker::getObjectId(nearShape.get()), "a wrong object id");
+	}
+	// a ray passing inside the bound of the side square but outside its triangles.
+	{
+		const double origin[3] = { 11.5, 0.0, 100.0 }, direction[3] = { 0.0, 0.0, -1.0 };
+		swl::GLRayCastPicker::Hit hit;
+		local::check(!picker.pick(swl::Ray<double>(origin, direction), hit), "an empty space is picked");
+	}
+
+	// pick through a camera looking down -z.
+	swl::ViewCamera3 camera;
+	camera.setViewBound(-20.0, -20.0, 20.0, 20.0, 1.0, 200.0);
+	camera.setViewport(0, 0, 400, 400);
+	camera.setEyePosition(0.0, 0.0, 50.0, false);
+	camera.setEyePose(0.0, 0.0, -1.0, 0.0, 1.0, 0.0);
+
+	swl::ViewCamera3 perspectiveCamera(camera);
+	perspectiveCamera.setPerspective(true);
+
+	const swl::ViewCamera3 *cameras[] = { &camera, &perspectiveCamera };
+	for (int i = 0; i < 2; ++i)
+	{
+		double ptWin[3] = { 0.0, 0.0, 0.0 };
+		const double ptSide[3] = { 10.0, 0.5, 0.0 };
+		cameras[i]->mapObjectToWindow(ptSide, ptWin);
+
+		swl::GLRayCastPicker::Hit hit;
+		local::check(picker.pick(*cameras[i], int(ptWin[0] + 0.5), int(ptWin[1] + 0.5), hit), "no hit through a camera");
+		local::check(hit.shape == sideShape, "a wrong shape is picked through a camera");
+	}
+
+	// feed the picker manager.
+	swl::ObjectPickerMgr::getInstance().clearAllPickedObjects();
+	{
+		double ptWin[3] = { 0.0, 0.0, 0.0 };
+		const double ptCenter[3] = { 0.0, 0.0, 5.0 };
+		camera.mapObjectToWindow(ptCenter, ptWin);
+		local::check(picker.pickObject(camera, int(ptWin[0] + 0.5), int(ptWin[1] + 0.5)), "the picked objects are not changed");
+		local::check(swl::ObjectPickerMgr::getInstance().isPickedObject(swl::GLRayCastPicker::getObjectId(nearShape.get())), "the picked object is not registered");
+	}
+	swl::ObjectPickerMgr::getInstance().clearAllPickedObjects();
+
+	std::cout << "ray-cast picking: " << picker.getShapeCount() << " shapes are picked correctly" << std::endl;
+}
@@ -124,6 +124,28 @@ CliffWalkingStateActionPair::State CliffWalkingStateActionPair::State::takeActio
 	}
 }
 
+/*static*/ CliffWalkingStateActionPair::action_type CliffWalkingStateActionPair::getGreedyAction(const state_type &state, const swl::DenseActionValueTable<CliffWalkingStateActionPair> &Q)
+{
+	return Q.getGreedyAction(state);
+}
+
+/*static*/ CliffWalkingStateActionPair::action_type CliffWalkingStateActionPair::getActionFromPolicy(const state_type &state, const swl::DenseActionValueTable<CliffWalkingStateActionPair> &Q, const policy_type &policy, const double epsilon)
+{
+	const double prob = double(std::rand() % RAND_MAX) / double(RAND_MAX);
+
+	switch (policy)
+	{
+	case GREEDY_POLICY:  // greedy policy
+		return getGreedyAction(state, Q);
+	case EPSILON_GREEDY_POLICY:  // epsilon-greedy policy
+		return prob < (1.0 - epsilon) ? getGreedyAction(state, Q) : getRandomAction();
+	case EPSILON_SOFT_POLICY:  // epsilon-soft policy
+		return prob < (1.0 - epsilon + epsilon / (double)action_type::ACTION_SIZE) ? getGreedyAction(state, Q) : getRandomAction();
+	default:
+		throw std::runtime_error("undefined policy");
+	}
+}
+
 /*static*/ double CliffWalkingStateActionPair::epsilonFunction(const size_t episodeTrial)
 {
 	// constant exploration rate (epsilon)
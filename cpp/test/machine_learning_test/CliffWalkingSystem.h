@@ -2,6 +2,7 @@
 #define __SWL_MACHINE_LEARNING_TEST__CLIFF_WALKING_SYSTEM__H_ 1
 
 
+#include "swl/machine_learning/TDTabularStorage.h"
 #include <map>
 
 
@@ -123,6 +124,9 @@ public:
 	}
 
 public:
+	const state_type & getState() const  {  return state_;  }
+	const action_type & getAction() const  {  return action_;  }
+
 	bool operator<(const CliffWalkingStateActionPair &rhs) const
 	{
 		return state_.getValue() * action_type::ACTION_SIZE + action_.getValue() < rhs.state_.getValue() * action_type::ACTION_SIZE + rhs.action_.getValue();
@@ -131,6 +135,8 @@ public:
 	static action_type getGreedyAction(const state_type &state, const std::map<const CliffWalkingStateActionPair, double> &Q);
 	static action_type getRandomAction();
 	static action_type getActionFromPolicy(const state_type &state, const std::map<const CliffWalkingStateActionPair, double> &Q, const policy_type &policy, const double epsilon);
+	static action_type getGreedyAction(const state_type &state, const swl::DenseActionValueTable<CliffWalkingStateActionPair> &Q);
+	static action_type getActionFromPolicy(const state_type &state, const swl::DenseActionValueTable<CliffWalkingStateActionPair> &Q, const policy_type &policy, const double epsilon);
 
 	static double epsilonFunction(const std::size_t episodeTrial);
 	static double stepSizeFunction(const std::size_t iterationStep);
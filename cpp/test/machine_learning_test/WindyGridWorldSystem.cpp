@@ -130,6 +130,28 @@ WindyGridWorldStateActionPair::State WindyGridWorldStateActionPair::State::takeA
 	}
 }
 
+/*static*/ WindyGridWorldStateActionPair::action_type WindyGridWorldStateActionPair::getGreedyAction(const state_type &state, const swl::DenseActionValueTable<WindyGridWorldStateActionPair> &Q)
+{
+	return Q.getGreedyAction(state);
+}
+
+/*static*/ WindyGridWorldStateActionPair::action_type WindyGridWorldStateActionPair::getActionFromPolicy(const state_type &state, const swl::DenseActionValueTable<WindyGridWorldStateActionPair> &Q, const policy_type &policy, const double epsilon)
+{
+	const double prob = double(std::rand() % RAND_MAX) / double(RAND_MAX);
+
+	switch (policy)
+	{
+	case GREEDY_POLICY:  // greedy policy
+		return getGreedyAction(state, Q);
+	case EPSILON_GREEDY_POLICY:  // epsilon-greedy policy
+		return prob < (1.0 - epsilon) ? getGreedyAction(state, Q) : getRandomAction();
+	case EPSILON_SOFT_POLICY:  // epsilon-soft policy
+		return prob < (1.0 - epsilon + epsilon / (double)action_type::ACTION_SIZE) ? getGreedyAction(state, Q) : getRandomAction();
+	default:
+		throw std::runtime_error("undefined policy");
+	}
+}
+
 /*static*/ double WindyGridWorldStateActionPair::epsilonFunction(const size_t episodeTrial)
 {
 	// constant exploration rate (epsilon)
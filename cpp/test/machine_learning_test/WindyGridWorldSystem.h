@@ -2,6 +2,7 @@
 #define __SWL_MACHINE_LEARNING_TEST__WINDY_GRID_WORLD_SYSTEM__H_ 1
 
 
+#include "swl/machine_learning/TDTabularStorage.h"
 #include <map>
 
 
@@ -124,6 +125,9 @@ public:
 	}
 
 public:
+	const state_type & getState() const  {  return state_;  }
+	const action_type & getAction() const  {  return action_;  }
+
 	bool operator<(const WindyGridWorldStateActionPair &rhs) const
 	{
 		return state_.getValue() * action_type::ACTION_SIZE + action_.getValue() < rhs.state_.getValue() * action_type::ACTION_SIZE + rhs.action_.getValue();
@@ -132,6 +136,8 @@ public:
 	static action_type getGreedyAction(const state_type &state, const std::map<const WindyGridWorldStateActionPair, double> &Q);
 	static action_type getRandomAction();
 	static action_type getActionFromPolicy(const state_type &state, const std::map<const WindyGridWorldStateActionPair, double> &Q, const policy_type &policy, const double epsilon);
+	static action_type getGreedyAction(const state_type &state, const swl::DenseActionValueTable<WindyGridWorldStateActionPair> &Q);
+	static action_type getActionFromPolicy(const state_type &state, const swl::DenseActionValueTable<WindyGridWorldStateActionPair> &Q, const policy_type &policy, const double epsilon);
 
 	static double epsilonFunction(const std::size_t episodeTrial);
 	static double stepSizeFunction(const std::size_t iterationStep);
@@ -4,6 +4,7 @@
 #include "swl/machine_learning/QLearning.h"
 #include "swl/machine_learning/SarsaLambda.h"
 #include "swl/machine_learning/QLambda.h"
+#include "swl/machine_learning/ParallelTDEpisodeRunner.h"
 #if defined(_WIN64) || defined(WIN64) || defined(_WIN32) || defined(WIN32)
 #include "swl/winutil/WinTimer.h"
 #elif defined(__linux) || defined(__linux__) || defined(linux) || defined(__unix) || defined(__unix__) || defined(unix)
@@ -219,6 +220,106 @@ void q_lambda(const size_t maxEpisodeCount, const state_action_pair_type::policy
 	}
 }
 
+// Sarsa(lambda) with a dense action-value table & a sparse eligibility trace
+void sarsa_lambda_with_dense_table(const size_t maxEpisodeCount, const state_action_pair_type::policy_type policy, const double gamma, const double lambda, const bool isReplacingTrace)
+{
+	std::cout << "<<-- Sarsa(lambda): dense table -->>" << std::endl;
+
+	typedef swl::DenseActionValueTable<state_action_pair_type> action_value_table_type;
+	typedef swl::SparseEligibilityTrace<state_action_pair_type> eligibility_trace_type;
+
+	// initialize Q(state, action)
+	action_value_table_type Q(0.0);
+	eligibility_trace_type eligibility(1.0e-5);
+
+	if (Q.size() != state_action_pair_type::state_type::STATE_SIZE * state_action_pair_type::action_type::ACTION_SIZE)
+	{
+		std::cerr << "state-action pair generation error" << std::endl;
+		return;
+	}
+
+	{
+#if defined(_WIN64) || defined(WIN64) || defined(_WIN32) || defined(WIN32)
+		swl::WinTimer aTimer;
+#elif defined(__linux) || defined(__linux__) || defined(linux) || defined(__unix) || defined(__unix__) || defined(unix)
+		swl::PosixTimer aTimer;
+#endif
+		const swl::SarsaLambda<state_action_pair_type, action_value_table_type, eligibility_trace_type> learner(gamma, &state_action_pair_type::epsilonFunction, &state_action_pair_type::stepSizeFunction, lambda, isReplacingTrace);
+		learner.train(maxEpisodeCount, policy, Q, eligibility);
+		std::cout << "elapsed time: " << aTimer.getElapsedTimeInMilliSecond() << " msec" << std::endl;
+
+		for (size_t row = 1; row <= state_action_pair_type::state_type::GRID_ROW_SIZE; ++row)
+		{
+			for (size_t col = 1; col <= state_action_pair_type::state_type::GRID_COL_SIZE; ++col)
+				std::cout << getActionSymbol(state_action_pair_type::getGreedyAction(state_action_pair_type::state_type(row, col), Q)) << "  ";
+			std::cout << std::endl;
+		}
+	}
+}
+
+// Q(lambda) with a dense action-value table & a sparse eligibility trace
+void q_lambda_with_dense_table(const size_t maxEpisodeCount, const state_action_pair_type::policy_type policy, const double gamma, const double lambda, const bool isReplacingTrace)
+{
+	std::cout << "<<-- Q(lambda): dense table -->>" << std::endl;
+
+	typedef swl::DenseActionValueTable<state_action_pair_type> action_value_table_type;
+	typedef swl::SparseEligibilityTrace<state_action_pair_type> eligibility_trace_type;
+
+	// initialize Q(state, action)
+	action_value_table_type Q(0.0);
+	eligibility_trace_type eligibility(1.0e-5);
+
+	if (Q.size() != state_action_pair_type::state_type::STATE_SIZE * state_action_pair_type::action_type::ACTION_SIZE)
+	{
+		std::cerr << "state-action pair generation error" << std::endl;
+		return;
+	}
+
+	{
+#if defined(_WIN64) || defined(WIN64) || defined(_WIN32) || defined(WIN32)
+		swl::WinTimer aTimer;
+#elif defined(__linux) || defined(__linux__) || defined(linux) || defined(__unix) || defined(__unix__) || defined(unix)
+		swl::PosixTimer aTimer;
+#endif
+		const swl::QLambda<state_action_pair_type, action_value_table_type, eligibility_trace_type> learner(gamma, &state_action_pair_type::epsilonFunction, &state_action_pair_type::stepSizeFunction, lambda, isReplacingTrace);
+		learner.train(maxEpisodeCount, policy, Q, eligibility);
+		std::cout << "elapsed time: " << aTimer.getElapsedTimeInMilliSecond() << " msec" << std::endl;
+
+		for (size_t row = 1; row <= state_action_pair_type::state_type::GRID_ROW_SIZE; ++row)
+		{
+			for (size_t col = 1; col <= state_action_pair_type::state_type::GRID_COL_SIZE; ++col)
+				std::cout << getActionSymbol(state_action_pair_type::getGreedyAction(state_action_pair_type::state_type(row, col), Q)) << "  ";
+			std::cout << std::endl;
+		}
+	}
+}
+
+// parallel multi-environment episode runner
+void parallel_td_learning(const size_t maxEpisodeCount, const double gamma, const size_t workerCount, const swl::ParallelTDEpisodeRunner<state_action_pair_type>::UPDATE_MODE updateMode)
+{
+	typedef swl::ParallelTDEpisodeRunner<state_action_pair_type> runner_type;
+
+	std::cout << "<<-- parallel Q-learning: " << workerCount << " workers, " << (runner_type::ASYNCHRONOUS_UPDATE == updateMode ? "asynchronous" : "synchronous batch") << " update -->>" << std::endl;
+
+	// initialize Q(state, action)
+	swl::DenseActionValueTable<state_action_pair_type> Q(0.0);
+
+	runner_type runner(gamma, &state_action_pair_type::epsilonFunction, &state_action_pair_type::stepSizeFunction, workerCount, runner_type::Q_LEARNING_UPDATE, updateMode);
+	runner.setEpisodesPerRound(10);
+	runner.setMaxStepCount(1000);
+	runner.setSeed((unsigned int)std::time(NULL));
+
+	const swl::TDEpisodeRunnerStatistics stats(runner.train(maxEpisodeCount, state_action_pair_type::state_type(), Q));
+	std::cout << "elapsed time: " << stats.elapsedTimeInSecond * 1000.0 << " msec, " << stats.episodeCount << " episodes (" << stats.getEpisodesPerSecond() << " episodes/sec), " << stats.stepCount << " steps (" << stats.getStepsPerSecond() << " steps/sec)" << std::endl;
+
+	for (size_t row = 1; row <= state_action_pair_type::state_type::GRID_ROW_SIZE; ++row)
+	{
+		for (size_t col = 1; col <= state_action_pair_type::state_type::GRID_COL_SIZE; ++col)
+			std::cout << getActionSymbol(state_action_pair_type::getGreedyAction(state_action_pair_type::state_type(row, col), Q)) << "  ";
+		std::cout << std::endl;
+	}
+}
+
 }  // namespace local
 }  // unnamed namespace
 
@@ -235,6 +336,9 @@ void td_learning()
 
 	local::sarsa(maxEpisodeCount, policy, gamma);
 	local::q_learning(maxEpisodeCount, policy, gamma);
+
+	local::parallel_td_learning(maxEpisodeCount, gamma, 4, swl::ParallelTDEpisodeRunner<local::state_action_pair_type>::SYNCHRONOUS_BATCH_UPDATE);
+	local::parallel_td_learning(maxEpisodeCount, gamma, 4, swl::ParallelTDEpisodeRunner<local::state_action_pair_type>::ASYNCHRONOUS_UPDATE);
 }
 
 void td_lambda()
@@ -254,4 +358,7 @@ void td_lambda()
 
 	local::sarsa_lambda(maxEpisodeCount, policy, gamma, lambda, isReplacingTrace);
 	local::q_lambda(maxEpisodeCount, policy, gamma, lambda, isReplacingTrace);
+
+	local::sarsa_lambda_with_dense_table(maxEpisodeCount, policy, gamma, lambda, isReplacingTrace);
+	local::q_lambda_with_dense_table(maxEpisodeCount, policy, gamma, lambda, isReplacingTrace);
 }
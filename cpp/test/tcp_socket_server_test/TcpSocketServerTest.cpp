@@ -3,6 +3,7 @@
 #include "EchoTcpSocketSession.h"
 #include "swl/util/TcpSocketConnectionUsingSession.h"
 #include "swl/util/TcpSocketServer.h"
+#include "swl/util/IoServicePool.h"
 #include <boost/thread.hpp>
 #include <boost/smart_ptr.hpp>
 #include <iostream>
@@ -39,6 +40,24 @@ struct echo_tcp_socket_server_worker_thread_functor
 	}
 };
 
+// the connections are served by a pool of I/O services, one thread per core.
+struct pooled_echo_tcp_socket_server_worker_thread_functor
+{
+	void operator()()
+	{
+		swl::IoServicePool ioServicePool(0, swl::IoServicePool::LEAST_LOADED, true);
+		const unsigned short portNum_withoutSession = 6001;
+		const unsigned short portNum_withSession = 7001;
+
+		swl::TcpSocketServer<swl::EchoTcpSocketConnection> server(ioServicePool, portNum_withoutSession);
+		swl::TcpSocketServer<swl::TcpSocketConnectionUsingSession<swl::EchoTcpSocketSession> > sessionServer(ioServicePool, portNum_withSession);
+
+		std::cout << "start pooled TCP socket servers on " << ioServicePool.getSize() << " I/O services: w/o & w/ session" << std::endl;
+		ioServicePool.run();
+		std::cout << "finish pooled TCP socket servers: w/o & w/ session" << std::endl;
+	}
+};
+
 }  // namespace local
 }  // unnamed namespace
 
@@ -49,9 +68,12 @@ int main(int argc, char *argv[])
 	{
 		std::cout << "start thread for TCP socket servers" << std::endl;
 		boost::scoped_ptr<boost::thread> thrd(new boost::thread(local::echo_tcp_socket_server_worker_thread_functor()));
+		boost::scoped_ptr<boost::thread> pooledThrd(new boost::thread(local::pooled_echo_tcp_socket_server_worker_thread_functor()));
 
 		if (thrd.get())
 			thrd->join();
+		if (pooledThrd.get())
+			pooledThrd->join();
 		std::cout << "finish thread for TCP socket servers" << std::endl;
 	}
     catch (const std::bad_alloc &e)
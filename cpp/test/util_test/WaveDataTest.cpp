@@ -1,5 +1,6 @@
 #include "swl/Config.h"
 #include "swl/util/WaveData.h"
+#include "swl/util/MappedWaveReader.h"
 #include <boost/timer/timer.hpp>
 #include <iostream>
 #include <vector>
@@ -166,4 +167,28 @@ void wave_data()
 	}
 	else
 		std::cerr << "Failed to open a wav file: " << wav_filename << std::endl;
+
+	// Read all the channel data through a memory map.
+	{
+		swl::MappedWaveReader reader;
+		if (reader.open(wav_filename))
+		{
+			std::cout << "Read all the channel data through a memory map: " << std::endl;
+
+			size_t numSamplesRead = 0;
+			{
+				boost::timer::auto_cpu_timer timer;
+				swl::WaveChunkStream stream(reader, 65536);
+				while (stream.next())
+				{
+					// Do something.
+					numSamplesRead += stream.getFrameCount();
+				}
+			}
+
+			std::cout << '\t' << numSamplesRead << " samples (" << numSamplesRead * reader.getBlockAlign() << " bytes) read." << std::endl;
+		}
+		else
+			std::cerr << "Failed to map a wav file: " << wav_filename << std::endl;
+	}
 }
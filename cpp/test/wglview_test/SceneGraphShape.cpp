@@ -88,6 +88,14 @@ void TrimmedSphereShape::draw() const
 	glPolygonMode(drawingFace, oldPolygonMode[1]);
 }
 
+bool TrimmedSphereShape::getBound(swl::BoundingBox<double> &bound) const
+{
+	// a sphere of radius 500 centered at (-250, 250, -250)
+	const double lower[3] = { -750.0, -250.0, -750.0 }, upper[3] = { 250.0, 750.0, 250.0 };
+	bound.set(lower, upper);
+	return true;
+}
+
 void TrimmedSphereShape::drawClippingRegion(const unsigned int clippingPlaneId, const double *clippingPlaneEqn) const
 {
 	glEnable(clippingPlaneId);
@@ -193,6 +201,14 @@ void SimpleCubeShape::draw() const
 	glPolygonMode(drawingFace, oldPolygonMode[1]);
 }
 
+bool SimpleCubeShape::getBound(swl::BoundingBox<double> &bound) const
+{
+	// a cube of size 500 centered at (250, -250, 250)
+	const double lower[3] = { 0.0, -500.0, 0.0 }, upper[3] = { 500.0, 0.0, 500.0 };
+	bound.set(lower, upper);
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 //
 
@@ -22,6 +22,7 @@ public:
 
 public:
 	/*virtual*/ void draw() const;
+	/*virtual*/ bool getBound(swl::BoundingBox<double> &bound) const;
 
 private:
 	void drawClippingRegion(const unsigned int clippingPlaneId, const double *clippingPlaneEqn) const;
@@ -42,6 +43,7 @@ public:
 
 public:
 	/*virtual*/ void draw() const;
+	/*virtual*/ bool getBound(swl::BoundingBox<double> &bound) const;
 };
 
 //-----------------------------------------------------------------------------
@@ -19,6 +19,7 @@
 #include "swl/winview/WglFont.h"
 #include "swl/glutil/GLCamera.h"
 #include "swl/glutil/GLRenderSceneVisitor.h"
+#include "swl/glutil/GLCullingRenderSceneVisitor.h"
 #include "swl/glutil/GLCreateDisplayListVisitor.h"
 #include "swl/glutil/GLPickObjectVisitor.h"
 #include "swl/glutil/GLPrintSceneVisitor.h"
@@ -47,6 +48,7 @@
 #endif
 
 #define __USE_OPENGL_DISPLAY_LIST 1
+#define __USE_CPU_RAY_CAST_PICKING 1
 
 
 // CWglSceneGraphView
@@ -364,6 +366,9 @@ void CWglSceneGraphView::OnInitialUpdate()
 
 		// Construct scene graph.
 		constructSceneGraph();
+#if defined(__USE_CPU_RAY_CAST_PICKING)
+		rayCastPicker_.build(rootSceneNode_);
+#endif
 
 		// Generate a new name base of OpenGL display list.
 #if defined(__USE_OPENGL_DISPLAY_LIST)
@@ -664,7 +669,7 @@ bool CWglSceneGraphView::doRenderStockScene(const context_type & /*context*/, co
 //-------------------------------------------------------------------------
 // This code is required for SWL.WglView: basic routine.
 
-bool CWglSceneGraphView::doRenderScene(const context_type & /*context*/, const camera_type & /*camera*/)
+bool CWglSceneGraphView::doRenderScene(const context_type & /*context*/, const camera_type &camera)
 {
 	// Traverse a scene graph.
 	if (rootSceneNode_)
@@ -677,8 +682,9 @@ bool CWglSceneGraphView::doRenderScene(const context_type & /*context*/, const c
 		}
 		else
 		{
-			rootSceneNode_->accept(swl::GLRenderSceneVisitor(swl::GLRenderSceneVisitor::RENDER_OPAQUE_OBJECTS, isPickingState));
-			rootSceneNode_->accept(swl::GLRenderSceneVisitor(swl::GLRenderSceneVisitor::RENDER_TRANSPARENT_OBJECTS, isPickingState));
+			// skip the shapes outside the view frustum.
+			rootSceneNode_->accept(swl::GLCullingRenderSceneVisitor(swl::GLRenderSceneVisitor::RENDER_OPAQUE_OBJECTS, camera, isPickingState));
+			rootSceneNode_->accept(swl::GLCullingRenderSceneVisitor(swl::GLRenderSceneVisitor::RENDER_TRANSPARENT_OBJECTS, camera, isPickingState));
 		}
 	}
 
@@ -902,6 +908,17 @@ void CWglSceneGraphView::processToPickObject(const int x, const int y, const int
 	const boost::shared_ptr<camera_type> &camera = topCamera();
 	if (!context || !camera) return;
 
+#if defined(__USE_CPU_RAY_CAST_PICKING)
+	// The shapes with known bounds are picked without rendering.
+	// Otherwise, fall back to the selection mode.
+	swl::GLRayCastPicker::Hit hit;
+	if (rayCastPicker_.pick(*camera, x, y, hit))
+	{
+		if (swl::GLRayCastPicker::updatePickedObjects(hit.objectId, isTemporary)) raiseDrawEvent(false);
+		return;
+	}
+#endif
+
 	context_type::guard_type guard(*context);
 
 	// Save states.
@@ -7,6 +7,7 @@
 #include "swl/winview/WglViewBase.h"
 #include "swl/view/ViewEventController.h"
 #include "swl/glutil/IGLSceneVisitor.h"
+#include "swl/glutil/GLRayCastPicker.h"
 #include "swl/graphics/SceneNode.h"
 #include <boost/smart_ptr.hpp>
 
@@ -167,6 +168,7 @@ private:
 	typedef swl::ISceneNode<visitor_type> scene_node_type;
 	scene_node_type::node_type stockSceneNode_;
 	scene_node_type::node_type rootSceneNode_;
+	swl::GLRayCastPicker rayCastPicker_;
 
 // Generated message map functions
 protected:
@@ -0,0 +1,386 @@
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/graphics/BoundingVolumeHierarchy.h"
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+typedef swl::BoundingBox<double> box_type;
+typedef swl::Frustum<double> frustum_type;
+typedef swl::Ray<double> ray_type;
+typedef swl::BoundingVolumeHierarchy<double> bvh_type;
+typedef bvh_type::index_type index_type;
+
+// small boxes scattered in [-12, 12]^3.
+std::vector<box_type> generateBoxes(const std::size_t count)
+{
+	std::vector<box_type> boxes;
+	boxes.reserve(count);
+	unsigned int seed = 2718u;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		double lower[3], upper[3];
+		for (int j = 0; j < 3; ++j)
+		{
+			seed = seed * 1103515245u + 12345u;
+			lower[j] = -12.0 + 24.0 * ((seed >> 8) & 0xFFFF) / 65536.0;
+			seed = seed * 1103515245u + 12345u;
+			upper[j] = lower[j] + ((seed >> 8) & 0xFF) / 256.0;
+		}
+		boxes.push_back(box_type(lower, upper));
+	}
+	return boxes;
+}
+
+// a camera at the origin looking down -z, with the near plane at 1 & the far plane at 10.
+frustum_type createFrustum()
+{
+	double vertices[8][3];
+	for (int i = 0; i < 8; ++i)
+	{
+		const double depth = i & 4 ? 10.0 : 1.0;
+		vertices[i][0] = (i & 1 ? 0.5 : -0.5) * depth;
+		vertices[i][1] = (i & 2 ? 0.4 : -0.4) * depth;
+		vertices[i][2] = -depth;
+	}
+	return frustum_type(vertices);
+}
+
+bool isSameItems(std::vector<index_type> lhs, std::vector<index_type> rhs)
+{
+	std::sort(lhs.begin(), lhs.end());
+	std::sort(rhs.begin(), rhs.end());
+	return lhs == rhs;
+}
+
+struct BoxIntersector
+{
+	BoxIntersector(const std::vector<box_type> &boxes)
+	: boxes_(boxes), testCount(0)
+	{}
+
+	bool operator()(const index_type item, const ray_type &ray, double &tHit)
+	{
+		++testCount;
+		double t;
+		if (!ray.intersect(boxes_[item], 0.0, tHit, t) || t >= tHit) return false;
+		tHit = t;
+		return true;
+	}
+
+private:
+	const std::vector<box_type> &boxes_;
+
+public:
+	std::size_t testCount;
+};
+
+bool checkBoundingBox()
+{
+	const double lower[3] = { 0.0, 0.0, 0.0 }, upper[3] = { 1.0, 2.0, 3.0 };
+	const box_type box(lower, upper);
+
+	// a rotation by 90 degrees about the z-axis followed by a translation by (1, 2, 3).
+	const swl::TMatrix3<double> mat(swl::Vector3<double>(0.0, 1.0, 0.0), swl::Vector3<double>(-1.0, 0.0, 0.0), swl::Vector3<double>(0.0, 0.0, 1.0), swl::Vector3<double>(1.0, 2.0, 3.0));
+	const box_type transformed(box.transform(mat));
+	const double expectedLower[3] = { -1.0, 2.0, 3.0 }, expectedUpper[3] = { 1.0, 3.0, 6.0 };
+	for (int i = 0; i < 3; ++i)
+		if (std::fabs(transformed.getLower(i) - expectedLower[i]) > 1.0e-12 || std::fabs(transformed.getUpper(i) - expectedUpper[i]) > 1.0e-12) return false;
+
+	const double lower2[3] = { 0.5, 1.5, 2.5 }, upper2[3] = { 2.0, 2.0, 4.0 }, lower3[3] = { 1.5, 0.0, 0.0 }, upper3[3] = { 2.0, 1.0, 1.0 };
+	const box_type box2(lower2, upper2), box3(lower3, upper3);
+	const double inside[3] = { 0.5, 1.0, 1.5 }, outside[3] = { 0.5, 2.5, 1.5 };
+	return box.isOverlapped(box2) && box2.isOverlapped(box) && !box.isOverlapped(box3) &&
+		box.isIncluded(inside) && !box.isIncluded(outside) &&
+		(box | box3).isIncluded(upper3) && !(box | box3).isIncluded(outside);
+}
+
+bool checkFrustum()
+{
+	const frustum_type frustum(createFrustum());
+
+	const double in[3] = { 0.0, 0.0, -5.0 }, behind[3] = { 0.0, 0.0, 1.0 }, beside[3] = { 3.0, 0.0, -5.0 };
+	if (!frustum.isIncluded(in) || frustum.isIncluded(behind) || frustum.isIncluded(beside)) return false;
+
+	const double insideLower[3] = { -0.5, -0.5, -6.0 }, insideUpper[3] = { 0.5, 0.5, -4.0 };
+	const double crossingLower[3] = { -0.5, -0.5, -12.0 }, crossingUpper[3] = { 0.5, 0.5, -8.0 };
+	const double outsideLower[3] = { 4.0, -0.5, -6.0 }, outsideUpper[3] = { 5.0, 0.5, -4.0 };
+	// a box across the near plane.
+	const double nearLower[3] = { -0.1, -0.1, -1.5 }, nearUpper[3] = { 0.1, 0.1, -0.5 };
+	return frustum_type::INSIDE == frustum.classify(box_type(insideLower, insideUpper)) &&
+		frustum_type::INTERSECTING == frustum.classify(box_type(crossingLower, crossingUpper)) &&
+		frustum_type::OUTSIDE == frustum.classify(box_type(outsideLower, outsideUpper)) &&
+		frustum_type::INTERSECTING == frustum.classify(box_type(nearLower, nearUpper));
+}
+
+bool checkFrustumQuery()
+{
+	const std::vector<box_type> boxes(generateBoxes(2000));
+	const frustum_type frustum(createFrustum());
+
+	std::vector<index_type> expected;
+	for (index_type i = 0; i < boxes.size(); ++i)
+		if (!frustum.isCulled(boxes[i])) expected.push_back(i);
+
+	const index_type maxLeafItemCounts[] = { 1, 4, 16 };
+	for (int k = 0; k < 3; ++k)
+	{
+		bvh_type bvh(maxLeafItemCounts[k]);
+		bvh.build(boxes);
+		if (boxes.size() != bvh.getItemCount()) return false;
+
+		std::vector<index_type> items;
+		bvh.query(frustum, items);
+		if (!isSameItems(items, expected)) return false;
+	}
+	return !expected.empty() && expected.size() < boxes.size();
+}
+
+bool checkBoxQuery()
+{
+	const std::vector<box_type> boxes(generateBoxes(2000));
+	bvh_type bvh;
+	bvh.build(boxes);
+
+	box_type bound;
+	if (!bvh.getBound(bound)) return false;
+	// the bound of all the items encloses every item.
+	for (index_type i = 0; i < boxes.size(); ++i)
+	{
+		double lower[3], upper[3];
+		boxes[i].get(lower, upper);
+		if (!bound.isIncluded(lower) || !bound.isIncluded(upper)) return false;
+	}
+
+	const double lowers[][3] = { { -3.0, -3.0, -3.0 }, { 5.0, -12.0, 0.0 }, { 20.0, 20.0, 20.0 } };
+	const double uppers[][3] = { { 3.0, 3.0, 3.0 }, { 6.0, 12.0, 0.5 }, { 21.0, 21.0, 21.0 } };
+	for (int k = 0; k < 3; ++k)
+	{
+		const box_type query(lowers[k], uppers[k]);
+		std::vector<index_type> expected;
+		for (index_type i = 0; i < boxes.size(); ++i)
+			if (boxes[i].isOverlapped(query)) expected.push_back(i);
+
+		std::vector<index_type> items;
+		bvh.query(query, items);
+		if (!isSameItems(items, expected)) return false;
+		if (2 == k && !items.empty()) return false;
+	}
+
+	// an empty hierarchy.
+	bvh.build(std::vector<box_type>());
+	std::vector<index_type> items;
+	bvh.query(box_type(lowers[0], uppers[0]), items);
+	return bvh.isEmpty() && items.empty() && !bvh.getBound(bound);
+}
+
+bool checkRayIntersection()
+{
+	const std::vector<box_type> boxes(generateBoxes(2000));
+	bvh_type bvh;
+	bvh.build(boxes);
+
+	unsigned int seed = 31415u;
+	for (int k = 0; k < 100; ++k)
+	{
+		double origin[3], direction[3];
+		for (int j = 0; j < 3; ++j)
+		{
+			seed = seed * 1103515245u + 12345u;
+			origin[j] = -15.0 + 30.0 * ((seed >> 8) & 0xFFFF) / 65536.0;
+			seed = seed * 1103515245u + 12345u;
+			direction[j] = -1.0 + 2.0 * ((seed >> 8) & 0xFFFF) / 65536.0;
+		}
+		const ray_type ray(origin, direction);
+
+		// the nearest hit by brute force.
+		double tExpected = std::numeric_limits<double>::max(), t;
+		for (index_type i = 0; i < boxes.size(); ++i)
+			if (ray.intersect(boxes[i], 0.0, tExpected, t) && t < tExpected) tExpected = t;
+
+		BoxIntersector intersector(boxes);
+		double tHit = std::numeric_limits<double>::max();
+		const bool isHit = bvh.intersect(ray, intersector, tHit);
+		if (isHit != (tExpected < std::numeric_limits<double>::max())) return false;
+		if (isHit && tHit != tExpected) return false;
+		// the hierarchy has to skip most of the items.
+		if (intersector.testCount > boxes.size() / 2) return false;
+	}
+	return true;
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct BoundingVolumeHierarchyTest
+{
+public:
+	void testBoundingBox()
+	{
+		BOOST_CHECK(local::checkBoundingBox());
+	}
+
+	void testFrustum()
+	{
+		BOOST_CHECK(local::checkFrustum());
+	}
+
+	void testFrustumQuery()
+	{
+		BOOST_CHECK(local::checkFrustumQuery());
+	}
+
+	void testBoxQuery()
+	{
+		BOOST_CHECK(local::checkBoxQuery());
+	}
+
+	void testRayIntersection()
+	{
+		BOOST_CHECK(local::checkRayIntersection());
+	}
+};
+
+struct BoundingVolumeHierarchyTestSuite: public boost::unit_test_framework::test_suite
+{
+	BoundingVolumeHierarchyTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.Graphics.BoundingVolumeHierarchy")
+	{
+		boost::shared_ptr<BoundingVolumeHierarchyTest> test(new BoundingVolumeHierarchyTest());
+
+		add(BOOST_CLASS_TEST_CASE(&BoundingVolumeHierarchyTest::testBoundingBox, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&BoundingVolumeHierarchyTest::testFrustum, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&BoundingVolumeHierarchyTest::testFrustumQuery, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&BoundingVolumeHierarchyTest::testBoxQuery, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&BoundingVolumeHierarchyTest::testRayIntersection, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class BoundingVolumeHierarchyTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(BoundingVolumeHierarchyTest, testBoundingBox)
+{
+	EXPECT_TRUE(local::checkBoundingBox());
+}
+
+TEST_F(BoundingVolumeHierarchyTest, testFrustum)
+{
+	EXPECT_TRUE(local::checkFrustum());
+}
+
+TEST_F(BoundingVolumeHierarchyTest, testFrustumQuery)
+{
+	EXPECT_TRUE(local::checkFrustumQuery());
+}
+
+TEST_F(BoundingVolumeHierarchyTest, testBoxQuery)
+{
+	EXPECT_TRUE(local::checkBoxQuery());
+}
+
+TEST_F(BoundingVolumeHierarchyTest, testRayIntersection)
+{
+	EXPECT_TRUE(local::checkRayIntersection());
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct BoundingVolumeHierarchyTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(BoundingVolumeHierarchyTest);
+	CPPUNIT_TEST(testBoundingBox);
+	CPPUNIT_TEST(testFrustum);
+	CPPUNIT_TEST(testFrustumQuery);
+	CPPUNIT_TEST(testBoxQuery);
+	CPPUNIT_TEST(testRayIntersection);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testBoundingBox()
+	{
+		CPPUNIT_ASSERT(local::checkBoundingBox());
+	}
+
+	void testFrustum()
+	{
+		CPPUNIT_ASSERT(local::checkFrustum());
+	}
+
+	void testFrustumQuery()
+	{
+		CPPUNIT_ASSERT(local::checkFrustumQuery());
+	}
+
+	void testBoxQuery()
+	{
+		CPPUNIT_ASSERT(local::checkBoxQuery());
+	}
+
+	void testRayIntersection()
+	{
+		CPPUNIT_ASSERT(local::checkRayIntersection());
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::BoundingVolumeHierarchyTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.Graphics");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::BoundingVolumeHierarchyTest, "SWL.Graphics");
+#endif
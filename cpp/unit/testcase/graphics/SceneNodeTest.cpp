@@ -0,0 +1,221 @@
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/graphics/SceneNode.h"
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+struct SceneVisitor
+{
+};
+
+typedef swl::ISceneNode<SceneVisitor> scene_node_type;
+typedef scene_node_type::node_type node_type;
+typedef scene_node_type::bound_type bound_type;
+typedef swl::GroupSceneNode<SceneVisitor> group_node_type;
+
+// a leaf with a fixed bound, or without a bound.
+class BoxSceneNode: public swl::LeafSceneNode<SceneVisitor>
+{
+public:
+	typedef swl::LeafSceneNode<SceneVisitor> base_type;
+
+public:
+	BoxSceneNode()
+	: base_type(), bound_(), isBoundKnown_(false)
+	{}
+	explicit BoxSceneNode(const bound_type &bound)
+	: base_type(), bound_(bound), isBoundKnown_(true)
+	{}
+
+public:
+	/*virtual*/ void accept(const visitor_type & /*visitor*/) const  {}
+
+protected:
+	/*virtual*/ bool doCalculateBound(bound_type &bound) const
+	{
+		if (isBoundKnown_) bound = bound_;
+		return isBoundKnown_;
+	}
+
+private:
+	const bound_type bound_;
+	const bool isBoundKnown_;
+};
+
+bound_type makeBox(const double x0, const double y0, const double z0, const double x1, const double y1, const double z1)
+{
+	const double lower[3] = { x0, y0, z0 }, upper[3] = { x1, y1, z1 };
+	return bound_type(lower, upper);
+}
+
+bool isSameBox(const bound_type &lhs, const bound_type &rhs)
+{
+	for (int i = 0; i < 3; ++i)
+		if (lhs.getLower(i) != rhs.getLower(i) || lhs.getUpper(i) != rhs.getUpper(i)) return false;
+	return true;
+}
+
+// a group bounds its bounded children & reports the unbounded ones separately.
+bool checkGroupBound()
+{
+	const node_type unbounded(new BoxSceneNode());
+	bound_type bound;
+	if (unbounded->getBound(bound) || unbounded->hasUnboundedDescendants()) return false;
+
+	group_node_type group;
+	if (group.getBound(bound) || group.hasUnboundedDescendants()) return false;
+
+	group.addChild(unbounded);
+	if (group.getBound(bound) || !group.hasUnboundedDescendants()) return false;
+
+	group.addChild(node_type(new BoxSceneNode(makeBox(0.0, 0.0, 0.0, 1.0, 1.0, 1.0))));
+	group.addChild(node_type(new BoxSceneNode(makeBox(-2.0, 0.5, 0.5, -1.0, 3.0, 0.5))));
+	if (!group.getBound(bound) || !isSameBox(bound, makeBox(-2.0, 0.0, 0.0, 1.0, 3.0, 1.0)) || !group.hasUnboundedDescendants()) return false;
+
+	group.removeChild(unbounded);
+	return group.getBound(bound) && isSameBox(bound, makeBox(-2.0, 0.0, 0.0, 1.0, 3.0, 1.0)) && !group.hasUnboundedDescendants();
+}
+
+// an unbounded node deep in a subtree marks all its ancestors, & removing it clears them.
+bool checkNestedGroupBound()
+{
+	const boost::shared_ptr<group_node_type> inner(new group_node_type());
+	const node_type unbounded(new BoxSceneNode());
+	inner->addChild(unbounded);
+	inner->addChild(node_type(new BoxSceneNode(makeBox(4.0, 4.0, 4.0, 5.0, 5.0, 5.0))));
+
+	group_node_type outer;
+	outer.addChild(inner);
+	outer.addChild(node_type(new BoxSceneNode(makeBox(0.0, 0.0, 0.0, 1.0, 1.0, 1.0))));
+
+	bound_type bound;
+	if (!outer.getBound(bound) || !isSameBox(bound, makeBox(0.0, 0.0, 0.0, 5.0, 5.0, 5.0)) || !outer.hasUnboundedDescendants()) return false;
+
+	inner->removeChild(unbounded);
+	if (!outer.getBound(bound) || !isSameBox(bound, makeBox(0.0, 0.0, 0.0, 5.0, 5.0, 5.0)) || outer.hasUnboundedDescendants()) return false;
+
+	inner->addChild(unbounded);
+	return outer.hasUnboundedDescendants();
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct SceneNodeTest
+{
+public:
+	void testGroupBound()
+	{
+		BOOST_CHECK(local::checkGroupBound());
+	}
+
+	void testNestedGroupBound()
+	{
+		BOOST_CHECK(local::checkNestedGroupBound());
+	}
+};
+
+struct SceneNodeTestSuite: public boost::unit_test_framework::test_suite
+{
+	SceneNodeTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.Graphics.SceneNode")
+	{
+		boost::shared_ptr<SceneNodeTest> test(new SceneNodeTest());
+
+		add(BOOST_CLASS_TEST_CASE(&SceneNodeTest::testGroupBound, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&SceneNodeTest::testNestedGroupBound, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class SceneNodeTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(SceneNodeTest, testGroupBound)
+{
+	EXPECT_TRUE(local::checkGroupBound());
+}
+
+TEST_F(SceneNodeTest, testNestedGroupBound)
+{
+	EXPECT_TRUE(local::checkNestedGroupBound());
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct SceneNodeTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(SceneNodeTest);
+	CPPUNIT_TEST(testGroupBound);
+	CPPUNIT_TEST(testNestedGroupBound);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testGroupBound()
+	{
+		CPPUNIT_ASSERT(local::checkGroupBound());
+	}
+
+	void testNestedGroupBound()
+	{
+		CPPUNIT_ASSERT(local::checkNestedGroupBound());
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::SceneNodeTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.Graphics");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::SceneNodeTest, "SWL.Graphics");
+#endif
@@ -0,0 +1,307 @@
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/machine_learning/ParallelTDEpisodeRunner.h"
+#include <stdexcept>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+// a corridor of 8 states with the goal at the right end & a reward of -1 per step.
+struct CorridorStateActionPair
+{
+public:
+	struct Action
+	{
+	public:
+		enum ACTION { LEFT = 0, RIGHT };
+		static const std::size_t ACTION_SIZE = 2;
+
+		typedef ACTION value_type;
+
+	public:
+		explicit Action(const value_type action = LEFT)
+		: action_(action)
+		{}
+
+	public:
+		value_type getValue() const  {  return action_;  }
+
+		bool operator==(const Action &rhs) const  {  return action_ == rhs.action_;  }
+
+	private:
+		value_type action_;
+	};
+
+	struct State
+	{
+	public:
+		static const std::size_t STATE_SIZE = 8;
+
+		typedef std::size_t value_type;
+		typedef int reward_type;
+
+	public:
+		// entering the state invalidState makes the next state invalid, to emulate a broken environment.
+		explicit State(const value_type state = 0, const value_type invalidState = STATE_SIZE)
+		: state_(state), invalidState_(invalidState)
+		{}
+
+	public:
+		bool isTerminalState() const  {  return STATE_SIZE - 1 == state_;  }
+		bool isValidState() const  {  return state_ < STATE_SIZE;  }
+
+		reward_type getReward() const  {  return -1;  }
+
+		State takeAction(const Action &action) const
+		{
+			if (state_ == invalidState_) return State(STATE_SIZE, invalidState_);
+			if (Action::LEFT == action.getValue()) return State(0 == state_ ? 0 : state_ - 1, invalidState_);
+			return State(state_ + 1, invalidState_);
+		}
+
+		value_type getValue() const  {  return state_;  }
+
+	private:
+		value_type state_;
+		value_type invalidState_;
+	};
+
+public:
+	typedef State state_type;
+	typedef Action action_type;
+	typedef State::reward_type reward_type;
+
+public:
+	CorridorStateActionPair(const state_type &state, const action_type &action)
+	: state_(state), action_(action)
+	{}
+
+public:
+	const state_type & getState() const  {  return state_;  }
+	const action_type & getAction() const  {  return action_;  }
+
+private:
+	state_type state_;
+	action_type action_;
+};
+
+typedef CorridorStateActionPair state_action_pair_type;
+typedef CorridorStateActionPair::state_type state_type;
+typedef CorridorStateActionPair::action_type action_type;
+typedef swl::ParallelTDEpisodeRunner<state_action_pair_type> runner_type;
+typedef runner_type::action_value_table_type action_value_table_type;
+
+double epsilonFunction(const std::size_t episodeTrial)
+{
+	return 0.5 / (1.0 + 0.01 * episodeTrial);
+}
+
+double stepSizeFunction(const std::size_t /*iterationStep*/)
+{
+	return 0.1;
+}
+
+void train(const runner_type::UPDATE_RULE updateRule, const runner_type::UPDATE_MODE updateMode, const std::size_t episodesPerRound, const state_type &startState, action_value_table_type &Q, swl::TDEpisodeRunnerStatistics &stats)
+{
+	runner_type runner(1.0, &epsilonFunction, &stepSizeFunction, 4, updateRule, updateMode);
+	runner.setEpisodesPerRound(episodesPerRound);
+	runner.setMaxStepCount(200);
+	runner.setSeed(37u);
+	Q.fill(0.0);
+	stats = runner.train(300, startState, Q);
+}
+
+// the greedy policy has to go right everywhere.
+bool isOptimal(const action_value_table_type &Q)
+{
+	for (std::size_t s = 0; s < state_type::STATE_SIZE - 1; ++s)
+		if (!(action_type(action_type::RIGHT) == Q.getGreedyAction(state_type(s)))) return false;
+	return true;
+}
+
+bool checkSynchronousUpdate()
+{
+	const runner_type::UPDATE_RULE rules[] = { runner_type::SARSA_UPDATE, runner_type::Q_LEARNING_UPDATE };
+	const std::size_t episodesPerRounds[] = { 1, 3 };
+	for (std::size_t i = 0; i < 2; ++i)
+		for (std::size_t j = 0; j < 2; ++j)
+		{
+			action_value_table_type Q1, Q2;
+			swl::TDEpisodeRunnerStatistics stats1, stats2;
+			train(rules[i], runner_type::SYNCHRONOUS_BATCH_UPDATE, episodesPerRounds[j], state_type(0), Q1, stats1);
+			train(rules[i], runner_type::SYNCHRONOUS_BATCH_UPDATE, episodesPerRounds[j], state_type(0), Q2, stats2);
+
+			// the same seed gives bitwise the same result, whatever the thread scheduling is.
+			for (std::size_t k = 0; k < action_value_table_type::TABLE_SIZE; ++k)
+				if (Q1[k] != Q2[k]) return false;
+			if (300 != stats1.episodeCount || stats1.stepCount != stats2.stepCount || stats1.updateCount != stats1.stepCount) return false;
+			if (runner_type::Q_LEARNING_UPDATE == rules[i] && !isOptimal(Q1)) return false;
+		}
+	return true;
+}
+
+bool checkAsynchronousUpdate()
+{
+	action_value_table_type Q;
+	swl::TDEpisodeRunnerStatistics stats;
+	train(runner_type::Q_LEARNING_UPDATE, runner_type::ASYNCHRONOUS_UPDATE, 1, state_type(0), Q, stats);
+	return 300 == stats.episodeCount && stats.updateCount == stats.stepCount && isOptimal(Q);
+}
+
+bool checkWorkerError()
+{
+	const runner_type::UPDATE_MODE modes[] = { runner_type::SYNCHRONOUS_BATCH_UPDATE, runner_type::ASYNCHRONOUS_UPDATE };
+	for (std::size_t i = 0; i < 2; ++i)
+	{
+		action_value_table_type Q;
+		swl::TDEpisodeRunnerStatistics stats;
+		try
+		{
+			// every episode which reaches state 3 fails on a worker thread.
+			train(runner_type::SARSA_UPDATE, modes[i], 2, state_type(0, 3), Q, stats);
+			return false;
+		}
+		catch (const std::runtime_error &)
+		{
+		}
+	}
+	return true;
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct ParallelTDEpisodeRunnerTest
+{
+public:
+	void testSynchronousUpdate()
+	{
+		BOOST_CHECK(local::checkSynchronousUpdate());
+	}
+
+	void testAsynchronousUpdate()
+	{
+		BOOST_CHECK(local::checkAsynchronousUpdate());
+	}
+
+	void testWorkerError()
+	{
+		BOOST_CHECK(local::checkWorkerError());
+	}
+};
+
+struct ParallelTDEpisodeRunnerTestSuite: public boost::unit_test_framework::test_suite
+{
+	ParallelTDEpisodeRunnerTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.MachineLearning.ParallelTDEpisodeRunner")
+	{
+		boost::shared_ptr<ParallelTDEpisodeRunnerTest> test(new ParallelTDEpisodeRunnerTest());
+
+		add(BOOST_CLASS_TEST_CASE(&ParallelTDEpisodeRunnerTest::testSynchronousUpdate, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&ParallelTDEpisodeRunnerTest::testAsynchronousUpdate, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&ParallelTDEpisodeRunnerTest::testWorkerError, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class ParallelTDEpisodeRunnerTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(ParallelTDEpisodeRunnerTest, testSynchronousUpdate)
+{
+	EXPECT_TRUE(local::checkSynchronousUpdate());
+}
+
+TEST_F(ParallelTDEpisodeRunnerTest, testAsynchronousUpdate)
+{
+	EXPECT_TRUE(local::checkAsynchronousUpdate());
+}
+
+TEST_F(ParallelTDEpisodeRunnerTest, testWorkerError)
+{
+	EXPECT_TRUE(local::checkWorkerError());
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct ParallelTDEpisodeRunnerTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(ParallelTDEpisodeRunnerTest);
+	CPPUNIT_TEST(testSynchronousUpdate);
+	CPPUNIT_TEST(testAsynchronousUpdate);
+	CPPUNIT_TEST(testWorkerError);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testSynchronousUpdate()
+	{
+		CPPUNIT_ASSERT(local::checkSynchronousUpdate());
+	}
+
+	void testAsynchronousUpdate()
+	{
+		CPPUNIT_ASSERT(local::checkAsynchronousUpdate());
+	}
+
+	void testWorkerError()
+	{
+		CPPUNIT_ASSERT(local::checkWorkerError());
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::ParallelTDEpisodeRunnerTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.MachineLearning");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::ParallelTDEpisodeRunnerTest, "SWL.MachineLearning");
+#endif
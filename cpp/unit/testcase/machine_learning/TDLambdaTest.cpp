@@ -0,0 +1,360 @@
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/machine_learning/TDLambda.h"
+#include <vector>
+#include <map>
+#include <cmath>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+// a chain of 5 states with two actions, left & right.
+struct ChainStateActionPair
+{
+public:
+	struct State
+	{
+	public:
+		static const std::size_t STATE_SIZE = 5;
+		typedef std::size_t value_type;
+
+	public:
+		explicit State(const value_type state = 0)
+		: state_(state)
+		{}
+
+	public:
+		value_type getValue() const  {  return state_;  }
+
+	private:
+		value_type state_;
+	};
+
+	struct Action
+	{
+	public:
+		static const std::size_t ACTION_SIZE = 2;
+		typedef std::size_t value_type;
+
+	public:
+		explicit Action(const value_type action = 0)
+		: action_(action)
+		{}
+
+	public:
+		value_type getValue() const  {  return action_;  }
+
+	private:
+		value_type action_;
+	};
+
+public:
+	typedef State state_type;
+	typedef Action action_type;
+	typedef double reward_type;
+	typedef int policy_type;
+
+public:
+	ChainStateActionPair(const state_type &state, const action_type &action)
+	: state_(state), action_(action)
+	{}
+
+public:
+	const state_type & getState() const  {  return state_;  }
+	const action_type & getAction() const  {  return action_;  }
+
+	bool operator<(const ChainStateActionPair &rhs) const
+	{
+		return state_.getValue() * action_type::ACTION_SIZE + action_.getValue() < rhs.state_.getValue() * action_type::ACTION_SIZE + rhs.action_.getValue();
+	}
+
+private:
+	state_type state_;
+	action_type action_;
+};
+
+typedef ChainStateActionPair state_action_pair_type;
+typedef ChainStateActionPair::state_type state_type;
+typedef ChainStateActionPair::action_type action_type;
+typedef std::map<const state_action_pair_type, double> map_type;
+typedef swl::DenseActionValueTable<state_action_pair_type> dense_table_type;
+typedef swl::SparseEligibilityTrace<state_action_pair_type> sparse_trace_type;
+
+double epsilonFunction(const std::size_t /*episodeTrial*/)
+{
+	return 0.1;
+}
+
+double stepSizeFunction(const std::size_t iterationStep)
+{
+	return 1.0 / (1.0 + 0.01 * iterationStep);
+}
+
+// exposes the protected update steps of TDLambda.
+template<typename ActionValueTable, typename EligibilityTrace>
+class TDLambdaStepper: public swl::TDLambda<state_action_pair_type, ActionValueTable, EligibilityTrace>
+{
+public:
+	typedef swl::TDLambda<state_action_pair_type, ActionValueTable, EligibilityTrace> base_type;
+
+public:
+	TDLambdaStepper(const double gamma, const double lambda, const bool isReplacingTrace)
+	: base_type(gamma, &epsilonFunction, &stepSizeFunction, lambda, isReplacingTrace)
+	{}
+
+public:
+	/*virtual*/ void train(const size_t /*maxEpisodeCount*/, const typename base_type::policy_type & /*policy*/, ActionValueTable & /*Q*/, EligibilityTrace & /*eligibility*/) const
+	{
+	}
+
+	// a step of Sarsa(lambda) if isGreedyAction is NULL, or of Watkins's Q(lambda).
+	void step(const std::size_t iterationStep, const state_action_pair_type &currSA, const state_action_pair_type &nextSA, const double reward, ActionValueTable &Q, EligibilityTrace &eligibility, const bool *isGreedyAction) const
+	{
+		const double delta = reward + base_type::gamma_ * Q[nextSA] - Q[currSA];
+		base_type::visit(currSA, eligibility);
+		base_type::updateQAndEligibility(iterationStep, delta, Q, eligibility, isGreedyAction);
+	}
+};
+
+struct Transition
+{
+	state_action_pair_type curr, next;
+	double reward;
+	bool isGreedyAction;
+};
+
+// a pseudo-random walk on the chain which revisits states with different actions.
+std::vector<Transition> generateTransitions(const std::size_t count)
+{
+	std::vector<Transition> transitions;
+	unsigned int seed = 12345u;
+	std::size_t state = 2;
+	std::size_t action = 0;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		seed = seed * 1103515245u + 12345u;
+		const std::size_t nextState = 0 == action ? (0 == state ? 0 : state - 1) : (state_type::STATE_SIZE - 1 == state ? state : state + 1);
+		const std::size_t nextAction = (seed >> 16) & 1u;
+
+		Transition transition = {
+			state_action_pair_type(state_type(state), action_type(action)),
+			state_action_pair_type(state_type(nextState), action_type(nextAction)),
+			state_type::STATE_SIZE - 1 == nextState ? 1.0 : -0.1,
+			0 != ((seed >> 20) % 5u)
+		};
+		transitions.push_back(transition);
+
+		state = nextState;
+		action = nextAction;
+	}
+	return transitions;
+}
+
+bool runAndCompare(const bool isReplacingTrace, const bool isQLambda, const double threshold, const double tolerance)
+{
+	const double gamma = 0.9, lambda = 0.8;
+	const std::vector<Transition> transitions(generateTransitions(200));
+
+	// std::map has to hold all the state-action pairs, since its update visits only the entries of Q.
+	map_type mapQ, mapEligibility;
+	for (std::size_t s = 0; s < state_type::STATE_SIZE; ++s)
+		for (std::size_t a = 0; a < action_type::ACTION_SIZE; ++a)
+			mapQ[state_action_pair_type(state_type(s), action_type(a))] = 0.0;
+	dense_table_type denseQ(0.0);
+	sparse_trace_type sparseEligibility(threshold);
+
+	const TDLambdaStepper<map_type, map_type> mapStepper(gamma, lambda, isReplacingTrace);
+	const TDLambdaStepper<dense_table_type, sparse_trace_type> denseStepper(gamma, lambda, isReplacingTrace);
+	for (std::size_t i = 0; i < transitions.size(); ++i)
+	{
+		const Transition &t = transitions[i];
+		mapStepper.step(i + 1, t.curr, t.next, t.reward, mapQ, mapEligibility, isQLambda ? &t.isGreedyAction : NULL);
+		denseStepper.step(i + 1, t.curr, t.next, t.reward, denseQ, sparseEligibility, isQLambda ? &t.isGreedyAction : NULL);
+	}
+
+	double maxAbsQ = 0.0;
+	for (map_type::const_iterator cit = mapQ.begin(); cit != mapQ.end(); ++cit)
+	{
+		if (std::fabs(cit->second - denseQ[cit->first]) > tolerance) return false;
+		maxAbsQ = std::max(maxAbsQ, std::fabs(cit->second));
+	}
+	// Q has to be updated at all.
+	return maxAbsQ > 0.1;
+}
+
+bool checkAccumulatingTrace()
+{
+	// without a cutoff, the sparse trace visits the same non-zero entries in the same way.
+	return runAndCompare(false, false, 0.0, 1.0e-12) && runAndCompare(false, true, 0.0, 1.0e-12) &&
+		runAndCompare(false, false, 1.0e-5, 1.0e-3) && runAndCompare(false, true, 1.0e-5, 1.0e-3);
+}
+
+bool checkReplacingTrace()
+{
+	return runAndCompare(true, false, 0.0, 1.0e-12) && runAndCompare(true, true, 0.0, 1.0e-12) &&
+		runAndCompare(true, false, 1.0e-5, 1.0e-3) && runAndCompare(true, true, 1.0e-5, 1.0e-3);
+}
+
+bool checkReplacingTraceValues()
+{
+	const state_action_pair_type left(state_type(1), action_type(0)), right(state_type(1), action_type(1)), other(state_type(2), action_type(0));
+
+	map_type mapQ, mapEligibility;
+	mapQ[left] = mapQ[right] = mapQ[other] = 0.0;
+	dense_table_type denseQ(0.0);
+	sparse_trace_type sparseEligibility(0.0);
+
+	const TDLambdaStepper<map_type, map_type> mapStepper(1.0, 0.5, true);
+	const TDLambdaStepper<dense_table_type, sparse_trace_type> denseStepper(1.0, 0.5, true);
+	// (1, left) -> (2, left) -> (1, right) -> (1, right).
+	mapStepper.step(1, left, other, 0.0, mapQ, mapEligibility, NULL);
+	mapStepper.step(2, other, right, 0.0, mapQ, mapEligibility, NULL);
+	mapStepper.step(3, right, right, 0.0, mapQ, mapEligibility, NULL);
+	mapStepper.step(4, right, right, 0.0, mapQ, mapEligibility, NULL);
+	denseStepper.step(1, left, other, 0.0, denseQ, sparseEligibility, NULL);
+	denseStepper.step(2, other, right, 0.0, denseQ, sparseEligibility, NULL);
+	denseStepper.step(3, right, right, 0.0, denseQ, sparseEligibility, NULL);
+	denseStepper.step(4, right, right, 0.0, denseQ, sparseEligibility, NULL);
+
+	// the revisit of state 1 cuts the trace of (1, left) & the trace of (1, right) is reset to 1, not accumulated.
+	return 0.0 == mapEligibility[left] && 0.5 == mapEligibility[right] && 0.125 == mapEligibility[other] &&
+		0.0 == sparseEligibility.getTrace(left) && 0.5 == sparseEligibility.getTrace(right) && 0.125 == sparseEligibility.getTrace(other);
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct TDLambdaTest
+{
+public:
+	void testAccumulatingTrace()
+	{
+		BOOST_CHECK(local::checkAccumulatingTrace());
+	}
+
+	void testReplacingTrace()
+	{
+		BOOST_CHECK(local::checkReplacingTrace());
+	}
+
+	void testReplacingTraceValues()
+	{
+		BOOST_CHECK(local::checkReplacingTraceValues());
+	}
+};
+
+struct TDLambdaTestSuite: public boost::unit_test_framework::test_suite
+{
+	TDLambdaTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.MachineLearning.TDLambda")
+	{
+		boost::shared_ptr<TDLambdaTest> test(new TDLambdaTest());
+
+		add(BOOST_CLASS_TEST_CASE(&TDLambdaTest::testAccumulatingTrace, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&TDLambdaTest::testReplacingTrace, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&TDLambdaTest::testReplacingTraceValues, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class TDLambdaTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(TDLambdaTest, testAccumulatingTrace)
+{
+	EXPECT_TRUE(local::checkAccumulatingTrace());
+}
+
+TEST_F(TDLambdaTest, testReplacingTrace)
+{
+	EXPECT_TRUE(local::checkReplacingTrace());
+}
+
+TEST_F(TDLambdaTest, testReplacingTraceValues)
+{
+	EXPECT_TRUE(local::checkReplacingTraceValues());
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct TDLambdaTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(TDLambdaTest);
+	CPPUNIT_TEST(testAccumulatingTrace);
+	CPPUNIT_TEST(testReplacingTrace);
+	CPPUNIT_TEST(testReplacingTraceValues);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testAccumulatingTrace()
+	{
+		CPPUNIT_ASSERT(local::checkAccumulatingTrace());
+	}
+
+	void testReplacingTrace()
+	{
+		CPPUNIT_ASSERT(local::checkReplacingTrace());
+	}
+
+	void testReplacingTraceValues()
+	{
+		CPPUNIT_ASSERT(local::checkReplacingTraceValues());
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::TDLambdaTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.MachineLearning");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::TDLambdaTest, "SWL.MachineLearning");
+#endif
@@ -0,0 +1,301 @@
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/math/ConvexPolygon.h"
+#include "swl/math/GeometryUtil.h"
+#include <vector>
+#include <list>
+#include <cmath>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+typedef swl::ConvexPolygon::point_type point_type;
+
+// points on a circle & inside it, with duplicates.
+std::vector<point_type> generatePoints()
+{
+	std::vector<point_type> points;
+	for (int i = 0; i < 40; ++i)
+	{
+		const double angle = 0.157 * i * i;
+		points.push_back(point_type(float(10.0 * std::cos(angle)), float(5.0 * std::sin(angle))));
+		points.push_back(point_type(float(3.0 * std::cos(angle * 3.0)), float(2.0 * std::sin(angle))));
+	}
+	points.push_back(points.front());
+	return points;
+}
+
+// the point is on the left of (or on) all the edges.
+bool includeByEdges(const std::vector<point_type> &hull, const point_type &pt)
+{
+	for (std::size_t i = 0; i < hull.size(); ++i)
+	{
+		const point_type &p = hull[i], &q = hull[(i + 1) % hull.size()];
+		if (((double)q.x - p.x) * ((double)pt.y - p.y) - ((double)q.y - p.y) * ((double)pt.x - p.x) < 0.0) return false;
+	}
+	return true;
+}
+
+bool checkConvexHull()
+{
+	// a square with points inside & on the edges.
+	const point_type points[] = {
+		point_type(0, 0), point_type(1, 0), point_type(2, 0), point_type(2, 1), point_type(2, 2), point_type(1, 1),
+		point_type(0, 2), point_type(1, 2), point_type(0, 1), point_type(0.5f, 1.5f), point_type(2, 2)
+	};
+	std::vector<point_type> hull;
+	swl::ConvexPolygon::computeConvexHull(points, sizeof(points) / sizeof(points[0]), hull);
+	const float expected[4][2] = { { 0, 0 }, { 2, 0 }, { 2, 2 }, { 0, 2 } };
+	if (4 != hull.size()) return false;
+	for (std::size_t i = 0; i < 4; ++i)
+		if (hull[i].x != expected[i][0] || hull[i].y != expected[i][1]) return false;
+
+	// degenerate cases.
+	swl::ConvexPolygon::computeConvexHull(points, 3, hull);
+	if (2 != hull.size()) return false;
+	swl::ConvexPolygon::computeConvexHull(points + 4, 1, hull);
+	if (1 != hull.size()) return false;
+	swl::ConvexPolygon::computeConvexHull(points, 0, hull);
+	return hull.empty();
+}
+
+bool checkInclude()
+{
+	const swl::ConvexPolygon polygon(generatePoints());
+	const std::vector<point_type> &hull = polygon.getVertices();
+	if (hull.size() < 3) return false;
+
+	std::vector<point_type> queries;
+	for (int i = -60; i <= 60; ++i)
+		for (int j = -30; j <= 30; ++j)
+			queries.push_back(point_type(i * 0.2f, j * 0.2f));
+	// the vertices themselves.
+	queries.insert(queries.end(), hull.begin(), hull.end());
+
+	std::vector<bool> results;
+	const std::size_t includedCount = polygon.include(queries, results);
+	std::size_t count = 0;
+	for (std::size_t i = 0; i < queries.size(); ++i)
+	{
+		const bool expected = includeByEdges(hull, queries[i]);
+		if (expected != polygon.include(queries[i]) || expected != results[i]) return false;
+		if (expected) ++count;
+	}
+	return count == includedCount && count > hull.size();
+}
+
+bool checkTolerance()
+{
+	const point_type square[] = { point_type(0, 0), point_type(4, 0), point_type(4, 4), point_type(0, 4) };
+	const swl::ConvexPolygon polygon(square, 4, 0.1f);
+
+	// near the edges & the corners.
+	return polygon.include(point_type(2.0f, -0.05f)) && !polygon.include(point_type(2.0f, -0.15f)) &&
+		polygon.include(point_type(4.09f, 2.0f)) && !polygon.include(point_type(4.11f, 2.0f)) &&
+		polygon.include(point_type(-0.09f, 4.09f)) && !polygon.include(point_type(-0.11f, 4.0f));
+}
+
+bool checkSegment()
+{
+	const point_type points[] = { point_type(0, 0), point_type(1, 1), point_type(2, 2) };
+	const swl::ConvexPolygon polygon(points, 3, 1.0e-3f);
+	if (2 != polygon.getVertices().size()) return false;
+
+	const point_type queries[] = { point_type(0.5f, 0.5f), point_type(0.5f, 0.6f), point_type(3, 3) };
+	bool results[3];
+	return 1 == polygon.include(queries, 3, results) && results[0] && !results[1] && !results[2];
+}
+
+// GeometryUtil::withinConvexHull() tests the supplied hull as it is, whichever its orientation is.
+bool checkWithinConvexHull()
+{
+	const swl::ConvexPolygon polygon(generatePoints());
+	const std::vector<point_type> &hull = polygon.getVertices();
+	const std::list<point_type> ccwHull(hull.begin(), hull.end()), cwHull(hull.rbegin(), hull.rend());
+
+	for (int i = -60; i <= 60; ++i)
+		for (int j = -30; j <= 30; ++j)
+		{
+			const point_type pt(i * 0.2f, j * 0.2f);
+			const bool expected = includeByEdges(hull, pt);
+			if (expected != swl::GeometryUtil::withinConvexHull(pt, ccwHull, 0.0f) || expected != swl::GeometryUtil::withinConvexHull(pt, cwHull, 0.0f)) return false;
+		}
+
+	// a line segment.
+	std::list<point_type> segment;
+	segment.push_back(point_type(0, 0));
+	segment.push_back(point_type(2, 2));
+	return swl::GeometryUtil::withinConvexHull(point_type(0.5f, 0.5f), segment, 1.0e-3f) && !swl::GeometryUtil::withinConvexHull(point_type(0.5f, 0.6f), segment, 1.0e-3f);
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct ConvexPolygonTest
+{
+public:
+	void testConvexHull()
+	{
+		BOOST_CHECK(local::checkConvexHull());
+	}
+
+	void testInclude()
+	{
+		BOOST_CHECK(local::checkInclude());
+	}
+
+	void testTolerance()
+	{
+		BOOST_CHECK(local::checkTolerance());
+	}
+
+	void testSegment()
+	{
+		BOOST_CHECK(local::checkSegment());
+	}
+
+	void testWithinConvexHull()
+	{
+		BOOST_CHECK(local::checkWithinConvexHull());
+	}
+};
+
+struct ConvexPolygonTestSuite: public boost::unit_test_framework::test_suite
+{
+	ConvexPolygonTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.Math.ConvexPolygon")
+	{
+		boost::shared_ptr<ConvexPolygonTest> test(new ConvexPolygonTest());
+
+		add(BOOST_CLASS_TEST_CASE(&ConvexPolygonTest::testConvexHull, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&ConvexPolygonTest::testInclude, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&ConvexPolygonTest::testTolerance, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&ConvexPolygonTest::testSegment, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&ConvexPolygonTest::testWithinConvexHull, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class ConvexPolygonTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(ConvexPolygonTest, testConvexHull)
+{
+	EXPECT_TRUE(local::checkConvexHull());
+}
+
+TEST_F(ConvexPolygonTest, testInclude)
+{
+	EXPECT_TRUE(local::checkInclude());
+}
+
+TEST_F(ConvexPolygonTest, testTolerance)
+{
+	EXPECT_TRUE(local::checkTolerance());
+}
+
+TEST_F(ConvexPolygonTest, testSegment)
+{
+	EXPECT_TRUE(local::checkSegment());
+}
+
+TEST_F(ConvexPolygonTest, testWithinConvexHull)
+{
+	EXPECT_TRUE(local::checkWithinConvexHull());
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct ConvexPolygonTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(ConvexPolygonTest);
+	CPPUNIT_TEST(testConvexHull);
+	CPPUNIT_TEST(testInclude);
+	CPPUNIT_TEST(testTolerance);
+	CPPUNIT_TEST(testSegment);
+	CPPUNIT_TEST(testWithinConvexHull);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testConvexHull()
+	{
+		CPPUNIT_ASSERT(local::checkConvexHull());
+	}
+
+	void testInclude()
+	{
+		CPPUNIT_ASSERT(local::checkInclude());
+	}
+
+	void testTolerance()
+	{
+		CPPUNIT_ASSERT(local::checkTolerance());
+	}
+
+	void testSegment()
+	{
+		CPPUNIT_ASSERT(local::checkSegment());
+	}
+
+	void testWithinConvexHull()
+	{
+		CPPUNIT_ASSERT(local::checkWithinConvexHull());
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::ConvexPolygonTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.Math");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::ConvexPolygonTest, "SWL.Math");
+#endif
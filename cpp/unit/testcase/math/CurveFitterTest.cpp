@@ -0,0 +1,327 @@
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/math/CurveFitter.h"
+#include <vector>
+#include <cmath>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+const double eps = 1.0e-6;
+
+bool isClose(const std::vector<double> &params, const double *expected, const std::size_t count, const double tol = eps)
+{
+	if (params.size() != count) return false;
+	for (std::size_t i = 0; i < count; ++i)
+		if (std::abs(params[i] - expected[i]) > tol) return false;
+	return true;
+}
+
+// deterministic noise in [-0.5, 0.5).
+double noise(const std::size_t i)
+{
+	const double val = std::sin(12.9898 * (i + 1)) * 43758.5453;
+	return val - std::floor(val) - 0.5;
+}
+
+bool checkModels()
+{
+	std::vector<double> xs, ys, params;
+
+	// a vertical line, x = 2.
+	for (int i = 0; i < 10; ++i)
+	{
+		xs.push_back(2.0);
+		ys.push_back(i);
+	}
+	swl::CurveFitter line(swl::CurveFitter::LINE);
+	line.add(&xs[0], &ys[0], xs.size());
+	if (!line.solve(params)) return false;
+	const double sign = params[0] > 0.0 ? 1.0 : -1.0;
+	const double expectedLine[] = { sign, 0.0, -2.0 * sign };
+	if (!isClose(params, expectedLine, 3)) return false;
+
+	// y = 0.5 * x^2 - 2 * x + 1 & y = 1 - x + 0.25 * x^2 - 0.125 * x^3.
+	xs.clear();
+	ys.clear();
+	std::vector<double> cubic;
+	for (int i = -10; i <= 10; ++i)
+	{
+		const double x = i * 0.3;
+		xs.push_back(x);
+		ys.push_back((0.5 * x - 2.0) * x + 1.0);
+		cubic.push_back(1.0 + x * (-1.0 + x * (0.25 - 0.125 * x)));
+	}
+	swl::CurveFitter quadratic(swl::CurveFitter::QUADRATIC);
+	quadratic.add(&xs[0], &ys[0], xs.size());
+	const double expectedQuadratic[] = { 0.5, -2.0, -1.0, 1.0 };
+	if (!quadratic.solve(params) || !isClose(params, expectedQuadratic, 4)) return false;
+
+	swl::CurveFitter polynomial(swl::CurveFitter::POLYNOMIAL, 3);
+	polynomial.add(&xs[0], &cubic[0], xs.size());
+	const double expectedPolynomial[] = { 1.0, -1.0, 0.25, -0.125 };
+	if (!polynomial.solve(params) || !isClose(params, expectedPolynomial, 4)) return false;
+
+	// a circle & a rotated ellipse.
+	swl::CurveFitter circle(swl::CurveFitter::CIRCLE), ellipse(swl::CurveFitter::ELLIPSE);
+	const double theta = 0.4;
+	for (int i = 0; i < 30; ++i)
+	{
+		const double t = 0.21 * i;
+		circle.add(1.0 + 3.0 * std::cos(t), -2.0 + 3.0 * std::sin(t));
+
+		const double u = 4.0 * std::cos(t), v = 1.5 * std::sin(t);
+		ellipse.add(-1.0 + u * std::cos(theta) - v * std::sin(theta), 2.0 + u * std::sin(theta) + v * std::cos(theta));
+	}
+	const double expectedCircle[] = { 1.0, -2.0, 3.0 };
+	if (!circle.solve(params) || !isClose(params, expectedCircle, 3)) return false;
+
+	if (!ellipse.solve(params) || std::abs(params[0] + params[2] - 1.0) > eps) return false;
+	double cx, cy, major, minor, angle;
+	if (!swl::CurveFitter::getEllipseGeometry(params, cx, cy, major, minor, angle)) return false;
+	// the angle of an axis is defined up to pi.
+	const double angleDiff = std::abs(std::remainder(angle - theta, 3.14159265358979323846));
+	return std::abs(cx + 1.0) < eps && std::abs(cy - 2.0) < eps && std::abs(major - 4.0) < eps && std::abs(minor - 1.5) < eps && angleDiff < eps;
+}
+
+bool checkAddRemove()
+{
+	swl::CurveFitter fitter(swl::CurveFitter::CIRCLE), reference(swl::CurveFitter::CIRCLE);
+	for (int i = 0; i < 20; ++i)
+	{
+		const double t = 0.3 * i, x = 2.0 * std::cos(t) + 0.01 * noise(i), y = 2.0 * std::sin(t) + 0.01 * noise(i + 100);
+		fitter.add(x, y);
+		reference.add(x, y, 2.0);
+	}
+	// outliers added & removed again.
+	fitter.add(10.0, 10.0, 3.0);
+	fitter.add(-7.0, 1.0);
+	fitter.remove(10.0, 10.0, 3.0);
+	fitter.remove(-7.0, 1.0);
+	if (20 != fitter.getPointCount()) return false;
+
+	// the solution does not depend on a common scale of the weights.
+	std::vector<double> params, expected;
+	if (!fitter.solve(params) || !reference.solve(expected)) return false;
+	if (!isClose(params, &expected[0], expected.size(), 1.0e-9)) return false;
+
+	// too few points.
+	swl::CurveFitter empty(swl::CurveFitter::CIRCLE);
+	empty.add(0.0, 0.0);
+	empty.add(1.0, 0.0);
+	return !empty.solve(params);
+}
+
+bool checkRobust()
+{
+	// y = 0.5 * x + 1 with small noise, every 5th point is an outlier.
+	std::vector<double> xs, ys;
+	for (std::size_t i = 0; i < 100; ++i)
+	{
+		const double x = 0.1 * i;
+		xs.push_back(x);
+		ys.push_back(0.5 * x + 1.0 + (i % 5 ? 0.01 * noise(i) : 5.0 + noise(i)));
+	}
+
+	swl::CurveFitter fitter(swl::CurveFitter::POLYNOMIAL, 1);
+	std::vector<double> params, weights;
+	if (!fitter.fitRobust(&xs[0], &ys[0], xs.size(), swl::CurveFitter::LEAST_SQUARES, params)) return false;
+	// biased by the outliers.
+	if (std::abs(params[0] - 1.0) < 0.5) return false;
+
+	const double expected[] = { 1.0, 0.5 };
+	if (!fitter.fitRobust(&xs[0], &ys[0], xs.size(), swl::CurveFitter::HUBER, params, &weights) || !isClose(params, expected, 2, 0.1)) return false;
+	if (!fitter.fitRobust(&xs[0], &ys[0], xs.size(), swl::CurveFitter::TUKEY, params, &weights) || !isClose(params, expected, 2, 0.01)) return false;
+
+	// Tukey's weights reject the outliers completely.
+	for (std::size_t i = 0; i < weights.size(); ++i)
+		if ((0 == i % 5) != (0.0 == weights[i])) return false;
+	return true;
+}
+
+bool checkBatch()
+{
+	// circles of different radii, with the last set too small to fit.
+	std::vector<double> xs, ys;
+	std::vector<std::size_t> offsets(1, 0);
+	for (int s = 0; s < 50; ++s)
+	{
+		const std::size_t count = 49 == s ? 2 : 10 + s;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const double t = 6.0 * i / count;
+			xs.push_back(s + (1.0 + s) * std::cos(t) + 0.001 * noise(xs.size()));
+			ys.push_back(-s + (1.0 + s) * std::sin(t));
+		}
+		offsets.push_back(xs.size());
+	}
+
+	std::vector<std::vector<double> > params;
+	if (49 != swl::CurveFitter::fitBatch(swl::CurveFitter::CIRCLE, 0, swl::CurveFitter::TUKEY, &xs[0], &ys[0], offsets, params)) return false;
+	if (50 != params.size() || !params.back().empty()) return false;
+
+	swl::CurveFitter fitter(swl::CurveFitter::CIRCLE);
+	std::vector<double> expected;
+	for (std::size_t s = 0; s < 49; ++s)
+	{
+		if (!fitter.fitRobust(&xs[offsets[s]], &ys[offsets[s]], offsets[s + 1] - offsets[s], swl::CurveFitter::TUKEY, expected)) return false;
+		if (!isClose(params[s], &expected[0], expected.size(), 0.0)) return false;
+		if (std::abs(params[s][2] - (1.0 + s)) > 0.01) return false;
+	}
+	return true;
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct CurveFitterTest
+{
+public:
+	void testModels()
+	{
+		BOOST_CHECK(local::checkModels());
+	}
+
+	void testAddRemove()
+	{
+		BOOST_CHECK(local::checkAddRemove());
+	}
+
+	void testRobust()
+	{
+		BOOST_CHECK(local::checkRobust());
+	}
+
+	void testBatch()
+	{
+		BOOST_CHECK(local::checkBatch());
+	}
+};
+
+struct CurveFitterTestSuite: public boost::unit_test_framework::test_suite
+{
+	CurveFitterTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.Math.CurveFitter")
+	{
+		boost::shared_ptr<CurveFitterTest> test(new CurveFitterTest());
+
+		add(BOOST_CLASS_TEST_CASE(&CurveFitterTest::testModels, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&CurveFitterTest::testAddRemove, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&CurveFitterTest::testRobust, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&CurveFitterTest::testBatch, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class CurveFitterTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(CurveFitterTest, testModels)
+{
+	EXPECT_TRUE(local::checkModels());
+}
+
+TEST_F(CurveFitterTest, testAddRemove)
+{
+	EXPECT_TRUE(local::checkAddRemove());
+}
+
+TEST_F(CurveFitterTest, testRobust)
+{
+	EXPECT_TRUE(local::checkRobust());
+}
+
+TEST_F(CurveFitterTest, testBatch)
+{
+	EXPECT_TRUE(local::checkBatch());
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct CurveFitterTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(CurveFitterTest);
+	CPPUNIT_TEST(testModels);
+	CPPUNIT_TEST(testAddRemove);
+	CPPUNIT_TEST(testRobust);
+	CPPUNIT_TEST(testBatch);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testModels()
+	{
+		CPPUNIT_ASSERT(local::checkModels());
+	}
+
+	void testAddRemove()
+	{
+		CPPUNIT_ASSERT(local::checkAddRemove());
+	}
+
+	void testRobust()
+	{
+		CPPUNIT_ASSERT(local::checkRobust());
+	}
+
+	void testBatch()
+	{
+		CPPUNIT_ASSERT(local::checkBatch());
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::CurveFitterTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.Math");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::CurveFitterTest, "SWL.Math");
+#endif
@@ -0,0 +1,305 @@
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/math/Matrix.h"
+#include <vector>
+#include <cmath>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+template<typename T>
+void fillMatrix(swl::Matrix<T> &A, const int seed)
+{
+	for (std::size_t i = 0; i < A.rows(); ++i)
+		for (std::size_t j = 0; j < A.cols(); ++j)
+			A(i, j) = T(((i * 7 + j * 3 + seed) % 11) - 5) / T(4);
+}
+
+// the naive product for reference.
+template<typename T>
+swl::Matrix<T> multiply(const swl::Matrix<T> &A, const swl::Matrix<T> &B)
+{
+	swl::Matrix<T> C(A.rows(), B.cols());
+	for (std::size_t i = 0; i < A.rows(); ++i)
+		for (std::size_t j = 0; j < B.cols(); ++j)
+		{
+			double sum = 0.0;
+			for (std::size_t p = 0; p < A.cols(); ++p) sum += double(A(i, p)) * double(B(p, j));
+			C(i, j) = T(sum);
+		}
+	return C;
+}
+
+template<typename T>
+bool isClose(const swl::Matrix<T> &A, const swl::Matrix<T> &B, const double tol)
+{
+	if (A.rows() != B.rows() || A.cols() != B.cols()) return false;
+	for (std::size_t i = 0; i < A.rows(); ++i)
+		for (std::size_t j = 0; j < A.cols(); ++j)
+			if (std::fabs(double(A(i, j)) - double(B(i, j))) > tol) return false;
+	return true;
+}
+
+template<typename T>
+bool checkProduct(const std::size_t m, const std::size_t k, const std::size_t n, const double tol)
+{
+	swl::Matrix<T> A(m, k), B(k, n), c(m, n);
+	fillMatrix(A, 1);
+	fillMatrix(B, 2);
+	fillMatrix(c, 3);
+
+	const swl::Matrix<T> AB(multiply(A, B));
+	swl::Matrix<T> expected(c);
+	for (std::size_t i = 0; i < m; ++i)
+		for (std::size_t j = 0; j < n; ++j)
+			expected(i, j) = T(2) * AB(i, j) - c(i, j);
+
+	// A * B + c without a temporary, then with the product accumulated.
+	swl::Matrix<T> C;
+	C = T(2) * (A * B) - c;
+	if (!isClose(C, expected, tol)) return false;
+	C = -c;
+	C += A * B * T(2);
+	return isClose(C, expected, tol);
+}
+
+bool checkExpressions()
+{
+	swl::Matrix<double> A(3, 3), x(3, 1), b(3, 1);
+	fillMatrix(A, 0);
+	fillMatrix(x, 1);
+	fillMatrix(b, 2);
+
+	// y = A * x + b.
+	swl::Matrix<double> y(A * x + b);
+	swl::Matrix<double> expected(multiply(A, x));
+	for (std::size_t i = 0; i < 3; ++i) expected(i, 0) += b(i, 0);
+	if (!isClose(y, expected, 1.0e-12)) return false;
+
+	// aliased: x = A * x.
+	expected = multiply(A, x);
+	x = A * x;
+	if (!isClose(x, expected, 1.0e-12)) return false;
+
+	// a product of expressions.
+	const swl::Matrix<double> I(swl::Matrix<double>::identity(3));
+	swl::Matrix<double> B((A + I) * (A - I));
+	swl::Matrix<double> A2(multiply(A, A));
+	for (std::size_t i = 0; i < 3; ++i) A2(i, i) -= 1.0;
+	if (!isClose(B, A2, 1.0e-12)) return false;
+
+	// a mismatched size.
+	try
+	{
+		swl::Matrix<double> z(A * b.transpose());
+		return false;
+	}
+	catch (const swl::LogException &)
+	{
+	}
+
+	return true;
+}
+
+bool checkViews()
+{
+	// a (2 x 3) block of a (4 x 5) array.
+	std::vector<double> buf(20, 0.0);
+	swl::MatrixView<double> V(swl::makeMatrixView(&buf[0], 4, 5, 5).block(1, 1, 2, 3));
+
+	swl::Matrix<double> A(2, 3), B(3, 3);
+	fillMatrix(A, 4);
+	fillMatrix(B, 5);
+	V = A * B;
+
+	const swl::Matrix<double> AB(multiply(A, B));
+	for (std::size_t i = 0; i < 4; ++i)
+		for (std::size_t j = 0; j < 5; ++j)
+		{
+			const bool isInBlock = 1 <= i && i < 3 && 1 <= j && j < 4;
+			if (std::fabs(buf[i * 5 + j] - (isInBlock ? AB(i - 1, j - 1) : 0.0)) > 1.0e-12) return false;
+		}
+
+	// a strided column vector.
+	swl::Matrix<double> M(3, 4);
+	fillMatrix(M, 6);
+	swl::Matrix<double> col(M.block(0, 2, 3, 1)), y(B * M.block(0, 2, 3, 1));
+	return isClose(y, multiply(B, col), 1.0e-12);
+}
+
+bool checkFixedMatrix()
+{
+	const double a[] = { 1, 2, 3, 4, 5, 6 };
+	const double b[] = { 1, 0, -1, 2, 0.5, 3 };
+	const swl::FixedMatrix<double, 2, 3> A(a);
+	const swl::FixedMatrix<double, 3, 2> B(b);
+
+	const swl::FixedMatrix<double, 2, 2> C(A * B);
+	if (C(0, 0) != 1 - 2 + 1.5 || C(0, 1) != 0 + 4 + 9 || C(1, 0) != 4 - 5 + 3 || C(1, 1) != 0 + 10 + 18) return false;
+
+	// mixed with a dynamic matrix.
+	swl::Matrix<double> D(2, 2, 1.0);
+	D = C + D * 2.0;
+	return 2 == D.rows() && 2 == D.cols() && D(1, 1) == 30.0 && D(0, 0) == 2.5;
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct MatrixTest
+{
+public:
+	void testProduct()
+	{
+		BOOST_CHECK(local::checkProduct<double>(37, 301, 290, 1.0e-10));
+		BOOST_CHECK(local::checkProduct<float>(33, 129, 257, 1.0e-3));
+		BOOST_CHECK(local::checkProduct<int>(5, 7, 3, 0.0));
+	}
+
+	void testExpressions()
+	{
+		BOOST_CHECK(local::checkExpressions());
+	}
+
+	void testViews()
+	{
+		BOOST_CHECK(local::checkViews());
+	}
+
+	void testFixedMatrix()
+	{
+		BOOST_CHECK(local::checkFixedMatrix());
+	}
+};
+
+struct MatrixTestSuite: public boost::unit_test_framework::test_suite
+{
+	MatrixTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.Math.Matrix")
+	{
+		boost::shared_ptr<MatrixTest> test(new MatrixTest());
+
+		add(BOOST_CLASS_TEST_CASE(&MatrixTest::testProduct, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&MatrixTest::testExpressions, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&MatrixTest::testViews, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&MatrixTest::testFixedMatrix, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class MatrixTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(MatrixTest, testProduct)
+{
+	EXPECT_TRUE(local::checkProduct<double>(37, 301, 290, 1.0e-10));
+	EXPECT_TRUE(local::checkProduct<float>(33, 129, 257, 1.0e-3));
+	EXPECT_TRUE(local::checkProduct<int>(5, 7, 3, 0.0));
+}
+
+TEST_F(MatrixTest, testExpressions)
+{
+	EXPECT_TRUE(local::checkExpressions());
+}
+
+TEST_F(MatrixTest, testViews)
+{
+	EXPECT_TRUE(local::checkViews());
+}
+
+TEST_F(MatrixTest, testFixedMatrix)
+{
+	EXPECT_TRUE(local::checkFixedMatrix());
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct MatrixTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(MatrixTest);
+	CPPUNIT_TEST(testProduct);
+	CPPUNIT_TEST(testExpressions);
+	CPPUNIT_TEST(testViews);
+	CPPUNIT_TEST(testFixedMatrix);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testProduct()
+	{
+		CPPUNIT_ASSERT(local::checkProduct<double>(37, 301, 290, 1.0e-10));
+		CPPUNIT_ASSERT(local::checkProduct<float>(33, 129, 257, 1.0e-3));
+		CPPUNIT_ASSERT(local::checkProduct<int>(5, 7, 3, 0.0));
+	}
+
+	void testExpressions()
+	{
+		CPPUNIT_ASSERT(local::checkExpressions());
+	}
+
+	void testViews()
+	{
+		CPPUNIT_ASSERT(local::checkViews());
+	}
+
+	void testFixedMatrix()
+	{
+		CPPUNIT_ASSERT(local::checkFixedMatrix());
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::MatrixTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.Math");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::MatrixTest, "SWL.Math");
+#endif
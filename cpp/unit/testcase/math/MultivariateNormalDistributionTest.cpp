@@ -0,0 +1,226 @@
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/math/MultivariateNormalDistribution.h"
+#include "swl/math/MathConstant.h"
+#include <Eigen/LU>
+#include <stdexcept>
+#include <cmath>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+// log p(x) by the definition.
+double logPdf(const Eigen::VectorXd &x, const Eigen::VectorXd &mean, const Eigen::MatrixXd &cov)
+{
+	const Eigen::VectorXd d(x - mean);
+	return -0.5 * d.dot(cov.inverse() * d) - 0.5 * double(x.size()) * std::log(swl::MathConstant::_2_PI) - 0.5 * std::log(cov.determinant());
+}
+
+Eigen::MatrixXd generatePoints(const Eigen::MatrixXd::Index dim, const Eigen::MatrixXd::Index count)
+{
+	Eigen::MatrixXd X(dim, count);
+	for (Eigen::MatrixXd::Index j = 0; j < count; ++j)
+		for (Eigen::MatrixXd::Index i = 0; i < dim; ++i)
+			X(i, j) = double(((j * 31 + i * 17) % 41) - 20) / 10.0;
+	return X;
+}
+
+bool checkDistribution(const swl::MultivariateNormalDistribution &dist, const Eigen::VectorXd &mean, const Eigen::MatrixXd &cov)
+{
+	// more than one block of points.
+	const Eigen::MatrixXd X(generatePoints(mean.size(), 1000));
+	Eigen::VectorXd logPdfs, pdfs;
+	dist.logPdf(X, logPdfs);
+	dist.pdf(X, pdfs);
+	if (logPdfs.size() != X.cols() || pdfs.size() != X.cols()) return false;
+
+	for (Eigen::MatrixXd::Index j = 0; j < X.cols(); ++j)
+	{
+		const double expected = logPdf(X.col(j), mean, cov);
+		if (std::fabs(logPdfs(j) - expected) > 1.0e-10 || std::fabs(dist.logPdf(X.col(j)) - expected) > 1.0e-10 ||
+			std::fabs(pdfs(j) - std::exp(expected)) > 1.0e-12)
+			return false;
+	}
+	return true;
+}
+
+bool checkFullCovariance()
+{
+	Eigen::VectorXd mean(3);
+	mean << 1.0, -1.0, 0.5;
+	Eigen::MatrixXd cov(3, 3);
+	cov << 0.9, 0.4, 0.1,  0.4, 0.3, 0.05,  0.1, 0.05, 2.0;
+
+	const swl::MultivariateNormalDistribution dist(mean, cov);
+	if (swl::MultivariateNormalDistribution::FULL_COVARIANCE != dist.getCovarianceType() || !checkDistribution(dist, mean, cov))
+		return false;
+
+	// not positive definite.
+	try
+	{
+		cov(2, 2) = -1.0;
+		const swl::MultivariateNormalDistribution invalid(mean, cov);
+		return false;
+	}
+	catch (const std::runtime_error &)
+	{
+	}
+	return true;
+}
+
+bool checkDiagonalCovariance()
+{
+	Eigen::VectorXd mean(4), variances(4);
+	mean << 1.0, -1.0, 0.5, 0.0;
+	variances << 0.5, 2.0, 1.5, 0.25;
+
+	const swl::MultivariateNormalDistribution dist(mean, variances);
+	return swl::MultivariateNormalDistribution::DIAGONAL_COVARIANCE == dist.getCovarianceType() && checkDistribution(dist, mean, Eigen::MatrixXd(variances.asDiagonal()));
+}
+
+bool checkIsotropicCovariance()
+{
+	Eigen::VectorXd mean(2);
+	mean << -1.0, 2.0;
+
+	const swl::MultivariateNormalDistribution dist(mean, 0.7);
+	return swl::MultivariateNormalDistribution::ISOTROPIC_COVARIANCE == dist.getCovarianceType() && checkDistribution(dist, mean, 0.7 * Eigen::MatrixXd::Identity(2, 2));
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct MultivariateNormalDistributionTest
+{
+public:
+	void testFullCovariance()
+	{
+		BOOST_CHECK(local::checkFullCovariance());
+	}
+
+	void testDiagonalCovariance()
+	{
+		BOOST_CHECK(local::checkDiagonalCovariance());
+	}
+
+	void testIsotropicCovariance()
+	{
+		BOOST_CHECK(local::checkIsotropicCovariance());
+	}
+};
+
+struct MultivariateNormalDistributionTestSuite: public boost::unit_test_framework::test_suite
+{
+	MultivariateNormalDistributionTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.Math.MultivariateNormalDistribution")
+	{
+		boost::shared_ptr<MultivariateNormalDistributionTest> test(new MultivariateNormalDistributionTest());
+
+		add(BOOST_CLASS_TEST_CASE(&MultivariateNormalDistributionTest::testFullCovariance, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&MultivariateNormalDistributionTest::testDiagonalCovariance, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&MultivariateNormalDistributionTest::testIsotropicCovariance, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class MultivariateNormalDistributionTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(MultivariateNormalDistributionTest, testFullCovariance)
+{
+	EXPECT_TRUE(local::checkFullCovariance());
+}
+
+TEST_F(MultivariateNormalDistributionTest, testDiagonalCovariance)
+{
+	EXPECT_TRUE(local::checkDiagonalCovariance());
+}
+
+TEST_F(MultivariateNormalDistributionTest, testIsotropicCovariance)
+{
+	EXPECT_TRUE(local::checkIsotropicCovariance());
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct MultivariateNormalDistributionTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(MultivariateNormalDistributionTest);
+	CPPUNIT_TEST(testFullCovariance);
+	CPPUNIT_TEST(testDiagonalCovariance);
+	CPPUNIT_TEST(testIsotropicCovariance);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testFullCovariance()
+	{
+		CPPUNIT_ASSERT(local::checkFullCovariance());
+	}
+
+	void testDiagonalCovariance()
+	{
+		CPPUNIT_ASSERT(local::checkDiagonalCovariance());
+	}
+
+	void testIsotropicCovariance()
+	{
+		CPPUNIT_ASSERT(local::checkIsotropicCovariance());
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::MultivariateNormalDistributionTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.Math");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::MultivariateNormalDistributionTest, "SWL.Math");
+#endif
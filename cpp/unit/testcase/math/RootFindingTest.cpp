@@ -0,0 +1,281 @@
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/math/RootFinding.h"
+#include <vector>
+#include <cmath>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+const double tol = 1.0e-10;
+
+double cosMinusX(double x)
+{
+	return std::cos(x) - x;
+}
+
+bool checkFunctor()
+{
+	// the root of cos(x) = x.
+	const double expected = 0.73908513321516064;
+
+	// a function pointer & a closure.
+	const double offset = 1.0;
+	const double root1 = swl::RootFinding::bisection(0.0, 1.0, cosMinusX, 1.0e-12);
+	const double root2 = swl::RootFinding::falsePosition(0.0, 1.0, [offset](double x) { return std::cos(x) - x * offset; }, 1.0e-12);
+	const double root3 = swl::RootFinding::secant(0.5, [offset](double x) { return std::cos(x) - x * offset; }, 1.0e-12);
+	if (std::abs(root1 - expected) > 1.0e-9 || std::abs(root2 - expected) > 1.0e-9 || std::abs(root3 - expected) > 1.0e-9) return false;
+
+	const swl::RootFinding::Result result = swl::RootFinding::brent(0.0, 1.0, [offset](double x) { return std::cos(x) - x * offset; }, 1.0e-14);
+	if (swl::RootFinding::CONVERGED != result.status || std::abs(result.root - expected) > 1.0e-13 || result.iterations > 10) return false;
+
+	// not bracketed.
+	return swl::RootFinding::NOT_BRACKETED == swl::RootFinding::brent(1.0, 2.0, cosMinusX).status;
+}
+
+bool checkNewtonHalley()
+{
+	// the cube root of 10.
+	const double a = 10.0, expected = std::cbrt(a);
+	const swl::RootFinding::Result newton = swl::RootFinding::newton(1.0, [a](double x, double &f, double &df) { f = x * x * x - a;  df = 3.0 * x * x; });
+	const swl::RootFinding::Result halley = swl::RootFinding::halley(1.0, [a](double x, double &f, double &df, double &d2f) { f = x * x * x - a;  df = 3.0 * x * x;  d2f = 6.0 * x; });
+	if (swl::RootFinding::CONVERGED != newton.status || std::abs(newton.root - expected) > tol) return false;
+	if (swl::RootFinding::CONVERGED != halley.status || std::abs(halley.root - expected) > tol) return false;
+	// the cubic convergence.
+	if (halley.iterations >= newton.iterations) return false;
+
+	// f'(0) = 0.
+	const swl::RootFinding::Result flat = swl::RootFinding::newton(0.0, [](double x, double &f, double &df) { f = x * x + 1.0;  df = 2.0 * x; });
+	return swl::RootFinding::ZERO_DERIVATIVE == flat.status;
+}
+
+bool checkBatch()
+{
+	// x^3 = a_i for many a_i, from a common initial guess.
+	const std::size_t count = 1000;
+	std::vector<double> as(count), inits(count, 1.0), lefts(count, 0.0), rights(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		as[i] = 0.01 + 0.5 * i;
+		rights[i] = 1.0 + as[i];
+	}
+
+	std::vector<swl::RootFinding::Result> newtons(count), halleys(count), bracketed(count);
+	const std::size_t newtonCount = swl::RootFinding::newton(count, &inits[0], [&as](std::size_t i, double x, double &f, double &df) { f = x * x * x - as[i];  df = 3.0 * x * x; }, &newtons[0]);
+	const std::size_t halleyCount = swl::RootFinding::halley(count, &inits[0], [&as](std::size_t i, double x, double &f, double &df, double &d2f) { f = x * x * x - as[i];  df = 3.0 * x * x;  d2f = 6.0 * x; }, &halleys[0]);
+	if (count != newtonCount || count != halleyCount) return false;
+
+	// the bracket keeps the iterates positive even from x = 0, where f' = 0.
+	std::vector<double> zeros(count, 0.0);
+	if (count != swl::RootFinding::newton(count, &zeros[0], [&as](std::size_t i, double x, double &f, double &df) { f = x * x * x - as[i];  df = 3.0 * x * x; }, &bracketed[0], &lefts[0], &rights[0])) return false;
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const double expected = std::cbrt(as[i]), eps = tol * (1.0 + expected);
+		if (std::abs(newtons[i].root - expected) > eps || std::abs(halleys[i].root - expected) > eps || std::abs(bracketed[i].root - expected) > eps) return false;
+
+		// the same as the scalar solver.
+		const double a = as[i];
+		const swl::RootFinding::Result scalar = swl::RootFinding::newton(1.0, [a](double x, double &f, double &df) { f = x * x * x - a;  df = 3.0 * x * x; });
+		if (scalar.root != newtons[i].root || scalar.iterations != newtons[i].iterations) return false;
+	}
+
+	// a problem without a sign change.
+	swl::RootFinding::Result result;
+	const double init = 0.5, left = 1.0, right = 2.0;
+	return 0 == swl::RootFinding::newton(1, &init, [](std::size_t, double x, double &f, double &df) { f = x * x + 1.0;  df = 2.0 * x; }, &result, &left, &right) &&
+		swl::RootFinding::NOT_BRACKETED == result.status;
+}
+
+bool checkPolynomialBatch()
+{
+	const std::array<double, 3> quadratics[] = { { 1.0, -3.0, 2.0 }, { 0.0, 1.0, 1.0 }, { 1.0, 0.0, 1.0 } };
+	const std::array<double, 4> cubics[] = { { 1.0, -6.0, 11.0, -6.0 }, { 2.0, 0.0, 0.0, -16.0 } };
+	const std::array<double, 5> quartics[] = { { 1.0, -10.0, 35.0, -50.0, 24.0 }, { 0.0, 0.0, 0.0, 0.0, 1.0 } };
+	std::array<std::complex<double>, 2> quadraticRoots[3], quadraticRoot;
+	std::array<std::complex<double>, 3> cubicRoots[2], cubicRoot;
+	std::array<std::complex<double>, 4> quarticRoots[2], quarticRoot;
+
+	if (2 != swl::RootFinding::quadratic(3, quadratics, quadraticRoots)) return false;
+	if (2 != swl::RootFinding::cubic(2, cubics, cubicRoots)) return false;
+	if (1 != swl::RootFinding::quartic(2, quartics, quarticRoots)) return false;
+
+	// illegal polynomials.
+	if (!std::isnan(quadraticRoots[1][0].real()) || !std::isnan(quarticRoots[1][3].imag())) return false;
+
+	// the same as the scalar solvers.
+	for (int i = 0; i < 3; ++i)
+	{
+		if (1 == i) continue;
+		swl::RootFinding::quadratic(quadratics[i], quadraticRoot);
+		if (quadraticRoot != quadraticRoots[i]) return false;
+	}
+	for (int i = 0; i < 2; ++i)
+	{
+		swl::RootFinding::cubic(cubics[i], cubicRoot);
+		if (cubicRoot != cubicRoots[i]) return false;
+	}
+	swl::RootFinding::quartic(quartics[0], quarticRoot);
+	if (quarticRoot != quarticRoots[0]) return false;
+
+	// 1, 2, 3 & 4.
+	double sum = 0.0;
+	for (int i = 0; i < 4; ++i)
+		sum += quarticRoots[0][i].real();
+	return std::abs(sum - 10.0) < 1.0e-9 && std::abs(quadraticRoots[2][0].imag()) == 1.0;
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct RootFindingTest
+{
+public:
+	void testFunctor()
+	{
+		BOOST_CHECK(local::checkFunctor());
+	}
+
+	void testNewtonHalley()
+	{
+		BOOST_CHECK(local::checkNewtonHalley());
+	}
+
+	void testBatch()
+	{
+		BOOST_CHECK(local::checkBatch());
+	}
+
+	void testPolynomialBatch()
+	{
+		BOOST_CHECK(local::checkPolynomialBatch());
+	}
+};
+
+struct RootFindingTestSuite: public boost::unit_test_framework::test_suite
+{
+	RootFindingTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.Math.RootFinding")
+	{
+		boost::shared_ptr<RootFindingTest> test(new RootFindingTest());
+
+		add(BOOST_CLASS_TEST_CASE(&RootFindingTest::testFunctor, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&RootFindingTest::testNewtonHalley, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&RootFindingTest::testBatch, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&RootFindingTest::testPolynomialBatch, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class RootFindingTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(RootFindingTest, testFunctor)
+{
+	EXPECT_TRUE(local::checkFunctor());
+}
+
+TEST_F(RootFindingTest, testNewtonHalley)
+{
+	EXPECT_TRUE(local::checkNewtonHalley());
+}
+
+TEST_F(RootFindingTest, testBatch)
+{
+	EXPECT_TRUE(local::checkBatch());
+}
+
+TEST_F(RootFindingTest, testPolynomialBatch)
+{
+	EXPECT_TRUE(local::checkPolynomialBatch());
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct RootFindingTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(RootFindingTest);
+	CPPUNIT_TEST(testFunctor);
+	CPPUNIT_TEST(testNewtonHalley);
+	CPPUNIT_TEST(testBatch);
+	CPPUNIT_TEST(testPolynomialBatch);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testFunctor()
+	{
+		CPPUNIT_ASSERT(local::checkFunctor());
+	}
+
+	void testNewtonHalley()
+	{
+		CPPUNIT_ASSERT(local::checkNewtonHalley());
+	}
+
+	void testBatch()
+	{
+		CPPUNIT_ASSERT(local::checkBatch());
+	}
+
+	void testPolynomialBatch()
+	{
+		CPPUNIT_ASSERT(local::checkPolynomialBatch());
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::RootFindingTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.Math");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::RootFindingTest, "SWL.Math");
+#endif
@@ -0,0 +1,328 @@
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/math/Rotation.h"
+#include "swl/math/Quaternion.h"
+#include <vector>
+#include <cmath>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+// structure-of-arrays buffers.
+template<int N>
+struct Arrays
+{
+	Arrays(const std::size_t count)
+	: buf(N * count, 0.0)
+	{
+		for (int i = 0; i < N; ++i) ptr[i] = &buf[i * count];
+	}
+
+	std::vector<double> buf;
+	double *ptr[N];
+};
+
+void generateAngles(const std::size_t count, std::vector<double> &alpha, std::vector<double> &beta, std::vector<double> &gamma)
+{
+	alpha.resize(count);
+	beta.resize(count);
+	gamma.resize(count);
+	for (std::size_t n = 0; n < count; ++n)
+	{
+		alpha[n] = -3.1 + 6.2 * double((n * 37) % 101) / 100.0;
+		beta[n] = -1.5 + 3.0 * double((n * 53) % 97) / 96.0;
+		gamma[n] = -3.1 + 6.2 * double((n * 71) % 89) / 88.0;
+	}
+}
+
+bool checkRotate(const unsigned int order)
+{
+	const std::size_t count = 300;  // more than one block.
+	std::vector<double> alpha, beta, gamma;
+	generateAngles(count, alpha, beta, gamma);
+
+	Arrays<9> mats(count);
+	Arrays<4> quats(count);
+	Arrays<9> quatMats(count);
+	swl::RotationArray::rotate(order, count, &alpha[0], &beta[0], &gamma[0], mats.ptr);
+	swl::RotationArray::toQuaternion(order, count, &alpha[0], &beta[0], &gamma[0], quats.ptr);
+	swl::RotationArray::toRotationMatrix(count, quats.ptr, quatMats.ptr);
+	for (std::size_t n = 0; n < count; ++n)
+	{
+		const swl::RMatrix3<double> expected(swl::Rotation::rotate(order, swl::RotationAngle(alpha[n], beta[n], gamma[n])));
+		for (int i = 0; i < 9; ++i)
+			if (std::fabs(mats.ptr[i][n] - expected[i]) > 1.0e-12 || std::fabs(quatMats.ptr[i][n] - expected[i]) > 1.0e-12)
+				return false;
+	}
+	return true;
+}
+
+bool checkCalc(const unsigned int order)
+{
+	const std::size_t count = 100;
+	std::vector<double> alpha, beta, gamma;
+	generateAngles(count, alpha, beta, gamma);
+
+	Arrays<9> mats(count);
+	swl::RotationArray::rotate(order, count, &alpha[0], &beta[0], &gamma[0], mats.ptr);
+
+	std::vector<double> a(count), b(count), g(count);
+	swl::RotationArray::calc(order, count, mats.ptr, &a[0], &b[0], &g[0]);
+	double entry[9];
+	for (std::size_t n = 0; n < count; ++n)
+	{
+		for (int i = 0; i < 9; ++i) entry[i] = mats.ptr[i][n];
+		const swl::RotationAngle expected(swl::RotationAngle::calc(order, swl::RMatrix3<double>(entry)));
+		if (std::fabs(a[n] - expected.alpha()) > 1.0e-12 || std::fabs(b[n] - expected.beta()) > 1.0e-12 || std::fabs(g[n] - expected.gamma()) > 1.0e-12)
+			return false;
+	}
+	return true;
+}
+
+bool checkQuaternion()
+{
+	const std::size_t count = 100;
+	const unsigned int order = swl::RotationOrder::genOrder(false, swl::MathConstant::AXIS_Z, swl::MathConstant::AXIS_Y, swl::MathConstant::AXIS_X);
+	std::vector<double> alpha, beta, gamma;
+	generateAngles(count, alpha, beta, gamma);
+
+	Arrays<9> mats(count);
+	Arrays<4> quats(count), products(count), units(count);
+	swl::RotationArray::rotate(order, count, &alpha[0], &beta[0], &gamma[0], mats.ptr);
+	swl::RotationArray::toQuaternion(count, mats.ptr, quats.ptr);
+	swl::RotationArray::multiply(count, quats.ptr, quats.ptr, products.ptr);
+	swl::RotationArray::normalize(count, products.ptr, units.ptr);
+
+	double entry[9];
+	for (std::size_t n = 0; n < count; ++n)
+	{
+		for (int i = 0; i < 9; ++i) entry[i] = mats.ptr[i][n];
+		const swl::Quaternion<double> expected(swl::Quaternion<double>::toQuaternion(swl::RMatrix3<double>(entry)));
+		const swl::Quaternion<double> product(expected * expected);
+		const double expectedQ[4] = { expected.q0(), expected.q1(), expected.q2(), expected.q3() };
+		const double productQ[4] = { product.q0(), product.q1(), product.q2(), product.q3() };
+		for (int i = 0; i < 4; ++i)
+			if (std::fabs(quats.ptr[i][n] - expectedQ[i]) > 1.0e-10 || std::fabs(products.ptr[i][n] - productQ[i]) > 1.0e-10 || std::fabs(units.ptr[i][n] - productQ[i]) > 1.0e-10)
+				return false;
+	}
+	return true;
+}
+
+bool checkSlerp()
+{
+	const std::size_t count = 50;
+	Arrays<4> q0(count), q1(count), quats(count);
+	std::vector<double> t(count);
+	for (std::size_t n = 0; n < count; ++n)
+	{
+		// rotations about the z-axis by 0 & 2 * theta.
+		const double theta = 0.02 * double(n);
+		q0.ptr[0][n] = 1.0;
+		q1.ptr[0][n] = std::cos(theta);
+		q1.ptr[3][n] = std::sin(theta);
+		t[n] = double(n % 11) / 10.0;
+	}
+	swl::RotationArray::slerp(count, &t[0], q0.ptr, q1.ptr, quats.ptr);
+
+	for (std::size_t n = 0; n < count; ++n)
+	{
+		const double theta = 0.02 * double(n) * t[n];
+		if (std::fabs(quats.ptr[0][n] - std::cos(theta)) > 1.0e-12 || std::fabs(quats.ptr[3][n] - std::sin(theta)) > 1.0e-12 ||
+			0.0 != quats.ptr[1][n] || 0.0 != quats.ptr[2][n])
+			return false;
+	}
+	return true;
+}
+
+bool checkSinCos()
+{
+	std::vector<double> angles;
+	for (int i = -2000; i <= 2000; ++i) angles.push_back(0.0137 * i);
+	angles.push_back(0.0);
+	angles.push_back(1.0e3);
+
+	const std::size_t count = angles.size();
+	std::vector<double> s(count), c(count);
+	swl::RotationArray::sincos(count, &angles[0], &s[0], &c[0]);
+	for (std::size_t n = 0; n < count; ++n)
+		if (std::fabs(s[n] - std::sin(angles[n])) > 1.0e-14 || std::fabs(c[n] - std::cos(angles[n])) > 1.0e-14)
+			return false;
+
+	// a large angle goes through the standard functions.
+	const double large = 1.0e10;
+	swl::RotationArray::sincos(1, &large, &s[0], &c[0]);
+	return std::sin(large) == s[0] && std::cos(large) == c[0];
+}
+
+bool checkOrders()
+{
+	const swl::MathConstant::AXIS axes[3] = { swl::MathConstant::AXIS_X, swl::MathConstant::AXIS_Y, swl::MathConstant::AXIS_Z };
+	for (int fixed = 0; fixed < 2; ++fixed)
+		for (int i = 0; i < 3; ++i)
+			for (int j = 0; j < 3; ++j)
+			{
+				if (i == j) continue;
+				for (int k = 0; k < 3; ++k)
+				{
+					if (j == k) continue;
+					const unsigned int order = swl::RotationOrder::genOrder(1 == fixed, axes[i], axes[j], axes[k]);
+					if (!checkRotate(order) || !checkCalc(order)) return false;
+				}
+			}
+	return true;
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct RotationTest
+{
+public:
+	void testOrders()
+	{
+		BOOST_CHECK(local::checkOrders());
+	}
+
+	void testQuaternion()
+	{
+		BOOST_CHECK(local::checkQuaternion());
+	}
+
+	void testSlerp()
+	{
+		BOOST_CHECK(local::checkSlerp());
+	}
+
+	void testSinCos()
+	{
+		BOOST_CHECK(local::checkSinCos());
+	}
+};
+
+struct RotationTestSuite: public boost::unit_test_framework::test_suite
+{
+	RotationTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.Math.Rotation")
+	{
+		boost::shared_ptr<RotationTest> test(new RotationTest());
+
+		add(BOOST_CLASS_TEST_CASE(&RotationTest::testOrders, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&RotationTest::testQuaternion, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&RotationTest::testSlerp, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&RotationTest::testSinCos, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class RotationTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(RotationTest, testOrders)
+{
+	EXPECT_TRUE(local::checkOrders());
+}
+
+TEST_F(RotationTest, testQuaternion)
+{
+	EXPECT_TRUE(local::checkQuaternion());
+}
+
+TEST_F(RotationTest, testSlerp)
+{
+	EXPECT_TRUE(local::checkSlerp());
+}
+
+TEST_F(RotationTest, testSinCos)
+{
+	EXPECT_TRUE(local::checkSinCos());
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct RotationTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(RotationTest);
+	CPPUNIT_TEST(testOrders);
+	CPPUNIT_TEST(testQuaternion);
+	CPPUNIT_TEST(testSlerp);
+	CPPUNIT_TEST(testSinCos);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testOrders()
+	{
+		CPPUNIT_ASSERT(local::checkOrders());
+	}
+
+	void testQuaternion()
+	{
+		CPPUNIT_ASSERT(local::checkQuaternion());
+	}
+
+	void testSlerp()
+	{
+		CPPUNIT_ASSERT(local::checkSlerp());
+	}
+
+	void testSinCos()
+	{
+		CPPUNIT_ASSERT(local::checkSinCos());
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::RotationTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.Math");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::RotationTest, "SWL.Math");
+#endif
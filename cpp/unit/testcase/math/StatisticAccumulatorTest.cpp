@@ -0,0 +1,271 @@
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/math/StatisticAccumulator.h"
+#include "swl/math/Statistic.h"
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+std::vector<double> generateSample(const std::size_t count, const double offset)
+{
+	// a skewed sample around a large offset, which makes the naive sums of powers lose precision.
+	std::vector<double> sample(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const double u = double((i * 7919) % 1009) / 1009.0;
+		sample[i] = offset + u * u * 10.0 - 3.0;
+	}
+	return sample;
+}
+
+bool isClose(const double lhs, const double rhs, const double tol)
+{
+	return std::fabs(lhs - rhs) <= tol * std::max(1.0, std::fabs(rhs));
+}
+
+bool isSameStatistic(const swl::StatisticAccumulator &acc, const std::vector<double> &sample, const double tol)
+{
+	const double mean = swl::Statistic::mean(sample);
+	const double sd = swl::Statistic::standardDeviation(sample, mean);
+	return sample.size() == acc.count() &&
+		isClose(acc.mean(), mean, tol) &&
+		isClose(acc.variance(), swl::Statistic::variance(sample, mean), tol) &&
+		isClose(acc.sampleVariance(), swl::Statistic::sampleVariance(sample, mean), tol) &&
+		isClose(acc.skewness(), swl::Statistic::skewness(sample, mean, sd), tol) &&
+		isClose(acc.kurtosis(), swl::Statistic::kurtosis(sample, mean, sd), tol) &&
+		isClose(acc.rms(mean), swl::Statistic::rms(sample, mean), tol) &&
+		isClose(acc.peak(), swl::Statistic::peak(sample), tol) &&
+		isClose(acc.crestFactor(0.0), swl::Statistic::crestFactor(sample, 0.0), tol);
+}
+
+bool checkMoments()
+{
+	const std::vector<double> sample(generateSample(1000, 1.0e6));
+	swl::StatisticAccumulator acc;
+	acc.add(sample);
+	return isSameStatistic(acc, sample, 1.0e-8);
+}
+
+bool checkMerge()
+{
+	const std::vector<double> sample(generateSample(1000, 5.0));
+
+	// uneven parts.
+	swl::StatisticAccumulator acc1, acc2, acc3;
+	acc1.add(&sample[0], 17);
+	acc2.add(&sample[17], 600);
+	acc3.add(&sample[617], sample.size() - 617);
+	acc1.merge(acc2);
+	acc1.merge(swl::StatisticAccumulator());
+	acc1.merge(acc3);
+	return isSameStatistic(acc1, sample, 1.0e-10);
+}
+
+bool checkSlidingWindow()
+{
+	const std::size_t windowSize = 64;
+	const std::vector<double> sample(generateSample(1000, 1.0e3));
+
+	swl::SlidingStatisticAccumulator sliding(windowSize);
+	for (std::size_t i = 0; i < sample.size(); ++i)
+	{
+		sliding.add(sample[i]);
+		if (i % 37 && i + 1 != sample.size()) continue;
+
+		const std::size_t first = i + 1 > windowSize ? i + 1 - windowSize : 0;
+		const std::vector<double> window(sample.begin() + first, sample.begin() + i + 1);
+		const swl::StatisticAccumulator acc(sliding.getStatistic());
+		if (!isSameStatistic(acc, window, 1.0e-7) ||
+			acc.minimum() != *std::min_element(window.begin(), window.end()) || acc.maximum() != *std::max_element(window.begin(), window.end()))
+			return false;
+	}
+	return sliding.isFull();
+}
+
+bool checkCovariance()
+{
+	const std::size_t dim = 3, count = 10000;
+	Eigen::MatrixXd D(dim, count);
+	for (std::size_t j = 0; j < count; ++j)
+	{
+		const double u = double((j * 7919) % 1009) / 1009.0, v = double((j * 104729) % 997) / 997.0;
+		D(0, j) = 100.0 + u;
+		D(1, j) = 2.0 * u - v;
+		D(2, j) = u * v;
+	}
+
+	const Eigen::MatrixXd centered(D.colwise() - D.rowwise().mean());
+	const Eigen::MatrixXd expected((centered * centered.adjoint()) / double(count - 1));
+
+	// a matrix, the parallel reduction & column by column.
+	swl::CovarianceAccumulator acc1(dim), acc3(dim);
+	acc1.add(D);
+	const swl::CovarianceAccumulator acc2(swl::CovarianceAccumulator::accumulate(D));
+	for (std::size_t j = 0; j < count; ++j)
+		acc3.add(Eigen::VectorXd(D.col(j)));
+
+	return (acc1.sampleCovarianceMatrix() - expected).cwiseAbs().maxCoeff() < 1.0e-12 &&
+		(acc2.sampleCovarianceMatrix() - expected).cwiseAbs().maxCoeff() < 1.0e-12 &&
+		(acc3.sampleCovarianceMatrix() - expected).cwiseAbs().maxCoeff() < 1.0e-12 &&
+		(swl::Statistic::sampleCovarianceMatrix(D) - expected).cwiseAbs().maxCoeff() < 1.0e-12 &&
+		(acc1.mean() - D.rowwise().mean()).cwiseAbs().maxCoeff() < 1.0e-12 &&
+		acc2.minimum() == D.rowwise().minCoeff() && acc3.maximum() == D.rowwise().maxCoeff();
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct StatisticAccumulatorTest
+{
+public:
+	void testMoments()
+	{
+		BOOST_CHECK(local::checkMoments());
+	}
+
+	void testMerge()
+	{
+		BOOST_CHECK(local::checkMerge());
+	}
+
+	void testSlidingWindow()
+	{
+		BOOST_CHECK(local::checkSlidingWindow());
+	}
+
+	void testCovariance()
+	{
+		BOOST_CHECK(local::checkCovariance());
+	}
+};
+
+struct StatisticAccumulatorTestSuite: public boost::unit_test_framework::test_suite
+{
+	StatisticAccumulatorTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.Math.StatisticAccumulator")
+	{
+		boost::shared_ptr<StatisticAccumulatorTest> test(new StatisticAccumulatorTest());
+
+		add(BOOST_CLASS_TEST_CASE(&StatisticAccumulatorTest::testMoments, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&StatisticAccumulatorTest::testMerge, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&StatisticAccumulatorTest::testSlidingWindow, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&StatisticAccumulatorTest::testCovariance, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class StatisticAccumulatorTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(StatisticAccumulatorTest, testMoments)
+{
+	EXPECT_TRUE(local::checkMoments());
+}
+
+TEST_F(StatisticAccumulatorTest, testMerge)
+{
+	EXPECT_TRUE(local::checkMerge());
+}
+
+TEST_F(StatisticAccumulatorTest, testSlidingWindow)
+{
+	EXPECT_TRUE(local::checkSlidingWindow());
+}
+
+TEST_F(StatisticAccumulatorTest, testCovariance)
+{
+	EXPECT_TRUE(local::checkCovariance());
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct StatisticAccumulatorTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(StatisticAccumulatorTest);
+	CPPUNIT_TEST(testMoments);
+	CPPUNIT_TEST(testMerge);
+	CPPUNIT_TEST(testSlidingWindow);
+	CPPUNIT_TEST(testCovariance);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testMoments()
+	{
+		CPPUNIT_ASSERT(local::checkMoments());
+	}
+
+	void testMerge()
+	{
+		CPPUNIT_ASSERT(local::checkMerge());
+	}
+
+	void testSlidingWindow()
+	{
+		CPPUNIT_ASSERT(local::checkSlidingWindow());
+	}
+
+	void testCovariance()
+	{
+		CPPUNIT_ASSERT(local::checkCovariance());
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::StatisticAccumulatorTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.Math");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::StatisticAccumulatorTest, "SWL.Math");
+#endif
@@ -0,0 +1,347 @@
+#define __USE_OPENCV 1
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/rnd_util/HistogramAccumulator.h"
+#include "swl/rnd_util/HistogramMatcher.h"
+#if defined(__USE_OPENCV)
+#define CV_NO_BACKWARD_COMPATIBILITY
+#include <opencv2/core/core.hpp>
+#endif
+#include <stdexcept>
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+#if defined(__USE_OPENCV)
+
+namespace {
+namespace local {
+
+const int binCount = 16;
+
+cv::MatND createHistogram()
+{
+	cv::MatND hist(binCount, 1, CV_32F);
+	for (int i = 0; i < binCount; ++i)
+		hist.at<float>(i, 0) = (float)(std::rand() % 1000) / 10.0f;
+	return hist;
+}
+
+// a peak of 3 bins centered at the given bin.
+cv::MatND createPeakHistogram(const int center)
+{
+	cv::MatND hist(cv::MatND::zeros(binCount, 1, CV_32F));
+	for (int i = std::max(center - 1, 0); i <= std::min(center + 1, binCount - 1); ++i)
+		hist.at<float>(i, 0) = i == center ? 10.0f : 5.0f;
+	return hist;
+}
+
+bool isEqual(const cv::Mat &lhs, const cv::Mat &rhs)
+{
+	if (lhs.rows != rhs.rows || lhs.cols != rhs.cols || lhs.type() != rhs.type()) return false;
+	for (int i = 0; i < lhs.rows; ++i)
+		for (int j = 0; j < lhs.cols; ++j)
+			if (lhs.at<float>(i, j) != rhs.at<float>(i, j)) return false;
+	return true;
+}
+
+// after every new histogram, the accumulated histogram is the weighted sum of the last histograms, weights[0] for the newest one.
+bool checkAccumulation(swl::HistogramAccumulator &accumulator, const std::vector<double> &weights)
+{
+	std::vector<cv::MatND> hists;
+	for (std::size_t n = 0; n < 5 * weights.size() + 3; ++n)
+	{
+		hists.push_back(createHistogram());
+		accumulator.addHistogram(hists.back());
+
+		const cv::MatND accumulated(accumulator.createAccumulatedHistogram());
+		if (binCount != accumulated.rows || 1 != accumulated.cols || CV_32F != accumulated.type()) return false;
+
+		const std::size_t count = std::min(hists.size(), weights.size());
+		if (count != accumulator.getHistogramSize()) return false;
+		for (int i = 0; i < binCount; ++i)
+		{
+			double expected = 0.0;
+			for (std::size_t age = 0; age < count; ++age)
+				expected += weights[age] * hists[hists.size() - 1 - age].at<float>(i, 0);
+			if (std::fabs(accumulated.at<float>(i, 0) - expected) > 1.0e-5 * (1.0 + std::fabs(expected))) return false;
+		}
+	}
+	return true;
+}
+
+bool checkAccumulatedHistogram()
+{
+	std::srand(7u);
+
+	{
+		swl::HistogramAccumulator accumulator(4);
+		if (swl::HistogramAccumulator::UNIFORM_WEIGHTING != accumulator.getWeightingMode()) return false;
+		if (!checkAccumulation(accumulator, std::vector<double>(4, 1.0))) return false;
+	}
+	{
+		swl::HistogramAccumulator accumulator(5, 0.8, 2.0);
+		std::vector<double> weights(5);
+		for (std::size_t i = 0; i < weights.size(); ++i)
+			weights[i] = 2.0 * std::pow(0.8, (double)i);
+		if (swl::HistogramAccumulator::EXPONENTIAL_WEIGHTING != accumulator.getWeightingMode()) return false;
+		if (!checkAccumulation(accumulator, weights)) return false;
+	}
+	{
+		// geometric weights are accumulated like exponential weights.
+		std::vector<float> weights(6);
+		for (std::size_t i = 0; i < weights.size(); ++i)
+			weights[i] = (float)std::exp(-2.0 * (double)i / (double)weights.size());
+		swl::HistogramAccumulator accumulator(weights);
+		if (swl::HistogramAccumulator::EXPONENTIAL_WEIGHTING != accumulator.getWeightingMode()) return false;
+		if (!checkAccumulation(accumulator, std::vector<double>(weights.begin(), weights.end()))) return false;
+	}
+	{
+		const float kernel[] = { 1.0f, 3.0f, 2.0f, 0.5f };
+		swl::HistogramAccumulator accumulator(std::vector<float>(kernel, kernel + 4));
+		if (swl::HistogramAccumulator::KERNEL_WEIGHTING != accumulator.getWeightingMode()) return false;
+		if (!checkAccumulation(accumulator, std::vector<double>(kernel, kernel + 4))) return false;
+	}
+
+	return true;
+}
+
+// the accumulator keeps its own copies of the histograms.
+bool checkHistogramCopy()
+{
+	swl::HistogramAccumulator accumulator(3);
+	cv::MatND hist(createHistogram());
+	const cv::MatND original(hist.clone());
+	accumulator.addHistogram(hist);
+	hist.setTo(cv::Scalar::all(0));
+
+	return isEqual(accumulator.createAccumulatedHistogram(), original) && isEqual(accumulator.createTemporalHistogram(), original);
+}
+
+bool checkTemporalHistogram()
+{
+	std::srand(11u);
+	swl::HistogramAccumulator accumulator(3);
+	std::vector<cv::MatND> hists;
+	for (std::size_t n = 0; n < 7; ++n)
+	{
+		hists.push_back(createHistogram());
+		accumulator.addHistogram(hists.back());
+
+		// the oldest histogram is in the first column.
+		const cv::MatND temporal(accumulator.createTemporalHistogram());
+		const std::size_t count = std::min(hists.size(), (std::size_t)3);
+		if (binCount != temporal.rows || (int)count != temporal.cols) return false;
+		for (std::size_t k = 0; k < count; ++k)
+			if (!isEqual(temporal.col((int)k), hists[hists.size() - count + k])) return false;
+	}
+
+	accumulator.clearAllHistograms();
+	return 0 == accumulator.getHistogramSize() && accumulator.createTemporalHistogram().empty();
+}
+
+// each histogram is replaced by its closest reference, or by zeros if the reference isn't close enough.
+bool checkTemporalHistogramWithReferences()
+{
+	std::vector<cv::MatND> refs;
+	for (int r = 0; r < 4; ++r)
+		refs.push_back(createPeakHistogram(4 * r));
+
+	// a histogram which overlaps none of the references.
+	const cv::MatND far(createPeakHistogram(binCount - 1));
+
+	const cv::MatND inputs[] = { refs[2], far, refs[0], refs[3] };
+	const int expectedRefs[] = { -1, 0, 3 };  // for the last 3 inputs.
+
+	const swl::PackedHistogramMatcher::Metric metrics[] = { swl::PackedHistogramMatcher::BHATTACHARYYA, swl::PackedHistogramMatcher::CORRELATION };
+	const double thresholds[] = { 0.1, 0.9 };
+	for (std::size_t m = 0; m < 2; ++m)
+	{
+		const swl::PackedHistogramMatcher matcher(refs, metrics[m]);
+		swl::HistogramAccumulator accumulator(3);
+		for (std::size_t n = 0; n < 4; ++n)
+			accumulator.addHistogram(inputs[n]);
+
+		const cv::MatND temporal(accumulator.createTemporalHistogram(refs, matcher, thresholds[m]));
+		if (binCount != temporal.rows || 3 != temporal.cols) return false;
+		for (int k = 0; k < 3; ++k)
+		{
+			cv::MatND expected(cv::MatND::zeros(binCount, 1, CV_32F));
+			if (expectedRefs[k] >= 0) expected = refs[expectedRefs[k]];
+			if (!isEqual(temporal.col(k), expected)) return false;
+		}
+	}
+
+	// the matcher has to be packed from the references.
+	try
+	{
+		const std::vector<cv::MatND> otherRefs(refs.begin(), refs.begin() + 2);
+		const swl::PackedHistogramMatcher matcher(otherRefs);
+		swl::HistogramAccumulator accumulator(3);
+		accumulator.addHistogram(refs[0]);
+		accumulator.createTemporalHistogram(refs, matcher, 0.1);
+		return false;
+	}
+	catch (const std::runtime_error &)
+	{
+	}
+
+	return true;
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct HistogramAccumulatorTest
+{
+public:
+	void testAccumulatedHistogram()
+	{
+		BOOST_CHECK(local::checkAccumulatedHistogram());
+	}
+
+	void testHistogramCopy()
+	{
+		BOOST_CHECK(local::checkHistogramCopy());
+	}
+
+	void testTemporalHistogram()
+	{
+		BOOST_CHECK(local::checkTemporalHistogram());
+	}
+
+	void testTemporalHistogramWithReferences()
+	{
+		BOOST_CHECK(local::checkTemporalHistogramWithReferences());
+	}
+};
+
+struct HistogramAccumulatorTestSuite: public boost::unit_test_framework::test_suite
+{
+	HistogramAccumulatorTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.RndUtil.HistogramAccumulator")
+	{
+		boost::shared_ptr<HistogramAccumulatorTest> test(new HistogramAccumulatorTest());
+
+		add(BOOST_CLASS_TEST_CASE(&HistogramAccumulatorTest::testAccumulatedHistogram, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&HistogramAccumulatorTest::testHistogramCopy, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&HistogramAccumulatorTest::testTemporalHistogram, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&HistogramAccumulatorTest::testTemporalHistogramWithReferences, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class HistogramAccumulatorTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(HistogramAccumulatorTest, testAccumulatedHistogram)
+{
+	EXPECT_TRUE(local::checkAccumulatedHistogram());
+}
+
+TEST_F(HistogramAccumulatorTest, testHistogramCopy)
+{
+	EXPECT_TRUE(local::checkHistogramCopy());
+}
+
+TEST_F(HistogramAccumulatorTest, testTemporalHistogram)
+{
+	EXPECT_TRUE(local::checkTemporalHistogram());
+}
+
+TEST_F(HistogramAccumulatorTest, testTemporalHistogramWithReferences)
+{
+	EXPECT_TRUE(local::checkTemporalHistogramWithReferences());
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct HistogramAccumulatorTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(HistogramAccumulatorTest);
+	CPPUNIT_TEST(testAccumulatedHistogram);
+	CPPUNIT_TEST(testHistogramCopy);
+	CPPUNIT_TEST(testTemporalHistogram);
+	CPPUNIT_TEST(testTemporalHistogramWithReferences);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testAccumulatedHistogram()
+	{
+		CPPUNIT_ASSERT(local::checkAccumulatedHistogram());
+	}
+
+	void testHistogramCopy()
+	{
+		CPPUNIT_ASSERT(local::checkHistogramCopy());
+	}
+
+	void testTemporalHistogram()
+	{
+		CPPUNIT_ASSERT(local::checkTemporalHistogram());
+	}
+
+	void testTemporalHistogramWithReferences()
+	{
+		CPPUNIT_ASSERT(local::checkTemporalHistogramWithReferences());
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::HistogramAccumulatorTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.RndUtil");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::HistogramAccumulatorTest, "SWL.RndUtil");
+#endif
+
+#endif  // __USE_OPENCV
@@ -0,0 +1,249 @@
+#define __USE_OPENCV 1
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/rnd_util/HistogramMatcher.h"
+#if defined(__USE_OPENCV)
+#define CV_NO_BACKWARD_COMPATIBILITY
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+#endif
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+#if defined(__USE_OPENCV)
+
+namespace {
+namespace local {
+
+typedef swl::PackedHistogramMatcher matcher_type;
+
+const int binCount = 32;
+const matcher_type::Metric metrics[] = { matcher_type::CORRELATION, matcher_type::CHI_SQUARE, matcher_type::INTERSECTION, matcher_type::BHATTACHARYYA };
+const int compareMethods[] = { CV_COMP_CORREL, CV_COMP_CHISQR, CV_COMP_INTERSECT, CV_COMP_BHATTACHARYYA };
+
+// a (bins x 1) histogram like the ones cv::calcHist creates, with about a quarter of the bins empty.
+cv::MatND createHistogram()
+{
+	cv::MatND hist(binCount, 1, CV_32F);
+	for (int i = 0; i < binCount; ++i)
+		hist.at<float>(i, 0) = std::rand() % 4 ? (float)(std::rand() % 1000) / 10.0f : 0.0f;
+	return hist;
+}
+
+void createHistograms(const std::size_t count, std::vector<cv::MatND> &hists)
+{
+	hists.clear();
+	for (std::size_t i = 0; i < count; ++i)
+		hists.push_back(createHistogram());
+}
+
+bool isClose(const double score, const double expected)
+{
+	return std::fabs(score - expected) <= 1.0e-6 * (1.0 + std::fabs(expected));
+}
+
+// the scores of a single query & of a batch of queries are the same as cv::compareHist(query, reference, metric).
+bool checkScores()
+{
+	std::srand(17u);
+	std::vector<cv::MatND> refs, queries;
+	createHistograms(7, refs);
+	createHistograms(5, queries);
+	// a query which is one of the references.
+	queries.push_back(refs[3].clone());
+
+	cv::Mat batch((int)queries.size(), binCount, CV_32F);
+	for (std::size_t i = 0; i < queries.size(); ++i)
+	{
+		cv::Mat row(batch.row((int)i));
+		queries[i].reshape(0, 1).copyTo(row);
+	}
+
+	for (std::size_t m = 0; m < 4; ++m)
+	{
+		const matcher_type matcher(refs, metrics[m]);
+		if (refs.size() != matcher.getReferenceCount() || (std::size_t)binCount != matcher.getBinCount()) return false;
+
+		cv::Mat batchScores;
+		matcher.computeScores(batch, batchScores);
+		if (batchScores.rows != (int)queries.size() || batchScores.cols != (int)refs.size() || CV_64F != batchScores.type()) return false;
+
+		std::vector<double> scores;
+		for (std::size_t i = 0; i < queries.size(); ++i)
+		{
+			matcher.computeScores(queries[i], scores);
+			if (refs.size() != scores.size()) return false;
+			for (std::size_t r = 0; r < refs.size(); ++r)
+			{
+				const double expected = cv::compareHist(queries[i], refs[r], compareMethods[m]);
+				if (!isClose(scores[r], expected) || !isClose(batchScores.at<double>((int)i, (int)r), expected)) return false;
+			}
+		}
+	}
+	return true;
+}
+
+// the best match & the k best matches agree with the scores of cv::compareHist.
+bool checkMatch()
+{
+	std::srand(31u);
+	std::vector<cv::MatND> refs, queries;
+	createHistograms(9, refs);
+	createHistograms(4, queries);
+
+	for (std::size_t m = 0; m < 4; ++m)
+	{
+		const matcher_type matcher(refs, metrics[m]);
+		const bool isSimilarity = matcher_type::isSimilarity(metrics[m]);
+		for (std::size_t i = 0; i < queries.size(); ++i)
+		{
+			std::vector<double> expected(refs.size());
+			for (std::size_t r = 0; r < refs.size(); ++r)
+				expected[r] = cv::compareHist(queries[i], refs[r], compareMethods[m]);
+			const double best = isSimilarity ? *std::max_element(expected.begin(), expected.end()) : *std::min_element(expected.begin(), expected.end());
+
+			double bestScore = 0.0;
+			const std::size_t matchedIdx = matcher.match(queries[i], bestScore);
+			if (matchedIdx >= refs.size() || !isClose(bestScore, best) || !isClose(expected[matchedIdx], best)) return false;
+
+			std::vector<std::size_t> matchedIndexes;
+			std::vector<double> scores;
+			matcher.match(queries[i], 3, matchedIndexes, scores);
+			if (3 != matchedIndexes.size() || 3 != scores.size() || matchedIdx != matchedIndexes[0]) return false;
+			for (std::size_t k = 0; k < 3; ++k)
+			{
+				if (!isClose(scores[k], expected[matchedIndexes[k]])) return false;
+				if (k > 0 && (isSimilarity ? scores[k] > scores[k - 1] : scores[k] < scores[k - 1])) return false;
+			}
+		}
+	}
+
+	// no reference.
+	const matcher_type emptyMatcher;
+	double bestScore = 0.0;
+	return emptyMatcher.empty() && (std::size_t)-1 == emptyMatcher.match(queries[0], bestScore);
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct HistogramMatcherTest
+{
+public:
+	void testScores()
+	{
+		BOOST_CHECK(local::checkScores());
+	}
+
+	void testMatch()
+	{
+		BOOST_CHECK(local::checkMatch());
+	}
+};
+
+struct HistogramMatcherTestSuite: public boost::unit_test_framework::test_suite
+{
+	HistogramMatcherTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.RndUtil.HistogramMatcher")
+	{
+		boost::shared_ptr<HistogramMatcherTest> test(new HistogramMatcherTest());
+
+		add(BOOST_CLASS_TEST_CASE(&HistogramMatcherTest::testScores, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&HistogramMatcherTest::testMatch, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class HistogramMatcherTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(HistogramMatcherTest, testScores)
+{
+	EXPECT_TRUE(local::checkScores());
+}
+
+TEST_F(HistogramMatcherTest, testMatch)
+{
+	EXPECT_TRUE(local::checkMatch());
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct HistogramMatcherTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(HistogramMatcherTest);
+	CPPUNIT_TEST(testScores);
+	CPPUNIT_TEST(testMatch);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testScores()
+	{
+		CPPUNIT_ASSERT(local::checkScores());
+	}
+
+	void testMatch()
+	{
+		CPPUNIT_ASSERT(local::checkMatch());
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::HistogramMatcherTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.RndUtil");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::HistogramMatcherTest, "SWL.RndUtil");
+#endif
+
+#endif  // __USE_OPENCV
@@ -0,0 +1,287 @@
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/rnd_util/SignalProcessing.h"
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+const double EPS = 1.0e-9;
+
+// Interleaved test signals, a different one for each channel.
+std::vector<double> makeSignal(const size_t numFrames, const size_t numChannels)
+{
+	std::vector<double> x(numFrames * numChannels);
+	for (size_t n = 0; n < numFrames; ++n)
+		for (size_t ch = 0; ch < numChannels; ++ch)
+			x[n * numChannels + ch] = std::sin(0.05 * double(n) * double(ch + 1)) + (0 == (n + ch) % 7 ? 0.5 : 0.0);
+	return x;
+}
+
+// The difference equation evaluated directly.
+std::vector<double> filterDirectly(const std::vector<double> &a, const std::vector<double> &b, const std::vector<double> &x, const size_t numChannels)
+{
+	std::vector<double> y(x.size(), 0.0);
+	const size_t numFrames = x.size() / numChannels;
+	for (size_t ch = 0; ch < numChannels; ++ch)
+		for (size_t n = 0; n < numFrames; ++n)
+		{
+			double sum = 0.0;
+			for (size_t i = 0; i < b.size() && i <= n; ++i)
+				sum += b[i] * x[(n - i) * numChannels + ch];
+			for (size_t i = 1; i < a.size() && i <= n; ++i)
+				sum -= a[i] * y[(n - i) * numChannels + ch];
+			y[n * numChannels + ch] = sum / a[0];
+		}
+	return y;
+}
+
+bool isEqual(const std::vector<double> &lhs, const std::vector<double> &rhs, const double eps)
+{
+	if (lhs.size() != rhs.size()) return false;
+	for (size_t i = 0; i < lhs.size(); ++i)
+		if (std::fabs(lhs[i] - rhs[i]) > eps) return false;
+	return true;
+}
+
+bool checkMatlabFilter()
+{
+	const double a_[] = { 2.0, -0.6, 0.2 }, b_[] = { 0.5, 0.3 };
+	const std::vector<double> a(a_, a_ + 3), b(b_, b_ + 2);
+	const std::vector<double> x(makeSignal(100, 1));
+
+	std::vector<double> y;
+	swl::SignalProcessing::filter(a, b, x, y);
+	return isEqual(y, filterDirectly(a, b, x, 1), EPS);
+}
+
+// Filtering block by block in place gives the same output as filtering at once.
+bool checkStreaming()
+{
+	const size_t numChannels = 5, numFrames = 200;
+	const double a_[] = { 1.0, -1.2, 0.5, -0.1 }, b_[] = { 0.2, 0.1, 0.05 };
+	const std::vector<double> a(a_, a_ + 4), b(b_, b_ + 3);
+	const std::vector<double> x(makeSignal(numFrames, numChannels));
+
+	swl::LinearFilter filter(a, b, numChannels);
+	std::vector<double> y(x);
+	const size_t blockSizes[] = { 1, 7, 64, 128 };
+	for (size_t n = 0, k = 0; n < numFrames; ++k)
+	{
+		const size_t count = std::min(blockSizes[k % 4], numFrames - n);
+		filter.process(&y[n * numChannels], &y[n * numChannels], count);
+		n += count;
+	}
+	if (!isEqual(y, filterDirectly(a, b, x, numChannels), EPS)) return false;
+
+	filter.reset();
+	std::vector<double> y2(x.size());
+	filter.process(&x[0], &y2[0], numFrames);
+	return isEqual(y2, y, EPS);
+}
+
+// (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2) x (c0 + c1 z^-1 + c2 z^-2) / (1 + d1 z^-1 + d2 z^-2).
+bool checkBiquadCascade()
+{
+	const size_t numChannels = 3, numFrames = 150;
+	const double sos_[] = {
+		0.2, 0.4, 0.2, 1.0, -0.5, 0.2,
+		2.0, -1.0, 0.5, 2.0, 0.6, 0.3,  // a0 = 2.
+	};
+	const std::vector<double> sos(sos_, sos_ + 12);
+	const double gain = 0.8;
+
+	const double b_[] = { gain * 0.2 * 1.0, gain * (0.2 * -0.5 + 0.4 * 1.0), gain * (0.2 * 0.25 + 0.4 * -0.5 + 0.2 * 1.0), gain * (0.4 * 0.25 + 0.2 * -0.5), gain * 0.2 * 0.25 };
+	const double a_[] = { 1.0, -0.5 + 0.3, 0.2 + -0.5 * 0.3 + 0.15, 0.2 * 0.3 + -0.5 * 0.15, 0.2 * 0.15 };
+	const std::vector<double> a(a_, a_ + 5), b(b_, b_ + 5);
+
+	const std::vector<double> x(makeSignal(numFrames, numChannels));
+	swl::BiquadCascade cascade(sos, numChannels, gain);
+	std::vector<double> y(x.size());
+	cascade.process(&x[0], &y[0], 100);
+	cascade.process(&x[100 * numChannels], &y[100 * numChannels], numFrames - 100);
+	return 2 == cascade.getNumberOfSections() && isEqual(y, filterDirectly(a, b, x, numChannels), 1.0e-8);
+}
+
+bool checkOverlapSave()
+{
+	const size_t numChannels = 3, numFrames = 1000;
+	std::vector<double> b(61);
+	for (size_t i = 0; i < b.size(); ++i)
+		b[i] = std::exp(-0.05 * double(i)) * std::cos(0.3 * double(i));
+	const std::vector<double> a(1, 1.0);
+	const std::vector<double> x(makeSignal(numFrames, numChannels));
+	const std::vector<double> expected(filterDirectly(a, b, x, numChannels));
+
+	// Whole blocks & partial blocks.
+	swl::OverlapSaveFilter filter(b, numChannels, 128);
+	if (128 - 60 != filter.getBlockSize()) return false;
+	std::vector<double> y(x);
+	const size_t counts[] = { 68, 5, 300, 627 };
+	for (size_t n = 0, k = 0; k < 4; n += counts[k++])
+		filter.process(&y[n * numChannels], &y[n * numChannels], counts[k]);
+	if (!isEqual(y, expected, 1.0e-9)) return false;
+
+	// The default FFT size.
+	swl::OverlapSaveFilter filter2(b, numChannels);
+	std::vector<double> y2(x.size());
+	filter2.process(&x[0], &y2[0], numFrames);
+	return isEqual(y2, expected, 1.0e-9);
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct SignalProcessingTest
+{
+public:
+	void testMatlabFilter()
+	{
+		BOOST_CHECK(local::checkMatlabFilter());
+	}
+
+	void testStreaming()
+	{
+		BOOST_CHECK(local::checkStreaming());
+	}
+
+	void testBiquadCascade()
+	{
+		BOOST_CHECK(local::checkBiquadCascade());
+	}
+
+	void testOverlapSave()
+	{
+		BOOST_CHECK(local::checkOverlapSave());
+	}
+};
+
+struct SignalProcessingTestSuite: public boost::unit_test_framework::test_suite
+{
+	SignalProcessingTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.RndUtil.SignalProcessing")
+	{
+		boost::shared_ptr<SignalProcessingTest> test(new SignalProcessingTest());
+
+		add(BOOST_CLASS_TEST_CASE(&SignalProcessingTest::testMatlabFilter, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&SignalProcessingTest::testStreaming, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&SignalProcessingTest::testBiquadCascade, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&SignalProcessingTest::testOverlapSave, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class SignalProcessingTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(SignalProcessingTest, testMatlabFilter)
+{
+	EXPECT_TRUE(local::checkMatlabFilter());
+}
+
+TEST_F(SignalProcessingTest, testStreaming)
+{
+	EXPECT_TRUE(local::checkStreaming());
+}
+
+TEST_F(SignalProcessingTest, testBiquadCascade)
+{
+	EXPECT_TRUE(local::checkBiquadCascade());
+}
+
+TEST_F(SignalProcessingTest, testOverlapSave)
+{
+	EXPECT_TRUE(local::checkOverlapSave());
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct SignalProcessingTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(SignalProcessingTest);
+	CPPUNIT_TEST(testMatlabFilter);
+	CPPUNIT_TEST(testStreaming);
+	CPPUNIT_TEST(testBiquadCascade);
+	CPPUNIT_TEST(testOverlapSave);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testMatlabFilter()
+	{
+		CPPUNIT_ASSERT(local::checkMatlabFilter());
+	}
+
+	void testStreaming()
+	{
+		CPPUNIT_ASSERT(local::checkStreaming());
+	}
+
+	void testBiquadCascade()
+	{
+		CPPUNIT_ASSERT(local::checkBiquadCascade());
+	}
+
+	void testOverlapSave()
+	{
+		CPPUNIT_ASSERT(local::checkOverlapSave());
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::SignalProcessingTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.RndUtil");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::SignalProcessingTest, "SWL.RndUtil");
+#endif
@@ -38,8 +38,13 @@ void EchoTcpSocketConnection::doCompleteSending(boost::system::error_code ec)
 	if (!ec)
 	{
 		// TODO [add] >> do something here to process sending message
+		// the sent message is still at the front of the send buffer.
+		const GuardedByteBuffer::value_type *segments[2];
+		std::size_t lengths[2];
+		sendBuffer_.getReadableSegments(segments, lengths, sentMsgLength_);
 		std::cout << "\tsend>>>>> ";
-		std::cout.write((char *)sendMsg_.data(), (std::streamsize)sentMsgLength_);
+		std::cout.write((char *)segments[0], (std::streamsize)lengths[0]);
+		std::cout.write((char *)segments[1], (std::streamsize)lengths[1]);
 		std::cout << std::endl;
 
 		sendBuffer_.pop(sentMsgLength_);
@@ -64,12 +69,21 @@ void EchoTcpSocketConnection::doCompleteReceiving(boost::system::error_code ec,
 	if (!ec)
 	{
 		// TODO [add] >> do something here to process received message
-		std::cout << "\treceive<<<<< ";
-		std::cout.write((char *)receiveMsg_.data(), (std::streamsize)bytesTransferred);
-		std::cout << std::endl;
-
-		//receiveBuffer_.push(receiveMsg_.data(), bytesTransferred);
-		sendBuffer_.push(receiveMsg_.data(), bytesTransferred);
+		// the message has been read directly into the receive buffer.
+		if (receiveBuffer_.produce(bytesTransferred))
+		{
+			const GuardedByteBuffer::value_type *segments[2];
+			std::size_t lengths[2];
+			receiveBuffer_.getReadableSegments(segments, lengths, bytesTransferred);
+			std::cout << "\treceive<<<<< ";
+			std::cout.write((char *)segments[0], (std::streamsize)lengths[0]);
+			std::cout.write((char *)segments[1], (std::streamsize)lengths[1]);
+			std::cout << std::endl;
+
+			sendBuffer_.push(segments[0], lengths[0]);
+			sendBuffer_.push(segments[1], lengths[1]);
+			receiveBuffer_.pop(bytesTransferred);
+		}
 	}
 
 	// the third party library successfully performed a read on the socket.
@@ -31,13 +31,16 @@ void EchoTcpSocketSession::send(boost::system::error_code &ec)
 		state_ = RECEIVING;
 	else
 	{
-		const std::size_t len = std::min(sendBuffer_.getSize(), MAX_SEND_LENGTH_);
-		sendBuffer_.top(sendMsg_.c_array(), len);
-		if (const std::size_t sentLen = socket_.write_some(boost::asio::buffer(sendMsg_, len), ec))
+		if (const std::size_t sentLen = writeSendBuffer(ec))
 		{
 			// TODO [add] >> do something here to process sending message
+			// the sent message is still at the front of the send buffer.
+			const GuardedByteBuffer::value_type *segments[2];
+			std::size_t lengths[2];
+			sendBuffer_.getReadableSegments(segments, lengths, sentLen);
 			std::cout << "\tsend>>>>> ";
-			std::cout.write((char *)sendMsg_.data(), (std::streamsize)sentLen);
+			std::cout.write((char *)segments[0], (std::streamsize)lengths[0]);
+			std::cout.write((char *)segments[1], (std::streamsize)lengths[1]);
 			std::cout << std::endl;
 
 			sendBuffer_.pop(sentLen);
@@ -48,15 +51,21 @@ void EchoTcpSocketSession::send(boost::system::error_code &ec)
 
 void EchoTcpSocketSession::receive(boost::system::error_code &ec)
 {
-	if (const std::size_t len = socket_.read_some(boost::asio::buffer(receiveMsg_), ec))
+	if (const std::size_t len = readReceiveBuffer(ec))
 	{
 		// TODO [add] >> do something here to process received message
+		// the message has been read directly into the receive buffer.
+		const GuardedByteBuffer::value_type *segments[2];
+		std::size_t lengths[2];
+		receiveBuffer_.getReadableSegments(segments, lengths, len);
 		std::cout << "\treceive<<<<< ";
-		std::cout.write((char *)receiveMsg_.data(), (std::streamsize)len);
+		std::cout.write((char *)segments[0], (std::streamsize)lengths[0]);
+		std::cout.write((char *)segments[1], (std::streamsize)lengths[1]);
 		std::cout << std::endl;
 
-		//receiveBuffer_.push(receiveMsg_.data(), len);
-		sendBuffer_.push(receiveMsg_.data(), len);
+		sendBuffer_.push(segments[0], lengths[0]);
+		sendBuffer_.push(segments[1], lengths[1]);
+		receiveBuffer_.pop(len);
 		state_ = sendBuffer_.isEmpty() ? RECEIVING : SENDING;
 	}
 }
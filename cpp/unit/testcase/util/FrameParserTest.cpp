@@ -0,0 +1,323 @@
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/util/FrameParser.h"
+#include "swl/util/GuardedBuffer.h"
+#include "swl/util/LockFreeRingBuffer.h"
+#include <vector>
+#include <cstring>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+// frame := 0xAA 0x55 [payload length (2, big-endian)] [payload] [CRC-16/CCITT over the length & the payload]
+swl::FrameFormat makeFormat()
+{
+	const unsigned char sync[] = { 0xAA, 0x55 };
+	swl::FrameFormat format;
+	format.setSyncBytes(sync, 2);
+	format.headerLength = 4;
+	format.lengthOffset = 2;
+	format.lengthSize = 2;
+	format.lengthAdjustment = 4 + 2;
+	format.maxFrameLength = 64;
+	format.checksumType = swl::FrameFormat::CRC16_CCITT_CHECKSUM;
+	format.checksumOffset = 2;
+	format.isLittleEndian = false;
+	return format;
+}
+
+unsigned short crc16(const unsigned char *data, const std::size_t len)
+{
+	unsigned int crc = 0xFFFF;
+	for (std::size_t i = 0; i < len; ++i)
+	{
+		crc ^= (unsigned int)data[i] << 8;
+		for (int k = 0; k < 8; ++k)
+			crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+	}
+	return (unsigned short)(crc & 0xFFFF);
+}
+
+std::vector<unsigned char> makeFrame(const std::size_t payloadLength, const unsigned char seed)
+{
+	std::vector<unsigned char> frame;
+	frame.push_back(0xAA);
+	frame.push_back(0x55);
+	frame.push_back((unsigned char)(payloadLength >> 8));
+	frame.push_back((unsigned char)payloadLength);
+	for (std::size_t i = 0; i < payloadLength; ++i)
+		frame.push_back((unsigned char)(seed + i));
+	const unsigned short crc = crc16(&frame[2], frame.size() - 2);
+	frame.push_back((unsigned char)(crc >> 8));
+	frame.push_back((unsigned char)crc);
+	return frame;
+}
+
+struct FrameCollector: public swl::IFrameHandler
+{
+public:
+	/*virtual*/ void handleFrame(const swl::FrameView &frame)
+	{
+		std::vector<unsigned char> data(frame.getSize());
+		frame.copy(&data[0], 0, data.size());
+		frames.push_back(data);
+	}
+
+public:
+	std::vector<std::vector<unsigned char> > frames;
+};
+
+template<class Buffer>
+void push(Buffer &buffer, const std::vector<unsigned char> &data)
+{
+	if (!data.empty()) buffer.push(&data[0], data.size());
+}
+
+// the frames arrive one byte at a time.
+template<class Buffer>
+bool checkIncrementalParsing(Buffer &buffer)
+{
+	swl::FrameParser parser(makeFormat());
+	FrameCollector collector;
+
+	std::vector<unsigned char> stream;
+	for (int k = 0; k < 5; ++k)
+	{
+		const std::vector<unsigned char> frame(makeFrame(3 + k, (unsigned char)(k * 10)));
+		stream.insert(stream.end(), frame.begin(), frame.end());
+	}
+
+	std::size_t frameCount = 0;
+	for (std::size_t i = 0; i < stream.size(); ++i)
+	{
+		buffer.push(stream[i]);
+		frameCount += parser.parse(buffer, collector);
+	}
+
+	if (5 != frameCount || 5 != collector.frames.size() || !buffer.isEmpty()) return false;
+	for (int k = 0; k < 5; ++k)
+		if (collector.frames[k] != makeFrame(3 + k, (unsigned char)(k * 10))) return false;
+	return 0 == parser.getDiscardedByteCount() && 0 == parser.getErrorCount();
+}
+
+// garbage, a false sync, a broken frame & an over-long length are skipped.
+template<class Buffer>
+bool checkResynchronization(Buffer &buffer)
+{
+	swl::FrameParser parser(makeFormat());
+	FrameCollector collector;
+
+	const unsigned char garbage[] = { 0x01, 0xAA, 0x02, 0x03 };
+	buffer.push(garbage, sizeof(garbage));
+	std::vector<unsigned char> broken(makeFrame(4, 1));
+	broken[5] ^= 0xFF;
+	push(buffer, broken);
+	const unsigned char overLong[] = { 0xAA, 0x55, 0x7F, 0xFF };
+	buffer.push(overLong, sizeof(overLong));
+	push(buffer, makeFrame(2, 7));
+
+	if (1 != parser.parse(buffer, collector) || 1 != collector.frames.size()) return false;
+	if (collector.frames[0] != makeFrame(2, 7) || !buffer.isEmpty()) return false;
+	return 2 == parser.getErrorCount() && sizeof(garbage) + broken.size() + sizeof(overLong) == parser.getDiscardedByteCount();
+}
+
+// a frame wrapping around the end of a ring buffer is handed over in two segments.
+bool checkWrappedFrame()
+{
+	swl::SpscByteBuffer buffer(16);
+	const std::vector<unsigned char> filler(10, 0);
+	push(buffer, filler);
+	buffer.pop(10);
+
+	swl::FrameParser parser(makeFormat());
+	FrameCollector collector;
+	const std::vector<unsigned char> frame(makeFrame(5, 3));
+	push(buffer, frame);
+	return 1 == parser.parse(buffer, collector) && frame == collector.frames[0];
+}
+
+bool checkDispatcher()
+{
+	FrameCollector collector;
+	const swl::FramedPacketDispatcher dispatcher(makeFormat(), collector);
+
+	swl::GuardedByteBuffer buffer;
+	const std::vector<unsigned char> frame(makeFrame(6, 0));
+	buffer.push(&frame[0], 5);
+	if (dispatcher.dispatch(buffer)) return false;
+	buffer.push(&frame[5], frame.size() - 5);
+	return dispatcher.dispatch(buffer) && 1 == collector.frames.size() && frame == collector.frames[0];
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct FrameParserTest
+{
+public:
+	void testIncrementalParsing()
+	{
+		swl::GuardedBuffer<unsigned char> guardedBuffer;
+		BOOST_CHECK(local::checkIncrementalParsing(guardedBuffer));
+		swl::SpscByteBuffer ringBuffer(64);
+		BOOST_CHECK(local::checkIncrementalParsing(ringBuffer));
+	}
+
+	void testResynchronization()
+	{
+		swl::GuardedBuffer<unsigned char> guardedBuffer;
+		BOOST_CHECK(local::checkResynchronization(guardedBuffer));
+		swl::SpscByteBuffer ringBuffer(64);
+		BOOST_CHECK(local::checkResynchronization(ringBuffer));
+	}
+
+	void testWrappedFrame()
+	{
+		BOOST_CHECK(local::checkWrappedFrame());
+	}
+
+	void testDispatcher()
+	{
+		BOOST_CHECK(local::checkDispatcher());
+	}
+};
+
+struct FrameParserTestSuite: public boost::unit_test_framework::test_suite
+{
+	FrameParserTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.Util.FrameParser")
+	{
+		boost::shared_ptr<FrameParserTest> test(new FrameParserTest());
+
+		add(BOOST_CLASS_TEST_CASE(&FrameParserTest::testIncrementalParsing, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&FrameParserTest::testResynchronization, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&FrameParserTest::testWrappedFrame, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&FrameParserTest::testDispatcher, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class FrameParserTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(FrameParserTest, testIncrementalParsing)
+{
+	swl::GuardedBuffer<unsigned char> guardedBuffer;
+	EXPECT_TRUE(local::checkIncrementalParsing(guardedBuffer));
+	swl::SpscByteBuffer ringBuffer(64);
+	EXPECT_TRUE(local::checkIncrementalParsing(ringBuffer));
+}
+
+TEST_F(FrameParserTest, testResynchronization)
+{
+	swl::GuardedBuffer<unsigned char> guardedBuffer;
+	EXPECT_TRUE(local::checkResynchronization(guardedBuffer));
+	swl::SpscByteBuffer ringBuffer(64);
+	EXPECT_TRUE(local::checkResynchronization(ringBuffer));
+}
+
+TEST_F(FrameParserTest, testWrappedFrame)
+{
+	EXPECT_TRUE(local::checkWrappedFrame());
+}
+
+TEST_F(FrameParserTest, testDispatcher)
+{
+	EXPECT_TRUE(local::checkDispatcher());
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct FrameParserTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(FrameParserTest);
+	CPPUNIT_TEST(testIncrementalParsing);
+	CPPUNIT_TEST(testResynchronization);
+	CPPUNIT_TEST(testWrappedFrame);
+	CPPUNIT_TEST(testDispatcher);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testIncrementalParsing()
+	{
+		swl::GuardedBuffer<unsigned char> guardedBuffer;
+		CPPUNIT_ASSERT(local::checkIncrementalParsing(guardedBuffer));
+		swl::SpscByteBuffer ringBuffer(64);
+		CPPUNIT_ASSERT(local::checkIncrementalParsing(ringBuffer));
+	}
+
+	void testResynchronization()
+	{
+		swl::GuardedBuffer<unsigned char> guardedBuffer;
+		CPPUNIT_ASSERT(local::checkResynchronization(guardedBuffer));
+		swl::SpscByteBuffer ringBuffer(64);
+		CPPUNIT_ASSERT(local::checkResynchronization(ringBuffer));
+	}
+
+	void testWrappedFrame()
+	{
+		CPPUNIT_ASSERT(local::checkWrappedFrame());
+	}
+
+	void testDispatcher()
+	{
+		CPPUNIT_ASSERT(local::checkDispatcher());
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::FrameParserTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.Util");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::FrameParserTest, "SWL.Util");
+#endif
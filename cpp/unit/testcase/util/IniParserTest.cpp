@@ -0,0 +1,258 @@
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/util/IniParser.h"
+#include <boost/scoped_ptr.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+#if defined(_UNICODE) || defined(UNICODE)
+#define SWL_INI_TEXT(str) L##str
+#else
+#define SWL_INI_TEXT(str) str
+#endif
+
+typedef swl::IniSnapshot::string_type string_type;
+
+const char *INI_FILE_NAME = "swl_ini_parser_test.ini";
+
+bool writeIniFile(const char *contents)
+{
+	FILE *fp = std::fopen(INI_FILE_NAME, "w");
+	if (!fp) return false;
+	std::fputs(contents, fp);
+	std::fclose(fp);
+	return true;
+}
+
+swl::IniParser * loadIniFile(const char *contents)
+{
+	if (!writeIniFile(contents)) return NULL;
+	swl::IniParser *parser = new swl::IniParser(SWL_INI_TEXT("swl_ini_parser_test.ini"));
+	std::remove(INI_FILE_NAME);
+	return parser;
+}
+
+bool checkManyKeys()
+{
+	boost::scoped_ptr<swl::IniParser> parser(loadIniFile("[section]\n"));
+	if (!parser) return false;
+
+	const int count = 5000;
+	char key[32], val[32];
+	for (int i = 0; i < count; ++i)
+	{
+		std::sprintf(key, "section:key%d", i);
+		std::sprintf(val, "%d", i);
+#if defined(_UNICODE) || defined(UNICODE)
+		parser->setStr(std::wstring(key, key + std::strlen(key)), std::wstring(val, val + std::strlen(val)));
+#else
+		parser->setStr(key, val);
+#endif
+	}
+	for (int i = 0; i < count; i += 2)
+	{
+		std::sprintf(key, "section:key%d", i);
+#if defined(_UNICODE) || defined(UNICODE)
+		parser->unset(std::wstring(key, key + std::strlen(key)));
+#else
+		parser->unset(key);
+#endif
+	}
+
+	for (int i = 0; i < count; ++i)
+	{
+		std::sprintf(key, "section:key%d", i);
+#if defined(_UNICODE) || defined(UNICODE)
+		const int value = parser->getInt(std::wstring(key, key + std::strlen(key)), -1);
+#else
+		const int value = parser->getInt(key, -1);
+#endif
+		if (value != (i % 2 ? i : -1)) return false;
+	}
+	return true;
+}
+
+bool checkSnapshot()
+{
+	boost::scoped_ptr<swl::IniParser> parser(loadIniFile(
+		"[Server]\n"
+		"Port = 0x1F90\n"
+		"Ratio = 0.25\n"
+		"Verbose = yes\n"
+		"Name = alpha\n"
+		"[Client]\n"
+		"Port = 7000\n"
+	));
+	if (!parser) return false;
+
+	swl::IniSnapshot all;
+	parser->takeSnapshot(all);
+	if (5 != all.getSize() || 7000 != all.getInt(SWL_INI_TEXT("client:port"), 0)) return false;
+
+	swl::IniSnapshot server;
+	parser->takeSectionSnapshot(SWL_INI_TEXT("SERVER"), server);
+	if (4 != server.getSize() || server.contains(SWL_INI_TEXT("client:port"))) return false;
+	if (8080 != server.getInt(SWL_INI_TEXT("Port"), 0) || 0.25 != server.getDouble(SWL_INI_TEXT("ratio"), 0.0)) return false;
+	if (!server.getBool(SWL_INI_TEXT("verbose"), false) || !server.getBool(SWL_INI_TEXT("missing"), true)) return false;
+	return string_type(SWL_INI_TEXT("alpha")) == server.getString(SWL_INI_TEXT("name"), SWL_INI_TEXT(""));
+}
+
+bool checkDiff()
+{
+	boost::scoped_ptr<swl::IniParser> oldParser(loadIniFile("[s]\na = 1\nb = 2\nc = 3\n"));
+	boost::scoped_ptr<swl::IniParser> newParser(loadIniFile("[s]\na = 1\nb = 20\nd = 4\n"));
+	if (!oldParser || !newParser) return false;
+
+	swl::IniSnapshot oldSnapshot, newSnapshot;
+	oldParser->takeSectionSnapshot(SWL_INI_TEXT("s"), oldSnapshot);
+	newParser->takeSectionSnapshot(SWL_INI_TEXT("s"), newSnapshot);
+
+	std::vector<string_type> added, removed, changed;
+	if (oldSnapshot.diff(oldSnapshot, added, removed, changed)) return false;
+	if (!newSnapshot.diff(oldSnapshot, added, removed, changed)) return false;
+	return 1 == added.size() && SWL_INI_TEXT("d") == added[0] &&
+		1 == removed.size() && SWL_INI_TEXT("c") == removed[0] &&
+		1 == changed.size() && SWL_INI_TEXT("b") == changed[0];
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct IniParserTest
+{
+public:
+	void testManyKeys()
+	{
+		BOOST_CHECK(local::checkManyKeys());
+	}
+
+	void testSnapshot()
+	{
+		BOOST_CHECK(local::checkSnapshot());
+	}
+
+	void testDiff()
+	{
+		BOOST_CHECK(local::checkDiff());
+	}
+};
+
+struct IniParserTestSuite: public boost::unit_test_framework::test_suite
+{
+	IniParserTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.Util.IniParser")
+	{
+		boost::shared_ptr<IniParserTest> test(new IniParserTest());
+
+		add(BOOST_CLASS_TEST_CASE(&IniParserTest::testManyKeys, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&IniParserTest::testSnapshot, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&IniParserTest::testDiff, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class IniParserTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(IniParserTest, testManyKeys)
+{
+	EXPECT_TRUE(local::checkManyKeys());
+}
+
+TEST_F(IniParserTest, testSnapshot)
+{
+	EXPECT_TRUE(local::checkSnapshot());
+}
+
+TEST_F(IniParserTest, testDiff)
+{
+	EXPECT_TRUE(local::checkDiff());
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct IniParserTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(IniParserTest);
+	CPPUNIT_TEST(testManyKeys);
+	CPPUNIT_TEST(testSnapshot);
+	CPPUNIT_TEST(testDiff);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testManyKeys()
+	{
+		CPPUNIT_ASSERT(local::checkManyKeys());
+	}
+
+	void testSnapshot()
+	{
+		CPPUNIT_ASSERT(local::checkSnapshot());
+	}
+
+	void testDiff()
+	{
+		CPPUNIT_ASSERT(local::checkDiff());
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::IniParserTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.Util");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::IniParserTest, "SWL.Util");
+#endif
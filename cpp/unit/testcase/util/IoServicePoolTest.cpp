@@ -0,0 +1,210 @@
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/util/IoServicePool.h"
+#include "EchoTcpSocketConnection.h"
+#include <boost/thread/thread.hpp>
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/scoped_ptr.hpp>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+void countHandler(boost::atomic<std::size_t> *count)
+{
+	++*count;
+}
+
+void holdConnection(swl::EchoTcpSocketConnection::pointer /*connection*/)
+{
+}
+
+bool checkSelection()
+{
+	swl::IoServicePool roundRobinPool(3, swl::IoServicePool::ROUND_ROBIN);
+	if (3 != roundRobinPool.getSize()) return false;
+	for (std::size_t i = 0; i < 7; ++i)
+		if (i % 3 != roundRobinPool.selectIoService()) return false;
+
+	swl::IoServicePool leastLoadedPool(3, swl::IoServicePool::LEAST_LOADED);
+	leastLoadedPool.getStatistics(0).connectionCount = 2;
+	leastLoadedPool.getStatistics(1).connectionCount = 1;
+	leastLoadedPool.getStatistics(2).connectionCount = 3;
+	if (1 != leastLoadedPool.selectIoService()) return false;
+	leastLoadedPool.getStatistics(1).connectionCount = 2;
+	// ties are broken in the round-robin order.
+	const std::size_t first = leastLoadedPool.selectIoService();
+	const std::size_t second = leastLoadedPool.selectIoService();
+	return (0 == first || 1 == first) && (0 == second || 1 == second) && first != second;
+}
+
+bool checkRun()
+{
+	swl::IoServicePool pool(4);
+	boost::atomic<std::size_t> count(0);
+
+	pool.start();
+	for (std::size_t i = 0; i < 400; ++i)
+		pool.getIoService(i % pool.getSize()).post(boost::bind(&countHandler, &count));
+
+	// the I/O services keep running without any pending work.
+	for (int k = 0; k < 1000 && count < 400; ++k)
+		boost::this_thread::sleep(boost::posix_time::milliseconds(5));
+	pool.stop();
+	pool.join();
+	return 400 == count;
+}
+
+bool checkDestructionWithLiveConnection()
+{
+	boost::scoped_ptr<swl::IoServicePool> pool(new swl::IoServicePool(2));
+	{
+		const swl::EchoTcpSocketConnection::pointer connection(swl::EchoTcpSocketConnection::create(pool->getIoService(1)));
+		connection->setStatistics(&pool->getStatistics(1));
+		// the pending handler holds the last reference to the connection, since the pool isn't started.
+		pool->getIoService(1).post(boost::bind(&holdConnection, connection));
+	}
+	if (1 != pool->getStatistics(1).connectionCount) return false;
+
+	// the connection is destroyed with the I/O service & still has to find its statistics alive.
+	pool.reset();
+	return true;
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct IoServicePoolTest
+{
+public:
+	void testSelection()
+	{
+		BOOST_CHECK(local::checkSelection());
+	}
+
+	void testRun()
+	{
+		BOOST_CHECK(local::checkRun());
+	}
+
+	void testDestructionWithLiveConnection()
+	{
+		BOOST_CHECK(local::checkDestructionWithLiveConnection());
+	}
+};
+
+struct IoServicePoolTestSuite: public boost::unit_test_framework::test_suite
+{
+	IoServicePoolTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.Util.IoServicePool")
+	{
+		boost::shared_ptr<IoServicePoolTest> test(new IoServicePoolTest());
+
+		add(BOOST_CLASS_TEST_CASE(&IoServicePoolTest::testSelection, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&IoServicePoolTest::testRun, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&IoServicePoolTest::testDestructionWithLiveConnection, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class IoServicePoolTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(IoServicePoolTest, testSelection)
+{
+	EXPECT_TRUE(local::checkSelection());
+}
+
+TEST_F(IoServicePoolTest, testRun)
+{
+	EXPECT_TRUE(local::checkRun());
+}
+
+TEST_F(IoServicePoolTest, testDestructionWithLiveConnection)
+{
+	EXPECT_TRUE(local::checkDestructionWithLiveConnection());
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct IoServicePoolTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(IoServicePoolTest);
+	CPPUNIT_TEST(testSelection);
+	CPPUNIT_TEST(testRun);
+	CPPUNIT_TEST(testDestructionWithLiveConnection);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testSelection()
+	{
+		CPPUNIT_ASSERT(local::checkSelection());
+	}
+
+	void testRun()
+	{
+		CPPUNIT_ASSERT(local::checkRun());
+	}
+
+	void testDestructionWithLiveConnection()
+	{
+		CPPUNIT_ASSERT(local::checkDestructionWithLiveConnection());
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::IoServicePoolTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.Util");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::IoServicePoolTest, "SWL.Util");
+#endif
@@ -0,0 +1,364 @@
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/util/MappedWaveReader.h"
+#include "swl/util/WaveData.h"
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+const char *WAVE_FILE_NAME = "swl_mapped_wave_reader_test.wav";
+
+void putUInt(std::vector<unsigned char> &bytes, const unsigned long value, const int size)
+{
+	for (int i = 0; i < size; ++i)
+		bytes.push_back((unsigned char)(value >> (8 * i)));
+}
+
+void putTag(std::vector<unsigned char> &bytes, const char *tag)
+{
+	bytes.insert(bytes.end(), tag, tag + 4);
+}
+
+// The sample (frame, channel) is (frame * channels + channel) % 200 / 100 - 1, i.e. in [-1, 1).
+double getSample(const size_t frame, const size_t channel, const size_t channels)
+{
+	return double((frame * channels + channel) % 200) / 100.0 - 1.0;
+}
+
+bool writeWaveFile(const unsigned short formatTag, const unsigned short bitsPerSample, const unsigned short channels, const size_t frameCount, const bool hasListChunk)
+{
+	const unsigned short blockAlign = channels * (bitsPerSample / 8);
+
+	std::vector<unsigned char> data;
+	for (size_t frame = 0; frame < frameCount; ++frame)
+		for (unsigned short ch = 0; ch < channels; ++ch)
+		{
+			const double sample = getSample(frame, ch, channels);
+			if (3 == formatTag)
+			{
+				const float value = (float)sample;
+				unsigned char raw[4];
+				std::memcpy(raw, &value, 4);
+				data.insert(data.end(), raw, raw + 4);
+			}
+			else if (8 == bitsPerSample)
+				data.push_back((unsigned char)std::floor(sample * 128.0 + 128.0));
+			else
+				putUInt(data, (unsigned long)(long long)std::floor(sample * std::ldexp(1.0, bitsPerSample - 1)), bitsPerSample / 8);
+		}
+
+	std::vector<unsigned char> bytes;
+	putTag(bytes, "RIFF");
+	putUInt(bytes, 0, 4);
+	putTag(bytes, "WAVE");
+	putTag(bytes, "fmt ");
+	putUInt(bytes, 16, 4);
+	putUInt(bytes, formatTag, 2);
+	putUInt(bytes, channels, 2);
+	putUInt(bytes, 8000, 4);
+	putUInt(bytes, 8000 * blockAlign, 4);
+	putUInt(bytes, blockAlign, 2);
+	putUInt(bytes, bitsPerSample, 2);
+	if (hasListChunk)
+	{
+		// An odd-sized chunk is padded.
+		putTag(bytes, "LIST");
+		putUInt(bytes, 3, 4);
+		putTag(bytes, "abc");
+	}
+	putTag(bytes, "data");
+	putUInt(bytes, (unsigned long)data.size(), 4);
+	bytes.insert(bytes.end(), data.begin(), data.end());
+
+	FILE *fp = std::fopen(WAVE_FILE_NAME, "wb");
+	if (!fp) return false;
+	const size_t written = std::fwrite(&bytes[0], 1, bytes.size(), fp);
+	std::fclose(fp);
+	return written == bytes.size();
+}
+
+bool checkFormat(const unsigned short formatTag, const unsigned short bitsPerSample, const unsigned short channels, const swl::MappedWaveReader::SampleFormat expectedFormat, const bool hasListChunk)
+{
+	const size_t frameCount = 1001;
+	if (!writeWaveFile(formatTag, bitsPerSample, channels, frameCount, hasListChunk)) return false;
+
+	// The quantization error, but not below the precision of float.
+	const double tolerance = 3 == formatTag || bitsPerSample > 16 ? 1.0e-6 : std::ldexp(1.0, 1 - bitsPerSample);
+
+	bool isOk = true;
+	{
+		swl::MappedWaveReader reader;
+		isOk = reader.open(WAVE_FILE_NAME) && expectedFormat == reader.getSampleFormat() &&
+			channels == reader.getNumberOfChannels() && frameCount == reader.getNumberOfFrames();
+
+		// Read across the end of the data.
+		std::vector<std::vector<float> > allChannelData;
+		isOk = isOk && frameCount - 5 == reader.readFrames(5, frameCount, allChannelData);
+		for (size_t ch = 0; isOk && ch < channels; ++ch)
+			for (size_t i = 0; isOk && i < frameCount - 5; ++i)
+				isOk = std::fabs(allChannelData[ch][i] - getSample(i + 5, ch, channels)) < tolerance;
+
+		std::vector<float> channelData(10);
+		isOk = isOk && 10 == reader.readChannel(channels - 1, 991, 100, &channelData[0]);
+		for (size_t i = 0; isOk && i < 10; ++i)
+			isOk = std::fabs(channelData[i] - getSample(991 + i, channels - 1, channels)) < tolerance;
+	}
+	std::remove(WAVE_FILE_NAME);
+	return isOk;
+}
+
+bool checkChunkStream()
+{
+	const size_t frameCount = 1000;
+	if (!writeWaveFile(1, 16, 2, frameCount, false)) return false;
+
+	bool isOk = true;
+	{
+		swl::MappedWaveReader reader;
+		isOk = reader.open(WAVE_FILE_NAME);
+
+		swl::WaveChunkStream stream(reader, 300);
+		size_t totalFrames = 0, chunkCount = 0;
+		while (isOk && stream.next())
+		{
+			isOk = totalFrames == stream.getStartFrame() &&
+				std::fabs(stream.getChannel(1)[stream.getFrameCount() - 1] - getSample(totalFrames + stream.getFrameCount() - 1, 1, 2)) < 1.0e-4;
+			totalFrames += stream.getFrameCount();
+			++chunkCount;
+		}
+		isOk = isOk && frameCount == totalFrames && 4 == chunkCount;
+
+		stream.seek(950);
+		isOk = isOk && stream.next() && 50 == stream.getFrameCount() && !stream.next();
+	}
+	std::remove(WAVE_FILE_NAME);
+	return isOk;
+}
+
+// swl::WaveData reads frames only when the file's blockAlign holds exactly one SampleType per channel.
+bool checkWaveDataBlockAlign()
+{
+	const size_t frameCount = 5000;
+	if (!writeWaveFile(1, 16, 2, frameCount, false)) return false;
+
+	bool isOk = true;
+	{
+		swl::WaveData wav;
+		isOk = wav.openWaveFile(WAVE_FILE_NAME);
+
+		std::vector<std::vector<double> > allChannelData(2, std::vector<double>(frameCount - 10));
+		isOk = isOk && frameCount - 10 == wav.readAllChannelData<int16_t>(10, allChannelData);
+		for (size_t ch = 0; isOk && ch < 2; ++ch)
+			for (size_t i = 0; isOk && i < frameCount - 10; ++i)
+				isOk = std::fabs(allChannelData[ch][i] / 32768.0 - getSample(i + 10, ch, 2)) < 1.0e-4;
+
+		std::vector<double> channelData(10);
+		isOk = isOk && 10 == wav.readChannelData<int16_t>(1, 100, channelData) && std::fabs(channelData[9] / 32768.0 - getSample(109, 1, 2)) < 1.0e-4;
+
+		// A sample type wider than the frame.
+		isOk = isOk && 0 == wav.readAllChannelData<int32_t>(0, allChannelData) && 0 == wav.readChannelData<int32_t>(0, 0, channelData);
+	}
+
+	// A padded frame : blockAlign = 8 for two 16-bit channels.
+	FILE *fp = isOk ? std::fopen(WAVE_FILE_NAME, "r+b") : NULL;
+	if (fp)
+	{
+		const unsigned char blockAlign[2] = { 8, 0 };
+		isOk = 0 == std::fseek(fp, 32, SEEK_SET) && 2 == std::fwrite(blockAlign, 1, 2, fp);
+		std::fclose(fp);
+
+		swl::WaveData wav;
+		std::vector<std::vector<double> > allChannelData(2, std::vector<double>(frameCount));
+		std::vector<double> channelData(frameCount);
+		isOk = isOk && wav.openWaveFile(WAVE_FILE_NAME) && 8 == wav.getBlockAlign() &&
+			0 == wav.readAllChannelData<int16_t>(0, allChannelData) && 0 == wav.readChannelData<int16_t>(0, 0, channelData);
+	}
+	else isOk = false;
+	std::remove(WAVE_FILE_NAME);
+	return isOk;
+}
+
+bool checkInvalidFile()
+{
+	FILE *fp = std::fopen(WAVE_FILE_NAME, "wb");
+	if (!fp) return false;
+	std::fputs("RIFF____WAVEjunk", fp);
+	std::fclose(fp);
+
+	swl::MappedWaveReader reader;
+	const bool isOpened = reader.open(WAVE_FILE_NAME);
+	std::remove(WAVE_FILE_NAME);
+	return !isOpened && !reader.isOpened() && 0 == reader.readChannel(0, 0, 1, NULL);
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct MappedWaveReaderTest
+{
+public:
+	void testSampleFormats()
+	{
+		BOOST_CHECK(local::checkFormat(1, 8, 1, swl::MappedWaveReader::PCM_U8, false));
+		BOOST_CHECK(local::checkFormat(1, 16, 2, swl::MappedWaveReader::PCM_S16, false));
+		BOOST_CHECK(local::checkFormat(1, 24, 1, swl::MappedWaveReader::PCM_S24, true));
+		BOOST_CHECK(local::checkFormat(1, 32, 2, swl::MappedWaveReader::PCM_S32, false));
+		BOOST_CHECK(local::checkFormat(3, 32, 3, swl::MappedWaveReader::FLOAT32, true));
+	}
+
+	void testChunkStream()
+	{
+		BOOST_CHECK(local::checkChunkStream());
+	}
+
+	void testInvalidFile()
+	{
+		BOOST_CHECK(local::checkInvalidFile());
+	}
+
+	void testWaveDataBlockAlign()
+	{
+		BOOST_CHECK(local::checkWaveDataBlockAlign());
+	}
+};
+
+struct MappedWaveReaderTestSuite: public boost::unit_test_framework::test_suite
+{
+	MappedWaveReaderTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.Util.MappedWaveReader")
+	{
+		boost::shared_ptr<MappedWaveReaderTest> test(new MappedWaveReaderTest());
+
+		add(BOOST_CLASS_TEST_CASE(&MappedWaveReaderTest::testSampleFormats, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&MappedWaveReaderTest::testChunkStream, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&MappedWaveReaderTest::testInvalidFile, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&MappedWaveReaderTest::testWaveDataBlockAlign, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class MappedWaveReaderTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(MappedWaveReaderTest, testSampleFormats)
+{
+	EXPECT_TRUE(local::checkFormat(1, 8, 1, swl::MappedWaveReader::PCM_U8, false));
+	EXPECT_TRUE(local::checkFormat(1, 16, 2, swl::MappedWaveReader::PCM_S16, false));
+	EXPECT_TRUE(local::checkFormat(1, 24, 1, swl::MappedWaveReader::PCM_S24, true));
+	EXPECT_TRUE(local::checkFormat(1, 32, 2, swl::MappedWaveReader::PCM_S32, false));
+	EXPECT_TRUE(local::checkFormat(3, 32, 3, swl::MappedWaveReader::FLOAT32, true));
+}
+
+TEST_F(MappedWaveReaderTest, testChunkStream)
+{
+	EXPECT_TRUE(local::checkChunkStream());
+}
+
+TEST_F(MappedWaveReaderTest, testInvalidFile)
+{
+	EXPECT_TRUE(local::checkInvalidFile());
+}
+
+TEST_F(MappedWaveReaderTest, testWaveDataBlockAlign)
+{
+	EXPECT_TRUE(local::checkWaveDataBlockAlign());
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct MappedWaveReaderTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(MappedWaveReaderTest);
+	CPPUNIT_TEST(testSampleFormats);
+	CPPUNIT_TEST(testChunkStream);
+	CPPUNIT_TEST(testInvalidFile);
+	CPPUNIT_TEST(testWaveDataBlockAlign);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testSampleFormats()
+	{
+		CPPUNIT_ASSERT(local::checkFormat(1, 8, 1, swl::MappedWaveReader::PCM_U8, false));
+		CPPUNIT_ASSERT(local::checkFormat(1, 16, 2, swl::MappedWaveReader::PCM_S16, false));
+		CPPUNIT_ASSERT(local::checkFormat(1, 24, 1, swl::MappedWaveReader::PCM_S24, true));
+		CPPUNIT_ASSERT(local::checkFormat(1, 32, 2, swl::MappedWaveReader::PCM_S32, false));
+		CPPUNIT_ASSERT(local::checkFormat(3, 32, 3, swl::MappedWaveReader::FLOAT32, true));
+	}
+
+	void testChunkStream()
+	{
+		CPPUNIT_ASSERT(local::checkChunkStream());
+	}
+
+	void testInvalidFile()
+	{
+		CPPUNIT_ASSERT(local::checkInvalidFile());
+	}
+
+	void testWaveDataBlockAlign()
+	{
+		CPPUNIT_ASSERT(local::checkWaveDataBlockAlign());
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::MappedWaveReaderTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.Util");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::MappedWaveReaderTest, "SWL.Util");
+#endif
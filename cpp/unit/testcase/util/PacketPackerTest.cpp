@@ -0,0 +1,291 @@
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/util/PacketPacker.h"
+#include "swl/util/PacketLayout.h"
+#include <boost/scoped_array.hpp>
+#include <cstring>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+const std::size_t PACKET_SIZE = 1 + 2 + 4 + 8 + 4 + 8 + 3 + 2;
+
+void pack(swl::PacketPacker &packer)
+{
+	packer.putChar('@');
+	packer.putShort(0x1234);
+	packer.putInt(-123456);
+	packer.putInt64(0x0102030405060708LL);
+	packer.putFloat(1.5f);
+	packer.putDouble(-2.25);
+	packer.putText("abc", 3);
+	packer.fillChar('#', 2);
+}
+
+bool unpack(swl::PacketUnpacker &unpacker)
+{
+	char ch = 0;
+	short sh = 0;
+	int i = 0;
+	long long ll = 0;
+	float f = 0.0f;
+	double d = 0.0;
+	char text[5] = { 0, };
+	if (!unpacker.getChar(ch) || '@' != ch) return false;
+	if (!unpacker.getShort(sh) || 0x1234 != sh) return false;
+	if (!unpacker.getInt(i) || -123456 != i) return false;
+	if (!unpacker.getInt64(ll) || 0x0102030405060708LL != ll) return false;
+	if (!unpacker.getFloat(f) || 1.5f != f) return false;
+	if (!unpacker.getDouble(d) || -2.25 != d) return false;
+	if (!unpacker.getText(text, 5) || 0 != std::strncmp(text, "abc##", 5)) return false;
+	return 0 == unpacker.getRemainingSize() && !unpacker.getChar(ch);
+}
+
+bool checkPackAndUnpack(const bool isLittleEndian)
+{
+	swl::PacketPacker packer(PACKET_SIZE, isLittleEndian);
+	// the internal buffer is reused.
+	for (int k = 0; k < 3; ++k)
+	{
+		if (!packer.initialize()) return false;
+		pack(packer);
+		if (!packer.finalize() || PACKET_SIZE != packer.getPacketSize()) return false;
+	}
+
+	// the byte order of a short.
+	const unsigned char *data = packer.getPacketData();
+	if (isLittleEndian != (0x12 == data[1])) return false;
+
+	const boost::scoped_array<unsigned char> packet(packer.getPacket());
+	if (!packet || 0 != std::memcmp(packet.get(), data, PACKET_SIZE)) return false;
+
+	swl::PacketUnpacker unpacker(packet.get(), PACKET_SIZE, isLittleEndian);
+	return unpack(unpacker);
+}
+
+bool checkExternalBuffer()
+{
+	unsigned char buffer[PACKET_SIZE];
+	swl::PacketPacker packer(buffer, PACKET_SIZE, PACKET_SIZE, true);
+	packer.initialize();
+	pack(packer);
+	if (!packer.finalize() || packer.getPacketData() != buffer) return false;
+
+	swl::PacketUnpacker unpacker(true);
+	unpacker.setPacket(buffer, PACKET_SIZE);
+	if (!unpack(unpacker)) return false;
+
+	// the data beyond the buffer is not packed.
+	packer.putChar('!');
+	if (!packer.isOverflowed() || PACKET_SIZE != packer.getPacketSize()) return false;
+	packer.initialize();
+	return !packer.isOverflowed() && 0 == packer.getPacketSize();
+}
+
+bool checkInsertion()
+{
+	// a header is inserted in front of the data already packed.
+	swl::PacketPacker packer(0, false);
+	packer.initialize();
+	packer.putText("body", 4);
+	packer.initialize(false);
+	packer.putText("hd", 2);
+	if (!packer.finalize()) return false;
+
+	unsigned char packet[10];
+	return 6 == packer.copyPacket(packet, sizeof(packet)) && 0 == std::memcmp(packet, "hdbody", 6) &&
+		0 == packer.copyPacket(packet, 5);
+}
+
+bool checkLayout()
+{
+	typedef swl::PacketField<char> Stx;
+	typedef swl::PacketField<short, Stx, true> Id;
+	typedef swl::PacketField<double, Id, true> Value;
+	typedef swl::PacketTextField<2, Value> Etx;
+	typedef swl::PacketLayout<Etx> Layout;
+
+	if (1 != Id::offset || 3 != Value::offset || 13 != Layout::size) return false;
+
+	unsigned char packet[Layout::size];
+	Stx::put(packet, '@');
+	Id::put(packet, 0x1234);
+	Value::put(packet, 3.75);
+	Etx::fill(packet, '\n');
+
+	// a layout is compatible with the packet packer & unpacker.
+	swl::PacketPacker packer(Layout::size, true);
+	packer.initialize();
+	packer.putChar('@');
+	packer.putShort(0x1234);
+	packer.putDouble(3.75);
+	packer.fillChar('\n', 2);
+	if (!packer.finalize() || 0 != std::memcmp(packer.getPacketData(), packet, Layout::size)) return false;
+
+	swl::PacketUnpacker unpacker(packet, Layout::size, true);
+	short id = 0;
+	unpacker.skip(1);
+	if (!unpacker.getShort(id) || Id::get(packet) != id) return false;
+
+	char etx[2];
+	Etx::get(packet, etx);
+	return '@' == Stx::get(packet) && 3.75 == Value::get(packet) && '\n' == etx[1];
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct PacketPackerTest
+{
+public:
+	void testPackAndUnpack()
+	{
+		BOOST_CHECK(local::checkPackAndUnpack(false));
+		BOOST_CHECK(local::checkPackAndUnpack(true));
+	}
+
+	void testExternalBuffer()
+	{
+		BOOST_CHECK(local::checkExternalBuffer());
+	}
+
+	void testInsertion()
+	{
+		BOOST_CHECK(local::checkInsertion());
+	}
+
+	void testLayout()
+	{
+		BOOST_CHECK(local::checkLayout());
+	}
+};
+
+struct PacketPackerTestSuite: public boost::unit_test_framework::test_suite
+{
+	PacketPackerTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.Util.PacketPacker")
+	{
+		boost::shared_ptr<PacketPackerTest> test(new PacketPackerTest());
+
+		add(BOOST_CLASS_TEST_CASE(&PacketPackerTest::testPackAndUnpack, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&PacketPackerTest::testExternalBuffer, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&PacketPackerTest::testInsertion, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&PacketPackerTest::testLayout, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class PacketPackerTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(PacketPackerTest, testPackAndUnpack)
+{
+	EXPECT_TRUE(local::checkPackAndUnpack(false));
+	EXPECT_TRUE(local::checkPackAndUnpack(true));
+}
+
+TEST_F(PacketPackerTest, testExternalBuffer)
+{
+	EXPECT_TRUE(local::checkExternalBuffer());
+}
+
+TEST_F(PacketPackerTest, testInsertion)
+{
+	EXPECT_TRUE(local::checkInsertion());
+}
+
+TEST_F(PacketPackerTest, testLayout)
+{
+	EXPECT_TRUE(local::checkLayout());
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct PacketPackerTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(PacketPackerTest);
+	CPPUNIT_TEST(testPackAndUnpack);
+	CPPUNIT_TEST(testExternalBuffer);
+	CPPUNIT_TEST(testInsertion);
+	CPPUNIT_TEST(testLayout);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testPackAndUnpack()
+	{
+		CPPUNIT_ASSERT(local::checkPackAndUnpack(false));
+		CPPUNIT_ASSERT(local::checkPackAndUnpack(true));
+	}
+
+	void testExternalBuffer()
+	{
+		CPPUNIT_ASSERT(local::checkExternalBuffer());
+	}
+
+	void testInsertion()
+	{
+		CPPUNIT_ASSERT(local::checkInsertion());
+	}
+
+	void testLayout()
+	{
+		CPPUNIT_ASSERT(local::checkLayout());
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::PacketPackerTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.Util");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::PacketPackerTest, "SWL.Util");
+#endif
@@ -0,0 +1,324 @@
+#include "swl/Config.h"
+#include "../../UnitTestConfig.h"
+#include "swl/util/LockFreeRingBuffer.h"
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#include <vector>
+
+
+#if defined(_DEBUG) && defined(__SWL_CONFIG__USE_DEBUG_NEW)
+#include "swl/ResourceLeakageCheck.h"
+#define new DEBUG_NEW
+#endif
+
+
+namespace {
+namespace local {
+
+const std::size_t MESSAGE_COUNT = 20000;
+const std::size_t MESSAGE_LENGTH = 13;
+
+// message i is filled with (unsigned char)(i + j).
+template<class Buffer>
+void produce(Buffer *buffer, const std::size_t first, const std::size_t step)
+{
+	unsigned char msg[MESSAGE_LENGTH];
+	for (std::size_t i = first; i < MESSAGE_COUNT; i += step)
+	{
+		for (std::size_t j = 0; j < MESSAGE_LENGTH; ++j)
+			msg[j] = (unsigned char)(i + j);
+		while (!buffer->push(msg, MESSAGE_LENGTH))
+			boost::this_thread::yield();
+	}
+}
+
+// count the messages received intact.
+template<class Buffer>
+void consume(Buffer *buffer, const std::size_t count, std::size_t *validCount)
+{
+	unsigned char msg[MESSAGE_LENGTH];
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		while (!buffer->pop(msg, MESSAGE_LENGTH))
+			boost::this_thread::yield();
+
+		bool isValid = true;
+		for (std::size_t j = 1; j < MESSAGE_LENGTH; ++j)
+			if ((unsigned char)(msg[0] + j) != msg[j]) isValid = false;
+		if (isValid) ++*validCount;
+	}
+}
+
+template<class Buffer>
+bool checkPushAndPop(Buffer &buffer)
+{
+	// the capacity is rounded up to a power of two.
+	if (16 != buffer.getCapacity() || !buffer.isEmpty()) return false;
+
+	const unsigned char data[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+	unsigned char out[12] = { 0, };
+
+	// wrap around the end of the storage several times
+	for (int k = 0; k < 5; ++k)
+	{
+		if (!buffer.push(data, 12) || 12 != buffer.getSize()) return false;
+		if (buffer.push(data, 5)) return false;  // all or nothing
+		if (!buffer.top(out, 12) || 12 != buffer.getSize()) return false;
+		for (int i = 0; i < 12; ++i)
+			if (data[i] != out[i]) return false;
+		if (!buffer.pop(12) || !buffer.isEmpty()) return false;
+	}
+
+	if (buffer.pop() || buffer.top(out, 1)) return false;
+
+	if (!buffer.push(data, data + 7) || !buffer.push((unsigned char)100)) return false;
+	unsigned char value = 0;
+	if (!buffer.top(value) || 0 != value) return false;
+	if (!buffer.pop(out, 8) || 6 != out[6] || 100 != out[7]) return false;
+
+	buffer.push(data, 10);
+	buffer.clear();
+	return buffer.isEmpty() && !buffer.pop();
+}
+
+// write & read across the end of the storage through the segments.
+template<class Buffer>
+bool checkSegments(Buffer &buffer)
+{
+	const unsigned char data[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+	if (!buffer.push(data, 10) || !buffer.pop(10)) return false;
+
+	unsigned char *segments[2];
+	std::size_t lengths[2];
+	if (12 != buffer.getWritableSegments(segments, lengths, 12) || 12 != lengths[0] + lengths[1]) return false;
+	for (std::size_t i = 0, k = 0; i < 2; ++i)
+		for (std::size_t j = 0; j < lengths[i]; ++j, ++k)
+			segments[i][j] = (unsigned char)(100 + k);
+	if (!buffer.produce(12) || 12 != buffer.getSize()) return false;
+
+	const unsigned char *readSegments[2];
+	if (12 != buffer.getReadableSegments(readSegments, lengths, 100) || 12 != lengths[0] + lengths[1]) return false;
+	for (std::size_t i = 0, k = 0; i < 2; ++i)
+		for (std::size_t j = 0; j < lengths[i]; ++j, ++k)
+			if ((unsigned char)(100 + k) != readSegments[i][j]) return false;
+	if (5 != buffer.getReadableSegments(readSegments, lengths, 5) || 100 != readSegments[0][0]) return false;
+	if (!buffer.pop(12)) return false;
+
+	// nothing is pushed if the buffer is full.
+	if (!buffer.push(data, 10) || !buffer.push(data, 6)) return false;
+	buffer.getWritableSegments(segments, lengths, 4);
+	return !buffer.produce(4) && 16 == buffer.getSize();
+}
+
+template<class Buffer>
+bool checkConcurrency(const std::size_t producerCount, const std::size_t consumerCount)
+{
+	Buffer buffer(64);
+
+	std::vector<std::size_t> validCounts(consumerCount, 0);
+	boost::thread_group threads;
+	for (std::size_t i = 0; i < consumerCount; ++i)
+		threads.create_thread(boost::bind(&consume<Buffer>, &buffer, MESSAGE_COUNT / consumerCount, &validCounts[i]));
+	for (std::size_t i = 0; i < producerCount; ++i)
+		threads.create_thread(boost::bind(&produce<Buffer>, &buffer, i, producerCount));
+	threads.join_all();
+
+	std::size_t validCount = 0;
+	for (std::size_t i = 0; i < consumerCount; ++i)
+		validCount += validCounts[i];
+	return MESSAGE_COUNT == validCount && buffer.isEmpty();
+}
+
+}  // namespace local
+}  // unnamed namespace
+
+namespace swl {
+namespace unit_test {
+
+//-----------------------------------------------------------------------------
+// Boost Test.
+
+#if defined(__SWL_UNIT_TEST__USE_BOOST_TEST)
+
+namespace {
+
+struct RingBufferTest
+{
+public:
+	void testSpscPushAndPop()
+	{
+		swl::SpscByteBuffer buffer(10);
+		BOOST_CHECK(local::checkPushAndPop(buffer));
+	}
+
+	void testMpmcPushAndPop()
+	{
+		swl::MpmcByteBuffer buffer(10);
+		BOOST_CHECK(local::checkPushAndPop(buffer));
+	}
+
+	void testSpscSegments()
+	{
+		swl::SpscByteBuffer buffer(16);
+		BOOST_CHECK(local::checkSegments(buffer));
+	}
+
+	void testMpmcSegments()
+	{
+		swl::MpmcByteBuffer buffer(16);
+		BOOST_CHECK(local::checkSegments(buffer));
+	}
+
+	void testSpscConcurrency()
+	{
+		BOOST_CHECK(local::checkConcurrency<swl::SpscByteBuffer>(1, 1));
+	}
+
+	void testMpmcConcurrency()
+	{
+		BOOST_CHECK(local::checkConcurrency<swl::MpmcByteBuffer>(4, 4));
+	}
+};
+
+struct RingBufferTestSuite: public boost::unit_test_framework::test_suite
+{
+	RingBufferTestSuite()
+	: boost::unit_test_framework::test_suite("SWL.Util.RingBuffer")
+	{
+		boost::shared_ptr<RingBufferTest> test(new RingBufferTest());
+
+		add(BOOST_CLASS_TEST_CASE(&RingBufferTest::testSpscPushAndPop, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&RingBufferTest::testMpmcPushAndPop, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&RingBufferTest::testSpscSegments, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&RingBufferTest::testMpmcSegments, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&RingBufferTest::testSpscConcurrency, test), 0);
+		add(BOOST_CLASS_TEST_CASE(&RingBufferTest::testMpmcConcurrency, test), 0);
+
+		boost::unit_test::framework::master_test_suite().add(this);
+	}
+} testsuite;
+
+}  // unnamed namespace
+
+//-----------------------------------------------------------------------------
+// Google Test.
+
+#elif defined(__SWL_UNIT_TEST__USE_GOOGLE_TEST)
+
+class RingBufferTest : public testing::Test
+{
+protected:
+	/*virtual*/ void SetUp()
+	{
+	}
+
+	/*virtual*/ void TearDown()
+	{
+	}
+};
+
+TEST_F(RingBufferTest, testSpscPushAndPop)
+{
+	swl::SpscByteBuffer buffer(10);
+	EXPECT_TRUE(local::checkPushAndPop(buffer));
+}
+
+TEST_F(RingBufferTest, testMpmcPushAndPop)
+{
+	swl::MpmcByteBuffer buffer(10);
+	EXPECT_TRUE(local::checkPushAndPop(buffer));
+}
+
+TEST_F(RingBufferTest, testSpscSegments)
+{
+	swl::SpscByteBuffer buffer(16);
+	EXPECT_TRUE(local::checkSegments(buffer));
+}
+
+TEST_F(RingBufferTest, testMpmcSegments)
+{
+	swl::MpmcByteBuffer buffer(16);
+	EXPECT_TRUE(local::checkSegments(buffer));
+}
+
+TEST_F(RingBufferTest, testSpscConcurrency)
+{
+	EXPECT_TRUE(local::checkConcurrency<swl::SpscByteBuffer>(1, 1));
+}
+
+TEST_F(RingBufferTest, testMpmcConcurrency)
+{
+	EXPECT_TRUE(local::checkConcurrency<swl::MpmcByteBuffer>(4, 4));
+}
+
+//-----------------------------------------------------------------------------
+// CppUnit.
+
+#elif defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+
+struct RingBufferTest: public CppUnit::TestFixture
+{
+private:
+	CPPUNIT_TEST_SUITE(RingBufferTest);
+	CPPUNIT_TEST(testSpscPushAndPop);
+	CPPUNIT_TEST(testMpmcPushAndPop);
+	CPPUNIT_TEST(testSpscSegments);
+	CPPUNIT_TEST(testMpmcSegments);
+	CPPUNIT_TEST(testSpscConcurrency);
+	CPPUNIT_TEST(testMpmcConcurrency);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()  // Set up.
+	{
+	}
+
+	void tearDown()  // Tear down.
+	{
+	}
+
+	void testSpscPushAndPop()
+	{
+		swl::SpscByteBuffer buffer(10);
+		CPPUNIT_ASSERT(local::checkPushAndPop(buffer));
+	}
+
+	void testMpmcPushAndPop()
+	{
+		swl::MpmcByteBuffer buffer(10);
+		CPPUNIT_ASSERT(local::checkPushAndPop(buffer));
+	}
+
+	void testSpscSegments()
+	{
+		swl::SpscByteBuffer buffer(16);
+		CPPUNIT_ASSERT(local::checkSegments(buffer));
+	}
+
+	void testMpmcSegments()
+	{
+		swl::MpmcByteBuffer buffer(16);
+		CPPUNIT_ASSERT(local::checkSegments(buffer));
+	}
+
+	void testSpscConcurrency()
+	{
+		CPPUNIT_ASSERT(local::checkConcurrency<swl::SpscByteBuffer>(1, 1));
+	}
+
+	void testMpmcConcurrency()
+	{
+		CPPUNIT_ASSERT(local::checkConcurrency<swl::MpmcByteBuffer>(4, 4));
+	}
+};
+
+#endif
+
+}  // namespace unit_test
+}  // namespace swl
+
+#if defined(__SWL_UNIT_TEST__USE_CPP_UNIT)
+//CPPUNIT_TEST_SUITE_REGISTRATION(swl::unit_test::RingBufferTest);
+CPPUNIT_REGISTRY_ADD_TO_DEFAULT("SWL.Util");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(swl::unit_test::RingBufferTest, "SWL.Util");
+#endif